@@ -0,0 +1,134 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Command-line tool which compresses a WAV file with ADPCM, for the sound bank.
+@par Usage:
+@code
+adpcm encoder <wav file> <adpcm wav file> [-ima | -ms] [block size]
+@endcode
+\a wav file may be in any format that avl::sound::LoadWAVFile() can load; it's converted
+to 16 bits first. IMA ADPCM is the default. Unless a block size is given, the one which
+Windows' own encoders use for the rate and channel count is used. The result is decoded
+again and its error is reported, so that sounds which don't compress well can be left
+uncompressed.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"..\..\sound\src\load wav file\load wav file.h"
+#include"..\..\sound\src\normalize sample\normalize sample.h"
+#include"..\..\sound\src\adpcm\adpcm.h"
+#include"..\..\utility\src\exceptions\exceptions.h"
+#include<iostream>
+#include<string>
+#include<cmath>
+#include<cstdlib>
+
+
+namespace
+{
+	/** Computes the root mean square error of each sample after decompression.
+	@param original The original 16-bit sample.
+	@param decoded The decompressed 16-bit sample.
+	@return The error, in 16-bit steps.
+	*/
+	const double MeasureError(const avl::sound::SoundSample& original, const avl::sound::SoundSample& decoded)
+	{
+		const short* const original_samples = reinterpret_cast<const short*>(original.GetAudioData());
+		const short* const decoded_samples = reinterpret_cast<const short*>(decoded.GetAudioData());
+		const std::size_t sample_count = original.GetFrameCount() * original.GetNumberOfChannels();
+		double sum = 0.0;
+		for(std::size_t i = 0; i < sample_count; ++i)
+		{
+			const double difference = static_cast<double>(original_samples[i]) - decoded_samples[i];
+			sum += difference * difference;
+		}
+		return (sample_count > 0) ? std::sqrt(sum / sample_count) : 0.0;
+	}
+}
+
+
+
+int main(int argc, char* argv[])
+{
+	using namespace avl::sound;
+	if(argc < 3)
+	{
+		std::cout << "Usage: adpcm encoder <wav file> <adpcm wav file> [-ima | -ms] [block size]\n";
+		return 1;
+	}
+	const std::string wav_name = argv[1];
+	const std::string adpcm_name = argv[2];
+	SoundSample::Encoding encoding = SoundSample::IMA_ADPCM;
+	unsigned long block_size = 0;
+	for(int i = 3; i < argc; ++i)
+	{
+		const std::string option = argv[i];
+		if(option == "-ima")
+		{
+			encoding = SoundSample::IMA_ADPCM;
+		}
+		else if(option == "-ms")
+		{
+			encoding = SoundSample::MS_ADPCM;
+		}
+		else
+		{
+			block_size = std::strtoul(argv[i], nullptr, 10);
+		}
+	}
+
+	try
+	{
+		const SoundSample loaded = LoadWAVFile(wav_name);
+		if(loaded.GetFrameCount() == 0)
+		{
+			std::cout << wav_name << " holds no sound.\n";
+			return 1;
+		}
+		if(encoding == SoundSample::MS_ADPCM && loaded.GetNumberOfChannels() > 2)
+		{
+			std::cout << wav_name << " has " << loaded.GetNumberOfChannels() << " channels; Microsoft ADPCM only supports mono and stereo.\n";
+			return 1;
+		}
+		const SampleFormat format = {16, loaded.GetFrequency(), loaded.GetNumberOfChannels()};
+		const SoundSample original = NormalizeSoundSample(loaded, format);
+		const unsigned short channel_count = original.GetNumberOfChannels();
+		const unsigned short block_alignment = (block_size != 0) ? static_cast<unsigned short>(block_size) : GetDefaultADPCMBlockAlignment(original.GetFrequency(), channel_count);
+		if(block_size > 0xFFFF || GetADPCMBlockFrames(encoding, block_alignment, channel_count) == 0)
+		{
+			std::cout << "A block size of " << block_size << " isn't supported with " << channel_count << " channels.\n";
+			return 1;
+		}
+
+		const SoundSample compressed = EncodeADPCM(encoding, reinterpret_cast<const short*>(original.GetAudioData()), original.GetFrameCount(), channel_count,
+			original.GetFrequency(), block_alignment);
+		SaveWAVFile(adpcm_name, compressed);
+
+		const SoundSample decoded = DecodeADPCMSample(compressed);
+		std::cout << "Wrote " << adpcm_name << " as " << ((encoding == SoundSample::IMA_ADPCM) ? "IMA ADPCM" : "Microsoft ADPCM") << " in blocks of "
+			<< block_alignment << ": " << compressed.GetDataSize() << " bytes vs. " << original.GetDataSize() << " as 16-bit PCM, RMS error "
+			<< MeasureError(original, decoded) << ".\n";
+	}
+	catch(const avl::utility::Exception& e)
+	{
+		std::cout << e.GetDescription() << std::endl;
+		return 1;
+	}
+	return 0;
+}
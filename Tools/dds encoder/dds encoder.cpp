@@ -0,0 +1,152 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Command-line tool which converts an image to a block-compressed DDS file.
+@par Usage:
+@code
+dds encoder <image> <dds file> [-dxt1 | -dxt5]
+@endcode
+\a image may be any format that avl::view::Image can load. Unless a format is given,
+images with any alpha value other than 0xFF are compressed to DXT5, and the rest to DXT1.
+The result is decoded again with the reference decoder, and its error is reported so that
+images which don't compress well can be left uncompressed.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"..\..\view\src\image\image.h"
+#include"..\..\view\src\block compression\block compression.h"
+#include"..\..\utility\src\exceptions\exceptions.h"
+#include<iostream>
+#include<string>
+#include<vector>
+#include<cmath>
+#include<new>
+
+
+namespace
+{
+	/** Checks whether an image uses its alpha channel.
+	@param image The image to check.
+	@return True if any pixel has an alpha value other than 0xFF.
+	*/
+	const bool IsAlphaUsed(const avl::view::Image& image)
+	{
+		if(image.GetPixelDepth() != 4)
+		{
+			return false;
+		}
+		const std::size_t pixel_count = static_cast<std::size_t>(image.GetWidth()) * image.GetHeight();
+		for(std::size_t i = 0; i < pixel_count; ++i)
+		{
+			if(image.GetPixelData()[i * 4 + 3] != 0xFF)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/** Computes the root mean square error of each pixel's channels after decompression.
+	@param image The original image.
+	@param decoded The decompressed 32-bit pixels.
+	@param format The block format, which decides whether alpha counts.
+	@return The error.
+	*/
+	const double MeasureError(const avl::view::Image& image, const std::vector<unsigned char>& decoded, const avl::view::BlockFormat format)
+	{
+		const std::size_t pixel_count = static_cast<std::size_t>(image.GetWidth()) * image.GetHeight();
+		const unsigned int pixel_depth = image.GetPixelDepth();
+		const unsigned int channels = (format == avl::view::DXT5) ? pixel_depth : 3;
+		double sum = 0.0;
+		for(std::size_t i = 0; i < pixel_count; ++i)
+		{
+			for(unsigned int channel = 0; channel < channels; ++channel)
+			{
+				const double difference = static_cast<double>(image.GetPixelData()[i * pixel_depth + channel]) - decoded[i * 4 + channel];
+				sum += difference * difference;
+			}
+		}
+		return std::sqrt(sum / (static_cast<double>(pixel_count) * channels));
+	}
+}
+
+
+
+int main(int argc, char* argv[])
+{
+	using namespace avl::view;
+	if(argc < 3)
+	{
+		std::cout << "Usage: dds encoder <image> <dds file> [-dxt1 | -dxt5]\n";
+		return 1;
+	}
+	const std::string image_name = argv[1];
+	const std::string dds_name = argv[2];
+	const std::string option = (argc > 3) ? argv[3] : "";
+
+	try
+	{
+		const Image image(image_name);
+		if(image.GetPixelData() == nullptr || image.IsCompressed() == true)
+		{
+			std::cout << "Unable to load " << image_name << ".\n";
+			return 1;
+		}
+		if(image.GetWidth() % 4 != 0 || image.GetHeight() % 4 != 0)
+		{
+			std::cout << image_name << " is " << image.GetWidth() << "x" << image.GetHeight() << "; block-compressed images must be a multiple of 4 in each direction.\n";
+			return 1;
+		}
+		BlockFormat format = (IsAlphaUsed(image) == true) ? DXT5 : DXT1;
+		if(option == "-dxt1")
+		{
+			format = DXT1;
+		}
+		else if(option == "-dxt5")
+		{
+			format = DXT5;
+		}
+
+		// The image takes ownership of the blocks.
+		unsigned char* const blocks = new(std::nothrow) unsigned char[GetBlockDataSize(image.GetWidth(), image.GetHeight(), format)];
+		if(blocks == nullptr)
+		{
+			throw avl::utility::OutOfMemoryError();
+		}
+		CompressBlocks(image.GetPixelData(), image.GetWidth(), image.GetHeight(), image.GetPixelDepth(), format, blocks);
+		const Image compressed(image.GetWidth(), image.GetHeight(), format, IsAnyBlockTranslucent(blocks, image.GetWidth(), image.GetHeight(), format), blocks);
+		if(SaveImageDDS(dds_name, compressed) == false)
+		{
+			std::cout << "Unable to write " << dds_name << ".\n";
+			return 1;
+		}
+
+		std::vector<unsigned char> decoded(static_cast<std::size_t>(image.GetWidth()) * image.GetHeight() * 4);
+		DecompressBlocks(blocks, image.GetWidth(), image.GetHeight(), format, &decoded[0]);
+		std::cout << "Wrote " << dds_name << " as " << ((format == DXT1) ? "DXT1" : "DXT5") << ": " << compressed.GetDataSize()
+			<< " bytes vs. " << static_cast<std::size_t>(image.GetWidth()) * image.GetHeight() * 4 << " as a 32-bit texture, RMS error "
+			<< MeasureError(image, decoded, format) << ".\n";
+	}
+	catch(const avl::utility::Exception& e)
+	{
+		std::cout << e.GetDescription() << std::endl;
+		return 1;
+	}
+	return 0;
+}
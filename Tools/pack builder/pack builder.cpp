@@ -0,0 +1,113 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Command-line tool which builds a pack file from a directory of assets.
+@par Usage:
+@code
+pack builder <pack file> <directory> [-c]
+@endcode
+Every file under \a directory is added to the pack file, named by its path as
+given (e.g. "assets/font.tga" for "pack builder assets.pak assets"), so that the
+game can open it by the same name it would use for the loose file. With \c -c,
+entries are compressed wherever that saves space.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"..\..\utility\src\pack file\pack file.h"
+#include"..\..\utility\src\exceptions\exceptions.h"
+#include<iostream>
+#include<string>
+#include<vector>
+#include<Windows.h>
+
+
+namespace
+{
+	/** Collects the names of every file under \a directory, recursively.
+	@param directory The directory to search.
+	@param file_names [OUT] Receives the names of the files.
+	*/
+	void FindFiles(const std::string& directory, std::vector<std::string>& file_names)
+	{
+		WIN32_FIND_DATAA find_data;
+		const HANDLE find = FindFirstFileA((directory + "\\*").c_str(), &find_data);
+		if(find == INVALID_HANDLE_VALUE)
+		{
+			return;
+		}
+		do
+		{
+			const std::string name = find_data.cFileName;
+			if(name == "." || name == "..")
+			{
+				continue;
+			}
+			const std::string path = directory + "/" + name;
+			if((find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+			{
+				FindFiles(path, file_names);
+			}
+			else
+			{
+				file_names.push_back(path);
+			}
+		}
+		while(FindNextFileA(find, &find_data) != FALSE);
+		FindClose(find);
+	}
+}
+
+
+
+int main(int argc, char* argv[])
+{
+	if(argc < 3)
+	{
+		std::cout << "Usage: pack builder <pack file> <directory> [-c]\n";
+		return 1;
+	}
+	const std::string pack_name = argv[1];
+	const std::string directory = argv[2];
+	const bool compress = (argc > 3 && std::string(argv[3]) == "-c");
+
+	try
+	{
+		std::vector<std::string> file_names;
+		FindFiles(directory, file_names);
+		if(file_names.empty() == true)
+		{
+			std::cout << "No files found in " << directory << ".\n";
+			return 1;
+		}
+
+		avl::utility::PackFileBuilder builder;
+		for(std::vector<std::string>::const_iterator i = file_names.begin(); i != file_names.end(); ++i)
+		{
+			builder.AddFile(*i, compress);
+		}
+		builder.Write(pack_name);
+		std::cout << "Packed " << file_names.size() << " files (" << builder.GetCompressedCount() << " compressed) into " << pack_name << ".\n";
+	}
+	catch(const avl::utility::Exception& e)
+	{
+		std::cout << e.GetDescription() << std::endl;
+		return 1;
+	}
+	return 0;
+}
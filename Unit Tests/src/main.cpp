@@ -50,6 +50,27 @@ void TestSettingsFileComponent();
 void TestTexturedQuadComponent();
 void TestXAudio2SoundEngineComponent();
 void TestFileOperationsComponent();
+void TestLockFreeQueueComponent();
+void TestAsyncLogFileComponent();
+void TestAssetLoaderComponent();
+void TestLZCodecComponent();
+void TestPackFileComponent();
+void TestImageComponent();
+void TestInflateComponent();
+void TestBlockCompressionComponent();
+void TestMipmapComponent();
+void TestContentHashComponent();
+void TestMixingComponent();
+void TestSoftwareSoundEngineComponent();
+void TestSoundStreamComponent();
+void TestSoundSampleComponent();
+void TestNormalizeSampleComponent();
+void TestADPCMComponent();
+void TestThreadedSoundEngineComponent();
+void TestSpatializationComponent();
+void TestDSPEffectsComponent();
+void TestInputBufferComponent();
+void TestInputRecordingComponent();
 
 int main()
 {
@@ -58,5 +79,26 @@ int main()
 	//TestSettingsFileComponent();
 	//TestXAudio2SoundEngineComponent();
 	//TestFileOperationsComponent();
+	//TestLockFreeQueueComponent();
+	//TestAsyncLogFileComponent();
+	//TestAssetLoaderComponent();
+	//TestLZCodecComponent();
+	//TestPackFileComponent();
+	//TestImageComponent();
+	//TestInflateComponent();
+	//TestBlockCompressionComponent();
+	//TestMipmapComponent();
+	//TestContentHashComponent();
+	//TestMixingComponent();
+	//TestSoftwareSoundEngineComponent();
+	//TestSoundStreamComponent();
+	//TestSoundSampleComponent();
+	//TestNormalizeSampleComponent();
+	//TestADPCMComponent();
+	//TestThreadedSoundEngineComponent();
+	//TestSpatializationComponent();
+	//TestDSPEffectsComponent();
+	//TestInputBufferComponent();
+	//TestInputRecordingComponent();
 	return 0;
 }
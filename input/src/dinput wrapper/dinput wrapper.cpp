@@ -25,8 +25,6 @@ Implementation for the dinput wrapper component. See "dinput wrapper.h" for deta
 #include"..\..\..\utility\src\key codes\key codes.h"
 #include"..\..\..\utility\src\input events\input events.h"
 #include"..\..\..\utility\src\exceptions\exceptions.h"
-#include<new>
-#include<memory>
 /// Defines the direct input version to avoid a compiler warning.
 #ifndef DIRECTINPUT_VERSION
 #define DIRECTINPUT_VERSION 0x800
@@ -144,30 +142,21 @@ namespace dinput
 	}
 
 	// See function declaration for details.
-	bool RetrieveDeviceData(LPDIRECTINPUTDEVICE8 device, std::queue<DIDEVICEOBJECTDATA>& data_queue)
+	bool RetrieveDeviceData(LPDIRECTINPUTDEVICE8 device, DIDEVICEOBJECTDATA* const data, DWORD& count)
 	{
-		static const DWORD BATCH_SIZE = 15;
-		// Holds buffered input data.
-		std::unique_ptr<DIDEVICEOBJECTDATA[]> data(new(std::nothrow) DIDEVICEOBJECTDATA[BATCH_SIZE]);
-		if(data == nullptr)
+		const DWORD capacity = count;
+		count = 0;
+		// Harvest the buffered input data from the device until it's empty or data is full.
+		while(count < capacity)
 		{
-			throw utility::OutOfMemoryError();
-		}
-		// Keeps track of how many elements have been read.
-		DWORD number_of_elements;
-		// Harvest all of the buffered input data from the device.
-		HRESULT result;
-		do
-		{
-			// Read in a batch of data.
-			number_of_elements = BATCH_SIZE;
-			result = device->GetDeviceData(sizeof(DIDEVICEOBJECTDATA), data.get(), &number_of_elements, 0);
+			// Read the data straight into the unused end of data.
+			DWORD number_of_elements = capacity - count;
+			const HRESULT result = device->GetDeviceData(sizeof(DIDEVICEOBJECTDATA), data + count, &number_of_elements, 0);
 			// Was there a failure other than an overflow?
 			if(FAILED(result) && result != DI_BUFFEROVERFLOW)
 			{
 				// Attempt to re-acquire the device.
-				result = device->Acquire();
-				if (FAILED(result))
+				if (FAILED(device->Acquire()))
 				{
 					// The device can't be re-acquired yet. Signal the failure.
 					return false;
@@ -175,12 +164,12 @@ namespace dinput
 				// We've successfully re-acquired the device. Continue collecting data.
 				continue;
 			}
-			// Stick the new events in the queue.
-			for(DWORD i = 0; i < number_of_elements; ++i)
+			if(number_of_elements == 0)
 			{
-				data_queue.push(data[i]);
+				break;
 			}
-		}while(number_of_elements != 0);
+			count += number_of_elements;
+		}
 		// Data collected. Return success.
 		return true;
 	}
@@ -27,7 +27,6 @@ Implements thin wrapper functions for common Direct Input tasks.
 #include"..\input device\input device.h"
 #include"..\..\..\utility\src\key codes\key codes.h"
 #include"..\..\..\utility\src\input events\input events.h"
-#include<queue>
 /// Defines the direct input version to avoid a compiler warning.
 #ifndef DIRECTINPUT_VERSION
 #define DIRECTINPUT_VERSION 0x800
@@ -68,16 +67,17 @@ namespace dinput
 	LPDIRECTINPUTDEVICE8 const CreateMouseDevice(LPDIRECTINPUT8 const dinput, HWND window_handle, const unsigned int buffer_size);
 
 
-	/** Attempts to retrieve the buffered data from an input device. Any data
-	extracted from the device's buffer will be queued in \a data_queue.
+	/** Attempts to retrieve the buffered data from an input device into \a data.
+	Data which doesn't fit is left in the device's buffer for the next call.
 	@param device The device from which to read input.
-	@param data_queue The queue in which to store extracted data.
+	@param data [OUT] Receives the extracted data.
+	@param count [IN/OUT] The number of elements which \a data can hold; receives
+	the number of elements extracted.
 	@return True if the retrieval was a complete success. False if unable to
 	finish retrieving the buffered data. Note that even if false is returned,
 	some buffered data may have been extracted.
-	@throws utility::OutOfMemoryError If we run out of storage space.
 	*/
-	bool RetrieveDeviceData(LPDIRECTINPUTDEVICE8 device, std::queue<DIDEVICEOBJECTDATA>& data_queue);
+	bool RetrieveDeviceData(LPDIRECTINPUTDEVICE8 device, DIDEVICEOBJECTDATA* const data, DWORD& count);
 
 
 
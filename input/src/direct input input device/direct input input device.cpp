@@ -24,11 +24,9 @@ Unit test for the direct input input device component. See "direct input input d
 #include"direct input input device.h"
 #include"..\dinput wrapper\dinput wrapper.h"
 #include"..\..\..\utility\src\key codes\key codes.h"
-#include"..\..\..\utility\src\input events\input events.h"
+#include"..\..\..\utility\src\input buffer\input buffer.h"
 #include"..\..\..\utility\src\exceptions\exceptions.h"
 #include"..\..\..\utility\src\assert\assert.h"
-#include<new>
-#include<queue>
 #include<windows.h>
 // Define the direct input version to avoid a compiler warning.
 #ifndef DIRECTINPUT_VERSION
@@ -58,9 +56,9 @@ namespace input
 			// Create the DirectInput interface.
 			dinput = dinput::GetDirectInput();
 			// Create a keyboard device.
-			keyboard_device = dinput::CreateKeyboardDevice(dinput, window_handle, 30);
+			keyboard_device = dinput::CreateKeyboardDevice(dinput, window_handle, DEVICE_BUFFER_SIZE);
 			// Create a mouse device.
-			mouse_device = dinput::CreateMouseDevice(dinput, window_handle, 30);
+			mouse_device = dinput::CreateMouseDevice(dinput, window_handle, DEVICE_BUFFER_SIZE);
 		
 		
 			// Aquire the keyboard and mouse devices.
@@ -97,46 +95,25 @@ namespace input
 
 
 	// See method declaration for details.
-	utility::input_events::InputQueue DirectInputInputDevice::GetInput()
+	void DirectInputInputDevice::GetInput(utility::input_events::InputBuffer& buffer)
 	{
-		utility::input_events::InputQueue queue;
-
-		PollKeyboard(queue);
-		PollMouse(queue);
-
-		return queue;
+		PollKeyboard(buffer);
+		PollMouse(buffer);
 	}
 
 
 	// See method declaration for details.
-	void DirectInputInputDevice::ResetDeviceStates(utility::input_events::InputQueue& queue)
+	void DirectInputInputDevice::ResetDeviceStates(utility::input_events::InputBuffer& buffer)
 	{
+		// The releases happen now, rather than at a time reported by the device.
+		const unsigned int timestamp = GetTickCount();
 		// Reset the state of each currently pressed mouse button.
-		const utility::input_events::InputEvent* event;
 		for(DWORD button = 0; button < 8; ++button)
 		{
 			if(mouse_button_state[button] == true)
 			{
 				// Generate the appropriate button-release event. Correct for the button offset.
-				event = new(std::nothrow) utility::input_events::MouseButtonEvent(dinput::DIKToMB(button + DIMOFS_BUTTON0), false);
-				if(event == nullptr)
-				{
-					throw utility::OutOfMemoryError();
-				}
-				try
-				{
-					queue.push(event);
-				}
-				catch(const std::bad_alloc&)
-				{
-					delete event;
-					throw utility::OutOfMemoryError();
-				}
-				catch(...)
-				{
-					delete event;
-					throw;
-				}
+				buffer.Push(utility::input_events::PackMouseButtonEvent(dinput::DIKToMB(button + DIMOFS_BUTTON0), false, timestamp));
 				// Set the button state to released.
 				mouse_button_state[button] = false;
 			}
@@ -148,25 +125,7 @@ namespace input
 			if(keyboard_state[key] & 0x80)
 			{
 				// Generate the appropriate key-release event.
-				event = new(std::nothrow) utility::input_events::KeyboardEvent(dinput::DIKToKK(key), false);
-				if(event == nullptr)
-				{
-					throw utility::OutOfMemoryError();
-				}
-				try
-				{
-					queue.push(event);
-				}
-				catch(const std::bad_alloc&)
-				{
-					delete event;
-					throw utility::OutOfMemoryError();
-				}
-				catch(...)
-				{
-					delete event;
-					throw;
-				}
+				buffer.Push(utility::input_events::PackKeyboardEvent(dinput::DIKToKK(key), false, timestamp));
 				// Set the key state to released.
 				keyboard_state[key] = 0x00;
 			}
@@ -175,122 +134,80 @@ namespace input
 
 
 	// See method declaration for details.
-	void DirectInputInputDevice::PollKeyboard(utility::input_events::InputQueue& queue)
+	void DirectInputInputDevice::PollKeyboard(utility::input_events::InputBuffer& buffer)
 	{
-		// These variables hold the raw data from the keyboard.
-		std::queue<DIDEVICEOBJECTDATA> data_queue;
-		DIDEVICEOBJECTDATA data;
-		// Retrieve the data from the keyboard.
-		bool device_okay = dinput::RetrieveDeviceData(keyboard_device, data_queue);
+		// Retrieve the raw data from the keyboard.
+		DWORD count = DEVICE_BUFFER_SIZE;
+		const bool device_okay = dinput::RetrieveDeviceData(keyboard_device, device_data, count);
 		// Now process the raw data into input events.
-		const utility::input_events::InputEvent* key_event;
-		while(data_queue.empty() == false)
+		for(DWORD i = 0; i < count; ++i)
 		{
-			data = data_queue.front();
-			data_queue.pop();
+			const DIDEVICEOBJECTDATA& data = device_data[i];
 			// Was the key pressed or released?
-			bool pressed = ((data.dwData & 0x80) != 0) ? true : false;
-			// Add a new KeyboardEvent to the queue.
-			key_event = new(std::nothrow) utility::input_events::KeyboardEvent(dinput::DIKToKK(data.dwOfs), pressed);
-			if(key_event == nullptr)
-			{
-				throw utility::OutOfMemoryError();
-			}
-			try
-			{
-				queue.push(key_event);
-			}
-			catch(const std::bad_alloc&)
-			{
-				delete key_event;
-				throw utility::OutOfMemoryError();
-			}
-			catch(...)
-			{
-				delete key_event;
-				throw;
-			}
+			const bool pressed = ((data.dwData & 0x80) != 0) ? true : false;
+			buffer.Push(utility::input_events::PackKeyboardEvent(dinput::DIKToKK(data.dwOfs), pressed, data.dwTimeStamp));
 			// Save the internal key state.
 			keyboard_state[data.dwOfs] = (char)data.dwData;
 		}
 		// Now reset the device states if necessary.
 		if(device_okay == false)
 		{
-			ResetDeviceStates(queue);
+			ResetDeviceStates(buffer);
 		}
 	}
 
 
 	// See method declaration for details.
-	void DirectInputInputDevice::PollMouse(utility::input_events::InputQueue& queue)
+	void DirectInputInputDevice::PollMouse(utility::input_events::InputBuffer& buffer)
 	{
-		// These variables hold the raw data from the mouse.
-		std::queue<DIDEVICEOBJECTDATA> data_queue;
-		DIDEVICEOBJECTDATA data;
-		// Retrieve the data from the mouse.
-		bool device_okay = dinput::RetrieveDeviceData(mouse_device, data_queue);
+		// Retrieve the raw data from the mouse.
+		DWORD count = DEVICE_BUFFER_SIZE;
+		const bool device_okay = dinput::RetrieveDeviceData(mouse_device, device_data, count);
 		// Now process the raw data into input events.
-		DWORD current_event_data;
-		DWORD next_event_data;
-		utility::input_events::InputEvent* event = nullptr;
-		while(data_queue.empty() == false)
+		for(DWORD i = 0; i < count; ++i)
 		{
-			data = data_queue.front();
-			data_queue.pop();
+			const DIDEVICEOBJECTDATA& data = device_data[i];
 			// Figure out what kind of event we're dealing with.
 			switch(data.dwOfs)
 			{
 			case DIMOFS_X:
 				// ***Falls through***
 			case DIMOFS_Y:
-				// Mouse move event.
-				current_event_data = data.dwData;
-				next_event_data = 0;
-				// If data_queue isn't empty, see if we can combine this event and the next one.
-				if(data_queue.empty() == false && data_queue.front().dwSequence == data.dwSequence)
 				{
-					next_event_data = data_queue.front().dwData;
-					data_queue.pop();
+					// Mouse move event.
+					const short current_event_data = (short)data.dwData;
+					short next_event_data = 0;
+					// If the next element moves along the other axis at the same time, combine them.
+					const DWORD other_axis = (data.dwOfs == DIMOFS_X) ? DIMOFS_Y : DIMOFS_X;
+					if(i + 1 < count && device_data[i + 1].dwSequence == data.dwSequence && device_data[i + 1].dwOfs == other_axis)
+					{
+						next_event_data = (short)device_data[i + 1].dwData;
+						++i;
+					}
+					// Is current_event_data x movement or y movement?
+					buffer.Push((data.dwOfs == DIMOFS_X) ? utility::input_events::PackMouseMoveEvent(current_event_data, next_event_data, data.dwTimeStamp)
+						: utility::input_events::PackMouseMoveEvent(next_event_data, current_event_data, data.dwTimeStamp));
 				}
-				// Is current_event_data x movement or y movement?
-				event = (data.dwOfs == DIMOFS_X) ? new(std::nothrow) utility::input_events::MouseMoveEvent((short)current_event_data, (short)next_event_data) : new(std::nothrow) utility::input_events::MouseMoveEvent((short)next_event_data, (short)current_event_data);
 				break;
 			case DIMOFS_Z:
 				// Mouse wheel event.
-				event = new(std::nothrow) utility::input_events::MouseScrollEvent((short)data.dwOfs);
+				buffer.Push(utility::input_events::PackMouseScrollEvent((short)data.dwData, data.dwTimeStamp));
 				break;
 			default:
-				// Mouse button event.
-				const bool pressed = (data.dwData & 0x80) ? true : false;
-				event = new(std::nothrow) utility::input_events::MouseButtonEvent(dinput::DIKToMB(data.dwOfs), pressed);
-				// Save the internal button state. Have to get the index into the butter statuses.
-				mouse_button_state[data.dwOfs - DIMOFS_BUTTON0] = pressed;
+				{
+					// Mouse button event.
+					const bool pressed = (data.dwData & 0x80) ? true : false;
+					buffer.Push(utility::input_events::PackMouseButtonEvent(dinput::DIKToMB(data.dwOfs), pressed, data.dwTimeStamp));
+					// Save the internal button state. Have to get the index into the butter statuses.
+					mouse_button_state[data.dwOfs - DIMOFS_BUTTON0] = pressed;
+				}
 				break;
 			}
-			// Did we run out of memory?
-			if(event == nullptr)
-			{
-				throw utility::OutOfMemoryError();
-			}
-			try
-			{
-				queue.push(event);
-			}
-			catch(const std::bad_alloc&)
-			{
-				delete event;
-				throw utility::OutOfMemoryError();
-			}
-			catch(...)
-			{
-				delete event;
-				throw;
-			}
 		}
 		// Now reset the device states if necessary.
 		if(device_okay == false)
 		{
-			ResetDeviceStates(queue);
+			ResetDeviceStates(buffer);
 		}
 	}
 
@@ -27,8 +27,7 @@ Defines the interface for the input::DirectInputInputDevice class, which is used
 
 
 #include"..\input device\input device.h"
-#include"..\..\..\utility\src\input events\input events.h"
-#include<queue>
+#include"..\..\..\utility\src\input buffer\input buffer.h"
 #include<windows.h>
 // Defines the direct input version to avoid a compiler warning.
 #ifndef DIRECTINPUT_VERSION
@@ -44,6 +43,9 @@ namespace input
 {
 
 	/** Uses Direct Input to retrieve input events from the keyboard and mouse devices.
+	Each device's buffered data is read into an array which this object owns, and
+	converted straight into the caller's utility::input_events::InputBuffer, so polling
+	never allocates.
 	@todo Modify this class to also record the sequence ID of each input event, and then
 	sort the container which input events are stored in by that sequence ID.
 	@todo Extract the code which modifies indices into the mouse button state to be
@@ -61,41 +63,40 @@ namespace input
 		*/
 		~DirectInputInputDevice();
 
-		/** Polls for mouse and keyboard input and returns a queue of any new input
-		events. If there are no new inputs, then the returned queue will be empty.
-		@attention The returned queue contains pointers to the input events, but
-		calling this function does not give you ownership of these pointers. These
-		pointers will remain valid only until the next call to this function.
-		@return An utility::utility::input_events::InputQueue containing all InputEvents since the last call to PollInput()
-		or since this device was created.
+		/** Polls for mouse and keyboard input and appends any new input events to
+		\a buffer, stamped with the times which Direct Input reported for them.
+		@param buffer [IN/OUT] The buffer to append the events to.
 		*/
-		utility::input_events::InputQueue GetInput();
+		void GetInput(utility::input_events::InputBuffer& buffer);
 
 	private:
 
 		/** Resets the keyboard and mouse states so that any currently pressed keys or buttons
-		are released and appropriate InputEvents are generated.
+		are released and appropriate input events are generated.
 		@post For each \c true value in the \ref keyboard_state and \ref mouse_button_state arrays,
-		that value will be set to \c false and an appropriate InputEvent will be added to
-		\a queue to indicate that the key/button is considered released.
-		@param queue A queue into which any InputEvents should be inserted.
+		that value will be set to \c false and an appropriate input event will be added to
+		\a buffer to indicate that the key/button is considered released.
+		@param buffer A buffer into which any input events should be inserted.
 		*/
-		void ResetDeviceStates(utility::input_events::InputQueue& queue);
+		void ResetDeviceStates(utility::input_events::InputBuffer& buffer);
 		/** Attempts to poll the keyboard for new input data. Any new input events
-		are appended to \a queue.
-		@param queue A queue into which any InputEvents should be inserted.
+		are appended to \a buffer.
+		@param buffer A buffer into which any input events should be inserted.
 		*/
-		void PollKeyboard(utility::input_events::InputQueue& queue);
+		void PollKeyboard(utility::input_events::InputBuffer& buffer);
 		/** Attempts to poll the mouse for new input data. Any new input events
-		are appended to queue.
-		@param queue A queue into which any InputEvents should be inserted.
+		are appended to \a buffer.
+		@param buffer A buffer into which any input events should be inserted.
 		*/
-		void PollMouse(utility::input_events::InputQueue& queue);
+		void PollMouse(utility::input_events::InputBuffer& buffer);
 
 		/** Releases any acquired resources.
 		*/
 		void ReleaseResources();
 
+		/// The number of elements which each device buffers between polls.
+		static const DWORD DEVICE_BUFFER_SIZE = 30;
+
 		/// The handle of the window receiving input.
 		const HWND window_handle;
 
@@ -113,6 +114,8 @@ namespace input
 		down whent he device is lost so that button-release messages can be
 		sent.*/
 		bool mouse_button_state[8];
+		/// Receives the buffered data of whichever device is being polled.
+		DIDEVICEOBJECTDATA device_data[DEVICE_BUFFER_SIZE];
 
 
 		/// Not implemented.
@@ -26,8 +26,7 @@ interface.
 @todo Document this component.
 */
 
-#include"..\..\..\utility\src\input events\input events.h"
-#include<queue>
+#include"..\..\..\utility\src\input buffer\input buffer.h"
 
 namespace avl
 {
@@ -43,11 +42,13 @@ namespace input
 		InputDevice();
 		virtual ~InputDevice();
 
-		/**	@return The queue of input events which have occurred
-		since this instance was created or since the last call to
-		this method.
+		/** Appends the input events which have occurred since this instance was
+		created or since the last call to this method to \a buffer. Events which
+		don't fit in \a buffer are dropped; see
+		utility::input_events::InputBuffer::GetDroppedCount().
+		@param buffer [IN/OUT] The buffer to append the events to.
 		*/
-		virtual utility::input_events::InputQueue GetInput() = 0;
+		virtual void GetInput(utility::input_events::InputBuffer& buffer) = 0;
 
 	private:
 		/// NOT IMPLEMENTED.
@@ -0,0 +1,388 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the input recording component. See "input recording.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"input recording.h"
+#include"..\..\..\utility\src\input events\input events.h"
+#include"..\..\..\utility\src\key codes\key codes.h"
+#include"..\..\..\utility\src\file operations\file operations.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include<fstream>
+#include<string>
+#include<cstring>
+#include<new>
+
+
+namespace avl
+{
+namespace input
+{
+	// See method definitions for details.
+	namespace
+	{
+		/// The version of the file format written.
+		const unsigned int VERSION = 1;
+		/// The size of the magic number, version, and frame count.
+		const std::size_t HEADER_SIZE = 12;
+		/// The offset of the frame count.
+		const std::size_t FRAME_COUNT_OFFSET = 8;
+		/// The size of a frame's number and event count.
+		const std::size_t FRAME_HEADER_SIZE = 8;
+		/// The size of an event.
+		const std::size_t EVENT_SIZE = 9;
+
+		void Write16(char* const destination, const unsigned short value);
+		void Write32(char* const destination, const unsigned int value);
+		const unsigned short Read16(const char* const source);
+		const unsigned int Read32(const char* const source);
+		void EncodeEvent(char* const destination, const utility::input_events::PackedInputEvent& event);
+		const bool DecodeEvent(const char* const source, utility::input_events::PackedInputEvent& event);
+	}
+
+
+
+	// See method declaration for details.
+	RecordingInputDevice::RecordingInputDevice(InputDevice& device, const std::string& file_name)
+		: device(device), file_name(file_name), frame_count(0)
+	{
+		file.exceptions(std::ios::goodbit);
+		file.open(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+		if(file.fail() == true)
+		{
+			throw utility::FileNotFoundException(file_name);
+		}
+		// The frame count is filled in by Close().
+		char header[HEADER_SIZE];
+		memcpy(&header[0], "AVLI", 4);
+		Write32(&header[4], VERSION);
+		Write32(&header[FRAME_COUNT_OFFSET], 0);
+		file.write(header, HEADER_SIZE);
+		if(file.bad() == true)
+		{
+			file.close();
+			throw utility::FileWriteException(file_name);
+		}
+	}
+
+	// See method declaration for details.
+	RecordingInputDevice::~RecordingInputDevice()
+	{
+		try
+		{
+			Close();
+		}
+		catch(...)
+		{
+		}
+	}
+
+	// See method declaration for details.
+	void RecordingInputDevice::GetInput(utility::input_events::InputBuffer& buffer)
+	{
+		if(file.is_open() == false)
+		{
+			throw utility::InvalidCallException("avl::input::RecordingInputDevice::GetInput()", "The file has already been closed.");
+		}
+		// Only the events which the device adds belong to this frame.
+		const std::size_t first = buffer.GetSize();
+		device.GetInput(buffer);
+		const std::size_t event_count = buffer.GetSize() - first;
+		const unsigned int frame = frame_count++;
+		if(event_count == 0)
+		{
+			return;
+		}
+		const std::size_t record_size = FRAME_HEADER_SIZE + event_count * EVENT_SIZE;
+		if(record.size() < record_size)
+		{
+			try
+			{
+				record.resize(record_size);
+			}
+			catch(const std::bad_alloc&)
+			{
+				throw utility::OutOfMemoryError();
+			}
+		}
+		Write32(&record[0], frame);
+		Write32(&record[4], static_cast<unsigned int>(event_count));
+		for(std::size_t i = 0; i < event_count; ++i)
+		{
+			EncodeEvent(&record[FRAME_HEADER_SIZE + i * EVENT_SIZE], buffer[first + i]);
+		}
+		file.write(&record[0], record_size);
+		if(file.bad() == true)
+		{
+			throw utility::FileWriteException(file_name);
+		}
+	}
+
+	// See method declaration for details.
+	void RecordingInputDevice::Close()
+	{
+		if(file.is_open() == false)
+		{
+			return;
+		}
+		char count[4];
+		Write32(count, frame_count);
+		file.seekp(FRAME_COUNT_OFFSET);
+		file.write(count, 4);
+		const bool is_bad = file.bad();
+		file.close();
+		if(is_bad == true)
+		{
+			throw utility::FileWriteException(file_name);
+		}
+	}
+
+	// See method declaration for details.
+	const unsigned int RecordingInputDevice::GetFrameCount() const
+	{
+		return frame_count;
+	}
+
+
+
+	// See method declaration for details.
+	ReplayInputDevice::ReplayInputDevice(const std::string& file_name)
+		: frame_count(0), frame_number(0), next_frame(0)
+	{
+		std::vector<char> data;
+		utility::LoadFile(file_name, data);
+		if(data.size() < HEADER_SIZE || memcmp(&data[0], "AVLI", 4) != 0 || Read32(&data[4]) != VERSION)
+		{
+			throw utility::FileFormatException(file_name);
+		}
+		frame_count = Read32(&data[FRAME_COUNT_OFFSET]);
+		// Every frame and event is checked now, so that playing them back can't fail.
+		std::size_t position = HEADER_SIZE;
+		while(position < data.size())
+		{
+			if(data.size() - position < FRAME_HEADER_SIZE)
+			{
+				throw utility::FileFormatException(file_name);
+			}
+			Frame frame;
+			frame.number = Read32(&data[position]);
+			frame.first = events.size();
+			frame.count = Read32(&data[position + 4]);
+			position += FRAME_HEADER_SIZE;
+			const bool is_in_order = frames.empty() == true || frame.number > frames.back().number;
+			if(is_in_order == false || frame.number >= frame_count || frame.count == 0
+				|| frame.count > (data.size() - position) / EVENT_SIZE)
+			{
+				throw utility::FileFormatException(file_name);
+			}
+			try
+			{
+				frames.push_back(frame);
+				events.resize(frame.first + frame.count);
+			}
+			catch(const std::bad_alloc&)
+			{
+				throw utility::OutOfMemoryError();
+			}
+			for(std::size_t i = 0; i < frame.count; ++i, position += EVENT_SIZE)
+			{
+				if(DecodeEvent(&data[position], events[frame.first + i]) == false)
+				{
+					throw utility::FileFormatException(file_name);
+				}
+			}
+		}
+	}
+
+	// See method declaration for details.
+	ReplayInputDevice::~ReplayInputDevice()
+	{
+	}
+
+	// See method declaration for details.
+	void ReplayInputDevice::GetInput(utility::input_events::InputBuffer& buffer)
+	{
+		if(IsFinished() == true)
+		{
+			return;
+		}
+		if(next_frame < frames.size() && frames[next_frame].number == frame_number)
+		{
+			const Frame& frame = frames[next_frame];
+			for(std::size_t i = 0; i < frame.count; ++i)
+			{
+				buffer.Push(events[frame.first + i]);
+			}
+			++next_frame;
+		}
+		++frame_number;
+	}
+
+	// See method declaration for details.
+	void ReplayInputDevice::Rewind()
+	{
+		frame_number = 0;
+		next_frame = 0;
+	}
+
+	// See method declaration for details.
+	const bool ReplayInputDevice::IsFinished() const
+	{
+		return frame_number >= frame_count;
+	}
+
+	// See method declaration for details.
+	const unsigned int ReplayInputDevice::GetFrameNumber() const
+	{
+		return frame_number;
+	}
+
+	// See method declaration for details.
+	const unsigned int ReplayInputDevice::GetFrameCount() const
+	{
+		return frame_count;
+	}
+
+
+
+	// Anonymous namespace.
+	namespace
+	{
+		/** Writes a 16-bit little-endian value.
+		@param destination [OUT] Receives the value.
+		@param value The value.
+		*/
+		void Write16(char* const destination, const unsigned short value)
+		{
+			destination[0] = static_cast<char>(value & 0xFF);
+			destination[1] = static_cast<char>(value >> 8);
+		}
+
+
+
+		/** Writes a 32-bit little-endian value.
+		@param destination [OUT] Receives the value.
+		@param value The value.
+		*/
+		void Write32(char* const destination, const unsigned int value)
+		{
+			Write16(destination, static_cast<unsigned short>(value & 0xFFFF));
+			Write16(destination + 2, static_cast<unsigned short>(value >> 16));
+		}
+
+
+
+		/** Reads a 16-bit little-endian value.
+		@param source The value's first byte.
+		@return The value.
+		*/
+		const unsigned short Read16(const char* const source)
+		{
+			const unsigned char* const bytes = reinterpret_cast<const unsigned char*>(source);
+			return static_cast<unsigned short>(bytes[0] | (bytes[1] << 8));
+		}
+
+
+
+		/** Reads a 32-bit little-endian value.
+		@param source The value's first byte.
+		@return The value.
+		*/
+		const unsigned int Read32(const char* const source)
+		{
+			return Read16(source) | (static_cast<unsigned int>(Read16(source + 2)) << 16);
+		}
+
+
+
+		/** Writes an event in the file's format.
+		@param destination [OUT] Receives the event's \ref EVENT_SIZE bytes.
+		@param event The event.
+		*/
+		void EncodeEvent(char* const destination, const utility::input_events::PackedInputEvent& event)
+		{
+			using namespace utility::input_events;
+			unsigned short first = 0;
+			unsigned short second = 0;
+			if(event.type == KeyboardEvent::KEYBOARD_TYPE || event.type == MouseButtonEvent::MOUSE_BUTTON_TYPE)
+			{
+				first = event.key.code;
+				second = event.key.is_pressed == true ? 1 : 0;
+			}
+			else if(event.type == MouseMoveEvent::MOUSE_MOVE_TYPE)
+			{
+				first = static_cast<unsigned short>(event.move.delta_x);
+				second = static_cast<unsigned short>(event.move.delta_y);
+			}
+			else
+			{
+				ASSERT(event.type == MouseScrollEvent::MOUSE_SCROLL_TYPE);
+				first = static_cast<unsigned short>(event.scroll.delta);
+			}
+			destination[0] = static_cast<char>(event.type);
+			Write16(destination + 1, first);
+			Write16(destination + 3, second);
+			Write32(destination + 5, event.timestamp);
+		}
+
+
+
+		/** Reads an event in the file's format.
+		@param source The event's \ref EVENT_SIZE bytes.
+		@param event [OUT] Receives the event.
+		@return False if the event has an unknown type.
+		*/
+		const bool DecodeEvent(const char* const source, utility::input_events::PackedInputEvent& event)
+		{
+			using namespace utility::input_events;
+			const unsigned char type = static_cast<unsigned char>(source[0]);
+			const unsigned short first = Read16(source + 1);
+			const unsigned short second = Read16(source + 3);
+			const unsigned int timestamp = Read32(source + 5);
+			if(type == KeyboardEvent::KEYBOARD_TYPE)
+			{
+				event = PackKeyboardEvent(static_cast<utility::key_codes::KeyboardKey::KeyboardKeyCodes>(first), second != 0, timestamp);
+			}
+			else if(type == MouseButtonEvent::MOUSE_BUTTON_TYPE)
+			{
+				event = PackMouseButtonEvent(static_cast<utility::key_codes::MouseButton::MouseButtonCodes>(first), second != 0, timestamp);
+			}
+			else if(type == MouseMoveEvent::MOUSE_MOVE_TYPE)
+			{
+				event = PackMouseMoveEvent(static_cast<short>(first), static_cast<short>(second), timestamp);
+			}
+			else if(type == MouseScrollEvent::MOUSE_SCROLL_TYPE)
+			{
+				event = PackMouseScrollEvent(static_cast<short>(first), timestamp);
+			}
+			else
+			{
+				return false;
+			}
+			return true;
+		}
+	}
+
+
+
+} // input
+} // avl
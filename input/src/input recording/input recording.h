@@ -0,0 +1,188 @@
+#pragma once
+#ifndef AVL_INPUT_INPUT_RECORDING__
+#define AVL_INPUT_INPUT_RECORDING__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Defines the \ref avl::input::RecordingInputDevice class, which writes the input from
+another device to a file, and the \ref avl::input::ReplayInputDevice class, which plays
+such a file back.
+@par Frames:
+Each call to \ref avl::input::InputDevice::GetInput() is one frame. A recording keeps
+the events which each frame received, and a replay hands out the same events on the
+same frames, so a scene run on a fixed timestep sees exactly the input it saw when it
+was recorded, without any input hardware.
+@par File format:
+All values are little-endian. The file begins with the 4 bytes "AVLI", a 32-bit
+version, and the 32-bit number of frames recorded. Then, for each frame which
+received any events, come its 32-bit frame number and 32-bit event count, followed by
+that many 9-byte events: an 8-bit type, two 16-bit fields, and a 32-bit timestamp.
+Frames without events take no space.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"..\input device\input device.h"
+#include"..\..\..\utility\src\input buffer\input buffer.h"
+#include<fstream>
+#include<string>
+#include<vector>
+#include<cstddef>
+
+
+namespace avl
+{
+namespace input
+{
+
+	/**
+	Passes the input from another device through unchanged, writing the events which each
+	frame receives to a file which \ref ReplayInputDevice can play back.
+	*/
+	class RecordingInputDevice: public InputDevice
+	{
+	public:
+		/** Creates the file and writes its header.
+		@param device The device to record. Must outlive this object.
+		@param file_name The name of the file to write. It's overwritten if it exists.
+		@throws FileNotFoundException If the file can't be created.
+		@throws FileWriteException If the header can't be written.
+		*/
+		RecordingInputDevice(InputDevice& device, const std::string& file_name);
+
+		/** Closes the file, if it hasn't been closed already. Errors are ignored; call
+		\ref Close() to find out about them.
+		*/
+		~RecordingInputDevice();
+
+		/** Gets the input from the recorded device and appends the events which it added
+		to \a buffer to the file, as the next frame.
+		@param buffer [IN/OUT] The buffer to append the events to.
+		@throws InvalidCallException If the file has been closed.
+		@throws FileWriteException If the events can't be written.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		void GetInput(utility::input_events::InputBuffer& buffer);
+
+		/** Fills in the number of frames in the file's header and closes it.
+		@throws FileWriteException If the header can't be updated.
+		*/
+		void Close();
+
+		/** Counts the frames recorded so far.
+		@return The number of frames.
+		*/
+		const unsigned int GetFrameCount() const;
+
+	private:
+		/// The device being recorded.
+		InputDevice& device;
+		/// The name of the file.
+		const std::string file_name;
+		/// The file being written.
+		std::ofstream file;
+		/// The number of frames recorded.
+		unsigned int frame_count;
+		/// Holds each frame's record once encoded.
+		std::vector<char> record;
+
+		/// NOT IMPLEMENTED.
+		RecordingInputDevice(const RecordingInputDevice&);
+		/// NOT IMPLEMENTED.
+		const RecordingInputDevice& operator=(const RecordingInputDevice&);
+	};
+
+
+
+	/**
+	Plays back a file written by \ref RecordingInputDevice, frame by frame. Once every
+	recorded frame has been played, further frames receive no events.
+	*/
+	class ReplayInputDevice: public InputDevice
+	{
+	public:
+		/** Reads and checks the whole recording.
+		@param file_name The name of the file to play back.
+		@throws FileNotFoundException If the file doesn't exist.
+		@throws FileReadException If the file can't be read.
+		@throws FileFormatException If the file isn't a valid recording.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		ReplayInputDevice(const std::string& file_name);
+
+		/** Basic destructor.*/
+		~ReplayInputDevice();
+
+		/** Appends the events recorded for the next frame to \a buffer.
+		@param buffer [IN/OUT] The buffer to append the events to.
+		*/
+		void GetInput(utility::input_events::InputBuffer& buffer);
+
+		/** Starts the playback over from the first frame.
+		*/
+		void Rewind();
+
+		/** Tells whether every recorded frame has been played.
+		@return True if the playback is finished.
+		*/
+		const bool IsFinished() const;
+
+		/** Accesses the number of the next frame to be played.
+		@return The number of frames played since the playback started.
+		*/
+		const unsigned int GetFrameNumber() const;
+
+		/** Accesses the number of frames in the recording.
+		@return The number of frames.
+		*/
+		const unsigned int GetFrameCount() const;
+
+	private:
+		/// A recorded frame which received events.
+		struct Frame
+		{
+			/// The frame's number.
+			unsigned int number;
+			/// The index in \ref events of the frame's first event.
+			std::size_t first;
+			/// The number of events the frame received.
+			std::size_t count;
+		};
+
+		/// The events from every frame, in order.
+		std::vector<utility::input_events::PackedInputEvent> events;
+		/// The frames which received events, in order.
+		std::vector<Frame> frames;
+		/// The number of frames in the recording.
+		unsigned int frame_count;
+		/// The number of the next frame to be played.
+		unsigned int frame_number;
+		/// The index in \ref frames of the next frame with events.
+		std::size_t next_frame;
+
+		/// NOT IMPLEMENTED.
+		ReplayInputDevice(const ReplayInputDevice&);
+		/// NOT IMPLEMENTED.
+		const ReplayInputDevice& operator=(const ReplayInputDevice&);
+	};
+
+
+
+} // input
+} // avl
+#endif // AVL_INPUT_INPUT_RECORDING__
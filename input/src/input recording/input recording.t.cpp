@@ -0,0 +1,211 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the input recording component. See "input recording.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"input recording.h"
+#include"..\..\..\utility\src\input buffer\input buffer.h"
+#include"..\..\..\utility\src\input events\input events.h"
+#include"..\..\..\utility\src\key codes\key codes.h"
+#include"..\..\..\utility\src\file operations\file operations.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include"..\..\..\utility\src\timer\timer.h"
+#include<iostream>
+#include<vector>
+#include<cstdlib>
+#include<cstring>
+
+
+
+namespace
+{
+	using namespace avl::utility::input_events;
+
+	/**
+	Stands in for an input device: each frame, it produces a scripted mix of events, and
+	none at all on every third frame.
+	*/
+	class ScriptedInputDevice: public avl::input::InputDevice
+	{
+	public:
+		ScriptedInputDevice(): frame(0) {}
+
+		void GetInput(InputBuffer& buffer)
+		{
+			using avl::utility::key_codes::KeyboardKey;
+			using avl::utility::key_codes::MouseButton;
+			const unsigned int timestamp = frame * 16;
+			if(frame % 3 != 2)
+			{
+				buffer.Push(PackKeyboardEvent(KeyboardKey::kk_w, frame % 2 == 0, timestamp));
+				buffer.Push(PackMouseMoveEvent(static_cast<short>(frame), -static_cast<short>(frame), timestamp + 1));
+				if(frame % 5 == 0)
+				{
+					buffer.Push(PackMouseButtonEvent(MouseButton::mb_left, true, timestamp + 2));
+					buffer.Push(PackMouseScrollEvent(-120, timestamp + 3));
+				}
+			}
+			++frame;
+		}
+
+	private:
+		unsigned int frame;
+	};
+
+
+
+	/** Tells whether two packed events are the same event.
+	*/
+	const bool IsSameEvent(const PackedInputEvent& first, const PackedInputEvent& second)
+	{
+		if(first.type != second.type || first.timestamp != second.timestamp)
+		{
+			return false;
+		}
+		if(first.type == MouseMoveEvent::MOUSE_MOVE_TYPE)
+		{
+			return first.move.delta_x == second.move.delta_x && first.move.delta_y == second.move.delta_y;
+		}
+		if(first.type == MouseScrollEvent::MOUSE_SCROLL_TYPE)
+		{
+			return first.scroll.delta == second.scroll.delta;
+		}
+		return first.key.code == second.key.code && first.key.is_pressed == second.key.is_pressed;
+	}
+}
+
+
+
+void TestInputRecordingComponent()
+{
+	using avl::input::RecordingInputDevice;
+	using avl::input::ReplayInputDevice;
+	using avl::utility::Timer;
+
+	const unsigned int frame_count = 100;
+
+	// A replay produces the same events, on the same frames, as the recorded device did.
+	{
+		{
+			ScriptedInputDevice scripted;
+			RecordingInputDevice recorder(scripted, "assets/input recording.avli");
+			InputBuffer buffer;
+			for(unsigned int frame = 0; frame < frame_count; ++frame)
+			{
+				// Events left over from earlier frames aren't recorded again.
+				if(frame % 4 == 0)
+				{
+					buffer.Clear();
+				}
+				recorder.GetInput(buffer);
+			}
+			ASSERT(recorder.GetFrameCount() == frame_count);
+		}
+		ReplayInputDevice replay("assets/input recording.avli");
+		ASSERT(replay.GetFrameCount() == frame_count && replay.IsFinished() == false);
+		for(unsigned int pass = 0; pass < 2; ++pass)
+		{
+			ScriptedInputDevice original;
+			InputBuffer expected;
+			InputBuffer replayed;
+			for(unsigned int frame = 0; frame < frame_count; ++frame)
+			{
+				ASSERT(replay.GetFrameNumber() == frame);
+				expected.Clear();
+				replayed.Clear();
+				original.GetInput(expected);
+				replay.GetInput(replayed);
+				ASSERT(replayed.GetSize() == expected.GetSize());
+				for(std::size_t i = 0; i < expected.GetSize(); ++i)
+				{
+					ASSERT(IsSameEvent(replayed[i], expected[i]) == true);
+				}
+			}
+			ASSERT(replay.IsFinished() == true);
+			replayed.Clear();
+			replay.GetInput(replayed);
+			ASSERT(replayed.IsEmpty() == true && replay.GetFrameNumber() == frame_count);
+			replay.Rewind();
+		}
+		std::cout << "Replays match their recordings frame by frame.\n";
+	}
+
+	// Files which aren't complete recordings are refused.
+	{
+		std::vector<char> data;
+		avl::utility::LoadFile("assets/input recording.avli", data);
+		unsigned int refused_count = 0;
+		std::vector<char> corrupt(data.begin(), data.begin() + 8);
+		avl::utility::WriteFile("assets/input recording corrupt.avli", corrupt);
+		try { ReplayInputDevice replay("assets/input recording corrupt.avli"); } catch(const avl::utility::FileFormatException&) { ++refused_count; }
+		corrupt.assign(data.begin(), data.end() - 1);
+		avl::utility::WriteFile("assets/input recording corrupt.avli", corrupt);
+		try { ReplayInputDevice replay("assets/input recording corrupt.avli"); } catch(const avl::utility::FileFormatException&) { ++refused_count; }
+		corrupt = data;
+		memcpy(&corrupt[0], "AVLX", 4);
+		avl::utility::WriteFile("assets/input recording corrupt.avli", corrupt);
+		try { ReplayInputDevice replay("assets/input recording corrupt.avli"); } catch(const avl::utility::FileFormatException&) { ++refused_count; }
+		// The first event's type.
+		corrupt = data;
+		corrupt[20] = 0;
+		avl::utility::WriteFile("assets/input recording corrupt.avli", corrupt);
+		try { ReplayInputDevice replay("assets/input recording corrupt.avli"); } catch(const avl::utility::FileFormatException&) { ++refused_count; }
+		// The frame count, so that the last frame lies beyond it.
+		corrupt = data;
+		corrupt[8] = static_cast<char>(frame_count - 2);
+		avl::utility::WriteFile("assets/input recording corrupt.avli", corrupt);
+		try { ReplayInputDevice replay("assets/input recording corrupt.avli"); } catch(const avl::utility::FileFormatException&) { ++refused_count; }
+		ASSERT(refused_count == 5);
+		std::cout << "Corrupt recordings are refused.\n";
+	}
+
+	// The cost of recording and of replaying a frame.
+	{
+		const unsigned int benchmark_frames = 10000;
+		InputBuffer buffer;
+		Timer timer;
+		{
+			ScriptedInputDevice scripted;
+			RecordingInputDevice recorder(scripted, "assets/input recording benchmark.avli");
+			for(unsigned int frame = 0; frame < benchmark_frames; ++frame)
+			{
+				buffer.Clear();
+				recorder.GetInput(buffer);
+			}
+		}
+		const double record_time = timer.Reset();
+		ReplayInputDevice replay("assets/input recording benchmark.avli");
+		const double load_time = timer.Reset();
+		while(replay.IsFinished() == false)
+		{
+			buffer.Clear();
+			replay.GetInput(buffer);
+		}
+		const double replay_time = timer.Elapsed();
+		std::cout << "Microseconds per frame over " << benchmark_frames << " frames:\n"
+			<< "  recording " << record_time * 1000000.0 / benchmark_frames << "\n"
+			<< "  loading   " << load_time * 1000000.0 / benchmark_frames << "\n"
+			<< "  replaying " << replay_time * 1000000.0 / benchmark_frames << "\n";
+	}
+
+	system("pause");
+}
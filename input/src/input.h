@@ -25,5 +25,6 @@ Includes the core components of the input subsystem.
 */
 
 #include"input device\input device.h"
+#include"input recording\input recording.h"
 
 #endif // AVL_INPUT_SUBSYSTEM__
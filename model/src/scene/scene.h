@@ -26,7 +26,7 @@ Defines the Scene interface.
 
 #include"..\..\..\utility\src\graphic\graphic.h"
 #include"..\..\..\utility\src\sound effect\sound effect.h"
-#include"..\..\..\utility\src\input events\input events.h"
+#include"..\..\..\utility\src\input buffer\input buffer.h"
 
 
 namespace avl
@@ -53,9 +53,12 @@ namespace model
 		virtual utility::SoundEffectList GetSoundEffects() = 0;
 		
 		/** Applies input actions to the model space as is
-		appropriate.
+		appropriate. The events are read in place, and popped once handled.
+		@param input [IN/OUT] The input events since the last call, oldest first.
+		Code written against the utility::input_events::InputEvent classes may
+		convert them with utility::input_events::ToInputQueue().
 		*/
-		virtual void ProcessInput(utility::input_events::InputQueue& input) = 0;
+		virtual void ProcessInput(utility::input_events::InputBuffer& input) = 0;
 		
 		/** Updates the scene.
 		*/
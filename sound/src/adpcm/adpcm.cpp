@@ -0,0 +1,599 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the adpcm component. See "adpcm.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"adpcm.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include<vector>
+#include<memory>
+#include<algorithm>
+#include<cstring>
+#include<cstdlib>
+#include<new>
+
+
+namespace avl
+{
+namespace sound
+{
+	// See method definitions for details.
+	namespace
+	{
+		/// The size of an IMA ADPCM block header, per channel.
+		const std::size_t IMA_HEADER_SIZE = 4;
+		/// The number of bytes of each channel which are grouped together in an IMA ADPCM block.
+		const std::size_t IMA_GROUP_SIZE = 4;
+		/// The largest IMA ADPCM step index.
+		const int IMA_MAX_INDEX = 88;
+		/// The IMA ADPCM quantizer step sizes.
+		const int IMA_STEPS[IMA_MAX_INDEX + 1] =
+		{
+			7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+			130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060,
+			1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484,
+			7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+		};
+		/// How each IMA ADPCM nibble moves the step index.
+		const int IMA_INDEX_ADJUSTMENTS[16] = {-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8};
+
+		/// The size of a Microsoft ADPCM block header, per channel.
+		const std::size_t MS_HEADER_SIZE = 7;
+		/// The number of standard Microsoft ADPCM predictors.
+		const unsigned int MS_PREDICTOR_COUNT = 7;
+		/// The coefficients of each standard Microsoft ADPCM predictor, in 8.8 fixed point.
+		const int MS_COEFFICIENTS[MS_PREDICTOR_COUNT][2] = {{256, 0}, {512, -256}, {0, 0}, {192, 64}, {240, 0}, {460, -208}, {392, -232}};
+		/// How each Microsoft ADPCM nibble scales the delta, in 8.8 fixed point.
+		const int MS_ADAPTATIONS[16] = {230, 230, 230, 230, 307, 409, 512, 614, 768, 614, 512, 409, 307, 230, 230, 230};
+		/// The smallest Microsoft ADPCM delta.
+		const int MS_MIN_DELTA = 16;
+		/// The largest Microsoft ADPCM delta, past which it could overflow.
+		const int MS_MAX_DELTA = 0x7FFFFFFF / 768;
+
+		/**
+		The state of a Microsoft ADPCM channel.
+		*/
+		struct MSChannel
+		{
+			/// The predictor coefficients.
+			int coefficient1;
+			/// See \ref coefficient1.
+			int coefficient2;
+			/// The quantizer step.
+			int delta;
+			/// The last sample.
+			int sample1;
+			/// The sample before \ref sample1.
+			int sample2;
+		};
+
+		const std::size_t DecodeIMABlock(const unsigned char* const block, const std::size_t block_size, const unsigned short channel_count, short* const frames);
+		const std::size_t DecodeMSBlock(const unsigned char* const block, const std::size_t block_size, const unsigned short channel_count, short* const frames);
+		const std::size_t EncodeIMABlock(const short* const frames, const std::size_t frame_count, const std::size_t block_frames, const unsigned short channel_count,
+			std::vector<int>& indices, unsigned char* const block);
+		const std::size_t EncodeMSBlock(const short* const frames, const std::size_t frame_count, const unsigned short channel_count, unsigned char* const block);
+		const int DecodeIMANibble(const unsigned int nibble, int& predictor, int& index);
+		const unsigned int EncodeIMANibble(const int sample, int& predictor, int& index);
+		const int DecodeMSNibble(const unsigned int nibble, MSChannel& channel);
+		const unsigned int EncodeMSNibble(const int sample, MSChannel& channel);
+		const short ReadShort(const unsigned char* const data);
+		void WriteShort(const int value, unsigned char* const data);
+		const int Clamp(const int value, const int minimum, const int maximum);
+	}
+
+
+
+	// See function declaration for details.
+	const std::size_t GetADPCMBlockFrames(const SoundSample::Encoding encoding, const unsigned short block_alignment, const unsigned short channel_count)
+	{
+		if(encoding == SoundSample::IMA_ADPCM && channel_count > 0)
+		{
+			// A header, then whole groups of 8 samples for each channel.
+			const std::size_t header_size = IMA_HEADER_SIZE * channel_count;
+			if(block_alignment <= header_size || (block_alignment - header_size) % (IMA_GROUP_SIZE * channel_count) != 0)
+			{
+				return 0;
+			}
+			return (block_alignment - header_size) / (IMA_GROUP_SIZE * channel_count) * 8 + 1;
+		}
+		if(encoding == SoundSample::MS_ADPCM && (channel_count == 1 || channel_count == 2))
+		{
+			// A header holding two frames, then a nibble per sample.
+			const std::size_t header_size = MS_HEADER_SIZE * channel_count;
+			if(block_alignment < header_size)
+			{
+				return 0;
+			}
+			return (block_alignment - header_size) * 2 / channel_count + 2;
+		}
+		return 0;
+	}
+
+	// See function declaration for details.
+	const std::size_t GetADPCMFrameCount(const SoundSample::Encoding encoding, const unsigned short block_alignment, const unsigned short channel_count, const std::size_t data_size)
+	{
+		const std::size_t block_frames = GetADPCMBlockFrames(encoding, block_alignment, channel_count);
+		if(block_frames == 0)
+		{
+			return 0;
+		}
+		std::size_t frame_count = data_size / block_alignment * block_frames;
+		// The last block may be short, but still needs its header.
+		const std::size_t remainder = data_size % block_alignment;
+		if(encoding == SoundSample::IMA_ADPCM && remainder >= IMA_HEADER_SIZE * channel_count)
+		{
+			frame_count += (remainder - IMA_HEADER_SIZE * channel_count) / (IMA_GROUP_SIZE * channel_count) * 8 + 1;
+		}
+		else if(encoding == SoundSample::MS_ADPCM && remainder >= MS_HEADER_SIZE * channel_count)
+		{
+			frame_count += (remainder - MS_HEADER_SIZE * channel_count) * 2 / channel_count + 2;
+		}
+		return frame_count;
+	}
+
+	// See function declaration for details.
+	const std::size_t DecodeADPCMBlock(const SoundSample::Encoding encoding, const char* const block, const std::size_t block_size, const unsigned short channel_count, short* const frames)
+	{
+		if(encoding == SoundSample::IMA_ADPCM)
+		{
+			return DecodeIMABlock(reinterpret_cast<const unsigned char*>(block), block_size, channel_count, frames);
+		}
+		ASSERT(encoding == SoundSample::MS_ADPCM);
+		return DecodeMSBlock(reinterpret_cast<const unsigned char*>(block), block_size, channel_count, frames);
+	}
+
+	// See function declaration for details.
+	SoundSample DecodeADPCMSample(const SoundSample& sample)
+	{
+		if(sample.GetEncoding() == SoundSample::PCM)
+		{
+			return sample;
+		}
+		const unsigned short channel_count = sample.GetNumberOfChannels();
+		const std::size_t block_frames = GetADPCMBlockFrames(sample.GetEncoding(), sample.GetBlockAlignment(), channel_count);
+		if(block_frames == 0)
+		{
+			throw utility::InvalidArgumentException("avl::sound::DecodeADPCMSample()", "sample", "Has an unsupported block layout.");
+		}
+		const std::size_t frame_count = sample.GetFrameCount();
+		if(GetADPCMFrameCount(sample.GetEncoding(), sample.GetBlockAlignment(), channel_count, sample.GetDataSize()) < frame_count)
+		{
+			throw utility::InvalidArgumentException("avl::sound::DecodeADPCMSample()", "sample", "Holds fewer frames than it claims to.");
+		}
+
+		const std::size_t data_size = frame_count * channel_count * 2;
+		char* const audio_data = new(std::nothrow) char[data_size];
+		if(audio_data == nullptr)
+		{
+			throw utility::OutOfMemoryError();
+		}
+		short* const frames = reinterpret_cast<short*>(audio_data);
+		try
+		{
+			// Blocks which would run past the end are decoded to the side first.
+			std::vector<short> last_block(block_frames * channel_count);
+			for(std::size_t frame = 0, offset = 0; frame < frame_count; frame += block_frames, offset += sample.GetBlockAlignment())
+			{
+				const std::size_t block_size = std::min<std::size_t>(sample.GetBlockAlignment(), sample.GetDataSize() - offset);
+				if(frame_count - frame >= block_frames)
+				{
+					DecodeADPCMBlock(sample.GetEncoding(), &sample.GetAudioData()[offset], block_size, channel_count, &frames[frame * channel_count]);
+				}
+				else
+				{
+					DecodeADPCMBlock(sample.GetEncoding(), &sample.GetAudioData()[offset], block_size, channel_count, &last_block[0]);
+					memcpy(&frames[frame * channel_count], &last_block[0], (frame_count - frame) * channel_count * 2);
+				}
+			}
+		}
+		catch(const std::bad_alloc&)
+		{
+			delete[] audio_data;
+			throw utility::OutOfMemoryError();
+		}
+		return SoundSample(16, sample.GetFrequency(), channel_count, data_size, audio_data);
+	}
+
+	// See function declaration for details.
+	SoundSample EncodeADPCM(const SoundSample::Encoding encoding, const short* const frames, const std::size_t frame_count, const unsigned short channel_count,
+		const unsigned int frequency, const unsigned short block_alignment)
+	{
+		const std::size_t block_frames = GetADPCMBlockFrames(encoding, block_alignment, channel_count);
+		if(block_frames == 0)
+		{
+			throw utility::InvalidArgumentException("avl::sound::EncodeADPCM()", "block_alignment", "Isn't supported by the encoding with this many channels.");
+		}
+		const std::size_t block_count = (frame_count + block_frames - 1) / block_frames;
+		char* const audio_data = new(std::nothrow) char[block_count * block_alignment];
+		if(audio_data == nullptr)
+		{
+			throw utility::OutOfMemoryError();
+		}
+		std::size_t data_size = 0;
+		std::shared_ptr<const char> shared_data;
+		try
+		{
+			// The IMA ADPCM step index carries over from block to block.
+			std::vector<int> indices(channel_count, 0);
+			for(std::size_t frame = 0; frame < frame_count; frame += block_frames)
+			{
+				const std::size_t count = std::min(block_frames, frame_count - frame);
+				unsigned char* const block = reinterpret_cast<unsigned char*>(&audio_data[data_size]);
+				if(encoding == SoundSample::IMA_ADPCM)
+				{
+					data_size += EncodeIMABlock(&frames[frame * channel_count], count, block_frames, channel_count, indices, block);
+				}
+				else
+				{
+					data_size += EncodeMSBlock(&frames[frame * channel_count], count, channel_count, block);
+				}
+			}
+			shared_data.reset(audio_data, std::default_delete<const char[]>());
+		}
+		catch(const std::bad_alloc&)
+		{
+			// Once reset() has been called, it has already deleted the data.
+			if(shared_data == nullptr && data_size == 0)
+			{
+				delete[] audio_data;
+			}
+			throw utility::OutOfMemoryError();
+		}
+		return SoundSample(encoding, frequency, channel_count, block_alignment, frame_count, data_size, shared_data);
+	}
+
+	// See function declaration for details.
+	const unsigned short GetDefaultADPCMBlockAlignment(const unsigned int frequency, const unsigned short channel_count)
+	{
+		unsigned int multiple = (frequency > 11025) ? frequency / 11025 : 1;
+		while(multiple > 1 && 256 * channel_count * multiple > 0xFFFF)
+		{
+			--multiple;
+		}
+		return static_cast<unsigned short>(256 * channel_count * multiple);
+	}
+
+
+
+	// Anonymous namespace.
+	namespace
+	{
+		/** Decodes a block of IMA ADPCM.
+		@param block The block.
+		@param block_size The size of \a block in bytes.
+		@param channel_count The number of channels.
+		@param frames [OUT] Receives the frames.
+		@return The number of frames decoded.
+		*/
+		const std::size_t DecodeIMABlock(const unsigned char* const block, const std::size_t block_size, const unsigned short channel_count, short* const frames)
+		{
+			ASSERT(block_size >= IMA_HEADER_SIZE * channel_count);
+			const std::size_t group_count = (block_size - IMA_HEADER_SIZE * channel_count) / (IMA_GROUP_SIZE * channel_count);
+			for(unsigned short channel = 0; channel < channel_count; ++channel)
+			{
+				const unsigned char* const header = &block[channel * IMA_HEADER_SIZE];
+				int predictor = ReadShort(header);
+				int index = Clamp(header[2], 0, IMA_MAX_INDEX);
+				frames[channel] = static_cast<short>(predictor);
+				short* output = &frames[channel_count + channel];
+				for(std::size_t group = 0; group < group_count; ++group)
+				{
+					const unsigned char* const bytes = &block[IMA_HEADER_SIZE * channel_count + (group * channel_count + channel) * IMA_GROUP_SIZE];
+					for(std::size_t byte = 0; byte < IMA_GROUP_SIZE; ++byte)
+					{
+						output[0] = static_cast<short>(DecodeIMANibble(bytes[byte] & 0x0F, predictor, index));
+						output[channel_count] = static_cast<short>(DecodeIMANibble(bytes[byte] >> 4, predictor, index));
+						output += channel_count * 2;
+					}
+				}
+			}
+			return group_count * 8 + 1;
+		}
+
+
+
+		/** Decodes a block of Microsoft ADPCM.
+		@param block The block.
+		@param block_size The size of \a block in bytes.
+		@param channel_count The number of channels: 1 or 2.
+		@param frames [OUT] Receives the frames.
+		@return The number of frames decoded.
+		*/
+		const std::size_t DecodeMSBlock(const unsigned char* const block, const std::size_t block_size, const unsigned short channel_count, short* const frames)
+		{
+			ASSERT(channel_count == 1 || channel_count == 2);
+			ASSERT(block_size >= MS_HEADER_SIZE * channel_count);
+			MSChannel channels[2];
+			for(unsigned short channel = 0; channel < channel_count; ++channel)
+			{
+				const unsigned int predictor = (block[channel] < MS_PREDICTOR_COUNT) ? block[channel] : 0;
+				channels[channel].coefficient1 = MS_COEFFICIENTS[predictor][0];
+				channels[channel].coefficient2 = MS_COEFFICIENTS[predictor][1];
+				channels[channel].delta = ReadShort(&block[channel_count + channel * 2]);
+				channels[channel].sample1 = ReadShort(&block[channel_count * 3 + channel * 2]);
+				channels[channel].sample2 = ReadShort(&block[channel_count * 5 + channel * 2]);
+				// The header holds the first two frames, the older one last.
+				frames[channel] = static_cast<short>(channels[channel].sample2);
+				frames[channel_count + channel] = static_cast<short>(channels[channel].sample1);
+			}
+			// The nibbles follow the frames' samples in order, so the channels alternate.
+			const std::size_t byte_count = block_size - MS_HEADER_SIZE * channel_count;
+			const unsigned char* const bytes = &block[MS_HEADER_SIZE * channel_count];
+			short* const output = &frames[channel_count * 2];
+			for(std::size_t byte = 0; byte < byte_count; ++byte)
+			{
+				output[byte * 2] = static_cast<short>(DecodeMSNibble(bytes[byte] >> 4, channels[0]));
+				output[byte * 2 + 1] = static_cast<short>(DecodeMSNibble(bytes[byte] & 0x0F, channels[(channel_count == 2) ? 1 : 0]));
+			}
+			return byte_count * 2 / channel_count + 2;
+		}
+
+
+
+		/** Encodes a block of IMA ADPCM. Frames which the last block doesn't need are filled in
+		with copies of the last frame.
+		@param frames The frames to encode.
+		@param frame_count The number of frames to encode.
+		@param block_frames The number of frames in a whole block.
+		@param channel_count The number of channels.
+		@param indices [IN/OUT] The step index of each channel.
+		@param block [OUT] Receives the block.
+		@return The size of the block in bytes.
+		*/
+		const std::size_t EncodeIMABlock(const short* const frames, const std::size_t frame_count, const std::size_t block_frames, const unsigned short channel_count,
+			std::vector<int>& indices, unsigned char* const block)
+		{
+			ASSERT(frame_count > 0 && frame_count <= block_frames);
+			const std::size_t group_count = (frame_count - 1 + 7) / 8;
+			for(unsigned short channel = 0; channel < channel_count; ++channel)
+			{
+				// The first sample is stored exactly, which keeps the predictor from drifting.
+				int predictor = frames[channel];
+				int& index = indices[channel];
+				unsigned char* const header = &block[channel * IMA_HEADER_SIZE];
+				WriteShort(predictor, header);
+				header[2] = static_cast<unsigned char>(index);
+				header[3] = 0;
+				std::size_t frame = 1;
+				for(std::size_t group = 0; group < group_count; ++group)
+				{
+					unsigned char* const bytes = &block[IMA_HEADER_SIZE * channel_count + (group * channel_count + channel) * IMA_GROUP_SIZE];
+					for(std::size_t byte = 0; byte < IMA_GROUP_SIZE; ++byte)
+					{
+						const int low = frames[std::min(frame, frame_count - 1) * channel_count + channel];
+						const int high = frames[std::min(frame + 1, frame_count - 1) * channel_count + channel];
+						const unsigned int low_nibble = EncodeIMANibble(low, predictor, index);
+						const unsigned int high_nibble = EncodeIMANibble(high, predictor, index);
+						bytes[byte] = static_cast<unsigned char>(low_nibble | (high_nibble << 4));
+						frame += 2;
+					}
+				}
+			}
+			return (IMA_HEADER_SIZE + group_count * IMA_GROUP_SIZE) * channel_count;
+		}
+
+
+
+		/** Encodes a block of Microsoft ADPCM, picking whichever predictor fits each channel
+		best. A missing second frame, or a missing last nibble, is filled in with a copy.
+		@param frames The frames to encode.
+		@param frame_count The number of frames to encode.
+		@param channel_count The number of channels: 1 or 2.
+		@param block [OUT] Receives the block.
+		@return The size of the block in bytes.
+		*/
+		const std::size_t EncodeMSBlock(const short* const frames, const std::size_t frame_count, const unsigned short channel_count, unsigned char* const block)
+		{
+			ASSERT(frame_count > 0);
+			ASSERT(channel_count == 1 || channel_count == 2);
+			const std::size_t second = (frame_count > 1) ? 1 : 0;
+			MSChannel channels[2];
+			for(unsigned short channel = 0; channel < channel_count; ++channel)
+			{
+				// Start the delta near the size of the first difference, so that it needn't adapt
+				// its way up from the smallest.
+				const int first = frames[channel];
+				const int next = frames[second * channel_count + channel];
+				const int third = frames[std::min<std::size_t>(2, frame_count - 1) * channel_count + channel];
+				const int delta = Clamp(std::abs(third - next) / 4, MS_MIN_DELTA, 0x7FFF);
+
+				// Try every predictor on the channel, and keep the one with the least error.
+				unsigned int best_predictor = 0;
+				double best_error = 0.0;
+				for(unsigned int predictor = 0; predictor < MS_PREDICTOR_COUNT; ++predictor)
+				{
+					MSChannel trial = {MS_COEFFICIENTS[predictor][0], MS_COEFFICIENTS[predictor][1], delta, next, first};
+					double error = 0.0;
+					for(std::size_t frame = 2; frame < frame_count; ++frame)
+					{
+						const int sample = frames[frame * channel_count + channel];
+						EncodeMSNibble(sample, trial);
+						error += static_cast<double>(sample - trial.sample1) * (sample - trial.sample1);
+					}
+					if(predictor == 0 || error < best_error)
+					{
+						best_predictor = predictor;
+						best_error = error;
+					}
+				}
+				MSChannel& state = channels[channel];
+				state.coefficient1 = MS_COEFFICIENTS[best_predictor][0];
+				state.coefficient2 = MS_COEFFICIENTS[best_predictor][1];
+				state.delta = delta;
+				state.sample1 = next;
+				state.sample2 = first;
+				block[channel] = static_cast<unsigned char>(best_predictor);
+				WriteShort(delta, &block[channel_count + channel * 2]);
+				WriteShort(next, &block[channel_count * 3 + channel * 2]);
+				WriteShort(first, &block[channel_count * 5 + channel * 2]);
+			}
+			const std::size_t nibble_count = (frame_count > 2) ? (frame_count - 2) * channel_count : 0;
+			unsigned char* const bytes = &block[MS_HEADER_SIZE * channel_count];
+			for(std::size_t nibble = 0; nibble < nibble_count; nibble += 2)
+			{
+				const int high = frames[channel_count * 2 + nibble];
+				const int low = frames[channel_count * 2 + std::min(nibble + 1, nibble_count - 1)];
+				const unsigned int high_nibble = EncodeMSNibble(high, channels[0]);
+				const unsigned int low_nibble = EncodeMSNibble(low, channels[(channel_count == 2) ? 1 : 0]);
+				bytes[nibble / 2] = static_cast<unsigned char>((high_nibble << 4) | low_nibble);
+			}
+			return MS_HEADER_SIZE * channel_count + (nibble_count + 1) / 2;
+		}
+
+
+
+		/** Decodes an IMA ADPCM nibble.
+		@param nibble The nibble.
+		@param predictor [IN/OUT] The last sample, which is replaced with the decoded sample.
+		@param index [IN/OUT] The step index.
+		@return The decoded sample.
+		*/
+		const int DecodeIMANibble(const unsigned int nibble, int& predictor, int& index)
+		{
+			// Summed a bit at a time, exactly as the reference decoder does, so that encoders
+			// and decoders round the same way.
+			const int step = IMA_STEPS[index];
+			int difference = step >> 3;
+			if((nibble & 4) != 0)
+			{
+				difference += step;
+			}
+			if((nibble & 2) != 0)
+			{
+				difference += step >> 1;
+			}
+			if((nibble & 1) != 0)
+			{
+				difference += step >> 2;
+			}
+			predictor = Clamp(((nibble & 8) != 0) ? predictor - difference : predictor + difference, -32768, 32767);
+			index = Clamp(index + IMA_INDEX_ADJUSTMENTS[nibble], 0, IMA_MAX_INDEX);
+			return predictor;
+		}
+
+
+
+		/** Encodes a sample as an IMA ADPCM nibble.
+		@param sample The sample.
+		@param predictor [IN/OUT] The last decoded sample, which is replaced with the decoded
+		value of the nibble.
+		@param index [IN/OUT] The step index.
+		@return The nibble.
+		*/
+		const unsigned int EncodeIMANibble(const int sample, int& predictor, int& index)
+		{
+			int difference = sample - predictor;
+			unsigned int nibble = 0;
+			if(difference < 0)
+			{
+				nibble = 8;
+				difference = -difference;
+			}
+			int step = IMA_STEPS[index];
+			for(unsigned int bit = 4; bit != 0; bit >>= 1)
+			{
+				if(difference >= step)
+				{
+					nibble |= bit;
+					difference -= step;
+				}
+				step >>= 1;
+			}
+			// Track the decoder exactly.
+			DecodeIMANibble(nibble, predictor, index);
+			return nibble;
+		}
+
+
+
+		/** Decodes a Microsoft ADPCM nibble.
+		@param nibble The nibble.
+		@param channel [IN/OUT] The state of the channel.
+		@return The decoded sample.
+		*/
+		const int DecodeMSNibble(const unsigned int nibble, MSChannel& channel)
+		{
+			const int predicted = (channel.sample1 * channel.coefficient1 + channel.sample2 * channel.coefficient2) / 256;
+			const int difference = ((nibble & 8) != 0) ? static_cast<int>(nibble) - 16 : static_cast<int>(nibble);
+			const int sample = Clamp(predicted + difference * channel.delta, -32768, 32767);
+			channel.sample2 = channel.sample1;
+			channel.sample1 = sample;
+			channel.delta = Clamp((MS_ADAPTATIONS[nibble] * channel.delta) >> 8, MS_MIN_DELTA, MS_MAX_DELTA);
+			return sample;
+		}
+
+
+
+		/** Encodes a sample as a Microsoft ADPCM nibble.
+		@param sample The sample.
+		@param channel [IN/OUT] The state of the channel.
+		@return The nibble.
+		*/
+		const unsigned int EncodeMSNibble(const int sample, MSChannel& channel)
+		{
+			const int predicted = (channel.sample1 * channel.coefficient1 + channel.sample2 * channel.coefficient2) / 256;
+			// Round the error to the nearest multiple of the delta.
+			const int error = sample - predicted;
+			const int rounded = (error >= 0) ? (error + channel.delta / 2) / channel.delta : -((-error + channel.delta / 2) / channel.delta);
+			const unsigned int nibble = static_cast<unsigned int>(Clamp(rounded, -8, 7)) & 0x0F;
+			// Track the decoder exactly.
+			DecodeMSNibble(nibble, channel);
+			return nibble;
+		}
+
+
+
+		/** Reads a little-endian 16-bit value.
+		@param data The value's bytes.
+		@return The value.
+		*/
+		const short ReadShort(const unsigned char* const data)
+		{
+			return static_cast<short>(data[0] | (data[1] << 8));
+		}
+
+		/** Writes a little-endian 16-bit value.
+		@param value The value; only its low 16 bits are written.
+		@param data [OUT] Receives the value's bytes.
+		*/
+		void WriteShort(const int value, unsigned char* const data)
+		{
+			data[0] = static_cast<unsigned char>(value);
+			data[1] = static_cast<unsigned char>(value >> 8);
+		}
+
+		/** Clamps a value to a range.
+		@param value The value.
+		@param minimum The least value of the range.
+		@param maximum The greatest value of the range.
+		@return The clamped value.
+		*/
+		const int Clamp(const int value, const int minimum, const int maximum)
+		{
+			return (value < minimum) ? minimum : ((value > maximum) ? maximum : value);
+		}
+	}
+
+
+
+} // sound
+} // avl
@@ -0,0 +1,114 @@
+#pragma once
+#ifndef AVL_SOUND_ADPCM__
+#define AVL_SOUND_ADPCM__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Encodes and decodes IMA ADPCM and Microsoft ADPCM, as stored in WAV files. Both store
+16-bit samples as 4-bit differences, in blocks which decode independently of each other,
+so that a sample can be kept compressed in memory and decoded a block at a time as it's
+played.
+@par IMA ADPCM:
+Each block starts with a 4-byte header per channel holding the first sample and the
+step index. The rest of the block is groups of 4 bytes per channel, each holding 8
+samples of that channel, low nibble first. Any number of channels is supported.
+@par Microsoft ADPCM:
+Each block starts with a 7-byte header per channel holding the predictor, the initial
+delta, and the first two samples. The rest of the block is one nibble per sample, high
+nibble first, with the channels interleaved. Only mono and stereo are supported, and only
+the standard table of predictor coefficients, which is what every common encoder writes.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"..\sound sample\sound sample.h"
+#include<cstddef>
+
+
+namespace avl
+{
+namespace sound
+{
+	/** Finds the number of frames in each block of ADPCM audio data.
+	@param encoding The encoding: SoundSample::IMA_ADPCM or SoundSample::MS_ADPCM.
+	@param block_alignment The size of each block in bytes.
+	@param channel_count The number of channels.
+	@return The number of frames in each whole block, or zero if the encoding doesn't
+	support blocks of this size with this many channels.
+	*/
+	const std::size_t GetADPCMBlockFrames(const SoundSample::Encoding encoding, const unsigned short block_alignment, const unsigned short channel_count);
+
+	/** Finds the number of frames which ADPCM audio data holds.
+	@param encoding The encoding: SoundSample::IMA_ADPCM or SoundSample::MS_ADPCM.
+	@param block_alignment The size of each block in bytes.
+	@param channel_count The number of channels.
+	@param data_size The size of the audio data in bytes. The last block may be short.
+	@return The number of frames, or zero if the block layout isn't supported.
+	*/
+	const std::size_t GetADPCMFrameCount(const SoundSample::Encoding encoding, const unsigned short block_alignment, const unsigned short channel_count, const std::size_t data_size);
+
+	/** Decodes a block of ADPCM audio data to interleaved 16-bit PCM.
+	@param encoding The encoding: SoundSample::IMA_ADPCM or SoundSample::MS_ADPCM.
+	@param block The block.
+	@param block_size The size of \a block in bytes: the block alignment, or less for the
+	last block.
+	@param channel_count The number of channels.
+	@param frames [OUT] Receives the decoded frames. Must have room for every frame of the
+	block; see GetADPCMBlockFrames().
+	@return The number of frames decoded.
+	@pre The block layout is supported.
+	*/
+	const std::size_t DecodeADPCMBlock(const SoundSample::Encoding encoding, const char* const block, const std::size_t block_size, const unsigned short channel_count, short* const frames);
+
+	/** Decodes an ADPCM sample to 16-bit PCM.
+	@param sample The sample. A PCM sample is shared rather than copied.
+	@return The decoded sample.
+	@throws InvalidArgumentException If the block layout of \a sample isn't supported, or if
+	its audio data holds fewer frames than it claims.
+	@throws OutOfMemoryError If we run out of memory.
+	*/
+	SoundSample DecodeADPCMSample(const SoundSample& sample);
+
+	/** Encodes 16-bit PCM to ADPCM.
+	@param encoding The encoding: SoundSample::IMA_ADPCM or SoundSample::MS_ADPCM.
+	@param frames The interleaved frames to encode.
+	@param frame_count The number of frames.
+	@param channel_count The number of channels.
+	@param frequency The number of frames per second.
+	@param block_alignment The size of each block in bytes.
+	@return The encoded sample. The last block is only as long as it needs to be.
+	@throws InvalidArgumentException If the encoding doesn't support blocks of this size
+	with this many channels.
+	@throws OutOfMemoryError If we run out of memory.
+	*/
+	SoundSample EncodeADPCM(const SoundSample::Encoding encoding, const short* const frames, const std::size_t frame_count, const unsigned short channel_count,
+		const unsigned int frequency, const unsigned short block_alignment);
+
+	/** Picks the block alignment which Windows' own encoders use for a rate and channel
+	count: 256 bytes per channel for each multiple of 11025 Hz.
+	@param frequency The number of frames per second.
+	@param channel_count The number of channels.
+	@return The block alignment in bytes.
+	*/
+	const unsigned short GetDefaultADPCMBlockAlignment(const unsigned int frequency, const unsigned short channel_count);
+
+
+
+} // sound
+} // avl
+#endif // AVL_SOUND_ADPCM__
@@ -0,0 +1,233 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the adpcm component. See "adpcm.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"adpcm.h"
+#include"..\sound sample\sound sample.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\timer\timer.h"
+#include<iostream>
+#include<vector>
+#include<memory>
+#include<cmath>
+#include<cstring>
+#include<cstdlib>
+
+using avl::sound::SoundSample;
+using avl::sound::GetADPCMBlockFrames;
+using avl::sound::GetADPCMFrameCount;
+using avl::sound::DecodeADPCMBlock;
+using avl::sound::DecodeADPCMSample;
+using avl::sound::EncodeADPCM;
+using avl::sound::GetDefaultADPCMBlockAlignment;
+
+
+
+// Anonymous namespace.
+namespace
+{
+	const double PI = 3.14159265358979323846;
+
+	std::vector<short> MakeSines(const unsigned int rate, const std::size_t frame_count, const unsigned short channel_count);
+	const double SignalToError(const std::vector<short>& original, const SoundSample& decoded);
+	std::shared_ptr<const char> CopyBytes(const unsigned char* const bytes, const std::size_t size);
+}
+
+
+
+void TestADPCMComponent()
+{
+	// Block layouts.
+	{
+		ASSERT(GetADPCMBlockFrames(SoundSample::IMA_ADPCM, 1024, 2) == 1017);
+		ASSERT(GetADPCMBlockFrames(SoundSample::IMA_ADPCM, 512, 1) == 1017);
+		ASSERT(GetADPCMBlockFrames(SoundSample::MS_ADPCM, 1024, 2) == 1012);
+		ASSERT(GetADPCMBlockFrames(SoundSample::MS_ADPCM, 512, 1) == 1012);
+		ASSERT(GetADPCMBlockFrames(SoundSample::IMA_ADPCM, 1026, 2) == 0);
+		ASSERT(GetADPCMBlockFrames(SoundSample::MS_ADPCM, 1024, 3) == 0);
+		ASSERT(GetADPCMBlockFrames(SoundSample::PCM, 1024, 2) == 0);
+		// Two whole blocks, and a last one holding a header and one group.
+		ASSERT(GetADPCMFrameCount(SoundSample::IMA_ADPCM, 512, 1, 1024 + 8) == 1017 * 2 + 9);
+		ASSERT(GetADPCMFrameCount(SoundSample::MS_ADPCM, 512, 1, 512 + 10) == 1012 + 8);
+		ASSERT(GetDefaultADPCMBlockAlignment(22050, 1) == 512 && GetDefaultADPCMBlockAlignment(44100, 2) == 2048 && GetDefaultADPCMBlockAlignment(8000, 1) == 256);
+		std::cout << "Block layouts are measured.\n";
+	}
+
+	// IMA ADPCM decodes exactly as the reference decoder does.
+	{
+		const unsigned char block[] = {0x00, 0x00, 0x00, 0x00, 0x07, 0x08, 0x00, 0x00};
+		const short expected[] = {0, 11, 13, 12, 13, 14, 15, 16, 17};
+		short frames[9];
+		ASSERT(DecodeADPCMBlock(SoundSample::IMA_ADPCM, reinterpret_cast<const char*>(block), sizeof(block), 1, frames) == 9);
+		ASSERT(memcmp(frames, expected, sizeof(expected)) == 0);
+		std::cout << "IMA ADPCM decodes.\n";
+	}
+
+	// Microsoft ADPCM decodes exactly as the reference decoder does, starting with the two
+	// frames of the header, the older first.
+	{
+		const unsigned char block[] = {0x00, 0x10, 0x00, 0x64, 0x00, 0x32, 0x00, 0x1F, 0x70};
+		const short expected[] = {50, 100, 116, 100, 212, 212};
+		short frames[6];
+		ASSERT(DecodeADPCMBlock(SoundSample::MS_ADPCM, reinterpret_cast<const char*>(block), sizeof(block), 1, frames) == 6);
+		ASSERT(memcmp(frames, expected, sizeof(expected)) == 0);
+		std::cout << "Microsoft ADPCM decodes.\n";
+	}
+
+	// Samples decode to exactly as many frames as they claim, and layouts we can't decode
+	// are refused.
+	{
+		const unsigned char block[] = {0x00, 0x00, 0x00, 0x00, 0x07, 0x08, 0x00, 0x00};
+		const SoundSample sample(SoundSample::IMA_ADPCM, 22050, 1, 8, 7, sizeof(block), CopyBytes(block, sizeof(block)));
+		const SoundSample decoded = DecodeADPCMSample(sample);
+		ASSERT(decoded.GetEncoding() == SoundSample::PCM && decoded.GetBitDepth() == 16 && decoded.GetFrameCount() == 7 && decoded.GetDataSize() == 14);
+		ASSERT(reinterpret_cast<const short*>(decoded.GetAudioData())[6] == 15);
+
+		bool thrown = false;
+		try
+		{
+			const SoundSample too_long(SoundSample::IMA_ADPCM, 22050, 1, 8, 10, sizeof(block), CopyBytes(block, sizeof(block)));
+			DecodeADPCMSample(too_long);
+		}
+		catch(const avl::utility::InvalidArgumentException&)
+		{
+			thrown = true;
+		}
+		ASSERT(thrown == true);
+		thrown = false;
+		try
+		{
+			const SoundSample bad_layout(SoundSample::IMA_ADPCM, 22050, 1, 6, 1, sizeof(block), CopyBytes(block, sizeof(block)));
+			DecodeADPCMSample(bad_layout);
+		}
+		catch(const avl::utility::InvalidArgumentException&)
+		{
+			thrown = true;
+		}
+		ASSERT(thrown == true);
+		std::cout << "Samples decode to their length.\n";
+	}
+
+	// Encoding then decoding keeps the sound, at about a quarter of the size. The lengths
+	// leave the last block short.
+	{
+		const SoundSample::Encoding encodings[] = {SoundSample::IMA_ADPCM, SoundSample::MS_ADPCM};
+		const char* const names[] = {"IMA ADPCM", "Microsoft ADPCM"};
+		for(unsigned int i = 0; i < 2; ++i)
+		{
+			for(unsigned short channel_count = 1; channel_count <= 2; ++channel_count)
+			{
+				const std::size_t frame_count = 44100 + 123;
+				const std::vector<short> frames = MakeSines(44100, frame_count, channel_count);
+				const unsigned short block_alignment = GetDefaultADPCMBlockAlignment(44100, channel_count);
+				const SoundSample encoded = EncodeADPCM(encodings[i], &frames[0], frame_count, channel_count, 44100, block_alignment);
+				ASSERT(encoded.GetEncoding() == encodings[i] && encoded.GetFrameCount() == frame_count && encoded.GetBlockAlignment() == block_alignment);
+				ASSERT(encoded.GetDataSize() < frame_count * channel_count * 2 / 3);
+				ASSERT(GetADPCMFrameCount(encodings[i], block_alignment, channel_count, encoded.GetDataSize()) >= frame_count);
+				const SoundSample decoded = DecodeADPCMSample(encoded);
+				ASSERT(decoded.GetFrameCount() == frame_count && decoded.GetNumberOfChannels() == channel_count);
+				const double snr = SignalToError(frames, decoded);
+				std::cout << "  " << names[i] << ", " << channel_count << " channel(s): signal to error " << snr << " dB, "
+					<< static_cast<double>(frame_count * channel_count * 2) / encoded.GetDataSize() << " to 1\n";
+				ASSERT(snr > 25.0);
+			}
+		}
+		std::cout << "Encoding keeps the sound.\n";
+	}
+
+	// Throughput, on ten seconds of 16-bit stereo 44.1 kHz.
+	{
+		const std::size_t frame_count = 441000;
+		const std::vector<short> frames = MakeSines(44100, frame_count, 2);
+		std::cout << "Milliseconds to decode ten seconds of 16-bit stereo 44.1 kHz:\n";
+		const SoundSample::Encoding encodings[] = {SoundSample::IMA_ADPCM, SoundSample::MS_ADPCM};
+		const char* const names[] = {"IMA ADPCM", "Microsoft ADPCM"};
+		for(unsigned int i = 0; i < 2; ++i)
+		{
+			const SoundSample encoded = EncodeADPCM(encodings[i], &frames[0], frame_count, 2, 44100, GetDefaultADPCMBlockAlignment(44100, 2));
+			avl::utility::Timer timer;
+			const SoundSample decoded = DecodeADPCMSample(encoded);
+			std::cout << "  " << names[i] << "  " << timer.Elapsed() * 1000.0 << "\n";
+			ASSERT(decoded.GetFrameCount() == frame_count);
+		}
+	}
+
+	system("pause");
+}
+
+
+
+// Anonymous namespace.
+namespace
+{
+	/** Makes 16-bit frames of a few sines, a different mix in each channel.
+	@param rate The sampling rate.
+	@param frame_count The number of frames.
+	@param channel_count The number of channels.
+	@return The interleaved frames.
+	*/
+	std::vector<short> MakeSines(const unsigned int rate, const std::size_t frame_count, const unsigned short channel_count)
+	{
+		std::vector<short> frames(frame_count * channel_count);
+		for(std::size_t frame = 0; frame < frame_count; ++frame)
+		{
+			for(unsigned short channel = 0; channel < channel_count; ++channel)
+			{
+				const double time = static_cast<double>(frame) / rate;
+				const double value = 0.4 * std::sin(2.0 * PI * (220.0 + 110.0 * channel) * time) + 0.2 * std::sin(2.0 * PI * 1760.0 * time) + 0.1 * std::sin(2.0 * PI * 5000.0 * time);
+				frames[frame * channel_count + channel] = static_cast<short>(std::floor(value * 32767.0 + 0.5));
+			}
+		}
+		return frames;
+	}
+
+	/** Measures how far decoded frames stray from the originals.
+	@param original The original frames.
+	@param decoded The decoded 16-bit sample.
+	@return The ratio of the signal to the error, in decibels.
+	*/
+	const double SignalToError(const std::vector<short>& original, const SoundSample& decoded)
+	{
+		const short* const frames = reinterpret_cast<const short*>(decoded.GetAudioData());
+		double signal = 0.0;
+		double error = 0.0;
+		for(std::size_t i = 0; i < original.size(); ++i)
+		{
+			signal += static_cast<double>(original[i]) * original[i];
+			error += static_cast<double>(original[i] - frames[i]) * (original[i] - frames[i]);
+		}
+		return 10.0 * std::log10(signal / error);
+	}
+
+	/** Copies bytes to audio data which can be shared by a SoundSample.
+	@param bytes The bytes.
+	@param size The number of bytes.
+	@return The copy.
+	*/
+	std::shared_ptr<const char> CopyBytes(const unsigned char* const bytes, const std::size_t size)
+	{
+		char* const data = new char[size];
+		memcpy(data, bytes, size);
+		return std::shared_ptr<const char>(data, std::default_delete<const char[]>());
+	}
+}
@@ -0,0 +1,671 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the dsp effects component. See "dsp effects.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"dsp effects.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include<algorithm>
+#include<cmath>
+#include<new>
+#include<emmintrin.h>
+
+
+namespace avl
+{
+namespace sound
+{
+	// See method definitions for details.
+	namespace
+	{
+		/// The most frames which the limiter works out the gains of at a time.
+		const std::size_t LIMITER_BLOCK_FRAMES = 256;
+		/// The lengths of the reverb's delay lines, in milliseconds, before being rounded up
+		/// to prime numbers of frames.
+		const float REVERB_LINE_MILLISECONDS[Reverb::LINE_COUNT] = {29.7f, 37.1f, 41.1f, 43.7f};
+		/// Added to and subtracted from the state of the recursive effects, which flushes
+		/// it to 0 once it has decayed below this, rather than letting it become denormal.
+		const float DENORMAL_GUARD = 1e-18f;
+		/// Pi.
+		const double PI = 3.14159265358979323846;
+
+		const __m128 LoadChannels(const float* const source, const unsigned int count);
+		void StoreChannels(const __m128 values, float* const destination, const unsigned int count);
+		const __m128 FlushDenormals(const __m128 values);
+		const __m128 Hadamard(const __m128 values);
+		const std::size_t NextPrime(const std::size_t value);
+		const std::size_t LookaheadFrames(const float lookahead, const unsigned int sample_rate);
+		void FindPeaks(const float* const frames, const std::size_t frame_count, const unsigned short channel_count, float* const peaks);
+		void ApplyGains(float* const frames, const float* const gains, const std::size_t frame_count, const unsigned short channel_count);
+	}
+
+
+
+	// See method declaration for details.
+	DSPEffect::DSPEffect(const unsigned int sample_rate, const unsigned short channel_count)
+		: sample_rate(sample_rate), channel_count(channel_count)
+	{
+		if(sample_rate == 0)
+		{
+			throw utility::InvalidArgumentException("avl::sound::DSPEffect::DSPEffect()", "sample_rate", "Must be greater than 0.");
+		}
+		if(channel_count == 0)
+		{
+			throw utility::InvalidArgumentException("avl::sound::DSPEffect::DSPEffect()", "channel_count", "Must be greater than 0.");
+		}
+	}
+
+	// See method declaration for details.
+	DSPEffect::~DSPEffect()
+	{
+	}
+
+	// See method declaration for details.
+	const unsigned int DSPEffect::GetSampleRate() const
+	{
+		return sample_rate;
+	}
+
+	// See method declaration for details.
+	const unsigned short DSPEffect::GetChannelCount() const
+	{
+		return channel_count;
+	}
+
+
+
+	// See method declaration for details.
+	BiquadFilter::BiquadFilter(const unsigned int sample_rate, const unsigned short channel_count, const Type type, const float cutoff, const float q)
+		: DSPEffect(sample_rate, channel_count), type(type), cutoff(cutoff), q(q)
+	{
+		if((q > 0.0f) == false)
+		{
+			throw utility::InvalidArgumentException("avl::sound::BiquadFilter::BiquadFilter()", "q", "Must be greater than 0.");
+		}
+		SetCutoff(cutoff);
+		// One state for each channel, and enough over for the last group of four.
+		try
+		{
+			first_state.resize((channel_count + 3) / 4 * 4);
+			second_state.resize((channel_count + 3) / 4 * 4);
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw utility::OutOfMemoryError();
+		}
+		Reset();
+	}
+
+	// See method declaration for details.
+	BiquadFilter::~BiquadFilter()
+	{
+	}
+
+	// See method declaration for details.
+	void BiquadFilter::SetCutoff(const float new_cutoff)
+	{
+		// Written so that NaNs fail.
+		if((new_cutoff > 0.0f && new_cutoff < GetSampleRate() / 2.0f) == false)
+		{
+			throw utility::InvalidArgumentException("avl::sound::BiquadFilter::SetCutoff()", "new_cutoff", "Must be between 0 and half of the sample rate.");
+		}
+		cutoff = new_cutoff;
+		ComputeCoefficients();
+	}
+
+	// See method declaration for details.
+	const float BiquadFilter::GetCutoff() const
+	{
+		return cutoff;
+	}
+
+	// See method declaration for details.
+	void BiquadFilter::Process(float* const frames, const std::size_t frame_count)
+	{
+		const unsigned short channel_count = GetChannelCount();
+		const __m128 feedforward0 = _mm_set1_ps(b0);
+		const __m128 feedforward1 = _mm_set1_ps(b1);
+		const __m128 feedforward2 = _mm_set1_ps(b2);
+		const __m128 feedback1 = _mm_set1_ps(a1);
+		const __m128 feedback2 = _mm_set1_ps(a2);
+		// Filter up to four channels at once, in transposed direct form II.
+		for(unsigned int first = 0; first < channel_count; first += 4)
+		{
+			const unsigned int width = std::min(4u, channel_count - first);
+			__m128 state1 = _mm_loadu_ps(&first_state[first]);
+			__m128 state2 = _mm_loadu_ps(&second_state[first]);
+			float* sample = frames + first;
+			for(std::size_t i = 0; i < frame_count; ++i, sample += channel_count)
+			{
+				const __m128 input = LoadChannels(sample, width);
+				const __m128 output = _mm_add_ps(_mm_mul_ps(feedforward0, input), state1);
+				state1 = FlushDenormals(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(feedforward1, input), _mm_mul_ps(feedback1, output)), state2));
+				state2 = FlushDenormals(_mm_sub_ps(_mm_mul_ps(feedforward2, input), _mm_mul_ps(feedback2, output)));
+				StoreChannels(output, sample, width);
+			}
+			_mm_storeu_ps(&first_state[first], state1);
+			_mm_storeu_ps(&second_state[first], state2);
+		}
+	}
+
+	// See method declaration for details.
+	void BiquadFilter::Reset()
+	{
+		std::fill(first_state.begin(), first_state.end(), 0.0f);
+		std::fill(second_state.begin(), second_state.end(), 0.0f);
+	}
+
+	// See method declaration for details.
+	void BiquadFilter::ComputeCoefficients()
+	{
+		const double angle = 2.0 * PI * cutoff / GetSampleRate();
+		const double cosine = std::cos(angle);
+		const double alpha = std::sin(angle) / (2.0 * q);
+		const double a0 = 1.0 + alpha;
+		double feedforward0, feedforward1;
+		if(type == LOW_PASS)
+		{
+			feedforward0 = (1.0 - cosine) / 2.0;
+			feedforward1 = 1.0 - cosine;
+		}
+		else
+		{
+			feedforward0 = (1.0 + cosine) / 2.0;
+			feedforward1 = -(1.0 + cosine);
+		}
+		b0 = static_cast<float>(feedforward0 / a0);
+		b1 = static_cast<float>(feedforward1 / a0);
+		b2 = b0;
+		a1 = static_cast<float>(-2.0 * cosine / a0);
+		a2 = static_cast<float>((1.0 - alpha) / a0);
+	}
+
+
+
+	// See method declaration for details.
+	Reverb::Reverb(const unsigned int sample_rate, const unsigned short channel_count, const float decay_time, const float damping, const float wet, const float dry)
+		: DSPEffect(sample_rate, channel_count), decay_time(decay_time), damping(damping), wet(wet), dry(dry)
+	{
+		SetDecayTime(decay_time);
+		SetDamping(damping);
+		std::size_t total_length = 0;
+		for(unsigned int line = 0; line < LINE_COUNT; ++line)
+		{
+			lengths[line] = NextPrime(static_cast<std::size_t>(REVERB_LINE_MILLISECONDS[line] * sample_rate / 1000.0f) + 1);
+			offsets[line] = total_length;
+			total_length += lengths[line];
+		}
+		try
+		{
+			lines.resize(total_length);
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw utility::OutOfMemoryError();
+		}
+		ComputeGains();
+		Reset();
+	}
+
+	// See method declaration for details.
+	Reverb::~Reverb()
+	{
+	}
+
+	// See method declaration for details.
+	void Reverb::SetDecayTime(const float new_decay_time)
+	{
+		if((new_decay_time > 0.0f) == false)
+		{
+			throw utility::InvalidArgumentException("avl::sound::Reverb::SetDecayTime()", "new_decay_time", "Must be greater than 0.");
+		}
+		decay_time = new_decay_time;
+		// The lines don't exist while constructing; the constructor works out the gains.
+		if(lines.empty() == false)
+		{
+			ComputeGains();
+		}
+	}
+
+	// See method declaration for details.
+	void Reverb::SetDamping(const float new_damping)
+	{
+		if((new_damping >= 0.0f && new_damping <= 1.0f) == false)
+		{
+			throw utility::InvalidArgumentException("avl::sound::Reverb::SetDamping()", "new_damping", "Must be from 0 to 1.");
+		}
+		damping = new_damping;
+	}
+
+	// See method declaration for details.
+	void Reverb::SetMix(const float new_wet, const float new_dry)
+	{
+		wet = new_wet;
+		dry = new_dry;
+	}
+
+	// See method declaration for details.
+	void Reverb::Process(float* const frames, const std::size_t frame_count)
+	{
+		const unsigned short channel_count = GetChannelCount();
+		const float input_scale = 1.0f / channel_count;
+		const __m128 line_gains = _mm_loadu_ps(gains);
+		const __m128 kept = _mm_set1_ps(damping);
+		const __m128 passed = _mm_set1_ps(1.0f - damping);
+		const __m128 half = _mm_set1_ps(0.5f);
+		__m128 filter = _mm_loadu_ps(filter_states);
+		float* frame = frames;
+		for(std::size_t i = 0; i < frame_count; ++i, frame += channel_count)
+		{
+			float input = 0.0f;
+			for(unsigned short channel = 0; channel < channel_count; ++channel)
+			{
+				input += frame[channel];
+			}
+			input *= input_scale;
+
+			// Run the four lines at once: damp what comes out of each, mix the lines together,
+			// and feed them back in along with the input.
+			float taps[LINE_COUNT];
+			for(unsigned int line = 0; line < LINE_COUNT; ++line)
+			{
+				taps[line] = lines[offsets[line] + positions[line]];
+			}
+			filter = FlushDenormals(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(taps), passed), _mm_mul_ps(filter, kept)));
+			// The Hadamard matrix scaled by a half is orthonormal, so the gains alone set the decay.
+			const __m128 feedback = _mm_mul_ps(Hadamard(_mm_mul_ps(filter, line_gains)), half);
+			float written[LINE_COUNT];
+			_mm_storeu_ps(written, _mm_add_ps(_mm_set1_ps(input), feedback));
+			for(unsigned int line = 0; line < LINE_COUNT; ++line)
+			{
+				lines[offsets[line] + positions[line]] = written[line];
+				if(++positions[line] == lengths[line])
+				{
+					positions[line] = 0;
+				}
+			}
+
+			const float left = (taps[0] + taps[2]) * 0.5f;
+			const float right = (taps[1] + taps[3]) * 0.5f;
+			if(channel_count == 1)
+			{
+				frame[0] = frame[0] * dry + (left + right) * 0.5f * wet;
+			}
+			else
+			{
+				for(unsigned short channel = 0; channel < channel_count; ++channel)
+				{
+					frame[channel] = frame[channel] * dry + ((channel % 2 == 0) ? left : right) * wet;
+				}
+			}
+		}
+		_mm_storeu_ps(filter_states, filter);
+	}
+
+	// See method declaration for details.
+	void Reverb::Reset()
+	{
+		std::fill(lines.begin(), lines.end(), 0.0f);
+		for(unsigned int line = 0; line < LINE_COUNT; ++line)
+		{
+			positions[line] = 0;
+			filter_states[line] = 0.0f;
+		}
+	}
+
+	// See method declaration for details.
+	void Reverb::ComputeGains()
+	{
+		// Each pass through a line must fall by its share of 60 dB over the decay time.
+		for(unsigned int line = 0; line < LINE_COUNT; ++line)
+		{
+			gains[line] = static_cast<float>(std::pow(10.0, -3.0 * lengths[line] / (static_cast<double>(GetSampleRate()) * decay_time)));
+		}
+	}
+
+
+
+	// See method declaration for details.
+	Limiter::Limiter(const unsigned int sample_rate, const unsigned short channel_count, const float threshold, const float lookahead, const float release)
+		: DSPEffect(sample_rate, channel_count), threshold(threshold),
+		release_coefficient(static_cast<float>(1.0 - std::exp(-1.0 / (static_cast<double>(release) * sample_rate)))),
+		latency(LookaheadFrames(lookahead, sample_rate))
+	{
+		if((threshold > 0.0f) == false)
+		{
+			throw utility::InvalidArgumentException("avl::sound::Limiter::Limiter()", "threshold", "Must be greater than 0.");
+		}
+		if((lookahead > 0.0f) == false)
+		{
+			throw utility::InvalidArgumentException("avl::sound::Limiter::Limiter()", "lookahead", "Must be greater than 0.");
+		}
+		if((release > 0.0f) == false)
+		{
+			throw utility::InvalidArgumentException("avl::sound::Limiter::Limiter()", "release", "Must be greater than 0.");
+		}
+		try
+		{
+			delay_line.resize(latency * channel_count);
+			minimum_gains.resize(latency + 1);
+			minimum_frames.resize(latency + 1);
+			average_window.resize(latency + 1);
+			peaks.resize(LIMITER_BLOCK_FRAMES);
+			frame_gains.resize(LIMITER_BLOCK_FRAMES);
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw utility::OutOfMemoryError();
+		}
+		Reset();
+	}
+
+	// See method declaration for details.
+	Limiter::~Limiter()
+	{
+	}
+
+	// See method declaration for details.
+	void Limiter::Process(float* const frames, const std::size_t frame_count)
+	{
+		const unsigned short channel_count = GetChannelCount();
+		for(std::size_t done = 0; done < frame_count;)
+		{
+			const std::size_t count = std::min(frame_count - done, LIMITER_BLOCK_FRAMES);
+			float* const block = frames + done * channel_count;
+			FindPeaks(block, count, channel_count, &peaks[0]);
+			ComputeGains(count);
+			// Trade the block for the frames a lookahead earlier, and turn those down.
+			for(std::size_t i = 0; i < count;)
+			{
+				const std::size_t run = std::min(count - i, latency - delay_position);
+				float* const run_frames = block + i * channel_count;
+				std::swap_ranges(run_frames, run_frames + run * channel_count, &delay_line[delay_position * channel_count]);
+				ApplyGains(run_frames, &frame_gains[i], run, channel_count);
+				i += run;
+				delay_position += run;
+				if(delay_position == latency)
+				{
+					delay_position = 0;
+				}
+			}
+			done += count;
+		}
+	}
+
+	// See method declaration for details.
+	void Limiter::Reset()
+	{
+		std::fill(delay_line.begin(), delay_line.end(), 0.0f);
+		delay_position = 0;
+		minimum_first = 0;
+		minimum_count = 0;
+		frame_number = 0;
+		released_gain = 1.0f;
+		std::fill(average_window.begin(), average_window.end(), 1.0f);
+		average_position = 0;
+		average_sum = static_cast<double>(average_window.size());
+	}
+
+	// See method declaration for details.
+	const std::size_t Limiter::GetLatency() const
+	{
+		return latency;
+	}
+
+	// See method declaration for details.
+	const float Limiter::GetThreshold() const
+	{
+		return threshold;
+	}
+
+	// See method declaration for details.
+	void Limiter::ComputeGains(const std::size_t count)
+	{
+		const std::size_t window = latency + 1;
+		for(std::size_t i = 0; i < count; ++i, ++frame_number)
+		{
+			const float needed = (peaks[i] > threshold) ? threshold / peaks[i] : 1.0f;
+			// Drop the gain which has left the lookahead first, so that there's always room in
+			// the ring for the new one.
+			if(minimum_count > 0 && minimum_frames[minimum_first] + window <= frame_number)
+			{
+				minimum_first = (minimum_first + 1) % window;
+				--minimum_count;
+			}
+			// Keep the smallest gain needed within the lookahead: a gain which is no smaller
+			// than a later one can never be the smallest again.
+			while(minimum_count > 0 && minimum_gains[(minimum_first + minimum_count - 1) % window] >= needed)
+			{
+				--minimum_count;
+			}
+			const std::size_t last = (minimum_first + minimum_count) % window;
+			minimum_gains[last] = needed;
+			minimum_frames[last] = frame_number;
+			++minimum_count;
+
+			released_gain += (1.0f - released_gain) * release_coefficient;
+			released_gain = std::min(released_gain, minimum_gains[minimum_first]);
+			average_sum += released_gain - average_window[average_position];
+			average_window[average_position] = released_gain;
+			if(++average_position == window)
+			{
+				// Sum the window afresh once per pass, so that rounding doesn't build up.
+				average_position = 0;
+				average_sum = 0.0;
+				for(std::size_t j = 0; j < window; ++j)
+				{
+					average_sum += average_window[j];
+				}
+			}
+			frame_gains[i] = static_cast<float>(average_sum / window);
+		}
+	}
+
+
+
+	// Anonymous namespace.
+	namespace
+	{
+		/** Loads the samples of up to four channels of a frame into the low lanes.
+		@param source The first sample.
+		@param count The number of samples, from 1 to 4.
+		@return The samples, with the remaining lanes 0.
+		*/
+		const __m128 LoadChannels(const float* const source, const unsigned int count)
+		{
+			switch(count)
+			{
+			case 1:
+				return _mm_load_ss(source);
+			case 2:
+				return _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(source));
+			case 3:
+				return _mm_setr_ps(source[0], source[1], source[2], 0.0f);
+			default:
+				return _mm_loadu_ps(source);
+			}
+		}
+
+		/** Stores the low lanes as the samples of up to four channels of a frame.
+		@param values The samples.
+		@param destination [OUT] Receives the samples.
+		@param count The number of samples, from 1 to 4.
+		*/
+		void StoreChannels(const __m128 values, float* const destination, const unsigned int count)
+		{
+			switch(count)
+			{
+			case 1:
+				_mm_store_ss(destination, values);
+				break;
+			case 2:
+				_mm_storel_pi(reinterpret_cast<__m64*>(destination), values);
+				break;
+			case 3:
+				{
+					float lanes[4];
+					_mm_storeu_ps(lanes, values);
+					std::copy(lanes, lanes + 3, destination);
+				}
+				break;
+			default:
+				_mm_storeu_ps(destination, values);
+				break;
+			}
+		}
+
+		/** Flushes values which have decayed to almost nothing to 0.
+		@param values The values.
+		@return The values, or 0 for those below \ref DENORMAL_GUARD.
+		*/
+		const __m128 FlushDenormals(const __m128 values)
+		{
+			const __m128 guard = _mm_set1_ps(DENORMAL_GUARD);
+			return _mm_sub_ps(_mm_add_ps(values, guard), guard);
+		}
+
+		/** Multiplies four values by the 4x4 Hadamard matrix.
+		@param values The values.
+		@return The sums and differences of the values, each with a different pattern of signs.
+		*/
+		const __m128 Hadamard(const __m128 values)
+		{
+			// [a, b, c, d] -> [a + b, a - b, c + d, c - d] -> sums and differences of the halves.
+			const __m128 pairs = _mm_add_ps(_mm_mul_ps(values, _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f)), _mm_shuffle_ps(values, values, _MM_SHUFFLE(2, 3, 0, 1)));
+			return _mm_add_ps(_mm_mul_ps(pairs, _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f)), _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 0, 3, 2)));
+		}
+
+		/** Finds the smallest prime number which is at least \a value, so that delay lines
+		don't share echoes.
+		@param value The smallest acceptable number.
+		@return The prime.
+		*/
+		const std::size_t NextPrime(const std::size_t value)
+		{
+			for(std::size_t candidate = std::max<std::size_t>(value, 2);; ++candidate)
+			{
+				bool is_prime = true;
+				for(std::size_t divisor = 2; divisor * divisor <= candidate; ++divisor)
+				{
+					if(candidate % divisor == 0)
+					{
+						is_prime = false;
+						break;
+					}
+				}
+				if(is_prime == true)
+				{
+					return candidate;
+				}
+			}
+		}
+
+		/** Converts a lookahead to frames.
+		@param lookahead The lookahead, in seconds.
+		@param sample_rate The number of frames per second.
+		@return The lookahead, in frames; at least one.
+		*/
+		const std::size_t LookaheadFrames(const float lookahead, const unsigned int sample_rate)
+		{
+			const double frames = static_cast<double>(lookahead) * sample_rate + 0.5;
+			// Written so that NaNs give one frame.
+			return (frames >= 2.0) ? static_cast<std::size_t>(frames) : 1;
+		}
+
+		/** Finds the loudest sample of each frame.
+		@param frames The interleaved frames.
+		@param frame_count The number of frames.
+		@param channel_count The number of channels in each frame.
+		@param peaks [OUT] Receives the absolute value of the loudest sample of each frame.
+		*/
+		void FindPeaks(const float* const frames, const std::size_t frame_count, const unsigned short channel_count, float* const peaks)
+		{
+			const __m128 magnitude_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+			std::size_t i = 0;
+			if(channel_count == 1)
+			{
+				for(; i + 4 <= frame_count; i += 4)
+				{
+					_mm_storeu_ps(&peaks[i], _mm_and_ps(_mm_loadu_ps(&frames[i]), magnitude_mask));
+				}
+			}
+			else if(channel_count == 2)
+			{
+				// Four frames at a time: split the left and right samples, and take the larger.
+				for(; i + 4 <= frame_count; i += 4)
+				{
+					const __m128 first = _mm_and_ps(_mm_loadu_ps(&frames[i * 2]), magnitude_mask);
+					const __m128 second = _mm_and_ps(_mm_loadu_ps(&frames[i * 2 + 4]), magnitude_mask);
+					const __m128 left = _mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0));
+					const __m128 right = _mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1));
+					_mm_storeu_ps(&peaks[i], _mm_max_ps(left, right));
+				}
+			}
+			for(; i < frame_count; ++i)
+			{
+				float peak = 0.0f;
+				for(unsigned short channel = 0; channel < channel_count; ++channel)
+				{
+					peak = std::max(peak, std::abs(frames[i * channel_count + channel]));
+				}
+				peaks[i] = peak;
+			}
+		}
+
+		/** Scales each frame by its gain.
+		@param frames [IN/OUT] The interleaved frames.
+		@param gains The gain of each frame.
+		@param frame_count The number of frames.
+		@param channel_count The number of channels in each frame.
+		*/
+		void ApplyGains(float* const frames, const float* const gains, const std::size_t frame_count, const unsigned short channel_count)
+		{
+			std::size_t i = 0;
+			if(channel_count == 1)
+			{
+				for(; i + 4 <= frame_count; i += 4)
+				{
+					_mm_storeu_ps(&frames[i], _mm_mul_ps(_mm_loadu_ps(&frames[i]), _mm_loadu_ps(&gains[i])));
+				}
+			}
+			else if(channel_count == 2)
+			{
+				// Two frames at a time, each gain repeated for both of its frame's samples.
+				for(; i + 2 <= frame_count; i += 2)
+				{
+					const __m128 pair = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(&gains[i]));
+					_mm_storeu_ps(&frames[i * 2], _mm_mul_ps(_mm_loadu_ps(&frames[i * 2]), _mm_unpacklo_ps(pair, pair)));
+				}
+			}
+			for(; i < frame_count; ++i)
+			{
+				for(unsigned short channel = 0; channel < channel_count; ++channel)
+				{
+					frames[i * channel_count + channel] *= gains[i];
+				}
+			}
+		}
+	}
+
+
+
+} // sound
+} // avl
@@ -0,0 +1,359 @@
+#pragma once
+#ifndef AVL_SOUND_DSP_EFFECTS__
+#define AVL_SOUND_DSP_EFFECTS__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Defines the \ref avl::sound::DSPEffect interface, and the filter, reverb, and limiter
+effects which a mix can be processed with.
+@par Format:
+Effects process blocks of interleaved float frames in place, the same as the mix which
+they're applied to. Each effect allocates everything which it needs when it's constructed,
+so that processing never allocates, and uses SSE2 for the work which it can do several
+samples at a time.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include<vector>
+#include<cstddef>
+
+
+namespace avl
+{
+namespace sound
+{
+
+	/**
+	Processes blocks of float frames in place, keeping whatever state it needs from one
+	block to the next.
+	*/
+	class DSPEffect
+	{
+	public:
+		/** Basic destructor.
+		*/
+		virtual ~DSPEffect();
+
+		/** Processes the next frames of the audio which this effect is applied to.
+		@param frames [IN/OUT] The interleaved frames, with \ref GetChannelCount() channels.
+		@param frame_count The number of frames.
+		*/
+		virtual void Process(float* const frames, const std::size_t frame_count) = 0;
+
+		/** Forgets the audio processed so far, as though the effect had just been created.
+		*/
+		virtual void Reset() = 0;
+
+		/** Accesses the number of frames per second which the effect expects.
+		@return The sample rate.
+		*/
+		const unsigned int GetSampleRate() const;
+
+		/** Accesses the number of channels in each frame which the effect expects.
+		@return The number of channels.
+		*/
+		const unsigned short GetChannelCount() const;
+
+	protected:
+		/** Basic constructor.
+		@param sample_rate The number of frames per second.
+		@param channel_count The number of channels in each frame.
+		@throws InvalidArgumentException If \a sample_rate or \a channel_count is 0.
+		*/
+		DSPEffect(const unsigned int sample_rate, const unsigned short channel_count);
+
+	private:
+		/// The number of frames per second.
+		const unsigned int sample_rate;
+		/// The number of channels in each frame.
+		const unsigned short channel_count;
+
+		/// NOT IMPLEMENTED.
+		DSPEffect(const DSPEffect&);
+		/// NOT IMPLEMENTED.
+		const DSPEffect& operator=(const DSPEffect&);
+	};
+
+
+
+	/**
+	A second-order low-pass or high-pass filter, with the coefficients from Robert
+	Bristow-Johnson's Audio EQ Cookbook. Up to four channels are filtered at once, one
+	channel per SSE2 lane.
+	*/
+	class BiquadFilter: public DSPEffect
+	{
+	public:
+		/** The kinds of filter.
+		*/
+		enum Type
+		{
+			/// Passes the frequencies below the cutoff.
+			LOW_PASS,
+			/// Passes the frequencies above the cutoff.
+			HIGH_PASS
+		};
+
+		/** Basic constructor.
+		@param sample_rate The number of frames per second.
+		@param channel_count The number of channels in each frame.
+		@param type The kind of filter.
+		@param cutoff The cutoff frequency, in Hz.
+		@param q The resonance at the cutoff; the default gives the flattest passband.
+		@throws InvalidArgumentException If \a sample_rate or \a channel_count is 0, if
+		\a cutoff isn't between 0 and half of \a sample_rate, or if \a q isn't greater than 0.
+		*/
+		BiquadFilter(const unsigned int sample_rate, const unsigned short channel_count, const Type type, const float cutoff, const float q = 0.7071f);
+
+		/** Basic destructor.
+		*/
+		~BiquadFilter();
+
+		/** Moves the cutoff, keeping the filter's state so that sweeping it doesn't click.
+		@param new_cutoff The cutoff frequency, in Hz.
+		@throws InvalidArgumentException If \a new_cutoff isn't between 0 and half of the
+		sample rate.
+		*/
+		void SetCutoff(const float new_cutoff);
+
+		/** Accesses the cutoff frequency.
+		@return The cutoff, in Hz.
+		*/
+		const float GetCutoff() const;
+
+		/** Filters the next frames.
+		@param frames [IN/OUT] The interleaved frames.
+		@param frame_count The number of frames.
+		*/
+		void Process(float* const frames, const std::size_t frame_count);
+
+		/** Clears the filter's state.
+		*/
+		void Reset();
+
+	private:
+		/** Works out the coefficients for the type, cutoff, and resonance.
+		*/
+		void ComputeCoefficients();
+
+		/// The kind of filter.
+		const Type type;
+		/// The cutoff frequency, in Hz.
+		float cutoff;
+		/// The resonance at the cutoff.
+		const float q;
+		/// The feedforward coefficients, normalized.
+		float b0, b1, b2;
+		/// The feedback coefficients, normalized.
+		float a1, a2;
+		/// The first state of each channel, padded to a whole number of groups of four.
+		std::vector<float> first_state;
+		/// The second state of each channel, padded the same way.
+		std::vector<float> second_state;
+	};
+
+
+
+	/**
+	A reverb built from a feedback delay network: four delay lines of mutually prime
+	lengths, damped by a one-pole low-pass filter each, and fed back into each other through
+	a Hadamard matrix, so that the echoes grow denser as they decay. The four lines are run
+	at once, one per SSE2 lane. The channels are mixed down to feed the network, and the
+	even and odd channels take the wet signal from different lines, for width.
+	*/
+	class Reverb: public DSPEffect
+	{
+	public:
+		/** Basic constructor.
+		@param sample_rate The number of frames per second.
+		@param channel_count The number of channels in each frame.
+		@param decay_time The number of seconds which the reverb takes to fall by 60 dB.
+		@param damping How much the high frequencies are damped on each echo, from 0 to 1.
+		@param wet How much of the reverb is mixed into the output.
+		@param dry How much of the input is mixed into the output.
+		@throws InvalidArgumentException If \a sample_rate or \a channel_count is 0, if
+		\a decay_time isn't greater than 0, or if \a damping isn't from 0 to 1.
+		@throws OutOfMemoryError If unable to allocate the delay lines.
+		*/
+		Reverb(const unsigned int sample_rate, const unsigned short channel_count, const float decay_time = 1.5f, const float damping = 0.3f,
+			const float wet = 0.25f, const float dry = 1.0f);
+
+		/** Basic destructor.
+		*/
+		~Reverb();
+
+		/** Changes how long the reverb rings for.
+		@param new_decay_time The number of seconds which the reverb takes to fall by 60 dB.
+		@throws InvalidArgumentException If \a new_decay_time isn't greater than 0.
+		*/
+		void SetDecayTime(const float new_decay_time);
+
+		/** Changes how much the high frequencies are damped on each echo.
+		@param new_damping The damping, from 0 to 1.
+		@throws InvalidArgumentException If \a new_damping isn't from 0 to 1.
+		*/
+		void SetDamping(const float new_damping);
+
+		/** Changes how the reverb is mixed with the input.
+		@param new_wet How much of the reverb is mixed into the output.
+		@param new_dry How much of the input is mixed into the output.
+		*/
+		void SetMix(const float new_wet, const float new_dry);
+
+		/** Adds reverb to the next frames.
+		@param frames [IN/OUT] The interleaved frames.
+		@param frame_count The number of frames.
+		*/
+		void Process(float* const frames, const std::size_t frame_count);
+
+		/** Silences the delay lines.
+		*/
+		void Reset();
+
+		/// The number of delay lines.
+		static const unsigned int LINE_COUNT = 4;
+
+	private:
+		/** Works out the feedback gain of each line from its length and the decay time.
+		*/
+		void ComputeGains();
+
+		/// The number of seconds which the reverb takes to fall by 60 dB.
+		float decay_time;
+		/// How much the high frequencies are damped on each echo.
+		float damping;
+		/// How much of the reverb is mixed into the output.
+		float wet;
+		/// How much of the input is mixed into the output.
+		float dry;
+		/// The feedback gain of each line.
+		float gains[LINE_COUNT];
+		/// The length of each line, in frames.
+		std::size_t lengths[LINE_COUNT];
+		/// Where each line starts in \ref lines.
+		std::size_t offsets[LINE_COUNT];
+		/// The read and write position within each line.
+		std::size_t positions[LINE_COUNT];
+		/// The state of each line's low-pass filter.
+		float filter_states[LINE_COUNT];
+		/// The delay lines, one after another.
+		std::vector<float> lines;
+	};
+
+
+
+	/**
+	Keeps the peaks of the audio at or below a threshold without clipping them. The audio
+	is delayed by a short lookahead so that the gain can be turned down smoothly before
+	each peak arrives, rather than all at once as it does.
+	@par Gain:
+	Each frame needs a gain which brings its loudest channel down to the threshold. The
+	gain applied to a frame is the smallest of those which the frames within the lookahead
+	need, allowed to recover at the release rate, and then averaged over the lookahead: the
+	average only includes gains which are at most what the frame needs, so the threshold
+	holds, and it ramps down linearly rather than stepping.
+	*/
+	class Limiter: public DSPEffect
+	{
+	public:
+		/** Basic constructor.
+		@param sample_rate The number of frames per second.
+		@param channel_count The number of channels in each frame.
+		@param threshold The largest sample which the output may have.
+		@param lookahead The number of seconds by which the audio is delayed. At least one
+		frame is used.
+		@param release The number of seconds which the gain takes to recover by about two
+		thirds after a peak has passed.
+		@throws InvalidArgumentException If \a sample_rate or \a channel_count is 0, or if
+		\a threshold, \a lookahead, or \a release isn't greater than 0.
+		@throws OutOfMemoryError If unable to allocate the delay line.
+		*/
+		Limiter(const unsigned int sample_rate, const unsigned short channel_count, const float threshold = 0.9f, const float lookahead = 0.005f,
+			const float release = 0.1f);
+
+		/** Basic destructor.
+		*/
+		~Limiter();
+
+		/** Limits the next frames. They come out delayed by \ref GetLatency() frames.
+		@param frames [IN/OUT] The interleaved frames.
+		@param frame_count The number of frames.
+		*/
+		void Process(float* const frames, const std::size_t frame_count);
+
+		/** Silences the delay line and lets the gain recover at once.
+		*/
+		void Reset();
+
+		/** Accesses the number of frames by which the audio is delayed.
+		@return The lookahead, in frames.
+		*/
+		const std::size_t GetLatency() const;
+
+		/** Accesses the largest sample which the output may have.
+		@return The threshold.
+		*/
+		const float GetThreshold() const;
+
+	private:
+		/** Works out the gains of the frames which are about to leave the delay line.
+		@param count The number of frames whose peaks are in \ref peaks.
+		*/
+		void ComputeGains(const std::size_t count);
+
+		/// The largest sample which the output may have.
+		const float threshold;
+		/// How far the gain recovers toward 1 in each frame.
+		const float release_coefficient;
+		/// The number of frames by which the audio is delayed.
+		const std::size_t latency;
+		/// The delayed frames, as a ring.
+		std::vector<float> delay_line;
+		/// The frame of \ref delay_line which is read and written next.
+		std::size_t delay_position;
+		/// The gains needed by the frames within the lookahead which might yet be the
+		/// smallest, as a ring in the order they arrived; each is smaller than the last.
+		std::vector<float> minimum_gains;
+		/// The number of the frame which each of \ref minimum_gains belongs to.
+		std::vector<unsigned long long> minimum_frames;
+		/// The index in \ref minimum_gains of the oldest, and so smallest, gain.
+		std::size_t minimum_first;
+		/// The number of gains in \ref minimum_gains.
+		std::size_t minimum_count;
+		/// The number of frames processed since the limiter was created or reset.
+		unsigned long long frame_number;
+		/// The smallest needed gain, after being allowed to recover at the release rate.
+		float released_gain;
+		/// The last lookahead's worth of released gains, as a ring, for averaging.
+		std::vector<float> average_window;
+		/// The index in \ref average_window which is written next.
+		std::size_t average_position;
+		/// The sum of \ref average_window.
+		double average_sum;
+		/// The loudest sample of each frame in the block being processed.
+		std::vector<float> peaks;
+		/// The gain of each frame in the block being processed.
+		std::vector<float> frame_gains;
+	};
+
+
+
+} // sound
+} // avl
+#endif // AVL_SOUND_DSP_EFFECTS__
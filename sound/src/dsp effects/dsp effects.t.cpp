@@ -0,0 +1,310 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the dsp effects component. See "dsp effects.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"dsp effects.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\timer\timer.h"
+#include<iostream>
+#include<vector>
+#include<cmath>
+#include<cstdlib>
+
+
+
+// Anonymous namespace.
+namespace
+{
+	const float RandomSample();
+	const double Energy(const std::vector<float>& samples, const std::size_t first, const std::size_t last);
+}
+
+
+
+void TestDSPEffectsComponent()
+{
+	using namespace avl::sound;
+	using avl::utility::InvalidArgumentException;
+	using avl::utility::Timer;
+
+	const unsigned int sample_rate = 44100;
+
+	// Invalid arguments are refused.
+	{
+		unsigned int refused_count = 0;
+		try { BiquadFilter filter(0, 2, BiquadFilter::LOW_PASS, 1000.0f); } catch(const InvalidArgumentException&) { ++refused_count; }
+		try { BiquadFilter filter(sample_rate, 0, BiquadFilter::LOW_PASS, 1000.0f); } catch(const InvalidArgumentException&) { ++refused_count; }
+		try { BiquadFilter filter(sample_rate, 2, BiquadFilter::LOW_PASS, 0.0f); } catch(const InvalidArgumentException&) { ++refused_count; }
+		try { BiquadFilter filter(sample_rate, 2, BiquadFilter::LOW_PASS, 30000.0f); } catch(const InvalidArgumentException&) { ++refused_count; }
+		try { BiquadFilter filter(sample_rate, 2, BiquadFilter::LOW_PASS, 1000.0f, 0.0f); } catch(const InvalidArgumentException&) { ++refused_count; }
+		try { Reverb reverb(sample_rate, 2, 0.0f); } catch(const InvalidArgumentException&) { ++refused_count; }
+		try { Reverb reverb(sample_rate, 2, 1.0f, 1.5f); } catch(const InvalidArgumentException&) { ++refused_count; }
+		try { Limiter limiter(sample_rate, 2, 0.0f); } catch(const InvalidArgumentException&) { ++refused_count; }
+		try { Limiter limiter(sample_rate, 2, 0.9f, 0.0f); } catch(const InvalidArgumentException&) { ++refused_count; }
+		try { Limiter limiter(sample_rate, 2, 0.9f, 0.005f, std::sqrt(-1.0f)); } catch(const InvalidArgumentException&) { ++refused_count; }
+		ASSERT(refused_count == 10);
+		BiquadFilter filter(sample_rate, 2, BiquadFilter::LOW_PASS, 1000.0f);
+		try { filter.SetCutoff(-5.0f); } catch(const InvalidArgumentException&) { ++refused_count; }
+		ASSERT(refused_count == 11);
+		ASSERT(filter.GetCutoff() == 1000.0f);
+		std::cout << "Invalid arguments are refused.\n";
+	}
+
+	// Each channel count filters the same as a plain biquad does, one sample at a time,
+	// across blocks of uneven sizes.
+	{
+		for(unsigned short channel_count = 1; channel_count <= 6; ++channel_count)
+		{
+			const float cutoff = 2500.0f;
+			const float q = 1.2f;
+			BiquadFilter filter(sample_rate, channel_count, BiquadFilter::HIGH_PASS, cutoff, q);
+			const std::size_t frame_count = 1000;
+			std::vector<float> samples(frame_count * channel_count);
+			for(std::size_t i = 0; i < samples.size(); ++i)
+			{
+				samples[i] = RandomSample();
+			}
+			std::vector<float> expected(samples);
+			const double angle = 2.0 * 3.14159265358979323846 * cutoff / sample_rate;
+			const double alpha = std::sin(angle) / (2.0 * q);
+			const double a0 = 1.0 + alpha;
+			const double b0 = (1.0 + std::cos(angle)) / 2.0 / a0;
+			const double b1 = -(1.0 + std::cos(angle)) / a0;
+			const double a1 = -2.0 * std::cos(angle) / a0;
+			const double a2 = (1.0 - alpha) / a0;
+			for(unsigned short channel = 0; channel < channel_count; ++channel)
+			{
+				double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+				for(std::size_t i = 0; i < frame_count; ++i)
+				{
+					const double x = expected[i * channel_count + channel];
+					const double y = b0 * x + b1 * x1 + b0 * x2 - a1 * y1 - a2 * y2;
+					x2 = x1;
+					x1 = x;
+					y2 = y1;
+					y1 = y;
+					expected[i * channel_count + channel] = static_cast<float>(y);
+				}
+			}
+			for(std::size_t done = 0, block = 1; done < frame_count; done += block, block = block * 3 + 1)
+			{
+				block = std::min(block, frame_count - done);
+				filter.Process(&samples[done * channel_count], block);
+			}
+			for(std::size_t i = 0; i < samples.size(); ++i)
+			{
+				ASSERT(std::abs(samples[i] - expected[i]) <= 1e-4f);
+			}
+		}
+		std::cout << "Filters match the plain form for every channel count.\n";
+	}
+
+	// A low-pass filter passes a constant and removes a tone near the Nyquist frequency; a
+	// high-pass filter does the opposite.
+	{
+		const std::size_t frame_count = 4410;
+		std::vector<float> constant(frame_count * 2, 0.5f);
+		std::vector<float> tone(frame_count * 2);
+		for(std::size_t i = 0; i < frame_count; ++i)
+		{
+			tone[i * 2] = tone[i * 2 + 1] = static_cast<float>(std::sin(i * 0.95 * 3.14159265358979323846));
+		}
+		std::vector<float> low_constant(constant), low_tone(tone), high_constant(constant), high_tone(tone);
+		BiquadFilter low_pass(sample_rate, 2, BiquadFilter::LOW_PASS, 500.0f);
+		low_pass.Process(&low_constant[0], frame_count);
+		low_pass.Reset();
+		low_pass.Process(&low_tone[0], frame_count);
+		BiquadFilter high_pass(sample_rate, 2, BiquadFilter::HIGH_PASS, 500.0f);
+		high_pass.Process(&high_constant[0], frame_count);
+		high_pass.Reset();
+		high_pass.Process(&high_tone[0], frame_count);
+		const std::size_t settled = frame_count / 2 * 2;
+		ASSERT(std::abs(low_constant[frame_count * 2 - 1] - 0.5f) <= 1e-3f);
+		ASSERT(Energy(low_tone, settled, frame_count * 2) < Energy(tone, settled, frame_count * 2) * 0.001);
+		ASSERT(std::abs(high_constant[frame_count * 2 - 1]) <= 1e-3f);
+		ASSERT(Energy(high_tone, settled, frame_count * 2) > Energy(tone, settled, frame_count * 2) * 0.9);
+		std::cout << "Filters pass and stop the right frequencies.\n";
+	}
+
+	// An impulse rings out and decays over the decay time, and reset silences the lines.
+	{
+		const float decay_time = 0.5f;
+		Reverb reverb(sample_rate, 2, decay_time, 0.2f, 1.0f, 0.0f);
+		const std::size_t frame_count = sample_rate;
+		std::vector<float> samples(frame_count * 2, 0.0f);
+		samples[0] = samples[1] = 1.0f;
+		reverb.Process(&samples[0], frame_count);
+		const std::size_t tenth = sample_rate / 10 * 2;
+		const double early = Energy(samples, 0, tenth);
+		const double late = Energy(samples, static_cast<std::size_t>(decay_time * sample_rate) * 2, static_cast<std::size_t>(decay_time * sample_rate) * 2 + tenth);
+		ASSERT(early > 0.0);
+		ASSERT(late < early * 1e-4);
+		bool is_widened = false;
+		for(std::size_t i = 0; i < tenth; i += 2)
+		{
+			ASSERT(std::abs(samples[i]) < 2.0f);
+			is_widened = is_widened || samples[i] != samples[i + 1];
+		}
+		ASSERT(is_widened == true);
+		reverb.Reset();
+		std::vector<float> silence(frame_count * 2, 0.0f);
+		reverb.Process(&silence[0], frame_count);
+		ASSERT(Energy(silence, 0, silence.size()) == 0.0);
+		// Dry only leaves the input as it was.
+		reverb.SetMix(0.0f, 1.0f);
+		std::vector<float> dry(256);
+		for(std::size_t i = 0; i < dry.size(); ++i)
+		{
+			dry[i] = RandomSample();
+		}
+		std::vector<float> processed(dry);
+		reverb.Process(&processed[0], processed.size() / 2);
+		ASSERT(processed == dry);
+		std::cout << "The reverb decays over its decay time.\n";
+	}
+
+	// Loud audio never comes out above the threshold, and quiet audio comes out unchanged,
+	// once the lookahead has passed.
+	{
+		for(unsigned short channel_count = 1; channel_count <= 3; ++channel_count)
+		{
+			Limiter limiter(sample_rate, channel_count, 0.8f, 0.002f, 0.05f);
+			const std::size_t latency = limiter.GetLatency();
+			ASSERT(latency == 88);
+			const std::size_t frame_count = 10000;
+			std::vector<float> loud(frame_count * channel_count);
+			for(std::size_t i = 0; i < loud.size(); ++i)
+			{
+				loud[i] = RandomSample() * ((i / 1000 % 2 == 0) ? 4.0f : 0.5f);
+			}
+			std::vector<float> limited(loud);
+			for(std::size_t done = 0, block = 7; done < frame_count; done += block, block = block * 2 + 1)
+			{
+				block = std::min(block, frame_count - done);
+				limiter.Process(&limited[done * channel_count], block);
+			}
+			for(std::size_t i = 0; i < limited.size(); ++i)
+			{
+				ASSERT(std::abs(limited[i]) <= limiter.GetThreshold() * 1.00001f);
+			}
+
+			limiter.Reset();
+			std::vector<float> quiet(frame_count * channel_count);
+			for(std::size_t i = 0; i < quiet.size(); ++i)
+			{
+				quiet[i] = RandomSample() * 0.5f;
+			}
+			std::vector<float> delayed(quiet);
+			limiter.Process(&delayed[0], frame_count);
+			for(std::size_t i = 0; i < latency * channel_count; ++i)
+			{
+				ASSERT(delayed[i] == 0.0f);
+			}
+			for(std::size_t i = latency * channel_count; i < delayed.size(); ++i)
+			{
+				ASSERT(delayed[i] == quiet[i - latency * channel_count]);
+			}
+		}
+		std::cout << "The limiter holds the threshold.\n";
+	}
+
+	// A steadily decaying peak needs a larger gain each frame, so none of the gains within the
+	// lookahead is ever dropped as redundant; the limiter still holds the threshold.
+	{
+		Limiter limiter(sample_rate, 1, 0.9f, 0.005f, 0.0005f);
+		const std::size_t frame_count = sample_rate / 10;
+		std::vector<float> decay(frame_count);
+		for(std::size_t i = 0; i < frame_count; ++i)
+		{
+			decay[i] = 5.0f * std::exp(-static_cast<float>(i) / (sample_rate * 0.01f));
+		}
+		for(std::size_t done = 0; done < frame_count; done += 512)
+		{
+			limiter.Process(&decay[done], std::min<std::size_t>(512, frame_count - done));
+		}
+		for(std::size_t i = 0; i < frame_count; ++i)
+		{
+			ASSERT(std::abs(decay[i]) <= limiter.GetThreshold() * 1.00001f);
+		}
+		std::cout << "The limiter holds the threshold through a decay.\n";
+	}
+
+	// The cost of each effect, on stereo blocks of the size which the software engine mixes.
+	{
+		const std::size_t frame_count = 512;
+		const unsigned int repetitions = 2000;
+		std::vector<float> samples(frame_count * 2);
+		for(std::size_t i = 0; i < samples.size(); ++i)
+		{
+			samples[i] = RandomSample();
+		}
+		BiquadFilter filter(sample_rate, 2, BiquadFilter::LOW_PASS, 2000.0f);
+		Reverb reverb(sample_rate, 2);
+		Limiter limiter(sample_rate, 2);
+		DSPEffect* const effects[3] = {&filter, &reverb, &limiter};
+		const char* const names[3] = {"biquad  ", "reverb  ", "limiter "};
+		std::cout << "Microseconds per block of " << frame_count << " stereo frames:\n";
+		for(unsigned int effect = 0; effect < 3; ++effect)
+		{
+			std::vector<float> block(samples);
+			Timer timer;
+			for(unsigned int repetition = 0; repetition < repetitions; ++repetition)
+			{
+				effects[effect]->Process(&block[0], frame_count);
+			}
+			std::cout << "  " << names[effect] << timer.Elapsed() * 1000000.0 / repetitions << "\n";
+		}
+	}
+
+	system("pause");
+}
+
+
+
+// Anonymous namespace.
+namespace
+{
+	/** Makes up a sample.
+	@return A sample from -1 to 1.
+	*/
+	const float RandomSample()
+	{
+		return static_cast<float>(rand() % 2001 - 1000) / 1000.0f;
+	}
+
+	/** Sums the squares of some samples.
+	@param samples The samples.
+	@param first The first sample to include.
+	@param last One past the last sample to include.
+	@return The sum.
+	*/
+	const double Energy(const std::vector<float>& samples, const std::size_t first, const std::size_t last)
+	{
+		double energy = 0.0;
+		for(std::size_t i = first; i < last; ++i)
+		{
+			energy += static_cast<double>(samples[i]) * samples[i];
+		}
+		return energy;
+	}
+}
@@ -23,11 +23,16 @@ Implementation for the load wav file component. See "load wav file.h" for detail
 
 #include"load wav file.h"
 #include"..\..\..\utility\src\file operations\file operations.h"
+#include"..\..\..\utility\src\pack file\pack file.h"
 #include"..\..\..\utility\src\exceptions\exceptions.h"
 #include"..\..\..\utility\src\assert\assert.h"
-#include<vector>
+#include"..\adpcm\adpcm.h"
 #include<string>
+#include<vector>
 #include<cstdint>
+#include<cstring>
+#include<memory>
+#include<new>
 
 namespace avl
 {
@@ -40,11 +45,22 @@ namespace sound
 		const std::string WAVE_ID = "WAVE";
 		const std::string FMT_ID = "fmt ";
 		const std::string DATA_ID = "data";
+		const std::string FACT_ID = "fact";
 		const unsigned short WAVE_PCM = 1;
+		const unsigned short WAVE_MS_ADPCM = 2;
+		const unsigned short WAVE_IMA_ADPCM = 0x11;
+		/// The size of the format chunk for each encoding; ADPCM adds the size of its extra information, then the extra information.
+		const std::size_t PCM_FMT_SIZE = 16;
+		const std::size_t IMA_FMT_SIZE = 20;
+		const std::size_t MS_FMT_SIZE = 50;
+		/// The number of Microsoft ADPCM coefficient pairs, then each pair, exactly as stored in the format chunk.
+		const std::int16_t MS_COEFFICIENTS[] = {7, 256, 0, 512, -256, 0, 0, 192, 64, 240, 0, 460, -208, 392, -232};
 
 		struct RIFFChunk;
 
-		const bool FindChunk(const std::vector<char>& data, RIFFChunk& chunk);
+		const bool FindChunk(const char* const data, const std::size_t data_size, RIFFChunk& chunk);
+		void AppendID(const std::string& id, std::vector<char>& data);
+		void AppendInteger(const std::size_t value, const unsigned int size, std::vector<char>& data);
 
 		struct RIFFChunk
 		{
@@ -56,92 +72,201 @@ namespace sound
 
 
 	// See function declaration for details.
-	SoundSample LoadWAVFile(const std::string& file_name)
+	const WAVFileFormat ParseWAVFile(const utility::MappedFile& file)
 	{
-		std::vector<char> file_data;
-		utility::LoadFile(file_name, file_data);
+		const std::string& file_name = file.GetFileName();
+		const char* const file_data = file.GetData();
+		const std::size_t file_size = file.GetSize();
 
 		RIFFChunk chunk;
 		chunk.offset = 0;
 		chunk.size = 0;
 
 		chunk.id = RIFF_ID;
-		if(FindChunk(file_data, chunk) == false)
+		if(FindChunk(file_data, file_size, chunk) == false || chunk.offset + 12 > file_size)
 		{
 			throw utility::FileFormatException(file_name);
 		}
 
 		chunk.offset += 8;
-		std::string file_type;
-		file_type.append(&file_data[chunk.offset], 4);
-
-		if(file_type != WAVE_ID)
+		if(WAVE_ID.compare(0, 4, &file_data[chunk.offset], 4) != 0)
 		{
-			throw utility::FileFormatException("file_name");
+			throw utility::FileFormatException(file_name);
 		}
 
+		// The other chunks are searched for from here, in whatever order they're in.
 		chunk.offset += 4;
+		const std::size_t body_offset = chunk.offset;
 		chunk.id = FMT_ID;
-		if(FindChunk(file_data, chunk) == false)
+		if(FindChunk(file_data, file_size, chunk) == false || chunk.size < 16)
 		{
-			throw utility::FileFormatException("file_name");
+			throw utility::FileFormatException(file_name);
 		}
+		const char* const fmt = &file_data[chunk.offset + 8];
+		const std::size_t fmt_size = chunk.size;
 
-		
 		unsigned short wave_format = 0;
-
-		chunk.offset += 8;
-		memcpy(&wave_format, &file_data[chunk.offset], 2);
-
-		if(wave_format != WAVE_PCM)
+		unsigned int bytes_per_sec = 0;
+		WAVFileFormat format;
+		memcpy(&wave_format, &fmt[0], 2);
+		memcpy(&format.channel_count, &fmt[2], 2);
+		memcpy(&format.frequency, &fmt[4], 4);
+		memcpy(&bytes_per_sec, &fmt[8], 4);
+		memcpy(&format.block_alignment, &fmt[12], 2);
+		memcpy(&format.bit_depth, &fmt[14], 2);
+
+		if(wave_format == WAVE_PCM)
 		{
-			throw utility::FileFormatException("file_name");
+			format.encoding = SoundSample::PCM;
+		}
+		else if(wave_format == WAVE_IMA_ADPCM && format.bit_depth == 4)
+		{
+			format.encoding = SoundSample::IMA_ADPCM;
+		}
+		else if(wave_format == WAVE_MS_ADPCM && format.bit_depth == 4 && fmt_size >= MS_FMT_SIZE)
+		{
+			// Only the standard coefficients are supported, which follow the samples per block.
+			format.encoding = SoundSample::MS_ADPCM;
+			if(memcmp(&fmt[20], MS_COEFFICIENTS, sizeof(MS_COEFFICIENTS)) != 0)
+			{
+				throw utility::FileFormatException(file_name);
+			}
+		}
+		else
+		{
+			throw utility::FileFormatException(file_name);
 		}
 
-		
-
-		unsigned short number_of_channels = 0;
-		unsigned int frequency = 0;
-		unsigned int bytes_per_sec = 0;
-		unsigned short block_alignment = 0;
-		unsigned short bit_depth = 0;
-		
-		
-		chunk.offset += 2;
-		memcpy(&number_of_channels, &file_data[chunk.offset], 2);
+		chunk.offset = body_offset;
+		chunk.id = DATA_ID;
+		if(FindChunk(file_data, file_size, chunk) == false)
+		{
+			throw utility::FileFormatException(file_name);
+		}
+		format.data_offset = chunk.offset + 8;
+		format.data_size = chunk.size;
 
-		chunk.offset += 2;
-		memcpy(&frequency, &file_data[chunk.offset], 4);
+		if(format.encoding == SoundSample::PCM)
+		{
+			format.frame_count = (format.block_alignment != 0) ? format.data_size / format.block_alignment : 0;
+			return format;
+		}
 
-		chunk.offset += 4;
-		memcpy(&bytes_per_sec, &file_data[chunk.offset], 4);
+		// The blocks hold a whole number of frames, so the real length is in the fact chunk, if
+		// there is one.
+		format.frame_count = GetADPCMFrameCount(format.encoding, format.block_alignment, format.channel_count, format.data_size);
+		if(format.frame_count == 0)
+		{
+			throw utility::FileFormatException(file_name);
+		}
+		chunk.offset = body_offset;
+		chunk.id = FACT_ID;
+		if(FindChunk(file_data, file_size, chunk) == true && chunk.size >= 4)
+		{
+			std::uint32_t fact_frames = 0;
+			memcpy(&fact_frames, &file_data[chunk.offset + 8], 4);
+			if(fact_frames < format.frame_count)
+			{
+				format.frame_count = fact_frames;
+			}
+		}
+		return format;
+	}
 
-		chunk.offset += 4;
-		memcpy(&block_alignment, &file_data[chunk.offset], 2);
+	// See function declaration for details.
+	SoundSample LoadWAVFile(const std::string& file_name, const bool is_decoding_adpcm)
+	{
+		// Parse straight out of the mapped file or pack file entry rather than reading it into memory first.
+		const utility::MappedFile file = utility::OpenAssetFile(file_name);
+		const WAVFileFormat format = ParseWAVFile(file);
+
+		// Share the audio data straight out of the mapped file or pack file entry rather than copying it,
+		// and keep the file open for as long as any sample shares the data.
+		std::shared_ptr<const char> audio_data;
+		try
+		{
+			const std::shared_ptr<const utility::MappedFile> shared_file(new utility::MappedFile(file));
+			audio_data = std::shared_ptr<const char>(shared_file, &shared_file->GetData()[format.data_offset]);
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw utility::OutOfMemoryError();
+		}
 
-		chunk.offset += 2;
-		memcpy(&bit_depth, &file_data[chunk.offset], 2);
+		if(format.encoding == SoundSample::PCM)
+		{
+			return SoundSample(format.bit_depth, format.frequency, format.channel_count, format.data_size, audio_data);
+		}
+		const SoundSample sample(format.encoding, format.frequency, format.channel_count, format.block_alignment, format.frame_count, format.data_size, audio_data);
+		return (is_decoding_adpcm == true) ? DecodeADPCMSample(sample) : sample;
+	}
 
+	// See function declaration for details.
+	void SaveWAVFile(const std::string& file_name, const SoundSample& sample)
+	{
+		const SoundSample::Encoding encoding = sample.GetEncoding();
+		const std::size_t fmt_size = (encoding == SoundSample::PCM) ? PCM_FMT_SIZE : ((encoding == SoundSample::IMA_ADPCM) ? IMA_FMT_SIZE : MS_FMT_SIZE);
+		// ADPCM needs a fact chunk to say how many frames the blocks really hold.
+		const std::size_t fact_size = (encoding == SoundSample::PCM) ? 0 : 12;
+		// Chunks are padded to an even size.
+		const std::size_t data_padding = sample.GetDataSize() % 2;
 
-		chunk.offset += 2;
-		chunk.id = DATA_ID;
-		if(FindChunk(file_data, chunk) == false)
+		std::vector<char> file_data;
+		try
 		{
-			throw utility::FileFormatException("file_name");
+			file_data.reserve(12 + 8 + fmt_size + fact_size + 8 + sample.GetDataSize() + data_padding);
 		}
+		catch(const std::bad_alloc&)
+		{
+			throw utility::OutOfMemoryError();
+		}
+		AppendID(RIFF_ID, file_data);
+		AppendInteger(4 + 8 + fmt_size + fact_size + 8 + sample.GetDataSize() + data_padding, 4, file_data);
+		AppendID(WAVE_ID, file_data);
+
+		const unsigned short block_alignment = sample.GetBlockAlignment();
+		AppendID(FMT_ID, file_data);
+		AppendInteger(fmt_size, 4, file_data);
+		AppendInteger((encoding == SoundSample::PCM) ? WAVE_PCM : ((encoding == SoundSample::IMA_ADPCM) ? WAVE_IMA_ADPCM : WAVE_MS_ADPCM), 2, file_data);
+		AppendInteger(sample.GetNumberOfChannels(), 2, file_data);
+		AppendInteger(sample.GetFrequency(), 4, file_data);
+		if(encoding == SoundSample::PCM)
+		{
+			AppendInteger(sample.GetFrequency() * block_alignment, 4, file_data);
+		}
+		else
+		{
+			// The average rate, rounded the way Windows' own encoders round it.
+			const std::size_t block_frames = GetADPCMBlockFrames(encoding, block_alignment, sample.GetNumberOfChannels());
+			AppendInteger(static_cast<unsigned long>((static_cast<unsigned long long>(sample.GetFrequency()) * block_alignment + block_frames / 2) / block_frames), 4, file_data);
+		}
+		AppendInteger(block_alignment, 2, file_data);
+		AppendInteger(sample.GetBitDepth(), 2, file_data);
+		if(encoding != SoundSample::PCM)
+		{
+			// The extra format information: its size, then the frames in each block, then for
+			// Microsoft ADPCM the coefficients.
+			AppendInteger(fmt_size - PCM_FMT_SIZE - 2, 2, file_data);
+			AppendInteger(GetADPCMBlockFrames(encoding, block_alignment, sample.GetNumberOfChannels()), 2, file_data);
+			if(encoding == SoundSample::MS_ADPCM)
+			{
+				file_data.insert(file_data.end(), reinterpret_cast<const char*>(MS_COEFFICIENTS), reinterpret_cast<const char*>(MS_COEFFICIENTS) + sizeof(MS_COEFFICIENTS));
+			}
 
-		// Check that the format information and size match up.
-
-		char* audio_data = new(std::nothrow) char[chunk.size];
+			AppendID(FACT_ID, file_data);
+			AppendInteger(4, 4, file_data);
+			AppendInteger(sample.GetFrameCount(), 4, file_data);
+		}
 
-		if(audio_data == nullptr)
+		AppendID(DATA_ID, file_data);
+		AppendInteger(sample.GetDataSize(), 4, file_data);
+		file_data.insert(file_data.end(), sample.GetAudioData(), sample.GetAudioData() + sample.GetDataSize());
+		if(data_padding != 0)
 		{
-			throw utility::OutOfMemoryError();
+			file_data.push_back(0);
 		}
 
-		memcpy(audio_data, &file_data[chunk.offset + 8], chunk.size);
-		
-		return SoundSample(bit_depth, frequency, number_of_channels, chunk.size, audio_data);
+		utility::WriteFile(file_name, file_data);
 	}
 
 
@@ -149,25 +274,30 @@ namespace sound
 	// Anonymous namespace.
 	namespace
 	{
-		/**
+		/** Searches for the chunk whose id is \a chunk.id, starting with the chunk
+		at \a chunk.offset.
+		@param data The contents of the RIFF file.
+		@param data_size The size of \a data in bytes.
+		@param chunk [IN/OUT] Supplies the id to search for and the offset to start
+		searching from. Receives the size and offset of the chunk if it's found.
+		@return True if the chunk was found and lies entirely within \a data.
 		*/
-		const bool FindChunk(const std::vector<char>& data, RIFFChunk& chunk)
+		const bool FindChunk(const char* const data, const std::size_t data_size, RIFFChunk& chunk)
 		{
-			ASSERT(chunk.offset <= data.size());
+			ASSERT(chunk.offset <= data_size);
 			std::size_t search_offset = chunk.offset;
-			std::string search_id;
 			unsigned long chunk_size = 0;
 
-			while(search_offset < data.size() + 8)
+			// Each chunk header is a 4-byte id followed by a 4-byte size.
+			while(search_offset + 8 <= data_size)
 			{
-				search_id.append(&data[search_offset], 4);
-				if(search_id == chunk.id)
+				memcpy(&chunk_size, &data[search_offset + 4], 4);
+				if(chunk.id.compare(0, 4, &data[search_offset], 4) == 0)
 				{
-					chunk.size = 0;
-					memcpy(&chunk.size, &data[search_offset + 4], 4);
+					chunk.size = chunk_size;
 					chunk.offset = search_offset;
 
-					if(chunk.offset + chunk.size + 4 >= data.size())
+					if(chunk.offset + 8 + chunk.size > data_size)
 					{
 						break;
 					}
@@ -175,12 +305,8 @@ namespace sound
 				}
 				else
 				{
-					search_id.clear();
-					search_offset += 4;
-					memcpy(&chunk_size, &data[search_offset], 4);
-					search_offset +=4;
-
-					if(search_offset + chunk_size >= data.size())
+					search_offset += 8;
+					if(search_offset + chunk_size >= data_size)
 					{
 						break;
 					}
@@ -189,10 +315,33 @@ namespace sound
 			}
 			chunk.id.clear();
 			chunk.size = 0;
-			chunk.offset = data.size() - 1;
+			chunk.offset = data_size;
 			return false;
 		}
 
+		/** Appends a RIFF chunk id.
+		@param id The id, which is 4 characters.
+		@param data [IN/OUT] The data to append to.
+		*/
+		void AppendID(const std::string& id, std::vector<char>& data)
+		{
+			ASSERT(id.size() == 4);
+			data.insert(data.end(), id.begin(), id.end());
+		}
+
+		/** Appends a little-endian integer.
+		@param value The integer.
+		@param size The size of the integer in bytes.
+		@param data [IN/OUT] The data to append to.
+		*/
+		void AppendInteger(const std::size_t value, const unsigned int size, std::vector<char>& data)
+		{
+			for(unsigned int byte = 0; byte < size; ++byte)
+			{
+				data.push_back(static_cast<char>(value >> (byte * 8)));
+			}
+		}
+
 	}
 
 
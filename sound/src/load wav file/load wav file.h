@@ -19,14 +19,17 @@ along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
 */
 /**
 @file
-Provides functionality for loading WAV files.
-@note Currently only supports uncompressed PCM format.
+Provides functionality for loading and saving WAV files.
+@note Supports uncompressed PCM, IMA ADPCM, and Microsoft ADPCM with the standard
+coefficients; see "adpcm.h".
 @author Sheldon Bachstein
 @date Jun 23, 2012
 */
 
 #include"..\sound sample\sound sample.h"
+#include"..\..\..\utility\src\file operations\file operations.h"
 #include<string>
+#include<cstddef>
 
 namespace avl
 {
@@ -34,10 +37,56 @@ namespace sound
 {
 
 	/**
-	@todo Document this file.
-	@todo Make use of the (soon to be added) utility::FileFormatException.
+	The format of a WAV file, and where its audio data lies within the file.
 	*/
-	SoundSample LoadWAVFile(const std::string& file_name);
+	struct WAVFileFormat
+	{
+		/// How the audio data is encoded.
+		SoundSample::Encoding encoding;
+		/// The bit depth of each sample.
+		unsigned short bit_depth;
+		/// The number of samples per second.
+		unsigned int frequency;
+		/// The number of audio channels.
+		unsigned short channel_count;
+		/// The offset of the audio data from the start of the file, in bytes.
+		std::size_t data_offset;
+		/// The size of the audio data in bytes.
+		std::size_t data_size;
+		/// The size of each block of audio data in bytes.
+		unsigned short block_alignment;
+		/// The number of frames which the audio data holds, once decoded.
+		std::size_t frame_count;
+	};
+
+	/** Reads the format of a WAV file and finds its audio data, without copying anything.
+	@param file The contents of the file.
+	@return The format of the file.
+	@throws FileFormatException If \a file isn't a WAV file in a supported format.
+	*/
+	const WAVFileFormat ParseWAVFile(const utility::MappedFile& file);
+
+	/** Loads a WAV file without copying its audio data: the returned sample shares the
+	data straight out of the mapped file or pack file entry, which stays open for as long
+	as any sample shares it.
+	@param file_name The name of the file, which is opened with utility::OpenAssetFile().
+	@param is_decoding_adpcm If true, ADPCM is decoded to 16-bit PCM, which takes a copy.
+	If false, the sample stays compressed, for engines which decode as they play.
+	@return The sample.
+	@throws FileNotFoundException If the file doesn't exist.
+	@throws FileFormatException If the file isn't a WAV file in a supported format.
+	@throws OutOfMemoryError If unable to share the file.
+	*/
+	SoundSample LoadWAVFile(const std::string& file_name, const bool is_decoding_adpcm = true);
+
+	/** Saves a sound sample as a WAV file, in whatever encoding it already has.
+	@param file_name The name of the file, which is replaced if it exists.
+	@param sample The sample.
+	@throws FileNotFoundException If the file can't be opened for writing.
+	@throws FileReadException If an error occurs while writing to the file.
+	@throws OutOfMemoryError If we run out of memory.
+	*/
+	void SaveWAVFile(const std::string& file_name, const SoundSample& sample);
 
 
 
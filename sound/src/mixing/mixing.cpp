@@ -0,0 +1,431 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the mixing component. See "mixing.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"mixing.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include<cstddef>
+#include<cstring>
+#include<emmintrin.h>
+
+
+namespace avl
+{
+namespace sound
+{
+	// See method definitions for details.
+	namespace
+	{
+		/// Scales 8-bit samples, once centered on 0, to floats.
+		const float SCALE_8 = 1.0f / 128.0f;
+		/// Scales 16-bit samples to floats.
+		const float SCALE_16 = 1.0f / 32768.0f;
+		/// Scales 24-bit samples to floats.
+		const float SCALE_24 = 1.0f / 8388608.0f;
+		/// Scales 32-bit samples to floats.
+		const float SCALE_32 = 1.0f / 2147483648.0f;
+		/// Scales floats to 16-bit samples. 1.0 maps to 32767, so that it doesn't saturate.
+		const float PCM16_SCALE = 32767.0f;
+		/// Scales floats to 8-bit samples, before they're centered on 128.
+		const float PCM8_SCALE = 127.0f;
+		/// Scales floats to 24-bit samples.
+		const float PCM24_SCALE = 8388607.0f;
+		/// Scales floats to 32-bit samples. A float can't hold 2147483647, so this one is a double.
+		const double PCM32_SCALE = 2147483647.0;
+
+		void Convert8BitToFloat(const unsigned char* const pcm, const std::size_t sample_count, float* const samples);
+		void Convert16BitToFloat(const char* const pcm, const std::size_t sample_count, float* const samples);
+		void Convert24BitToFloat(const unsigned char* const pcm, const std::size_t sample_count, float* const samples);
+		void Convert32BitToFloat(const char* const pcm, const std::size_t sample_count, float* const samples);
+		void ConvertFloatTo8Bit(const float* const samples, const std::size_t sample_count, unsigned char* const pcm);
+		void ConvertFloatTo24Bit(const float* const samples, const std::size_t sample_count, unsigned char* const pcm);
+		void ConvertFloatTo32Bit(const float* const samples, const std::size_t sample_count, char* const pcm);
+	}
+
+
+
+	// See function declaration for details.
+	void ConvertPCMToFloat(const char* const pcm, const unsigned short bit_depth, const std::size_t sample_count, float* const samples)
+	{
+		ASSERT(pcm != nullptr || sample_count == 0);
+		ASSERT(samples != nullptr || sample_count == 0);
+		switch(bit_depth)
+		{
+		case 8:
+			Convert8BitToFloat(reinterpret_cast<const unsigned char*>(pcm), sample_count, samples);
+			break;
+		case 16:
+			Convert16BitToFloat(pcm, sample_count, samples);
+			break;
+		case 24:
+			Convert24BitToFloat(reinterpret_cast<const unsigned char*>(pcm), sample_count, samples);
+			break;
+		case 32:
+			Convert32BitToFloat(pcm, sample_count, samples);
+			break;
+		default:
+			throw utility::InvalidArgumentException("avl::sound::ConvertPCMToFloat()", "bit_depth", "Must be 8, 16, 24, or 32.");
+		}
+	}
+
+
+
+	// See function declaration for details.
+	void ConvertFloatToPCM16(const float* const samples, const std::size_t sample_count, short* const pcm)
+	{
+		const __m128 minimum = _mm_set1_ps(-1.0f);
+		const __m128 maximum = _mm_set1_ps(1.0f);
+		const __m128 scale = _mm_set1_ps(PCM16_SCALE);
+		std::size_t i = 0;
+		for(; i + 8 <= sample_count; i += 8)
+		{
+			const __m128 low = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&samples[i]), minimum), maximum);
+			const __m128 high = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&samples[i + 4]), minimum), maximum);
+			// The conversion rounds to the nearest integer, and the pack saturates.
+			const __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(low, scale)), _mm_cvtps_epi32(_mm_mul_ps(high, scale)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&pcm[i]), packed);
+		}
+		// The same operations one sample at a time, so that the tail rounds the same way.
+		for(; i < sample_count; ++i)
+		{
+			const __m128 sample = _mm_min_ss(_mm_max_ss(_mm_load_ss(&samples[i]), minimum), maximum);
+			pcm[i] = static_cast<short>(_mm_cvtss_si32(_mm_mul_ss(sample, scale)));
+		}
+	}
+
+
+
+	// See function declaration for details.
+	void ConvertFloatToPCM(const float* const samples, const unsigned short bit_depth, const std::size_t sample_count, char* const pcm)
+	{
+		ASSERT(samples != nullptr || sample_count == 0);
+		ASSERT(pcm != nullptr || sample_count == 0);
+		switch(bit_depth)
+		{
+		case 8:
+			ConvertFloatTo8Bit(samples, sample_count, reinterpret_cast<unsigned char*>(pcm));
+			break;
+		case 16:
+			// Written a sample at a time through memcpy(), since pcm needn't be aligned.
+			{
+				const std::size_t BATCH = 256;
+				short batch[BATCH];
+				for(std::size_t i = 0; i < sample_count; i += BATCH)
+				{
+					const std::size_t count = (sample_count - i < BATCH) ? sample_count - i : BATCH;
+					ConvertFloatToPCM16(&samples[i], count, batch);
+					memcpy(&pcm[i * 2], batch, count * 2);
+				}
+			}
+			break;
+		case 24:
+			ConvertFloatTo24Bit(samples, sample_count, reinterpret_cast<unsigned char*>(pcm));
+			break;
+		case 32:
+			ConvertFloatTo32Bit(samples, sample_count, pcm);
+			break;
+		default:
+			throw utility::InvalidArgumentException("avl::sound::ConvertFloatToPCM()", "bit_depth", "Must be 8, 16, 24, or 32.");
+		}
+	}
+
+
+
+	// See function declaration for details.
+	void MixSamples(const float* const source, const float volume, const std::size_t sample_count, float* const destination)
+	{
+		const __m128 scale = _mm_set1_ps(volume);
+		std::size_t i = 0;
+		for(; i + 8 <= sample_count; i += 8)
+		{
+			const __m128 low = _mm_add_ps(_mm_loadu_ps(&destination[i]), _mm_mul_ps(_mm_loadu_ps(&source[i]), scale));
+			const __m128 high = _mm_add_ps(_mm_loadu_ps(&destination[i + 4]), _mm_mul_ps(_mm_loadu_ps(&source[i + 4]), scale));
+			_mm_storeu_ps(&destination[i], low);
+			_mm_storeu_ps(&destination[i + 4], high);
+		}
+		for(; i < sample_count; ++i)
+		{
+			destination[i] += source[i] * volume;
+		}
+	}
+
+
+
+	// See function declaration for details.
+	void MixMonoSamples(const float* const source, const float volume, const std::size_t frame_count, const unsigned short channel_count, float* const destination)
+	{
+		if(channel_count == 1)
+		{
+			MixSamples(source, volume, frame_count, destination);
+			return;
+		}
+		std::size_t i = 0;
+		if(channel_count == 2)
+		{
+			// Duplicate each sample into both channels of its frame.
+			const __m128 scale = _mm_set1_ps(volume);
+			for(; i + 4 <= frame_count; i += 4)
+			{
+				const __m128 scaled = _mm_mul_ps(_mm_loadu_ps(&source[i]), scale);
+				_mm_storeu_ps(&destination[i * 2], _mm_add_ps(_mm_loadu_ps(&destination[i * 2]), _mm_unpacklo_ps(scaled, scaled)));
+				_mm_storeu_ps(&destination[i * 2 + 4], _mm_add_ps(_mm_loadu_ps(&destination[i * 2 + 4]), _mm_unpackhi_ps(scaled, scaled)));
+			}
+		}
+		for(; i < frame_count; ++i)
+		{
+			const float scaled = source[i] * volume;
+			for(unsigned short channel = 0; channel < channel_count; ++channel)
+			{
+				destination[i * channel_count + channel] += scaled;
+			}
+		}
+	}
+
+
+
+	// See function declaration for details.
+	void MixPannedSamples(const float* const source, const unsigned short source_channels, const float left_volume, const float right_volume, const std::size_t frame_count,
+		float* const destination)
+	{
+		ASSERT(source_channels == 1 || source_channels == 2);
+		// Each pair of lanes holds a frame, left then right.
+		const __m128 scale = _mm_setr_ps(left_volume, right_volume, left_volume, right_volume);
+		std::size_t i = 0;
+		if(source_channels == 1)
+		{
+			for(; i + 4 <= frame_count; i += 4)
+			{
+				const __m128 samples = _mm_loadu_ps(&source[i]);
+				const __m128 low = _mm_mul_ps(_mm_unpacklo_ps(samples, samples), scale);
+				const __m128 high = _mm_mul_ps(_mm_unpackhi_ps(samples, samples), scale);
+				_mm_storeu_ps(&destination[i * 2], _mm_add_ps(_mm_loadu_ps(&destination[i * 2]), low));
+				_mm_storeu_ps(&destination[i * 2 + 4], _mm_add_ps(_mm_loadu_ps(&destination[i * 2 + 4]), high));
+			}
+			for(; i < frame_count; ++i)
+			{
+				destination[i * 2] += source[i] * left_volume;
+				destination[i * 2 + 1] += source[i] * right_volume;
+			}
+		}
+		else
+		{
+			for(; i + 4 <= frame_count; i += 4)
+			{
+				const __m128 low = _mm_mul_ps(_mm_loadu_ps(&source[i * 2]), scale);
+				const __m128 high = _mm_mul_ps(_mm_loadu_ps(&source[i * 2 + 4]), scale);
+				_mm_storeu_ps(&destination[i * 2], _mm_add_ps(_mm_loadu_ps(&destination[i * 2]), low));
+				_mm_storeu_ps(&destination[i * 2 + 4], _mm_add_ps(_mm_loadu_ps(&destination[i * 2 + 4]), high));
+			}
+			for(; i < frame_count; ++i)
+			{
+				destination[i * 2] += source[i * 2] * left_volume;
+				destination[i * 2 + 1] += source[i * 2 + 1] * right_volume;
+			}
+		}
+	}
+
+
+
+	// Anonymous namespace.
+	namespace
+	{
+		/** Converts 8-bit PCM samples to floats, 16 at a time.
+		@param pcm The PCM samples.
+		@param sample_count The number of samples.
+		@param samples [OUT] Receives the float samples.
+		*/
+		void Convert8BitToFloat(const unsigned char* const pcm, const std::size_t sample_count, float* const samples)
+		{
+			const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+			const __m128 scale = _mm_set1_ps(SCALE_8);
+			std::size_t i = 0;
+			for(; i + 16 <= sample_count; i += 16)
+			{
+				// Flipping the top bit centers the samples on 0. Unpacking each byte into the top of a
+				// word, then each word into the top of a doubleword, and shifting back sign-extends it.
+				const __m128i centered = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&pcm[i])), bias);
+				const __m128i low_words = _mm_unpacklo_epi8(centered, centered);
+				const __m128i high_words = _mm_unpackhi_epi8(centered, centered);
+				const __m128i words[2] = {low_words, high_words};
+				for(unsigned int half = 0; half < 2; ++half)
+				{
+					const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(words[half], words[half]), 24);
+					const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(words[half], words[half]), 24);
+					_mm_storeu_ps(&samples[i + half * 8], _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+					_mm_storeu_ps(&samples[i + half * 8 + 4], _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+				}
+			}
+			for(; i < sample_count; ++i)
+			{
+				samples[i] = static_cast<float>(static_cast<int>(pcm[i]) - 128) * SCALE_8;
+			}
+		}
+
+
+
+		/** Converts 16-bit PCM samples to floats, 8 at a time.
+		@param pcm The PCM samples.
+		@param sample_count The number of samples.
+		@param samples [OUT] Receives the float samples.
+		*/
+		void Convert16BitToFloat(const char* const pcm, const std::size_t sample_count, float* const samples)
+		{
+			const __m128 scale = _mm_set1_ps(SCALE_16);
+			std::size_t i = 0;
+			for(; i + 8 <= sample_count; i += 8)
+			{
+				const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pcm[i * 2]));
+				const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(words, words), 16);
+				const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(words, words), 16);
+				_mm_storeu_ps(&samples[i], _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+				_mm_storeu_ps(&samples[i + 4], _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+			}
+			for(; i < sample_count; ++i)
+			{
+				short sample = 0;
+				memcpy(&sample, &pcm[i * 2], 2);
+				samples[i] = static_cast<float>(sample) * SCALE_16;
+			}
+		}
+
+
+
+		/** Converts 24-bit PCM samples to floats. Three-byte samples don't line up with SSE2's
+		lanes, so this goes one sample at a time.
+		@param pcm The PCM samples.
+		@param sample_count The number of samples.
+		@param samples [OUT] Receives the float samples.
+		*/
+		void Convert24BitToFloat(const unsigned char* const pcm, const std::size_t sample_count, float* const samples)
+		{
+			for(std::size_t i = 0; i < sample_count; ++i)
+			{
+				// Assemble the sample in the top of an int, then shift it back down to sign-extend it.
+				const int sample = static_cast<int>((static_cast<unsigned int>(pcm[i * 3]) << 8) | (static_cast<unsigned int>(pcm[i * 3 + 1]) << 16)
+					| (static_cast<unsigned int>(pcm[i * 3 + 2]) << 24)) >> 8;
+				samples[i] = static_cast<float>(sample) * SCALE_24;
+			}
+		}
+
+
+
+		/** Converts 32-bit PCM samples to floats, 4 at a time.
+		@param pcm The PCM samples.
+		@param sample_count The number of samples.
+		@param samples [OUT] Receives the float samples.
+		*/
+		void Convert32BitToFloat(const char* const pcm, const std::size_t sample_count, float* const samples)
+		{
+			const __m128 scale = _mm_set1_ps(SCALE_32);
+			std::size_t i = 0;
+			for(; i + 4 <= sample_count; i += 4)
+			{
+				const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&pcm[i * 4]));
+				_mm_storeu_ps(&samples[i], _mm_mul_ps(_mm_cvtepi32_ps(values), scale));
+			}
+			for(; i < sample_count; ++i)
+			{
+				int sample = 0;
+				memcpy(&sample, &pcm[i * 4], 4);
+				samples[i] = static_cast<float>(sample) * SCALE_32;
+			}
+		}
+
+
+
+		/** Converts float samples to 8-bit PCM, 8 at a time.
+		@param samples The float samples.
+		@param sample_count The number of samples.
+		@param pcm [OUT] Receives the PCM samples.
+		*/
+		void ConvertFloatTo8Bit(const float* const samples, const std::size_t sample_count, unsigned char* const pcm)
+		{
+			const __m128 minimum = _mm_set1_ps(-1.0f);
+			const __m128 maximum = _mm_set1_ps(1.0f);
+			const __m128 scale = _mm_set1_ps(PCM8_SCALE);
+			const __m128i bias = _mm_set1_epi16(128);
+			std::size_t i = 0;
+			for(; i + 8 <= sample_count; i += 8)
+			{
+				const __m128 low = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&samples[i]), minimum), maximum);
+				const __m128 high = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(&samples[i + 4]), minimum), maximum);
+				// Round to words, center them on 128, then pack them down to bytes.
+				const __m128i words = _mm_add_epi16(_mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(low, scale)), _mm_cvtps_epi32(_mm_mul_ps(high, scale))), bias);
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(&pcm[i]), _mm_packus_epi16(words, words));
+			}
+			for(; i < sample_count; ++i)
+			{
+				const __m128 sample = _mm_min_ss(_mm_max_ss(_mm_load_ss(&samples[i]), minimum), maximum);
+				pcm[i] = static_cast<unsigned char>(_mm_cvtss_si32(_mm_mul_ss(sample, scale)) + 128);
+			}
+		}
+
+
+
+		/** Converts float samples to 24-bit PCM. Three-byte samples don't line up with SSE2's
+		lanes, so this goes one sample at a time.
+		@param samples The float samples.
+		@param sample_count The number of samples.
+		@param pcm [OUT] Receives the PCM samples.
+		*/
+		void ConvertFloatTo24Bit(const float* const samples, const std::size_t sample_count, unsigned char* const pcm)
+		{
+			const __m128 minimum = _mm_set1_ps(-1.0f);
+			const __m128 maximum = _mm_set1_ps(1.0f);
+			const __m128 scale = _mm_set1_ps(PCM24_SCALE);
+			for(std::size_t i = 0; i < sample_count; ++i)
+			{
+				const __m128 sample = _mm_min_ss(_mm_max_ss(_mm_load_ss(&samples[i]), minimum), maximum);
+				const unsigned int value = static_cast<unsigned int>(_mm_cvtss_si32(_mm_mul_ss(sample, scale)));
+				pcm[i * 3] = static_cast<unsigned char>(value);
+				pcm[i * 3 + 1] = static_cast<unsigned char>(value >> 8);
+				pcm[i * 3 + 2] = static_cast<unsigned char>(value >> 16);
+			}
+		}
+
+
+
+		/** Converts float samples to 32-bit PCM. The samples are scaled as doubles, since a
+		float can't hold every 32-bit value.
+		@param samples The float samples.
+		@param sample_count The number of samples.
+		@param pcm [OUT] Receives the PCM samples.
+		*/
+		void ConvertFloatTo32Bit(const float* const samples, const std::size_t sample_count, char* const pcm)
+		{
+			const __m128d minimum = _mm_set1_pd(-1.0);
+			const __m128d maximum = _mm_set1_pd(1.0);
+			const __m128d scale = _mm_set1_pd(PCM32_SCALE);
+			for(std::size_t i = 0; i < sample_count; ++i)
+			{
+				const __m128d sample = _mm_min_sd(_mm_max_sd(_mm_cvtss_sd(minimum, _mm_load_ss(&samples[i])), minimum), maximum);
+				const int value = _mm_cvtsd_si32(_mm_mul_sd(sample, scale));
+				memcpy(&pcm[i * 4], &value, 4);
+			}
+		}
+	}
+
+
+
+} // sound
+} // avl
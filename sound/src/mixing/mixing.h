@@ -0,0 +1,100 @@
+#pragma once
+#ifndef AVL_SOUND_MIXING__
+#define AVL_SOUND_MIXING__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Converts PCM audio data to and from floats, and mixes float samples together.
+@par Format:
+Float samples range from -1.0 to 1.0. Multi-channel audio is interleaved, one frame
+at a time, the same as in a WAV file. 8-bit PCM samples are unsigned, with silence at
+128; the other depths are signed and little-endian. Each function uses SSE2 where it can,
+and gives the same results as it would without.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include<cstddef>
+
+
+namespace avl
+{
+namespace sound
+{
+	/** Converts PCM samples to floats.
+	@param pcm The PCM samples. Needn't be aligned.
+	@param bit_depth The bit depth of the samples: 8, 16, 24, or 32.
+	@param sample_count The number of samples, counting each channel of each frame.
+	@param samples [OUT] Receives the float samples.
+	@throws InvalidArgumentException If \a bit_depth isn't supported.
+	*/
+	void ConvertPCMToFloat(const char* const pcm, const unsigned short bit_depth, const std::size_t sample_count, float* const samples);
+
+	/** Converts float samples to 16-bit PCM. Samples outside of -1.0 to 1.0 saturate rather
+	than wrap around.
+	@param samples The float samples.
+	@param sample_count The number of samples.
+	@param pcm [OUT] Receives the PCM samples.
+	*/
+	void ConvertFloatToPCM16(const float* const samples, const std::size_t sample_count, short* const pcm);
+
+	/** Converts float samples to PCM of any supported bit depth. Samples outside of -1.0 to
+	1.0 saturate rather than wrap around, and 1.0 maps to the largest positive value.
+	@param samples The float samples.
+	@param bit_depth The bit depth to convert to: 8, 16, 24, or 32.
+	@param sample_count The number of samples.
+	@param pcm [OUT] Receives the PCM samples. Needn't be aligned.
+	@throws InvalidArgumentException If \a bit_depth isn't supported.
+	*/
+	void ConvertFloatToPCM(const float* const samples, const unsigned short bit_depth, const std::size_t sample_count, char* const pcm);
+
+	/** Adds samples to a mix, scaled by a volume.
+	@param source The samples to add.
+	@param volume The volume to scale \a source by.
+	@param sample_count The number of samples.
+	@param destination [IN/OUT] The mix to add to.
+	*/
+	void MixSamples(const float* const source, const float volume, const std::size_t sample_count, float* const destination);
+
+	/** Adds mono samples to each channel of a multi-channel mix, scaled by a volume.
+	@param source The mono samples to add.
+	@param volume The volume to scale \a source by.
+	@param frame_count The number of samples in \a source, and of frames in \a destination.
+	@param channel_count The number of channels in \a destination.
+	@param destination [IN/OUT] The mix to add to.
+	*/
+	void MixMonoSamples(const float* const source, const float volume, const std::size_t frame_count, const unsigned short channel_count, float* const destination);
+
+	/** Adds mono or stereo samples to a stereo mix, scaled by a volume for each side. A mono
+	sample is added to both sides; a stereo sample's left and right channels are added to
+	the left and right sides.
+	@param source The samples to add.
+	@param source_channels The number of channels in \a source: 1 or 2.
+	@param left_volume The volume to scale \a source by on the left.
+	@param right_volume The volume to scale \a source by on the right.
+	@param frame_count The number of frames in \a source and in \a destination.
+	@param destination [IN/OUT] The stereo mix to add to.
+	*/
+	void MixPannedSamples(const float* const source, const unsigned short source_channels, const float left_volume, const float right_volume, const std::size_t frame_count,
+		float* const destination);
+
+
+
+} // sound
+} // avl
+#endif // AVL_SOUND_MIXING__
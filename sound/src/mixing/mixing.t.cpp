@@ -0,0 +1,225 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the mixing component. See "mixing.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"mixing.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include"..\..\..\utility\src\timer\timer.h"
+#include<iostream>
+#include<vector>
+#include<cmath>
+#include<cstdlib>
+
+
+
+// Anonymous namespace.
+namespace
+{
+	const float ReferenceSample(const unsigned char* const pcm, const unsigned short bit_depth, const std::size_t index);
+}
+
+
+
+void TestMixingComponent()
+{
+	using namespace avl::sound;
+	using avl::utility::Timer;
+
+	std::vector<unsigned char> pcm(4 * 1000 + 16);
+	for(std::size_t i = 0; i < pcm.size(); ++i)
+	{
+		pcm[i] = static_cast<unsigned char>(rand());
+	}
+	// The extremes of each depth.
+	pcm[0] = 0x00;
+	pcm[1] = 0x80;
+	pcm[2] = 0xFF;
+	pcm[3] = 0x7F;
+
+	// Each depth converts exactly as it would one sample at a time, at every alignment and for
+	// counts which leave a tail.
+	const unsigned short depths[] = {8, 16, 24, 32};
+	const std::size_t counts[] = {0, 1, 3, 4, 7, 8, 15, 16, 17, 33, 999};
+	std::vector<float> samples(1000);
+	for(unsigned int depth = 0; depth < 4; ++depth)
+	{
+		for(unsigned int count = 0; count < sizeof(counts) / sizeof(counts[0]); ++count)
+		{
+			for(std::size_t offset = 0; offset < 4; ++offset)
+			{
+				ConvertPCMToFloat(reinterpret_cast<const char*>(&pcm[offset]), depths[depth], counts[count], &samples[0]);
+				for(std::size_t i = 0; i < counts[count]; ++i)
+				{
+					ASSERT(samples[i] == ReferenceSample(&pcm[offset], depths[depth], i));
+					ASSERT(samples[i] >= -1.0f && samples[i] < 1.0f);
+				}
+			}
+		}
+	}
+	std::cout << "PCM converts to floats exactly.\n";
+
+	// Converting back saturates, and rounds to the nearest value.
+	{
+		const float values[] = {0.0f, 0.5f, -0.5f, 1.0f, -1.0f, 1.5f, -7.0f, 1e9f, 0.25f / 32767.0f, 0.75f / 32767.0f, -0.75f / 32767.0f, 0.999f};
+		const short expected[] = {0, 16384, -16384, 32767, -32767, 32767, -32767, 32767, 0, 1, -1, 32734};
+		const std::size_t value_count = sizeof(values) / sizeof(values[0]);
+		// Repeat the values so that both the SSE2 loop and the tail see each one.
+		std::vector<float> input;
+		for(unsigned int i = 0; i < 3; ++i)
+		{
+			input.insert(input.end(), values, values + value_count);
+		}
+		std::vector<short> output(input.size());
+		ConvertFloatToPCM16(&input[0], input.size(), &output[0]);
+		for(std::size_t i = 0; i < input.size(); ++i)
+		{
+			ASSERT(output[i] == expected[i % value_count]);
+		}
+		std::cout << "Floats convert to 16-bit PCM with saturation.\n";
+	}
+
+	// Every depth converts back to the PCM which it was converted from, and saturates.
+	for(unsigned int depth = 0; depth < 4; ++depth)
+	{
+		const std::size_t bytes = depths[depth] / 8;
+		const std::size_t count = 999;
+		ConvertPCMToFloat(reinterpret_cast<const char*>(&pcm[0]), depths[depth], count, &samples[0]);
+		std::vector<char> output(count * bytes + 1);
+		// Offset by a byte, since the output needn't be aligned.
+		ConvertFloatToPCM(&samples[0], depths[depth], count, &output[1]);
+		for(std::size_t i = 0; i < count; ++i)
+		{
+			const float converted = ReferenceSample(reinterpret_cast<const unsigned char*>(&output[1]), depths[depth], i);
+			// Converting to floats divides by 2^(depth - 1), but converting back multiplies by
+			// 2^(depth - 1) - 1, so that 1.0 doesn't saturate, and rounds. 32-bit samples are also
+			// limited by the precision of a float.
+			const float step = std::ldexp(1.0f, 1 - depths[depth]);
+			ASSERT(std::abs(converted - samples[i]) <= (0.5f + std::abs(samples[i])) * step + std::abs(samples[i]) * 1.2e-7f);
+		}
+		const float extremes[] = {8.0f, -8.0f};
+		ConvertFloatToPCM(extremes, depths[depth], 2, &output[0]);
+		ASSERT(ReferenceSample(reinterpret_cast<const unsigned char*>(&output[0]), depths[depth], 0) > 0.99f);
+		ASSERT(ReferenceSample(reinterpret_cast<const unsigned char*>(&output[0]), depths[depth], 1) < -0.99f);
+	}
+	std::cout << "Floats convert to PCM of every depth.\n";
+
+	// Mixing adds scaled samples, into every channel for mono.
+	{
+		std::vector<float> source(37);
+		std::vector<float> mix(37 * 2, 0.25f);
+		for(std::size_t i = 0; i < source.size(); ++i)
+		{
+			source[i] = static_cast<float>(i) / 64.0f;
+		}
+		MixSamples(&source[0], 0.5f, source.size(), &mix[0]);
+		for(std::size_t i = 0; i < source.size(); ++i)
+		{
+			ASSERT(mix[i] == 0.25f + source[i] * 0.5f);
+			ASSERT(mix[source.size() + i] == 0.25f);
+		}
+		for(unsigned short channels = 1; channels <= 3; ++channels)
+		{
+			std::vector<float> frames(source.size() * channels, 0.0f);
+			MixMonoSamples(&source[0], 2.0f, source.size(), channels, &frames[0]);
+			for(std::size_t i = 0; i < frames.size(); ++i)
+			{
+				ASSERT(frames[i] == source[i / channels] * 2.0f);
+			}
+		}
+		// Panned samples are scaled separately on each side.
+		for(unsigned short channels = 1; channels <= 2; ++channels)
+		{
+			std::vector<float> frames(source.size() / channels * 2, 0.25f);
+			MixPannedSamples(&source[0], channels, 0.5f, 2.0f, source.size() / channels, &frames[0]);
+			for(std::size_t i = 0; i < frames.size(); ++i)
+			{
+				const float sample = (channels == 1) ? source[i / 2] : source[i];
+				ASSERT(frames[i] == 0.25f + sample * ((i % 2 == 0) ? 0.5f : 2.0f));
+			}
+		}
+		std::cout << "Mixing is correct.\n";
+	}
+
+	// Throughput, on a second of 48 kHz stereo.
+	{
+		const std::size_t sample_count = 48000 * 2;
+		std::vector<char> pcm16(sample_count * 2);
+		for(std::size_t i = 0; i < pcm16.size(); ++i)
+		{
+			pcm16[i] = static_cast<char>(rand());
+		}
+		std::vector<float> converted(sample_count);
+		std::vector<float> mix(sample_count, 0.0f);
+		std::vector<short> output(sample_count);
+		const unsigned int repetitions = 100;
+		double times[3] = {0.0, 0.0, 0.0};
+		for(unsigned int i = 0; i < repetitions; ++i)
+		{
+			Timer timer;
+			ConvertPCMToFloat(&pcm16[0], 16, sample_count, &converted[0]);
+			times[0] += timer.Reset();
+			MixSamples(&converted[0], 0.5f, sample_count, &mix[0]);
+			times[1] += timer.Reset();
+			ConvertFloatToPCM16(&mix[0], sample_count, &output[0]);
+			times[2] += timer.Elapsed();
+		}
+		std::cout << "Microseconds per second of 48 kHz stereo:\n"
+			<< "  16-bit to float " << times[0] * 1000000.0 / repetitions << "\n"
+			<< "  mix             " << times[1] * 1000000.0 / repetitions << "\n"
+			<< "  float to 16-bit " << times[2] * 1000000.0 / repetitions << "\n";
+	}
+
+	system("pause");
+}
+
+
+
+// Anonymous namespace.
+namespace
+{
+	/** Converts a single PCM sample to a float the plain way, for comparison.
+	@param pcm The PCM samples.
+	@param bit_depth The bit depth of the samples.
+	@param index The index of the sample to convert.
+	@return The sample.
+	*/
+	const float ReferenceSample(const unsigned char* const pcm, const unsigned short bit_depth, const std::size_t index)
+	{
+		const std::size_t bytes = bit_depth / 8;
+		const unsigned char* const sample = &pcm[index * bytes];
+		if(bit_depth == 8)
+		{
+			return static_cast<float>(static_cast<int>(sample[0]) - 128) / 128.0f;
+		}
+		long long value = 0;
+		for(std::size_t byte = 0; byte < bytes; ++byte)
+		{
+			value |= static_cast<long long>(sample[byte]) << (byte * 8);
+		}
+		// Sign-extend the top byte.
+		if((sample[bytes - 1] & 0x80) != 0)
+		{
+			value -= 1LL << (bytes * 8);
+		}
+		return static_cast<float>(static_cast<double>(value) / std::pow(2.0, static_cast<double>(bit_depth - 1)));
+	}
+}
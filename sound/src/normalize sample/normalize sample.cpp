@@ -0,0 +1,378 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the normalize sample component. See "normalize sample.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"normalize sample.h"
+#include"..\adpcm\adpcm.h"
+#include"..\mixing\mixing.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include<vector>
+#include<cmath>
+#include<cstddef>
+#include<new>
+#include<xmmintrin.h>
+
+
+namespace avl
+{
+namespace sound
+{
+	// See method definitions for details.
+	namespace
+	{
+		/// The stopband attenuation of the resampling filter, in decibels.
+		const double STOPBAND_ATTENUATION = 80.0;
+		/// The fraction of the lower Nyquist frequency which the filter passes untouched.
+		const double PASSBAND = 0.9;
+		/// The most filter phases which are tabulated; phases between them are interpolated.
+		const unsigned int MAX_PHASES = 1024;
+		/// Pi.
+		const double PI = 3.14159265358979323846;
+
+		/**
+		A polyphase resampling filter, for a ratio of sampling rates reduced to lowest terms.
+		*/
+		struct Filter
+		{
+			/// The reduced input rate: each output frame advances the input by this much over \ref output_step.
+			unsigned int input_step;
+			/// The reduced output rate.
+			unsigned int output_step;
+			/// The number of taps in each phase; a multiple of 4.
+			unsigned int tap_count;
+			/// The number of phases, not counting the extra phase at the end, which lies a whole input frame on.
+			unsigned int phase_count;
+			/// The coefficients of each phase, one after another.
+			std::vector<float> coefficients;
+		};
+
+		void DesignFilter(const unsigned int input_rate, const unsigned int output_rate, Filter& filter);
+		void ResampleChannel(const Filter& filter, const float* const input, const std::size_t output_count, const unsigned short channel_count, float* const output);
+		void RemapChannels(const float* const frames, const std::size_t frame_count, const unsigned short source_channels,
+			const unsigned short output_channels, const unsigned short channel, const std::size_t padding, std::vector<float>& row);
+		const float DotProduct(const float* const input, const float* const coefficients, const unsigned int count);
+		const double BesselI0(const double x);
+		const unsigned int GreatestCommonDivisor(unsigned int a, unsigned int b);
+	}
+
+
+
+	// See function declaration for details.
+	SoundSample NormalizeSoundSample(const SoundSample& sample, const SampleFormat& format)
+	{
+		if(sample.GetAudioData() == nullptr && sample.GetDataSize() > 0)
+		{
+			throw utility::InvalidArgumentException("avl::sound::NormalizeSoundSample()", "sample", "Must contain a non-null audio data pointer.");
+		}
+		if(sample.GetEncoding() != SoundSample::PCM)
+		{
+			return NormalizeSoundSample(DecodeADPCMSample(sample), format);
+		}
+		if(sample.GetBitDepth() != 8 && sample.GetBitDepth() != 16 && sample.GetBitDepth() != 24 && sample.GetBitDepth() != 32)
+		{
+			throw utility::InvalidArgumentException("avl::sound::NormalizeSoundSample()", "sample", "Must have a bit depth of 8, 16, 24, or 32.");
+		}
+		if(sample.GetNumberOfChannels() == 0 || sample.GetFrequency() == 0)
+		{
+			throw utility::InvalidArgumentException("avl::sound::NormalizeSoundSample()", "sample", "Must have at least one channel and a non-zero frequency.");
+		}
+		if(format.bit_depth != 8 && format.bit_depth != 16 && format.bit_depth != 24 && format.bit_depth != 32)
+		{
+			throw utility::InvalidArgumentException("avl::sound::NormalizeSoundSample()", "format", "Must have a bit depth of 8, 16, 24, or 32.");
+		}
+		if(format.channel_count == 0 || format.frequency == 0)
+		{
+			throw utility::InvalidArgumentException("avl::sound::NormalizeSoundSample()", "format", "Must have at least one channel and a non-zero frequency.");
+		}
+		// Samples which are already normalized are shared rather than copied.
+		if(sample.GetBitDepth() == format.bit_depth && sample.GetFrequency() == format.frequency && sample.GetNumberOfChannels() == format.channel_count)
+		{
+			return sample;
+		}
+
+		const unsigned short source_channels = sample.GetNumberOfChannels();
+		const std::size_t frame_count = sample.GetDataSize() / (source_channels * (sample.GetBitDepth() / 8));
+		const bool is_resampling = (sample.GetFrequency() != format.frequency);
+		char* audio_data = nullptr;
+		std::size_t data_size = 0;
+		try
+		{
+			// Convert the whole frames to floats.
+			std::vector<float> frames(frame_count * source_channels);
+			ConvertPCMToFloat(sample.GetAudioData(), sample.GetBitDepth(), frames.size(), frames.empty() ? nullptr : &frames[0]);
+
+			Filter filter;
+			std::size_t output_count = frame_count;
+			std::size_t padding = 0;
+			if(is_resampling == true)
+			{
+				DesignFilter(sample.GetFrequency(), format.frequency, filter);
+				// Enough frames to cover the length of the sample at the new rate.
+				output_count = static_cast<std::size_t>((static_cast<unsigned long long>(frame_count) * filter.output_step + filter.input_step - 1) / filter.input_step);
+				// The filter reaches this far before the first frame; silence is read there, and past the last frame.
+				padding = filter.tap_count / 2 - 1;
+			}
+
+			// Each output channel is filtered on its own, out of a row of silence-padded samples.
+			std::vector<float> output(output_count * format.channel_count);
+			std::vector<float> row;
+			for(unsigned short channel = 0; channel < format.channel_count; ++channel)
+			{
+				RemapChannels(frames.empty() ? nullptr : &frames[0], frame_count, source_channels, format.channel_count, channel, padding, row);
+				if(is_resampling == true)
+				{
+					row.resize(frame_count + filter.tap_count, 0.0f);
+					ResampleChannel(filter, &row[0], output_count, format.channel_count, output.empty() ? nullptr : &output[channel]);
+				}
+				else
+				{
+					for(std::size_t i = 0; i < output_count; ++i)
+					{
+						output[i * format.channel_count + channel] = row[i];
+					}
+				}
+			}
+
+			data_size = output.size() * (format.bit_depth / 8);
+			audio_data = new(std::nothrow) char[data_size];
+			if(audio_data == nullptr)
+			{
+				throw utility::OutOfMemoryError();
+			}
+			ConvertFloatToPCM(output.empty() ? nullptr : &output[0], format.bit_depth, output.size(), audio_data);
+		}
+		catch(const std::bad_alloc&)
+		{
+			delete[] audio_data;
+			throw utility::OutOfMemoryError();
+		}
+		return SoundSample(format.bit_depth, format.frequency, format.channel_count, data_size, audio_data);
+	}
+
+
+
+	// Anonymous namespace.
+	namespace
+	{
+		/** Designs a Kaiser-windowed sinc filter for resampling from one rate to another.
+		@param input_rate The rate to resample from.
+		@param output_rate The rate to resample to.
+		@param filter [OUT] Receives the filter.
+		*/
+		void DesignFilter(const unsigned int input_rate, const unsigned int output_rate, Filter& filter)
+		{
+			const unsigned int divisor = GreatestCommonDivisor(input_rate, output_rate);
+			filter.input_step = input_rate / divisor;
+			filter.output_step = output_rate / divisor;
+			// Every phase which the reduced ratio can land on, if there aren't too many.
+			filter.phase_count = (filter.output_step <= MAX_PHASES) ? filter.output_step : MAX_PHASES;
+
+			// Frequencies are in cycles per input frame. When downsampling, the filter has to
+			// stop what the output can't represent, so its band narrows and it grows longer.
+			const double ratio = (output_rate < input_rate) ? static_cast<double>(output_rate) / input_rate : 1.0;
+			const double transition = (1.0 - PASSBAND) * 0.5 * ratio;
+			const double cutoff = (PASSBAND * 0.5 * ratio + 0.5 * ratio) / 2.0;
+			// The length and shape of a Kaiser window which meets the attenuation over the
+			// transition band; see Kaiser's formulas.
+			const double beta = 0.1102 * (STOPBAND_ATTENUATION - 8.7);
+			const double length = (STOPBAND_ATTENUATION - 8.0) / (2.285 * 2.0 * PI * transition) + 1.0;
+			filter.tap_count = (static_cast<unsigned int>(std::ceil(length)) + 3) & ~3U;
+			const double half_width = filter.tap_count / 2.0;
+			const double window_scale = 1.0 / BesselI0(beta);
+
+			filter.coefficients.resize((filter.phase_count + 1) * filter.tap_count);
+			for(unsigned int phase = 0; phase <= filter.phase_count; ++phase)
+			{
+				// The output frame lies this far past the input frame at the center of the taps.
+				const double fraction = static_cast<double>(phase) / filter.phase_count;
+				float* const coefficients = &filter.coefficients[phase * filter.tap_count];
+				double sum = 0.0;
+				for(unsigned int tap = 0; tap < filter.tap_count; ++tap)
+				{
+					const double x = static_cast<double>(tap) - (half_width - 1.0) - fraction;
+					const double sinc = (x == 0.0) ? 1.0 : std::sin(2.0 * PI * cutoff * x) / (2.0 * PI * cutoff * x);
+					const double position = x / half_width;
+					const double window = (position <= -1.0 || position >= 1.0) ? 0.0 : BesselI0(beta * std::sqrt(1.0 - position * position)) * window_scale;
+					coefficients[tap] = static_cast<float>(sinc * window);
+					sum += coefficients[tap];
+				}
+				// Unity gain at DC, for every phase.
+				for(unsigned int tap = 0; tap < filter.tap_count; ++tap)
+				{
+					coefficients[tap] = static_cast<float>(coefficients[tap] / sum);
+				}
+			}
+		}
+
+
+
+		/** Resamples one channel.
+		@param filter The resampling filter.
+		@param input The channel's input samples, preceded by filter.tap_count / 2 - 1 samples of
+		silence and followed by enough silence for the filter to read past the last one.
+		@param output_count The number of output frames.
+		@param channel_count The number of channels in \a output.
+		@param output [OUT] Receives the resampled channel, every \a channel_count floats.
+		*/
+		void ResampleChannel(const Filter& filter, const float* const input, const std::size_t output_count, const unsigned short channel_count, float* const output)
+		{
+			const bool is_exact = (filter.phase_count == filter.output_step);
+			// The input frame at the center of the taps, and how far past it the output frame lies,
+			// in units of 1 / output_step.
+			std::size_t frame = 0;
+			unsigned int offset = 0;
+			for(std::size_t i = 0; i < output_count; ++i)
+			{
+				const float* const taps = &input[frame];
+				if(is_exact == true)
+				{
+					output[i * channel_count] = DotProduct(taps, &filter.coefficients[offset * filter.tap_count], filter.tap_count);
+				}
+				else
+				{
+					// Interpolate between the two nearest phases.
+					const unsigned long long scaled = static_cast<unsigned long long>(offset) * filter.phase_count;
+					const unsigned int phase = static_cast<unsigned int>(scaled / filter.output_step);
+					const float weight = static_cast<float>(scaled % filter.output_step) / filter.output_step;
+					const float before = DotProduct(taps, &filter.coefficients[phase * filter.tap_count], filter.tap_count);
+					const float after = DotProduct(taps, &filter.coefficients[(phase + 1) * filter.tap_count], filter.tap_count);
+					output[i * channel_count] = before + (after - before) * weight;
+				}
+				offset += filter.input_step;
+				frame += offset / filter.output_step;
+				offset %= filter.output_step;
+			}
+		}
+
+
+
+		/** Fills a row with one output channel, mapped from the source channels.
+		@param frames The source frames.
+		@param frame_count The number of source frames.
+		@param source_channels The number of channels in each source frame.
+		@param output_channels The number of channels in each output frame.
+		@param channel The output channel.
+		@param padding The number of samples of silence to put before the channel.
+		@param row [OUT] Receives the padding and then the channel.
+		*/
+		void RemapChannels(const float* const frames, const std::size_t frame_count, const unsigned short source_channels,
+			const unsigned short output_channels, const unsigned short channel, const std::size_t padding, std::vector<float>& row)
+		{
+			row.assign(padding + frame_count, 0.0f);
+			float* const samples = &row[padding];
+			if(source_channels == 1)
+			{
+				for(std::size_t i = 0; i < frame_count; ++i)
+				{
+					samples[i] = frames[i];
+				}
+			}
+			else if(output_channels == 1)
+			{
+				const float scale = 1.0f / source_channels;
+				for(std::size_t i = 0; i < frame_count; ++i)
+				{
+					float sum = 0.0f;
+					for(unsigned short source = 0; source < source_channels; ++source)
+					{
+						sum += frames[i * source_channels + source];
+					}
+					samples[i] = sum * scale;
+				}
+			}
+			else if(channel < source_channels)
+			{
+				for(std::size_t i = 0; i < frame_count; ++i)
+				{
+					samples[i] = frames[i * source_channels + channel];
+				}
+			}
+			// Leaves the channels which the source doesn't have silent.
+		}
+
+
+
+		/** Multiplies floats pairwise and sums the products, four at a time.
+		@param input The first floats. Needn't be aligned.
+		@param coefficients The second floats. Needn't be aligned.
+		@param count The number of floats in each; a multiple of 4.
+		@return The sum of the products.
+		*/
+		const float DotProduct(const float* const input, const float* const coefficients, const unsigned int count)
+		{
+			ASSERT(count % 4 == 0);
+			__m128 sum = _mm_setzero_ps();
+			for(unsigned int i = 0; i < count; i += 4)
+			{
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(&input[i]), _mm_loadu_ps(&coefficients[i])));
+			}
+			// Add the four lanes together.
+			sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+			sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+			return _mm_cvtss_f32(sum);
+		}
+
+
+
+		/** Evaluates the zeroth-order modified Bessel function of the first kind, which shapes
+		the Kaiser window.
+		@param x The argument.
+		@return I0(\a x).
+		*/
+		const double BesselI0(const double x)
+		{
+			// Sum the power series until its terms stop mattering.
+			double sum = 1.0;
+			double term = 1.0;
+			for(unsigned int k = 1; term > sum * 1e-12; ++k)
+			{
+				const double factor = x / (2.0 * k);
+				term *= factor * factor;
+				sum += term;
+			}
+			return sum;
+		}
+
+
+
+		/** Finds the greatest common divisor of two numbers.
+		@param a The first number.
+		@param b The second number.
+		@return The greatest common divisor of \a a and \a b.
+		*/
+		const unsigned int GreatestCommonDivisor(unsigned int a, unsigned int b)
+		{
+			while(b != 0)
+			{
+				const unsigned int remainder = a % b;
+				a = b;
+				b = remainder;
+			}
+			return a;
+		}
+	}
+
+
+
+} // sound
+} // avl
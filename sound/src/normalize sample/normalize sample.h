@@ -0,0 +1,75 @@
+#pragma once
+#ifndef AVL_SOUND_NORMALIZE_SAMPLE__
+#define AVL_SOUND_NORMALIZE_SAMPLE__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Converts sound samples to a common format when they're loaded, so that a sound engine
+plays every sample in the same format: XAudio2SoundEngine reuses its source voices only
+between sounds of the same format, and SoftwareSoundEngine resamples at run time whatever
+doesn't match its output.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"..\sound sample\sound sample.h"
+
+
+namespace avl
+{
+namespace sound
+{
+	/**
+	The format which sound samples are normalized to.
+	*/
+	struct SampleFormat
+	{
+		/// The bit depth of each sample: 8, 16, 24, or 32.
+		unsigned short bit_depth;
+		/// The number of frames per second.
+		unsigned int frequency;
+		/// The number of channels in each frame.
+		unsigned short channel_count;
+	};
+
+	/** Converts a sound sample to \a format.
+	@par Resampling:
+	Uses a polyphase windowed-sinc filter (Kaiser window) whose taps are applied with SSE2.
+	Its passband is flat to 90% of the lower of the two Nyquist frequencies, and it
+	attenuates whatever would alias by at least 80 dB. The phases are exact for rates with
+	a small common divisor, such as 22050, 44100, and 48000 Hz, and interpolated otherwise.
+	@par Channels:
+	Mono is copied to every channel, and every channel is averaged down to mono. Otherwise
+	each channel is kept if \a format has room for it and dropped if not, and the channels
+	which \a format adds are silent.
+	@param sample The sample to convert. ADPCM is decoded first.
+	@param format The format to convert to.
+	@return The converted sample. Shares the audio data of \a sample if it's already in
+	\a format.
+	@throws InvalidArgumentException If \a sample has no audio data, no channels, no
+	frequency, an unsupported bit depth, or an unsupported ADPCM block layout, or if
+	\a format does.
+	@throws OutOfMemoryError If we run out of memory.
+	*/
+	SoundSample NormalizeSoundSample(const SoundSample& sample, const SampleFormat& format);
+
+
+
+} // sound
+} // avl
+#endif // AVL_SOUND_NORMALIZE_SAMPLE__
@@ -0,0 +1,251 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the normalize sample component. See "normalize sample.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"normalize sample.h"
+#include"..\sound sample\sound sample.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include"..\..\..\utility\src\timer\timer.h"
+#include<iostream>
+#include<vector>
+#include<cmath>
+#include<cstring>
+#include<cstdlib>
+
+using avl::sound::SoundSample;
+using avl::sound::SampleFormat;
+using avl::sound::NormalizeSoundSample;
+
+
+
+// Anonymous namespace.
+namespace
+{
+	const double PI = 3.14159265358979323846;
+
+	SoundSample MakeSine(const double frequency, const unsigned int rate, const std::size_t frame_count, const double amplitude);
+	const double SineError(const SoundSample& sample, const double frequency, const double amplitude, const std::size_t margin);
+	const double RootMeanSquare(const SoundSample& sample, const std::size_t margin);
+	const short GetSample(const SoundSample& sample, const std::size_t index);
+}
+
+
+
+void TestNormalizeSampleComponent()
+{
+	// Samples which are already in the format are shared.
+	{
+		const SoundSample sample = MakeSine(1000.0, 44100, 100, 0.5);
+		const SampleFormat format = {16, 44100, 1};
+		const SoundSample normalized = NormalizeSoundSample(sample, format);
+		ASSERT(normalized.GetAudioData() == sample.GetAudioData());
+		std::cout << "Normalized samples are shared.\n";
+	}
+
+	// Bit depths convert through floats, and back again exactly.
+	{
+		const SoundSample sample = MakeSine(1000.0, 44100, 1000, 0.9);
+		const unsigned short depths[] = {24, 32};
+		for(unsigned int depth = 0; depth < 2; ++depth)
+		{
+			const SampleFormat wide = {depths[depth], 44100, 1};
+			const SampleFormat narrow = {16, 44100, 1};
+			const SoundSample widened = NormalizeSoundSample(sample, wide);
+			ASSERT(widened.GetBitDepth() == depths[depth] && widened.GetDataSize() == 1000 * depths[depth] / 8);
+			const SoundSample restored = NormalizeSoundSample(widened, narrow);
+			for(std::size_t i = 0; i < 1000; ++i)
+			{
+				ASSERT(std::abs(GetSample(restored, i) - GetSample(sample, i)) <= 1);
+			}
+		}
+		const SampleFormat eight = {8, 44100, 1};
+		const SoundSample narrowed = NormalizeSoundSample(sample, eight);
+		ASSERT(narrowed.GetDataSize() == 1000);
+		for(std::size_t i = 0; i < 1000; ++i)
+		{
+			const int expected = static_cast<int>(std::floor(GetSample(sample, i) / 32768.0 * 127.0 + 0.5)) + 128;
+			ASSERT(std::abs(static_cast<unsigned char>(narrowed.GetAudioData()[i]) - expected) <= 1);
+		}
+		std::cout << "Bit depths convert.\n";
+	}
+
+	// Mono is copied to both channels, and stereo is averaged down to mono.
+	{
+		short* const data = new short[4];
+		const short values[] = {1000, -3000, 20000, 10000};
+		memcpy(data, values, sizeof(values));
+		const SoundSample stereo(16, 48000, 2, 8, reinterpret_cast<char*>(data));
+		const SampleFormat mono_format = {16, 48000, 1};
+		const SoundSample mono = NormalizeSoundSample(stereo, mono_format);
+		ASSERT(mono.GetNumberOfChannels() == 1 && mono.GetDataSize() == 4);
+		ASSERT(GetSample(mono, 0) == -1000 && GetSample(mono, 1) == 15000);
+		const SampleFormat stereo_format = {16, 48000, 2};
+		const SoundSample doubled = NormalizeSoundSample(mono, stereo_format);
+		ASSERT(doubled.GetDataSize() == 8);
+		ASSERT(GetSample(doubled, 0) == -1000 && GetSample(doubled, 1) == -1000 && GetSample(doubled, 2) == 15000 && GetSample(doubled, 3) == 15000);
+		std::cout << "Channels are remapped.\n";
+	}
+
+	// Resampling keeps the length and the content of the sound. Away from the edges, where the
+	// filter reads silence, each output frame matches the sine at its own rate to within about
+	// the noise of 16-bit PCM.
+	{
+		const unsigned int rates[][2] = {{44100, 48000}, {22050, 48000}, {48000, 44100}, {48000, 22050}, {44100, 44099}};
+		for(unsigned int i = 0; i < sizeof(rates) / sizeof(rates[0]); ++i)
+		{
+			const std::size_t frame_count = 20000;
+			const SoundSample sample = MakeSine(1000.0, rates[i][0], frame_count, 0.5);
+			const SampleFormat format = {16, rates[i][1], 1};
+			const SoundSample resampled = NormalizeSoundSample(sample, format);
+			const std::size_t expected_count = static_cast<std::size_t>(std::ceil(static_cast<double>(frame_count) * rates[i][1] / rates[i][0]));
+			ASSERT(resampled.GetFrequency() == rates[i][1] && resampled.GetDataSize() == expected_count * 2);
+			const double error = SineError(resampled, 1000.0, 0.5, 500);
+			std::cout << "  " << rates[i][0] << " Hz to " << rates[i][1] << " Hz: signal to error " << 20.0 * std::log10(0.5 / error) << " dB\n";
+			ASSERT(error < 0.5 * std::pow(10.0, -70.0 / 20.0));
+		}
+
+		// A constant stays constant.
+		std::vector<short> constant(5000, 12345);
+		short* const data = new short[constant.size()];
+		memcpy(data, &constant[0], constant.size() * 2);
+		const SampleFormat format = {16, 48000, 1};
+		const SoundSample level = NormalizeSoundSample(SoundSample(16, 22050, 1, constant.size() * 2, reinterpret_cast<char*>(data)), format);
+		for(std::size_t i = 500; i < level.GetDataSize() / 2 - 500; ++i)
+		{
+			ASSERT(std::abs(GetSample(level, i) - 12345) <= 1);
+		}
+		std::cout << "Resampling preserves the signal.\n";
+	}
+
+	// Downsampling removes what the new rate can't represent, rather than folding it back down.
+	{
+		const SoundSample sample = MakeSine(15000.0, 48000, 20000, 0.5);
+		const SampleFormat format = {16, 22050, 1};
+		const SoundSample resampled = NormalizeSoundSample(sample, format);
+		const double level = RootMeanSquare(resampled, 500);
+		std::cout << "  15 kHz at 22050 Hz: " << 20.0 * std::log10(level / (0.5 / std::sqrt(2.0))) << " dB\n";
+		ASSERT(level < (0.5 / std::sqrt(2.0)) * std::pow(10.0, -70.0 / 20.0));
+		std::cout << "Downsampling doesn't alias.\n";
+	}
+
+	// Throughput, on ten seconds of sound from each rate in our sound bank.
+	{
+		struct Case
+		{
+			const char* name;
+			unsigned short bit_depth;
+			unsigned int frequency;
+			unsigned short channel_count;
+		};
+		const Case cases[] = {{"8-bit mono 22.05 kHz", 8, 22050, 1}, {"16-bit mono 44.1 kHz", 16, 44100, 1}, {"16-bit stereo 44.1 kHz", 16, 44100, 2}, {"16-bit stereo 48 kHz", 16, 48000, 2}};
+		const SampleFormat format = {16, 48000, 2};
+		std::cout << "Milliseconds to normalize 10 seconds to 16-bit stereo 48 kHz:\n";
+		for(unsigned int i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i)
+		{
+			const std::size_t size = cases[i].frequency * 10 * cases[i].channel_count * (cases[i].bit_depth / 8);
+			char* const data = new char[size];
+			for(std::size_t byte = 0; byte < size; ++byte)
+			{
+				data[byte] = static_cast<char>(rand());
+			}
+			const SoundSample sample(cases[i].bit_depth, cases[i].frequency, cases[i].channel_count, size, data);
+			avl::utility::Timer timer;
+			const SoundSample normalized = NormalizeSoundSample(sample, format);
+			std::cout << "  " << cases[i].name << "  " << timer.Elapsed() * 1000.0 << "\n";
+			ASSERT(normalized.GetDataSize() == 48000 * 10 * 4);
+		}
+	}
+
+	system("pause");
+}
+
+
+
+// Anonymous namespace.
+namespace
+{
+	/** Makes a 16-bit mono sine wave.
+	@param frequency The frequency of the sine, in Hz.
+	@param rate The sampling rate.
+	@param frame_count The number of frames.
+	@param amplitude The amplitude, from 0.0 to 1.0.
+	@return The sample.
+	*/
+	SoundSample MakeSine(const double frequency, const unsigned int rate, const std::size_t frame_count, const double amplitude)
+	{
+		short* const data = new short[frame_count];
+		for(std::size_t i = 0; i < frame_count; ++i)
+		{
+			data[i] = static_cast<short>(std::floor(std::sin(2.0 * PI * frequency * i / rate) * amplitude * 32767.0 + 0.5));
+		}
+		return SoundSample(16, rate, 1, frame_count * 2, reinterpret_cast<char*>(data));
+	}
+
+	/** Measures how far a 16-bit mono sample strays from a sine wave.
+	@param sample The sample.
+	@param frequency The frequency of the sine, in Hz.
+	@param amplitude The amplitude of the sine.
+	@param margin The number of frames to skip at each end.
+	@return The root mean square of the difference, from 0.0 to 1.0.
+	*/
+	const double SineError(const SoundSample& sample, const double frequency, const double amplitude, const std::size_t margin)
+	{
+		const std::size_t frame_count = sample.GetDataSize() / 2;
+		double sum = 0.0;
+		for(std::size_t i = margin; i < frame_count - margin; ++i)
+		{
+			const double expected = std::sin(2.0 * PI * frequency * i / sample.GetFrequency()) * amplitude;
+			const double difference = GetSample(sample, i) / 32767.0 - expected;
+			sum += difference * difference;
+		}
+		return std::sqrt(sum / (frame_count - 2 * margin));
+	}
+
+	/** Measures the level of a 16-bit mono sample.
+	@param sample The sample.
+	@param margin The number of frames to skip at each end.
+	@return The root mean square of the samples, from 0.0 to 1.0.
+	*/
+	const double RootMeanSquare(const SoundSample& sample, const std::size_t margin)
+	{
+		const std::size_t frame_count = sample.GetDataSize() / 2;
+		double sum = 0.0;
+		for(std::size_t i = margin; i < frame_count - margin; ++i)
+		{
+			const double value = GetSample(sample, i) / 32767.0;
+			sum += value * value;
+		}
+		return std::sqrt(sum / (frame_count - 2 * margin));
+	}
+
+	/** Reads a 16-bit sample.
+	@param sample The sound sample.
+	@param index The index of the sample, counting each channel of each frame.
+	@return The sample.
+	*/
+	const short GetSample(const SoundSample& sample, const std::size_t index)
+	{
+		short value = 0;
+		memcpy(&value, &sample.GetAudioData()[index * 2], 2);
+		return value;
+	}
+}
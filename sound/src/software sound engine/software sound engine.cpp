@@ -0,0 +1,987 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the software sound engine component. See "software sound engine.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"software sound engine.h"
+#include"..\adpcm\adpcm.h"
+#include"..\mixing\mixing.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include<algorithm>
+#include<memory>
+#include<cstring>
+#include<new>
+
+
+namespace avl
+{
+namespace sound
+{
+	// See method definitions for details.
+	namespace
+	{
+		/// The most frames mixed for a voice at a time.
+		const std::size_t BLOCK_FRAMES = 512;
+		/// A position step of one frame, in 32.32 fixed point.
+		const unsigned long long ONE_FRAME = 1ULL << 32;
+	}
+
+
+
+	// See method declaration for details.
+	SoftwareSoundEngine::Sink::~Sink()
+	{
+	}
+
+
+
+	// See method declaration for details.
+	SoftwareSoundEngine::SoftwareSoundEngine(const unsigned int sample_rate, const unsigned short channel_count, const unsigned int max_voices)
+		: sample_rate(sample_rate), channel_count(channel_count), max_voice_count(max_voices), next_handle(1), underrun_count(0), started_voice_count(0)
+	{
+		const VoiceStatistics no_voices = {0, 0, 0, 0};
+		statistics = no_voices;
+		if(sample_rate == 0)
+		{
+			throw utility::InvalidArgumentException("avl::sound::SoftwareSoundEngine::SoftwareSoundEngine()", "sample_rate", "Must be greater than 0.");
+		}
+		if(channel_count == 0)
+		{
+			throw utility::InvalidArgumentException("avl::sound::SoftwareSoundEngine::SoftwareSoundEngine()", "channel_count", "Must be greater than 0.");
+		}
+		if(max_voices == 0)
+		{
+			throw utility::InvalidArgumentException("avl::sound::SoftwareSoundEngine::SoftwareSoundEngine()", "max_voices", "Must be greater than 0.");
+		}
+	}
+
+	// See method declaration for details.
+	SoftwareSoundEngine::~SoftwareSoundEngine()
+	{
+	}
+
+	// See method declaration for details.
+	const utility::SoundEffect::SoundHandle SoftwareSoundEngine::AddSound(const sound::SoundSample& new_sample)
+	{
+		// Check for valid audio data.
+		if(new_sample.GetAudioData() == nullptr)
+		{
+			throw utility::InvalidArgumentException("avl::sound::SoftwareSoundEngine::AddSound()", "new_sample", "Must contain a non-null audio data pointer.");
+		}
+		const bool is_pcm = (new_sample.GetEncoding() == SoundSample::PCM);
+		if(is_pcm == true && new_sample.GetBitDepth() != 8 && new_sample.GetBitDepth() != 16 && new_sample.GetBitDepth() != 24 && new_sample.GetBitDepth() != 32)
+		{
+			throw utility::InvalidArgumentException("avl::sound::SoftwareSoundEngine::AddSound()", "new_sample", "Must have a bit depth of 8, 16, 24, or 32.");
+		}
+		if(new_sample.GetNumberOfChannels() == 0 || new_sample.GetFrequency() == 0)
+		{
+			throw utility::InvalidArgumentException("avl::sound::SoftwareSoundEngine::AddSound()", "new_sample", "Must have at least one channel and a non-zero frequency.");
+		}
+		const std::size_t block_frames = GetADPCMBlockFrames(new_sample.GetEncoding(), new_sample.GetBlockAlignment(), new_sample.GetNumberOfChannels());
+		if(is_pcm == false && block_frames == 0)
+		{
+			throw utility::InvalidArgumentException("avl::sound::SoftwareSoundEngine::AddSound()", "new_sample", "Must have a supported ADPCM block layout.");
+		}
+		if(is_pcm == false && GetADPCMFrameCount(new_sample.GetEncoding(), new_sample.GetBlockAlignment(), new_sample.GetNumberOfChannels(), new_sample.GetDataSize()) < new_sample.GetFrameCount())
+		{
+			throw utility::InvalidArgumentException("avl::sound::SoftwareSoundEngine::AddSound()", "new_sample", "Must hold as many frames as it claims to.");
+		}
+
+		// Share the audio data rather than copying it; only its whole frames are played.
+		std::shared_ptr<Sound> sound;
+		try
+		{
+			sound.reset(new Sound());
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw utility::OutOfMemoryError();
+		}
+		sound->bit_depth = (is_pcm == true) ? new_sample.GetBitDepth() : 16;
+		sound->channel_count = new_sample.GetNumberOfChannels();
+		sound->frequency = new_sample.GetFrequency();
+		sound->frame_count = new_sample.GetFrameCount();
+		sound->data = new_sample.ShareAudioData();
+		sound->encoding = new_sample.GetEncoding();
+		sound->block_alignment = new_sample.GetBlockAlignment();
+		sound->block_frames = block_frames;
+		sound->data_size = new_sample.GetDataSize();
+		if(is_pcm == false && sound->frame_count > 0)
+		{
+			try
+			{
+				std::vector<short> first_block(block_frames * sound->channel_count);
+				DecodeADPCMBlock(sound->encoding, sound->data.get(), std::min<std::size_t>(sound->block_alignment, sound->data_size), sound->channel_count, &first_block[0]);
+				sound->first_frame.assign(first_block.begin(), first_block.begin() + sound->channel_count);
+			}
+			catch(const std::bad_alloc&)
+			{
+				throw utility::OutOfMemoryError();
+			}
+		}
+
+		const utility::SoundEffect::SoundHandle issued_handle = IssueHandle();
+		try
+		{
+			sounds.insert(std::make_pair(issued_handle, sound));
+		}
+		catch(const std::bad_alloc&)
+		{
+			// Leaks the issued sound handle until the next time ClearSounds() is called.
+			throw utility::OutOfMemoryError();
+		}
+		return issued_handle;
+	}
+
+	// See method declaration for details.
+	const bool SoftwareSoundEngine::IsPlayingADPCM() const
+	{
+		return true;
+	}
+
+	// See method declaration for details.
+	const utility::SoundEffect::SoundHandle SoftwareSoundEngine::AddStream(const std::string& file_name)
+	{
+		std::shared_ptr<SoundStream> stream;
+		try
+		{
+			stream.reset(new SoundStream(file_name));
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw utility::OutOfMemoryError();
+		}
+		if(stream->GetBitDepth() != 8 && stream->GetBitDepth() != 16 && stream->GetBitDepth() != 24 && stream->GetBitDepth() != 32)
+		{
+			throw utility::InvalidArgumentException("avl::sound::SoftwareSoundEngine::AddStream()", "file_name", "Must have a bit depth of 8, 16, 24, or 32.");
+		}
+		if(stream->GetFrequency() == 0)
+		{
+			throw utility::InvalidArgumentException("avl::sound::SoftwareSoundEngine::AddStream()", "file_name", "Must have a non-zero frequency.");
+		}
+
+		const utility::SoundEffect::SoundHandle issued_handle = IssueHandle();
+		try
+		{
+			streams.insert(std::make_pair(issued_handle, stream));
+		}
+		catch(const std::bad_alloc&)
+		{
+			// Leaks the issued sound handle until the next time ClearSounds() is called.
+			throw utility::OutOfMemoryError();
+		}
+		return issued_handle;
+	}
+
+	// See method declaration for details.
+	void SoftwareSoundEngine::DeleteSound(const utility::SoundEffect::SoundHandle& handle)
+	{
+		SoundHandleToSound::iterator element = sounds.find(handle);
+		SoundHandleToStream::iterator stream = streams.find(handle);
+		if(element != sounds.end() || stream != streams.end())
+		{
+			if(element != sounds.end())
+			{
+				sounds.erase(element);
+			}
+			else
+			{
+				streams.erase(stream);
+			}
+			// Reuse this sound handle.
+			try
+			{
+				reusable_sound_handles.push(handle);
+			}
+			catch(const std::bad_alloc&)
+			{
+				throw utility::OutOfMemoryError();
+			}
+		}
+	}
+
+	// See method declaration for details.
+	void SoftwareSoundEngine::ClearSounds()
+	{
+		voices.clear();
+		ranked_voices.clear();
+		sounds.clear();
+		streams.clear();
+		// Reset the sound handles.
+		while(reusable_sound_handles.empty() == false)
+		{
+			reusable_sound_handles.pop();
+		}
+		next_handle = 1;
+	}
+
+	// See method declaration for details.
+	void SoftwareSoundEngine::UpdateSounds(utility::SoundEffectList& sound_effects)
+	{
+		for(SoundEffectToVoice::iterator voice = voices.begin(); voice != voices.end(); ++voice)
+		{
+			voice->second.is_updated = false;
+		}
+
+		spatializer.Clear();
+		for(utility::SoundEffectList::iterator effect = sound_effects.begin(); effect != sound_effects.end(); ++effect)
+		{
+			spatializer.AddEffect(**effect);
+		}
+		spatializer.Spatialize(GetListenerPosition(), GetAttenuation());
+
+		std::size_t index = 0;
+		for(utility::SoundEffectList::iterator effect = sound_effects.begin(); effect != sound_effects.end(); ++effect, ++index)
+		{
+			const SoundHandleToSound::const_iterator sound = sounds.find((*effect)->GetSoundHandle());
+			const SoundHandleToStream::const_iterator stream = streams.find((*effect)->GetSoundHandle());
+			if(sound == sounds.end() && stream == streams.end())
+			{
+				throw utility::InvalidArgumentException("avl::sound::SoftwareSoundEngine::UpdateSounds()", "sound_effects", "One or more sound effects contain an invalid sound handle.");
+			}
+			const SoundEffectToVoice::iterator voice = voices.find(*effect);
+			if(voice != voices.end())
+			{
+				Voice& state = voice->second;
+				state.is_updated = true;
+				const bool is_changed = ((*effect)->IsReset() == true || (*effect)->GetSoundHandle() != state.handle);
+				if((*effect)->IsPlaying() == true)
+				{
+					if(is_changed == true || (state.is_finished == true && (*effect)->IsLooping() == true))
+					{
+						// Start over.
+						if(sound != sounds.end())
+						{
+							StartVoice(state, sound->second, **effect);
+						}
+						else
+						{
+							StartVoice(state, stream->second, **effect, sound_effects);
+						}
+						(*effect)->Reset(false);
+					}
+					else if(state.is_finished == true)
+					{
+						// The sound has played through.
+						voices.erase(voice);
+						(*effect)->Pause();
+						continue;
+					}
+					state.is_playing = true;
+					state.is_looping = (*effect)->IsLooping();
+					state.bus = (*effect)->GetBus();
+					state.rank.priority = (*effect)->GetPriority();
+					SpatializeVoice(state, index);
+				}
+				// At this point: effect.IsPlaying() == false
+				else
+				{
+					if(is_changed == true || state.is_finished == true)
+					{
+						// Stopped.
+						voices.erase(voice);
+						(*effect)->Reset(false);
+					}
+					else
+					{
+						// Paused.
+						state.is_playing = false;
+					}
+				}
+			}
+			// voice == voices.end()
+			else if((*effect)->IsPlaying() == true)
+			{
+				Voice new_voice;
+				if(sound != sounds.end())
+				{
+					StartVoice(new_voice, sound->second, **effect);
+				}
+				else
+				{
+					StartVoice(new_voice, stream->second, **effect, sound_effects);
+				}
+				SpatializeVoice(new_voice, index);
+				try
+				{
+					voices.insert(std::make_pair(*effect, new_voice));
+				}
+				catch(const std::bad_alloc&)
+				{
+					throw utility::OutOfMemoryError();
+				}
+				(*effect)->Reset(false);
+			}
+		}
+
+		// Forget the voices of effects which weren't updated once they're no longer heard.
+		for(SoundEffectToVoice::iterator voice = voices.begin(); voice != voices.end();)
+		{
+			if(voice->second.is_updated == false && (voice->second.is_finished == true || voice->second.is_playing == false))
+			{
+				voices.erase(voice++);
+			}
+			else
+			{
+				++voice;
+			}
+		}
+
+		CullVoices();
+	}
+
+	// See method declaration for details.
+	const VoiceStatistics SoftwareSoundEngine::GetVoiceStatistics() const
+	{
+		return statistics;
+	}
+
+	// See method declaration for details.
+	void SoftwareSoundEngine::MixFrames(float* const output, const std::size_t frame_count)
+	{
+		const std::size_t sample_count = frame_count * channel_count;
+		std::fill(output, output + sample_count, 0.0f);
+		// Buses with effects are mixed on their own first.
+		for(std::size_t bus = utility::SoundEffect::MASTER_BUS + 1; bus < buses.size(); ++bus)
+		{
+			if(buses[bus].effects.empty() == false)
+			{
+				ReserveScratch(buses[bus].samples, sample_count);
+				std::fill(buses[bus].samples.begin(), buses[bus].samples.begin() + sample_count, 0.0f);
+			}
+		}
+		for(SoundEffectToVoice::iterator voice = voices.begin(); voice != voices.end(); ++voice)
+		{
+			if(voice->second.is_playing == true && voice->second.is_finished == false)
+			{
+				if(voice->second.is_virtual == true)
+				{
+					AdvanceVoice(voice->second, frame_count);
+				}
+				else
+				{
+					const unsigned int bus = voice->second.bus;
+					const bool is_bus_processed = (bus != utility::SoundEffect::MASTER_BUS && bus < buses.size() && buses[bus].effects.empty() == false);
+					MixVoice(voice->second, (is_bus_processed == true) ? &buses[bus].samples[0] : output, frame_count);
+				}
+			}
+		}
+		for(std::size_t bus = utility::SoundEffect::MASTER_BUS + 1; bus < buses.size(); ++bus)
+		{
+			if(buses[bus].effects.empty() == false)
+			{
+				for(std::size_t effect = 0; effect < buses[bus].effects.size(); ++effect)
+				{
+					buses[bus].effects[effect]->Process(&buses[bus].samples[0], frame_count);
+				}
+				MixSamples(&buses[bus].samples[0], 1.0f, sample_count, output);
+			}
+		}
+		if(buses.empty() == false)
+		{
+			const Bus& master = buses[utility::SoundEffect::MASTER_BUS];
+			for(std::size_t effect = 0; effect < master.effects.size(); ++effect)
+			{
+				master.effects[effect]->Process(output, frame_count);
+			}
+		}
+	}
+
+	// See method declaration for details.
+	void SoftwareSoundEngine::RenderFrames(Sink& sink, const std::size_t frame_count)
+	{
+		ReserveScratch(mix_block, BLOCK_FRAMES * channel_count);
+		for(std::size_t frames_left = frame_count; frames_left > 0;)
+		{
+			const std::size_t block_size = std::min(frames_left, BLOCK_FRAMES);
+			MixFrames(&mix_block[0], block_size);
+			sink.WriteFrames(&mix_block[0], block_size, channel_count);
+			frames_left -= block_size;
+		}
+	}
+
+	// See method declaration for details.
+	void SoftwareSoundEngine::AddBusEffect(const unsigned int bus, const std::shared_ptr<DSPEffect>& effect)
+	{
+		if(effect == nullptr)
+		{
+			throw utility::InvalidArgumentException("avl::sound::SoftwareSoundEngine::AddBusEffect()", "effect", "Must not be null.");
+		}
+		if(effect->GetSampleRate() != sample_rate || effect->GetChannelCount() != channel_count)
+		{
+			throw utility::InvalidArgumentException("avl::sound::SoftwareSoundEngine::AddBusEffect()", "effect", "Must have the engine's sample rate and channel count.");
+		}
+		try
+		{
+			if(bus >= buses.size())
+			{
+				buses.resize(bus + 1);
+			}
+			buses[bus].effects.push_back(effect);
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw utility::OutOfMemoryError();
+		}
+	}
+
+	// See method declaration for details.
+	void SoftwareSoundEngine::ClearBusEffects(const unsigned int bus)
+	{
+		if(bus < buses.size())
+		{
+			buses[bus].effects.clear();
+		}
+	}
+
+	// See method declaration for details.
+	const unsigned int SoftwareSoundEngine::GetSampleRate() const
+	{
+		return sample_rate;
+	}
+
+	// See method declaration for details.
+	const unsigned short SoftwareSoundEngine::GetChannelCount() const
+	{
+		return channel_count;
+	}
+
+	// See method declaration for details.
+	const unsigned int SoftwareSoundEngine::GetPlayingVoiceCount() const
+	{
+		unsigned int count = 0;
+		for(SoundEffectToVoice::const_iterator voice = voices.begin(); voice != voices.end(); ++voice)
+		{
+			if(voice->second.is_playing == true && voice->second.is_finished == false && voice->second.is_virtual == false)
+			{
+				++count;
+			}
+		}
+		return count;
+	}
+
+	// See method declaration for details.
+	const unsigned int SoftwareSoundEngine::GetUnderrunCount() const
+	{
+		return underrun_count;
+	}
+
+	// See method declaration for details.
+	void SoftwareSoundEngine::StartVoice(Voice& voice, const std::shared_ptr<const Sound>& sound, const utility::SoundEffect& effect)
+	{
+		voice.sound = sound;
+		voice.stream.reset();
+		voice.window_frames = 0;
+		voice.decoded_first = 0;
+		voice.decoded_frames = 0;
+		voice.is_stream_ended = false;
+		voice.handle = effect.GetSoundHandle();
+		voice.position = 0;
+		voice.step = (static_cast<unsigned long long>(sound->frequency) << 32) / sample_rate;
+		voice.volume = effect.GetVolume();
+		voice.left_pan = 1.0f;
+		voice.right_pan = 1.0f;
+		voice.is_audible = true;
+		voice.is_playing = true;
+		voice.is_looping = effect.IsLooping();
+		voice.bus = effect.GetBus();
+		voice.is_finished = false;
+		voice.is_updated = true;
+		voice.rank.priority = effect.GetPriority();
+		voice.rank.volume = effect.GetVolume();
+		voice.rank.start_order = started_voice_count++;
+		voice.is_virtual = false;
+		voice.is_ranked = false;
+	}
+
+	// See method declaration for details.
+	void SoftwareSoundEngine::StartVoice(Voice& voice, const std::shared_ptr<SoundStream>& stream, const utility::SoundEffect& effect, utility::SoundEffectList& sound_effects)
+	{
+		// Take the stream over from any other voice playing it.
+		for(SoundEffectToVoice::iterator other = voices.begin(); other != voices.end();)
+		{
+			if(other->second.stream == stream && &other->second != &voice)
+			{
+				const utility::SoundEffectList::iterator other_effect = std::find(sound_effects.begin(), sound_effects.end(), other->first);
+				if(other_effect != sound_effects.end())
+				{
+					(*other_effect)->Pause();
+				}
+				voices.erase(other++);
+			}
+			else
+			{
+				++other;
+			}
+		}
+
+		stream->Restart();
+		voice.sound.reset();
+		voice.stream = stream;
+		voice.window_frames = 0;
+		voice.decoded_first = 0;
+		voice.decoded_frames = 0;
+		voice.is_stream_ended = false;
+		voice.handle = effect.GetSoundHandle();
+		voice.position = 0;
+		voice.step = (static_cast<unsigned long long>(stream->GetFrequency()) << 32) / sample_rate;
+		voice.volume = effect.GetVolume();
+		voice.left_pan = 1.0f;
+		voice.right_pan = 1.0f;
+		voice.is_audible = true;
+		voice.is_playing = true;
+		voice.is_looping = effect.IsLooping();
+		voice.bus = effect.GetBus();
+		voice.is_finished = false;
+		voice.is_updated = true;
+		voice.rank.priority = effect.GetPriority();
+		voice.rank.volume = effect.GetVolume();
+		voice.rank.start_order = started_voice_count++;
+		voice.is_virtual = false;
+		voice.is_ranked = false;
+	}
+
+	// See method declaration for details.
+	void SoftwareSoundEngine::SpatializeVoice(Voice& voice, const std::size_t index) const
+	{
+		voice.volume = spatializer.GetGain(index);
+		voice.left_pan = spatializer.GetLeftPan(index);
+		voice.right_pan = spatializer.GetRightPan(index);
+		voice.is_audible = spatializer.IsAudible(index);
+		voice.rank.volume = voice.volume;
+	}
+
+	// See method declaration for details.
+	void SoftwareSoundEngine::CullVoices()
+	{
+		ranked_voices.clear();
+		unsigned int stream_voice_count = 0;
+		unsigned int inaudible_count = 0;
+		unsigned int inaudible_demoted_count = 0;
+		for(SoundEffectToVoice::iterator voice = voices.begin(); voice != voices.end(); ++voice)
+		{
+			if(voice->second.is_playing == false || voice->second.is_finished == true)
+			{
+				continue;
+			}
+			if(voice->second.stream != nullptr)
+			{
+				++stream_voice_count;
+				continue;
+			}
+			if(voice->second.is_audible == false)
+			{
+				// Too quiet to be heard, so not worth a real voice.
+				if(voice->second.is_ranked == true && voice->second.is_virtual == false)
+				{
+					++inaudible_demoted_count;
+				}
+				voice->second.is_virtual = true;
+				voice->second.is_ranked = true;
+				++inaudible_count;
+				continue;
+			}
+			try
+			{
+				ranked_voices.push_back(&voice->second);
+			}
+			catch(const std::bad_alloc&)
+			{
+				throw utility::OutOfMemoryError();
+			}
+		}
+
+		// Mix the most audible voices, in whatever room the streams leave.
+		const std::size_t room = (stream_voice_count < max_voice_count) ? max_voice_count - stream_voice_count : 0;
+		const std::size_t real_count = std::min(room, ranked_voices.size());
+		if(real_count < ranked_voices.size())
+		{
+			std::nth_element(ranked_voices.begin(), ranked_voices.begin() + real_count, ranked_voices.end(),
+				[](const Voice* const voice, const Voice* const other_voice) { return IsMoreAudible(voice->rank, other_voice->rank); });
+		}
+		statistics.promoted_count = 0;
+		statistics.demoted_count = inaudible_demoted_count;
+		for(std::size_t i = 0; i < ranked_voices.size(); ++i)
+		{
+			Voice& voice = *ranked_voices[i];
+			const bool is_virtual = (i >= real_count);
+			if(voice.is_ranked == true && voice.is_virtual != is_virtual)
+			{
+				if(is_virtual == true)
+				{
+					++statistics.demoted_count;
+				}
+				else
+				{
+					++statistics.promoted_count;
+				}
+			}
+			voice.is_virtual = is_virtual;
+			voice.is_ranked = true;
+		}
+		statistics.real_voice_count = stream_voice_count + static_cast<unsigned int>(real_count);
+		statistics.virtual_voice_count = static_cast<unsigned int>(ranked_voices.size() - real_count) + inaudible_count;
+	}
+
+	// See method declaration for details.
+	void SoftwareSoundEngine::AdvanceVoice(Voice& voice, const std::size_t frame_count)
+	{
+		ASSERT(voice.sound != nullptr);
+		const unsigned long long end = static_cast<unsigned long long>(voice.sound->frame_count) << 32;
+		if(end == 0 || voice.step == 0)
+		{
+			voice.is_finished = true;
+			return;
+		}
+		// Mixing wraps a looping voice's position around each time it passes the end, which
+		// comes to the same as wrapping it around once.
+		voice.position += static_cast<unsigned long long>(frame_count) * voice.step;
+		if(voice.position >= end)
+		{
+			if(voice.is_looping == true)
+			{
+				voice.position %= end;
+			}
+			else
+			{
+				voice.is_finished = true;
+			}
+		}
+	}
+
+	// See method declaration for details.
+	void SoftwareSoundEngine::MixVoice(Voice& voice, float* output, std::size_t frame_count)
+	{
+		if(voice.stream != nullptr)
+		{
+			MixStreamVoice(voice, output, frame_count);
+			return;
+		}
+		const Sound& sound = *voice.sound;
+		const unsigned short source_channels = sound.channel_count;
+		const std::size_t frame_size = source_channels * (sound.bit_depth / 8);
+		const unsigned long long end = static_cast<unsigned long long>(sound.frame_count) << 32;
+		if(end == 0 || voice.step == 0)
+		{
+			voice.is_finished = true;
+			return;
+		}
+
+		while(frame_count > 0 && voice.is_finished == false)
+		{
+			// Mix up to the end of the sound, a block at a time.
+			const std::size_t first = static_cast<std::size_t>(voice.position >> 32);
+			const std::size_t count = static_cast<std::size_t>(std::min<unsigned long long>(std::min(frame_count, BLOCK_FRAMES), (end - voice.position - 1) / voice.step + 1));
+			// After the end of the sound, the next frame is its first frame if it's looping, and
+			// silence otherwise.
+			const std::size_t last = static_cast<std::size_t>((voice.position + (count - 1) * voice.step) >> 32);
+			const bool is_next_in_sound = (last + 1 < sound.frame_count);
+			const char* const frames = GetFrames(voice, first, (is_next_in_sound == true) ? last + 1 : last);
+			const char* next_frame = nullptr;
+			if(is_next_in_sound == true)
+			{
+				next_frame = &frames[(last + 1 - first) * frame_size];
+			}
+			else if(voice.is_looping == true)
+			{
+				next_frame = (sound.encoding == SoundSample::PCM) ? sound.data.get() : reinterpret_cast<const char*>(&sound.first_frame[0]);
+			}
+			const float* const samples = ConvertFrames(frames, next_frame, sound.bit_depth, source_channels,
+				voice.position - (static_cast<unsigned long long>(first) << 32), voice.step, count);
+
+			MixChannels(samples, source_channels, voice.volume, voice.left_pan, voice.right_pan, count, output);
+			output += count * channel_count;
+			frame_count -= count;
+			voice.position += count * voice.step;
+			if(voice.position >= end)
+			{
+				if(voice.is_looping == true)
+				{
+					voice.position %= end;
+				}
+				else
+				{
+					voice.is_finished = true;
+				}
+			}
+		}
+	}
+
+	// See method declaration for details.
+	void SoftwareSoundEngine::MixStreamVoice(Voice& voice, float* output, std::size_t frame_count)
+	{
+		SoundStream& stream = *voice.stream;
+		const unsigned short source_channels = stream.GetNumberOfChannels();
+		const std::size_t frame_size = source_channels * (stream.GetBitDepth() / 8);
+		if(voice.step == 0)
+		{
+			voice.is_finished = true;
+			return;
+		}
+
+		while(frame_count > 0 && voice.is_finished == false)
+		{
+			// Read the frames which this block uses, plus the one after them to interpolate toward.
+			const std::size_t block_size = std::min(frame_count, BLOCK_FRAMES);
+			const std::size_t needed = static_cast<std::size_t>((voice.position + (block_size - 1) * voice.step) >> 32) + 2;
+			if(voice.window_frames < needed && voice.is_stream_ended == false)
+			{
+				if(voice.window.size() < needed * frame_size)
+				{
+					try
+					{
+						voice.window.resize(needed * frame_size);
+					}
+					catch(const std::bad_alloc&)
+					{
+						throw utility::OutOfMemoryError();
+					}
+				}
+				while(voice.window_frames < needed)
+				{
+					bool is_end = false;
+					const std::size_t read = stream.ReadFrames(&voice.window[voice.window_frames * frame_size], needed - voice.window_frames, is_end);
+					voice.window_frames += read;
+					if(is_end == true && voice.is_looping == false)
+					{
+						voice.is_stream_ended = true;
+						break;
+					}
+					if(read == 0)
+					{
+						// The reader hasn't caught up.
+						break;
+					}
+				}
+			}
+
+			// Mix as much of the block as the window covers. After the end of a stream which
+			// isn't looped, the next frame is silence.
+			const unsigned long long available = static_cast<unsigned long long>(voice.window_frames) << 32;
+			std::size_t count = block_size;
+			if(voice.is_stream_ended == true)
+			{
+				if(voice.position >= available)
+				{
+					voice.is_finished = true;
+					break;
+				}
+				count = static_cast<std::size_t>(std::min<unsigned long long>(count, (available - voice.position - 1) / voice.step + 1));
+			}
+			else if(voice.window_frames < needed)
+			{
+				const unsigned long long usable = (voice.window_frames > 1) ? available - ONE_FRAME : 0;
+				count = (voice.position < usable) ? static_cast<std::size_t>(std::min<unsigned long long>(count, (usable - voice.position - 1) / voice.step + 1)) : 0;
+				if(count == 0)
+				{
+					// Leave the rest of the mix silent rather than wait on the reader.
+					++underrun_count;
+					break;
+				}
+			}
+			const std::size_t first = static_cast<std::size_t>(voice.position >> 32);
+			const std::size_t last = static_cast<std::size_t>((voice.position + (count - 1) * voice.step) >> 32);
+			const char* const next_frame = (last + 1 < voice.window_frames) ? &voice.window[(last + 1) * frame_size] : nullptr;
+			const float* const samples = ConvertFrames(&voice.window[first * frame_size], next_frame, stream.GetBitDepth(), source_channels,
+				voice.position - (static_cast<unsigned long long>(first) << 32), voice.step, count);
+
+			MixChannels(samples, source_channels, voice.volume, voice.left_pan, voice.right_pan, count, output);
+			output += count * channel_count;
+			frame_count -= count;
+			voice.position += count * voice.step;
+
+			// Drop the frames which have been mixed past.
+			const std::size_t passed = std::min(static_cast<std::size_t>(voice.position >> 32), voice.window_frames);
+			if(passed > 0)
+			{
+				memmove(&voice.window[0], &voice.window[passed * frame_size], (voice.window_frames - passed) * frame_size);
+				voice.window_frames -= passed;
+				voice.position -= static_cast<unsigned long long>(passed) << 32;
+			}
+			if(voice.is_stream_ended == true && voice.position >= (static_cast<unsigned long long>(voice.window_frames) << 32))
+			{
+				voice.is_finished = true;
+			}
+		}
+	}
+
+	// See method declaration for details.
+	const char* const SoftwareSoundEngine::GetFrames(Voice& voice, const std::size_t first, const std::size_t last)
+	{
+		const Sound& sound = *voice.sound;
+		if(sound.encoding == SoundSample::PCM)
+		{
+			return &sound.data.get()[first * sound.channel_count * (sound.bit_depth / 8)];
+		}
+		if(first >= voice.decoded_first && last < voice.decoded_first + voice.decoded_frames)
+		{
+			return reinterpret_cast<const char*>(&voice.decoded[(first - voice.decoded_first) * sound.channel_count]);
+		}
+
+		// Keep whatever's been decoded from the first block needed on, and decode the rest.
+		const std::size_t first_block = first / sound.block_frames;
+		const std::size_t last_block = last / sound.block_frames;
+		const std::size_t decoded_block = voice.decoded_first / sound.block_frames;
+		const std::size_t decoded_blocks = (voice.decoded_frames + sound.block_frames - 1) / sound.block_frames;
+		std::size_t block = first_block;
+		if(first_block >= decoded_block && first_block < decoded_block + decoded_blocks)
+		{
+			const std::size_t passed = (first_block - decoded_block) * sound.block_frames;
+			memmove(&voice.decoded[0], &voice.decoded[passed * sound.channel_count], (voice.decoded_frames - passed) * sound.channel_count * sizeof(short));
+			voice.decoded_frames -= passed;
+			block = decoded_block + decoded_blocks;
+		}
+		else
+		{
+			voice.decoded_frames = 0;
+		}
+		voice.decoded_first = first_block * sound.block_frames;
+
+		const std::size_t needed = (last_block - first_block + 1) * sound.block_frames * sound.channel_count;
+		if(voice.decoded.size() < needed)
+		{
+			try
+			{
+				voice.decoded.resize(needed);
+			}
+			catch(const std::bad_alloc&)
+			{
+				throw utility::OutOfMemoryError();
+			}
+		}
+		for(; block <= last_block; ++block)
+		{
+			const std::size_t offset = block * sound.block_alignment;
+			const std::size_t block_size = std::min<std::size_t>(sound.block_alignment, sound.data_size - offset);
+			voice.decoded_frames += DecodeADPCMBlock(sound.encoding, &sound.data.get()[offset], block_size, sound.channel_count, &voice.decoded[voice.decoded_frames * sound.channel_count]);
+		}
+		ASSERT(last < voice.decoded_first + voice.decoded_frames);
+		return reinterpret_cast<const char*>(&voice.decoded[(first - voice.decoded_first) * sound.channel_count]);
+	}
+
+	// See method declaration for details.
+	const float* const SoftwareSoundEngine::ConvertFrames(const char* const frames, const char* const next_frame, const unsigned short bit_depth, const unsigned short source_channels,
+		const unsigned long long position, const unsigned long long step, const std::size_t count)
+	{
+		if(step == ONE_FRAME)
+		{
+			ReserveScratch(converted_samples, count * source_channels);
+			ConvertPCMToFloat(frames, bit_depth, count * source_channels, &converted_samples[0]);
+			return &converted_samples[0];
+		}
+
+		// Interpolating between frames takes the frame after the last one used too.
+		const std::size_t last = static_cast<std::size_t>((position + (count - 1) * step) >> 32);
+		const std::size_t source_count = last + 1;
+		ReserveScratch(converted_samples, (source_count + 1) * source_channels);
+		ConvertPCMToFloat(frames, bit_depth, source_count * source_channels, &converted_samples[0]);
+		float* const next = &converted_samples[source_count * source_channels];
+		if(next_frame != nullptr)
+		{
+			ConvertPCMToFloat(next_frame, bit_depth, source_channels, next);
+		}
+		else
+		{
+			std::fill(next, next + source_channels, 0.0f);
+		}
+
+		ReserveScratch(resampled_samples, count * source_channels);
+		unsigned long long frame_position = position;
+		for(std::size_t i = 0; i < count; ++i, frame_position += step)
+		{
+			const float* const frame = &converted_samples[static_cast<std::size_t>(frame_position >> 32) * source_channels];
+			const float fraction = static_cast<float>(static_cast<unsigned int>(frame_position)) * (1.0f / 4294967296.0f);
+			for(unsigned short channel = 0; channel < source_channels; ++channel)
+			{
+				resampled_samples[i * source_channels + channel] = frame[channel] + (frame[source_channels + channel] - frame[channel]) * fraction;
+			}
+		}
+		return &resampled_samples[0];
+	}
+
+	// See method declaration for details.
+	void SoftwareSoundEngine::MixChannels(const float* const samples, const unsigned short source_channels, const float volume, const float left_pan, const float right_pan,
+		const std::size_t frame_count, float* const output) const
+	{
+		if(channel_count == 2 && source_channels <= 2 && (left_pan != 1.0f || right_pan != 1.0f))
+		{
+			MixPannedSamples(samples, source_channels, volume * left_pan, volume * right_pan, frame_count, output);
+		}
+		else if(source_channels == channel_count)
+		{
+			MixSamples(samples, volume, frame_count * channel_count, output);
+		}
+		else if(source_channels == 1)
+		{
+			MixMonoSamples(samples, volume, frame_count, channel_count, output);
+		}
+		else
+		{
+			// Map the sound's channels onto ours in order, wrapping around.
+			for(std::size_t frame = 0; frame < frame_count; ++frame)
+			{
+				for(unsigned short channel = 0; channel < source_channels; ++channel)
+				{
+					output[frame * channel_count + channel % channel_count] += samples[frame * source_channels + channel] * volume;
+				}
+			}
+		}
+	}
+
+	// See method declaration for details.
+	void SoftwareSoundEngine::ReserveScratch(std::vector<float>& buffer, const std::size_t size)
+	{
+		if(buffer.size() < size)
+		{
+			try
+			{
+				buffer.resize(size);
+			}
+			catch(const std::bad_alloc&)
+			{
+				throw utility::OutOfMemoryError();
+			}
+		}
+	}
+
+	// See method declaration for details.
+	const utility::SoundEffect::SoundHandle SoftwareSoundEngine::IssueHandle()
+	{
+		// Reuse any reusable sound handles.
+		utility::SoundEffect::SoundHandle issued_handle;
+		if(reusable_sound_handles.empty() == false)
+		{
+			issued_handle = reusable_sound_handles.front();
+			reusable_sound_handles.pop();
+		}
+		else
+		{
+			issued_handle = next_handle;
+			++next_handle;
+		}
+		return issued_handle;
+	}
+
+
+
+} // sound
+} // avl
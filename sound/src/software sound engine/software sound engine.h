@@ -0,0 +1,476 @@
+#pragma once
+#ifndef AVL_SOUND_SOFTWARE_SOUND_ENGINE__
+#define AVL_SOUND_SOFTWARE_SOUND_ENGINE__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Defines the \ref avl::sound::SoftwareSoundEngine class.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"..\dsp effects\dsp effects.h"
+#include"..\sound engine\sound engine.h"
+#include"..\sound sample\sound sample.h"
+#include"..\sound stream\sound stream.h"
+#include"..\spatialization\spatialization.h"
+#include"..\..\..\utility\src\sound effect\sound effect.h"
+#include<map>
+#include<queue>
+#include<vector>
+#include<memory>
+#include<string>
+#include<cstddef>
+
+
+namespace avl
+{
+namespace sound
+{
+
+	/**
+	Implements the \ref avl::sound::SoundEngine interface by mixing every playing sound
+	effect in software, without an audio device. The mix is produced on demand, a block of
+	frames at a time, and handed to a \ref Sink; so it runs anywhere, and as fast as it's
+	asked to, which makes it suitable for tests and offline rendering.
+	@par Mixing:
+	Each voice's PCM data is converted to floats a block at a time, resampled with linear
+	interpolation if its rate differs from the engine's, scaled by its volume, and added to
+	the mix. Mono sounds are played on every channel; otherwise a sound's channels are mapped
+	onto the engine's channels in order, wrapping around. The mix isn't clipped; sinks which
+	need integer samples saturate them.
+	@par Positional audio:
+	Each update spatializes every updated sound effect in one batch. A positional effect's
+	voice is mixed at its attenuated volume, and when mixing stereo, a mono or stereo
+	sound is panned by it. Positional effects which are too quiet to be heard are
+	virtualized, whatever their priority; except for streams, which are never virtualized.
+	@par Streams:
+	A voice playing a stream reads just the frames which its next block needs from the
+	stream, into a window which holds a block's worth of frames at most. If the stream's
+	reader hasn't caught up, the rest of the block is left silent; see
+	\ref GetUnderrunCount().
+	@par ADPCM:
+	Compressed samples stay compressed. A voice decodes just the blocks which its next block
+	of frames uses, into a window of its own, and keeps the last of them for the next block.
+	@par Voice virtualization:
+	At most a set number of voices are mixed. Once more sound effects than that are playing,
+	the least audible ones (see \ref SoundEngine::IsMoreAudible()) are virtualized each time
+	the sounds are updated: they're only advanced, not mixed, so that they carry on from
+	exactly where they would have been once they're mixed again. Voices playing streams are
+	never virtualized, but do count toward the limit.
+	@par Buses:
+	Each sound effect is mixed into a bus; see \ref utility::SoundEffect::SetBus(). Bus
+	\ref utility::SoundEffect::MASTER_BUS is the mix itself. Every other bus with effects of
+	its own (see \ref AddBusEffect()) is mixed separately, processed by them in the order
+	they were added, and then added to the mix; a bus without effects is mixed straight into
+	the mix. Finally, the master bus's effects process the whole mix.
+	*/
+	class SoftwareSoundEngine: public SoundEngine
+	{
+	public:
+		/**
+		Receives the mix from \ref RenderFrames().
+		*/
+		class Sink
+		{
+		public:
+			/** Basic destructor.*/
+			virtual ~Sink();
+
+			/** Receives a block of mixed frames.
+			@param samples The interleaved float samples, valid only during the call.
+			@param frame_count The number of frames in \a samples.
+			@param channel_count The number of channels in each frame.
+			*/
+			virtual void WriteFrames(const float* const samples, const std::size_t frame_count, const unsigned short channel_count) = 0;
+		};
+
+		/** Basic constructor.
+		@param sample_rate The number of frames per second to mix at.
+		@param channel_count The number of channels to mix.
+		@param max_voices The most voices to mix at once.
+		@throws InvalidArgumentException If \a sample_rate, \a channel_count, or \a max_voices
+		is 0.
+		*/
+		SoftwareSoundEngine(const unsigned int sample_rate = 48000, const unsigned short channel_count = 2, const unsigned int max_voices = 64);
+
+		/** Basic destructor.
+		*/
+		~SoftwareSoundEngine();
+
+		/** Makes it possible to play \a new_sample using the returned sound handle. The audio
+		data is shared with \a new_sample rather than copied.
+		@param new_sample The sample to be stored internally and accessed via the
+		returned sound handle.
+		@return The sound handle by which \a new_sample is to be accessed.
+		@throw InvalidArgumentException If the \a new_sample audio data is null, or if it has no
+		channels, no frequency, or a bit depth other than 8, 16, 24, or 32; or if it's ADPCM with
+		an unsupported block layout, or holds fewer frames than it claims.
+		@throw OutOfMemoryError If there's not enough memory to store the sound.
+		*/
+		const utility::SoundEffect::SoundHandle AddSound(const sound::SoundSample& new_sample);
+
+		/** Tells whether samples compressed with ADPCM are kept compressed once added.
+		@return True, since voices decode them as they play.
+		*/
+		const bool IsPlayingADPCM() const;
+
+		/** Makes it possible to play the WAV file named \a file_name, a chunk at a time, using
+		the returned sound handle.
+		@param file_name The name of the WAV file to be streamed.
+		@return The sound handle by which the stream is to be accessed.
+		@throw InvalidArgumentException If the file has no frequency, or a bit depth other than
+		8, 16, 24, or 32.
+		@throw OutOfMemoryError If there's not enough memory to open the stream.
+		@throw Exception See \ref avl::sound::SoundStream::SoundStream().
+		*/
+		const utility::SoundEffect::SoundHandle AddStream(const std::string& file_name);
+
+		/** Removes the sound sample or stream associated with \a handle, making it no longer
+		accessible. Voices already playing it finish playing it.
+		@param handle The handle to the sound which is to be deleted.
+		@throw OutOfMemoryError If we run out of memory.
+		*/
+		void DeleteSound(const utility::SoundEffect::SoundHandle& handle);
+
+		/** Stops all currently playing sounds and deallocates all memory storing
+		sounds and sound data, and renders all currently issued sound handles invalid
+		@post Any previously issued sound handles will be rendered invalid, and
+		may in the future become associated with different sounds.
+		*/
+		void ClearSounds();
+
+		/** Starts, stops, and updates the voices of the sound effects in \a sound_effects. An
+		effect whose sound has finished playing is paused. Voices of effects which aren't in
+		\a sound_effects keep playing until they finish.
+		@param sound_effects The SoundEffect objects whose state needs to be updated.
+		@throw InvalidArgumentException If one or more sound effects contain an invalid
+		sound handle.
+		@throw OutOfMemoryError If unable to allocate necessary storage.
+		*/
+		void UpdateSounds(utility::SoundEffectList& sound_effects);
+
+		/** Counts the voices which are mixed and the voices which are virtualized, as of the
+		last call to UpdateSounds(). Only voices which are playing and haven't finished are
+		counted.
+		@return The counts.
+		*/
+		const VoiceStatistics GetVoiceStatistics() const;
+
+		/** Mixes the next \a frame_count frames of every playing voice, through the buses.
+		@param output [OUT] Receives the interleaved float samples. Must have room for
+		\a frame_count * \ref GetChannelCount() samples.
+		@param frame_count The number of frames to mix.
+		@throw OutOfMemoryError If unable to allocate necessary storage.
+		*/
+		void MixFrames(float* const output, const std::size_t frame_count);
+
+		/** Mixes the next \a frame_count frames and writes them to \a sink, a block at a time.
+		@param sink The sink to write to.
+		@param frame_count The number of frames to mix.
+		@throw OutOfMemoryError If unable to allocate necessary storage.
+		*/
+		void RenderFrames(Sink& sink, const std::size_t frame_count);
+
+		/** Adds an effect to the end of a bus's chain of effects. The effect is kept until the
+		bus is cleared, and is only used from within \ref MixFrames().
+		@param bus The bus. \ref utility::SoundEffect::MASTER_BUS processes the whole mix.
+		@param effect The effect.
+		@throw InvalidArgumentException If \a effect is null, or if its sample rate or channel
+		count differs from the engine's.
+		@throw OutOfMemoryError If unable to allocate necessary storage.
+		*/
+		void AddBusEffect(const unsigned int bus, const std::shared_ptr<DSPEffect>& effect);
+
+		/** Removes every effect from a bus, so that it's mixed straight into the mix again.
+		@param bus The bus.
+		*/
+		void ClearBusEffects(const unsigned int bus);
+
+		/** Accesses the number of frames mixed per second.
+		@return The sample rate.
+		*/
+		const unsigned int GetSampleRate() const;
+
+		/** Accesses the number of channels mixed.
+		@return The number of channels.
+		*/
+		const unsigned short GetChannelCount() const;
+
+		/** Counts the voices which are playing, haven't finished, and aren't virtualized.
+		@return The number of voices mixed by the next call to \ref MixFrames().
+		*/
+		const unsigned int GetPlayingVoiceCount() const;
+
+		/** Counts the blocks which voices playing streams couldn't finish mixing because the
+		streams' readers hadn't caught up.
+		@return The number of underruns since the engine was constructed.
+		*/
+		const unsigned int GetUnderrunCount() const;
+
+	private:
+		/**
+		The audio data and format of a sound.
+		*/
+		struct Sound
+		{
+			/// The bit depth of each sample, once decoded.
+			unsigned short bit_depth;
+			/// The number of channels in each frame.
+			unsigned short channel_count;
+			/// The number of frames per second.
+			unsigned int frequency;
+			/// The number of whole frames in \ref data.
+			std::size_t frame_count;
+			/// The audio data, shared with the sample which it came from.
+			std::shared_ptr<const char> data;
+			/// How \ref data is encoded.
+			SoundSample::Encoding encoding;
+			/// The size of each block of ADPCM in \ref data.
+			unsigned short block_alignment;
+			/// The number of frames in each whole block of ADPCM.
+			std::size_t block_frames;
+			/// The size of \ref data in bytes.
+			std::size_t data_size;
+			/// The first frame of ADPCM, decoded, for looping voices to interpolate toward.
+			std::vector<short> first_frame;
+		};
+
+		/**
+		The playback state of a sound effect.
+		*/
+		struct Voice
+		{
+			/// The sound being played, if any. Shared, so that the sound may be deleted while it plays.
+			std::shared_ptr<const Sound> sound;
+			/// The stream being played, if any. Shared for the same reason as \ref sound.
+			std::shared_ptr<SoundStream> stream;
+			/// The frames read from \ref stream which haven't been mixed past yet.
+			std::vector<char> window;
+			/// The number of frames in \ref window.
+			std::size_t window_frames;
+			/// The frames decoded from the ADPCM blocks of \ref sound which the voice is playing.
+			std::vector<short> decoded;
+			/// The index of the first frame in \ref decoded.
+			std::size_t decoded_first;
+			/// The number of frames in \ref decoded.
+			std::size_t decoded_frames;
+			/// Set once the frames in \ref window end a pass through \ref stream which isn't looped.
+			bool is_stream_ended;
+			/// The handle of the sound being played.
+			utility::SoundEffect::SoundHandle handle;
+			/// The position in \ref sound, or in \ref window, in frames, as a 32.32 fixed point number.
+			unsigned long long position;
+			/// The amount added to \ref position per frame mixed.
+			unsigned long long step;
+			/// The volume to mix at: the effect's volume, attenuated if it's positional.
+			float volume;
+			/// How much of the voice is mixed on the left, in stereo.
+			float left_pan;
+			/// How much of the voice is mixed on the right, in stereo.
+			float right_pan;
+			/// The bus which the voice is mixed into.
+			unsigned int bus;
+			/// Whether the voice is loud enough to be heard.
+			bool is_audible;
+			/// Whether the voice is mixed.
+			bool is_playing;
+			/// Whether the voice starts over when it reaches the end of its sound.
+			bool is_looping;
+			/// Set once a voice which isn't looping reaches the end of its sound.
+			bool is_finished;
+			/// Set when the voice's effect is updated, so that orphaned voices can be found.
+			bool is_updated;
+			/// How much the voice deserves to be mixed.
+			VoiceRank rank;
+			/// Whether the voice is only advanced rather than mixed.
+			bool is_virtual;
+			/// Whether the voice has been ranked since it started, so that a new voice which
+			/// is virtualized at once isn't counted as demoted.
+			bool is_ranked;
+		};
+
+		/**
+		A bus's chain of effects, and the buffer which it's mixed into.
+		*/
+		struct Bus
+		{
+			/// The effects, in the order which they process the bus.
+			std::vector<std::shared_ptr<DSPEffect>> effects;
+			/// Holds the bus's mix while its effects process it.
+			std::vector<float> samples;
+		};
+
+		/** Starts playing a voice from the beginning of a sound.
+		@param voice The voice to start.
+		@param sound The sound to play.
+		@param effect The effect which the voice plays.
+		*/
+		void StartVoice(Voice& voice, const std::shared_ptr<const Sound>& sound, const utility::SoundEffect& effect);
+
+		/** Starts playing a voice from the beginning of a stream, taking the stream over from
+		any other voice playing it.
+		@param voice The voice to start.
+		@param stream The stream to play.
+		@param effect The effect which the voice plays.
+		@param sound_effects The effects being updated, so that the effect which the stream is
+		taken from can be paused.
+		*/
+		void StartVoice(Voice& voice, const std::shared_ptr<SoundStream>& stream, const utility::SoundEffect& effect, utility::SoundEffectList& sound_effects);
+
+		/** Brings a voice's volume and panning up to date with its effect's.
+		@param voice The voice.
+		@param index The index of the voice's effect in \ref spatializer.
+		*/
+		void SpatializeVoice(Voice& voice, const std::size_t index) const;
+
+		/** Picks the voices to mix: the most audible of those which are playing, haven't
+		finished, and can be heard, up to the limit. The rest are virtualized.
+		@throw OutOfMemoryError If unable to allocate necessary storage.
+		*/
+		void CullVoices();
+
+		/** Advances a virtualized voice as far as mixing it would have.
+		@param voice The voice to advance. It mustn't be playing a stream.
+		@param frame_count The number of frames to advance it by.
+		*/
+		static void AdvanceVoice(Voice& voice, const std::size_t frame_count);
+
+		/** Mixes the next frames of a voice.
+		@param voice The voice to mix. Its position is advanced.
+		@param output [IN/OUT] The mix to add to.
+		@param frame_count The number of frames to mix.
+		@throw OutOfMemoryError If unable to allocate necessary storage.
+		*/
+		void MixVoice(Voice& voice, float* output, std::size_t frame_count);
+
+		/** Mixes the next frames of a voice which plays a stream, reading them as needed.
+		@param voice The voice to mix. Its position and window are advanced.
+		@param output [IN/OUT] The mix to add to.
+		@param frame_count The number of frames to mix.
+		@throw OutOfMemoryError If unable to allocate necessary storage.
+		*/
+		void MixStreamVoice(Voice& voice, float* output, std::size_t frame_count);
+
+		/** Finds the frames which a block of a voice playing a sound uses, decoding them first
+		if the sound is ADPCM.
+		@param voice The voice. Its window of decoded frames is advanced.
+		@param first The index of the first frame needed.
+		@param last The index of the last frame needed.
+		@return The frames, as PCM.
+		@throw OutOfMemoryError If unable to allocate necessary storage.
+		*/
+		static const char* const GetFrames(Voice& voice, const std::size_t first, const std::size_t last);
+
+		/** Converts the frames which a block of a voice uses to floats, resampling them if
+		the voice's step isn't one frame.
+		@param frames The frame at the voice's position, followed by the rest of the frames
+		which the block uses.
+		@param next_frame The frame after the last one which the block uses, to interpolate
+		toward; or null to interpolate toward silence. Unused if the step is one frame.
+		@param bit_depth The bit depth of each sample.
+		@param source_channels The number of channels in each frame.
+		@param position The voice's position relative to \a frames, in 32.32 fixed point.
+		@param step The amount added to \a position per frame mixed.
+		@param count The number of frames to mix.
+		@return The block's samples, in one of the scratch buffers.
+		@throw OutOfMemoryError If unable to allocate necessary storage.
+		*/
+		const float* const ConvertFrames(const char* const frames, const char* const next_frame, const unsigned short bit_depth, const unsigned short source_channels,
+			const unsigned long long position, const unsigned long long step, const std::size_t count);
+
+		/** Adds a voice's samples to the mix, mapping its channels onto the engine's.
+		@param samples The voice's samples.
+		@param source_channels The number of channels in \a samples.
+		@param volume The volume to mix at.
+		@param left_pan How much of the samples to mix on the left, in stereo.
+		@param right_pan How much of the samples to mix on the right, in stereo.
+		@param frame_count The number of frames in \a samples.
+		@param output [IN/OUT] The mix to add to.
+		*/
+		void MixChannels(const float* const samples, const unsigned short source_channels, const float volume, const float left_pan, const float right_pan,
+			const std::size_t frame_count, float* const output) const;
+
+		/** Makes sure that a scratch buffer can hold \a size floats.
+		@param buffer The buffer.
+		@param size The number of floats needed.
+		@throw OutOfMemoryError If unable to allocate the buffer.
+		*/
+		static void ReserveScratch(std::vector<float>& buffer, const std::size_t size);
+
+		/** Issues a sound handle, reusing a freed one if there is one.
+		@return The sound handle.
+		*/
+		const utility::SoundEffect::SoundHandle IssueHandle();
+
+		/// The number of frames mixed per second.
+		const unsigned int sample_rate;
+		/// The number of channels mixed.
+		const unsigned short channel_count;
+		/// The most voices mixed at once.
+		const unsigned int max_voice_count;
+
+		/// Keeps track of which sound handles have already been issued.
+		utility::SoundEffect::SoundHandle next_handle;
+		/// Keeps track of sound handles which have been freed so that they may be reused.
+		std::queue<utility::SoundEffect::SoundHandle> reusable_sound_handles;
+
+		/// Maps sound handles to sounds.
+		typedef std::map<const utility::SoundEffect::SoundHandle, std::shared_ptr<const Sound>> SoundHandleToSound;
+		/// Maps sound handles to streams.
+		typedef std::map<const utility::SoundEffect::SoundHandle, std::shared_ptr<SoundStream>> SoundHandleToStream;
+		/// Maps sound effect addresses to voices, but never dereferences these addresses.
+		typedef std::map<const utility::SoundEffect*, Voice> SoundEffectToVoice;
+
+		/// All currently loaded sounds and their associated sound handles.
+		SoundHandleToSound sounds;
+		/// All currently open streams and their associated sound handles.
+		SoundHandleToStream streams;
+		/// All current voices and their associated sound effect addresses.
+		SoundEffectToVoice voices;
+
+		/// Holds a voice's samples converted to floats.
+		std::vector<float> converted_samples;
+		/// Holds a voice's samples once resampled.
+		std::vector<float> resampled_samples;
+		/// Holds a block of the mix for RenderFrames().
+		std::vector<float> mix_block;
+		/// The number of blocks which stream voices couldn't finish mixing.
+		unsigned int underrun_count;
+		/// The number of voices started, which orders them by recency.
+		unsigned int started_voice_count;
+		/// The voices which may be virtualized, while CullVoices() ranks them.
+		std::vector<Voice*> ranked_voices;
+		/// The counts of real and virtual voices, as of the last update.
+		VoiceStatistics statistics;
+		/// Works out the volumes and panning of the effects being updated.
+		Spatializer spatializer;
+		/// The buses which have had effects added, indexed by bus.
+		std::vector<Bus> buses;
+
+		/// NOT IMPLEMENTED.
+		SoftwareSoundEngine(const SoftwareSoundEngine&);
+		/// NOT IMPLEMENTED.
+		const SoftwareSoundEngine& operator=(const SoftwareSoundEngine&);
+	};
+
+
+
+} // sound
+} // avl
+#endif // AVL_SOUND_SOFTWARE_SOUND_ENGINE__
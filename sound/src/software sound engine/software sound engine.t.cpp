@@ -0,0 +1,562 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the software sound engine component. See "software sound engine.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"software sound engine.h"
+#include"..\wav file sink\wav file sink.h"
+#include"..\sound sample\sound sample.h"
+#include"..\load wav file\load wav file.h"
+#include"..\adpcm\adpcm.h"
+#include"..\dsp effects\dsp effects.h"
+#include"..\..\..\utility\src\sound effect\sound effect.h"
+#include"..\..\..\utility\src\vector\vector.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\timer\timer.h"
+#include<iostream>
+#include<vector>
+#include<cstring>
+#include<cmath>
+#include<cstdlib>
+#include<Windows.h>
+
+using avl::sound::SoftwareSoundEngine;
+using avl::sound::WAVFileSink;
+using avl::sound::SoundSample;
+using avl::sound::LoadWAVFile;
+using avl::sound::EncodeADPCM;
+using avl::sound::DecodeADPCMSample;
+using avl::utility::SoundEffect;
+using avl::utility::SoundEffectList;
+
+
+
+// Anonymous namespace.
+namespace
+{
+	SoundSample MakeSample(const std::vector<short>& samples, const unsigned int frequency, const unsigned int channel_count);
+	const bool IsEveryFrame(const std::vector<float>& mix, const std::size_t first, const std::size_t last, const float value);
+}
+
+
+
+void TestSoftwareSoundEngineComponent()
+{
+	using avl::utility::Timer;
+
+	SoftwareSoundEngine engine(48000, 2);
+	std::vector<float> mix(48000 * 2);
+
+	// A mono sound plays on both channels at its effect's volume, then pauses its effect once
+	// it has played through.
+	const SoundEffect::SoundHandle constant = engine.AddSound(MakeSample(std::vector<short>(1000, 16384), 48000, 1));
+	{
+		SoundEffect effect(constant);
+		effect.SetVolume(0.5f);
+		effect.Play();
+		SoundEffectList list(1, &effect);
+		engine.UpdateSounds(list);
+		ASSERT(engine.GetPlayingVoiceCount() == 1);
+		engine.MixFrames(&mix[0], 600);
+		ASSERT(IsEveryFrame(mix, 0, 600, 0.25f));
+		engine.MixFrames(&mix[0], 600);
+		ASSERT(IsEveryFrame(mix, 0, 400, 0.25f) && IsEveryFrame(mix, 400, 600, 0.0f));
+		ASSERT(engine.GetPlayingVoiceCount() == 0);
+		engine.UpdateSounds(list);
+		ASSERT(effect.IsPlaying() == false);
+
+		// Looping plays it over and over.
+		effect.Loop(true);
+		effect.Play();
+		engine.UpdateSounds(list);
+		engine.MixFrames(&mix[0], 2500);
+		ASSERT(IsEveryFrame(mix, 0, 2500, 0.25f));
+		effect.Stop();
+		engine.UpdateSounds(list);
+		ASSERT(engine.GetPlayingVoiceCount() == 0);
+		std::cout << "Sounds play, finish, and loop.\n";
+	}
+
+	// Positional sounds are attenuated by their distance from the listener and panned with
+	// equal power, and those too far away to be heard aren't mixed.
+	{
+		SoundEffect effect(constant);
+		effect.Loop(true);
+		effect.SetPosition(avl::utility::Vector(3.0f, 4.0f));
+		effect.Play();
+		SoundEffectList list(1, &effect);
+		engine.UpdateSounds(list);
+		engine.MixFrames(&mix[0], 100);
+		for(std::size_t frame = 0; frame < 100; ++frame)
+		{
+			// 5 away, so a fifth of the volume; 3 to the right.
+			ASSERT(std::abs(mix[frame * 2] - 0.5f * 0.2f * std::sqrt(0.2f)) < 1e-6f);
+			ASSERT(std::abs(mix[frame * 2 + 1] - 0.5f * 0.2f * std::sqrt(0.8f)) < 1e-6f);
+		}
+		engine.SetListenerPosition(avl::utility::Vector(3.0f, 0.0f));
+		engine.UpdateSounds(list);
+		engine.MixFrames(&mix[0], 100);
+		ASSERT(std::abs(mix[0] - 0.5f * 0.25f * std::sqrt(0.5f)) < 1e-6f && mix[0] == mix[1]);
+
+		const avl::sound::Attenuation original_attenuation = engine.GetAttenuation();
+		const avl::sound::Attenuation attenuation = {1.0f, 1000.0f, 0.01f};
+		engine.SetAttenuation(attenuation);
+		effect.SetPosition(avl::utility::Vector(500.0f, 0.0f));
+		engine.UpdateSounds(list);
+		const avl::sound::VoiceStatistics statistics = engine.GetVoiceStatistics();
+		ASSERT(statistics.real_voice_count == 0 && statistics.virtual_voice_count == 1);
+		engine.MixFrames(&mix[0], 100);
+		ASSERT(IsEveryFrame(mix, 0, 100, 0.0f));
+		effect.ClearPosition();
+		engine.UpdateSounds(list);
+		engine.MixFrames(&mix[0], 100);
+		ASSERT(IsEveryFrame(mix, 0, 100, 0.5f));
+		effect.Stop();
+		engine.UpdateSounds(list);
+		engine.SetListenerPosition(avl::utility::Vector());
+		engine.SetAttenuation(original_attenuation);
+		std::cout << "Positional sounds are attenuated and panned.\n";
+	}
+
+	// A bus's effects process just the voices mixed into it, and the master bus's effects
+	// process the whole mix.
+	{
+		SoundEffect filtered(constant);
+		filtered.Loop(true);
+		filtered.SetVolume(0.5f);
+		filtered.SetBus(1);
+		filtered.Play();
+		SoundEffect plain(constant);
+		plain.Loop(true);
+		plain.SetVolume(0.5f);
+		plain.Play();
+		SoundEffect loud(constant);
+		loud.Loop(true);
+		loud.SetVolume(0.5f);
+		loud.Play();
+		SoundEffectList list;
+		list.push_back(&filtered);
+		list.push_back(&plain);
+		engine.UpdateSounds(list);
+		engine.AddBusEffect(1, std::make_shared<avl::sound::BiquadFilter>(48000, 2, avl::sound::BiquadFilter::HIGH_PASS, 1000.0f));
+		engine.MixFrames(&mix[0], 4800);
+		// The filter lets the start through and then removes the constant.
+		ASSERT(mix[0] > 0.4f);
+		ASSERT(std::abs(mix[4799 * 2] - 0.25f) < 1e-3f && std::abs(mix[4799 * 2 + 1] - 0.25f) < 1e-3f);
+		engine.ClearBusEffects(1);
+		engine.MixFrames(&mix[0], 100);
+		ASSERT(IsEveryFrame(mix, 0, 100, 0.5f));
+
+		// A limiter on the master bus holds the sum of three voices down.
+		list.push_back(&loud);
+		engine.UpdateSounds(list);
+		const std::shared_ptr<avl::sound::Limiter> limiter = std::make_shared<avl::sound::Limiter>(48000, 2, 0.5f);
+		engine.AddBusEffect(SoundEffect::MASTER_BUS, limiter);
+		engine.MixFrames(&mix[0], 4800);
+		ASSERT(IsEveryFrame(mix, 0, limiter->GetLatency(), 0.0f));
+		for(std::size_t i = 0; i < 4800 * 2; ++i)
+		{
+			ASSERT(mix[i] <= 0.5f * 1.00001f);
+		}
+		ASSERT(std::abs(mix[4799 * 2] - 0.5f) < 1e-5f);
+		engine.ClearBusEffects(SoundEffect::MASTER_BUS);
+		engine.MixFrames(&mix[0], 100);
+		ASSERT(IsEveryFrame(mix, 0, 100, 0.75f));
+
+		// Effects must match the engine's format.
+		unsigned int refused_count = 0;
+		try { engine.AddBusEffect(1, std::shared_ptr<avl::sound::DSPEffect>()); } catch(const avl::utility::InvalidArgumentException&) { ++refused_count; }
+		try { engine.AddBusEffect(1, std::make_shared<avl::sound::Limiter>(48000, 1)); } catch(const avl::utility::InvalidArgumentException&) { ++refused_count; }
+		try { engine.AddBusEffect(1, std::make_shared<avl::sound::Limiter>(44100, 2)); } catch(const avl::utility::InvalidArgumentException&) { ++refused_count; }
+		ASSERT(refused_count == 3);
+		filtered.Stop();
+		plain.Stop();
+		loud.Stop();
+		engine.UpdateSounds(list);
+		std::cout << "Buses are processed by their effects.\n";
+	}
+
+	// Pausing keeps a voice's place.
+	std::vector<short> ramp(4800);
+	for(std::size_t i = 0; i < ramp.size(); ++i)
+	{
+		ramp[i] = static_cast<short>(i * 4);
+	}
+	const SoundEffect::SoundHandle ramp_48k = engine.AddSound(MakeSample(ramp, 48000, 1));
+	{
+		SoundEffect effect(ramp_48k);
+		effect.Play();
+		SoundEffectList list(1, &effect);
+		engine.UpdateSounds(list);
+		engine.MixFrames(&mix[0], 100);
+		effect.Pause();
+		engine.UpdateSounds(list);
+		engine.MixFrames(&mix[0], 100);
+		ASSERT(IsEveryFrame(mix, 0, 100, 0.0f));
+		effect.Play();
+		engine.UpdateSounds(list);
+		engine.MixFrames(&mix[0], 100);
+		ASSERT(mix[0] == 400.0f / 32768.0f && mix[199] == 796.0f / 32768.0f);
+		effect.Stop();
+		engine.UpdateSounds(list);
+		std::cout << "Paused voices resume where they left off.\n";
+	}
+
+	// Sounds at other rates are resampled with linear interpolation.
+	const SoundEffect::SoundHandle ramp_24k = engine.AddSound(MakeSample(ramp, 24000, 1));
+	{
+		SoundEffect effect(ramp_24k);
+		effect.Play();
+		SoundEffectList list(1, &effect);
+		engine.UpdateSounds(list);
+		engine.MixFrames(&mix[0], 9600);
+		for(std::size_t frame = 0; frame < 9598; ++frame)
+		{
+			ASSERT(std::fabs(mix[frame * 2] - frame * 2.0f / 32768.0f) < 1e-6f);
+		}
+		// The last frame fades towards silence, since the sound doesn't loop.
+		ASSERT(std::fabs(mix[9599 * 2] - ramp.back() * 0.5f / 32768.0f) < 1e-6f);
+		engine.UpdateSounds(list);
+		ASSERT(effect.IsPlaying() == false && engine.GetPlayingVoiceCount() == 0);
+		std::cout << "Other sample rates are resampled.\n";
+	}
+
+	// Voices add up, and the mix saturates when written to a WAV file.
+	{
+		SoundEffect first(constant);
+		SoundEffect second(constant);
+		SoundEffect third(constant);
+		first.Play();
+		second.Play();
+		third.Play();
+		SoundEffectList list;
+		list.push_back(&first);
+		list.push_back(&second);
+		list.push_back(&third);
+		engine.UpdateSounds(list);
+		{
+			WAVFileSink sink("assets/software sound engine.wav", 48000, 2);
+			engine.RenderFrames(sink, 1200);
+			sink.Close();
+			ASSERT(sink.GetFrameCount() == 1200);
+		}
+		SoundSample written = LoadWAVFile("assets/software sound engine.wav");
+		ASSERT(written.GetBitDepth() == 16 && written.GetNumberOfChannels() == 2 && written.GetFrequency() == 48000);
+		ASSERT(written.GetDataSize() == 1200 * 4);
+		const short* const pcm = reinterpret_cast<const short*>(written.GetAudioData());
+		ASSERT(pcm[0] == 32767 && pcm[1] == 32767 && pcm[999 * 2] == 32767 && pcm[1000 * 2] == 0);
+		engine.UpdateSounds(list);
+		ASSERT(engine.GetPlayingVoiceCount() == 0);
+		std::cout << "The mix is written to WAV files.\n";
+	}
+
+	// Streaming a file mixes exactly like loading it, looping or not.
+	{
+		std::vector<float> samples(5000 * 2);
+		for(std::size_t i = 0; i < samples.size(); ++i)
+		{
+			samples[i] = static_cast<float>(i % 1000) / 1000.0f - 0.5f;
+		}
+		{
+			WAVFileSink sink("assets/software sound engine stream.wav", 44100, 2);
+			sink.WriteFrames(&samples[0], 5000, 2);
+			sink.Close();
+		}
+		SoftwareSoundEngine stream_engine(48000, 2);
+		const SoundEffect::SoundHandle loaded = engine.AddSound(LoadWAVFile("assets/software sound engine stream.wav"));
+		const SoundEffect::SoundHandle streamed = stream_engine.AddStream("assets/software sound engine stream.wav");
+		std::vector<float> stream_mix(mix.size());
+		for(unsigned int pass = 0; pass < 2; ++pass)
+		{
+			SoundEffect loaded_effect(loaded);
+			SoundEffect streamed_effect(streamed);
+			loaded_effect.Loop(pass == 1);
+			streamed_effect.Loop(pass == 1);
+			loaded_effect.Play();
+			streamed_effect.Play();
+			SoundEffectList loaded_list(1, &loaded_effect);
+			SoundEffectList streamed_list(1, &streamed_effect);
+			engine.UpdateSounds(loaded_list);
+			stream_engine.UpdateSounds(streamed_list);
+			// Mix in real time, 10 ms at a time, so that the reader keeps up as it would with
+			// an audio device.
+			Sleep(50);
+			for(unsigned int block = 0; block < 40; ++block)
+			{
+				Sleep(10);
+				engine.MixFrames(&mix[0], 480);
+				stream_engine.MixFrames(&stream_mix[0], 480);
+				ASSERT(memcmp(&mix[0], &stream_mix[0], 480 * 2 * sizeof(float)) == 0);
+			}
+			engine.UpdateSounds(loaded_list);
+			stream_engine.UpdateSounds(streamed_list);
+			ASSERT(streamed_effect.IsPlaying() == loaded_effect.IsPlaying() && streamed_effect.IsPlaying() == (pass == 1));
+			loaded_effect.Stop();
+			streamed_effect.Stop();
+			engine.UpdateSounds(loaded_list);
+			stream_engine.UpdateSounds(streamed_list);
+		}
+		ASSERT(stream_engine.GetUnderrunCount() == 0);
+
+		// Only one effect plays a stream at a time.
+		SoundEffect first(streamed);
+		SoundEffect second(streamed);
+		SoundEffectList list;
+		list.push_back(&first);
+		list.push_back(&second);
+		first.Play();
+		stream_engine.UpdateSounds(list);
+		second.Play();
+		stream_engine.UpdateSounds(list);
+		ASSERT(first.IsPlaying() == false && second.IsPlaying() == true && stream_engine.GetPlayingVoiceCount() == 1);
+		std::cout << "Streams mix like the sounds they stream.\n";
+	}
+
+	// ADPCM sounds mix exactly like the sounds they decode to, looping or not. The blocks are
+	// small, so that each block of the mix crosses several of them.
+	{
+		std::vector<short> tone(3000 * 2);
+		for(std::size_t i = 0; i < tone.size(); ++i)
+		{
+			tone[i] = static_cast<short>(std::sin(i * 0.01) * 20000.0);
+		}
+		const SoundSample::Encoding encodings[] = {SoundSample::IMA_ADPCM, SoundSample::MS_ADPCM};
+		for(unsigned int encoding = 0; encoding < 2; ++encoding)
+		{
+			SoftwareSoundEngine compressed_engine(48000, 2);
+			SoftwareSoundEngine decoded_engine(48000, 2);
+			const SoundSample compressed = EncodeADPCM(encodings[encoding], &tone[0], 3000, 2, 44100, 64);
+			const SoundEffect::SoundHandle compressed_handle = compressed_engine.AddSound(compressed);
+			const SoundEffect::SoundHandle decoded_handle = decoded_engine.AddSound(DecodeADPCMSample(compressed));
+			std::vector<float> decoded_mix(mix.size());
+			for(unsigned int pass = 0; pass < 2; ++pass)
+			{
+				SoundEffect compressed_effect(compressed_handle);
+				SoundEffect decoded_effect(decoded_handle);
+				compressed_effect.Loop(pass == 1);
+				decoded_effect.Loop(pass == 1);
+				compressed_effect.Play();
+				decoded_effect.Play();
+				SoundEffectList compressed_list(1, &compressed_effect);
+				SoundEffectList decoded_list(1, &decoded_effect);
+				compressed_engine.UpdateSounds(compressed_list);
+				decoded_engine.UpdateSounds(decoded_list);
+				for(unsigned int block = 0; block < 20; ++block)
+				{
+					compressed_engine.MixFrames(&mix[0], 480);
+					decoded_engine.MixFrames(&decoded_mix[0], 480);
+					ASSERT(memcmp(&mix[0], &decoded_mix[0], 480 * 2 * sizeof(float)) == 0);
+				}
+				compressed_engine.UpdateSounds(compressed_list);
+				ASSERT(compressed_effect.IsPlaying() == (pass == 1));
+			}
+		}
+		std::cout << "ADPCM sounds mix like the sounds they decode to.\n";
+	}
+
+	// Only the most audible voices are mixed. The rest are virtualized, and carry on from
+	// exactly where they would have been once they're mixed again.
+	{
+		std::vector<short> tone(3000 * 2);
+		for(std::size_t i = 0; i < tone.size(); ++i)
+		{
+			tone[i] = static_cast<short>(std::sin(i * 0.01) * 20000.0);
+		}
+		SoftwareSoundEngine capped_engine(48000, 2, 1);
+		SoftwareSoundEngine reference_engine(48000, 2);
+		const SoundSample compressed = EncodeADPCM(SoundSample::IMA_ADPCM, &tone[0], 3000, 2, 44100, 64);
+		const SoundEffect::SoundHandle capped_tone = capped_engine.AddSound(compressed);
+		const SoundEffect::SoundHandle capped_constant = capped_engine.AddSound(MakeSample(std::vector<short>(1000, 16384), 48000, 1));
+		const SoundEffect::SoundHandle reference_tone = reference_engine.AddSound(compressed);
+		SoundEffect quiet(capped_tone);
+		SoundEffect loud(capped_constant);
+		SoundEffect reference(reference_tone);
+		quiet.SetVolume(0.5f);
+		reference.SetVolume(0.5f);
+		quiet.Loop(true);
+		loud.Loop(true);
+		reference.Loop(true);
+		quiet.Play();
+		reference.Play();
+		SoundEffectList capped_list(1, &quiet);
+		capped_list.push_back(&loud);
+		SoundEffectList reference_list(1, &reference);
+		capped_engine.UpdateSounds(capped_list);
+		reference_engine.UpdateSounds(reference_list);
+		std::vector<float> reference_mix(mix.size());
+		capped_engine.MixFrames(&mix[0], 480);
+		reference_engine.MixFrames(&reference_mix[0], 480);
+		ASSERT(memcmp(&mix[0], &reference_mix[0], 480 * 2 * sizeof(float)) == 0);
+
+		// The louder effect takes the voice.
+		loud.Play();
+		capped_engine.UpdateSounds(capped_list);
+		avl::sound::VoiceStatistics statistics = capped_engine.GetVoiceStatistics();
+		ASSERT(statistics.real_voice_count == 1 && statistics.virtual_voice_count == 1 && statistics.promoted_count == 0 && statistics.demoted_count == 1);
+		ASSERT(capped_engine.GetPlayingVoiceCount() == 1);
+		for(unsigned int block = 0; block < 7; ++block)
+		{
+			capped_engine.MixFrames(&mix[0], 480);
+			reference_engine.MixFrames(&reference_mix[0], 480);
+			ASSERT(IsEveryFrame(mix, 0, 480, 0.5f));
+		}
+
+		// A higher priority outranks a louder volume, and the quieter effect picks up where it
+		// would have been.
+		quiet.SetPriority(1);
+		capped_engine.UpdateSounds(capped_list);
+		statistics = capped_engine.GetVoiceStatistics();
+		ASSERT(statistics.real_voice_count == 1 && statistics.virtual_voice_count == 1 && statistics.promoted_count == 1 && statistics.demoted_count == 1);
+		for(unsigned int block = 0; block < 7; ++block)
+		{
+			capped_engine.MixFrames(&mix[0], 480);
+			reference_engine.MixFrames(&reference_mix[0], 480);
+			ASSERT(memcmp(&mix[0], &reference_mix[0], 480 * 2 * sizeof(float)) == 0);
+		}
+		loud.Stop();
+		capped_engine.UpdateSounds(capped_list);
+		statistics = capped_engine.GetVoiceStatistics();
+		ASSERT(statistics.real_voice_count == 1 && statistics.virtual_voice_count == 0 && statistics.promoted_count == 0 && statistics.demoted_count == 0);
+
+		// Virtual voices which don't loop finish on time.
+		SoundEffect once(capped_constant);
+		once.Play();
+		capped_list.push_back(&once);
+		capped_engine.UpdateSounds(capped_list);
+		ASSERT(capped_engine.GetVoiceStatistics().virtual_voice_count == 1);
+		capped_engine.MixFrames(&mix[0], 999);
+		capped_engine.UpdateSounds(capped_list);
+		ASSERT(once.IsPlaying() == true);
+		capped_engine.MixFrames(&mix[0], 1);
+		capped_engine.UpdateSounds(capped_list);
+		ASSERT(once.IsPlaying() == false && capped_engine.GetVoiceStatistics().virtual_voice_count == 0);
+		std::cout << "The least audible voices are virtualized, and keep their place.\n";
+
+		// A thousand looping voices, of which the default 64 are mixed.
+		SoftwareSoundEngine crowded_engine(48000, 2);
+		const SoundEffect::SoundHandle crowded_tone = crowded_engine.AddSound(compressed);
+		std::vector<SoundEffect> effects(1000, SoundEffect(crowded_tone));
+		SoundEffectList list;
+		for(unsigned int i = 0; i < effects.size(); ++i)
+		{
+			effects[i].Loop(true);
+			effects[i].SetVolume((i % 100) / 100.0f);
+			effects[i].Play();
+			list.push_back(&effects[i]);
+		}
+		const Timer timer;
+		// A second of audio, updated every 10 ms.
+		for(unsigned int block = 0; block < 100; ++block)
+		{
+			crowded_engine.UpdateSounds(list);
+			crowded_engine.MixFrames(&mix[0], 480);
+		}
+		const double time = timer.Elapsed();
+		statistics = crowded_engine.GetVoiceStatistics();
+		ASSERT(statistics.real_voice_count == 64 && statistics.virtual_voice_count == 936);
+		std::cout << "  Milliseconds to update and mix a second of 1000 voices, 64 of them real: " << time * 1000.0 << "\n";
+	}
+
+	// The cost of mixing, per voice per millisecond of audio.
+	{
+		std::vector<short> noise(48000 * 2);
+		for(std::size_t i = 0; i < noise.size(); ++i)
+		{
+			noise[i] = static_cast<short>(rand() - RAND_MAX / 2);
+		}
+		const SoundEffect::SoundHandle stereo_48k = engine.AddSound(MakeSample(noise, 48000, 2));
+		const SoundEffect::SoundHandle mono_48k = engine.AddSound(MakeSample(noise, 48000, 1));
+		const SoundEffect::SoundHandle stereo_44k = engine.AddSound(MakeSample(noise, 44100, 2));
+		const SoundEffect::SoundHandle ima_44k = engine.AddSound(EncodeADPCM(SoundSample::IMA_ADPCM, &noise[0], 48000, 2, 44100, 2048));
+		const SoundEffect::SoundHandle handles[] = {stereo_48k, mono_48k, stereo_44k, ima_44k};
+		const char* const names[] = {"16-bit stereo 48 kHz  ", "16-bit mono 48 kHz    ", "16-bit stereo 44.1 kHz", "IMA stereo 44.1 kHz   "};
+		const unsigned int voice_count = 64;
+		std::cout << "Microseconds per voice per millisecond of 48 kHz stereo:\n";
+		for(unsigned int kind = 0; kind < 4; ++kind)
+		{
+			std::vector<SoundEffect> effects(voice_count, SoundEffect(handles[kind]));
+			SoundEffectList list;
+			for(unsigned int i = 0; i < voice_count; ++i)
+			{
+				effects[i].Loop(true);
+				effects[i].Play();
+				list.push_back(&effects[i]);
+			}
+			engine.UpdateSounds(list);
+			const Timer timer;
+			// A second of audio, in 10 ms blocks.
+			for(unsigned int block = 0; block < 100; ++block)
+			{
+				engine.MixFrames(&mix[0], 480);
+			}
+			const double time = timer.Elapsed();
+			std::cout << "  " << names[kind] << " " << time * 1000000.0 / (voice_count * 1000.0) << "\n";
+			for(unsigned int i = 0; i < voice_count; ++i)
+			{
+				effects[i].Stop();
+			}
+			engine.UpdateSounds(list);
+		}
+	}
+
+	system("pause");
+}
+
+
+
+// Anonymous namespace.
+namespace
+{
+	/** Creates a 16-bit sample.
+	@param samples The samples, interleaved.
+	@param frequency The number of frames per second.
+	@param channel_count The number of channels.
+	@return The sample.
+	*/
+	SoundSample MakeSample(const std::vector<short>& samples, const unsigned int frequency, const unsigned int channel_count)
+	{
+		char* const data = new char[samples.size() * 2];
+		memcpy(data, &samples[0], samples.size() * 2);
+		return SoundSample(16, frequency, channel_count, samples.size() * 2, data);
+	}
+
+
+
+	/** Checks that both channels of a range of stereo frames have a value.
+	@param mix The stereo frames.
+	@param first The first frame to check.
+	@param last One past the last frame to check.
+	@param value The expected value.
+	@return True if every sample is \a value.
+	*/
+	const bool IsEveryFrame(const std::vector<float>& mix, const std::size_t first, const std::size_t last, const float value)
+	{
+		for(std::size_t i = first * 2; i < last * 2; ++i)
+		{
+			if(mix[i] != value)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
@@ -22,6 +22,7 @@ Implementation for the sound engine component. See "sound engine.h" for details.
 */
 
 #include"sound engine.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
 
 
 namespace avl
@@ -31,6 +32,8 @@ namespace sound
 	// See method declaration for details.
 	SoundEngine::SoundEngine()
 	{
+		const Attenuation default_attenuation = {1.0f, 1000.0f, 0.001f};
+		attenuation = default_attenuation;
 	}
 
 	// See method declaration for details.
@@ -38,6 +41,56 @@ namespace sound
 	{
 	}
 
+	// See method declaration for details.
+	const bool SoundEngine::IsPlayingADPCM() const
+	{
+		return false;
+	}
+
+	// See method declaration for details.
+	void SoundEngine::SetListenerPosition(const utility::Vector& position)
+	{
+		listener_position = position;
+	}
+
+	// See method declaration for details.
+	const utility::Vector& SoundEngine::GetListenerPosition() const
+	{
+		return listener_position;
+	}
+
+	// See method declaration for details.
+	void SoundEngine::SetAttenuation(const Attenuation& new_attenuation)
+	{
+		if(Spatializer::IsValidAttenuation(new_attenuation) == false)
+		{
+			throw utility::InvalidArgumentException("avl::sound::SoundEngine::SetAttenuation()", "new_attenuation",
+				"The reference distance must be greater than 0 and at most the maximum distance, and the audibility threshold at least 0.");
+		}
+		attenuation = new_attenuation;
+	}
+
+	// See method declaration for details.
+	const Attenuation& SoundEngine::GetAttenuation() const
+	{
+		return attenuation;
+	}
+
+	// See method declaration for details.
+	const bool SoundEngine::IsMoreAudible(const VoiceRank& rank, const VoiceRank& other_rank)
+	{
+		if(rank.priority != other_rank.priority)
+		{
+			return rank.priority > other_rank.priority;
+		}
+		if(rank.volume != other_rank.volume)
+		{
+			return rank.volume > other_rank.volume;
+		}
+		// Start orders wrap around, so compare their difference.
+		return static_cast<int>(rank.start_order - other_rank.start_order) > 0;
+	}
+
 
 } // sound
 } // avl
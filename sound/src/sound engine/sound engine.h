@@ -25,7 +25,10 @@ Defines the \ref avl::sound::SoundEngine interface.
 */
 
 #include"..\sound sample\sound sample.h"
+#include"..\spatialization\spatialization.h"
 #include"..\..\..\utility\src\sound effect\sound effect.h"
+#include"..\..\..\utility\src\vector\vector.h"
+#include<string>
 
 
 namespace avl
@@ -33,9 +36,32 @@ namespace avl
 namespace sound
 {
 
+	/**
+	Counts a sound engine's real and virtual voices. When more sound effects play than an
+	engine has voices for, only the most audible get real voices, which are heard. The rest
+	get virtual voices, which just keep track of where they would be, so that they carry on
+	from there if they become audible enough to be given real voices again.
+	*/
+	struct VoiceStatistics
+	{
+		/// The number of sound effects with real voices.
+		unsigned int real_voice_count;
+		/// The number of sound effects with virtual voices.
+		unsigned int virtual_voice_count;
+		/// The number of sound effects given real voices in place of virtual ones.
+		unsigned int promoted_count;
+		/// The number of sound effects given virtual voices in place of real ones.
+		unsigned int demoted_count;
+	};
+
 	/**
 	Provides an interface for submitting audio data to an audio device and
 	accessing that audio data via a handle.
+	@par Positional audio:
+	Sound effects with positions (see utility::SoundEffect::SetPosition()) are heard from
+	the listener's position: they're attenuated by their distance from it and panned to
+	the side which they're on, as a \ref Spatializer does it, each time the sounds are
+	updated. Those too quiet to be heard aren't mixed at all.
 	*/
 	class SoundEngine
 	{
@@ -55,6 +81,25 @@ namespace sound
 		*/
 		virtual const utility::SoundEffect::SoundHandle AddSound(const sound::SoundSample& new_sample) = 0;
 
+		/** Tells whether samples compressed with ADPCM are kept compressed once added, and
+		decoded as they play. If not, the engine decodes them once, when they're added.
+		Safe to call from any thread.
+		@return True if the engine plays ADPCM samples as they are. The default is false.
+		*/
+		virtual const bool IsPlayingADPCM() const;
+
+		/** Makes it possible to play the WAV file named \a file_name using the returned sound
+		handle. Rather than being loaded all at once, the file is read a chunk at a time as it
+		plays (see \ref avl::sound::SoundStream), which suits long sounds such as music.
+		@note A stream has a single read position, so only one sound effect may play it at a
+		time. An effect which starts playing a stream takes it over from any other effect
+		playing it, and that effect is paused.
+		@param file_name The name of the WAV file to be streamed.
+		@return The sound handle by which the stream is to be accessed. It's deleted or
+		cleared like any other sound handle.
+		*/
+		virtual const utility::SoundEffect::SoundHandle AddStream(const std::string& file_name) = 0;
+
 		/** Removes the sound sample associated with \a handle from memory, making
 		it no longer accessible.
 		@post Don't try playing any sounds whose sound handles have been deleted.
@@ -75,6 +120,63 @@ namespace sound
 		*/
 		virtual void UpdateSounds(utility::SoundEffectList& sound_effects) = 0;
 
+		/** Counts the real and virtual voices as of the last call to UpdateSounds().
+		@return The counts. The promoted and demoted counts are for that call alone.
+		*/
+		virtual const VoiceStatistics GetVoiceStatistics() const = 0;
+
+		/** Moves the listener, which positional sound effects are heard from. Takes effect
+		the next time the sounds are updated.
+		@param position The listener's new position. It starts out at the origin.
+		*/
+		virtual void SetListenerPosition(const utility::Vector& position);
+
+		/** Accesses the listener's position.
+		@return The position last set by SetListenerPosition().
+		*/
+		const utility::Vector& GetListenerPosition() const;
+
+		/** Changes how positional sound effects fade with distance. Takes effect the next
+		time the sounds are updated.
+		@param new_attenuation The attenuation. It starts out with a reference distance of 1,
+		a maximum distance of 1000, and an audibility threshold of 0.001 (-60 dB).
+		@throws InvalidArgumentException If \a new_attenuation isn't valid; see
+		\ref Spatializer::IsValidAttenuation().
+		*/
+		virtual void SetAttenuation(const Attenuation& new_attenuation);
+
+		/** Accesses how positional sound effects fade with distance.
+		@return The attenuation last set by SetAttenuation().
+		*/
+		const Attenuation& GetAttenuation() const;
+
+	protected:
+		/**
+		What a playing sound effect is ranked by when deciding which effects get real voices.
+		*/
+		struct VoiceRank
+		{
+			/// The priority of the sound effect.
+			unsigned int priority;
+			/// The volume of the sound effect.
+			float volume;
+			/// Counts up each time a sound effect starts playing, so that later starts rank higher.
+			unsigned int start_order;
+		};
+
+		/** Ranks two playing sound effects by how much they deserve a real voice: by priority,
+		then by volume, then by which started playing more recently.
+		@param rank The rank of one sound effect.
+		@param other_rank The rank of the other.
+		@return True if \a rank is the more audible of the two.
+		*/
+		static const bool IsMoreAudible(const VoiceRank& rank, const VoiceRank& other_rank);
+
+	private:
+		/// Where positional sound effects are heard from.
+		utility::Vector listener_position;
+		/// How positional sound effects fade with distance.
+		Attenuation attenuation;
 	};
 
 
@@ -0,0 +1,92 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the sound job component. See "sound job.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"sound job.h"
+#include"..\load wav file\load wav file.h"
+#include"..\sound engine\sound engine.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include<string>
+#include<memory>
+#include<new>
+
+
+namespace avl
+{
+namespace sound
+{
+
+	// See method declaration for details.
+	SoundJob::SoundJob(const std::string& file_name, SoundEngine& engine, const Priority priority)
+		: AssetJob(priority), file_name(file_name), engine(engine), is_normalizing(false), format(), handle(0)
+	{
+	}
+
+	// See method declaration for details.
+	SoundJob::SoundJob(const std::string& file_name, SoundEngine& engine, const SampleFormat& format, const Priority priority)
+		: AssetJob(priority), file_name(file_name), engine(engine), is_normalizing(true), format(format), handle(0)
+	{
+	}
+
+	// See method declaration for details.
+	SoundJob::~SoundJob()
+	{
+	}
+
+	// See method declaration for details.
+	const utility::SoundEffect::SoundHandle SoundJob::GetHandle() const
+	{
+		ASSERT(IsDone() == true && HasFailed() == false);
+		return handle;
+	}
+
+	// See method declaration for details.
+	void SoundJob::Load()
+	{
+		// Copying a SoundSample shares its audio data rather than duplicating it. ADPCM is
+		// decoded here, off the owning thread, unless the engine plays it compressed.
+		if(is_normalizing == true)
+		{
+			sample.reset(new(std::nothrow) SoundSample(NormalizeSoundSample(LoadWAVFile(file_name), format)));
+		}
+		else
+		{
+			sample.reset(new(std::nothrow) SoundSample(LoadWAVFile(file_name, engine.IsPlayingADPCM() == false)));
+		}
+		if(sample == nullptr)
+		{
+			throw utility::OutOfMemoryError();
+		}
+	}
+
+	// See method declaration for details.
+	void SoundJob::Finish()
+	{
+		handle = engine.AddSound(*sample);
+		sample.reset();
+	}
+
+
+
+} // sound
+} // avl
@@ -0,0 +1,109 @@
+#pragma once
+#ifndef AVL_SOUND_SOUND_JOB__
+#define AVL_SOUND_SOUND_JOB__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Defines the \ref avl::sound::SoundJob class.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"..\sound engine\sound engine.h"
+#include"..\sound sample\sound sample.h"
+#include"..\normalize sample\normalize sample.h"
+#include"..\..\..\utility\src\asset loader\asset loader.h"
+#include"..\..\..\utility\src\sound effect\sound effect.h"
+#include<string>
+#include<memory>
+
+
+namespace avl
+{
+namespace sound
+{
+	/**
+	Loads a WAV file on an AssetLoader worker and then adds it to a SoundEngine
+	on the owning thread.
+	*/
+	class SoundJob: public utility::AssetJob
+	{
+	public:
+		/** Basic constructor.
+		@param file_name The name of the WAV file to load.
+		@param engine The sound engine which the sound will be added to. Must outlive the job.
+		@param priority How urgently the sound is needed.
+		*/
+		SoundJob(const std::string& file_name, SoundEngine& engine, const Priority priority = NORMAL);
+		/** Constructs a job which also normalizes the sound, on the worker, before it's added.
+		@param file_name The name of the WAV file to load.
+		@param engine The sound engine which the sound will be added to. Must outlive the job.
+		@param format The format to normalize the sound to. See NormalizeSoundSample().
+		@param priority How urgently the sound is needed.
+		*/
+		SoundJob(const std::string& file_name, SoundEngine& engine, const SampleFormat& format, const Priority priority = NORMAL);
+		/** Basic destructor.*/
+		~SoundJob();
+
+		/** Accesses the handle of the loaded sound.
+		@pre The job is done and didn't fail.
+		@return The handle which the sound engine issued for the sound.
+		*/
+		const utility::SoundEffect::SoundHandle GetHandle() const;
+
+	protected:
+		/** Loads and decodes the WAV file, and normalizes it if the job was asked to. ADPCM
+		stays compressed if the job doesn't normalize and the engine plays ADPCM; see
+		SoundEngine::IsPlayingADPCM().
+		@throws FileNotFoundException If the file doesn't exist.
+		@throws FileFormatException If the file isn't a supported WAV file.
+		@throws InvalidArgumentException If the sound can't be normalized.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		void Load();
+
+		/** Adds the decoded sample to the sound engine and frees it.
+		@throws Exception If the sound engine can't add the sound.
+		*/
+		void Finish();
+
+	private:
+		/// The name of the WAV file.
+		const std::string file_name;
+		/// The sound engine which the sound will be added to.
+		SoundEngine& engine;
+		/// Is the sound normalized to \ref format?
+		const bool is_normalizing;
+		/// The format to normalize the sound to.
+		const SampleFormat format;
+		/// The decoded sample, between Load() and Finish().
+		std::unique_ptr<SoundSample> sample;
+		/// The handle issued by the sound engine.
+		utility::SoundEffect::SoundHandle handle;
+
+		/// NOT IMPLEMENTED.
+		SoundJob(const SoundJob&);
+		/// NOT IMPLEMENTED.
+		const SoundJob& operator=(const SoundJob&);
+	};
+
+
+
+} // sound
+} // avl
+#endif // AVL_SOUND_SOUND_JOB__
@@ -22,7 +22,10 @@ Implementation for the sound sample component. See "sound sample.h" for details.
 */
 
 #include"sound sample.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\assert\assert.h"
 #include<cstddef>
+#include<new>
 
 
 namespace avl
@@ -31,18 +34,55 @@ namespace sound
 {
 	// See method declaration for details.
 	SoundSample::SoundSample(const unsigned short& depth, const unsigned int frequency, const unsigned int num_channels, const std::size_t size, const char* const data)
-		: bit_depth(depth), sampling_frequency(frequency), number_of_channels(num_channels), data_size(size), audio_data(data)
+		: bit_depth(depth), sampling_frequency(frequency), number_of_channels(num_channels), data_size(size), encoding(PCM),
+		block_alignment(static_cast<unsigned short>(num_channels * (depth / 8))), frame_count((block_alignment != 0) ? size / block_alignment : 0)
 	{
+		try
+		{
+			audio_data.reset(data, std::default_delete<const char[]>());
+		}
+		catch(const std::bad_alloc&)
+		{
+			// The reference count couldn't be allocated, and reset() has already deleted data.
+			throw utility::OutOfMemoryError();
+		}
 	}
 
 	// See method declaration for details.
-	SoundSample::SoundSample(SoundSample& original)
-		: bit_depth(original.bit_depth), sampling_frequency(original.sampling_frequency), number_of_channels(original.number_of_channels), data_size(original.data_size), audio_data(original.audio_data.release())
+	SoundSample::SoundSample(const unsigned short& depth, const unsigned int frequency, const unsigned int num_channels, const std::size_t size, const std::shared_ptr<const char>& data)
+		: bit_depth(depth), sampling_frequency(frequency), number_of_channels(num_channels), data_size(size), audio_data(data), encoding(PCM),
+		block_alignment(static_cast<unsigned short>(num_channels * (depth / 8))), frame_count((block_alignment != 0) ? size / block_alignment : 0)
 	{
-		original.bit_depth = 0;
-		original.sampling_frequency = 0;
-		original.number_of_channels = 0;
-		original.data_size = 0;
+	}
+
+	// See method declaration for details.
+	SoundSample::SoundSample(const Encoding encoding, const unsigned int frequency, const unsigned int num_channels, const unsigned short block_alignment,
+		const std::size_t frame_count, const std::size_t size, const std::shared_ptr<const char>& data)
+		: bit_depth(4), sampling_frequency(frequency), number_of_channels(num_channels), data_size(size), audio_data(data),
+		encoding(encoding), block_alignment(block_alignment), frame_count(frame_count)
+	{
+		ASSERT(encoding != PCM);
+	}
+
+	// See method declaration for details.
+	SoundSample::SoundSample(const SoundSample& original)
+		: bit_depth(original.bit_depth), sampling_frequency(original.sampling_frequency), number_of_channels(original.number_of_channels), data_size(original.data_size), audio_data(original.audio_data),
+		encoding(original.encoding), block_alignment(original.block_alignment), frame_count(original.frame_count)
+	{
+	}
+
+	// See method declaration for details.
+	SoundSample& SoundSample::operator=(const SoundSample& original)
+	{
+		bit_depth = original.bit_depth;
+		sampling_frequency = original.sampling_frequency;
+		number_of_channels = original.number_of_channels;
+		data_size = original.data_size;
+		audio_data = original.audio_data;
+		encoding = original.encoding;
+		block_alignment = original.block_alignment;
+		frame_count = original.frame_count;
+		return *this;
 	}
 		
 	// See method declaration for details.
@@ -80,6 +120,30 @@ namespace sound
 		return audio_data.get();
 	}
 
+	// See method declaration for details.
+	const std::shared_ptr<const char>& SoundSample::ShareAudioData() const
+	{
+		return audio_data;
+	}
+
+	// See method declaration for details.
+	const SoundSample::Encoding SoundSample::GetEncoding() const
+	{
+		return encoding;
+	}
+
+	// See method declaration for details.
+	const unsigned short SoundSample::GetBlockAlignment() const
+	{
+		return block_alignment;
+	}
+
+	// See method declaration for details.
+	const std::size_t SoundSample::GetFrameCount() const
+	{
+		return frame_count;
+	}
+
 
 
 
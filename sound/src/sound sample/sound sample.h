@@ -33,30 +33,75 @@ namespace sound
 {
 	/**
 	Contains the data necessary to play a Pulse-Code Modulation sound
-	sample.
+	sample, or one compressed with ADPCM (see "adpcm.h").
+	@par Sharing:
+	The audio data is immutable and reference counted. Copying a sample
+	shares its audio data rather than duplicating it, and the audio data
+	may point straight into a mapped file or pack file entry (see
+	\ref LoadWAVFile()), which is kept open for as long as any sample
+	shares it.
 	*/
 	class SoundSample
 	{
 	public:
-		/** Full-spec constructor.
+		/** The ways in which the audio data may be encoded.
+		*/
+		enum Encoding
+		{
+			/// Uncompressed PCM samples.
+			PCM,
+			/// Blocks of 4-bit IMA ADPCM.
+			IMA_ADPCM,
+			/// Blocks of 4-bit Microsoft ADPCM, with the standard coefficients.
+			MS_ADPCM
+		};
+
+		/** Full-spec constructor for PCM; takes ownership of \a data.
 		@param depth The bit depth of each sample.
 		@param frequency The number of samples per second.
 		@param num_channels The number of audio channels.
 		@param size The size of the audio data in bytes.
-		@param data The audio data.
+		@param data The audio data, which must have been allocated with
+		new[]. It is deleted once no sample shares it.
 		*/
 		SoundSample(const unsigned short& depth, const unsigned int frequency, const unsigned int num_channels, const std::size_t size, const char data[]);
+
+		/** Full-spec constructor for PCM; shares \a data.
+		@param depth The bit depth of each sample.
+		@param frequency The number of samples per second.
+		@param num_channels The number of audio channels.
+		@param size The size of the audio data in bytes.
+		@param data The audio data, which must not be modified while it is
+		shared.
+		*/
+		SoundSample(const unsigned short& depth, const unsigned int frequency, const unsigned int num_channels, const std::size_t size, const std::shared_ptr<const char>& data);
+
+		/** Full-spec constructor for compressed audio data; shares \a data.
+		The bit depth of a compressed sample is that of its encoded samples.
+		@param encoding How the audio data is encoded; anything but PCM.
+		@param frequency The number of samples per second.
+		@param num_channels The number of audio channels.
+		@param block_alignment The size of each block of audio data in bytes.
+		The last block may be shorter.
+		@param frame_count The number of frames which the audio data decodes to.
+		@param size The size of the audio data in bytes.
+		@param data The audio data, which must not be modified while it is
+		shared.
+		*/
+		SoundSample(const Encoding encoding, const unsigned int frequency, const unsigned int num_channels, const unsigned short block_alignment,
+			const std::size_t frame_count, const std::size_t size, const std::shared_ptr<const char>& data);
 		
-		/** Copy constructor; transfers ownership of the audio data from
-		\a original to the new sample.
-		@attention Ownership of the data which \a original contained is
-		transferred to the newly constructed object.
-		@post The audio data of \a original is set to nullptr and each other
-		property is set to zero.
-		@param original The object being copied and which loses ownership
-		of the audio data.
+		/** Copy constructor; shares the audio data of \a original.
+		@param original The object being copied.
 		*/
-		SoundSample(SoundSample& original);
+		SoundSample(const SoundSample& original);
+
+		/** Assignment operator; shares the audio data of \a original, and
+		stops sharing the audio data which this sample held.
+		@param original The object being copied.
+		@return This object.
+		*/
+		SoundSample& operator=(const SoundSample& original);
 
 		/** Basic destructor.
 		*/
@@ -87,6 +132,28 @@ namespace sound
 		*/
 		const char* const GetAudioData() const;
 
+		/** Accesses the shared audio data of the sample, so that it may be
+		kept alive without copying it.
+		@return The audio data for the sample.
+		*/
+		const std::shared_ptr<const char>& ShareAudioData() const;
+
+		/** Accesses the encoding of the audio data.
+		@return How the audio data is encoded.
+		*/
+		const Encoding GetEncoding() const;
+
+		/** Accesses the size of each block of audio data: each frame for PCM, or
+		each independently decodable block for ADPCM.
+		@return The block alignment in bytes.
+		*/
+		const unsigned short GetBlockAlignment() const;
+
+		/** Accesses the length of the sample.
+		@return The number of whole frames in the sample, once decoded.
+		*/
+		const std::size_t GetFrameCount() const;
+
 	private:
 		/// The bit depth of the sample.
 		unsigned short bit_depth;
@@ -96,13 +163,17 @@ namespace sound
 		unsigned short number_of_channels;
 		/// The size of the sample's audio data.
 		std::size_t data_size;
-		/// The raw audio data.
-		std::unique_ptr<const char[]> audio_data;
+		/// The raw audio data, shared by every copy of the sample.
+		std::shared_ptr<const char> audio_data;
+		/// How the audio data is encoded.
+		Encoding encoding;
+		/// The size of each block of the audio data.
+		unsigned short block_alignment;
+		/// The number of whole frames in the sample.
+		std::size_t frame_count;
 
 		/// NOT IMPLEMENTED.
 		SoundSample();
-		/// NOT IMPLEMENTED.
-		const SoundSample& operator=(const SoundSample&);
 	};
 
 
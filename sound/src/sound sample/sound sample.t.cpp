@@ -22,7 +22,50 @@ Unit test for the sound sample component. See "sound sample.h" for details.
 */
 
 #include"sound sample.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include<iostream>
+#include<memory>
+#include<cstring>
 
+using avl::sound::SoundSample;
 
 
 
+void TestSoundSampleComponent()
+{
+	// Copies share the audio data rather than duplicating it, and keep it alive.
+	{
+		char* const data = new char[8];
+		memcpy(data, "abcdefgh", 8);
+		std::unique_ptr<SoundSample> original(new SoundSample(16, 44100, 2, 8, data));
+		const SoundSample copy(*original);
+		ASSERT(copy.GetAudioData() == data && original->GetAudioData() == data);
+		ASSERT(copy.GetBitDepth() == 16 && copy.GetFrequency() == 44100 && copy.GetNumberOfChannels() == 2 && copy.GetDataSize() == 8);
+		ASSERT(copy.ShareAudioData().use_count() == 2);
+		original.reset();
+		ASSERT(copy.ShareAudioData().use_count() == 1);
+		ASSERT(memcmp(copy.GetAudioData(), "abcdefgh", 8) == 0);
+		std::cout << "Copied samples share their audio data.\n";
+	}
+
+	// Assignment drops the old data and shares the new.
+	{
+		SoundSample first(8, 22050, 1, 4, new char[4]);
+		const SoundSample second(16, 48000, 2, 16, new char[16]);
+		const std::shared_ptr<const char> old_data = first.ShareAudioData();
+		first = second;
+		ASSERT(first.GetAudioData() == second.GetAudioData() && first.GetDataSize() == 16);
+		ASSERT(first.GetBitDepth() == 16 && first.GetFrequency() == 48000 && first.GetNumberOfChannels() == 2);
+		ASSERT(old_data.use_count() == 1 && second.ShareAudioData().use_count() == 2);
+		std::cout << "Assigned samples share their audio data.\n";
+	}
+
+	// Audio data owned by something else, such as a mapped file, is shared without copying it.
+	{
+		const std::shared_ptr<const std::string> file(new std::string("RIFF....data0123"));
+		const SoundSample sample(8, 8000, 1, 4, std::shared_ptr<const char>(file, &(*file)[12]));
+		ASSERT(sample.GetAudioData() == &(*file)[12] && file.use_count() == 2);
+		ASSERT(memcmp(sample.GetAudioData(), "0123", 4) == 0);
+		std::cout << "Samples share audio data which lies within other storage.\n";
+	}
+}
@@ -0,0 +1,300 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the sound stream component. See "sound stream.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"sound stream.h"
+#include"..\load wav file\load wav file.h"
+#include"..\..\..\utility\src\pack file\pack file.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include<algorithm>
+#include<cstring>
+#include<new>
+#include<Windows.h>
+#include<process.h>
+
+
+namespace avl
+{
+namespace sound
+{
+
+	// See method declaration for details.
+	SoundStream::SoundStream(const std::string& file_name, const std::size_t chunk_size, const unsigned int chunk_count)
+		: file(utility::OpenAssetFile(file_name, utility::MappedFile::SEQUENTIAL)), data(nullptr), data_size(0), bit_depth(0), frequency(0),
+		channel_count(0), chunk_size(0), chunk_count(chunk_count), filled_count(0), released_count(0), generation(0), acquired_count(0),
+		acquire_index(0), read_offset(0), is_reading_chunk(false), is_started(false), released_event(nullptr), reader(nullptr), is_stopping(false)
+	{
+		if(chunk_count < 2)
+		{
+			throw utility::InvalidArgumentException("avl::sound::SoundStream::SoundStream()", "chunk_count", "Must be at least 2.");
+		}
+		const WAVFileFormat format = ParseWAVFile(file);
+		bit_depth = format.bit_depth;
+		frequency = format.frequency;
+		channel_count = format.channel_count;
+		const std::size_t frame_size = channel_count * (bit_depth / 8);
+		// Compressed files are decoded when they're loaded instead; see LoadWAVFile().
+		if(format.encoding != SoundSample::PCM || frame_size == 0 || bit_depth % 8 != 0)
+		{
+			throw utility::FileFormatException(file_name);
+		}
+		this->chunk_size = chunk_size - chunk_size % frame_size;
+		if(this->chunk_size == 0)
+		{
+			throw utility::InvalidArgumentException("avl::sound::SoundStream::SoundStream()", "chunk_size", "Must hold at least one frame.");
+		}
+		data = &file.GetData()[format.data_offset];
+		data_size = format.data_size - format.data_size % frame_size;
+		if(data_size == 0)
+		{
+			throw utility::FileFormatException(file_name);
+		}
+
+		chunks.reset(new(std::nothrow) char[this->chunk_size * chunk_count]);
+		chunk_states.reset(new(std::nothrow) ChunkState[chunk_count]);
+		if(chunks == nullptr || chunk_states == nullptr)
+		{
+			throw utility::OutOfMemoryError();
+		}
+
+		released_event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+		if(released_event == nullptr)
+		{
+			throw utility::Exception("avl::sound::SoundStream::SoundStream() -- Unable to create the synchronization objects.");
+		}
+		reader = reinterpret_cast<HANDLE>(_beginthreadex(nullptr, 0, &SoundStream::ReaderThread, this, 0, nullptr));
+		if(reader == nullptr)
+		{
+			Shutdown();
+			throw utility::Exception("avl::sound::SoundStream::SoundStream() -- Unable to start the reader thread.");
+		}
+	}
+
+	// See method declaration for details.
+	SoundStream::~SoundStream()
+	{
+		Shutdown();
+	}
+
+	// See method declaration for details.
+	const bool SoundStream::AcquireChunk(Chunk& chunk)
+	{
+		SkipStaleChunks();
+		// A chunk which the reader started before the last restart may have been published
+		// since; it's skipped next time.
+		if(acquired_count == filled_count || chunk_states[acquire_index].generation != generation)
+		{
+			return false;
+		}
+		const ChunkState& state = chunk_states[acquire_index];
+		chunk.data = &chunks[acquire_index * chunk_size];
+		chunk.size = state.size;
+		chunk.is_last = state.is_last;
+		++acquired_count;
+		acquire_index = (acquire_index + 1) % chunk_count;
+		is_started = true;
+		return true;
+	}
+
+	// See method declaration for details.
+	void SoundStream::ReleaseChunk()
+	{
+		ASSERT(released_count != acquired_count);
+		InterlockedIncrement(&released_count);
+		SetEvent(released_event);
+	}
+
+	// See method declaration for details.
+	const std::size_t SoundStream::ReadFrames(char* const frames, const std::size_t frame_count, bool& is_end)
+	{
+		const std::size_t frame_size = channel_count * (bit_depth / 8);
+		std::size_t copied = 0;
+		is_end = false;
+		while(copied < frame_count)
+		{
+			if(is_reading_chunk == false)
+			{
+				if(AcquireChunk(read_chunk) == false)
+				{
+					break;
+				}
+				is_reading_chunk = true;
+				read_offset = 0;
+			}
+			const std::size_t size = std::min((frame_count - copied) * frame_size, read_chunk.size - read_offset);
+			memcpy(&frames[copied * frame_size], &read_chunk.data[read_offset], size);
+			copied += size / frame_size;
+			read_offset += size;
+			if(read_offset == read_chunk.size)
+			{
+				is_reading_chunk = false;
+				ReleaseChunk();
+				if(read_chunk.is_last == true)
+				{
+					is_end = true;
+					break;
+				}
+			}
+		}
+		return copied;
+	}
+
+	// See method declaration for details.
+	void SoundStream::Restart()
+	{
+		if(is_started == false)
+		{
+			return;
+		}
+		is_started = false;
+		InterlockedExchange(&released_count, acquired_count);
+		is_reading_chunk = false;
+		read_offset = 0;
+		InterlockedIncrement(&generation);
+		// Make room for the reader right away, rather than when the next chunk is acquired.
+		SkipStaleChunks();
+		SetEvent(released_event);
+	}
+
+	// See method declaration for details.
+	const unsigned short SoundStream::GetBitDepth() const
+	{
+		return bit_depth;
+	}
+
+	// See method declaration for details.
+	const unsigned int SoundStream::GetFrequency() const
+	{
+		return frequency;
+	}
+
+	// See method declaration for details.
+	const unsigned short SoundStream::GetNumberOfChannels() const
+	{
+		return channel_count;
+	}
+
+	// See method declaration for details.
+	const std::size_t SoundStream::GetDataSize() const
+	{
+		return data_size;
+	}
+
+	// See method declaration for details.
+	const std::size_t SoundStream::GetChunkSize() const
+	{
+		return chunk_size;
+	}
+
+	// See method declaration for details.
+	const unsigned int SoundStream::GetChunkCount() const
+	{
+		return chunk_count;
+	}
+
+	// See method declaration for details.
+	const std::string& SoundStream::GetFileName() const
+	{
+		return file.GetFileName();
+	}
+
+	// See method declaration for details.
+	unsigned int __stdcall SoundStream::ReaderThread(void* stream)
+	{
+		static_cast<SoundStream*>(stream)->RunReader();
+		return 0;
+	}
+
+	// See method declaration for details.
+	void SoundStream::RunReader()
+	{
+		std::size_t position = 0;
+		unsigned int write_index = 0;
+		LONG read_generation = generation;
+		while(is_stopping == false)
+		{
+			// Wait for the player to release a chunk.
+			if(filled_count - released_count >= static_cast<LONG>(chunk_count))
+			{
+				WaitForSingleObject(released_event, INFINITE);
+				continue;
+			}
+			// Start over if the player has restarted.
+			const LONG current_generation = generation;
+			if(current_generation != read_generation)
+			{
+				position = 0;
+				read_generation = current_generation;
+			}
+			// Copying out of the mapping is what actually reads the file.
+			ChunkState& state = chunk_states[write_index];
+			state.size = std::min(chunk_size, data_size - position);
+			memcpy(&chunks[write_index * chunk_size], &data[position], state.size);
+			position += state.size;
+			state.is_last = (position == data_size);
+			state.generation = current_generation;
+			if(state.is_last == true)
+			{
+				position = 0;
+			}
+			write_index = (write_index + 1) % chunk_count;
+			// Publish the chunk to the player.
+			InterlockedIncrement(&filled_count);
+		}
+	}
+
+	// See method declaration for details.
+	void SoundStream::SkipStaleChunks()
+	{
+		while(acquired_count != filled_count && chunk_states[acquire_index].generation != generation)
+		{
+			// Every chunk acquired before this one has been released, so it's the oldest, and
+			// may be released right away.
+			++acquired_count;
+			acquire_index = (acquire_index + 1) % chunk_count;
+			ReleaseChunk();
+		}
+	}
+
+	// See method declaration for details.
+	void SoundStream::Shutdown()
+	{
+		is_stopping = true;
+		if(reader != nullptr)
+		{
+			SetEvent(released_event);
+			WaitForSingleObject(reader, INFINITE);
+			CloseHandle(reader);
+			reader = nullptr;
+		}
+		if(released_event != nullptr)
+		{
+			CloseHandle(released_event);
+			released_event = nullptr;
+		}
+	}
+
+
+
+} // sound
+} // avl
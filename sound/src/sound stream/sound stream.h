@@ -0,0 +1,248 @@
+#pragma once
+#ifndef AVL_SOUND_SOUND_STREAM__
+#define AVL_SOUND_SOUND_STREAM__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Defines the \ref avl::sound::SoundStream class.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"..\..\..\utility\src\file operations\file operations.h"
+#include<string>
+#include<memory>
+#include<cstddef>
+#include<Windows.h>
+
+
+namespace avl
+{
+namespace sound
+{
+
+	/**
+	Plays the audio data of a WAV file a chunk at a time, rather than loading all of it into
+	memory, so that long sounds such as music cost the same no matter how long they are.
+	@par Read-ahead:
+	The file is mapped rather than read, and a background thread copies the audio data out
+	of the mapping into a small ring of fixed-size chunks ahead of the player, so that the
+	disk reads behind the mapping happen on that thread. The player acquires the chunks in
+	order and releases them once it's done with them, which frees them to be refilled. Peak
+	memory is the ring, \ref GetChunkSize() * \ref GetChunkCount() bytes, plus whichever
+	pages of the mapping the system keeps around.
+	@par Looping:
+	The reader wraps around to the start of the audio data as soon as it reaches the end,
+	so a looping stream never waits on the disk at its loop point. The chunk which ends each
+	pass through the data is marked as the last.
+	@par Threads:
+	Apart from the constructor and destructor, the methods of a stream may only be called
+	from one thread at a time: the thread which plays it.
+	@note Entries of a compressed pack file are decompressed into memory when they're opened,
+	so streams should be stored uncompressed.
+	*/
+	class SoundStream
+	{
+	public:
+		/**
+		A chunk of audio data which has been read ahead.
+		*/
+		struct Chunk
+		{
+			/// The audio data. Valid until the chunk is released.
+			const char* data;
+			/// The size of \ref data in bytes; always a whole number of frames.
+			std::size_t size;
+			/// Is this the chunk which ends a pass through the audio data?
+			bool is_last;
+		};
+
+		/** Opens a WAV file and starts reading it ahead.
+		@param file_name The name of the file, which is opened with utility::OpenAssetFile().
+		@param chunk_size The size of each chunk in bytes. Rounded down to a whole number of
+		frames.
+		@param chunk_count The number of chunks to read ahead.
+		@throws InvalidArgumentException If \a chunk_size is less than one frame, or if
+		\a chunk_count is less than 2.
+		@throws FileNotFoundException If the file doesn't exist.
+		@throws FileFormatException If the file isn't a PCM WAV file, or has no audio data.
+		@throws OutOfMemoryError If unable to allocate the chunks.
+		@throws Exception If unable to start the reader thread.
+		*/
+		SoundStream(const std::string& file_name, const std::size_t chunk_size = 65536, const unsigned int chunk_count = 3);
+
+		/** Stops the reader thread and closes the file.
+		*/
+		~SoundStream();
+
+		/** Gets the next chunk which has been read ahead, without releasing any. Chunks
+		which were read before the last call to \ref Restart() are skipped.
+		@param chunk [OUT] Receives the chunk.
+		@return True if a chunk was acquired, and false if the reader hasn't caught up.
+		*/
+		const bool AcquireChunk(Chunk& chunk);
+
+		/** Releases the oldest acquired chunk so that it may be refilled.
+		@pre A chunk has been acquired and not yet released.
+		*/
+		void ReleaseChunk();
+
+		/** Copies frames out of the read-ahead chunks, acquiring and releasing them as
+		needed. Stops at the end of a pass through the audio data, so that the caller can
+		decide whether to loop.
+		@param frames [OUT] Receives the frames.
+		@param frame_count The most frames to copy.
+		@param is_end [OUT] Set to true if the copied frames end a pass through the audio
+		data, and false otherwise.
+		@return The number of frames copied. Less than \a frame_count if the end of a pass
+		was reached, or if the reader hasn't caught up.
+		@attention Don't mix calls to this with calls to \ref AcquireChunk() and
+		\ref ReleaseChunk(), except through \ref Restart().
+		*/
+		const std::size_t ReadFrames(char* const frames, const std::size_t frame_count, bool& is_end);
+
+		/** Starts over from the beginning of the audio data. Every acquired chunk is
+		released, so the caller must be done with them. Does nothing if no chunk has been
+		acquired since the stream was opened or last restarted, so that the chunks which
+		have already been read ahead aren't wasted.
+		*/
+		void Restart();
+
+		/** Accesses the bit depth of the audio data.
+		@return The bit depth of each sample.
+		*/
+		const unsigned short GetBitDepth() const;
+
+		/** Accesses the sampling frequency.
+		@return The number of frames per second.
+		*/
+		const unsigned int GetFrequency() const;
+
+		/** Accesses the number of channels.
+		@return The number of audio channels.
+		*/
+		const unsigned short GetNumberOfChannels() const;
+
+		/** Accesses the size of the audio data.
+		@return The size of the audio data in bytes, rounded down to whole frames.
+		*/
+		const std::size_t GetDataSize() const;
+
+		/** Accesses the size of a chunk.
+		@return The size of each chunk in bytes.
+		*/
+		const std::size_t GetChunkSize() const;
+
+		/** Accesses the number of chunks which are read ahead.
+		@return The number of chunks.
+		*/
+		const unsigned int GetChunkCount() const;
+
+		/** Accesses the name of the file being streamed.
+		@return The name of the file.
+		*/
+		const std::string& GetFileName() const;
+
+	private:
+		/** The bookkeeping for a chunk, written by the reader before the chunk is published.
+		*/
+		struct ChunkState
+		{
+			/// The size of the chunk's data in bytes.
+			std::size_t size;
+			/// Does the chunk end a pass through the audio data?
+			bool is_last;
+			/// The value of \ref generation when the chunk was read.
+			LONG generation;
+		};
+
+		/** Entry point of the reader thread.
+		@param stream The SoundStream which owns the reader.
+		@return Zero.
+		*/
+		static unsigned int __stdcall ReaderThread(void* stream);
+
+		/** Fills chunks until told to stop.*/
+		void RunReader();
+
+		/** Acquires and releases the chunks which were read before the last call to
+		\ref Restart(), up to the first which was read since.
+		*/
+		void SkipStaleChunks();
+
+		/** Stops the reader thread and releases the synchronization objects.*/
+		void Shutdown();
+
+		/// The mapped file.
+		const utility::MappedFile file;
+		/// The audio data within \ref file.
+		const char* data;
+		/// The size of \ref data in bytes.
+		std::size_t data_size;
+		/// The bit depth of each sample.
+		unsigned short bit_depth;
+		/// The number of frames per second.
+		unsigned int frequency;
+		/// The number of channels.
+		unsigned short channel_count;
+		/// The size of each chunk in bytes.
+		std::size_t chunk_size;
+		/// The number of chunks.
+		const unsigned int chunk_count;
+		/// The storage for every chunk.
+		std::unique_ptr<char[]> chunks;
+		/// The bookkeeping for every chunk.
+		std::unique_ptr<ChunkState[]> chunk_states;
+
+		/// The number of chunks which have been filled, ever. Written only by the reader.
+		volatile LONG filled_count;
+		/// The number of chunks which have been released, ever. Written only by the player.
+		volatile LONG released_count;
+		/// Incremented by \ref Restart(); chunks read before then are skipped.
+		volatile LONG generation;
+		/// The number of chunks which have been acquired, ever. Used only by the player.
+		LONG acquired_count;
+		/// The index of the next chunk to be acquired. Used only by the player.
+		unsigned int acquire_index;
+		/// The chunk which \ref ReadFrames() is copying from.
+		Chunk read_chunk;
+		/// The number of bytes of \ref read_chunk which have been copied.
+		std::size_t read_offset;
+		/// Does \ref ReadFrames() hold \ref read_chunk?
+		bool is_reading_chunk;
+		/// Has a chunk been acquired since the stream was opened or last restarted?
+		bool is_started;
+
+		/// Signaled whenever a chunk is released, or when the reader should stop.
+		HANDLE released_event;
+		/// The reader thread.
+		HANDLE reader;
+		/// Set when the reader should exit.
+		volatile bool is_stopping;
+
+		/// NOT IMPLEMENTED.
+		SoundStream(const SoundStream&);
+		/// NOT IMPLEMENTED.
+		const SoundStream& operator=(const SoundStream&);
+	};
+
+
+
+} // sound
+} // avl
+#endif // AVL_SOUND_SOUND_STREAM__
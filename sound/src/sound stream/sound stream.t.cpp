@@ -0,0 +1,160 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the sound stream component. See "sound stream.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"sound stream.h"
+#include"..\wav file sink\wav file sink.h"
+#include"..\sound sample\sound sample.h"
+#include"..\load wav file\load wav file.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include<iostream>
+#include<vector>
+#include<algorithm>
+#include<cstring>
+#include<Windows.h>
+
+using avl::sound::SoundStream;
+using avl::sound::WAVFileSink;
+using avl::sound::SoundSample;
+using avl::sound::LoadWAVFile;
+
+
+
+// Anonymous namespace.
+namespace
+{
+	const std::size_t ReadPass(SoundStream& stream, char* const frames, const std::size_t frame_count);
+	void AcquireChunk(SoundStream& stream, SoundStream::Chunk& chunk);
+}
+
+
+
+void TestSoundStreamComponent()
+{
+	// A file which is much longer than a stream's chunks put together.
+	const std::size_t frame_count = 10007;
+	{
+		std::vector<float> samples(frame_count * 2);
+		for(std::size_t i = 0; i < samples.size(); ++i)
+		{
+			samples[i] = static_cast<float>(i % 2000) / 2000.0f - 0.5f;
+		}
+		WAVFileSink sink("assets/sound stream.wav", 44100, 2);
+		sink.WriteFrames(&samples[0], frame_count, 2);
+		sink.Close();
+	}
+	const SoundSample whole = LoadWAVFile("assets/sound stream.wav");
+	const char* const expected = whole.GetAudioData();
+
+	// Every frame is read in order through a small ring of chunks, which is all the memory
+	// that a stream needs.
+	{
+		SoundStream stream("assets/sound stream.wav", 1001, 3);
+		ASSERT(stream.GetChunkSize() == 1000 && stream.GetChunkCount() == 3);
+		ASSERT(stream.GetBitDepth() == 16 && stream.GetNumberOfChannels() == 2 && stream.GetFrequency() == 44100);
+		ASSERT(stream.GetDataSize() == whole.GetDataSize());
+		std::vector<char> frames(whole.GetDataSize());
+		ASSERT(ReadPass(stream, &frames[0], frame_count) == frame_count);
+		ASSERT(memcmp(&frames[0], expected, whole.GetDataSize()) == 0);
+
+		// The next pass starts over, so that looping never waits on the disk.
+		ASSERT(ReadPass(stream, &frames[0], 300) == 300);
+		ASSERT(memcmp(&frames[0], expected, 300 * 4) == 0);
+
+		// Restarting skips whatever was read ahead.
+		stream.Restart();
+		ASSERT(ReadPass(stream, &frames[0], 1234) == 1234);
+		ASSERT(memcmp(&frames[0], expected, 1234 * 4) == 0);
+		std::cout << "Streams read every frame in order, loop, and restart.\n";
+	}
+
+	// Held chunks aren't refilled until they're released.
+	{
+		SoundStream stream("assets/sound stream.wav", 4096, 2);
+		SoundStream::Chunk first;
+		SoundStream::Chunk second;
+		SoundStream::Chunk next;
+		AcquireChunk(stream, first);
+		AcquireChunk(stream, second);
+		Sleep(50);
+		ASSERT(stream.AcquireChunk(next) == false);
+		ASSERT(first.size == 4096 && memcmp(first.data, expected, 4096) == 0);
+		ASSERT(second.size == 4096 && memcmp(second.data, expected + 4096, 4096) == 0);
+
+		// The rest of the pass follows, and ends with a partial chunk.
+		stream.ReleaseChunk();
+		stream.ReleaseChunk();
+		std::size_t offset = 8192;
+		do
+		{
+			AcquireChunk(stream, next);
+			ASSERT(memcmp(next.data, expected + offset, next.size) == 0);
+			offset += next.size;
+			stream.ReleaseChunk();
+		} while(next.is_last == false);
+		ASSERT(offset == whole.GetDataSize() && next.size == whole.GetDataSize() % 4096);
+		std::cout << "Chunks are refilled once they're released.\n";
+	}
+}
+
+
+
+// Anonymous namespace.
+namespace
+{
+	/** Reads frames from a stream until \a frame_count have been read or the pass ends,
+	waiting on the reader whenever it falls behind.
+	@param stream The stream to read.
+	@param frames [OUT] Receives the frames.
+	@param frame_count The most frames to read.
+	@return The number of frames read.
+	*/
+	const std::size_t ReadPass(SoundStream& stream, char* const frames, const std::size_t frame_count)
+	{
+		const std::size_t frame_size = stream.GetNumberOfChannels() * (stream.GetBitDepth() / 8);
+		std::size_t read = 0;
+		bool is_end = false;
+		while(read < frame_count && is_end == false)
+		{
+			// Read in pieces which don't line up with the chunks.
+			const std::size_t count = stream.ReadFrames(&frames[read * frame_size], std::min<std::size_t>(frame_count - read, 123), is_end);
+			if(count == 0 && is_end == false)
+			{
+				Sleep(1);
+			}
+			read += count;
+		}
+		return read;
+	}
+
+	/** Acquires the next chunk of a stream, waiting on the reader if need be.
+	@param stream The stream.
+	@param chunk [OUT] Receives the chunk.
+	*/
+	void AcquireChunk(SoundStream& stream, SoundStream::Chunk& chunk)
+	{
+		while(stream.AcquireChunk(chunk) == false)
+		{
+			Sleep(1);
+		}
+	}
+}
@@ -24,7 +24,17 @@ Includes the core components of the sound subsystem.
 @date Jun 28, 2012
 */
 
+#include"adpcm\adpcm.h"
+#include"dsp effects\dsp effects.h"
+#include"mixing\mixing.h"
+#include"normalize sample\normalize sample.h"
 #include"sound engine\sound engine.h"
+#include"sound job\sound job.h"
+#include"software sound engine\software sound engine.h"
 #include"sound sample\sound sample.h"
+#include"sound stream\sound stream.h"
+#include"spatialization\spatialization.h"
+#include"threaded sound engine\threaded sound engine.h"
+#include"wav file sink\wav file sink.h"
 
 #endif // AVL_SOUND_SUBSYSTEM__
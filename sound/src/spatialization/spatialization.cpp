@@ -0,0 +1,265 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the spatialization component. See "spatialization.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"spatialization.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include<new>
+#include<emmintrin.h>
+
+
+namespace avl
+{
+namespace sound
+{
+	// See method definitions for details.
+	namespace
+	{
+		/**
+		The values which every batch of sound effects is spatialized with, in every lane.
+		*/
+		struct SpatialConstants
+		{
+			/// The listener's x coordinate.
+			__m128 listener_x;
+			/// The listener's y coordinate.
+			__m128 listener_y;
+			/// \ref Attenuation::reference_distance.
+			__m128 reference_distance;
+			/// \ref Attenuation::max_distance.
+			__m128 max_distance;
+			/// \ref Attenuation::audibility_threshold.
+			__m128 audibility_threshold;
+		};
+
+		void SpatializeFour(const SpatialConstants& constants, const float* const x, const float* const y, const float* const volume, const unsigned int* const positional,
+			float* const gain, float* const left_pan, float* const right_pan, unsigned int* const audible);
+	}
+
+
+
+	// See method declaration for details.
+	Spatializer::Spatializer()
+	{
+	}
+
+	// See method declaration for details.
+	Spatializer::~Spatializer()
+	{
+	}
+
+	// See method declaration for details.
+	void Spatializer::Clear()
+	{
+		x_positions.clear();
+		y_positions.clear();
+		volumes.clear();
+		positional_masks.clear();
+	}
+
+	// See method declaration for details.
+	const std::size_t Spatializer::AddEffect(const utility::SoundEffect& effect)
+	{
+		try
+		{
+			x_positions.push_back(effect.GetPosition().GetX());
+			y_positions.push_back(effect.GetPosition().GetY());
+			volumes.push_back(effect.GetVolume());
+			positional_masks.push_back((effect.IsPositional() == true) ? 0xFFFFFFFF : 0);
+		}
+		catch(const std::bad_alloc&)
+		{
+			// Keep the arrays the same length.
+			x_positions.resize(positional_masks.size());
+			y_positions.resize(positional_masks.size());
+			volumes.resize(positional_masks.size());
+			throw utility::OutOfMemoryError();
+		}
+		return positional_masks.size() - 1;
+	}
+
+	// See method declaration for details.
+	void Spatializer::Spatialize(const utility::Vector& listener, const Attenuation& attenuation)
+	{
+		ASSERT(IsValidAttenuation(attenuation) == true);
+		const std::size_t count = positional_masks.size();
+		// Growing the results after Clear() only allocates when there are more effects than
+		// there have ever been; so, past the first few updates, never.
+		if(gains.size() < count)
+		{
+			try
+			{
+				gains.resize(count);
+				left_pans.resize(count);
+				right_pans.resize(count);
+				audible_masks.resize(count);
+			}
+			catch(const std::bad_alloc&)
+			{
+				throw utility::OutOfMemoryError();
+			}
+		}
+
+		SpatialConstants constants;
+		constants.listener_x = _mm_set1_ps(listener.GetX());
+		constants.listener_y = _mm_set1_ps(listener.GetY());
+		constants.reference_distance = _mm_set1_ps(attenuation.reference_distance);
+		constants.max_distance = _mm_set1_ps(attenuation.max_distance);
+		constants.audibility_threshold = _mm_set1_ps(attenuation.audibility_threshold);
+		std::size_t i = 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			SpatializeFour(constants, &x_positions[i], &y_positions[i], &volumes[i], &positional_masks[i], &gains[i], &left_pans[i], &right_pans[i], &audible_masks[i]);
+		}
+		// Spatialize the rest in a batch of their own, padded out with silent non-positional
+		// effects, so that they're worked out exactly the same way.
+		if(i < count)
+		{
+			float x[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+			float y[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+			float volume[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+			unsigned int positional[4] = {0, 0, 0, 0};
+			float gain[4];
+			float left_pan[4];
+			float right_pan[4];
+			unsigned int audible[4];
+			for(std::size_t lane = 0; i + lane < count; ++lane)
+			{
+				x[lane] = x_positions[i + lane];
+				y[lane] = y_positions[i + lane];
+				volume[lane] = volumes[i + lane];
+				positional[lane] = positional_masks[i + lane];
+			}
+			SpatializeFour(constants, x, y, volume, positional, gain, left_pan, right_pan, audible);
+			for(std::size_t lane = 0; i + lane < count; ++lane)
+			{
+				gains[i + lane] = gain[lane];
+				left_pans[i + lane] = left_pan[lane];
+				right_pans[i + lane] = right_pan[lane];
+				audible_masks[i + lane] = audible[lane];
+			}
+		}
+	}
+
+	// See method declaration for details.
+	const std::size_t Spatializer::GetEffectCount() const
+	{
+		return positional_masks.size();
+	}
+
+	// See method declaration for details.
+	const bool Spatializer::IsPositional(const std::size_t index) const
+	{
+		ASSERT(index < positional_masks.size());
+		return positional_masks[index] != 0;
+	}
+
+	// See method declaration for details.
+	const float Spatializer::GetGain(const std::size_t index) const
+	{
+		ASSERT(index < positional_masks.size());
+		return gains[index];
+	}
+
+	// See method declaration for details.
+	const float Spatializer::GetLeftPan(const std::size_t index) const
+	{
+		ASSERT(index < positional_masks.size());
+		return left_pans[index];
+	}
+
+	// See method declaration for details.
+	const float Spatializer::GetRightPan(const std::size_t index) const
+	{
+		ASSERT(index < positional_masks.size());
+		return right_pans[index];
+	}
+
+	// See method declaration for details.
+	const bool Spatializer::IsAudible(const std::size_t index) const
+	{
+		ASSERT(index < positional_masks.size());
+		return audible_masks[index] != 0;
+	}
+
+	// See method declaration for details.
+	const bool Spatializer::IsValidAttenuation(const Attenuation& attenuation)
+	{
+		// Written so that NaNs fail.
+		return attenuation.reference_distance > 0.0f && attenuation.max_distance >= attenuation.reference_distance
+			&& attenuation.audibility_threshold >= 0.0f;
+	}
+
+
+
+	// Anonymous namespace.
+	namespace
+	{
+		/** Spatializes four sound effects.
+		@param constants The listener and the attenuation.
+		@param x The x coordinates of the effects.
+		@param y The y coordinates of the effects.
+		@param volume The volumes of the effects.
+		@param positional The positional masks of the effects.
+		@param gain [OUT] Receives the gains of the effects.
+		@param left_pan [OUT] Receives the left pans of the effects.
+		@param right_pan [OUT] Receives the right pans of the effects.
+		@param audible [OUT] Receives the audible masks of the effects.
+		*/
+		void SpatializeFour(const SpatialConstants& constants, const float* const x, const float* const y, const float* const volume, const unsigned int* const positional,
+			float* const gain, float* const left_pan, float* const right_pan, unsigned int* const audible)
+		{
+			const __m128 half = _mm_set1_ps(0.5f);
+			const __m128 one = _mm_set1_ps(1.0f);
+			const __m128 zero = _mm_setzero_ps();
+
+			const __m128 dx = _mm_sub_ps(_mm_loadu_ps(x), constants.listener_x);
+			const __m128 dy = _mm_sub_ps(_mm_loadu_ps(y), constants.listener_y);
+			const __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+			// Never less than the reference distance, so never 0.
+			const __m128 near_distance = _mm_max_ps(distance, constants.reference_distance);
+			const __m128 clamped_distance = _mm_min_ps(near_distance, constants.max_distance);
+			const __m128 sound_volume = _mm_loadu_ps(volume);
+			const __m128 attenuated = _mm_div_ps(_mm_mul_ps(sound_volume, constants.reference_distance), clamped_distance);
+
+			// The pan runs from -1 on the left to 1 on the right. Clamping it keeps rounding from
+			// taking the square roots below 0.
+			const __m128 pan = _mm_min_ps(_mm_max_ps(_mm_div_ps(dx, near_distance), _mm_sub_ps(zero, one)), one);
+			const __m128 left = _mm_sqrt_ps(_mm_sub_ps(half, _mm_mul_ps(half, pan)));
+			const __m128 right = _mm_sqrt_ps(_mm_add_ps(half, _mm_mul_ps(half, pan)));
+
+			// Non-positional effects keep their volumes, and are played on both sides in full.
+			const __m128 mask = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(positional)));
+			const __m128 final_gain = _mm_or_ps(_mm_and_ps(mask, attenuated), _mm_andnot_ps(mask, sound_volume));
+			_mm_storeu_ps(gain, final_gain);
+			_mm_storeu_ps(left_pan, _mm_or_ps(_mm_and_ps(mask, left), _mm_andnot_ps(mask, one)));
+			_mm_storeu_ps(right_pan, _mm_or_ps(_mm_and_ps(mask, right), _mm_andnot_ps(mask, one)));
+			const __m128 is_audible = _mm_or_ps(_mm_andnot_ps(mask, _mm_cmpeq_ps(zero, zero)), _mm_cmpge_ps(final_gain, constants.audibility_threshold));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(audible), _mm_castps_si128(is_audible));
+		}
+	}
+
+
+
+} // sound
+} // avl
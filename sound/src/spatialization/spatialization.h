@@ -0,0 +1,171 @@
+#pragma once
+#ifndef AVL_SOUND_SPATIALIZATION__
+#define AVL_SOUND_SPATIALIZATION__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Defines the \ref avl::sound::Spatializer class, which attenuates and pans positional
+sound effects by where they are relative to a listener.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"..\..\..\utility\src\sound effect\sound effect.h"
+#include"..\..\..\utility\src\vector\vector.h"
+#include<vector>
+#include<cstddef>
+
+
+namespace avl
+{
+namespace sound
+{
+
+	/**
+	How positional sound effects fade with their distance from the listener. Distances are
+	in the same units as the positions.
+	*/
+	struct Attenuation
+	{
+		/// Sound effects at most this far away are heard at their full volume. Further away,
+		/// their volume falls off in proportion to their distance. Must be greater than 0.
+		float reference_distance;
+		/// Sound effects further away than this are heard as though they were this far
+		/// away. Must be at least \ref reference_distance.
+		float max_distance;
+		/// Positional sound effects whose attenuated volume is below this aren't heard at
+		/// all, so they aren't mixed. Must be at least 0.
+		float audibility_threshold;
+	};
+
+	/**
+	Works out the gain and panning of a batch of sound effects, all at once: the effects are
+	added one at a time, and then spatialized four at a time with SSE2.
+	@par Gain:
+	A positional effect's gain is its volume scaled by \a reference_distance divided by its
+	distance from the listener, clamped to the range of the \ref Attenuation. A
+	non-positional effect's gain is its volume.
+	@par Panning:
+	A positional effect is panned by the sideways part of its direction from the listener,
+	using an equal-power pan law: its left and right pans' squares add up to 1, so it's
+	as loud wherever it is. Effects within \a reference_distance are panned less the closer
+	they are, so that one passing through the listener doesn't jump from side to side. A
+	non-positional effect's pans are both 1, so that it's heard as it would be without them.
+	*/
+	class Spatializer
+	{
+	public:
+		/** Basic constructor.
+		*/
+		Spatializer();
+
+		/** Basic destructor.
+		*/
+		~Spatializer();
+
+		/** Forgets the sound effects which have been added, keeping the storage for them.
+		*/
+		void Clear();
+
+		/** Adds a sound effect to be spatialized.
+		@param effect The sound effect. Its position and volume are copied.
+		@return The index of the effect, counting from 0 since Clear() was last called.
+		@throw OutOfMemoryError If unable to allocate necessary storage.
+		*/
+		const std::size_t AddEffect(const utility::SoundEffect& effect);
+
+		/** Spatializes every sound effect which has been added.
+		@param listener The position which the sound effects are heard from.
+		@param attenuation How the sound effects fade with distance. Must be valid; see
+		\ref IsValidAttenuation().
+		*/
+		void Spatialize(const utility::Vector& listener, const Attenuation& attenuation);
+
+		/** Counts the sound effects which have been added.
+		@return The number of sound effects.
+		*/
+		const std::size_t GetEffectCount() const;
+
+		/** Tells whether a sound effect was positional when it was added.
+		@param index The index of the sound effect.
+		@return True if the sound effect is positional.
+		*/
+		const bool IsPositional(const std::size_t index) const;
+
+		/** Accesses a sound effect's gain, as of the last call to Spatialize().
+		@param index The index of the sound effect.
+		@return The gain.
+		*/
+		const float GetGain(const std::size_t index) const;
+
+		/** Accesses how much a sound effect is played on the left, as of the last call to
+		Spatialize(). Its gain isn't included.
+		@param index The index of the sound effect.
+		@return The left pan, from 0 to 1.
+		*/
+		const float GetLeftPan(const std::size_t index) const;
+
+		/** Accesses how much a sound effect is played on the right, as of the last call to
+		Spatialize(). Its gain isn't included.
+		@param index The index of the sound effect.
+		@return The right pan, from 0 to 1.
+		*/
+		const float GetRightPan(const std::size_t index) const;
+
+		/** Tells whether a sound effect is loud enough to be heard, as of the last call to
+		Spatialize(). Non-positional sound effects always are.
+		@param index The index of the sound effect.
+		@return True if the sound effect is audible.
+		*/
+		const bool IsAudible(const std::size_t index) const;
+
+		/** Checks that an attenuation's distances and threshold are in range.
+		@param attenuation The attenuation.
+		@return True if \a attenuation may be used.
+		*/
+		static const bool IsValidAttenuation(const Attenuation& attenuation);
+
+	private:
+		/// The x coordinates of the sound effects.
+		std::vector<float> x_positions;
+		/// The y coordinates of the sound effects.
+		std::vector<float> y_positions;
+		/// The volumes of the sound effects.
+		std::vector<float> volumes;
+		/// All bits set for the positional sound effects, and clear for the others.
+		std::vector<unsigned int> positional_masks;
+		/// The gains of the sound effects.
+		std::vector<float> gains;
+		/// The left pans of the sound effects.
+		std::vector<float> left_pans;
+		/// The right pans of the sound effects.
+		std::vector<float> right_pans;
+		/// All bits set for the sound effects which are audible, and clear for the others.
+		std::vector<unsigned int> audible_masks;
+
+		/// NOT IMPLEMENTED.
+		Spatializer(const Spatializer&);
+		/// NOT IMPLEMENTED.
+		const Spatializer& operator=(const Spatializer&);
+	};
+
+
+
+} // sound
+} // avl
+#endif // AVL_SOUND_SPATIALIZATION__
@@ -0,0 +1,264 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the spatialization component. See "spatialization.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"spatialization.h"
+#include"..\..\..\utility\src\sound effect\sound effect.h"
+#include"..\..\..\utility\src\vector\vector.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include"..\..\..\utility\src\timer\timer.h"
+#include<iostream>
+#include<vector>
+#include<cmath>
+#include<cstdlib>
+
+
+
+// Anonymous namespace.
+namespace
+{
+	void ReferenceSpatialize(const avl::utility::SoundEffect& effect, const avl::utility::Vector& listener, const avl::sound::Attenuation& attenuation,
+		float& gain, float& left_pan, float& right_pan, bool& is_audible);
+	const bool IsClose(const float lhs, const float rhs);
+}
+
+
+
+void TestSpatializationComponent()
+{
+	using namespace avl::sound;
+	using avl::utility::SoundEffect;
+	using avl::utility::Vector;
+	using avl::utility::Timer;
+
+	const Attenuation attenuation = {2.0f, 50.0f, 0.05f};
+	const Vector listener(3.0f, -1.0f);
+
+	// Only sensible attenuations are valid.
+	{
+		ASSERT(Spatializer::IsValidAttenuation(attenuation) == true);
+		const Attenuation zero_reference = {0.0f, 50.0f, 0.05f};
+		const Attenuation short_max = {2.0f, 1.0f, 0.05f};
+		const Attenuation negative_threshold = {2.0f, 50.0f, -0.05f};
+		const Attenuation not_a_number = {std::sqrt(-1.0f), 50.0f, 0.05f};
+		ASSERT(Spatializer::IsValidAttenuation(zero_reference) == false);
+		ASSERT(Spatializer::IsValidAttenuation(short_max) == false);
+		ASSERT(Spatializer::IsValidAttenuation(negative_threshold) == false);
+		ASSERT(Spatializer::IsValidAttenuation(not_a_number) == false);
+		std::cout << "Attenuations are validated.\n";
+	}
+
+	// Every count, including those which leave a tail, spatializes as one effect at a time
+	// would; and again after being cleared.
+	{
+		std::vector<SoundEffect> effects;
+		for(unsigned int i = 0; i < 37; ++i)
+		{
+			SoundEffect effect;
+			effect.SetVolume(static_cast<float>(rand() % 100) / 100.0f);
+			if(i % 5 != 0)
+			{
+				effect.SetPosition(Vector(static_cast<float>(rand() % 200) - 100.0f, static_cast<float>(rand() % 200) - 100.0f));
+			}
+			effects.push_back(effect);
+		}
+		Spatializer spatializer;
+		for(std::size_t count = 0; count <= effects.size(); ++count)
+		{
+			spatializer.Clear();
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				ASSERT(spatializer.AddEffect(effects[i]) == i);
+			}
+			ASSERT(spatializer.GetEffectCount() == count);
+			spatializer.Spatialize(listener, attenuation);
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				float gain, left_pan, right_pan;
+				bool is_audible;
+				ReferenceSpatialize(effects[i], listener, attenuation, gain, left_pan, right_pan, is_audible);
+				ASSERT(spatializer.IsPositional(i) == effects[i].IsPositional());
+				ASSERT(IsClose(spatializer.GetGain(i), gain) == true);
+				ASSERT(IsClose(spatializer.GetLeftPan(i), left_pan) == true);
+				ASSERT(IsClose(spatializer.GetRightPan(i), right_pan) == true);
+				ASSERT(spatializer.IsAudible(i) == is_audible);
+			}
+		}
+		std::cout << "Batches spatialize as single effects do.\n";
+	}
+
+	// Positional effects are panned with equal power, non-positional effects are left alone,
+	// and the gain follows the distance within its limits.
+	{
+		Spatializer spatializer;
+		SoundEffect right;
+		right.SetVolume(1.0f);
+		right.SetPosition(listener + Vector(10.0f, 0.0f));
+		SoundEffect left;
+		left.SetVolume(1.0f);
+		left.SetPosition(listener - Vector(10.0f, 0.0f));
+		SoundEffect ahead;
+		ahead.SetVolume(1.0f);
+		ahead.SetPosition(listener + Vector(0.0f, 4.0f));
+		SoundEffect close;
+		close.SetVolume(0.5f);
+		close.SetPosition(listener + Vector(1.0f, 0.0f));
+		SoundEffect distant;
+		distant.SetVolume(1.0f);
+		distant.SetPosition(listener + Vector(0.0f, 1000.0f));
+		SoundEffect ambient;
+		ambient.SetVolume(0.75f);
+		ambient.SetPosition(listener + Vector(1000.0f, 0.0f));
+		ambient.ClearPosition();
+		spatializer.AddEffect(right);
+		spatializer.AddEffect(left);
+		spatializer.AddEffect(ahead);
+		spatializer.AddEffect(close);
+		spatializer.AddEffect(distant);
+		spatializer.AddEffect(ambient);
+		spatializer.Spatialize(listener, attenuation);
+
+		ASSERT(IsClose(spatializer.GetGain(0), 0.2f) == true);
+		ASSERT(IsClose(spatializer.GetLeftPan(0), 0.0f) == true && IsClose(spatializer.GetRightPan(0), 1.0f) == true);
+		ASSERT(IsClose(spatializer.GetLeftPan(1), 1.0f) == true && IsClose(spatializer.GetRightPan(1), 0.0f) == true);
+		ASSERT(IsClose(spatializer.GetGain(2), 0.5f) == true);
+		ASSERT(IsClose(spatializer.GetLeftPan(2), std::sqrt(0.5f)) == true && IsClose(spatializer.GetRightPan(2), std::sqrt(0.5f)) == true);
+		// Within the reference distance, the gain is full, and the pan is eased toward the middle.
+		ASSERT(IsClose(spatializer.GetGain(3), 0.5f) == true);
+		ASSERT(IsClose(spatializer.GetRightPan(3), std::sqrt(0.75f)) == true);
+		for(std::size_t i = 0; i < 4; ++i)
+		{
+			const float left_pan = spatializer.GetLeftPan(i);
+			const float right_pan = spatializer.GetRightPan(i);
+			ASSERT(IsClose(left_pan * left_pan + right_pan * right_pan, 1.0f) == true);
+			ASSERT(spatializer.IsAudible(i) == true);
+		}
+		// Beyond the max distance, the gain stops falling, and is below the threshold.
+		ASSERT(IsClose(spatializer.GetGain(4), 0.04f) == true);
+		ASSERT(spatializer.IsAudible(4) == false);
+		ASSERT(spatializer.IsPositional(5) == false);
+		ASSERT(spatializer.GetGain(5) == 0.75f);
+		ASSERT(spatializer.GetLeftPan(5) == 1.0f && spatializer.GetRightPan(5) == 1.0f);
+		ASSERT(spatializer.IsAudible(5) == true);
+		std::cout << "Gain and panning are correct.\n";
+	}
+
+	// Throughput, on many emitters.
+	{
+		const std::size_t emitter_count = 10000;
+		std::vector<SoundEffect> effects;
+		effects.reserve(emitter_count);
+		for(std::size_t i = 0; i < emitter_count; ++i)
+		{
+			SoundEffect effect;
+			effect.SetVolume(1.0f);
+			effect.SetPosition(Vector(static_cast<float>(rand() % 2000) - 1000.0f, static_cast<float>(rand() % 2000) - 1000.0f));
+			effects.push_back(effect);
+		}
+		Spatializer spatializer;
+		std::vector<float> gains(emitter_count);
+		std::vector<float> left_pans(emitter_count);
+		std::vector<float> right_pans(emitter_count);
+		std::vector<char> audible(emitter_count);
+		const unsigned int repetitions = 100;
+		double times[3] = {0.0, 0.0, 0.0};
+		std::size_t audible_count = 0;
+		for(unsigned int repetition = 0; repetition < repetitions; ++repetition)
+		{
+			Timer timer;
+			spatializer.Clear();
+			for(std::size_t i = 0; i < emitter_count; ++i)
+			{
+				spatializer.AddEffect(effects[i]);
+			}
+			times[0] += timer.Reset();
+			spatializer.Spatialize(listener, attenuation);
+			times[1] += timer.Reset();
+			for(std::size_t i = 0; i < emitter_count; ++i)
+			{
+				bool is_audible;
+				ReferenceSpatialize(effects[i], listener, attenuation, gains[i], left_pans[i], right_pans[i], is_audible);
+				audible[i] = (is_audible == true) ? 1 : 0;
+			}
+			times[2] += timer.Elapsed();
+			for(std::size_t i = 0; i < emitter_count; ++i)
+			{
+				audible_count += (spatializer.IsAudible(i) == true) ? 1 : 0;
+			}
+		}
+		std::cout << "Microseconds to spatialize " << emitter_count << " emitters (" << audible_count / repetitions << " audible):\n"
+			<< "  add        " << times[0] * 1000000.0 / repetitions << "\n"
+			<< "  SSE2       " << times[1] * 1000000.0 / repetitions << "\n"
+			<< "  one by one " << times[2] * 1000000.0 / repetitions << "\n";
+	}
+
+	system("pause");
+}
+
+
+
+// Anonymous namespace.
+namespace
+{
+	/** Spatializes a single sound effect the plain way, for comparison.
+	@param effect The sound effect.
+	@param listener The listener's position.
+	@param attenuation The attenuation.
+	@param gain [OUT] Receives the gain.
+	@param left_pan [OUT] Receives the left pan.
+	@param right_pan [OUT] Receives the right pan.
+	@param is_audible [OUT] Receives whether the effect is audible.
+	*/
+	void ReferenceSpatialize(const avl::utility::SoundEffect& effect, const avl::utility::Vector& listener, const avl::sound::Attenuation& attenuation,
+		float& gain, float& left_pan, float& right_pan, bool& is_audible)
+	{
+		if(effect.IsPositional() == false)
+		{
+			gain = effect.GetVolume();
+			left_pan = 1.0f;
+			right_pan = 1.0f;
+			is_audible = true;
+			return;
+		}
+		const float dx = effect.GetPosition().GetX() - listener.GetX();
+		const float dy = effect.GetPosition().GetY() - listener.GetY();
+		const float distance = std::sqrt(dx * dx + dy * dy);
+		const float near_distance = (distance > attenuation.reference_distance) ? distance : attenuation.reference_distance;
+		const float clamped_distance = (near_distance < attenuation.max_distance) ? near_distance : attenuation.max_distance;
+		gain = effect.GetVolume() * attenuation.reference_distance / clamped_distance;
+		float pan = dx / near_distance;
+		pan = (pan < -1.0f) ? -1.0f : ((pan > 1.0f) ? 1.0f : pan);
+		left_pan = std::sqrt(0.5f - 0.5f * pan);
+		right_pan = std::sqrt(0.5f + 0.5f * pan);
+		is_audible = gain >= attenuation.audibility_threshold;
+	}
+
+	/** Compares two floats, allowing for rounding.
+	@param lhs The first float.
+	@param rhs The second float.
+	@return True if they are about the same.
+	*/
+	const bool IsClose(const float lhs, const float rhs)
+	{
+		return std::abs(lhs - rhs) <= 1e-5f;
+	}
+}
@@ -0,0 +1,602 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the threaded sound engine component. See "threaded sound engine.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"threaded sound engine.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include<new>
+#include<process.h>
+
+
+
+namespace avl
+{
+namespace sound
+{
+
+	// See method declaration for details.
+	ThreadedSoundEngine::ThreadedSoundEngine(SoundEngine& engine, const std::size_t capacity, const DWORD update_interval)
+		: engine(engine), commands(capacity), reports(capacity), update_interval(update_interval), is_applying_reports(false),
+		is_listener_posted(true), is_live_changed(false), is_listener_moved(false), has_failed(0), wake_event(nullptr), audio_thread(nullptr), is_stopping(0)
+	{
+		const CommandLatency no_commands = {0, 0.0, 0.0};
+		latency = no_commands;
+		InitializeCriticalSection(&lock);
+		// The audio thread wakes up when signaled, or after update_interval at most.
+		wake_event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+		if(wake_event == nullptr)
+		{
+			DeleteCriticalSection(&lock);
+			throw utility::Exception("avl::sound::ThreadedSoundEngine::ThreadedSoundEngine() -- Unable to create the wake event.");
+		}
+		audio_thread = reinterpret_cast<HANDLE>(_beginthreadex(nullptr, 0, &ThreadedSoundEngine::AudioThread, this, 0, nullptr));
+		if(audio_thread == nullptr)
+		{
+			CloseHandle(wake_event);
+			DeleteCriticalSection(&lock);
+			throw utility::Exception("avl::sound::ThreadedSoundEngine::ThreadedSoundEngine() -- Unable to start the audio thread.");
+		}
+		// Mixing late is heard; running late elsewhere isn't.
+		SetThreadPriority(audio_thread, THREAD_PRIORITY_TIME_CRITICAL);
+	}
+
+	// See method declaration for details.
+	ThreadedSoundEngine::~ThreadedSoundEngine()
+	{
+		// Tell the audio thread to stop every sound and exit, then wait for it.
+		InterlockedExchange(&is_stopping, 1);
+		SetEvent(wake_event);
+		WaitForSingleObject(audio_thread, INFINITE);
+		CloseHandle(audio_thread);
+		CloseHandle(wake_event);
+		DeleteCriticalSection(&lock);
+	}
+
+	// See method declaration for details.
+	const utility::SoundEffect::SoundHandle ThreadedSoundEngine::AddSound(const sound::SoundSample& new_sample)
+	{
+		EnterCriticalSection(&lock);
+		try
+		{
+			const utility::SoundEffect::SoundHandle handle = engine.AddSound(new_sample);
+			LeaveCriticalSection(&lock);
+			return handle;
+		}
+		catch(...)
+		{
+			LeaveCriticalSection(&lock);
+			throw;
+		}
+	}
+
+	// See method declaration for details.
+	const bool ThreadedSoundEngine::IsPlayingADPCM() const
+	{
+		return engine.IsPlayingADPCM();
+	}
+
+	// See method declaration for details.
+	const utility::SoundEffect::SoundHandle ThreadedSoundEngine::AddStream(const std::string& file_name)
+	{
+		EnterCriticalSection(&lock);
+		try
+		{
+			const utility::SoundEffect::SoundHandle handle = engine.AddStream(file_name);
+			LeaveCriticalSection(&lock);
+			return handle;
+		}
+		catch(...)
+		{
+			LeaveCriticalSection(&lock);
+			throw;
+		}
+	}
+
+	// See method declaration for details.
+	void ThreadedSoundEngine::DeleteSound(const utility::SoundEffect::SoundHandle& handle)
+	{
+		EnterCriticalSection(&lock);
+		try
+		{
+			engine.DeleteSound(handle);
+		}
+		catch(...)
+		{
+			LeaveCriticalSection(&lock);
+			throw;
+		}
+		LeaveCriticalSection(&lock);
+	}
+
+	// See method declaration for details.
+	void ThreadedSoundEngine::ClearSounds()
+	{
+		EnterCriticalSection(&lock);
+		try
+		{
+			engine.ClearSounds();
+		}
+		catch(...)
+		{
+			LeaveCriticalSection(&lock);
+			throw;
+		}
+		LeaveCriticalSection(&lock);
+	}
+
+	// See method declaration for details.
+	void ThreadedSoundEngine::UpdateSounds(utility::SoundEffectList& sound_effects)
+	{
+		CheckAudioThread();
+		// Take in what the audio thread has reported since the last update. A report about a
+		// sound effect which has changed since is out of date.
+		Report report;
+		while(reports.TryPop(report) == true)
+		{
+			Proxy& proxy = proxies[report.slot];
+			if(proxy.sequence != report.sequence || (report.is_retired == false && proxy.is_posted == false))
+			{
+				continue;
+			}
+			if(report.is_retired == true)
+			{
+				proxy.is_in_use = false;
+				proxy.is_released = false;
+				try
+				{
+					free_proxies.push_back(report.slot);
+				}
+				catch(const std::bad_alloc&)
+				{
+					throw utility::OutOfMemoryError();
+				}
+			}
+			else
+			{
+				proxy.is_finished = true;
+			}
+		}
+		for(std::vector<Proxy>::iterator proxy = proxies.begin(); proxy != proxies.end(); ++proxy)
+		{
+			proxy->is_updated = false;
+		}
+
+		bool is_posted = false;
+		for(utility::SoundEffectList::iterator effect = sound_effects.begin(); effect != sound_effects.end(); ++effect)
+		{
+			const unsigned int slot = AcquireProxy(**effect);
+			Proxy& proxy = proxies[slot];
+			proxy.is_updated = true;
+			if(proxy.is_finished == true)
+			{
+				// The engine finished playing it.
+				is_applying_reports = true;
+				(*effect)->Pause();
+				is_applying_reports = false;
+				proxy.posted.Pause();
+				proxy.is_finished = false;
+			}
+			if(proxy.is_posted == false || IsChanged(**effect, proxy.posted) == true)
+			{
+				PostState(slot, **effect);
+				is_posted = true;
+			}
+		}
+		if(is_listener_posted == false && PostListenerPosition() == true)
+		{
+			is_posted = true;
+		}
+		// Release the slots of the sound effects which are no longer updated, and retry the
+		// releases which didn't fit into the queue.
+		for(std::size_t i = 0; i < proxies.size(); ++i)
+		{
+			if(proxies[i].is_in_use == true && proxies[i].is_updated == false && proxies[i].is_released == false)
+			{
+				PostRelease(i);
+				is_posted = true;
+			}
+		}
+		if(is_posted == true)
+		{
+			SetEvent(wake_event);
+		}
+	}
+
+	// See method declaration for details.
+	const VoiceStatistics ThreadedSoundEngine::GetVoiceStatistics() const
+	{
+		EnterCriticalSection(&lock);
+		const VoiceStatistics statistics = engine.GetVoiceStatistics();
+		LeaveCriticalSection(&lock);
+		return statistics;
+	}
+
+	// See method declaration for details.
+	void ThreadedSoundEngine::SetListenerPosition(const utility::Vector& position)
+	{
+		SoundEngine::SetListenerPosition(position);
+		// If there's no room, the next call to UpdateSounds() posts it instead.
+		if(PostListenerPosition() == true)
+		{
+			SetEvent(wake_event);
+		}
+	}
+
+	// See method declaration for details.
+	void ThreadedSoundEngine::SetAttenuation(const Attenuation& new_attenuation)
+	{
+		EnterCriticalSection(&lock);
+		try
+		{
+			engine.SetAttenuation(new_attenuation);
+			SoundEngine::SetAttenuation(new_attenuation);
+		}
+		catch(...)
+		{
+			LeaveCriticalSection(&lock);
+			throw;
+		}
+		LeaveCriticalSection(&lock);
+	}
+
+	// See method declaration for details.
+	const CommandLatency ThreadedSoundEngine::GetCommandLatency() const
+	{
+		EnterCriticalSection(&lock);
+		const CommandLatency measured = latency;
+		LeaveCriticalSection(&lock);
+		return measured;
+	}
+
+	// See method declaration for details.
+	void ThreadedSoundEngine::OnSoundEffectChanged(utility::SoundEffect& effect)
+	{
+		if(is_applying_reports == true)
+		{
+			return;
+		}
+		PostState(AcquireProxy(effect), effect);
+		SetEvent(wake_event);
+	}
+
+	// See method declaration for details.
+	unsigned int __stdcall ThreadedSoundEngine::AudioThread(void* engine)
+	{
+		static_cast<ThreadedSoundEngine*>(engine)->RunAudioThread();
+		return 0;
+	}
+
+	// See method declaration for details.
+	void ThreadedSoundEngine::RunAudioThread()
+	{
+		while(true)
+		{
+			WaitForSingleObject(wake_event, update_interval);
+			// Check for the stop request before applying commands so that nothing posted
+			// ahead of it is lost.
+			const bool stop = (is_stopping != 0);
+			UpdateEngine();
+			if(stop == true)
+			{
+				break;
+			}
+		}
+		// Stop every sound, so that the engine lets go of the copies before they're destroyed.
+		for(std::deque<Mirror>::iterator mirror = mirrors.begin(); mirror != mirrors.end(); ++mirror)
+		{
+			mirror->effect.Stop();
+		}
+		EnterCriticalSection(&lock);
+		try
+		{
+			engine.UpdateSounds(live_effects);
+		}
+		catch(...)
+		{
+		}
+		LeaveCriticalSection(&lock);
+	}
+
+	// See method declaration for details.
+	void ThreadedSoundEngine::UpdateEngine()
+	{
+		// Apply the commands to the copies. Only the latest state of each copy matters,
+		// except that a reset isn't undone by a later command.
+		Command command;
+		unsigned int command_count = 0;
+		double posted_time_sum = 0.0;
+		double earliest_posted_time = 0.0;
+		while(commands.TryPop(command) == true)
+		{
+			if(command.slot == utility::SoundEffect::NO_ENGINE_SLOT)
+			{
+				// The listener moved.
+				listener_position = command.state.GetPosition();
+				is_listener_moved = true;
+			}
+			else
+			{
+				if(command.slot >= mirrors.size())
+				{
+					Mirror unused;
+					unused.sequence = 0;
+					unused.is_live = false;
+					unused.is_released = false;
+					unused.is_retiring = false;
+					unused.was_playing = false;
+					unused.is_report_pending = false;
+					mirrors.resize(command.slot + 1, unused);
+				}
+				Mirror& mirror = mirrors[command.slot];
+				mirror.sequence = command.sequence;
+				mirror.is_report_pending = false;
+				if(command.is_released == true)
+				{
+					mirror.is_released = true;
+				}
+				else
+				{
+					mirror.is_released = false;
+					mirror.is_retiring = false;
+					const unsigned int engine_slot = mirror.effect.GetEngineSlot();
+					const bool is_reset = mirror.effect.IsReset() || command.state.IsReset();
+					mirror.effect = command.state;
+					mirror.effect.SetEngineSlot(engine_slot);
+					mirror.effect.Reset(is_reset);
+					if(mirror.is_live == false)
+					{
+						mirror.is_live = true;
+						is_live_changed = true;
+					}
+				}
+			}
+			if(command_count == 0 || command.posted_time < earliest_posted_time)
+			{
+				earliest_posted_time = command.posted_time;
+			}
+			posted_time_sum += command.posted_time;
+			++command_count;
+		}
+		if(is_live_changed == true)
+		{
+			live_effects.clear();
+			for(std::deque<Mirror>::iterator mirror = mirrors.begin(); mirror != mirrors.end(); ++mirror)
+			{
+				if(mirror->is_live == true)
+				{
+					live_effects.push_back(&mirror->effect);
+				}
+			}
+			is_live_changed = false;
+		}
+		for(std::deque<Mirror>::iterator mirror = mirrors.begin(); mirror != mirrors.end(); ++mirror)
+		{
+			mirror->was_playing = mirror->effect.IsPlaying();
+		}
+
+		EnterCriticalSection(&lock);
+		try
+		{
+			if(is_listener_moved == true)
+			{
+				engine.SetListenerPosition(listener_position);
+				is_listener_moved = false;
+			}
+			engine.UpdateSounds(live_effects);
+		}
+		catch(const utility::Exception& e)
+		{
+			failure_description = e.GetDescription();
+			InterlockedExchange(&has_failed, 1);
+		}
+		catch(...)
+		{
+			failure_description = "An unknown error occurred while updating the sound engine.";
+			InterlockedExchange(&has_failed, 1);
+		}
+		if(command_count > 0)
+		{
+			const double now = clock.Elapsed();
+			const double total_latency = latency.average_latency * latency.command_count + command_count * now - posted_time_sum;
+			latency.command_count += command_count;
+			latency.average_latency = total_latency / latency.command_count;
+			if(now - earliest_posted_time > latency.longest_latency)
+			{
+				latency.longest_latency = now - earliest_posted_time;
+			}
+		}
+		LeaveCriticalSection(&lock);
+		PostReports();
+	}
+
+	// See method declaration for details.
+	void ThreadedSoundEngine::PostReports()
+	{
+		for(std::size_t i = 0; i < mirrors.size(); ++i)
+		{
+			Mirror& mirror = mirrors[i];
+			if(mirror.is_live == false)
+			{
+				continue;
+			}
+			if(mirror.is_retiring == true)
+			{
+				// The engine has let go of it.
+				const Report retired = {static_cast<unsigned int>(i), mirror.sequence, true};
+				if(reports.TryPush(retired) == true)
+				{
+					mirror.is_live = false;
+					mirror.is_released = false;
+					mirror.is_retiring = false;
+					is_live_changed = true;
+				}
+			}
+			else if(mirror.is_released == true)
+			{
+				if(mirror.effect.IsPlaying() == false)
+				{
+					mirror.effect.Stop();
+					mirror.is_retiring = true;
+				}
+			}
+			else if(mirror.is_report_pending == true || (mirror.was_playing == true && mirror.effect.IsPlaying() == false))
+			{
+				const Report finished = {static_cast<unsigned int>(i), mirror.sequence, false};
+				mirror.is_report_pending = (reports.TryPush(finished) == false);
+			}
+		}
+	}
+
+	// See method declaration for details.
+	void ThreadedSoundEngine::PostState(const unsigned int slot, utility::SoundEffect& effect)
+	{
+		Proxy& proxy = proxies[slot];
+		Command command;
+		command.slot = slot;
+		command.sequence = proxy.sequence + 1;
+		command.is_released = false;
+		command.state = effect;
+		command.state.SetListener(nullptr);
+		command.state.SetEngineSlot(utility::SoundEffect::NO_ENGINE_SLOT);
+		command.posted_time = clock.Elapsed();
+		if(commands.TryPush(command) == false)
+		{
+			// The next update posts it instead.
+			proxy.is_posted = false;
+			return;
+		}
+		proxy.sequence = command.sequence;
+		proxy.posted = command.state;
+		proxy.posted.Reset(false);
+		proxy.is_posted = true;
+		proxy.is_finished = false;
+		// The reset has been handed to the engine.
+		effect.Reset(false);
+	}
+
+	// See method declaration for details.
+	const bool ThreadedSoundEngine::PostListenerPosition()
+	{
+		Command command;
+		command.slot = utility::SoundEffect::NO_ENGINE_SLOT;
+		command.sequence = 0;
+		command.is_released = false;
+		command.state.SetPosition(GetListenerPosition());
+		command.posted_time = clock.Elapsed();
+		is_listener_posted = commands.TryPush(command);
+		return is_listener_posted;
+	}
+
+	// See method declaration for details.
+	void ThreadedSoundEngine::PostRelease(const unsigned int slot)
+	{
+		Proxy& proxy = proxies[slot];
+		Command command;
+		command.slot = slot;
+		command.sequence = proxy.sequence + 1;
+		command.is_released = true;
+		command.posted_time = clock.Elapsed();
+		if(commands.TryPush(command) == true)
+		{
+			proxy.sequence = command.sequence;
+			proxy.is_released = true;
+		}
+	}
+
+	// See method declaration for details.
+	const unsigned int ThreadedSoundEngine::AcquireProxy(utility::SoundEffect& effect)
+	{
+		// The slot which the effect remembers is only its own if the slot still says so. If
+		// the slot has been released but not yet retired, the effect takes it back.
+		const unsigned int remembered = effect.GetEngineSlot();
+		if(remembered < proxies.size() && proxies[remembered].is_in_use == true && proxies[remembered].effect == &effect)
+		{
+			if(proxies[remembered].is_released == true)
+			{
+				proxies[remembered].is_released = false;
+				proxies[remembered].is_posted = false;
+			}
+			return remembered;
+		}
+		unsigned int slot;
+		try
+		{
+			if(free_proxies.empty() == false)
+			{
+				slot = free_proxies.back();
+				free_proxies.pop_back();
+			}
+			else
+			{
+				slot = proxies.size();
+				Proxy unused;
+				unused.effect = nullptr;
+				unused.sequence = 0;
+				unused.is_in_use = false;
+				unused.is_posted = false;
+				unused.is_finished = false;
+				unused.is_released = false;
+				unused.is_updated = false;
+				proxies.push_back(unused);
+			}
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw utility::OutOfMemoryError();
+		}
+		Proxy& proxy = proxies[slot];
+		proxy.effect = &effect;
+		proxy.is_in_use = true;
+		proxy.is_posted = false;
+		proxy.is_finished = false;
+		proxy.is_released = false;
+		proxy.is_updated = false;
+		effect.SetEngineSlot(slot);
+		return slot;
+	}
+
+	// See method declaration for details.
+	const bool ThreadedSoundEngine::IsChanged(const utility::SoundEffect& effect, const utility::SoundEffect& posted)
+	{
+		return effect.IsReset() == true || effect.IsPlaying() != posted.IsPlaying() || effect.GetSoundHandle() != posted.GetSoundHandle()
+			|| effect.GetVolume() != posted.GetVolume() || effect.GetPriority() != posted.GetPriority() || effect.IsLooping() != posted.IsLooping()
+			|| effect.IsPositional() != posted.IsPositional() || effect.GetPosition() != posted.GetPosition() || effect.GetBus() != posted.GetBus();
+	}
+
+	// See method declaration for details.
+	void ThreadedSoundEngine::CheckAudioThread()
+	{
+		if(has_failed == 0)
+		{
+			return;
+		}
+		EnterCriticalSection(&lock);
+		const std::string description = failure_description;
+		InterlockedExchange(&has_failed, 0);
+		LeaveCriticalSection(&lock);
+		throw utility::Exception(description);
+	}
+
+
+
+} // sound
+} // avl
@@ -0,0 +1,364 @@
+#pragma once
+#ifndef AVL_SOUND_THREADED_SOUND_ENGINE__
+#define AVL_SOUND_THREADED_SOUND_ENGINE__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Defines the \ref avl::sound::ThreadedSoundEngine class, which runs another sound engine
+on an audio thread of its own.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"..\sound engine\sound engine.h"
+#include"..\sound sample\sound sample.h"
+#include"..\..\..\utility\src\sound effect\sound effect.h"
+#include"..\..\..\utility\src\lock free queue\lock free queue.h"
+#include"..\..\..\utility\src\timer\timer.h"
+#include<deque>
+#include<string>
+#include<vector>
+#include<Windows.h>
+
+
+namespace avl
+{
+namespace sound
+{
+
+	/**
+	Measures how long the changes made to sound effects take to reach the sound engine
+	which plays them.
+	*/
+	struct CommandLatency
+	{
+		/// The number of changes which have reached the engine.
+		unsigned int command_count;
+		/// The average number of seconds from a change being made to the engine having
+		/// been updated with it.
+		double average_latency;
+		/// The longest number of seconds from a change being made to the engine having
+		/// been updated with it.
+		double longest_latency;
+	};
+
+	/**
+	Plays sounds through another sound engine, which it updates on an audio thread of its
+	own, so that no sound engine calls are made on the game thread and sounds needn't wait
+	for the game's next frame to start.
+	@par Commands:
+	The game thread never touches the sound effects which the audio thread updates. Instead
+	the audio thread keeps a copy of each, and \ref UpdateSounds() posts the state of each
+	sound effect which has changed since it was last posted to a lock-free queue. The audio
+	thread wakes up once per \a update_interval, or as soon as a command is posted, applies
+	the commands, and updates the sound engine. When the engine pauses a sound effect
+	because it finished, the audio thread posts that back through a second queue, and the
+	game's sound effect is paused by the next call to \ref UpdateSounds(). If a queue is
+	full, the state is posted again by the next call instead.
+	@par Latency:
+	A sound effect whose listener is the engine (see utility::SoundEffect::SetListener())
+	posts each change as it's made, rather than waiting for the next call to \ref
+	UpdateSounds(), so the time from Play() to the sound starting isn't tied to the frame
+	rate. See \ref GetCommandLatency().
+	@par Positional audio:
+	Moving the listener is posted to the audio thread like a change to a sound effect, so it
+	never blocks. Changing the attenuation is rare, so it's done under the lock instead.
+	@par Buses:
+	A sound effect's bus is posted along with the rest of its state. The engine's buses
+	themselves, such as a \ref SoftwareSoundEngine's effects, should be set up before the
+	audio thread starts using the engine.
+	@attention The sound effects must only be changed and updated on one thread: the game
+	thread. Sounds are added and deleted under a lock which the audio thread holds while it
+	updates the engine, so the engine itself must be able to be used from either thread.
+	*/
+	class ThreadedSoundEngine: public SoundEngine, public utility::SoundEffectListener
+	{
+	public:
+		/** Starts the audio thread.
+		@param engine The sound engine to play sounds through. It must outlive this object,
+		and mustn't be used directly until then.
+		@param capacity The minimum number of commands which may be waiting in each queue.
+		@param update_interval The longest time in milliseconds between updates of \a engine.
+		@throws InvalidArgumentException If \a capacity is 0.
+		@throws OutOfMemoryError If unable to allocate the queues.
+		@throws Exception If unable to start the audio thread.
+		*/
+		ThreadedSoundEngine(SoundEngine& engine, const std::size_t capacity = 4096, const DWORD update_interval = 10);
+
+		/** Stops every sound which is playing, and the audio thread.
+		*/
+		~ThreadedSoundEngine();
+
+		/** See \ref SoundEngine::AddSound(). Blocks while the audio thread updates the engine.
+		@param new_sample The sample to add.
+		@return The sound handle by which \a new_sample is to be accessed.
+		*/
+		const utility::SoundEffect::SoundHandle AddSound(const sound::SoundSample& new_sample);
+
+		/** See \ref SoundEngine::IsPlayingADPCM().
+		@return True if the engine plays ADPCM samples as they are.
+		*/
+		const bool IsPlayingADPCM() const;
+
+		/** See \ref SoundEngine::AddStream(). Blocks while the audio thread updates the engine.
+		@param file_name The name of the WAV file to be streamed.
+		@return The sound handle by which the stream is to be accessed.
+		*/
+		const utility::SoundEffect::SoundHandle AddStream(const std::string& file_name);
+
+		/** See \ref SoundEngine::DeleteSound(). Blocks while the audio thread updates the engine.
+		@param handle The handle to the sound which is to be deleted.
+		*/
+		void DeleteSound(const utility::SoundEffect::SoundHandle& handle);
+
+		/** See \ref SoundEngine::ClearSounds(). Blocks while the audio thread updates the engine.
+		*/
+		void ClearSounds();
+
+		/** Posts the changes to \a sound_effects which haven't been posted yet, and pauses
+		those which the engine has finished playing. Never blocks. As with the other engines,
+		a sound effect which is no longer updated plays until it finishes, and is then
+		forgotten.
+		@param sound_effects The SoundEffect objects whose state needs to be updated.
+		@throw Exception If the engine failed to update the sound effects on the audio thread
+		since the last call; for instance, because one had an invalid sound handle.
+		@throw OutOfMemoryError If unable to allocate necessary storage.
+		*/
+		void UpdateSounds(utility::SoundEffectList& sound_effects);
+
+		/** Counts the engine's real and virtual voices as of its last update.
+		@return The counts.
+		*/
+		const VoiceStatistics GetVoiceStatistics() const;
+
+		/** See \ref SoundEngine::SetListenerPosition(). Posts the position to the audio thread,
+		and never blocks.
+		@param position The listener's new position.
+		*/
+		void SetListenerPosition(const utility::Vector& position);
+
+		/** See \ref SoundEngine::SetAttenuation(). Blocks while the audio thread updates the
+		engine.
+		@param new_attenuation The new attenuation.
+		@throws InvalidArgumentException If \a new_attenuation isn't valid.
+		*/
+		void SetAttenuation(const Attenuation& new_attenuation);
+
+		/** Measures how long changes have taken to reach the engine since it was created.
+		@return The latency.
+		*/
+		const CommandLatency GetCommandLatency() const;
+
+		/** Posts the new state of \a effect at once. Called by the sound effects whose
+		listener is this engine; see utility::SoundEffect::SetListener().
+		@param effect The sound effect which changed.
+		@throw OutOfMemoryError If unable to allocate necessary storage.
+		*/
+		void OnSoundEffectChanged(utility::SoundEffect& effect);
+
+	private:
+		/** A sound effect's new state, posted from the game thread to the audio thread.
+		*/
+		struct Command
+		{
+			/// The slot of the sound effect; or utility::SoundEffect::NO_ENGINE_SLOT if the
+			/// command instead moves the listener to the position of \ref state.
+			unsigned int slot;
+			/// Counts up with each command for the slot.
+			unsigned int sequence;
+			/// Is the sound effect no longer being updated? If so, \ref state is ignored.
+			bool is_released;
+			/// The state of the sound effect.
+			utility::SoundEffect state;
+			/// When the command was posted, by \ref clock.
+			double posted_time;
+		};
+
+		/** Tells the game thread that the engine paused a sound effect, or that a slot
+		which was released may be reused.
+		*/
+		struct Report
+		{
+			/// The slot of the sound effect.
+			unsigned int slot;
+			/// The sequence of the last command which was applied to the sound effect.
+			unsigned int sequence;
+			/// Has the slot's sound effect finished since it was released?
+			bool is_retired;
+		};
+
+		/** The game thread's record of a sound effect.
+		*/
+		struct Proxy
+		{
+			/// The sound effect. Only dereferenced while the sound effect is being updated.
+			const utility::SoundEffect* effect;
+			/// The state which was last posted.
+			utility::SoundEffect posted;
+			/// The sequence of the last command which was posted.
+			unsigned int sequence;
+			/// Is the slot in use? It stays in use after its sound effect is gone, until
+			/// the audio thread retires it.
+			bool is_in_use;
+			/// Has the sound effect's current state been posted?
+			bool is_posted;
+			/// Has the engine paused the sound effect since its state was last posted?
+			bool is_finished;
+			/// Has the slot's release been posted?
+			bool is_released;
+			/// Set when the sound effect is updated, so that orphaned slots can be found.
+			bool is_updated;
+		};
+
+		/** The audio thread's copy of a sound effect.
+		*/
+		struct Mirror
+		{
+			/// The copy, which the engine updates.
+			utility::SoundEffect effect;
+			/// The sequence of the last command which was applied.
+			unsigned int sequence;
+			/// Is the copy in \ref live_effects?
+			bool is_live;
+			/// Has the sound effect been released? The copy plays until it finishes.
+			bool is_released;
+			/// Has the released copy been stopped, so that the engine lets go of it? It's
+			/// retired once the engine has been updated with it.
+			bool is_retiring;
+			/// Was the copy playing before the engine was updated?
+			bool was_playing;
+			/// Has the engine paused the copy without the game thread having been told?
+			bool is_report_pending;
+		};
+
+		/** Entry point of the audio thread.
+		@param engine The ThreadedSoundEngine which owns the thread.
+		@return Zero.
+		*/
+		static unsigned int __stdcall AudioThread(void* engine);
+
+		/** Applies commands and updates the engine until told to stop.
+		*/
+		void RunAudioThread();
+
+		/** Applies every command in the queue to the copies of the sound effects, and updates
+		the engine with them. Records a failure if the engine throws.
+		*/
+		void UpdateEngine();
+
+		/** Posts the state of a sound effect, if there's room in the queue.
+		@param slot The index of the sound effect's proxy.
+		@param effect The sound effect. Its reset property is cleared once it's posted.
+		*/
+		void PostState(const unsigned int slot, utility::SoundEffect& effect);
+
+		/** Posts the listener's position, if there's room in the queue.
+		@return True if it was posted.
+		*/
+		const bool PostListenerPosition();
+
+		/** Posts the release of a slot, if there's room in the queue. The slot is freed
+		once the audio thread retires it.
+		@param slot The index of the proxy.
+		*/
+		void PostRelease(const unsigned int slot);
+
+		/** Tells the game thread about the copies which the engine paused, and retires the
+		released copies which it's done with.
+		*/
+		void PostReports();
+
+		/** Finds a sound effect's proxy, or gives it one.
+		@param effect The sound effect.
+		@return The index of the proxy.
+		@throw OutOfMemoryError If unable to grow the proxies.
+		*/
+		const unsigned int AcquireProxy(utility::SoundEffect& effect);
+
+		/** Compares the properties of two sound effects which the engine plays them by.
+		@param effect The sound effect.
+		@param posted The state of \a effect which was last posted.
+		@return True if \a effect needs to be posted again.
+		*/
+		static const bool IsChanged(const utility::SoundEffect& effect, const utility::SoundEffect& posted);
+
+		/** Throws the failure recorded by the audio thread, if there is one.
+		@throw Exception The failure.
+		*/
+		void CheckAudioThread();
+
+		/// The engine which plays the sounds.
+		SoundEngine& engine;
+		/// Commands from the game thread to the audio thread.
+		utility::LockFreeQueue<Command> commands;
+		/// Reports from the audio thread to the game thread.
+		utility::LockFreeQueue<Report> reports;
+		/// The longest time in milliseconds between updates of \ref engine.
+		const DWORD update_interval;
+		/// Stamps commands when they're posted and applied. Never reset.
+		utility::Timer clock;
+
+		// Game thread.
+		/// The game thread's records of the sound effects, indexed by their engine slots.
+		std::vector<Proxy> proxies;
+		/// The indices of the free proxies.
+		std::vector<unsigned int> free_proxies;
+		/// Set while the game thread changes sound effects itself, so that it doesn't post them.
+		bool is_applying_reports;
+		/// Has the listener's position been posted since it last moved?
+		bool is_listener_posted;
+
+		// Audio thread.
+		/// The copies of the sound effects, indexed like \ref proxies.
+		std::deque<Mirror> mirrors;
+		/// The copies which the engine updates.
+		utility::SoundEffectList live_effects;
+		/// Have copies been added to or removed from \ref live_effects since it was built?
+		bool is_live_changed;
+		/// The listener's position, as last posted.
+		utility::Vector listener_position;
+		/// Has the listener moved since the engine was last updated?
+		bool is_listener_moved;
+
+		// Shared.
+		/// Guards \ref engine, \ref latency and \ref failure_description.
+		mutable CRITICAL_SECTION lock;
+		/// The latency of the commands which have been applied.
+		CommandLatency latency;
+		/// Why the engine failed to update, if it did.
+		std::string failure_description;
+		/// Set when the engine failed to update.
+		volatile LONG has_failed;
+		/// Signals the audio thread to apply commands now.
+		HANDLE wake_event;
+		/// The audio thread.
+		HANDLE audio_thread;
+		/// Set when the audio thread should exit.
+		volatile LONG is_stopping;
+
+		/// NOT IMPLEMENTED.
+		ThreadedSoundEngine(const ThreadedSoundEngine&);
+		/// NOT IMPLEMENTED.
+		const ThreadedSoundEngine& operator=(const ThreadedSoundEngine&);
+	};
+
+
+
+} // sound
+} // avl
+#endif // AVL_SOUND_THREADED_SOUND_ENGINE__
@@ -0,0 +1,425 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the threaded sound engine component. See "threaded sound engine.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"threaded sound engine.h"
+#include"..\software sound engine\software sound engine.h"
+#include"..\sound sample\sound sample.h"
+#include"..\..\..\utility\src\sound effect\sound effect.h"
+#include"..\..\..\utility\src\vector\vector.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include"..\..\..\utility\src\timer\timer.h"
+#include<iostream>
+#include<vector>
+#include<memory>
+#include<cstring>
+#include<cstdlib>
+#include<Windows.h>
+
+using avl::sound::ThreadedSoundEngine;
+using avl::sound::SoftwareSoundEngine;
+using avl::sound::SoundSample;
+using avl::utility::SoundEffect;
+using avl::utility::SoundEffectList;
+
+
+
+// Anonymous namespace.
+namespace
+{
+	SoundSample MakeSample(const std::size_t frame_count);
+	template<class Condition> const bool WaitUntil(Condition condition);
+
+
+
+	/** A sound engine which plays nothing, but counts what it's asked to play. Its sounds
+	play until it's told to finish them.
+	*/
+	class StandInEngine: public avl::sound::SoundEngine
+	{
+	public:
+		/** Basic constructor.
+		*/
+		StandInEngine()
+			: sound_count(0), update_count(0), effect_count(0), playing_count(0), positional_count(0), first_playing_time(-1.0), is_finishing(0)
+		{
+		}
+
+		const SoundEffect::SoundHandle AddSound(const SoundSample& new_sample)
+		{
+			return ++sound_count;
+		}
+
+		const SoundEffect::SoundHandle AddStream(const std::string& file_name)
+		{
+			throw avl::utility::Exception("StandInEngine::AddStream() -- Streams aren't supported.");
+		}
+
+		void DeleteSound(const SoundEffect::SoundHandle& handle)
+		{
+		}
+
+		void ClearSounds()
+		{
+			sound_count = 0;
+		}
+
+		void UpdateSounds(SoundEffectList& sound_effects)
+		{
+			LONG playing = 0;
+			LONG positional = 0;
+			for(SoundEffectList::iterator effect = sound_effects.begin(); effect != sound_effects.end(); ++effect)
+			{
+				if((*effect)->GetSoundHandle() == 0 || (*effect)->GetSoundHandle() > sound_count)
+				{
+					throw avl::utility::InvalidArgumentException("StandInEngine::UpdateSounds()", "sound_effects", "One or more sound effects contain an invalid sound handle.");
+				}
+				(*effect)->Reset(false);
+				if(is_finishing != 0 && (*effect)->IsPlaying() == true)
+				{
+					(*effect)->Pause();
+				}
+				if((*effect)->IsPlaying() == true)
+				{
+					++playing;
+				}
+				if((*effect)->IsPositional() == true)
+				{
+					++positional;
+				}
+			}
+			if(playing > 0 && first_playing_time < 0.0)
+			{
+				first_playing_time = clock.Elapsed();
+			}
+			InterlockedExchange(&effect_count, static_cast<LONG>(sound_effects.size()));
+			InterlockedExchange(&playing_count, playing);
+			InterlockedExchange(&positional_count, positional);
+			InterlockedIncrement(&update_count);
+		}
+
+		const avl::sound::VoiceStatistics GetVoiceStatistics() const
+		{
+			const avl::sound::VoiceStatistics statistics = {static_cast<unsigned int>(playing_count), 0, 0, 0};
+			return statistics;
+		}
+
+		/** Finishes every sound which is playing, from the next update on, or stops doing so.
+		@param finish Should sounds be finished?
+		*/
+		void FinishSounds(const bool finish)
+		{
+			InterlockedExchange(&is_finishing, (finish == true) ? 1 : 0);
+		}
+
+		/** Forgets when a sound last started playing.
+		*/
+		void ResetFirstPlayingTime()
+		{
+			first_playing_time = -1.0;
+		}
+
+		/// The number of sounds which have been added.
+		SoundEffect::SoundHandle sound_count;
+		/// The number of updates.
+		volatile LONG update_count;
+		/// The number of sound effects in the last update.
+		volatile LONG effect_count;
+		/// The number of sound effects which were playing as of the last update.
+		volatile LONG playing_count;
+		/// The number of sound effects which were positional as of the last update.
+		volatile LONG positional_count;
+		/// When the first update with a sound effect playing was, by \ref clock, or -1.
+		volatile double first_playing_time;
+		/// Measures \ref first_playing_time.
+		avl::utility::Timer clock;
+
+	private:
+		/// Are sounds finished as soon as they're updated?
+		volatile LONG is_finishing;
+	};
+}
+
+
+
+void TestThreadedSoundEngineComponent()
+{
+	// Changes reach the engine on the audio thread, and finished sounds are paused on the
+	// game thread.
+	{
+		StandInEngine stand_in;
+		ThreadedSoundEngine engine(stand_in, 16, 5);
+		const SoundEffect::SoundHandle handle = engine.AddSound(MakeSample(100));
+		SoundEffect effects[3] = {SoundEffect(handle), SoundEffect(handle), SoundEffect(handle)};
+		SoundEffectList list;
+		for(unsigned int i = 0; i < 3; ++i)
+		{
+			list.push_back(&effects[i]);
+		}
+		effects[0].Play();
+		effects[1].Play();
+		engine.UpdateSounds(list);
+		ASSERT(WaitUntil([&]() { return stand_in.playing_count == 2 && stand_in.effect_count == 3; }) == true);
+		ASSERT(engine.GetVoiceStatistics().real_voice_count == 2);
+
+		effects[1].Stop();
+		engine.UpdateSounds(list);
+		ASSERT(WaitUntil([&]() { return stand_in.playing_count == 1; }) == true);
+		ASSERT(effects[1].IsReset() == false);
+
+		stand_in.FinishSounds(true);
+		ASSERT(WaitUntil([&]() { return stand_in.playing_count == 0; }) == true);
+		ASSERT(effects[0].IsPlaying() == true);
+		// The report may take an update to arrive.
+		ASSERT(WaitUntil([&]() { engine.UpdateSounds(list); return effects[0].IsPlaying() == false; }) == true);
+		stand_in.FinishSounds(false);
+		std::cout << "Changes reach the engine, and finished sounds are paused.\n";
+
+		// A sound effect which is no longer updated plays until it finishes, and is then forgotten.
+		effects[2].Loop(true);
+		effects[2].Play();
+		engine.UpdateSounds(list);
+		list.pop_back();
+		engine.UpdateSounds(list);
+		Sleep(20);
+		ASSERT(stand_in.playing_count == 1 && stand_in.effect_count == 3);
+		stand_in.FinishSounds(true);
+		ASSERT(WaitUntil([&]() { engine.UpdateSounds(list); return stand_in.effect_count == 2; }) == true);
+		stand_in.FinishSounds(false);
+
+		// One which returns before it finishes picks up where it was.
+		effects[0].Loop(true);
+		effects[0].Play();
+		engine.UpdateSounds(list);
+		SoundEffectList empty;
+		engine.UpdateSounds(empty);
+		engine.UpdateSounds(list);
+		ASSERT(WaitUntil([&]() { return stand_in.effect_count == 2 && stand_in.playing_count == 1; }) == true);
+		Sleep(20);
+		ASSERT(stand_in.effect_count == 2);
+		effects[0].Stop();
+		engine.UpdateSounds(list);
+		std::cout << "Sound effects which aren't updated play until they finish.\n";
+
+		// A sound effect which listens to the engine reaches it without an update.
+		effects[1].SetListener(&engine);
+		effects[1].Play();
+		ASSERT(WaitUntil([&]() { return stand_in.playing_count == 1; }) == true);
+		effects[1].SetVolume(0.5f);
+		effects[1].Stop();
+		ASSERT(WaitUntil([&]() { return stand_in.playing_count == 0; }) == true);
+		effects[1].SetListener(nullptr);
+		std::cout << "Listening sound effects reach the engine at once.\n";
+
+		// The listener's position reaches the engine without an update, and so do the sound
+		// effects' positions with one.
+		const avl::utility::Vector listener(2.0f, 3.0f);
+		engine.SetListenerPosition(listener);
+		ASSERT(engine.GetListenerPosition() == listener);
+		ASSERT(WaitUntil([&]() { return stand_in.GetListenerPosition() == listener; }) == true);
+		effects[0].SetPosition(avl::utility::Vector(1.0f, 1.0f));
+		engine.UpdateSounds(list);
+		ASSERT(WaitUntil([&]() { return stand_in.positional_count == 1; }) == true);
+		effects[0].ClearPosition();
+		engine.UpdateSounds(list);
+		ASSERT(WaitUntil([&]() { return stand_in.positional_count == 0; }) == true);
+		const avl::sound::Attenuation attenuation = {2.0f, 20.0f, 0.0f};
+		engine.SetAttenuation(attenuation);
+		ASSERT(stand_in.GetAttenuation().reference_distance == 2.0f && engine.GetAttenuation().max_distance == 20.0f);
+		const avl::sound::Attenuation invalid_attenuation = {0.0f, 20.0f, 0.0f};
+		bool is_refused = false;
+		try
+		{
+			engine.SetAttenuation(invalid_attenuation);
+		}
+		catch(const avl::utility::InvalidArgumentException&)
+		{
+			is_refused = true;
+		}
+		ASSERT(is_refused == true && engine.GetAttenuation().reference_distance == 2.0f);
+		std::cout << "The listener and positions reach the engine.\n";
+
+		// More changes than fit into the queue are posted by later updates.
+		std::vector<SoundEffect> many(100, SoundEffect(handle));
+		SoundEffectList many_list;
+		for(std::size_t i = 0; i < many.size(); ++i)
+		{
+			many[i].Play();
+			many_list.push_back(&many[i]);
+		}
+		ASSERT(WaitUntil([&]() { engine.UpdateSounds(many_list); return stand_in.playing_count == 100; }) == true);
+		for(std::size_t i = 0; i < many.size(); ++i)
+		{
+			many[i].Stop();
+		}
+		ASSERT(WaitUntil([&]() { engine.UpdateSounds(many_list); return stand_in.playing_count == 0; }) == true);
+		ASSERT(WaitUntil([&]() { engine.UpdateSounds(list); return stand_in.effect_count == 2; }) == true);
+		std::cout << "Full queues are caught up with.\n";
+
+		// Failures on the audio thread are thrown by the next update.
+		SoundEffect invalid(handle + 1);
+		list.push_back(&invalid);
+		engine.UpdateSounds(list);
+		bool thrown = false;
+		ASSERT(WaitUntil([&]() -> bool
+		{
+			try
+			{
+				engine.UpdateSounds(list);
+			}
+			catch(const avl::utility::Exception&)
+			{
+				thrown = true;
+			}
+			return thrown;
+		}) == true);
+		list.pop_back();
+		std::cout << "Failures on the audio thread are thrown on the game thread.\n";
+	}
+
+	// Measure how long it takes for Play() to reach the engine when the game runs at 60
+	// frames per second: first when it's posted by the next frame's update, then when it's
+	// posted at once.
+	{
+		StandInEngine stand_in;
+		ThreadedSoundEngine engine(stand_in);
+		const SoundEffect::SoundHandle handle = engine.AddSound(MakeSample(100));
+		SoundEffect effect(handle);
+		SoundEffectList list;
+		list.push_back(&effect);
+		const unsigned int TRIALS = 20;
+		double frame_tied = 0.0;
+		for(unsigned int i = 0; i < TRIALS; ++i)
+		{
+			engine.UpdateSounds(list);
+			// Play partway through the frame.
+			Sleep(i % 16);
+			stand_in.ResetFirstPlayingTime();
+			const double played = stand_in.clock.Elapsed();
+			effect.Play();
+			Sleep(16 - i % 16);
+			engine.UpdateSounds(list);
+			ASSERT(WaitUntil([&]() { return stand_in.first_playing_time >= 0.0; }) == true);
+			frame_tied += stand_in.first_playing_time - played;
+			effect.Stop();
+			engine.UpdateSounds(list);
+			ASSERT(WaitUntil([&]() { return stand_in.playing_count == 0; }) == true);
+		}
+		effect.SetListener(&engine);
+		double immediate = 0.0;
+		for(unsigned int i = 0; i < TRIALS; ++i)
+		{
+			engine.UpdateSounds(list);
+			Sleep(i % 16);
+			stand_in.ResetFirstPlayingTime();
+			const double played = stand_in.clock.Elapsed();
+			effect.Play();
+			ASSERT(WaitUntil([&]() { return stand_in.first_playing_time >= 0.0; }) == true);
+			immediate += stand_in.first_playing_time - played;
+			Sleep(16 - i % 16);
+			effect.Stop();
+			engine.UpdateSounds(list);
+			ASSERT(WaitUntil([&]() { return stand_in.playing_count == 0; }) == true);
+		}
+		effect.SetListener(nullptr);
+		ASSERT(immediate < frame_tied);
+		const avl::sound::CommandLatency latency = engine.GetCommandLatency();
+		ASSERT(latency.command_count > 0 && latency.average_latency <= latency.longest_latency);
+		std::cout << "  Milliseconds from Play() to the engine, posted by the next frame: " << frame_tied * 1000.0 / TRIALS << "\n";
+		std::cout << "  Milliseconds from Play() to the engine, posted at once: " << immediate * 1000.0 / TRIALS << "\n";
+		std::cout << "  Average milliseconds from posting to the engine: " << latency.average_latency * 1000.0 << "\n";
+	}
+
+	// Measure the game thread's time per frame with 1000 sound effects, a tenth of which
+	// change each frame, with and without the audio thread.
+	{
+		const unsigned int EFFECT_COUNT = 1000;
+		const unsigned int FRAMES = 100;
+		double times[2];
+		for(unsigned int pass = 0; pass < 2; ++pass)
+		{
+			SoftwareSoundEngine software;
+			std::unique_ptr<ThreadedSoundEngine> threaded((pass == 1) ? new ThreadedSoundEngine(software) : nullptr);
+			avl::sound::SoundEngine& engine = (pass == 1) ? static_cast<avl::sound::SoundEngine&>(*threaded) : software;
+			const SoundEffect::SoundHandle handle = engine.AddSound(MakeSample(48000));
+			std::vector<SoundEffect> effects(EFFECT_COUNT, SoundEffect(handle));
+			SoundEffectList list;
+			for(unsigned int i = 0; i < EFFECT_COUNT; ++i)
+			{
+				effects[i].SetPriority(i % 3);
+				effects[i].Loop(true);
+				effects[i].Play();
+				list.push_back(&effects[i]);
+			}
+			engine.UpdateSounds(list);
+			avl::utility::Timer timer;
+			for(unsigned int frame = 0; frame < FRAMES; ++frame)
+			{
+				for(unsigned int i = frame % 10; i < EFFECT_COUNT; i += 10)
+				{
+					effects[i].SetVolume((frame % 100) / 100.0f);
+				}
+				engine.UpdateSounds(list);
+			}
+			times[pass] = timer.Elapsed();
+			for(unsigned int i = 0; i < EFFECT_COUNT; ++i)
+			{
+				effects[i].Stop();
+			}
+			engine.UpdateSounds(list);
+		}
+		std::cout << "  Game thread microseconds per update of 1000 sound effects, by the engine: " << times[0] * 1000000.0 / FRAMES << "\n";
+		std::cout << "  Game thread microseconds per update of 1000 sound effects, posted to the audio thread: " << times[1] * 1000000.0 / FRAMES << "\n";
+	}
+
+	system("pause");
+}
+
+
+
+// Anonymous namespace.
+namespace
+{
+	// Makes a silent 16-bit mono sample.
+	SoundSample MakeSample(const std::size_t frame_count)
+	{
+		char* const data = new char[frame_count * 2];
+		std::memset(data, 0, frame_count * 2);
+		return SoundSample(16, 48000, 1, frame_count * 2, data);
+	}
+
+	// Polls a condition for up to a second.
+	template<class Condition>
+	const bool WaitUntil(Condition condition)
+	{
+		for(unsigned int i = 0; i < 1000; ++i)
+		{
+			if(condition() == true)
+			{
+				return true;
+			}
+			Sleep(1);
+		}
+		return condition();
+	}
+}
@@ -0,0 +1,192 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the wav file sink component. See "wav file sink.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"wav file sink.h"
+#include"..\mixing\mixing.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include<fstream>
+#include<string>
+#include<cstring>
+#include<new>
+
+
+namespace avl
+{
+namespace sound
+{
+	// See method definitions for details.
+	namespace
+	{
+		/// The size of the RIFF, fmt, and data chunk headers, plus the fmt chunk.
+		const std::size_t HEADER_SIZE = 44;
+		/// The offset of the RIFF chunk's size.
+		const std::size_t RIFF_SIZE_OFFSET = 4;
+		/// The offset of the data chunk's size.
+		const std::size_t DATA_SIZE_OFFSET = 40;
+
+		void Write16(char* const destination, const unsigned short value);
+		void Write32(char* const destination, const unsigned int value);
+	}
+
+
+
+	// See method declaration for details.
+	WAVFileSink::WAVFileSink(const std::string& file_name, const unsigned int sample_rate, const unsigned short channel_count)
+		: file_name(file_name), channel_count(channel_count), frame_count(0)
+	{
+		file.exceptions(std::ios::goodbit);
+		file.open(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+		if(file.fail() == true)
+		{
+			throw utility::FileNotFoundException(file_name);
+		}
+		// The sizes are filled in by Close().
+		char header[HEADER_SIZE];
+		memcpy(&header[0], "RIFF", 4);
+		Write32(&header[RIFF_SIZE_OFFSET], 0);
+		memcpy(&header[8], "WAVEfmt ", 8);
+		Write32(&header[16], 16);
+		Write16(&header[20], 1);
+		Write16(&header[22], channel_count);
+		Write32(&header[24], sample_rate);
+		Write32(&header[28], sample_rate * channel_count * 2);
+		Write16(&header[32], static_cast<unsigned short>(channel_count * 2));
+		Write16(&header[34], 16);
+		memcpy(&header[36], "data", 4);
+		Write32(&header[DATA_SIZE_OFFSET], 0);
+		file.write(header, HEADER_SIZE);
+		if(file.bad() == true)
+		{
+			file.close();
+			throw utility::FileWriteException(file_name);
+		}
+	}
+
+	// See method declaration for details.
+	WAVFileSink::~WAVFileSink()
+	{
+		try
+		{
+			Close();
+		}
+		catch(...)
+		{
+		}
+	}
+
+	// See method declaration for details.
+	void WAVFileSink::WriteFrames(const float* const samples, const std::size_t frame_count, const unsigned short channel_count)
+	{
+		ASSERT(channel_count == this->channel_count);
+		if(file.is_open() == false)
+		{
+			throw utility::InvalidCallException("avl::sound::WAVFileSink::WriteFrames()", "The file has already been closed.");
+		}
+		const std::size_t sample_count = frame_count * channel_count;
+		if(pcm.size() < sample_count)
+		{
+			try
+			{
+				pcm.resize(sample_count);
+			}
+			catch(const std::bad_alloc&)
+			{
+				throw utility::OutOfMemoryError();
+			}
+		}
+		if(sample_count == 0)
+		{
+			return;
+		}
+		// WAV files are little-endian, as are we.
+		ConvertFloatToPCM16(samples, sample_count, &pcm[0]);
+		file.write(reinterpret_cast<const char*>(&pcm[0]), sample_count * sizeof(short));
+		if(file.bad() == true)
+		{
+			throw utility::FileWriteException(file_name);
+		}
+		this->frame_count += frame_count;
+	}
+
+	// See method declaration for details.
+	void WAVFileSink::Close()
+	{
+		if(file.is_open() == false)
+		{
+			return;
+		}
+		const unsigned int data_size = static_cast<unsigned int>(frame_count * channel_count * 2);
+		char size[4];
+		Write32(size, static_cast<unsigned int>(HEADER_SIZE - 8) + data_size);
+		file.seekp(RIFF_SIZE_OFFSET);
+		file.write(size, 4);
+		Write32(size, data_size);
+		file.seekp(DATA_SIZE_OFFSET);
+		file.write(size, 4);
+		const bool is_bad = file.bad();
+		file.close();
+		if(is_bad == true)
+		{
+			throw utility::FileWriteException(file_name);
+		}
+	}
+
+	// See method declaration for details.
+	const std::size_t WAVFileSink::GetFrameCount() const
+	{
+		return frame_count;
+	}
+
+
+
+	// Anonymous namespace.
+	namespace
+	{
+		/** Writes a 16-bit little-endian value.
+		@param destination [OUT] Receives the value.
+		@param value The value.
+		*/
+		void Write16(char* const destination, const unsigned short value)
+		{
+			destination[0] = static_cast<char>(value & 0xFF);
+			destination[1] = static_cast<char>(value >> 8);
+		}
+
+
+
+		/** Writes a 32-bit little-endian value.
+		@param destination [OUT] Receives the value.
+		@param value The value.
+		*/
+		void Write32(char* const destination, const unsigned int value)
+		{
+			Write16(destination, static_cast<unsigned short>(value & 0xFFFF));
+			Write16(destination + 2, static_cast<unsigned short>(value >> 16));
+		}
+	}
+
+
+
+} // sound
+} // avl
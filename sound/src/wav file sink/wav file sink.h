@@ -0,0 +1,102 @@
+#pragma once
+#ifndef AVL_SOUND_WAV_FILE_SINK__
+#define AVL_SOUND_WAV_FILE_SINK__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Defines the \ref avl::sound::WAVFileSink class.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"..\software sound engine\software sound engine.h"
+#include<fstream>
+#include<string>
+#include<vector>
+#include<cstddef>
+
+
+namespace avl
+{
+namespace sound
+{
+
+	/**
+	Writes the mix from a \ref SoftwareSoundEngine to a 16-bit PCM WAV file, which can be
+	loaded again with LoadWAVFile().
+	*/
+	class WAVFileSink: public SoftwareSoundEngine::Sink
+	{
+	public:
+		/** Creates the file and writes its header.
+		@param file_name The name of the file to write. It's overwritten if it exists.
+		@param sample_rate The number of frames per second.
+		@param channel_count The number of channels in each frame.
+		@throws FileNotFoundException If the file can't be created.
+		@throws FileWriteException If the header can't be written.
+		*/
+		WAVFileSink(const std::string& file_name, const unsigned int sample_rate, const unsigned short channel_count);
+
+		/** Closes the file, if it hasn't been closed already. Errors are ignored; call
+		\ref Close() to find out about them.
+		*/
+		~WAVFileSink();
+
+		/** Converts a block of frames to 16-bit samples and appends them to the file.
+		@param samples The interleaved float samples. Samples outside of -1.0 to 1.0 saturate.
+		@param frame_count The number of frames in \a samples.
+		@param channel_count The number of channels in each frame. Must match the file's.
+		@throws InvalidCallException If the file has been closed.
+		@throws FileWriteException If the samples can't be written.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		void WriteFrames(const float* const samples, const std::size_t frame_count, const unsigned short channel_count);
+
+		/** Fills in the sizes in the file's header and closes it.
+		@throws FileWriteException If the header can't be updated.
+		*/
+		void Close();
+
+		/** Counts the frames written so far.
+		@return The number of frames.
+		*/
+		const std::size_t GetFrameCount() const;
+
+	private:
+		/// The name of the file.
+		const std::string file_name;
+		/// The number of channels in each frame.
+		const unsigned short channel_count;
+		/// The file being written.
+		std::ofstream file;
+		/// The number of frames written.
+		std::size_t frame_count;
+		/// Holds each block of samples once converted.
+		std::vector<short> pcm;
+
+		/// NOT IMPLEMENTED.
+		WAVFileSink(const WAVFileSink&);
+		/// NOT IMPLEMENTED.
+		const WAVFileSink& operator=(const WAVFileSink&);
+	};
+
+
+
+} // sound
+} // avl
+#endif // AVL_SOUND_WAV_FILE_SINK__
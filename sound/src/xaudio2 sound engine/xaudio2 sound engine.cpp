@@ -23,18 +23,35 @@ Implementation for the xaudio2 sound engine component. See "xaudio2 sound engine
 
 #include"xaudio2 sound engine.h"
 #include"..\sound engine\sound engine.h"
+#include"..\adpcm\adpcm.h"
 #include"..\xaudio2 wrapper\xaudio2 wrapper.h"
 #include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\assert\assert.h"
 #include"..\..\..\utility\src\sound effect\sound effect.h"
 #include<map>
 #include<algorithm>
 #include<new>
 #include<memory>
+#include<vector>
 #include<cstring>
+#include<cmath>
 #include<xaudio2.h>
 
 
 
+namespace
+{
+	/// The number of low bits of a sound handle which hold the index of its slot. The rest
+	/// hold the slot's generation.
+	const unsigned int HANDLE_INDEX_BITS = 20;
+	/// Extracts the index of a slot from a sound handle.
+	const unsigned int HANDLE_INDEX_MASK = (1 << HANDLE_INDEX_BITS) - 1;
+	/// The greatest generation which fits in a sound handle.
+	const unsigned int MAX_HANDLE_GENERATION = 0xFFFFFFFF >> HANDLE_INDEX_BITS;
+}
+
+
+
 namespace avl
 {
 namespace sound
@@ -42,14 +59,53 @@ namespace sound
 
 
 	// See method declaration for details.
-	XAudio2SoundEngine::XAudio2SoundEngine()
-		: next_handle(1), xaudio2(nullptr), mastering_voice(nullptr)
+	XAudio2SoundEngine::XAudio2SoundEngine(const unsigned int max_voices, const unsigned int prewarmed_voices)
+		: xaudio2(nullptr), is_xaudio2_external(false), mastering_voice(nullptr), output_channel_count(0), max_voice_count(max_voices), prewarmed_voice_count(prewarmed_voices),
+		voice_count(0), active_voice_count(0), virtual_voice_count(0), started_voice_count(0), stolen_voice_count(0)
 	{
+		const VoiceStatistics no_voices = {0, 0, 0, 0};
+		statistics = no_voices;
+		if(max_voices == 0)
+		{
+			throw utility::InvalidArgumentException("avl::sound::XAudio2SoundEngine::XAudio2SoundEngine()", "max_voices", "Must be greater than 0.");
+		}
 		try
 		{
 			CoInitializeEx(nullptr, COINIT_MULTITHREADED);
 			xaudio2 = xaudio2::CreateXAudio2();
 			mastering_voice = xaudio2::CreateMasteringVoice(*xaudio2);
+			XAUDIO2_VOICE_DETAILS details;
+			memset(&details, 0, sizeof(details));
+			mastering_voice->GetVoiceDetails(&details);
+			output_channel_count = details.InputChannels;
+		}
+		catch(...)
+		{
+			ReleaseResources();
+			throw;
+		}
+	}
+
+	// See method declaration for details.
+	XAudio2SoundEngine::XAudio2SoundEngine(IXAudio2& xaudio2_interface, const unsigned int max_voices, const unsigned int prewarmed_voices)
+		: xaudio2(nullptr), is_xaudio2_external(true), mastering_voice(nullptr), output_channel_count(0), max_voice_count(max_voices), prewarmed_voice_count(prewarmed_voices),
+		voice_count(0), active_voice_count(0), virtual_voice_count(0), started_voice_count(0), stolen_voice_count(0)
+	{
+		const VoiceStatistics no_voices = {0, 0, 0, 0};
+		statistics = no_voices;
+		if(max_voices == 0)
+		{
+			throw utility::InvalidArgumentException("avl::sound::XAudio2SoundEngine::XAudio2SoundEngine()", "max_voices", "Must be greater than 0.");
+		}
+		xaudio2 = &xaudio2_interface;
+		xaudio2->AddRef();
+		try
+		{
+			mastering_voice = xaudio2::CreateMasteringVoice(*xaudio2);
+			XAUDIO2_VOICE_DETAILS details;
+			memset(&details, 0, sizeof(details));
+			mastering_voice->GetVoiceDetails(&details);
+			output_channel_count = details.InputChannels;
 		}
 		catch(...)
 		{
@@ -72,6 +128,10 @@ namespace sound
 		{
 			throw utility::InvalidArgumentException("avl::sound::XAudio2SoundEngine::AddSound()", "new_sample", "Must contain a non-null audio data pointer.");
 		}
+		if(new_sample.GetEncoding() != SoundSample::PCM)
+		{
+			return AddSound(DecodeADPCMSample(new_sample));
+		}
 		// Make sure that the sample's bit depth is acceptable.
 		if(new_sample.GetBitDepth() != 8 && new_sample.GetBitDepth() != 16 && new_sample.GetBitDepth() != 24 && new_sample.GetBitDepth() != 32)
 		{
@@ -88,185 +148,895 @@ namespace sound
 		{
 			throw utility::OutOfMemoryError();
 		}
-		xaudio2::ExtractPCMFormatData(new_sample, sound_data->first);
-		xaudio2::CreateBuffer(new_sample, sound_data->second);
-		// Reuse any reusable sound handles.
-		utility::SoundEffect::SoundHandle issued_handle;
-		if(reusable_sound_handles.empty() == false)
-		{
-			issued_handle = reusable_sound_handles.front();
-			reusable_sound_handles.pop();
-		}
-		else
+		xaudio2::ExtractPCMFormatData(new_sample, sound_data->format);
+		// Create the voices for this format now, rather than when it's first played.
+		PrewarmVoices(sound_data->format);
+		sound_data->audio_data = new_sample.ShareAudioData();
+		xaudio2::CreateBuffer(new_sample, sound_data->buffer);
+		// Save the sound sample's data and issue the sound handle.
+		const utility::SoundEffect::SoundHandle issued_handle = StoreSound(sound_data.get(), nullptr);
+		sound_data.release();
+		return issued_handle;
+	}
+
+	// See method declaration for details.
+	const utility::SoundEffect::SoundHandle XAudio2SoundEngine::AddStream(const std::string& file_name)
+	{
+		std::unique_ptr<StreamData> stream_data(new(std::nothrow) StreamData());
+		if(stream_data == nullptr)
 		{
-			issued_handle = next_handle;
-			++next_handle;
+			throw utility::OutOfMemoryError();
 		}
-		// Save the sound sample's data and issue the sound handle. Clean up if this fails.
-		try
+		stream_data->stream.reset(new(std::nothrow) SoundStream(file_name));
+		if(stream_data->stream == nullptr)
 		{
-			sounds.insert(std::make_pair(issued_handle, sound_data.get()));
-			sound_data.release();
+			throw utility::OutOfMemoryError();
 		}
-		catch(...)
+		const unsigned short bit_depth = stream_data->stream->GetBitDepth();
+		if(bit_depth != 8 && bit_depth != 16 && bit_depth != 24 && bit_depth != 32)
 		{
-			delete[] reinterpret_cast<const char*>(sound_data->second.pAudioData);
-			// Leaks the issued texture handle until the next time ClearTextures() is called.
-			throw;
+			throw utility::InvalidArgumentException("avl::sound::XAudio2SoundEngine::AddStream()", "file_name", "Must have a bit depth of 8, 16, 24, or 32.");
 		}
+		xaudio2::ExtractPCMFormatData(*stream_data->stream, stream_data->format);
+		// Create the voices for this format now, rather than when it's first played.
+		PrewarmVoices(stream_data->format);
+		const utility::SoundEffect::SoundHandle issued_handle = StoreSound(nullptr, stream_data.get());
+		stream_data.release();
 		return issued_handle;
 	}
 
 	// See method declaration for details.
 	void XAudio2SoundEngine::DeleteSound(const utility::SoundEffect::SoundHandle& handle)
 	{
-		SoundHandleToSound::iterator element = sounds.find(handle);
-		if(element != sounds.end())
+		const SoundSlot* const slot = FindSound(handle);
+		if(slot == nullptr)
 		{
-			// Delete the audio data.
-			delete[] reinterpret_cast<const char*>(element->second->second.pAudioData);
-			element->second->second.pAudioData = nullptr;
-			// Delete the SoundData object.
-			delete element->second;
-			// Erase this entry.
-			sounds.erase(element);
-			// Reuse this sound handle.
-			try
-			{
-				reusable_sound_handles.push(handle);
-			}
-			catch(const std::bad_alloc&)
+			return;
+		}
+		if(slot->stream != nullptr)
+		{
+			// Destroy the voices playing the stream before its chunks: DestroyVoice() waits until
+			// the audio thread is done with them.
+			for(std::size_t i = 0; i < effect_slots.size(); ++i)
 			{
-				throw utility::OutOfMemoryError();
+				if(effect_slots[i].active.voice != nullptr && effect_slots[i].active.stream == slot->stream->stream.get())
+				{
+					effect_slots[i].active.voice->DestroyVoice();
+					effect_slots[i].active.voice = nullptr;
+					--voice_count;
+					--active_voice_count;
+					FreeEffectSlot(i);
+				}
 			}
 		}
+		// Delete the sound, and with it this engine's share of the audio data.
+		FreeSound(handle & HANDLE_INDEX_MASK);
 	}
 
 	// See method declaration for details.
 	void XAudio2SoundEngine::ClearSounds()
 	{
-		// Unload all of the currently loaded sound data.
-		for(SoundHandleToSound::iterator i = sounds.begin(); i != sounds.end(); ++i)
+		// Destroy the source voices which are in use first: DestroyVoice() waits until the
+		// audio thread is done with their buffers, which are about to be deleted. Idle voices
+		// hold no buffers, so they're kept.
+		for(std::size_t i = 0; i < effect_slots.size(); ++i)
 		{
-			if(i->second->second.pAudioData != nullptr)
+			IXAudio2SourceVoice* const voice = effect_slots[i].active.voice;
+			if(voice != nullptr)
 			{
-				delete[] reinterpret_cast<const unsigned char*>(i->second->second.pAudioData);
-				i->second->second.pAudioData = nullptr;
+				voice->Stop(0);
+				voice->FlushSourceBuffers();
+				voice->DestroyVoice();
+				--voice_count;
 			}
-			delete i->second;
 		}
-		sounds.clear();
-		// Destroy all of the source voices.
-		for(SoundEffectToVoice::iterator i = voices.begin(); i != voices.end(); ++i)
+		effect_slots.clear();
+		free_effect_slots.clear();
+		promotion_candidates.clear();
+		active_voice_count = 0;
+		virtual_voice_count = 0;
+		// Unload all of the currently loaded sounds and close all of the streams. Their slots
+		// move on to the next generation, so that the old handles are refused.
+		for(std::size_t i = 0; i < sound_slots.size(); ++i)
 		{
-			i->second->Stop(0);
-			i->second->FlushSourceBuffers();
-			i->second->DestroyVoice();
-		}
-		voices.clear();
-		// Reset the texture handles.
-		while(reusable_sound_handles.empty() == false)
-		{
-			reusable_sound_handles.pop();
+			if(sound_slots[i].sound != nullptr || sound_slots[i].stream != nullptr)
+			{
+				FreeSound(i);
+			}
 		}
-		next_handle = 1;
 	}
 
 	// See method declaration for details.
 	void XAudio2SoundEngine::UpdateSounds(utility::SoundEffectList& sound_effects)
 	{
-		SoundEffectToVoice::iterator voice;
-		SoundHandleToSound::iterator sound;
+		// Advance every sound effect by the time since the last update.
+		const double elapsed = clock.Reset();
+		for(std::vector<EffectSlot>::iterator slot = effect_slots.begin(); slot != effect_slots.end(); ++slot)
+		{
+			if(slot->active.voice != nullptr || slot->is_virtual == true)
+			{
+				AdvancePlayback(slot->active.playback, elapsed);
+				slot->active.playback.is_updated = false;
+			}
+		}
+		statistics.promoted_count = 0;
+		statistics.demoted_count = 0;
+
+		spatializer.Clear();
 		for(utility::SoundEffectList::iterator effect = sound_effects.begin(); effect != sound_effects.end(); ++effect)
 		{
-			sound = sounds.find((*effect)->GetSoundHandle());
-			if(sound == sounds.end())
+			spatializer.AddEffect(**effect);
+		}
+		spatializer.Spatialize(GetListenerPosition(), GetAttenuation());
+
+		std::size_t index = 0;
+		for(utility::SoundEffectList::iterator effect = sound_effects.begin(); effect != sound_effects.end(); ++effect, ++index)
+		{
+			SoundSlot* const sound = FindSound((*effect)->GetSoundHandle());
+			if(sound == nullptr)
 			{
 				throw utility::InvalidArgumentException("avl::sound::XAudio2SoundEngine::UpdateSounds()", "sound_effects", "One or more sound effects contain an invalid sound handle.");
 			}
-			voice = voices.find(*effect);
-			if(voice != voices.end())
+			const WAVEFORMATEX& format = (sound->sound != nullptr) ? sound->sound->format : sound->stream->format;
+			SoundStream* const sound_stream = (sound->stream != nullptr) ? sound->stream->stream.get() : nullptr;
+			SoundData* const sound_data = sound->sound;
+			// The slot which the effect remembers is only its own if the slot still says so.
+			unsigned int slot_index = (*effect)->GetEngineSlot();
+			if(slot_index >= effect_slots.size() || effect_slots[slot_index].effect != *effect)
+			{
+				slot_index = utility::SoundEffect::NO_ENGINE_SLOT;
+			}
+			if(slot_index != utility::SoundEffect::NO_ENGINE_SLOT)
+			{
+				EffectSlot& slot = effect_slots[slot_index];
+				// A sound effect with a virtual voice is only tracked until it can be given a real one.
+				if(slot.is_virtual == true)
+				{
+					if(sound_stream == nullptr)
+					{
+						if(UpdateVirtualVoice(slot.active.playback, **effect, *sound_data) == true)
+						{
+							slot.is_virtual = false;
+							--virtual_voice_count;
+							FreeEffectSlot(slot_index);
+						}
+						else
+						{
+							SpatializePlayback(slot.active.playback, index);
+						}
+						continue;
+					}
+					// Streams are never virtual, so start it over like any other effect without a voice.
+					slot.is_virtual = false;
+					--virtual_voice_count;
+				}
+				// If the effect has switched to a sound with another format, or to another stream,
+				// then its voice can't play it; give it up and start over with a voice of the right
+				// format.
+				else if(IsSameFormat(slot.active.format, format) == false || slot.active.stream != sound_stream)
+				{
+					ReleaseVoice(slot);
+				}
+				else
+				{
+					UpdatePlayback(slot.active.playback, **effect, sound_data);
+					SpatializePlayback(slot.active.playback, index);
+					const bool is_released = (sound_stream != nullptr) ? UpdateStreamVoice(slot.active, *(*effect))
+						: xaudio2::UpdateVoice(*(slot.active.voice), sound_data->buffer, *(*effect));
+					if(is_released == true)
+					{
+						ReleaseVoice(slot);
+						FreeEffectSlot(slot_index);
+					}
+					else if(sound_stream == nullptr && slot.active.playback.is_audible == false)
+					{
+						// Too quiet to be heard, so keep track of it with a virtual voice instead.
+						ReleaseVoice(slot);
+						slot.is_virtual = true;
+						++virtual_voice_count;
+						++statistics.demoted_count;
+					}
+					else
+					{
+						ApplySpatialization(slot.active);
+					}
+					continue;
+				}
+			}
+			// At this point the effect has no voice.
+			if((*effect)->IsPlaying() == false)
 			{
-				if(xaudio2::UpdateVoice(*(voice->second), sound->second->second, *(*effect)) == true)
+				if(slot_index != utility::SoundEffect::NO_ENGINE_SLOT)
 				{
-					voices.erase(voice);
+					FreeEffectSlot(slot_index);
 				}
+				continue;
+			}
+			if(slot_index == utility::SoundEffect::NO_ENGINE_SLOT)
+			{
+				slot_index = AcquireEffectSlot(**effect);
+			}
+			EffectSlot& slot = effect_slots[slot_index];
+			slot.active.format = format;
+			slot.active.stream = nullptr;
+			slot.active.queued_chunk_count = 0;
+			slot.active.is_stream_ended = false;
+			StartPlayback(slot.active.playback, **effect, sound_data);
+			SpatializePlayback(slot.active.playback, index);
+			IXAudio2SourceVoice* const new_voice = (slot.active.playback.is_audible == true || sound_stream != nullptr)
+				? AcquireVoice(format, slot.active.playback.rank, sound_effects) : nullptr;
+			if(new_voice == nullptr)
+			{
+				// Every voice is playing something more audible, or the effect can't be heard.
+				// Keep track of a sound sample until a voice is free, but a stream can't skip
+				// ahead, so pause it.
+				if(sound_stream != nullptr)
+				{
+					(*effect)->Pause();
+					FreeEffectSlot(slot_index);
+					continue;
+				}
+				slot.is_virtual = true;
+				++virtual_voice_count;
+				(*effect)->Reset(false);
+				continue;
+			}
+			slot.active.voice = new_voice;
+			slot.active.matrix_left_pan = -1.0f;
+			++active_voice_count;
+			if(sound_stream != nullptr)
+			{
+				// Play the stream from the beginning.
+				TakeStream(sound_stream, *effect, sound_effects);
+				sound_stream->Restart();
+				slot.active.stream = sound_stream;
+				new_voice->SetVolume((*effect)->GetVolume());
+				QueueChunks(slot.active, (*effect)->IsLooping());
+				new_voice->Start();
 			}
-			// voice == voices.end()
 			else
 			{
-				if((*effect)->IsPlaying() == true)
+				// Prepare and submit buffer.
+				xaudio2::PlayBuffer(*new_voice, sound_data->buffer, *(*effect));
+			}
+			ApplySpatialization(slot.active);
+			(*effect)->Reset(false);
+		}
+		// Recycle source voices which have finished playing and which haven't been updated, and
+		// forget the virtual voices of effects which haven't been updated.
+		CleanupVoices();
+		PromoteVoices(sound_effects);
+		statistics.real_voice_count = active_voice_count;
+		statistics.virtual_voice_count = virtual_voice_count;
+	}
+
+	// See method declaration for details.
+	const unsigned int XAudio2SoundEngine::GetActiveVoiceCount() const
+	{
+		return active_voice_count;
+	}
+
+	// See method declaration for details.
+	const unsigned int XAudio2SoundEngine::GetIdleVoiceCount() const
+	{
+		return voice_count - active_voice_count;
+	}
+
+	// See method declaration for details.
+	const unsigned int XAudio2SoundEngine::GetStolenVoiceCount() const
+	{
+		return stolen_voice_count;
+	}
+
+	// See method declaration for details.
+	const VoiceStatistics XAudio2SoundEngine::GetVoiceStatistics() const
+	{
+		return statistics;
+	}
+
+	// See method declaration for details.
+	const bool XAudio2SoundEngine::FormatLess::operator()(const WAVEFORMATEX& lhs, const WAVEFORMATEX& rhs) const
+	{
+		if(lhs.wFormatTag != rhs.wFormatTag)
+		{
+			return lhs.wFormatTag < rhs.wFormatTag;
+		}
+		if(lhs.nChannels != rhs.nChannels)
+		{
+			return lhs.nChannels < rhs.nChannels;
+		}
+		if(lhs.nSamplesPerSec != rhs.nSamplesPerSec)
+		{
+			return lhs.nSamplesPerSec < rhs.nSamplesPerSec;
+		}
+		return lhs.wBitsPerSample < rhs.wBitsPerSample;
+	}
+
+	// See method declaration for details.
+	IXAudio2SourceVoice* const XAudio2SoundEngine::AcquireVoice(const WAVEFORMATEX& format, const VoiceRank& rank, utility::SoundEffectList& sound_effects)
+	{
+		// Use an idle voice with this format if there is one.
+		FormatToVoicePool::iterator pool = voice_pools.find(format);
+		if(pool != voice_pools.end() && pool->second.empty() == false)
+		{
+			IXAudio2SourceVoice* const voice = pool->second.back();
+			pool->second.pop_back();
+			return voice;
+		}
+		// Make room for a new voice by destroying an idle voice of another format.
+		if(voice_count >= max_voice_count)
+		{
+			for(pool = voice_pools.begin(); pool != voice_pools.end(); ++pool)
+			{
+				if(pool->second.empty() == false)
 				{
-					// Create new voice.
-					IXAudio2SourceVoice* new_sound = xaudio2::CreateSourceVoice(*xaudio2, sound->second->first);
-					voices.insert(std::make_pair(*effect, new_sound));
-					// Prepare and submit buffer.
-					xaudio2::PlayBuffer(*new_sound, sound->second->second, *(*effect));
-					(*effect)->Reset(false);
+					pool->second.back()->DestroyVoice();
+					pool->second.pop_back();
+					--voice_count;
+					break;
 				}
 			}
 		}
-		// Clean up source voices which have finished playing and which haven't been updated.
-		CleanupVoices(sound_effects);
+		if(voice_count < max_voice_count)
+		{
+			IXAudio2SourceVoice* const voice = xaudio2::CreateSourceVoice(*xaudio2, format);
+			++voice_count;
+			return voice;
+		}
+		// Every voice is in use, so take the one playing the least audible sound, starting
+		// with those which are paused.
+		EffectSlot* victim = nullptr;
+		for(std::vector<EffectSlot>::iterator slot = effect_slots.begin(); slot != effect_slots.end(); ++slot)
+		{
+			if(slot->active.voice == nullptr)
+			{
+				continue;
+			}
+			if(victim == nullptr)
+			{
+				victim = &*slot;
+			}
+			else if(slot->active.playback.is_playing != victim->active.playback.is_playing)
+			{
+				if(slot->active.playback.is_playing == false)
+				{
+					victim = &*slot;
+				}
+			}
+			else if(IsMoreAudible(victim->active.playback.rank, slot->active.playback.rank) == true)
+			{
+				victim = &*slot;
+			}
+		}
+		if(victim == nullptr || (victim->active.playback.is_playing == true && IsMoreAudible(rank, victim->active.playback.rank) == false))
+		{
+			return nullptr;
+		}
+		// Give the sound effect which loses its voice a virtual voice; if it's no longer
+		// being updated, CleanupVoices() forgets it. A stream can't be virtual, so pause it.
+		const ActiveVoice stolen = victim->active;
+		victim->active.voice = nullptr;
+		--active_voice_count;
+		if(stolen.stream == nullptr)
+		{
+			victim->is_virtual = true;
+			++virtual_voice_count;
+			++statistics.demoted_count;
+		}
+		else
+		{
+			const utility::SoundEffectList::iterator effect = std::find(sound_effects.begin(), sound_effects.end(), victim->effect);
+			if(effect != sound_effects.end())
+			{
+				(*effect)->Pause();
+			}
+			FreeEffectSlot(static_cast<unsigned int>(victim - &effect_slots[0]));
+		}
+		++stolen_voice_count;
+		stolen.voice->Stop(0);
+		stolen.voice->FlushSourceBuffers();
+		if(stolen.stream != nullptr)
+		{
+			stolen.stream->Restart();
+		}
+		if(IsSameFormat(stolen.format, format) == true)
+		{
+			return stolen.voice;
+		}
+		stolen.voice->DestroyVoice();
+		--voice_count;
+		IXAudio2SourceVoice* const voice = xaudio2::CreateSourceVoice(*xaudio2, format);
+		++voice_count;
+		return voice;
 	}
 
 	// See method declaration for details.
-	void XAudio2SoundEngine::CleanupVoices(utility::SoundEffectList& sound_effects)
+	void XAudio2SoundEngine::PromoteVoices(utility::SoundEffectList& sound_effects)
 	{
-		// Iterate through voices and find any finished (buffers < 1) voices
-		// which don't have a corresponding sound sample in sounds -- delete them.
-		// Since modifying a map isn't supported while iterating through it, here
-		// we store all kept elements in a temporary map and then update the original
-		// one after we're done with modifications.
-		SoundEffectToVoice kept_voices;
-		XAUDIO2_VOICE_STATE voice_state;
-		for(auto voice = voices.begin(); voice != voices.end(); ++voice)
+		promotion_candidates.clear();
+		for(std::size_t i = 0; i < effect_slots.size(); ++i)
 		{
-			voice->second->GetState(&voice_state/*, XAUDIO2_VOICE_NOSAMPLESPLAYED*/);
-			if(voice_state.BuffersQueued < 1)
+			if(effect_slots[i].is_virtual == true && effect_slots[i].active.playback.is_playing == true && effect_slots[i].active.playback.is_audible == true)
 			{
-				utility::SoundEffectList::const_iterator effect = std::find(sound_effects.begin(), sound_effects.end(), voice->first);
-				if(effect == sound_effects.end())
+				try
 				{
-					// Delete this voice.
-					voice->second->Stop();
-					voice->second->DestroyVoice();
+					promotion_candidates.push_back(i);
 				}
-				else
+				catch(const std::bad_alloc&)
 				{
-					// Keep this voice.
-					kept_voices.insert(*voice);
+					throw utility::OutOfMemoryError();
 				}
 			}
-			else
+		}
+		const std::vector<EffectSlot>& slots = effect_slots;
+		std::sort(promotion_candidates.begin(), promotion_candidates.end(),
+			[&slots](const unsigned int slot, const unsigned int other_slot) { return IsMoreAudible(slots[slot].active.playback.rank, slots[other_slot].active.playback.rank); });
+
+		for(std::size_t i = 0; i < promotion_candidates.size(); ++i)
+		{
+			EffectSlot& candidate = effect_slots[promotion_candidates[i]];
+			// Every virtual voice left was updated, so its sound and its effect are valid.
+			const SoundData& sound = *FindSound(candidate.active.playback.handle)->sound;
+			IXAudio2SourceVoice* const voice = AcquireVoice(sound.format, candidate.active.playback.rank, sound_effects);
+			if(voice == nullptr)
+			{
+				// The rest are less audible still.
+				break;
+			}
+			candidate.is_virtual = false;
+			--virtual_voice_count;
+			candidate.active.voice = voice;
+			candidate.active.format = sound.format;
+			candidate.active.stream = nullptr;
+			candidate.active.matrix_left_pan = -1.0f;
+			++active_voice_count;
+			xaudio2::PlayBufferFrom(*voice, sound.buffer, static_cast<UINT32>(candidate.active.playback.position), *candidate.effect);
+			ApplySpatialization(candidate.active);
+			++statistics.promoted_count;
+		}
+		promotion_candidates.clear();
+	}
+
+	// See method declaration for details.
+	const bool XAudio2SoundEngine::UpdateVirtualVoice(Playback& playback, utility::SoundEffect& effect, const SoundData& sound)
+	{
+		playback.is_updated = true;
+		playback.rank.priority = effect.GetPriority();
+		playback.rank.volume = effect.GetVolume();
+		if(effect.IsPlaying() == true)
+		{
+			if(effect.IsReset() == true || effect.GetSoundHandle() != playback.handle)
+			{
+				// Start over.
+				StartPlayback(playback, effect, &sound);
+				effect.Reset(false);
+			}
+			else if(playback.position >= playback.frame_count)
 			{
-				// Keep this voice.
-				kept_voices.insert(*voice);
+				// The sound has played through.
+				effect.Pause();
+				return true;
 			}
+			playback.is_playing = true;
+			playback.is_looping = effect.IsLooping();
 		}
-		// Only preserve the kept voices.
-		voices.clear();
-		voices.insert(kept_voices.begin(), kept_voices.end());
+		// At this point: effect.IsPlaying() == false
+		else
+		{
+			if(effect.IsReset() == true)
+			{
+				// Stopped.
+				effect.Reset(false);
+				return true;
+			}
+			// Paused.
+			playback.is_playing = false;
+		}
+		return false;
+	}
+
+	// See method declaration for details.
+	void XAudio2SoundEngine::UpdatePlayback(Playback& playback, const utility::SoundEffect& effect, const SoundData* const sound)
+	{
+		if(effect.IsPlaying() == true && (effect.IsReset() == true || effect.GetSoundHandle() != playback.handle))
+		{
+			// The voice is about to start over.
+			StartPlayback(playback, effect, sound);
+		}
+		playback.is_updated = true;
+		playback.rank.priority = effect.GetPriority();
+		playback.rank.volume = effect.GetVolume();
+		playback.is_playing = effect.IsPlaying();
+		playback.is_looping = effect.IsLooping();
+	}
+
+	// See method declaration for details.
+	void XAudio2SoundEngine::SpatializePlayback(Playback& playback, const std::size_t index) const
+	{
+		playback.rank.volume = spatializer.GetGain(index);
+		playback.left_pan = spatializer.GetLeftPan(index);
+		playback.right_pan = spatializer.GetRightPan(index);
+		playback.is_positional = spatializer.IsPositional(index);
+		playback.is_audible = spatializer.IsAudible(index);
+	}
+
+	// See method declaration for details.
+	void XAudio2SoundEngine::ApplySpatialization(ActiveVoice& voice) const
+	{
+		const Playback& playback = voice.playback;
+		if(playback.is_positional == true)
+		{
+			voice.voice->SetVolume(playback.rank.volume);
+		}
+		if(output_channel_count != 2 || voice.format.nChannels > 2
+			|| (voice.matrix_left_pan == playback.left_pan && voice.matrix_right_pan == playback.right_pan))
+		{
+			return;
+		}
+		// Each row holds the levels of the source channels in one output channel.
+		const float mono_matrix[2] = {playback.left_pan, playback.right_pan};
+		const float stereo_matrix[4] = {playback.left_pan, 0.0f, 0.0f, playback.right_pan};
+		voice.voice->SetOutputMatrix(mastering_voice, voice.format.nChannels, 2, (voice.format.nChannels == 1) ? mono_matrix : stereo_matrix);
+		voice.matrix_left_pan = playback.left_pan;
+		voice.matrix_right_pan = playback.right_pan;
+	}
+
+	// See method declaration for details.
+	void XAudio2SoundEngine::StartPlayback(Playback& playback, const utility::SoundEffect& effect, const SoundData* const sound)
+	{
+		playback.handle = effect.GetSoundHandle();
+		playback.rank.priority = effect.GetPriority();
+		playback.rank.volume = effect.GetVolume();
+		playback.rank.start_order = started_voice_count++;
+		playback.position = 0.0;
+		playback.frequency = (sound != nullptr) ? sound->format.nSamplesPerSec : 0;
+		playback.frame_count = (sound != nullptr) ? sound->buffer.PlayLength : 0;
+		playback.is_playing = true;
+		playback.is_looping = effect.IsLooping();
+		playback.is_updated = true;
+		playback.left_pan = 1.0f;
+		playback.right_pan = 1.0f;
+		playback.is_positional = false;
+		playback.is_audible = true;
+	}
+
+	// See method declaration for details.
+	void XAudio2SoundEngine::AdvancePlayback(Playback& playback, const double elapsed)
+	{
+		if(playback.is_playing == false || playback.frame_count == 0)
+		{
+			return;
+		}
+		playback.position += elapsed * playback.frequency;
+		if(playback.position >= playback.frame_count)
+		{
+			playback.position = (playback.is_looping == true) ? std::fmod(playback.position, static_cast<double>(playback.frame_count)) : playback.frame_count;
+		}
+	}
+
+	// See method declaration for details.
+	void XAudio2SoundEngine::ReleaseVoice(EffectSlot& slot)
+	{
+		const ActiveVoice released = slot.active;
+		slot.active.voice = nullptr;
+		--active_voice_count;
+		RecycleVoice(released);
+	}
+
+	// See method declaration for details.
+	void XAudio2SoundEngine::RecycleVoice(const ActiveVoice& voice)
+	{
+		voice.voice->Stop(0);
+		voice.voice->FlushSourceBuffers();
+		if(voice.stream != nullptr)
+		{
+			// The chunks stay allocated, so at worst the reader refills one which the audio
+			// thread is still letting go of, and which is never heard.
+			voice.stream->Restart();
+		}
+		try
+		{
+			voice_pools[voice.format].push_back(voice.voice);
+		}
+		catch(const std::bad_alloc&)
+		{
+			voice.voice->DestroyVoice();
+			--voice_count;
+			throw utility::OutOfMemoryError();
+		}
+	}
+
+	// See method declaration for details.
+	const bool XAudio2SoundEngine::UpdateStreamVoice(ActiveVoice& voice, utility::SoundEffect& effect)
+	{
+		voice.voice->SetVolume(effect.GetVolume());
+		// Buffers are played in the order they're queued, so those which are no longer queued
+		// hold the oldest chunks.
+		XAUDIO2_VOICE_STATE voice_state;
+		voice.voice->GetState(&voice_state);
+		while(voice.queued_chunk_count > voice_state.BuffersQueued)
+		{
+			voice.stream->ReleaseChunk();
+			--voice.queued_chunk_count;
+		}
+
+		if(effect.IsPlaying() == true)
+		{
+			const bool is_played_through = (voice.is_stream_ended == true && voice.queued_chunk_count == 0);
+			if(effect.IsReset() == true || (is_played_through == true && effect.IsLooping() == true))
+			{
+				// Start over.
+				voice.voice->Stop(0);
+				voice.voice->FlushSourceBuffers();
+				voice.stream->Restart();
+				voice.queued_chunk_count = 0;
+				voice.is_stream_ended = false;
+				effect.Reset(false);
+			}
+			else if(is_played_through == true)
+			{
+				// Release voice.
+				effect.Pause();
+				return true;
+			}
+			QueueChunks(voice, effect.IsLooping());
+			voice.voice->Start();
+		}
+		// At this point: effect.IsPlaying() == false
+		else
+		{
+			if(effect.IsReset() == true)
+			{
+				// Release voice.
+				effect.Reset(false);
+				return true;
+			}
+			// Stop the voice & pause the effect.
+			voice.voice->Stop();
+		}
+		return false;
+	}
+
+	// See method declaration for details.
+	void XAudio2SoundEngine::QueueChunks(ActiveVoice& voice, const bool is_looping)
+	{
+		SoundStream::Chunk chunk;
+		while(voice.is_stream_ended == false && voice.queued_chunk_count < voice.stream->GetChunkCount() && voice.stream->AcquireChunk(chunk) == true)
+		{
+			const bool is_end = (chunk.is_last == true && is_looping == false);
+			xaudio2::SubmitChunk(*voice.voice, chunk, is_end);
+			++voice.queued_chunk_count;
+			voice.is_stream_ended = is_end;
+		}
+	}
+
+	// See method declaration for details.
+	void XAudio2SoundEngine::TakeStream(const SoundStream* const stream, const utility::SoundEffect* const effect, utility::SoundEffectList& sound_effects)
+	{
+		for(std::size_t i = 0; i < effect_slots.size(); ++i)
+		{
+			EffectSlot& slot = effect_slots[i];
+			if(slot.active.voice != nullptr && slot.active.stream == stream && slot.effect != effect)
+			{
+				const utility::SoundEffectList::iterator other = std::find(sound_effects.begin(), sound_effects.end(), slot.effect);
+				if(other != sound_effects.end())
+				{
+					(*other)->Pause();
+				}
+				ReleaseVoice(slot);
+				FreeEffectSlot(i);
+			}
+		}
+	}
+
+	// See method declaration for details.
+	void XAudio2SoundEngine::PrewarmVoices(const WAVEFORMATEX& format)
+	{
+		FormatToVoicePool::iterator pool = voice_pools.find(format);
+		if(pool != voice_pools.end())
+		{
+			return;
+		}
+		try
+		{
+			pool = voice_pools.insert(std::make_pair(format, std::vector<IXAudio2SourceVoice*>())).first;
+			pool->second.reserve(prewarmed_voice_count);
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw utility::OutOfMemoryError();
+		}
+		while(pool->second.size() < prewarmed_voice_count && voice_count < max_voice_count)
+		{
+			pool->second.push_back(xaudio2::CreateSourceVoice(*xaudio2, format));
+			++voice_count;
+		}
+	}
+
+	// See method declaration for details.
+	void XAudio2SoundEngine::CleanupVoices()
+	{
+		// Find the slots whose sound effects are no longer being updated. Recycle their voices
+		// once they're finished (buffers < 1), and forget their virtual voices.
+		XAUDIO2_VOICE_STATE voice_state;
+		for(std::size_t i = 0; i < effect_slots.size(); ++i)
+		{
+			EffectSlot& slot = effect_slots[i];
+			if(slot.active.playback.is_updated == true || slot.effect == nullptr)
+			{
+				continue;
+			}
+			if(slot.is_virtual == true)
+			{
+				slot.is_virtual = false;
+				--virtual_voice_count;
+				FreeEffectSlot(i);
+			}
+			else if(slot.active.voice != nullptr)
+			{
+				slot.active.voice->GetState(&voice_state/*, XAUDIO2_VOICE_NOSAMPLESPLAYED*/);
+				if(voice_state.BuffersQueued < 1)
+				{
+					ReleaseVoice(slot);
+					FreeEffectSlot(i);
+				}
+			}
+		}
+	}
+
+	// See method declaration for details.
+	const bool XAudio2SoundEngine::IsSameFormat(const WAVEFORMATEX& lhs, const WAVEFORMATEX& rhs)
+	{
+		const FormatLess is_before = FormatLess();
+		return is_before(lhs, rhs) == false && is_before(rhs, lhs) == false;
 	}
 
 	// See method declaration for details.
 	void XAudio2SoundEngine::ReleaseResources()
 	{
-		// Clear all sound data and voices.
+		// Clear all sound data and active voices.
 		ClearSounds();
+		// Destroy the idle voices.
+		for(FormatToVoicePool::iterator pool = voice_pools.begin(); pool != voice_pools.end(); ++pool)
+		{
+			for(std::size_t i = 0; i < pool->second.size(); ++i)
+			{
+				pool->second[i]->DestroyVoice();
+			}
+		}
+		voice_pools.clear();
+		voice_count = 0;
 		// Destroy the mastering voice.
 		if(mastering_voice != nullptr)
 		{
 			mastering_voice->DestroyVoice();
 			mastering_voice = nullptr;
 		}
-		// Destroy the XAudio2 interface.
+		// Release the XAudio2 interface.
 		if(xaudio2 != nullptr)
 		{
 			xaudio2->Release();
 			xaudio2 = nullptr;
 		}
-		CoUninitialize();
+		if(is_xaudio2_external == false)
+		{
+			CoUninitialize();
+		}
+	}
+
+	// See method declaration for details.
+	const utility::SoundEffect::SoundHandle XAudio2SoundEngine::StoreSound(SoundData* const sound, StreamData* const stream)
+	{
+		// Reuse an empty slot if there is one.
+		unsigned int index;
+		try
+		{
+			if(free_sound_slots.empty() == false)
+			{
+				index = free_sound_slots.back();
+				free_sound_slots.pop_back();
+			}
+			else
+			{
+				if(sound_slots.size() > HANDLE_INDEX_MASK)
+				{
+					throw utility::Exception("avl::sound::XAudio2SoundEngine::StoreSound() -- Every sound handle is in use.");
+				}
+				index = sound_slots.size();
+				const SoundSlot empty_slot = {1, nullptr, nullptr};
+				sound_slots.push_back(empty_slot);
+			}
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw utility::OutOfMemoryError();
+		}
+		SoundSlot& slot = sound_slots[index];
+		slot.sound = sound;
+		slot.stream = stream;
+		return (slot.generation << HANDLE_INDEX_BITS) | index;
+	}
+
+	// See method declaration for details.
+	XAudio2SoundEngine::SoundSlot* const XAudio2SoundEngine::FindSound(const utility::SoundEffect::SoundHandle handle)
+	{
+		const unsigned int index = handle & HANDLE_INDEX_MASK;
+		if(index >= sound_slots.size())
+		{
+			return nullptr;
+		}
+		SoundSlot& slot = sound_slots[index];
+		if(slot.generation != (handle >> HANDLE_INDEX_BITS) || (slot.sound == nullptr && slot.stream == nullptr))
+		{
+			return nullptr;
+		}
+		return &slot;
+	}
+
+	// See method declaration for details.
+	void XAudio2SoundEngine::FreeSound(const unsigned int index)
+	{
+		SoundSlot& slot = sound_slots[index];
+		delete slot.sound;
+		delete slot.stream;
+		slot.sound = nullptr;
+		slot.stream = nullptr;
+		// Generation 0 is skipped, so that no handle is 0.
+		slot.generation = (slot.generation < MAX_HANDLE_GENERATION) ? slot.generation + 1 : 1;
+		try
+		{
+			free_sound_slots.push_back(index);
+		}
+		catch(const std::bad_alloc&)
+		{
+			// Leaks the slot until the next time ClearSounds() is called.
+			throw utility::OutOfMemoryError();
+		}
+	}
+
+	// See method declaration for details.
+	const unsigned int XAudio2SoundEngine::AcquireEffectSlot(utility::SoundEffect& effect)
+	{
+		unsigned int index;
+		try
+		{
+			if(free_effect_slots.empty() == false)
+			{
+				index = free_effect_slots.back();
+				free_effect_slots.pop_back();
+			}
+			else
+			{
+				index = effect_slots.size();
+				effect_slots.push_back(EffectSlot());
+			}
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw utility::OutOfMemoryError();
+		}
+		EffectSlot& slot = effect_slots[index];
+		slot.effect = &effect;
+		slot.active.voice = nullptr;
+		slot.is_virtual = false;
+		effect.SetEngineSlot(index);
+		return index;
+	}
+
+	// See method declaration for details.
+	void XAudio2SoundEngine::FreeEffectSlot(const unsigned int index)
+	{
+		ASSERT(effect_slots[index].active.voice == nullptr && effect_slots[index].is_virtual == false);
+		effect_slots[index].effect = nullptr;
+		try
+		{
+			free_effect_slots.push_back(index);
+		}
+		catch(const std::bad_alloc&)
+		{
+			// Leaks the slot until the next time ClearSounds() is called.
+			throw utility::OutOfMemoryError();
+		}
 	}
 
 
@@ -25,9 +25,14 @@ Defines the \ref avl::sound::XAudio2SoundEngine class.
 */
 
 #include"..\sound engine\sound engine.h"
+#include"..\sound stream\sound stream.h"
+#include"..\spatialization\spatialization.h"
 #include"..\..\..\utility\src\sound effect\sound effect.h"
+#include"..\..\..\utility\src\timer\timer.h"
 #include<map>
-#include<queue>
+#include<vector>
+#include<memory>
+#include<string>
 #include<xaudio2.h>
 
 
@@ -39,46 +44,116 @@ namespace sound
 	/**
 	Implements the \ref avl::sound::SoundEngine interface using the XAudio2
 	API.
-	@todo DestroyVoice() is a blocking function, so calling it from within UpdateSounds()
-	often is a bad idea. Consider using some voice pooling strategies (i.e. a vector of
-	source voices).
+	@par Voice pooling:
+	Creating and destroying source voices is expensive (DestroyVoice() blocks until the
+	audio thread lets go of the voice), so voices are never destroyed when a sound finishes.
+	Instead they're stopped and returned to a pool of idle voices with the same format, from
+	which the next sound of that format is played. When the first sound of a format is added,
+	a few voices are created for it up front so that playing it doesn't create any.
+	@par Voice virtualization:
+	No more than a fixed number of voices exist at once. When a sound needs a voice and none
+	is idle, the voice of the least audible sound (see \ref SoundEngine::IsMoreAudible()) is
+	taken from it, if the new sound is more audible; paused sounds lose their voices first.
+	A sound sample which loses its voice, or which never gets one, is given a virtual voice:
+	its position keeps advancing by the engine's clock, and once a voice is free or a less
+	audible sound holds one, it's given a real voice again, starting from that position. So
+	every effect's position is tracked by the clock rather than read from its voice. A
+	stream which loses its voice is paused, since its reader can't skip ahead.
+	@par Streams:
+	A voice playing a stream keeps every chunk which the stream has read ahead queued on
+	it, submitting each chunk as its own buffer and releasing it back to the stream once the
+	voice has played it. So chunks are only refilled as fast as \ref UpdateSounds() is
+	called: a stream's chunks must hold more audio than passes between updates.
+	@par Lookups:
+	Sounds are kept in a table of slots, and a sound handle holds both the index of its
+	slot and the slot's generation, which counts up each time the slot is emptied; so
+	finding a sound is an index and a comparison, and handles to deleted sounds are
+	refused rather than reused. Likewise, the state of each sound effect with a voice is
+	kept in a slot whose index the effect remembers (see
+	\ref utility::SoundEffect::SetEngineSlot()), so \ref UpdateSounds() is a single pass
+	over the sound effects without any searching.
+	@par Positional audio:
+	Each update spatializes every updated sound effect in one batch first. A positional
+	effect's voice plays at its attenuated volume, and when the mastering voice is stereo,
+	each voice playing a mono or stereo sound is sent to the left and right by an output
+	matrix: a positional effect's pans, or in full for any other effect. Positional sound
+	samples which are too quiet to be heard are given virtual voices, whatever their
+	priority, and only get real voices back once they can be heard again.
+	@par Buses:
+	Every voice is sent straight to the mastering voice, so a sound effect's bus (see
+	utility::SoundEffect::SetBus()) doesn't change how it's played.
 	*/
 	class XAudio2SoundEngine: public SoundEngine
 	{
 	public:
 		/** Basic constructor.
+		@param max_voices The most source voices which may exist at once, across all formats.
+		@param prewarmed_voices The number of voices to create for each format as soon as the
+		first sound with that format is added.
+		@throws InvalidArgumentException If \a max_voices is 0.
 		@throws Exception If unable to acquire one of the XAudio2 objects.
 		*/
-		XAudio2SoundEngine();
+		XAudio2SoundEngine(const unsigned int max_voices = 64, const unsigned int prewarmed_voices = 4);
+
+		/** Constructs a sound engine which plays through an existing XAudio2 interface rather
+		than creating its own, so that it may be tested against a stand-in implementation.
+		@param xaudio2_interface The interface to play through. The engine holds a reference
+		to it until it's destroyed.
+		@param max_voices The most source voices which may exist at once, across all formats.
+		@param prewarmed_voices The number of voices to create for each format as soon as the
+		first sound with that format is added.
+		@throws InvalidArgumentException If \a max_voices is 0.
+		@throws Exception If unable to create the mastering voice.
+		*/
+		XAudio2SoundEngine(IXAudio2& xaudio2_interface, const unsigned int max_voices = 64, const unsigned int prewarmed_voices = 4);
 
 		/** Basic destructor.
 		*/
 		~XAudio2SoundEngine();
 
-		/** Makes it possible to play \a new_sample using the returned sound handle.
+		/** Makes it possible to play \a new_sample using the returned sound handle. The audio
+		data is shared with \a new_sample rather than copied, except that ADPCM is decoded
+		to 16-bit PCM here: XAudio2 plays Microsoft ADPCM but not IMA ADPCM, and decoding
+		both keeps every voice in the pools PCM.
 		@param new_sample The sample to be stored internally and accessed via the
 		returned sound handle.
 		@return The sound handle by which \a new_sample is to be accessed.
 		@throw InvalidArgumentException If the \a new_sample audio data is null.
 		@throw InvalidArgumentException If the \a new_sample bit depth is not 8, 16, or 32.
+		@throw InvalidArgumentException If the \a new_sample is ADPCM with an unsupported block
+		layout, or holds fewer frames than it claims.
 		@throw InvalidArgumentException If the \a new_sample audio data is too large to fit
 		into a single buffer. See the XAudio2 constant XAUDIO2_MAX_BUFFER_BYTES.
-		@throw OutOfMemoryError If there's not enough memory to copy the audio data.
+		@throw OutOfMemoryError If there's not enough memory to store the sound.
+		@throw Exception If unable to create the voices for a new format.
 		*/
 		const utility::SoundEffect::SoundHandle AddSound(const sound::SoundSample& new_sample);
 
-		/** Removes the sound sample associated with \a handle from memory, making
-		it no longer accessible.
-		@post Don't try playing any sounds whose sound handles have been deleted.
-		@param handle The handle to the sound sample which is to be deleted.
+		/** Makes it possible to play the WAV file named \a file_name, a chunk at a time, using
+		the returned sound handle.
+		@param file_name The name of the WAV file to be streamed.
+		@return The sound handle by which the stream is to be accessed.
+		@throw InvalidArgumentException If the file's bit depth is not 8, 16, 24, or 32.
+		@throw OutOfMemoryError If there's not enough memory to open the stream.
+		@throw Exception See \ref avl::sound::SoundStream::SoundStream(); or if unable to
+		create the voices for a new format.
+		*/
+		const utility::SoundEffect::SoundHandle AddStream(const std::string& file_name);
+
+		/** Removes the sound sample or stream associated with \a handle from memory, making
+		it no longer accessible. Voices playing a stream are destroyed along with it.
+		@post \a handle is refused by \ref UpdateSounds() from then on.
+		@param handle The handle to the sound which is to be deleted.
 		@throw utility::OutOfMemoryError If we run out of memory.
 		*/
 		void DeleteSound(const utility::SoundEffect::SoundHandle& handle);
 
 		/** Stops all currently playing sounds and deallocates all memory storing
 		sounds and sound data, and renders all currently issued sound handles invalid
-		@post Any previously issued sound handles will be rendered invalid, and
-		may in the future become associated with different sounds.
+		@post Any previously issued sound handles will be rendered invalid, and are
+		refused by \ref UpdateSounds().
+		@post The voices which were playing are destroyed, but idle voices are kept
+		for the next sounds with the same formats.
 		*/
 		void ClearSounds();
 
@@ -92,48 +167,356 @@ namespace sound
 		*/
 		void UpdateSounds(utility::SoundEffectList& sound_effects);
 
+		/** Gets the number of voices which are currently assigned to sound effects.
+		@return The number of active voices.
+		*/
+		const unsigned int GetActiveVoiceCount() const;
+
+		/** Gets the number of voices which are waiting in the pools to be used again.
+		@return The number of idle voices.
+		*/
+		const unsigned int GetIdleVoiceCount() const;
+
+		/** Gets the number of times that a voice has been taken from one sound effect
+		to play another.
+		@return The number of stolen voices.
+		*/
+		const unsigned int GetStolenVoiceCount() const;
+
+		/** Counts the sound effects with real and virtual voices as of the last call to
+		UpdateSounds(). Real voices include those of paused effects, which keep them until
+		they're taken.
+		@return The counts.
+		*/
+		const VoiceStatistics GetVoiceStatistics() const;
+
 
 	private:
 
-		/** Deletes all unused voices.
-		@param sound_effects Used to determine whether or not a voice is still
-		in use.
-		@todo See if there's a more elegant way of cleaning up a map.
+		/** Orders audio formats so that they may key the voice pools. Only the fields
+		which are set by xaudio2::ExtractPCMFormatData() are compared.
+		*/
+		struct FormatLess
+		{
+			/** Compares two formats.
+			@param lhs The left-hand format.
+			@param rhs The right-hand format.
+			@return True if \a lhs is ordered before \a rhs.
+			*/
+			const bool operator()(const WAVEFORMATEX& lhs, const WAVEFORMATEX& rhs) const;
+		};
+
+		/** Contains all of the information about a sound sample
+		necessary to play that sample.
+		*/
+		struct SoundData
+		{
+			/// The format of the sample's audio data.
+			WAVEFORMATEX format;
+			/// The buffer which plays the sample; points into \ref audio_data.
+			XAUDIO2_BUFFER buffer;
+			/// The sample's audio data, shared with the sample.
+			std::shared_ptr<const char> audio_data;
+		};
+
+		/** Contains a stream and the format of its audio data.
+		*/
+		struct StreamData
+		{
+			/// The format of the stream's audio data.
+			WAVEFORMATEX format;
+			/// The stream.
+			std::unique_ptr<SoundStream> stream;
+		};
+
+		/** Holds a sound sample or a stream, indexed by the sound handles which refer to it.
+		*/
+		struct SoundSlot
+		{
+			/// Counts up each time the slot is emptied, so that handles to the sounds which it
+			/// used to hold are refused.
+			unsigned int generation;
+			/// The sound sample in the slot, if any.
+			SoundData* sound;
+			/// The stream in the slot, if any.
+			StreamData* stream;
+		};
+
+		/** Where a sound effect is in its sound, as tracked by the engine's clock, and how much
+		it deserves a real voice.
+		*/
+		struct Playback
+		{
+			/// The handle of the sound being played.
+			utility::SoundEffect::SoundHandle handle;
+			/// How much the sound effect deserves a real voice.
+			VoiceRank rank;
+			/// The position in the sound, in frames. Not tracked for streams.
+			double position;
+			/// The number of frames per second of the sound, or 0 for a stream.
+			unsigned int frequency;
+			/// The number of frames in the sound, or 0 for a stream.
+			UINT32 frame_count;
+			/// Was the sound effect playing as of the last update?
+			bool is_playing;
+			/// Was the sound effect looping as of the last update?
+			bool is_looping;
+			/// Set when the sound effect is updated, so that orphaned slots can be found.
+			bool is_updated;
+			/// How much of the sound effect is sent to the left, in stereo.
+			float left_pan;
+			/// How much of the sound effect is sent to the right, in stereo.
+			float right_pan;
+			/// Is the sound effect positional? Its voice's volume is set to its attenuated
+			/// volume if so.
+			bool is_positional;
+			/// Is the sound effect loud enough to be heard?
+			bool is_audible;
+		};
+
+		/** A source voice which is assigned to a sound effect.
+		*/
+		struct ActiveVoice
+		{
+			/// The source voice, or nullptr if the sound effect doesn't have one.
+			IXAudio2SourceVoice* voice;
+			/// The format which the voice was created with.
+			WAVEFORMATEX format;
+			/// The sound effect's place in its sound.
+			Playback playback;
+			/// The stream which the voice plays, or nullptr if it plays a sound sample.
+			SoundStream* stream;
+			/// The number of chunks of \ref stream which are queued on the voice.
+			unsigned int queued_chunk_count;
+			/// Has the last chunk which the voice will play been queued?
+			bool is_stream_ended;
+			/// The left pan in the voice's output matrix, or a negative number if the voice's
+			/// output matrix hasn't been set since it was assigned.
+			float matrix_left_pan;
+			/// The right pan in the voice's output matrix.
+			float matrix_right_pan;
+		};
+
+		/** Holds the state of a sound effect which has a real or a virtual voice. The sound
+		effect remembers the index of its slot; see utility::SoundEffect::SetEngineSlot().
 		*/
-		void CleanupVoices(utility::SoundEffectList& sound_effects);
+		struct EffectSlot
+		{
+			/// The sound effect, or nullptr if the slot is free. Only dereferenced while the
+			/// sound effect is being updated.
+			const utility::SoundEffect* effect;
+			/// The sound effect's real voice, if it has one, and its playback either way.
+			ActiveVoice active;
+			/// Does the sound effect have a virtual voice?
+			bool is_virtual;
+		};
+
+		/** Gets a voice from the pool for \a format, creating or stealing one if the pool is empty.
+		@param format The format of the sound which is to be played.
+		@param rank The rank of the sound which is to be played.
+		@param sound_effects The sound effects being updated, so that a sound effect which
+		plays a stream may be paused if its voice is stolen.
+		@return The voice, or nullptr if every voice is playing a more audible sound.
+		@throw Exception If unable to create a source voice.
+		*/
+		IXAudio2SourceVoice* const AcquireVoice(const WAVEFORMATEX& format, const VoiceRank& rank, utility::SoundEffectList& sound_effects);
+
+		/** Gives real voices to the most audible sound effects with virtual voices, for as
+		long as there are voices free or held by less audible sounds. Each starts playing
+		from its virtual voice's position.
+		@param sound_effects The sound effects being updated.
+		@throw Exception If unable to create a source voice, or to play a buffer.
+		@throw OutOfMemoryError If unable to allocate necessary storage.
+		*/
+		void PromoteVoices(utility::SoundEffectList& sound_effects);
+
+		/** Brings a virtual voice up to date with its sound effect.
+		@param playback The virtual voice.
+		@param effect The sound effect which \a playback tracks.
+		@param sound The sound which \a effect refers to.
+		@return True if \a playback is no longer needed by \a effect: it was stopped, or it
+		reached the end of its sound without looping, in which case it's paused.
+		*/
+		const bool UpdateVirtualVoice(Playback& playback, utility::SoundEffect& effect, const SoundData& sound);
+
+		/** Brings the playback of a real voice up to date with its sound effect, before the
+		voice itself is.
+		@param playback The playback.
+		@param effect The sound effect which \a playback tracks.
+		@param sound The sound which \a effect refers to, or nullptr if it's a stream.
+		*/
+		void UpdatePlayback(Playback& playback, const utility::SoundEffect& effect, const SoundData* const sound);
+
+		/** Brings a playback's volume and panning up to date with its sound effect's.
+		@param playback The playback.
+		@param index The index of the sound effect in \ref spatializer.
+		*/
+		void SpatializePlayback(Playback& playback, const std::size_t index) const;
+
+		/** Sets a real voice's volume and output matrix, if its sound effect's spatialization
+		calls for them. Called after the voice has been brought up to date with the effect.
+		@param voice The voice.
+		*/
+		void ApplySpatialization(ActiveVoice& voice) const;
+
+		/** Starts tracking a sound effect from the beginning of its sound.
+		@param playback [OUT] The playback.
+		@param effect The sound effect.
+		@param sound The sound which \a effect refers to, or nullptr if it's a stream.
+		*/
+		void StartPlayback(Playback& playback, const utility::SoundEffect& effect, const SoundData* const sound);
+
+		/** Advances a playback by the time since the last update, if it was playing.
+		@param playback The playback.
+		@param elapsed The number of seconds since the last update.
+		*/
+		static void AdvancePlayback(Playback& playback, const double elapsed);
+
+		/** Takes a sound effect's voice from it, and returns the voice to the pool for its
+		format.
+		@param slot The sound effect's slot, which must have a real voice.
+		@throw OutOfMemoryError If unable to grow the pool, in which case the voice is destroyed.
+		*/
+		void ReleaseVoice(EffectSlot& slot);
+
+		/** Stops a voice and returns it to the pool for its format. If it was playing a
+		stream, the stream is restarted, which releases its chunks.
+		@param voice The voice to recycle, which no sound effect has any longer.
+		@throw OutOfMemoryError If unable to grow the pool, in which case the voice is destroyed.
+		*/
+		void RecycleVoice(const ActiveVoice& voice);
+
+		/** Brings a voice which plays a stream up to date with its sound effect: releases the
+		chunks which it has played, and queues those which have been read since.
+		@param voice The voice.
+		@param effect The sound effect which \a voice plays.
+		@return True if \a voice is no longer needed by \a effect.
+		@throw Exception If unable to submit a chunk.
+		*/
+		const bool UpdateStreamVoice(ActiveVoice& voice, utility::SoundEffect& effect);
+
+		/** Queues as many of a stream's chunks on its voice as have been read, stopping after
+		the last chunk of a pass unless the stream is looping.
+		@param voice The voice.
+		@param is_looping Is the voice's sound effect looping?
+		@throw Exception If unable to submit a chunk.
+		*/
+		void QueueChunks(ActiveVoice& voice, const bool is_looping);
+
+		/** Takes a stream from any voice playing it other than that of \a effect. The sound
+		effect which loses the stream is paused.
+		@param stream The stream.
+		@param effect The sound effect which is taking the stream.
+		@param sound_effects The sound effects being updated.
+		*/
+		void TakeStream(const SoundStream* const stream, const utility::SoundEffect* const effect, utility::SoundEffectList& sound_effects);
+
+		/** Creates the pool for a format which hasn't been seen before, and fills it with up
+		to \ref prewarmed_voice_count voices without exceeding \ref max_voice_count.
+		@param format The format of the voices to create. Nothing happens if its pool
+		already exists.
+		@throw Exception If unable to create a source voice.
+		@throw OutOfMemoryError If unable to grow the pool.
+		*/
+		void PrewarmVoices(const WAVEFORMATEX& format);
+
+		/** Frees the slots of sound effects which weren't updated, once they're no longer
+		heard: their voices are recycled once they've finished, and their virtual voices are
+		forgotten.
+		*/
+		void CleanupVoices();
+
+		/** Compares the fields of two formats which matter for a source voice.
+		@param lhs The first format.
+		@param rhs The second format.
+		@return True if a voice created with \a lhs can play sounds with \a rhs.
+		*/
+		static const bool IsSameFormat(const WAVEFORMATEX& lhs, const WAVEFORMATEX& rhs);
 
 		/** Deletes all sound data, voices, and all other resources.
 		*/
 		void ReleaseResources();
 
-		/// Keeps track of which sound handles have already been issued.
-		utility::SoundEffect::SoundHandle next_handle;
-		/// Keeps track of sound handles which have been freed so that they may be reused.
-		std::queue<utility::SoundEffect::SoundHandle> reusable_sound_handles;
+		/** Stores a sound sample or a stream in a free slot, and issues the handle to it.
+		@param sound The sound sample, or nullptr.
+		@param stream The stream, or nullptr.
+		@return The sound handle.
+		@throw OutOfMemoryError If unable to grow the slots.
+		@throw Exception If every handle is in use.
+		*/
+		const utility::SoundEffect::SoundHandle StoreSound(SoundData* const sound, StreamData* const stream);
 
-		/** Contains all of the information about a sound sample
-		necessary to play that sample.
+		/** Finds the slot which a sound handle refers to.
+		@param handle The sound handle.
+		@return The slot, or nullptr if \a handle doesn't refer to a sound which is loaded.
+		*/
+		SoundSlot* const FindSound(const utility::SoundEffect::SoundHandle handle);
+
+		/** Deletes the sound in a slot, and frees the slot. Handles to the sound are refused
+		from then on.
+		@param index The index of the slot.
+		@throw OutOfMemoryError If unable to grow the list of free slots.
+		*/
+		void FreeSound(const unsigned int index);
+
+		/** Gives a sound effect a slot.
+		@param effect The sound effect.
+		@return The index of the slot.
+		@throw OutOfMemoryError If unable to grow the slots.
 		*/
-		typedef std::pair<WAVEFORMATEX, XAUDIO2_BUFFER> SoundData;
-		/** Maps sound handles to the format information and buffers which
-		represent that sound.
+		const unsigned int AcquireEffectSlot(utility::SoundEffect& effect);
+
+		/** Frees a sound effect's slot, which must have neither a real nor a virtual voice.
+		The sound effect isn't dereferenced.
+		@param index The index of the slot.
+		@throw OutOfMemoryError If unable to grow the list of free slots.
 		*/
-		typedef std::map<const utility::SoundEffect::SoundHandle, SoundData* const> SoundHandleToSound;
+		void FreeEffectSlot(const unsigned int index);
 
-		/** Maps sound effect addresses to source voices, but never dereferences
-		these addresses.
+		/** Maps audio formats to the idle voices which were created with them.
 		*/
-		typedef std::map<const utility::SoundEffect*, IXAudio2SourceVoice* const> SoundEffectToVoice;
+		typedef std::map<WAVEFORMATEX, std::vector<IXAudio2SourceVoice*>, FormatLess> FormatToVoicePool;
 
 		/// The XAudio2 interface.
 		IXAudio2* xaudio2;
+		/// Were we given \ref xaudio2, rather than creating it and initializing COM ourselves?
+		const bool is_xaudio2_external;
 		/// The mastering voice through which all source voices are played.
 		IXAudio2MasteringVoice* mastering_voice;
-		/// All currently loaded sounds and their associated sound handles.
-		SoundHandleToSound sounds;
-		/// All currently active source voices and their associated sound effect
-		/// addresses.
-		SoundEffectToVoice voices;
+		/// The number of channels which the mastering voice mixes.
+		UINT32 output_channel_count;
+		/// Works out the volumes and panning of the effects being updated.
+		Spatializer spatializer;
+		/// The currently loaded sounds and open streams, indexed by their sound handles.
+		std::vector<SoundSlot> sound_slots;
+		/// The indices of the empty sound slots.
+		std::vector<unsigned int> free_sound_slots;
+		/// The state of each sound effect with a real or a virtual voice.
+		std::vector<EffectSlot> effect_slots;
+		/// The indices of the free effect slots.
+		std::vector<unsigned int> free_effect_slots;
+		/// The slots of the virtual voices which may be promoted, while PromoteVoices() ranks them.
+		std::vector<unsigned int> promotion_candidates;
+		/// Measures the time between updates, to advance playbacks by.
+		utility::Timer clock;
+		/// The counts of real and virtual voices, as of the last update.
+		VoiceStatistics statistics;
+		/// The idle voices for each format which has been played.
+		FormatToVoicePool voice_pools;
+		/// The most voices which may exist at once, active or idle.
+		const unsigned int max_voice_count;
+		/// The number of voices to create for each new format.
+		const unsigned int prewarmed_voice_count;
+		/// The number of voices which currently exist, active or idle.
+		unsigned int voice_count;
+		/// The number of voices which are assigned to sound effects.
+		unsigned int active_voice_count;
+		/// The number of sound effects with virtual voices.
+		unsigned int virtual_voice_count;
+		/// The number of sound effects which have started playing, for ordering them.
+		unsigned int started_voice_count;
+		/// The number of voices which have been stolen.
+		unsigned int stolen_voice_count;
 
 		/// NOT IMPLEMENTED.
 		XAudio2SoundEngine(const XAudio2SoundEngine&);
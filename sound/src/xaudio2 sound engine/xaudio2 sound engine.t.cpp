@@ -24,20 +24,599 @@ Unit test for the xaudio2 sound engine component. See "xaudio2 sound engine.h" f
 #include"xaudio2 sound engine.h"
 #include"..\sound sample\sound sample.h"
 #include"..\load wav file\load wav file.h"
+#include"..\wav file sink\wav file sink.h"
 #include"..\..\..\utility\src\sound effect\sound effect.h"
+#include"..\..\..\utility\src\vector\vector.h"
 #include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include"..\..\..\utility\src\timer\timer.h"
 #include<new>
 #include<iostream>
 #include<cmath>
+#include<vector>
+#include<algorithm>
+#include<cstring>
+#include<xaudio2.h>
+#include<Windows.h>
 
 using avl::sound::XAudio2SoundEngine;
+using avl::sound::WAVFileSink;
 using avl::sound::SoundSample;
 using avl::sound::LoadWAVFile;
 using avl::utility::SoundEffect;
 using avl::utility::SoundEffectList;
 
+
+
+// Anonymous namespace.
+namespace
+{
+	SoundSample MakeSample(const unsigned int frequency, const unsigned int channel_count, const std::size_t frame_count);
+	class StandInXAudio2;
+
+
+
+	/** Implements the parts of the IXAudio2Voice interface which the sound engine doesn't
+	use, or which a stand-in voice can ignore.
+	*/
+	template<class Interface>
+	class StandInVoice: public Interface
+	{
+	public:
+		void __stdcall GetVoiceDetails(XAUDIO2_VOICE_DETAILS* details) {}
+		HRESULT __stdcall SetOutputVoices(const XAUDIO2_VOICE_SENDS* sends) {return S_OK;}
+		HRESULT __stdcall SetEffectChain(const XAUDIO2_EFFECT_CHAIN* chain) {return S_OK;}
+		HRESULT __stdcall EnableEffect(UINT32 index, UINT32 operation_set) {return S_OK;}
+		HRESULT __stdcall DisableEffect(UINT32 index, UINT32 operation_set) {return S_OK;}
+		void __stdcall GetEffectState(UINT32 index, BOOL* enabled) {}
+		HRESULT __stdcall SetEffectParameters(UINT32 index, const void* parameters, UINT32 size, UINT32 operation_set) {return S_OK;}
+		HRESULT __stdcall GetEffectParameters(UINT32 index, void* parameters, UINT32 size) {return S_OK;}
+		HRESULT __stdcall SetFilterParameters(const XAUDIO2_FILTER_PARAMETERS* parameters, UINT32 operation_set) {return S_OK;}
+		void __stdcall GetFilterParameters(XAUDIO2_FILTER_PARAMETERS* parameters) {}
+		HRESULT __stdcall SetOutputFilterParameters(IXAudio2Voice* destination, const XAUDIO2_FILTER_PARAMETERS* parameters, UINT32 operation_set) {return S_OK;}
+		void __stdcall GetOutputFilterParameters(IXAudio2Voice* destination, XAUDIO2_FILTER_PARAMETERS* parameters) {}
+		HRESULT __stdcall SetVolume(float volume, UINT32 operation_set) {return S_OK;}
+		void __stdcall GetVolume(float* volume) {*volume = 1.0f;}
+		HRESULT __stdcall SetChannelVolumes(UINT32 channels, const float* volumes, UINT32 operation_set) {return S_OK;}
+		void __stdcall GetChannelVolumes(UINT32 channels, float* volumes) {}
+		HRESULT __stdcall SetOutputMatrix(IXAudio2Voice* destination, UINT32 source_channels, UINT32 destination_channels, const float* matrix, UINT32 operation_set) {return S_OK;}
+		void __stdcall GetOutputMatrix(IXAudio2Voice* destination, UINT32 source_channels, UINT32 destination_channels, float* matrix) {}
+	};
+
+
+
+	/** A stereo mastering voice which does nothing.
+	*/
+	class StandInMasteringVoice: public StandInVoice<IXAudio2MasteringVoice>
+	{
+	public:
+		void __stdcall GetVoiceDetails(XAUDIO2_VOICE_DETAILS* details) {details->InputChannels = 2;}
+		void __stdcall DestroyVoice() {delete this;}
+	};
+
+
+
+	/** A source voice which queues the buffers submitted to it, but never plays them
+	until it's told to finish them all. Its volume and output matrix are kept, so that they
+	can be checked.
+	*/
+	class StandInSourceVoice: public StandInVoice<IXAudio2SourceVoice>
+	{
+	public:
+		/** Basic constructor.
+		@param creator The stand-in which created this voice.
+		@param voice_callback Receives the ends of this voice's buffers.
+		*/
+		StandInSourceVoice(StandInXAudio2& creator, IXAudio2VoiceCallback* const voice_callback);
+
+		/** Counts the queued buffers.
+		@return The number of buffers which haven't been played.
+		*/
+		const std::size_t GetQueuedCount() const
+		{
+			return buffer_contexts.size();
+		}
+
+		/** Plays every queued buffer to the end.
+		*/
+		void Finish()
+		{
+			while(buffer_contexts.empty() == false)
+			{
+				void* const context = buffer_contexts.front();
+				buffer_contexts.erase(buffer_contexts.begin());
+				if(callback != nullptr)
+				{
+					callback->OnBufferEnd(context);
+				}
+			}
+		}
+
+		void __stdcall DestroyVoice();
+		HRESULT __stdcall Start(UINT32 flags, UINT32 operation_set) {return S_OK;}
+		HRESULT __stdcall Stop(UINT32 flags, UINT32 operation_set) {return S_OK;}
+		HRESULT __stdcall SubmitSourceBuffer(const XAUDIO2_BUFFER* buffer, const XAUDIO2_BUFFER_WMA* wma_buffer);
+		HRESULT __stdcall FlushSourceBuffers() {Finish(); return S_OK;}
+		HRESULT __stdcall Discontinuity() {return S_OK;}
+		HRESULT __stdcall ExitLoop(UINT32 operation_set) {return S_OK;}
+		void __stdcall GetState(XAUDIO2_VOICE_STATE* state)
+		{
+			state->pCurrentBufferContext = (buffer_contexts.empty() == true) ? nullptr : buffer_contexts.front();
+			state->BuffersQueued = buffer_contexts.size();
+			state->SamplesPlayed = 0;
+		}
+		HRESULT __stdcall SetFrequencyRatio(float ratio, UINT32 operation_set) {return S_OK;}
+		void __stdcall GetFrequencyRatio(float* ratio) {*ratio = 1.0f;}
+		HRESULT __stdcall SetSourceSampleRate(UINT32 sample_rate) {return S_OK;}
+		HRESULT __stdcall SetVolume(float new_volume, UINT32 operation_set) {volume = new_volume; return S_OK;}
+		void __stdcall GetVolume(float* current_volume) {*current_volume = volume;}
+		HRESULT __stdcall SetOutputMatrix(IXAudio2Voice* destination, UINT32 source_channels, UINT32 destination_channels, const float* matrix, UINT32 operation_set)
+		{
+			output_matrix.assign(matrix, matrix + source_channels * destination_channels);
+			return S_OK;
+		}
+		void __stdcall GetOutputMatrix(IXAudio2Voice* destination, UINT32 source_channels, UINT32 destination_channels, float* matrix)
+		{
+			std::copy(output_matrix.begin(), output_matrix.end(), matrix);
+		}
+
+	private:
+		/// The stand-in which created this voice.
+		StandInXAudio2& owner;
+		/// Receives the ends of this voice's buffers.
+		IXAudio2VoiceCallback* const callback;
+		/// The contexts of the queued buffers, in the order they were submitted.
+		std::vector<void*> buffer_contexts;
+		/// The volume.
+		float volume;
+		/// The output matrix which was last set, if any.
+		std::vector<float> output_matrix;
+	};
+
+
+
+	/** Implements IXAudio2 without an audio device, and counts the source voices which
+	are created and destroyed through it.
+	*/
+	class StandInXAudio2: public IXAudio2
+	{
+	public:
+		/** Basic constructor.
+		*/
+		StandInXAudio2()
+			: reference_count(1), created_count(0), destroyed_count(0)
+		{
+			memset(&last_buffer, 0, sizeof(last_buffer));
+		}
+
+		/** Finishes the queued buffers of every source voice.
+		*/
+		void FinishVoices()
+		{
+			for(std::size_t i = 0; i < voices.size(); ++i)
+			{
+				voices[i]->Finish();
+			}
+		}
+
+		/** Counts the queued buffers of every source voice.
+		@return The number of buffers which haven't been played.
+		*/
+		const std::size_t GetQueuedCount() const
+		{
+			std::size_t count = 0;
+			for(std::size_t i = 0; i < voices.size(); ++i)
+			{
+				count += voices[i]->GetQueuedCount();
+			}
+			return count;
+		}
+
+		/** Forgets a source voice which is being destroyed.
+		@param voice The voice.
+		*/
+		void OnVoiceDestroyed(StandInSourceVoice* const voice)
+		{
+			voices.erase(std::find(voices.begin(), voices.end(), voice));
+			++destroyed_count;
+		}
+
+		/** Remembers the last buffer submitted to any source voice.
+		@param buffer The buffer.
+		*/
+		void OnBufferSubmitted(const XAUDIO2_BUFFER& buffer)
+		{
+			last_buffer = buffer;
+		}
+
+		const XAUDIO2_BUFFER& GetLastBuffer() const {return last_buffer;}
+		StandInSourceVoice& GetLastVoice() {return *voices.back();}
+		const unsigned long GetReferenceCount() const {return reference_count;}
+		const unsigned int GetCreatedCount() const {return created_count;}
+		const unsigned int GetDestroyedCount() const {return destroyed_count;}
+
+		HRESULT __stdcall QueryInterface(REFIID id, void** object) {return E_NOINTERFACE;}
+		ULONG __stdcall AddRef() {return ++reference_count;}
+		ULONG __stdcall Release() {return --reference_count;}
+		HRESULT __stdcall GetDeviceCount(UINT32* count) {*count = 0; return S_OK;}
+		HRESULT __stdcall GetDeviceDetails(UINT32 index, XAUDIO2_DEVICE_DETAILS* details) {return E_FAIL;}
+		HRESULT __stdcall Initialize(UINT32 flags, XAUDIO2_PROCESSOR processor) {return S_OK;}
+		HRESULT __stdcall RegisterForCallbacks(IXAudio2EngineCallback* callback) {return S_OK;}
+		void __stdcall UnregisterForCallbacks(IXAudio2EngineCallback* callback) {}
+		HRESULT __stdcall CreateSourceVoice(IXAudio2SourceVoice** voice, const WAVEFORMATEX* format, UINT32 flags, float max_frequency_ratio,
+			IXAudio2VoiceCallback* callback, const XAUDIO2_VOICE_SENDS* sends, const XAUDIO2_EFFECT_CHAIN* chain)
+		{
+			StandInSourceVoice* const new_voice = new StandInSourceVoice(*this, callback);
+			voices.push_back(new_voice);
+			++created_count;
+			*voice = new_voice;
+			return S_OK;
+		}
+		HRESULT __stdcall CreateSubmixVoice(IXAudio2SubmixVoice** voice, UINT32 channels, UINT32 sample_rate, UINT32 flags, UINT32 stage,
+			const XAUDIO2_VOICE_SENDS* sends, const XAUDIO2_EFFECT_CHAIN* chain) {return E_FAIL;}
+		HRESULT __stdcall CreateMasteringVoice(IXAudio2MasteringVoice** voice, UINT32 channels, UINT32 sample_rate, UINT32 flags, UINT32 device,
+			const XAUDIO2_EFFECT_CHAIN* chain)
+		{
+			*voice = new StandInMasteringVoice();
+			return S_OK;
+		}
+		HRESULT __stdcall StartEngine() {return S_OK;}
+		void __stdcall StopEngine() {}
+		HRESULT __stdcall CommitChanges(UINT32 operation_set) {return S_OK;}
+		void __stdcall GetPerformanceData(XAUDIO2_PERFORMANCE_DATA* data) {}
+		void __stdcall SetDebugConfiguration(const XAUDIO2_DEBUG_CONFIGURATION* configuration, void* reserved) {}
+
+	private:
+		/// The reference count, which starts at 1 for the test which owns the stand-in.
+		unsigned long reference_count;
+		/// The number of source voices created.
+		unsigned int created_count;
+		/// The number of source voices destroyed.
+		unsigned int destroyed_count;
+		/// The source voices which haven't been destroyed.
+		std::vector<StandInSourceVoice*> voices;
+		/// The last buffer submitted to a source voice.
+		XAUDIO2_BUFFER last_buffer;
+	};
+}
+
+
+
 void TestXAudio2SoundEngineComponent()
 {
+	// Run the engine against a stand-in XAudio2 which never plays anything, but counts the
+	// voices which are created and destroyed.
+	StandInXAudio2 stand_in;
+	{
+		XAudio2SoundEngine engine(stand_in, 4, 2);
+		ASSERT(stand_in.GetReferenceCount() == 2);
+
+		// The first sound of a format creates its voices up front, and later ones reuse them.
+		const SoundEffect::SoundHandle mono = engine.AddSound(MakeSample(22050, 1, 220500));
+		ASSERT(stand_in.GetCreatedCount() == 2 && engine.GetIdleVoiceCount() == 2);
+		engine.AddSound(MakeSample(22050, 1, 1000));
+		ASSERT(stand_in.GetCreatedCount() == 2);
+
+		// Voices which finish go back to the pool instead of being destroyed.
+		std::vector<SoundEffect> effects(9, SoundEffect(mono));
+		SoundEffectList list;
+		for(unsigned int i = 0; i < 3; ++i)
+		{
+			effects[i].Play();
+			list.push_back(&effects[i]);
+		}
+		engine.UpdateSounds(list);
+		ASSERT(engine.GetActiveVoiceCount() == 3 && stand_in.GetCreatedCount() == 3);
+		stand_in.FinishVoices();
+		engine.UpdateSounds(list);
+		ASSERT(effects[0].IsPlaying() == false && engine.GetActiveVoiceCount() == 0 && engine.GetIdleVoiceCount() == 3);
+		for(unsigned int i = 0; i < 3; ++i)
+		{
+			effects[i].Play();
+		}
+		engine.UpdateSounds(list);
+		ASSERT(stand_in.GetCreatedCount() == 3 && stand_in.GetDestroyedCount() == 0);
+		stand_in.FinishVoices();
+		engine.UpdateSounds(list);
+		std::cout << "Finished voices are recycled.\n";
+
+		// Once every voice is busy, the sound with the lowest priority loses its voice, and keeps
+		// playing on a virtual voice...
+		list.clear();
+		for(unsigned int i = 0; i < 9; ++i)
+		{
+			list.push_back(&effects[i]);
+		}
+		for(unsigned int i = 0; i < 4; ++i)
+		{
+			effects[i].SetPriority(i + 1);
+			effects[i].Play();
+		}
+		engine.UpdateSounds(list);
+		ASSERT(engine.GetActiveVoiceCount() == 4 && stand_in.GetCreatedCount() == 4);
+		effects[4].SetPriority(5);
+		effects[4].Play();
+		engine.UpdateSounds(list);
+		ASSERT(effects[0].IsPlaying() == true && effects[4].IsPlaying() == true && engine.GetStolenVoiceCount() == 1);
+		ASSERT(stand_in.GetCreatedCount() == 4 && stand_in.GetDestroyedCount() == 0);
+		avl::sound::VoiceStatistics statistics = engine.GetVoiceStatistics();
+		ASSERT(statistics.real_voice_count == 4 && statistics.virtual_voice_count == 1 && statistics.promoted_count == 0 && statistics.demoted_count == 1);
+
+		// ...unless it's more important than the new sound, which gets a virtual voice instead.
+		effects[5].SetPriority(0);
+		effects[5].Play();
+		engine.UpdateSounds(list);
+		ASSERT(effects[5].IsPlaying() == true && engine.GetStolenVoiceCount() == 1);
+		statistics = engine.GetVoiceStatistics();
+		ASSERT(statistics.real_voice_count == 4 && statistics.virtual_voice_count == 2 && statistics.demoted_count == 0);
+
+		// Stealing for another format replaces the voice. The new format's pool starts out
+		// empty, since there's no room to create voices for it.
+		const SoundEffect::SoundHandle stereo = engine.AddSound(MakeSample(44100, 2, 1000));
+		ASSERT(stand_in.GetCreatedCount() == 4);
+		effects[6].SetSoundHandle(stereo);
+		effects[6].SetPriority(10);
+		effects[6].Play();
+		engine.UpdateSounds(list);
+		ASSERT(effects[1].IsPlaying() == true && effects[6].IsPlaying() == true && engine.GetVoiceStatistics().virtual_voice_count == 3);
+		ASSERT(stand_in.GetCreatedCount() == 5 && stand_in.GetDestroyedCount() == 1);
+
+		// Among sounds with the same priority, the one which started first loses its voice.
+		effects[7].SetPriority(4);
+		effects[7].Play();
+		engine.UpdateSounds(list);
+		ASSERT(engine.GetVoiceStatistics().demoted_count == 1 && effects[7].IsPlaying() == true);
+		effects[8].SetPriority(4);
+		effects[8].Play();
+		engine.UpdateSounds(list);
+		ASSERT(effects[3].IsPlaying() == true && effects[7].IsPlaying() == true && effects[8].IsPlaying() == true);
+		ASSERT(engine.GetStolenVoiceCount() == 4 && engine.GetActiveVoiceCount() == 4 && engine.GetVoiceStatistics().virtual_voice_count == 5);
+		std::cout << "Voices are stolen from the sounds with the lowest priorities.\n";
+
+		// Switching to a sound of another format trades the voice for one of that format.
+		effects[8].SetSoundHandle(stereo);
+		engine.UpdateSounds(list);
+		ASSERT(effects[8].IsPlaying() == true && engine.GetActiveVoiceCount() == 4 && engine.GetIdleVoiceCount() == 0);
+		ASSERT(stand_in.GetCreatedCount() == 6 && stand_in.GetDestroyedCount() == 2);
+		std::cout << "Voices follow their sounds' formats.\n";
+
+		// Stopping an effect with a virtual voice forgets it.
+		const unsigned int virtual_effects[] = {0, 1, 2, 3, 5};
+		for(unsigned int i = 0; i < 5; ++i)
+		{
+			effects[virtual_effects[i]].Stop();
+		}
+		engine.UpdateSounds(list);
+		ASSERT(engine.GetVoiceStatistics().virtual_voice_count == 0 && effects[0].IsPlaying() == false);
+
+		// Clearing the sounds destroys the voices which are playing, but keeps the idle ones.
+		effects[4].Loop(true);
+		engine.UpdateSounds(list);
+		stand_in.FinishVoices();
+		engine.UpdateSounds(list);
+		ASSERT(engine.GetActiveVoiceCount() == 1 && engine.GetIdleVoiceCount() == 3);
+		engine.ClearSounds();
+		ASSERT(engine.GetActiveVoiceCount() == 0 && engine.GetIdleVoiceCount() == 3 && stand_in.GetDestroyedCount() == 3);
+	}
+
+	// Sounds on virtual voices get real voices back once they're free, starting where they
+	// would have been; and finish on time if they don't loop.
+	{
+		XAudio2SoundEngine engine(stand_in, 1, 1);
+		const SoundEffect::SoundHandle long_sound = engine.AddSound(MakeSample(22050, 1, 22050));
+		const SoundEffect::SoundHandle short_sound = engine.AddSound(MakeSample(22050, 1, 1000));
+		SoundEffect quiet(long_sound);
+		SoundEffect loud(long_sound);
+		SoundEffect brief(short_sound);
+		SoundEffectList list;
+		list.push_back(&quiet);
+		list.push_back(&loud);
+		list.push_back(&brief);
+		quiet.SetVolume(0.5f);
+		quiet.Loop(true);
+		quiet.Play();
+		engine.UpdateSounds(list);
+		loud.Play();
+		engine.UpdateSounds(list);
+		avl::sound::VoiceStatistics statistics = engine.GetVoiceStatistics();
+		ASSERT(statistics.real_voice_count == 1 && statistics.virtual_voice_count == 1 && statistics.demoted_count == 1);
+		Sleep(100);
+		loud.Stop();
+		engine.UpdateSounds(list);
+		statistics = engine.GetVoiceStatistics();
+		ASSERT(statistics.real_voice_count == 1 && statistics.virtual_voice_count == 0 && statistics.promoted_count == 1);
+		// A tenth of a second is 2205 frames; allow for the sleep's inaccuracy.
+		const XAUDIO2_BUFFER& promoted = stand_in.GetLastBuffer();
+		ASSERT(promoted.PlayBegin >= 2000 && promoted.PlayBegin < 11025 && promoted.PlayBegin + promoted.PlayLength == 22050);
+		ASSERT(promoted.LoopBegin == 0 && promoted.LoopLength == 22050 && promoted.LoopCount == XAUDIO2_MAX_LOOP_COUNT);
+
+		brief.SetVolume(0.25f);
+		brief.Play();
+		engine.UpdateSounds(list);
+		ASSERT(brief.IsPlaying() == true && engine.GetVoiceStatistics().virtual_voice_count == 1);
+		Sleep(100);
+		engine.UpdateSounds(list);
+		ASSERT(brief.IsPlaying() == false && engine.GetVoiceStatistics().virtual_voice_count == 0);
+		quiet.Stop();
+		engine.UpdateSounds(list);
+		std::cout << "Virtual voices keep their place, and get real voices back.\n";
+	}
+
+	// Handles to deleted sounds are refused, even once their slots hold other sounds; and a
+	// copy of a sound effect gets a voice of its own.
+	{
+		XAudio2SoundEngine engine(stand_in, 4, 1);
+		const SoundEffect::SoundHandle deleted = engine.AddSound(MakeSample(22050, 1, 1000));
+		engine.DeleteSound(deleted);
+		const SoundEffect::SoundHandle reused = engine.AddSound(MakeSample(22050, 1, 1000));
+		ASSERT(reused != deleted);
+		SoundEffect effect(reused);
+		SoundEffectList list;
+		list.push_back(&effect);
+		effect.Play();
+		engine.UpdateSounds(list);
+		SoundEffect copy(effect);
+		list.push_back(&copy);
+		engine.UpdateSounds(list);
+		ASSERT(engine.GetActiveVoiceCount() == 2);
+
+		SoundEffect stale(deleted);
+		list.push_back(&stale);
+		bool thrown = false;
+		try
+		{
+			engine.UpdateSounds(list);
+		}
+		catch(const avl::utility::InvalidArgumentException&)
+		{
+			thrown = true;
+		}
+		ASSERT(thrown == true);
+		engine.ClearSounds();
+		list.clear();
+		list.push_back(&effect);
+		thrown = false;
+		try
+		{
+			engine.UpdateSounds(list);
+		}
+		catch(const avl::utility::InvalidArgumentException&)
+		{
+			thrown = true;
+		}
+		ASSERT(thrown == true);
+		std::cout << "Handles to deleted sounds are refused.\n";
+	}
+
+	// A stream keeps its chunks queued on its voice, and gets them back once they've played.
+	// The file fits in one chunk, so each chunk is a pass through it.
+	{
+		{
+			std::vector<float> silence(4410 * 2, 0.0f);
+			WAVFileSink sink("assets/xaudio2 sound engine.wav", 44100, 2);
+			sink.WriteFrames(&silence[0], 4410, 2);
+			sink.Close();
+		}
+		XAudio2SoundEngine engine(stand_in, 4, 1);
+		const SoundEffect::SoundHandle stream = engine.AddStream("assets/xaudio2 sound engine.wav");
+		SoundEffect first(stream);
+		SoundEffect second(stream);
+		SoundEffectList list;
+		list.push_back(&first);
+		list.push_back(&second);
+		first.Loop(true);
+		first.Play();
+		engine.UpdateSounds(list);
+		Sleep(50);
+		engine.UpdateSounds(list);
+		ASSERT(stand_in.GetQueuedCount() == 3);
+		stand_in.FinishVoices();
+		engine.UpdateSounds(list);
+		Sleep(50);
+		engine.UpdateSounds(list);
+		ASSERT(stand_in.GetQueuedCount() == 3 && first.IsPlaying() == true);
+
+		// Without looping, nothing is queued after the end of a pass, and the effect is paused
+		// once that has played.
+		first.Loop(false);
+		stand_in.FinishVoices();
+		engine.UpdateSounds(list);
+		Sleep(50);
+		engine.UpdateSounds(list);
+		ASSERT(stand_in.GetQueuedCount() == 1 && first.IsPlaying() == true);
+		stand_in.FinishVoices();
+		engine.UpdateSounds(list);
+		ASSERT(first.IsPlaying() == false && engine.GetActiveVoiceCount() == 0);
+
+		// Only one effect plays a stream at a time.
+		first.Play();
+		engine.UpdateSounds(list);
+		second.Play();
+		engine.UpdateSounds(list);
+		ASSERT(first.IsPlaying() == false && second.IsPlaying() == true && engine.GetActiveVoiceCount() == 1);
+		std::cout << "Streams queue their chunks, and take them back once they've played.\n";
+	}
+	// Positional sounds set their voices' volumes and output matrices by where they are, and
+	// those too far away to be heard get virtual voices.
+	{
+		XAudio2SoundEngine engine(stand_in, 1, 1);
+		const SoundEffect::SoundHandle mono = engine.AddSound(MakeSample(22050, 1, 22050));
+		StandInSourceVoice& voice = stand_in.GetLastVoice();
+		SoundEffect near_effect(mono);
+		SoundEffect far_effect(mono);
+		SoundEffectList list;
+		list.push_back(&near_effect);
+		list.push_back(&far_effect);
+		near_effect.Loop(true);
+		near_effect.SetPosition(avl::utility::Vector(3.0f, 4.0f));
+		near_effect.Play();
+		engine.UpdateSounds(list);
+		float volume;
+		float matrix[2];
+		voice.GetVolume(&volume);
+		voice.GetOutputMatrix(nullptr, 1, 2, matrix);
+		ASSERT(std::abs(volume - 0.2f) < 1e-6f && std::abs(matrix[0] - std::sqrt(0.2f)) < 1e-6f && std::abs(matrix[1] - std::sqrt(0.8f)) < 1e-6f);
+
+		const avl::sound::Attenuation attenuation = {1.0f, 1000.0f, 0.01f};
+		engine.SetAttenuation(attenuation);
+		far_effect.Loop(true);
+		far_effect.SetPosition(avl::utility::Vector(500.0f, 0.0f));
+		far_effect.Play();
+		engine.UpdateSounds(list);
+		avl::sound::VoiceStatistics statistics = engine.GetVoiceStatistics();
+		ASSERT(statistics.real_voice_count == 1 && statistics.virtual_voice_count == 1);
+		near_effect.SetPosition(avl::utility::Vector(-600.0f, 0.0f));
+		engine.UpdateSounds(list);
+		statistics = engine.GetVoiceStatistics();
+		ASSERT(statistics.real_voice_count == 0 && statistics.virtual_voice_count == 2 && statistics.demoted_count == 1);
+
+		// Without a position, a sound plays at its own volume on both sides.
+		far_effect.ClearPosition();
+		engine.UpdateSounds(list);
+		statistics = engine.GetVoiceStatistics();
+		ASSERT(statistics.real_voice_count == 1 && statistics.virtual_voice_count == 1 && statistics.promoted_count == 1);
+		voice.GetVolume(&volume);
+		voice.GetOutputMatrix(nullptr, 1, 2, matrix);
+		ASSERT(volume == 1.0f && matrix[0] == 1.0f && matrix[1] == 1.0f);
+		near_effect.Stop();
+		far_effect.Stop();
+		engine.UpdateSounds(list);
+		std::cout << "Positional sounds are attenuated and panned.\n";
+	}
+
+	// The cost of updating a thousand looping sound effects, 64 of which have real voices.
+	{
+		XAudio2SoundEngine engine(stand_in);
+		std::vector<SoundEffect::SoundHandle> handles;
+		for(unsigned int i = 0; i < 10; ++i)
+		{
+			handles.push_back(engine.AddSound(MakeSample(22050, 1, 22050)));
+		}
+		std::vector<SoundEffect> effects(1000);
+		SoundEffectList list;
+		for(std::size_t i = 0; i < effects.size(); ++i)
+		{
+			effects[i].SetSoundHandle(handles[i % handles.size()]);
+			effects[i].SetPriority(i % 3);
+			effects[i].SetVolume((i % 100) / 100.0f);
+			effects[i].Loop(true);
+			effects[i].Play();
+			list.push_back(&effects[i]);
+		}
+		engine.UpdateSounds(list);
+		avl::utility::Timer timer;
+		for(unsigned int update = 0; update < 100; ++update)
+		{
+			engine.UpdateSounds(list);
+		}
+		const double time = timer.Elapsed();
+		ASSERT(engine.GetVoiceStatistics().real_voice_count == 64 && engine.GetVoiceStatistics().virtual_voice_count == 936);
+		std::cout << "  Microseconds per update of 1000 sound effects: " << time * 1000000.0 / 100.0 << "\n";
+	}
+	ASSERT(stand_in.GetCreatedCount() == stand_in.GetDestroyedCount() && stand_in.GetReferenceCount() == 1);
+	std::cout << "Every voice is destroyed along with the engine.\n";
+
+	// Listen to the real thing.
 	XAudio2SoundEngine engine;
 
 	SoundSample sample = LoadWAVFile("assets/Try again.wav");
@@ -58,4 +637,48 @@ void TestXAudio2SoundEngineComponent()
 	}
 
 	system("pause");
-}
\ No newline at end of file
+}
+
+
+
+// Anonymous namespace.
+namespace
+{
+	/** Creates a 16-bit sample of silence.
+	@param frequency The number of frames per second.
+	@param channel_count The number of channels.
+	@param frame_count The number of frames.
+	@return The sample.
+	*/
+	SoundSample MakeSample(const unsigned int frequency, const unsigned int channel_count, const std::size_t frame_count)
+	{
+		const std::size_t size = frame_count * channel_count * 2;
+		char* const data = new char[size];
+		std::fill(data, data + size, 0);
+		return SoundSample(16, frequency, channel_count, size, data);
+	}
+
+
+
+	// See method declaration for details.
+	StandInSourceVoice::StandInSourceVoice(StandInXAudio2& creator, IXAudio2VoiceCallback* const voice_callback)
+		: owner(creator), callback(voice_callback), volume(1.0f)
+	{
+	}
+
+	// See method declaration for details.
+	HRESULT StandInSourceVoice::SubmitSourceBuffer(const XAUDIO2_BUFFER* buffer, const XAUDIO2_BUFFER_WMA* wma_buffer)
+	{
+		buffer_contexts.push_back(buffer->pContext);
+		owner.OnBufferSubmitted(*buffer);
+		return S_OK;
+	}
+
+	// See method declaration for details.
+	void StandInSourceVoice::DestroyVoice()
+	{
+		Finish();
+		owner.OnVoiceDestroyed(this);
+		delete this;
+	}
+}
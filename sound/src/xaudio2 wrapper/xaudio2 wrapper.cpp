@@ -127,9 +127,8 @@ namespace xaudio2
 				}
 				else
 				{
-					// Delete voice.
+					// Release voice.
 					voice.Stop();
-					voice.DestroyVoice();
 					effect.Pause();
 					return true;
 				}
@@ -158,10 +157,9 @@ namespace xaudio2
 			}
 			else
 			{
-				// Delete voice.
+				// Release voice.
 				voice.Stop();
 				voice.FlushSourceBuffers();
-				voice.DestroyVoice();
 				effect.Reset(false);
 				return true;
 			}
@@ -181,21 +179,26 @@ namespace xaudio2
 		format.cbSize = 0;
 	}
 
+	// See function declaration for details.
+	void ExtractPCMFormatData(const SoundStream& stream, WAVEFORMATEX& format)
+	{
+		format.wFormatTag = WAVE_FORMAT_PCM;
+		format.wBitsPerSample = stream.GetBitDepth();
+		format.nChannels = stream.GetNumberOfChannels();
+		format.nSamplesPerSec = stream.GetFrequency();
+		format.nBlockAlign = (WORD)(format.nChannels * format.wBitsPerSample / 8);
+		format.nAvgBytesPerSec = format.nBlockAlign * format.nSamplesPerSec;
+		format.cbSize = 0;
+	}
+
 	// See function declaration for details.
 	void CreateBuffer(const SoundSample& sample, XAUDIO2_BUFFER& buffer)
 	{
-		// Create a deep copy of the audio sample data.
-		std::unique_ptr<char[]> audio_data(new(std::nothrow) char[sample.GetDataSize()]);
-		if(audio_data == false)
-		{
-			throw utility::OutOfMemoryError();
-		}
-		memcpy(audio_data.get(), sample.GetAudioData(), sample.GetDataSize());
 		memset(&buffer, 0, sizeof(XAUDIO2_BUFFER));
 		buffer.Flags = XAUDIO2_END_OF_STREAM;
 		buffer.PlayLength = (sample.GetDataSize() * 8) / (sample.GetBitDepth() * sample.GetNumberOfChannels());
 		buffer.AudioBytes = sample.GetDataSize();
-		buffer.pAudioData = reinterpret_cast<const BYTE* const>(audio_data.release());
+		buffer.pAudioData = reinterpret_cast<const BYTE* const>(sample.GetAudioData());
 	}
 
 	// See function declaration for details.
@@ -233,14 +236,46 @@ namespace xaudio2
 		}
 	}
 
+	// See function declaration for details.
+	void PlayBufferFrom(IXAudio2SourceVoice& voice, const XAUDIO2_BUFFER& buffer, const UINT32 first_frame, const utility::SoundEffect& effect)
+	{
+		XAUDIO2_BUFFER part = buffer;
+		if(first_frame > 0 && first_frame < buffer.PlayLength)
+		{
+			part.PlayBegin = buffer.PlayBegin + first_frame;
+			part.PlayLength = buffer.PlayLength - first_frame;
+			// Loop back to the beginning of the whole buffer rather than of the part.
+			if(effect.IsLooping() == true)
+			{
+				part.LoopBegin = buffer.PlayBegin;
+				part.LoopLength = buffer.PlayLength;
+			}
+		}
+		PlayBuffer(voice, part, effect);
+	}
+
 	// See function declaration for details.
 	void ResumeBuffer(IXAudio2SourceVoice& voice, XAUDIO2_BUFFER& buffer, const utility::SoundEffect& effect)
 	{
 		XAUDIO2_VOICE_STATE voice_state;
 		voice.GetState(&voice_state);
 		// Resume the buffer from the current sample.
-		buffer.PlayBegin = (UINT32)(voice_state.SamplesPlayed % buffer.PlayLength);
-		PlayBuffer(voice, buffer, effect);
+		PlayBufferFrom(voice, buffer, (UINT32)(voice_state.SamplesPlayed % buffer.PlayLength), effect);
+	}
+
+	// See function declaration for details.
+	void SubmitChunk(IXAudio2SourceVoice& voice, const SoundStream::Chunk& chunk, const bool is_end)
+	{
+		XAUDIO2_BUFFER buffer;
+		memset(&buffer, 0, sizeof(XAUDIO2_BUFFER));
+		buffer.Flags = (is_end == true) ? XAUDIO2_END_OF_STREAM : 0;
+		buffer.AudioBytes = chunk.size;
+		buffer.pAudioData = reinterpret_cast<const BYTE*>(chunk.data);
+		HRESULT result = voice.SubmitSourceBuffer(&buffer);
+		if(FAILED(result))
+		{
+			throw utility::Exception("avl::sound::xaudio2::SubmitChunk() -- Unable to submit buffer.");
+		}
 	}
 
 
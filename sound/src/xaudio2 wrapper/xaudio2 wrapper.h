@@ -27,6 +27,7 @@ Provides functions and structures for performing common XAudio2 tasks.
 
 #include<xaudio2.h>
 #include"..\sound sample\sound sample.h"
+#include"..\sound stream\sound stream.h"
 #include"..\..\..\utility\src\sound effect\sound effect.h"
 #include<memory>
 
@@ -48,7 +49,12 @@ namespace xaudio2
 	*/
 	IXAudio2SourceVoice* const CreateSourceVoice(IXAudio2& xaudio2, const WAVEFORMATEX format);
 
-	/**
+	/** Brings a voice up to date with the state of the sound effect it's playing.
+	@param voice The voice which is playing \a effect.
+	@param buffer The buffer holding the sound which \a effect refers to.
+	@param effect The sound effect being played.
+	@return True if \a voice is no longer needed by \a effect, in which case it has been
+	stopped but not destroyed, so that it may be used again.
 	*/
 	const bool UpdateVoice(IXAudio2SourceVoice& voice, XAUDIO2_BUFFER& buffer, utility::SoundEffect& effect);
 
@@ -56,7 +62,17 @@ namespace xaudio2
 	*/
 	void ExtractPCMFormatData(const SoundSample& sample, WAVEFORMATEX& format);
 
-	/**
+	/** Fills in the format of a stream's audio data.
+	@param stream The stream.
+	@param format [OUT] Receives the format.
+	*/
+	void ExtractPCMFormatData(const SoundStream& stream, WAVEFORMATEX& format);
+
+	/** Fills in a buffer which plays the whole of a sample. The buffer points at the
+	sample's audio data rather than a copy of it, so the data must be kept alive for as
+	long as the buffer is in use (see SoundSample::ShareAudioData()).
+	@param sample The sample.
+	@param buffer [OUT] Receives the buffer.
 	*/
 	void CreateBuffer(const SoundSample& sample, XAUDIO2_BUFFER& buffer);
 
@@ -64,10 +80,30 @@ namespace xaudio2
 	*/
 	void PlayBuffer(IXAudio2SourceVoice& voice, XAUDIO2_BUFFER& buffer, const utility::SoundEffect& effect);
 
+	/** Plays a buffer from part of the way through, as PlayBuffer() does from the beginning.
+	If the sound effect is looping, each loop after the first plays the whole buffer.
+	@param voice The voice to play the buffer on.
+	@param buffer The buffer, which plays the whole of a sound. It isn't changed.
+	@param first_frame The frame to start from. The whole buffer is played if it's past the end.
+	@param effect The sound effect being played.
+	@throws Exception If unable to submit the buffer.
+	@throws OutOfMemoryError If unable to allocate the buffer's context.
+	*/
+	void PlayBufferFrom(IXAudio2SourceVoice& voice, const XAUDIO2_BUFFER& buffer, const UINT32 first_frame, const utility::SoundEffect& effect);
+
 	/**
 	*/
 	void ResumeBuffer(IXAudio2SourceVoice& voice, XAUDIO2_BUFFER& buffer, const utility::SoundEffect& effect);
 
+	/** Queues a chunk of a stream on a voice, without a buffer context. The chunk's data
+	must stay valid until the voice is done with it.
+	@param voice The voice to queue the chunk on.
+	@param chunk The chunk.
+	@param is_end Is this the last buffer which will be queued?
+	@throws Exception If unable to submit the buffer.
+	*/
+	void SubmitChunk(IXAudio2SourceVoice& voice, const SoundStream::Chunk& chunk, const bool is_end);
+
 	/**
 	*/
 	struct BufferContext
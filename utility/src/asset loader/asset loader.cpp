@@ -0,0 +1,367 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the asset loader component. See "asset loader.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"asset loader.h"
+#include"..\exceptions\exceptions.h"
+#include"..\timer\timer.h"
+#include<string>
+#include<deque>
+#include<vector>
+#include<memory>
+#include<new>
+#include<climits>
+#include<Windows.h>
+#include<process.h>
+
+
+
+namespace avl
+{
+namespace utility
+{
+
+	// See method declaration for details.
+	AssetJob::AssetJob(const Priority priority)
+		: priority(priority), is_done(false), has_failed(false)
+	{
+	}
+
+	// See method declaration for details.
+	AssetJob::~AssetJob()
+	{
+	}
+
+	// See method declaration for details.
+	const AssetJob::Priority AssetJob::GetPriority() const
+	{
+		return priority;
+	}
+
+	// See method declaration for details.
+	const bool AssetJob::IsDone() const
+	{
+		return is_done;
+	}
+
+	// See method declaration for details.
+	const bool AssetJob::HasFailed() const
+	{
+		return has_failed;
+	}
+
+	// See method declaration for details.
+	const std::string& AssetJob::GetFailureDescription() const
+	{
+		return failure_description;
+	}
+
+
+
+	// See method declaration for details.
+	AssetLoader::AssetLoader(const unsigned int thread_count)
+		: work_semaphore(nullptr), loaded_event(nullptr), is_stopping(false), failed_count(0)
+	{
+		for(unsigned int i = 0; i < AssetJob::PRIORITY_COUNT; ++i)
+		{
+			submitted_count[i] = 0;
+			done_count[i] = 0;
+		}
+
+		// Leave one processor free for the owning thread.
+		unsigned int worker_count = thread_count;
+		if(worker_count == 0)
+		{
+			SYSTEM_INFO system_info;
+			GetSystemInfo(&system_info);
+			worker_count = (system_info.dwNumberOfProcessors > 1) ? system_info.dwNumberOfProcessors - 1 : 1;
+		}
+
+		InitializeCriticalSection(&lock);
+		work_semaphore = CreateSemaphore(nullptr, 0, LONG_MAX, nullptr);
+		loaded_event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+		if(work_semaphore == nullptr || loaded_event == nullptr)
+		{
+			Shutdown();
+			throw Exception("avl::utility::AssetLoader::AssetLoader() -- Unable to create the synchronization objects.");
+		}
+
+		try
+		{
+			workers.reserve(worker_count);
+		}
+		catch(const std::bad_alloc&)
+		{
+			Shutdown();
+			throw OutOfMemoryError();
+		}
+		for(unsigned int i = 0; i < worker_count; ++i)
+		{
+			const HANDLE worker = reinterpret_cast<HANDLE>(_beginthreadex(nullptr, 0, &AssetLoader::WorkerThread, this, 0, nullptr));
+			if(worker == nullptr)
+			{
+				Shutdown();
+				throw Exception("avl::utility::AssetLoader::AssetLoader() -- Unable to start the worker threads.");
+			}
+			workers.push_back(worker);
+		}
+	}
+
+	// See method declaration for details.
+	AssetLoader::~AssetLoader()
+	{
+		Shutdown();
+	}
+
+	// See method declaration for details.
+	void AssetLoader::Shutdown()
+	{
+		// Wake every worker so that each one sees the stop request.
+		is_stopping = true;
+		if(work_semaphore != nullptr && workers.empty() == false)
+		{
+			ReleaseSemaphore(work_semaphore, static_cast<LONG>(workers.size()), nullptr);
+		}
+		for(std::vector<HANDLE>::iterator i = workers.begin(); i != workers.end(); ++i)
+		{
+			WaitForSingleObject(*i, INFINITE);
+			CloseHandle(*i);
+		}
+		workers.clear();
+		if(work_semaphore != nullptr)
+		{
+			CloseHandle(work_semaphore);
+			work_semaphore = nullptr;
+		}
+		if(loaded_event != nullptr)
+		{
+			CloseHandle(loaded_event);
+			loaded_event = nullptr;
+		}
+		DeleteCriticalSection(&lock);
+	}
+
+	// See method declaration for details.
+	void AssetLoader::Submit(const std::shared_ptr<AssetJob>& job)
+	{
+		if(job == nullptr)
+		{
+			throw InvalidArgumentException("avl::utility::AssetLoader::Submit()", "job", "Must not be null.");
+		}
+		EnterCriticalSection(&lock);
+		try
+		{
+			pending_jobs[job->GetPriority()].push_back(job);
+		}
+		catch(const std::bad_alloc&)
+		{
+			LeaveCriticalSection(&lock);
+			throw OutOfMemoryError();
+		}
+		LeaveCriticalSection(&lock);
+		++submitted_count[job->GetPriority()];
+		ReleaseSemaphore(work_semaphore, 1, nullptr);
+	}
+
+	// See method declaration for details.
+	const unsigned int AssetLoader::FinishLoadedJobs(const double time_budget)
+	{
+		const Timer timer;
+		unsigned int finished = 0;
+		while(true)
+		{
+			std::shared_ptr<AssetJob> job;
+			EnterCriticalSection(&lock);
+			if(loaded_jobs.empty() == false)
+			{
+				job = loaded_jobs.front();
+				loaded_jobs.pop_front();
+			}
+			LeaveCriticalSection(&lock);
+			if(job == nullptr)
+			{
+				break;
+			}
+
+			FinishJob(*job);
+			++finished;
+			if(time_budget > 0.0 && timer.Elapsed() >= time_budget)
+			{
+				break;
+			}
+		}
+		return finished;
+	}
+
+	// See method declaration for details.
+	void AssetLoader::WaitForPriority(const AssetJob::Priority priority)
+	{
+		while(ArePrioritiesDone(priority) == false)
+		{
+			// Finish everything that's ready, since less urgent jobs may be holding up a
+			// worker anyway, then sleep until something else is loaded.
+			if(FinishLoadedJobs() == 0)
+			{
+				WaitForSingleObject(loaded_event, INFINITE);
+			}
+		}
+	}
+
+	// See method declaration for details.
+	const unsigned int AssetLoader::GetJobCount() const
+	{
+		unsigned int count = 0;
+		for(unsigned int i = 0; i < AssetJob::PRIORITY_COUNT; ++i)
+		{
+			count += submitted_count[i];
+		}
+		return count;
+	}
+
+	// See method declaration for details.
+	const unsigned int AssetLoader::GetDoneCount() const
+	{
+		unsigned int count = 0;
+		for(unsigned int i = 0; i < AssetJob::PRIORITY_COUNT; ++i)
+		{
+			count += done_count[i];
+		}
+		return count;
+	}
+
+	// See method declaration for details.
+	const unsigned int AssetLoader::GetFailedCount() const
+	{
+		return failed_count;
+	}
+
+	// See method declaration for details.
+	const float AssetLoader::GetProgress() const
+	{
+		const unsigned int job_count = GetJobCount();
+		if(job_count == 0)
+		{
+			return 1.0f;
+		}
+		return static_cast<float>(GetDoneCount()) / static_cast<float>(job_count);
+	}
+
+	// See method declaration for details.
+	unsigned int __stdcall AssetLoader::WorkerThread(void* loader)
+	{
+		static_cast<AssetLoader*>(loader)->RunWorker();
+		return 0;
+	}
+
+	// See method declaration for details.
+	void AssetLoader::RunWorker()
+	{
+		while(true)
+		{
+			// Each pending job adds one count to the semaphore.
+			WaitForSingleObject(work_semaphore, INFINITE);
+			if(is_stopping == true)
+			{
+				return;
+			}
+
+			// Take the most urgent job.
+			std::shared_ptr<AssetJob> job;
+			EnterCriticalSection(&lock);
+			for(unsigned int i = 0; i < AssetJob::PRIORITY_COUNT; ++i)
+			{
+				if(pending_jobs[i].empty() == false)
+				{
+					job = pending_jobs[i].front();
+					pending_jobs[i].pop_front();
+					break;
+				}
+			}
+			LeaveCriticalSection(&lock);
+			if(job == nullptr)
+			{
+				continue;
+			}
+
+			try
+			{
+				job->Load();
+			}
+			catch(const Exception& e)
+			{
+				job->has_failed = true;
+				job->failure_description = e.GetDescription();
+			}
+			catch(...)
+			{
+				job->has_failed = true;
+				job->failure_description = "An unknown error occurred while loading the asset.";
+			}
+
+			// Hand the job back to the owning thread.
+			EnterCriticalSection(&lock);
+			loaded_jobs.push_back(job);
+			LeaveCriticalSection(&lock);
+			SetEvent(loaded_event);
+		}
+	}
+
+	// See method declaration for details.
+	void AssetLoader::FinishJob(AssetJob& job)
+	{
+		if(job.has_failed == false)
+		{
+			try
+			{
+				job.Finish();
+			}
+			catch(const Exception& e)
+			{
+				job.has_failed = true;
+				job.failure_description = e.GetDescription();
+			}
+		}
+		if(job.has_failed == true)
+		{
+			++failed_count;
+		}
+		++done_count[job.GetPriority()];
+		job.is_done = true;
+	}
+
+	// See method declaration for details.
+	const bool AssetLoader::ArePrioritiesDone(const AssetJob::Priority priority) const
+	{
+		for(unsigned int i = 0; i <= static_cast<unsigned int>(priority) && i < AssetJob::PRIORITY_COUNT; ++i)
+		{
+			if(done_count[i] != submitted_count[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+
+
+} // utility
+} // avl
@@ -0,0 +1,253 @@
+#pragma once
+#ifndef AVL_UTILITY_ASSET_LOADER__
+#define AVL_UTILITY_ASSET_LOADER__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Defines the \ref avl::utility::AssetJob and \ref avl::utility::AssetLoader classes,
+which load assets on a pool of worker threads.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include<string>
+#include<deque>
+#include<vector>
+#include<memory>
+#include<Windows.h>
+
+
+namespace avl
+{
+namespace utility
+{
+
+	/**
+	A single asset to be loaded by an \ref AssetLoader. Loading is split into two
+	halves: \ref Load() reads and decodes the asset on a worker thread, and
+	\ref Finish() hands the decoded asset to whatever owns it (e.g. a Renderer or
+	SoundEngine) on the thread which calls AssetLoader::FinishLoadedJobs().
+	*/
+	class AssetJob
+	{
+	public:
+		/** How urgently an asset is needed. Jobs of a more urgent priority are always
+		started before jobs of a less urgent priority.*/
+		enum Priority
+		{
+			/// Needed before anything can be shown.
+			CRITICAL = 0,
+			/// Needed soon.
+			NORMAL = 1,
+			/// May stream in while the game is running.
+			BACKGROUND = 2,
+			/// The number of priorities.
+			PRIORITY_COUNT = 3
+		};
+
+		/** Basic constructor.
+		@param priority How urgently the asset is needed.
+		*/
+		AssetJob(const Priority priority);
+		/** Basic destructor.*/
+		virtual ~AssetJob();
+
+		/** Accesses the priority of the job.
+		@return How urgently the asset is needed.
+		*/
+		const Priority GetPriority() const;
+
+		/** Checks whether the job has been completed, successfully or not.
+		@return True if the job will no longer be touched by the loader.
+		*/
+		const bool IsDone() const;
+
+		/** Checks whether an exception was thrown while loading or finishing the asset.
+		@return True if the job failed.
+		*/
+		const bool HasFailed() const;
+
+		/** Describes why the job failed.
+		@return The description of the exception which was thrown, or an empty string
+		if the job didn't fail.
+		*/
+		const std::string& GetFailureDescription() const;
+
+	protected:
+		/** Reads and decodes the asset. Called on a worker thread, so this must not
+		touch anything which isn't safe to use from another thread.
+		@throws Exception If the asset can't be loaded. \ref Finish() won't be called.
+		*/
+		virtual void Load() = 0;
+
+		/** Hands the decoded asset to its owner. Called on the thread which calls
+		AssetLoader::FinishLoadedJobs().
+		@throws Exception If the asset can't be handed off.
+		*/
+		virtual void Finish() = 0;
+
+	private:
+		friend class AssetLoader;
+
+		/// How urgently the asset is needed.
+		const Priority priority;
+		/// Set once the loader is done with the job.
+		volatile bool is_done;
+		/// Set if Load() or Finish() threw an exception.
+		bool has_failed;
+		/// Why the job failed.
+		std::string failure_description;
+
+		/// NOT IMPLEMENTED.
+		AssetJob(const AssetJob&);
+		/// NOT IMPLEMENTED.
+		const AssetJob& operator=(const AssetJob&);
+	};
+
+
+
+	/**
+	Loads assets on a pool of worker threads. Jobs are submitted from one owning
+	thread, loaded in priority order across the pool, then finished back on the
+	owning thread in batches, so that device resources are only ever created from
+	the thread which owns the device.
+	@par Example:
+	@code
+	loader.Submit(title_screen_job);
+	loader.Submit(level_music_job);
+	// Wait for the first scene's assets, then let the rest stream in.
+	loader.WaitForPriority(AssetJob::CRITICAL);
+	while(running)
+	{
+		loader.FinishLoadedJobs(0.002);
+		...
+	}
+	@endcode
+	*/
+	class AssetLoader
+	{
+	public:
+		/** Starts the worker threads.
+		@param thread_count The number of worker threads to start. If zero, one fewer
+		than the number of processors is used, with a minimum of one.
+		@throws OutOfMemoryError If we run out of memory.
+		@throws Exception If unable to start the worker threads.
+		*/
+		AssetLoader(const unsigned int thread_count = 0);
+		/** Abandons any jobs which haven't been started, waits for the workers to
+		finish their current jobs, and stops them. Jobs which were loaded but never
+		finished are not finished.*/
+		~AssetLoader();
+
+		/** Queues \a job to be loaded.
+		@param job The job to load. The loader keeps it alive until it's done.
+		@throws InvalidArgumentException If \a job is null.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		void Submit(const std::shared_ptr<AssetJob>& job);
+
+		/** Finishes jobs which have been loaded, in the order they were loaded. Must be
+		called from the owning thread.
+		@param time_budget The number of seconds to spend finishing jobs, after which
+		the rest are left for the next call. Zero finishes every loaded job.
+		@return The number of jobs which were finished.
+		*/
+		const unsigned int FinishLoadedJobs(const double time_budget = 0.0);
+
+		/** Finishes jobs as they're loaded until every job of \a priority or more urgent
+		is done. Must be called from the owning thread.
+		@param priority The least urgent priority to wait for.
+		*/
+		void WaitForPriority(const AssetJob::Priority priority);
+
+		/** Accesses the number of jobs which have been submitted.
+		@return The number of jobs submitted.
+		*/
+		const unsigned int GetJobCount() const;
+
+		/** Accesses the number of jobs which are done, including those that failed.
+		@return The number of jobs done.
+		*/
+		const unsigned int GetDoneCount() const;
+
+		/** Accesses the number of jobs which failed.
+		@return The number of jobs which failed.
+		*/
+		const unsigned int GetFailedCount() const;
+
+		/** Computes the fraction of submitted jobs which are done.
+		@return A value from 0 to 1, or 1 if no jobs have been submitted.
+		*/
+		const float GetProgress() const;
+
+	private:
+		/** Entry point of the worker threads.
+		@param loader The AssetLoader which owns the worker.
+		@return Zero.
+		*/
+		static unsigned int __stdcall WorkerThread(void* loader);
+
+		/** Loads jobs until told to stop.*/
+		void RunWorker();
+
+		/** Stops the worker threads and releases the synchronization objects.*/
+		void Shutdown();
+
+		/** Finishes \a job, or records its failure.
+		@param job The loaded job.
+		*/
+		void FinishJob(AssetJob& job);
+
+		/** Checks whether every job of \a priority or more urgent is done.
+		@param priority The least urgent priority to check.
+		@return True if they're all done.
+		*/
+		const bool ArePrioritiesDone(const AssetJob::Priority priority) const;
+
+		/// Guards \ref pending_jobs and \ref loaded_jobs.
+		mutable CRITICAL_SECTION lock;
+		/// Jobs waiting to be loaded, by priority.
+		std::deque<std::shared_ptr<AssetJob>> pending_jobs[AssetJob::PRIORITY_COUNT];
+		/// Jobs waiting to be finished.
+		std::deque<std::shared_ptr<AssetJob>> loaded_jobs;
+		/// Counts the pending jobs; a worker takes one count per job.
+		HANDLE work_semaphore;
+		/// Signaled whenever a job is loaded.
+		HANDLE loaded_event;
+		/// The worker threads.
+		std::vector<HANDLE> workers;
+		/// Set when the workers should exit.
+		volatile bool is_stopping;
+		/// The number of jobs submitted at each priority.
+		unsigned int submitted_count[AssetJob::PRIORITY_COUNT];
+		/// The number of jobs done at each priority.
+		unsigned int done_count[AssetJob::PRIORITY_COUNT];
+		/// The number of jobs which failed.
+		unsigned int failed_count;
+
+		/// NOT IMPLEMENTED.
+		AssetLoader(const AssetLoader&);
+		/// NOT IMPLEMENTED.
+		const AssetLoader& operator=(const AssetLoader&);
+	};
+
+
+
+} // utility
+} // avl
+#endif // AVL_UTILITY_ASSET_LOADER__
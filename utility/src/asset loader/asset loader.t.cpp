@@ -0,0 +1,99 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the asset loader component. See "asset loader.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"asset loader.h"
+#include"..\exceptions\exceptions.h"
+#include"..\timer\timer.h"
+#include<iostream>
+#include<memory>
+#include<Windows.h>
+
+
+
+namespace
+{
+	/** Pretends to load an asset by sleeping, and records the order in which jobs finish.*/
+	class SleepJob: public avl::utility::AssetJob
+	{
+	public:
+		SleepJob(const Priority priority, const DWORD duration, const bool fail = false)
+			: AssetJob(priority), duration(duration), fail(fail)
+		{
+		}
+
+	protected:
+		void Load()
+		{
+			Sleep(duration);
+			if(fail == true)
+			{
+				throw avl::utility::FileFormatException("missing asset");
+			}
+		}
+
+		void Finish()
+		{
+			std::cout << "Finished a job of priority " << GetPriority() << '\n';
+		}
+
+	private:
+		const DWORD duration;
+		const bool fail;
+	};
+}
+
+
+
+void TestAssetLoaderComponent()
+{
+	using avl::utility::AssetJob;
+	using avl::utility::AssetLoader;
+
+	AssetLoader loader;
+	avl::utility::Timer timer;
+
+	// Submit the background jobs first; the critical ones should still start first.
+	for(int i = 0; i < 8; ++i)
+	{
+		loader.Submit(std::shared_ptr<AssetJob>(new SleepJob(AssetJob::BACKGROUND, 50)));
+	}
+	for(int i = 0; i < 4; ++i)
+	{
+		loader.Submit(std::shared_ptr<AssetJob>(new SleepJob(AssetJob::CRITICAL, 50)));
+	}
+	loader.Submit(std::shared_ptr<AssetJob>(new SleepJob(AssetJob::CRITICAL, 10, true)));
+
+	loader.WaitForPriority(AssetJob::CRITICAL);
+	std::cout << "Critical assets ready after " << timer.Elapsed() << "s (failed: " << loader.GetFailedCount() << ")\n";
+
+	// Stream the rest in while "running".
+	while(loader.GetDoneCount() < loader.GetJobCount())
+	{
+		loader.FinishLoadedJobs(0.002);
+		std::cout << "Progress: " << loader.GetProgress() * 100.0f << "%\n";
+		Sleep(16);
+	}
+	std::cout << "Everything loaded after " << timer.Elapsed() << "s (0.61s if loaded serially)\n";
+
+	system("pause");
+}
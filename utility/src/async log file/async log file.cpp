@@ -0,0 +1,265 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the async log file component. See "async log file.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"async log file.h"
+#include"..\exceptions\exceptions.h"
+#include<string>
+#include<cstring>
+#include<ctime>
+#include<new>
+#include<Windows.h>
+#include<process.h>
+
+
+
+namespace
+{
+	/// Batches are written to the file once they grow past this many bytes.
+	const std::size_t MAX_BATCH_SIZE = 64 * 1024;
+}
+
+
+
+namespace avl
+{
+namespace utility
+{
+
+	// See method declaration for details.
+	AsyncLogFile::AsyncLogFile(const std::string& file_name, const OverflowPolicy policy, const std::size_t capacity, const DWORD flush_interval)
+		: LogFile(file_name), records(capacity), overflow_policy(policy), flush_interval(flush_interval), wake_event(nullptr),
+		writer_thread(nullptr), is_stopping(0), has_failed(0), queued_count(0), written_count(0), dropped_count(0), cached_time(0)
+	{
+		// The writer wakes up when signaled, or after flush_interval at most.
+		wake_event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+		if(wake_event == nullptr)
+		{
+			throw Exception("avl::utility::AsyncLogFile::AsyncLogFile() -- Unable to create the wake event.");
+		}
+		writer_thread = reinterpret_cast<HANDLE>(_beginthreadex(nullptr, 0, &AsyncLogFile::WriterThread, this, 0, nullptr));
+		if(writer_thread == nullptr)
+		{
+			CloseHandle(wake_event);
+			throw Exception("avl::utility::AsyncLogFile::AsyncLogFile() -- Unable to start the background writer.");
+		}
+	}
+
+
+
+	// See method declaration for details.
+	AsyncLogFile::~AsyncLogFile()
+	{
+		// Tell the writer to write whatever is left and exit, then wait for it.
+		InterlockedExchange(&is_stopping, 1);
+		SetEvent(wake_event);
+		WaitForSingleObject(writer_thread, INFINITE);
+		CloseHandle(writer_thread);
+		CloseHandle(wake_event);
+	}
+
+
+
+	// See method declaration for details.
+	const LogFile& AsyncLogFile::operator()(const short& urgency, const std::string& message)
+	{
+		CheckWriter();
+
+		// Stamp the message now so that the time reflects when it was logged rather than
+		// when it was written.
+		Record record;
+		record.urgency = urgency;
+		record.time = time(nullptr);
+		if(message.size() <= INLINE_MESSAGE_LENGTH)
+		{
+			record.length = static_cast<unsigned short>(message.size());
+			memcpy(record.text, message.data(), message.size());
+			record.long_text = nullptr;
+		}
+		else
+		{
+			record.length = 0;
+			record.long_text = new(std::nothrow) std::string(message);
+			if(record.long_text == nullptr)
+			{
+				throw OutOfMemoryError();
+			}
+		}
+
+		// Handle a full queue according to the overflow policy.
+		while(records.TryPush(record) != true)
+		{
+			if(overflow_policy == DROP_MESSAGES)
+			{
+				delete record.long_text;
+				InterlockedIncrement(&dropped_count);
+				return *this;
+			}
+			SetEvent(wake_event);
+			if(SwitchToThread() == FALSE)
+			{
+				Sleep(1);
+			}
+			CheckWriter();
+		}
+		const LONG pending = InterlockedIncrement(&queued_count) - written_count;
+
+		// Wake the writer early for urgent messages, or if the queue is filling up.
+		if(urgency >= 4 || static_cast<std::size_t>(pending) >= records.GetCapacity() / 2)
+		{
+			SetEvent(wake_event);
+		}
+		return *this;
+	}
+
+
+
+	// See method declaration for details.
+	void AsyncLogFile::Flush()
+	{
+		const LONG target = queued_count;
+		SetEvent(wake_event);
+		while(static_cast<LONG>(written_count - target) < 0)
+		{
+			CheckWriter();
+			Sleep(1);
+		}
+		CheckWriter();
+	}
+
+
+
+	// See method declaration for details.
+	const unsigned long AsyncLogFile::GetDroppedCount() const
+	{
+		return static_cast<unsigned long>(dropped_count);
+	}
+
+
+
+	// See method declaration for details.
+	unsigned int __stdcall AsyncLogFile::WriterThread(void* log)
+	{
+		static_cast<AsyncLogFile*>(log)->RunWriter();
+		return 0;
+	}
+
+
+
+	// See method declaration for details.
+	void AsyncLogFile::RunWriter()
+	{
+		// Reused between batches so that the writer doesn't allocate in steady state.
+		std::string batch;
+		batch.reserve(MAX_BATCH_SIZE + INLINE_MESSAGE_LENGTH + 64);
+		while(true)
+		{
+			WaitForSingleObject(wake_event, flush_interval);
+			// Check for the stop request before draining so that nothing queued ahead of
+			// it is lost.
+			const bool stop = (is_stopping != 0);
+			DrainQueue(batch);
+			if(stop == true)
+			{
+				return;
+			}
+		}
+	}
+
+
+
+	// See method declaration for details.
+	void AsyncLogFile::DrainQueue(std::string& batch)
+	{
+		Record record;
+		LONG count = 0;
+		while(records.TryPop(record) == true)
+		{
+			FormatUrgency(record.urgency, batch);
+			// Messages tend to arrive in bursts within the same second, so only format the
+			// date and time when it changes.
+			if(record.time != cached_time || cached_time_stamp.empty() == true)
+			{
+				cached_time = record.time;
+				cached_time_stamp.clear();
+				FormatTimeStamp(record.time, cached_time_stamp);
+			}
+			batch += cached_time_stamp;
+			if(record.long_text == nullptr)
+			{
+				batch.append(record.text, record.length);
+			}
+			else
+			{
+				batch += *record.long_text;
+				delete record.long_text;
+			}
+			batch += '\n';
+			++count;
+
+			if(batch.size() >= MAX_BATCH_SIZE)
+			{
+				WriteBatch(batch, count);
+				count = 0;
+			}
+		}
+		if(count > 0)
+		{
+			WriteBatch(batch, count);
+		}
+	}
+
+
+
+	// See method declaration for details.
+	void AsyncLogFile::WriteBatch(std::string& batch, const LONG count)
+	{
+		// Once the file has failed, keep consuming messages so that producers and
+		// Flush() don't wait forever; they'll see the failure through CheckWriter().
+		if(has_failed == 0)
+		{
+			file.write(batch.data(), batch.size());
+			file.flush();
+			if(file.good() != true)
+			{
+				InterlockedExchange(&has_failed, 1);
+			}
+		}
+		batch.clear();
+		InterlockedExchangeAdd(&written_count, count);
+	}
+
+
+
+	// See method declaration for details.
+	void AsyncLogFile::CheckWriter() const
+	{
+		if(has_failed != 0)
+		{
+			throw FileWriteException(file_name);
+		}
+	}
+
+
+
+} // utility
+} // avl
@@ -0,0 +1,169 @@
+#pragma once
+#ifndef AVL_UTILITY_ASYNC_LOG_FILE__
+#define AVL_UTILITY_ASYNC_LOG_FILE__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Defines the \ref avl::utility::AsyncLogFile class, which logs messages to a file
+from a background thread.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"..\log file\log file.h"
+#include"..\lock free queue\lock free queue.h"
+#include<string>
+#include<ctime>
+#include<Windows.h>
+
+
+namespace avl
+{
+namespace utility
+{
+
+	/** A LogFile which does no file I/O on the calling thread. Messages are stamped
+	with the time, copied into a lock-free queue, and written in batches by a
+	background thread. The output format and urgency levels are identical to
+	those of LogFile.
+	@note Messages of up to \ref INLINE_MESSAGE_LENGTH characters are logged without
+	any heap allocation. Longer messages are copied to the heap before being queued.
+	*/
+	class AsyncLogFile: public LogFile
+	{
+	public:
+		/** Describes what happens to a message which is logged while the queue is full.*/
+		enum OverflowPolicy
+		{
+			/// The message is discarded and counted. See \ref GetDroppedCount().
+			DROP_MESSAGES,
+			/// The calling thread waits until the background thread frees up space.
+			BLOCK_UNTIL_SPACE
+		};
+
+		/** The number of characters of a message which are stored inside the queue itself.*/
+		static const std::size_t INLINE_MESSAGE_LENGTH = 200;
+
+		/** Opens \a file_name for appending and starts the background writer.
+		@param file_name Name of the file to log messages to.
+		@param policy What to do when a message is logged while the queue is full.
+		@param capacity The minimum number of messages which may be queued at once.
+		@param flush_interval The longest time in milliseconds which a queued message
+		waits before it's written.
+		@throws FileWriteException If an error occurs while attempting to access \a file_name.
+		@throws OutOfMemoryError If unable to allocate the message queue.
+		@throws Exception If unable to start the background writer.
+		*/
+		AsyncLogFile(const std::string& file_name, const OverflowPolicy policy = DROP_MESSAGES, const std::size_t capacity = 1024, const DWORD flush_interval = 50);
+		/** Writes any queued messages, stops the background writer, and closes the file.*/
+		~AsyncLogFile();
+
+		/** Queues a message to be logged to the file by the background writer. See
+		LogFile::operator()() for the format and range of \a urgency. Messages of
+		urgency 4 are handed to the background writer immediately.
+		@param urgency The urgency of the message, from 1 to 4.
+		@param message The message to be logged.
+		@throws FileWriteException If the background writer has failed to write to the file.
+		*/
+		const LogFile& operator()(const short& urgency, const std::string& message);
+
+		/** Blocks until every message queued before this call has been written to the file.
+		@throws FileWriteException If the background writer has failed to write to the file.
+		*/
+		void Flush();
+
+		/** Returns the number of messages which have been dropped because the queue was full.
+		@return The number of dropped messages.
+		*/
+		const unsigned long GetDroppedCount() const;
+
+	private:
+		/** A single queued message.*/
+		struct Record
+		{
+			/// The urgency of the message.
+			short urgency;
+			/// The time at which the message was logged.
+			time_t time;
+			/// The number of characters stored in \ref text.
+			unsigned short length;
+			/// The message, if it fits.
+			char text[INLINE_MESSAGE_LENGTH];
+			/// The message, if it doesn't fit into \ref text. Owned by the record.
+			std::string* long_text;
+		};
+
+		/** Entry point of the background writer.
+		@param log The AsyncLogFile which is being written.
+		@return Zero.
+		*/
+		static unsigned int __stdcall WriterThread(void* log);
+
+		/** Waits for queued messages and writes them until told to stop.*/
+		void RunWriter();
+
+		/** Writes every message in the queue to the file in batches.
+		@param batch Scratch storage for the formatted messages.
+		*/
+		void DrainQueue(std::string& batch);
+
+		/** Writes \a batch to the file and clears it. Records a write failure if one occurs.
+		@param batch The formatted messages.
+		@param count The number of messages in \a batch.
+		*/
+		void WriteBatch(std::string& batch, const LONG count);
+
+		/** Throws a FileWriteException if the background writer has failed.*/
+		void CheckWriter() const;
+
+		/// The queued messages.
+		LockFreeQueue<Record> records;
+		/// What to do when the queue is full.
+		const OverflowPolicy overflow_policy;
+		/// The longest time in milliseconds that the writer sleeps between batches.
+		const DWORD flush_interval;
+		/// Signals the background writer to write queued messages now.
+		HANDLE wake_event;
+		/// The background writer thread.
+		HANDLE writer_thread;
+		/// Set when the background writer should exit.
+		volatile LONG is_stopping;
+		/// Set when the background writer failed to write to the file.
+		volatile LONG has_failed;
+		/// The number of messages which have been queued.
+		volatile LONG queued_count;
+		/// The number of messages which have been written.
+		volatile LONG written_count;
+		/// The number of messages which have been dropped.
+		volatile LONG dropped_count;
+		/// The date and time of the previous message, cached by the background writer.
+		std::string cached_time_stamp;
+		/// The time which \ref cached_time_stamp represents.
+		time_t cached_time;
+
+		/// NOT IMPLEMENTED.
+		AsyncLogFile(const AsyncLogFile&);
+		/// NOT IMPLEMENTED.
+		const AsyncLogFile& operator=(const AsyncLogFile&);
+	};
+
+
+
+} // utility
+} // avl
+#endif // AVL_UTILITY_ASYNC_LOG_FILE__
@@ -0,0 +1,81 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the async log file component. See "async log file.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"async log file.h"
+#include"..\log file\log file.h"
+#include"..\timer\timer.h"
+#include"..\exceptions\exceptions.h"
+#include<iostream>
+#include<string>
+
+
+
+namespace
+{
+	/** Logs \a count messages to \a log and reports the mean and worst per-call latency.*/
+	void MeasureLatency(const std::string& name, avl::utility::LogFile& log, const unsigned int count)
+	{
+		const std::string message = "A typical log message of modest length.";
+		avl::utility::Timer timer;
+		double total = 0.0;
+		double worst = 0.0;
+		for(unsigned int i = 0; i < count; ++i)
+		{
+			timer.Reset();
+			log(1 + i % 3, message);
+			const double elapsed = timer.Elapsed();
+			total += elapsed;
+			worst = (elapsed > worst) ? elapsed : worst;
+		}
+		std::cout << name << ": mean " << (total / count) * 1000000.0 << "us, worst " << worst * 1000000.0 << "us\n";
+	}
+}
+
+
+
+void TestAsyncLogFileComponent()
+{
+	try
+	{
+		const unsigned int count = 10000;
+		{
+			avl::utility::LogFile log("test log.txt");
+			MeasureLatency("LogFile", log, count);
+		}
+		{
+			avl::utility::AsyncLogFile log("test async log.txt", avl::utility::AsyncLogFile::BLOCK_UNTIL_SPACE, count);
+			MeasureLatency("AsyncLogFile", log, count);
+			log.Flush();
+			std::cout << "Dropped (expecting 0): " << log.GetDroppedCount() << '\n';
+
+			// Long messages take the slow path but must still come out intact.
+			log(4, std::string(500, 'x'));
+		}
+	}
+	catch (const avl::utility::FileIOException& e)
+	{
+		std::cout << e.GetDescription() << std::endl;
+	}
+
+	system("pause");
+}
@@ -0,0 +1,178 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the content hash component. See "content hash.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"content hash.h"
+#include<cstddef>
+#include<cstring>
+#include<emmintrin.h>
+
+
+namespace avl
+{
+namespace utility
+{
+	// See method definitions for details.
+	namespace
+	{
+		/// The number of bytes read into the accumulators at a time.
+		const std::size_t STRIPE_SIZE = 32;
+		/// The accumulators are scrambled after this many stripes.
+		const std::size_t STRIPES_PER_BLOCK = 16;
+		/// Multiplies the accumulators when they're scrambled.
+		const unsigned int SCRAMBLE_PRIME = 0x9E3779B1U;
+		/// Primes used to mix the accumulators into the hash.
+		const unsigned long long PRIME_1 = 0x9E3779B185EBCA87ULL;
+		const unsigned long long PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+		const unsigned long long PRIME_3 = 0x165667B19E3779F9ULL;
+		/// The key XORed with each lane.
+		const unsigned long long KEYS[4] = {0xBE4BA423396CFEB8ULL, 0x1CAD21F72C81017CULL, 0xDB979083E96DD4DEULL, 0x1F67B3B7A4A44072ULL};
+		/// The accumulators' starting values.
+		const unsigned long long INITIAL_ACCUMULATORS[4] = {PRIME_3, PRIME_1, PRIME_2, 0xC2B2AE3DULL};
+
+		void AccumulateStripes(__m128i* const accumulators, const unsigned char* data, const std::size_t stripe_count);
+		void ScrambleAccumulators(__m128i* const accumulators);
+		const unsigned long long MixAccumulators(const unsigned long long* const accumulators, const std::size_t size, const unsigned long long seed);
+	}
+
+
+
+	// See function declaration for details.
+	const unsigned long long HashContent(const void* const data, const std::size_t size, const unsigned long long seed)
+	{
+		const unsigned char* next = static_cast<const unsigned char*>(data);
+		__m128i accumulators[2] =
+		{
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(&INITIAL_ACCUMULATORS[0])),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(&INITIAL_ACCUMULATORS[2]))
+		};
+
+		// Whole blocks of stripes.
+		std::size_t stripes_left = size / STRIPE_SIZE;
+		while(stripes_left >= STRIPES_PER_BLOCK)
+		{
+			AccumulateStripes(accumulators, next, STRIPES_PER_BLOCK);
+			ScrambleAccumulators(accumulators);
+			next += STRIPES_PER_BLOCK * STRIPE_SIZE;
+			stripes_left -= STRIPES_PER_BLOCK;
+		}
+		// The stripes of the last partial block, then the partial stripe padded with zeroes.
+		AccumulateStripes(accumulators, next, stripes_left);
+		next += stripes_left * STRIPE_SIZE;
+		const std::size_t tail_size = size % STRIPE_SIZE;
+		if(tail_size != 0)
+		{
+			unsigned char tail[STRIPE_SIZE] = {0};
+			memcpy(tail, next, tail_size);
+			AccumulateStripes(accumulators, tail, 1);
+		}
+
+		unsigned long long lanes[4];
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&lanes[0]), accumulators[0]);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&lanes[2]), accumulators[1]);
+		return MixAccumulators(lanes, size, seed);
+	}
+
+
+
+	// Anonymous namespace.
+	namespace
+	{
+		/** Reads whole stripes into the accumulators, two lanes per register.
+		@param accumulators The accumulators for lanes 0 and 1, then lanes 2 and 3.
+		@param data The stripes to read.
+		@param stripe_count The number of stripes to read.
+		*/
+		void AccumulateStripes(__m128i* const accumulators, const unsigned char* data, const std::size_t stripe_count)
+		{
+			const __m128i low_keys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&KEYS[0]));
+			const __m128i high_keys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&KEYS[2]));
+			__m128i low = accumulators[0];
+			__m128i high = accumulators[1];
+			for(std::size_t i = 0; i < stripe_count; ++i, data += STRIPE_SIZE)
+			{
+				const __m128i low_lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+				const __m128i high_lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+				const __m128i low_keyed = _mm_xor_si128(low_lanes, low_keys);
+				const __m128i high_keyed = _mm_xor_si128(high_lanes, high_keys);
+				// Multiply the low half of each keyed lane by its high half.
+				const __m128i low_products = _mm_mul_epu32(low_keyed, _mm_shuffle_epi32(low_keyed, _MM_SHUFFLE(3, 3, 1, 1)));
+				const __m128i high_products = _mm_mul_epu32(high_keyed, _mm_shuffle_epi32(high_keyed, _MM_SHUFFLE(3, 3, 1, 1)));
+				// Swap each pair of lanes to add them to their neighbours.
+				low = _mm_add_epi64(low, _mm_add_epi64(low_products, _mm_shuffle_epi32(low_lanes, _MM_SHUFFLE(1, 0, 3, 2))));
+				high = _mm_add_epi64(high, _mm_add_epi64(high_products, _mm_shuffle_epi32(high_lanes, _MM_SHUFFLE(1, 0, 3, 2))));
+			}
+			accumulators[0] = low;
+			accumulators[1] = high;
+		}
+
+
+
+		/** Spreads the high bits of each accumulator into its low bits, so that they keep
+		counting towards the products.
+		@param accumulators The accumulators for lanes 0 and 1, then lanes 2 and 3.
+		*/
+		void ScrambleAccumulators(__m128i* const accumulators)
+		{
+			const __m128i prime = _mm_set1_epi32(static_cast<int>(SCRAMBLE_PRIME));
+			for(unsigned int i = 0; i < 2; ++i)
+			{
+				const __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&KEYS[i * 2]));
+				__m128i lanes = accumulators[i];
+				lanes = _mm_xor_si128(lanes, _mm_srli_epi64(lanes, 47));
+				lanes = _mm_xor_si128(lanes, keys);
+				// SSE2 only multiplies 32-bit halves, so multiply the 64-bit lanes a half at a time.
+				const __m128i low_products = _mm_mul_epu32(lanes, prime);
+				const __m128i high_products = _mm_mul_epu32(_mm_srli_epi64(lanes, 32), prime);
+				accumulators[i] = _mm_add_epi64(low_products, _mm_slli_epi64(high_products, 32));
+			}
+		}
+
+
+
+		/** Mixes the accumulators into the final hash.
+		@param accumulators The four accumulators.
+		@param size The size of the data in bytes.
+		@param seed The seed.
+		@return The hash.
+		*/
+		const unsigned long long MixAccumulators(const unsigned long long* const accumulators, const std::size_t size, const unsigned long long seed)
+		{
+			unsigned long long hash = seed ^ (static_cast<unsigned long long>(size) * PRIME_1);
+			for(unsigned int i = 0; i < 4; ++i)
+			{
+				hash ^= accumulators[i] * PRIME_2;
+				hash = ((hash << 31) | (hash >> 33)) * PRIME_1;
+			}
+			hash ^= hash >> 33;
+			hash *= PRIME_2;
+			hash ^= hash >> 29;
+			hash *= PRIME_3;
+			hash ^= hash >> 32;
+			return hash;
+		}
+	}
+
+
+
+} // utility
+} // avl
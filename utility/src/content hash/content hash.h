@@ -0,0 +1,59 @@
+#pragma once
+#ifndef AVL_UTILITY_CONTENT_HASH__
+#define AVL_UTILITY_CONTENT_HASH__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Computes fast, non-cryptographic 64-bit hashes of large blocks of data, such as
+pixel data, so that identical contents can be found without comparing them byte by byte.
+@par Algorithm:
+The data is read in stripes of 32 bytes, as four 64-bit little-endian lanes, into four
+64-bit accumulators; a final partial stripe is padded with zeroes. Each lane is XORed
+with a key, and the product of its low and high halves is added to its accumulator,
+while the lane itself is added to its neighbour's accumulator (lanes 0 and 1 are
+neighbours, as are lanes 2 and 3). After every 16 stripes the accumulators are
+scrambled. Finally the accumulators, the size, and the seed are mixed into the hash.
+Two lanes are processed at a time with SSE2.
+@par Collisions:
+The hash is meant to tell apart data that differs by accident, not by design. Anyone able
+to choose the data can make two blocks collide.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include<cstddef>
+
+
+namespace avl
+{
+namespace utility
+{
+	/** Hashes \a size bytes of \a data.
+	@param data The data to hash. Needn't be aligned.
+	@param size The size of \a data in bytes.
+	@param seed Mixed into the hash. Hashing several blocks in turn, each seeded with the hash
+	of the last, hashes them as a whole.
+	@return The hash.
+	*/
+	const unsigned long long HashContent(const void* const data, const std::size_t size, const unsigned long long seed = 0);
+
+
+
+} // utility
+} // avl
+#endif // AVL_UTILITY_CONTENT_HASH__
@@ -0,0 +1,184 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the content hash component. See "content hash.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"content hash.h"
+#include"..\assert\assert.h"
+#include"..\timer\timer.h"
+#include<iostream>
+#include<vector>
+#include<set>
+#include<cstdlib>
+
+
+
+// Anonymous namespace.
+namespace
+{
+	const unsigned long long ReferenceHash(const unsigned char* const data, const std::size_t size, const unsigned long long seed);
+}
+
+
+
+void TestContentHashComponent()
+{
+	using avl::utility::HashContent;
+	using avl::utility::Timer;
+
+	std::vector<unsigned char> data(1 << 16);
+	for(std::size_t i = 0; i < data.size(); ++i)
+	{
+		data[i] = static_cast<unsigned char>(rand());
+	}
+
+	// The SSE2 hash must match a plain scalar one exactly, at every alignment and at sizes
+	// around the stripe and block boundaries.
+	const std::size_t sizes[] = {0, 1, 7, 31, 32, 33, 100, 511, 512, 513, 1024, 4000, 65000};
+	for(unsigned int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+	{
+		for(std::size_t offset = 0; offset < 16; ++offset)
+		{
+			ASSERT(HashContent(&data[offset], sizes[i], 0) == ReferenceHash(&data[offset], sizes[i], 0));
+			ASSERT(HashContent(&data[offset], sizes[i], 12345) == ReferenceHash(&data[offset], sizes[i], 12345));
+		}
+	}
+	std::cout << "SSE2 hashes match the scalar reference.\n";
+
+	// Flipping any single bit of a block changes its hash, as does appending a zero.
+	{
+		std::set<unsigned long long> hashes;
+		std::vector<unsigned char> block(data.begin(), data.begin() + 600);
+		hashes.insert(HashContent(&block[0], block.size()));
+		for(std::size_t bit = 0; bit < block.size() * 8; ++bit)
+		{
+			block[bit / 8] ^= static_cast<unsigned char>(1 << (bit % 8));
+			hashes.insert(HashContent(&block[0], block.size()));
+			block[bit / 8] ^= static_cast<unsigned char>(1 << (bit % 8));
+		}
+		ASSERT(hashes.size() == block.size() * 8 + 1);
+		block.push_back(0);
+		ASSERT(hashes.count(HashContent(&block[0], block.size())) == 0);
+		std::cout << "Every single-bit change gives a different hash.\n";
+	}
+
+	// Identical contents give identical hashes, wherever they're stored.
+	{
+		const std::vector<unsigned char> copy(data.begin() + 3, data.begin() + 3 + 4096);
+		ASSERT(HashContent(&copy[0], copy.size()) == HashContent(&data[3], 4096));
+		// Blocks hashed in turn, each seeded with the last one's hash, hash the same too.
+		ASSERT(HashContent(&data[2051], 2048, HashContent(&data[3], 2048)) == HashContent(&copy[2048], 2048, HashContent(&copy[0], 2048)));
+		ASSERT(HashContent(&copy[2048], 2048, HashContent(&copy[0], 2048)) != HashContent(&copy[2048], 2048));
+		std::cout << "Identical contents hash the same.\n";
+	}
+
+	// Throughput, on a 1024x1024 32-bit image.
+	{
+		std::vector<unsigned char> image(1024 * 1024 * 4);
+		for(std::size_t i = 0; i < image.size(); ++i)
+		{
+			image[i] = static_cast<unsigned char>(i * 7 + (i >> 12));
+		}
+		const unsigned int repetitions = 20;
+		unsigned long long total = 0;
+		const Timer timer;
+		for(unsigned int i = 0; i < repetitions; ++i)
+		{
+			total ^= HashContent(&image[0], image.size(), i);
+		}
+		const double hash_time = timer.Elapsed();
+		const Timer reference_timer;
+		for(unsigned int i = 0; i < repetitions; ++i)
+		{
+			total ^= ReferenceHash(&image[0], image.size(), i);
+		}
+		const double reference_time = reference_timer.Elapsed();
+		const double megabytes = static_cast<double>(image.size()) * repetitions / (1024.0 * 1024.0);
+		std::cout << "Hash throughput (" << total % 2 << "):\n"
+			<< "  scalar " << megabytes / reference_time << " MB/s\n"
+			<< "  SSE2   " << megabytes / hash_time << " MB/s\n";
+	}
+
+	system("pause");
+}
+
+
+
+// Anonymous namespace.
+namespace
+{
+	/** Hashes data the plain way, one lane at a time, for comparison.
+	@param data The data to hash.
+	@param size The size of \a data in bytes.
+	@param seed The seed.
+	@return The hash.
+	*/
+	const unsigned long long ReferenceHash(const unsigned char* const data, const std::size_t size, const unsigned long long seed)
+	{
+		const unsigned long long prime_1 = 0x9E3779B185EBCA87ULL;
+		const unsigned long long prime_2 = 0xC2B2AE3D27D4EB4FULL;
+		const unsigned long long prime_3 = 0x165667B19E3779F9ULL;
+		const unsigned long long keys[4] = {0xBE4BA423396CFEB8ULL, 0x1CAD21F72C81017CULL, 0xDB979083E96DD4DEULL, 0x1F67B3B7A4A44072ULL};
+		unsigned long long accumulators[4] = {prime_3, prime_1, prime_2, 0xC2B2AE3DULL};
+
+		// Pad the data with zeroes to a whole number of stripes.
+		std::vector<unsigned char> padded(data, data + size);
+		padded.resize((size + 31) / 32 * 32, 0);
+		const std::size_t stripe_count = padded.size() / 32;
+		for(std::size_t stripe = 0; stripe < stripe_count; ++stripe)
+		{
+			for(unsigned int lane = 0; lane < 4; ++lane)
+			{
+				unsigned long long value = 0;
+				for(unsigned int byte = 0; byte < 8; ++byte)
+				{
+					value |= static_cast<unsigned long long>(padded[stripe * 32 + lane * 8 + byte]) << (byte * 8);
+				}
+				const unsigned long long keyed = value ^ keys[lane];
+				accumulators[lane] += (keyed & 0xFFFFFFFFULL) * (keyed >> 32);
+				accumulators[lane ^ 1] += value;
+			}
+			// Only whole blocks of 16 stripes are scrambled, never the padded stripe.
+			if(stripe % 16 == 15 && (stripe + 1) * 32 <= size)
+			{
+				for(unsigned int lane = 0; lane < 4; ++lane)
+				{
+					accumulators[lane] ^= accumulators[lane] >> 47;
+					accumulators[lane] ^= keys[lane];
+					accumulators[lane] *= 0x9E3779B1ULL;
+				}
+			}
+		}
+
+		unsigned long long hash = seed ^ (static_cast<unsigned long long>(size) * prime_1);
+		for(unsigned int lane = 0; lane < 4; ++lane)
+		{
+			hash ^= accumulators[lane] * prime_2;
+			hash = ((hash << 31) | (hash >> 33)) * prime_1;
+		}
+		hash ^= hash >> 33;
+		hash *= prime_2;
+		hash ^= hash >> 29;
+		hash *= prime_3;
+		hash ^= hash >> 32;
+		return hash;
+	}
+}
@@ -26,6 +26,9 @@ Implementation for the file operations component. See "file operations.h" for de
 #include<string>
 #include<vector>
 #include<fstream>
+#include<memory>
+#include<new>
+#include<Windows.h>
 
 
 namespace avl
@@ -81,6 +84,17 @@ namespace utility
 		}
 	}
 
+	// See function declaration for details.
+	const unsigned long long FileLastWriteTime(const std::string& file_name)
+	{
+		WIN32_FILE_ATTRIBUTE_DATA attributes;
+		if(GetFileAttributesEx(file_name.c_str(), GetFileExInfoStandard, &attributes) == FALSE)
+		{
+			throw FileNotFoundException(file_name);
+		}
+		return (static_cast<unsigned long long>(attributes.ftLastWriteTime.dwHighDateTime) << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+	}
+
 	// See function declaration for details.
 	void LoadFile(const std::string& file_name, std::vector<char>& file_data)
 	{
@@ -246,5 +260,225 @@ namespace utility
 	}
 
 
+	/**
+	Holds the contents of a file for a MappedFile, either as a read-only view of a
+	file mapping or as a buffer which the file was read into.
+	*/
+	class MappedFile::Storage
+	{
+	public:
+		/** Maps the file named \a file_name, or reads it into a buffer if it can't be mapped.
+		@param file_name The name of the file.
+		@param pattern How the contents of the file will be read.
+		@throws OutOfMemoryError If we run out of memory.
+		@throws FileNotFoundException If the file doesn't exist.
+		@throws FileReadException If an error occurs while reading from the file.
+		*/
+		Storage(const std::string& file_name, const AccessPattern pattern);
+		/** Takes ownership of data which is already in memory.
+		@post \a file_data is empty.
+		@param file_data The data.
+		*/
+		Storage(std::vector<char>& file_data);
+		/** Unmaps the file.*/
+		~Storage();
+
+		/// The file's handle, if it's mapped.
+		HANDLE file;
+		/// The file mapping's handle, if it's mapped.
+		HANDLE mapping;
+		/// The mapped view of the file, if it's mapped.
+		const char* view;
+		/// The contents of the file, if it couldn't be mapped.
+		std::vector<char> buffer;
+		/// The size of the file in bytes.
+		std::size_t size;
+
+	private:
+		/// NOT IMPLEMENTED.
+		Storage(const Storage&);
+		/// NOT IMPLEMENTED.
+		const Storage& operator=(const Storage&);
+	};
+
+	// See method declaration for details.
+	MappedFile::Storage::Storage(const std::string& file_name, const AccessPattern pattern)
+		: file(INVALID_HANDLE_VALUE), mapping(nullptr), view(nullptr), size(0)
+	{
+		// Let the cache manager know how the file will be read so that it can read
+		// ahead or not accordingly.
+		const DWORD hint = (pattern == SEQUENTIAL) ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+		file = CreateFile(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | hint, nullptr);
+		if(file == INVALID_HANDLE_VALUE)
+		{
+			const DWORD error = GetLastError();
+			if(error == ERROR_FILE_NOT_FOUND || error == ERROR_PATH_NOT_FOUND)
+			{
+				throw FileNotFoundException(file_name);
+			}
+		}
+		else
+		{
+			LARGE_INTEGER file_size;
+			if(GetFileSizeEx(file, &file_size) == FALSE || static_cast<ULONGLONG>(file_size.QuadPart) > static_cast<std::size_t>(-1))
+			{
+				CloseHandle(file);
+				throw FileReadException(file_name);
+			}
+			size = static_cast<std::size_t>(file_size.QuadPart);
+			// Empty files can't be mapped, and there's nothing to read anyway.
+			if(size == 0)
+			{
+				return;
+			}
+			mapping = CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if(mapping != nullptr)
+			{
+				view = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+				if(view != nullptr)
+				{
+					return;
+				}
+				CloseHandle(mapping);
+				mapping = nullptr;
+			}
+			CloseHandle(file);
+			file = INVALID_HANDLE_VALUE;
+		}
+
+		// The file couldn't be mapped (e.g. the address space is exhausted), so fall
+		// back to reading it into memory.
+		LoadFile(file_name, buffer);
+		size = buffer.size();
+	}
+
+	// See method declaration for details.
+	MappedFile::Storage::Storage(std::vector<char>& file_data)
+		: file(INVALID_HANDLE_VALUE), mapping(nullptr), view(nullptr), size(file_data.size())
+	{
+		buffer.swap(file_data);
+	}
+
+	// See method declaration for details.
+	MappedFile::Storage::~Storage()
+	{
+		if(view != nullptr)
+		{
+			UnmapViewOfFile(view);
+		}
+		if(mapping != nullptr)
+		{
+			CloseHandle(mapping);
+		}
+		if(file != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(file);
+		}
+	}
+
+
+
+	// See method declaration for details.
+	MappedFile::MappedFile(const std::string& file_name, const AccessPattern pattern)
+		: file_name(file_name), data(nullptr), size(0)
+	{
+		try
+		{
+			storage.reset(new Storage(file_name, pattern));
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw OutOfMemoryError();
+		}
+		size = storage->size;
+		if(storage->view != nullptr)
+		{
+			data = storage->view;
+		}
+		else if(storage->buffer.empty() == false)
+		{
+			data = &storage->buffer[0];
+		}
+	}
+
+	// See method declaration for details.
+	MappedFile::MappedFile(const MappedFile& source, const std::size_t offset, const std::size_t size, const std::string& file_name)
+		: storage(source.storage), file_name(file_name), data(nullptr), size(size)
+	{
+		if(offset > source.size || size > source.size - offset)
+		{
+			throw InvalidArgumentException("avl::utility::MappedFile::MappedFile()", "offset", "The view must lie within the source view.");
+		}
+		if(size > 0)
+		{
+			data = source.data + offset;
+		}
+	}
+
+	// See method declaration for details.
+	MappedFile::MappedFile(std::vector<char>& file_data, const std::string& file_name)
+		: file_name(file_name), data(nullptr), size(0)
+	{
+		try
+		{
+			storage.reset(new Storage(file_data));
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw OutOfMemoryError();
+		}
+		size = storage->size;
+		if(storage->buffer.empty() == false)
+		{
+			data = &storage->buffer[0];
+		}
+	}
+
+	// See method declaration for details.
+	MappedFile::MappedFile(const MappedFile& original)
+		: storage(original.storage), file_name(original.file_name), data(original.data), size(original.size)
+	{
+	}
+
+	// See method declaration for details.
+	MappedFile::~MappedFile()
+	{
+	}
+
+	// See method declaration for details.
+	MappedFile& MappedFile::operator=(const MappedFile& original)
+	{
+		storage = original.storage;
+		file_name = original.file_name;
+		data = original.data;
+		size = original.size;
+		return *this;
+	}
+
+	// See method declaration for details.
+	const char* const MappedFile::GetData() const
+	{
+		return data;
+	}
+
+	// See method declaration for details.
+	const std::size_t MappedFile::GetSize() const
+	{
+		return size;
+	}
+
+	// See method declaration for details.
+	const bool MappedFile::IsMapped() const
+	{
+		return storage->view != nullptr;
+	}
+
+	// See method declaration for details.
+	const std::string& MappedFile::GetFileName() const
+	{
+		return file_name;
+	}
+
+
 } // utility
 } // avl
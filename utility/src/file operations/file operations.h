@@ -27,6 +27,8 @@ Provides basic functions for reading from and writing to files.
 #include<string>
 #include<vector>
 #include<fstream>
+#include<memory>
+#include<cstddef>
 
 namespace avl
 {
@@ -46,6 +48,13 @@ namespace utility
 	*/
 	const std::streamoff FileSize(const std::string& file_name);
 
+	/** Checks when the file named \a file_name was last written to.
+	@param file_name The name of the file to check.
+	@return The time at which the file was last written to, as a Windows file time.
+	@throws FileNotFoundException If the file doesn't exist.
+	*/
+	const unsigned long long FileLastWriteTime(const std::string& file_name);
+
 	/** Reads the file named \a file_name to \a file_data.
 	@param file_name The name of the file to read from.
 	@param file_data Will be used to store the data from the file named
@@ -97,6 +106,110 @@ namespace utility
 
 
 
+	/**
+	A read-only view of the entire contents of a file. Where possible the file is
+	mapped into memory so that its contents are paged in on demand and never copied;
+	otherwise the file is read into a buffer with \ref LoadFile(). Either way the
+	contents stay valid for as long as any copy of the MappedFile exists, so loaders
+	may decode straight from \ref GetData() without taking a copy of their own.
+	*/
+	class MappedFile
+	{
+	public:
+		/** Describes how the contents of a file will be read, so that the operating
+		system can schedule reads from the disk appropriately.*/
+		enum AccessPattern
+		{
+			/// The file will be read from front to back, mostly once.
+			SEQUENTIAL,
+			/// The file will be read in no particular order.
+			RANDOM
+		};
+
+		/** Maps the file named \a file_name into memory.
+		@param file_name The name of the file to map.
+		@param pattern How the contents of the file will be read.
+		@throws OutOfMemoryError If we run out of memory.
+		@throws FileNotFoundException If the file doesn't exist.
+		@throws FileReadException If an error occurs while reading from the file.
+		*/
+		MappedFile(const std::string& file_name, const AccessPattern pattern = SEQUENTIAL);
+
+		/** Creates a view of part of another view's contents. The contents stay valid
+		for as long as either view exists.
+		@param source The view which contains the new view.
+		@param offset The offset of the new view from the start of \a source, in bytes.
+		@param size The size of the new view in bytes.
+		@param file_name The name to report for the new view.
+		@throws InvalidArgumentException If the new view doesn't lie within \a source.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		MappedFile(const MappedFile& source, const std::size_t offset, const std::size_t size, const std::string& file_name);
+
+		/** Creates a view of data which is already in memory (e.g. data which has been
+		decompressed), taking ownership of it.
+		@post \a file_data is empty.
+		@param file_data The data. Its contents are moved into the view.
+		@param file_name The name to report for the view.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		MappedFile(std::vector<char>& file_data, const std::string& file_name);
+
+		/** Creates a view which shares the contents of \a original.
+		@param original The view to share.
+		*/
+		MappedFile(const MappedFile& original);
+
+		/** Basic destructor. The file is unmapped once the last view of it is destroyed.*/
+		~MappedFile();
+
+		/** Makes this view share the contents of \a original.
+		@param original The view to share.
+		@return This view.
+		*/
+		MappedFile& operator=(const MappedFile& original);
+
+		/** Accesses the contents of the file.
+		@return The first byte of the file, or nullptr if the file is empty.
+		*/
+		const char* const GetData() const;
+
+		/** Accesses the size of the file.
+		@return The size of the file in bytes.
+		*/
+		const std::size_t GetSize() const;
+
+		/** Checks whether the file was actually mapped into memory, or if it was
+		read into a buffer instead.
+		@return True if the file is mapped, and false if it was read into or created
+		from a buffer.
+		*/
+		const bool IsMapped() const;
+
+		/** Accesses the name of the file.
+		@return The name of the file.
+		*/
+		const std::string& GetFileName() const;
+
+	private:
+		/// Owns the mapping or buffer which holds the contents of the file.
+		class Storage;
+
+		/// Shared by every view of the same file.
+		std::shared_ptr<const Storage> storage;
+		/// The name of the file.
+		std::string file_name;
+		/// The first byte of the file.
+		const char* data;
+		/// The size of the file in bytes.
+		std::size_t size;
+
+		/// NOT IMPLEMENTED.
+		MappedFile();
+	};
+
+
+
 } // utility
 } // avl
 #endif // AVL_UTILITY_FILE_OPERATIONS__
@@ -25,14 +25,28 @@ Unit test for the file operations component. See "file operations.h" for details
 #include<iostream>
 #include<string>
 #include<vector>
+#include<cstring>
 
 using avl::utility::FileExists;
 using avl::utility::FileSize;
 using avl::utility::LoadFile;
 using avl::utility::WriteFile;
+using avl::utility::MappedFile;
 
 void TestFileOperationsComponent()
 {
+	// A mapped file should hold exactly what LoadFile() reads.
+	const std::string file_name = "assets/Example.txt";
+	std::vector<char> loaded;
+	LoadFile(file_name, loaded);
+	const MappedFile mapped(file_name);
+	const bool same = mapped.GetSize() == loaded.size() && (loaded.empty() == true || memcmp(mapped.GetData(), &loaded[0], loaded.size()) == 0);
+	std::cout << "Mapped: " << mapped.IsMapped() << ", matches LoadFile(): " << same << std::endl;
+
+	// Copies share the mapping and keep it alive.
+	MappedFile* copy = new MappedFile(mapped);
+	std::cout << "Copy shares data: " << (copy->GetData() == mapped.GetData()) << std::endl;
+	delete copy;
 	
 	system("pause");
 }
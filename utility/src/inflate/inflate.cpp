@@ -0,0 +1,574 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the inflate component. See "inflate.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"inflate.h"
+#include<cstddef>
+#include<cstring>
+
+
+namespace avl
+{
+namespace utility
+{
+	// See method definitions for details.
+	namespace
+	{
+		/// The number of bits resolved by a single lookup in a Huffman table.
+		const unsigned int FAST_BITS = 10;
+		/// The longest code allowed by DEFLATE.
+		const unsigned int MAXIMUM_CODE_LENGTH = 15;
+		/// The number of literal/length symbols, including the two which are never used.
+		const unsigned int LITERAL_LENGTH_SYMBOLS = 288;
+		/// The number of distance symbols, including the two which are never used.
+		const unsigned int DISTANCE_SYMBOLS = 32;
+		/// The number of code length symbols.
+		const unsigned int CODE_LENGTH_SYMBOLS = 19;
+		/// Marks the end of a block.
+		const unsigned int END_OF_BLOCK = 256;
+
+		/** Reads the compressed data a bit at a time, least significant bit first. Bits are
+		buffered 64 at a time; past the end of the data, the buffer is padded with zeros, and
+		reading into the padding is detected afterwards rather than checked for on every read.*/
+		struct BitReader
+		{
+			/// The next byte to buffer.
+			const unsigned char* next;
+			/// One past the last byte of data.
+			const unsigned char* end;
+			/// The buffered bits.
+			unsigned long long bits;
+			/// The number of buffered bits.
+			unsigned int count;
+			/// The number of buffered or consumed bits which were padding.
+			unsigned int padding;
+		};
+
+		/** A canonical Huffman code. A symbol whose code is no longer than \ref FAST_BITS is
+		found in \ref fast; longer codes are found by comparing the code against the last code
+		of each length.*/
+		struct HuffmanTable
+		{
+			/// Indexed by the next \ref FAST_BITS bits of input. Each entry is the code's length
+			/// shifted left by 9, plus its symbol, or zero if the code is longer.
+			unsigned short fast[1 << FAST_BITS];
+			/// The first code of each length.
+			unsigned short first_code[MAXIMUM_CODE_LENGTH + 2];
+			/// The index in \ref symbols of the first code of each length.
+			unsigned short first_symbol[MAXIMUM_CODE_LENGTH + 2];
+			/// One past the last code of each length, left-justified in 16 bits.
+			unsigned int end_code[MAXIMUM_CODE_LENGTH + 2];
+			/// The symbols, sorted by code.
+			unsigned short symbols[LITERAL_LENGTH_SYMBOLS];
+		};
+
+		const bool InflateBlocks(BitReader& reader, unsigned char* const data, const std::size_t size);
+		const bool InflateStored(BitReader& reader, unsigned char* const data, const std::size_t size, std::size_t& written);
+		const bool InflateHuffman(BitReader& reader, const HuffmanTable& literals, const HuffmanTable& distances, unsigned char* const data, const std::size_t size, std::size_t& written);
+		const bool ReadDynamicTables(BitReader& reader, HuffmanTable& literals, HuffmanTable& distances);
+		const bool BuildTable(HuffmanTable& table, const unsigned char* const lengths, const unsigned int symbol_count);
+		void BuildFixedTables(HuffmanTable& literals, HuffmanTable& distances);
+		void Refill(BitReader& reader);
+		const unsigned int ReadBits(BitReader& reader, const unsigned int count);
+		const int DecodeSymbol(BitReader& reader, const HuffmanTable& table);
+		const bool HasOverrun(const BitReader& reader);
+		const unsigned int ReverseBits(unsigned int bits, const unsigned int count);
+		const unsigned int Adler32(const unsigned char* data, std::size_t size);
+	}
+
+
+
+	// See function declaration for details.
+	const bool Inflate(const char* const compressed, const std::size_t compressed_size, char* const data, const std::size_t size)
+	{
+		BitReader reader;
+		reader.next = reinterpret_cast<const unsigned char*>(compressed);
+		reader.end = reader.next + compressed_size;
+		reader.bits = 0;
+		reader.count = 0;
+		reader.padding = 0;
+		return InflateBlocks(reader, reinterpret_cast<unsigned char*>(data), size);
+	}
+
+
+
+	// See function declaration for details.
+	const bool InflateZlib(const char* const compressed, const std::size_t compressed_size, char* const data, const std::size_t size)
+	{
+		// The header is a compression method byte and a flags byte, which together are a
+		// multiple of 31. Only DEFLATE without a preset dictionary is supported.
+		const unsigned char* const in = reinterpret_cast<const unsigned char*>(compressed);
+		if(compressed_size < 6 || (in[0] & 0x0F) != 8 || (in[0] >> 4) > 7 || (in[0] * 256 + in[1]) % 31 != 0 || (in[1] & 0x20) != 0)
+		{
+			return false;
+		}
+
+		BitReader reader;
+		reader.next = in + 2;
+		reader.end = in + compressed_size;
+		reader.bits = 0;
+		reader.count = 0;
+		reader.padding = 0;
+		if(InflateBlocks(reader, reinterpret_cast<unsigned char*>(data), size) == false)
+		{
+			return false;
+		}
+
+		// The big-endian Adler-32 checksum follows the last block, starting on a byte boundary.
+		ReadBits(reader, reader.count % 8);
+		unsigned int checksum = 0;
+		for(unsigned int i = 0; i < 4; ++i)
+		{
+			checksum = (checksum << 8) | ReadBits(reader, 8);
+		}
+		return HasOverrun(reader) == false && checksum == Adler32(reinterpret_cast<const unsigned char*>(data), size);
+	}
+
+
+
+	// Anonymous namespace.
+	namespace
+	{
+		/** Decompresses blocks until the final block has been decompressed.
+		@return True if exactly \a size bytes were decompressed without error.
+		*/
+		const bool InflateBlocks(BitReader& reader, unsigned char* const data, const std::size_t size)
+		{
+			HuffmanTable literals;
+			HuffmanTable distances;
+			bool fixed_tables_built = false;
+			std::size_t written = 0;
+			bool is_final = false;
+			while(is_final == false)
+			{
+				is_final = (ReadBits(reader, 1) == 1);
+				const unsigned int type = ReadBits(reader, 2);
+				if(HasOverrun(reader) == true)
+				{
+					return false;
+				}
+				bool is_valid = false;
+				switch(type)
+				{
+				case 0:
+					is_valid = InflateStored(reader, data, size, written);
+					break;
+				case 1:
+					// The fixed tables are the same for every block, so only build them once.
+					if(fixed_tables_built == false)
+					{
+						BuildFixedTables(literals, distances);
+					}
+					fixed_tables_built = true;
+					is_valid = InflateHuffman(reader, literals, distances, data, size, written);
+					break;
+				case 2:
+					fixed_tables_built = false;
+					is_valid = ReadDynamicTables(reader, literals, distances) && InflateHuffman(reader, literals, distances, data, size, written);
+					break;
+				}
+				if(is_valid == false || HasOverrun(reader) == true)
+				{
+					return false;
+				}
+			}
+			return written == size;
+		}
+
+		/** Copies an uncompressed block.
+		@param written [IN/OUT] The number of bytes decompressed so far.
+		@return False if the block is corrupt or won't fit.
+		*/
+		const bool InflateStored(BitReader& reader, unsigned char* const data, const std::size_t size, std::size_t& written)
+		{
+			// The block starts on a byte boundary, with its length and the length's complement.
+			ReadBits(reader, reader.count % 8);
+			const unsigned int length = ReadBits(reader, 16);
+			const unsigned int complement = ReadBits(reader, 16);
+			if(HasOverrun(reader) == true || (length ^ 0xFFFF) != complement || length > size - written)
+			{
+				return false;
+			}
+
+			// Take whatever is buffered first, then copy the rest straight from the input.
+			unsigned int remaining = length;
+			for(; remaining > 0 && reader.count >= reader.padding + 8; --remaining)
+			{
+				data[written++] = static_cast<unsigned char>(ReadBits(reader, 8));
+			}
+			if(remaining > 0)
+			{
+				if(reader.count > reader.padding || remaining > static_cast<std::size_t>(reader.end - reader.next))
+				{
+					return false;
+				}
+				memcpy(data + written, reader.next, remaining);
+				written += remaining;
+				reader.next += remaining;
+			}
+			return true;
+		}
+
+		/** Decompresses a Huffman-coded block.
+		@param written [IN/OUT] The number of bytes decompressed so far.
+		@return False if the block is corrupt or won't fit.
+		*/
+		const bool InflateHuffman(BitReader& reader, const HuffmanTable& literals, const HuffmanTable& distances, unsigned char* const data, const std::size_t size, std::size_t& written)
+		{
+			static const unsigned short LENGTH_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+				35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+			static const unsigned char LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+				3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+			static const unsigned short DISTANCE_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+				257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+			static const unsigned char DISTANCE_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+				7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+			while(true)
+			{
+				const int symbol = DecodeSymbol(reader, literals);
+				if(symbol < 256)
+				{
+					// A literal byte, or a code which isn't in the table.
+					if(symbol < 0 || written == size)
+					{
+						return false;
+					}
+					data[written++] = static_cast<unsigned char>(symbol);
+					continue;
+				}
+				if(symbol == END_OF_BLOCK)
+				{
+					return true;
+				}
+
+				// A match: a length, then a distance back into what's been decompressed.
+				const unsigned int length_code = symbol - 257;
+				if(length_code >= 29)
+				{
+					return false;
+				}
+				const std::size_t length = LENGTH_BASE[length_code] + ReadBits(reader, LENGTH_EXTRA[length_code]);
+				const int distance_code = DecodeSymbol(reader, distances);
+				if(distance_code < 0 || distance_code >= 30)
+				{
+					return false;
+				}
+				const std::size_t distance = DISTANCE_BASE[distance_code] + ReadBits(reader, DISTANCE_EXTRA[distance_code]);
+				if(distance > written || length > size - written)
+				{
+					return false;
+				}
+
+				unsigned char* out = data + written;
+				const unsigned char* from = out - distance;
+				if(distance == 1)
+				{
+					// A run of one byte.
+					memset(out, *from, length);
+				}
+				else if(distance >= length)
+				{
+					memcpy(out, from, length);
+				}
+				else
+				{
+					// The match overlaps itself, so it must be copied in order.
+					for(std::size_t i = 0; i < length; ++i)
+					{
+						out[i] = from[i];
+					}
+				}
+				written += length;
+
+				// A long run of corrupt codes could otherwise spin on padding forever.
+				if(HasOverrun(reader) == true)
+				{
+					return false;
+				}
+			}
+		}
+
+		/** Reads the code lengths of a dynamic block and builds its tables.
+		@return False if the code lengths are corrupt.
+		*/
+		const bool ReadDynamicTables(BitReader& reader, HuffmanTable& literals, HuffmanTable& distances)
+		{
+			static const unsigned char CODE_LENGTH_ORDER[CODE_LENGTH_SYMBOLS] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+			const unsigned int literal_count = ReadBits(reader, 5) + 257;
+			const unsigned int distance_count = ReadBits(reader, 5) + 1;
+			const unsigned int code_length_count = ReadBits(reader, 4) + 4;
+			if(literal_count > 286 || distance_count > 30)
+			{
+				return false;
+			}
+
+			// The code lengths are themselves Huffman coded.
+			unsigned char code_length_lengths[CODE_LENGTH_SYMBOLS];
+			memset(code_length_lengths, 0, sizeof(code_length_lengths));
+			for(unsigned int i = 0; i < code_length_count; ++i)
+			{
+				code_length_lengths[CODE_LENGTH_ORDER[i]] = static_cast<unsigned char>(ReadBits(reader, 3));
+			}
+			HuffmanTable code_lengths;
+			if(HasOverrun(reader) == true || BuildTable(code_lengths, code_length_lengths, CODE_LENGTH_SYMBOLS) == false)
+			{
+				return false;
+			}
+
+			// The literal/length and distance code lengths are read as one sequence, since repeats
+			// may cross from one to the other.
+			unsigned char lengths[LITERAL_LENGTH_SYMBOLS + DISTANCE_SYMBOLS];
+			const unsigned int total = literal_count + distance_count;
+			for(unsigned int i = 0; i < total; )
+			{
+				const int symbol = DecodeSymbol(reader, code_lengths);
+				unsigned int repeat = 1;
+				unsigned char length = 0;
+				if(symbol < 0)
+				{
+					return false;
+				}
+				else if(symbol < 16)
+				{
+					length = static_cast<unsigned char>(symbol);
+				}
+				else if(symbol == 16)
+				{
+					// Repeat the previous length.
+					if(i == 0)
+					{
+						return false;
+					}
+					length = lengths[i - 1];
+					repeat = 3 + ReadBits(reader, 2);
+				}
+				else if(symbol == 17)
+				{
+					repeat = 3 + ReadBits(reader, 3);
+				}
+				else
+				{
+					repeat = 11 + ReadBits(reader, 7);
+				}
+				if(repeat > total - i || HasOverrun(reader) == true)
+				{
+					return false;
+				}
+				memset(lengths + i, length, repeat);
+				i += repeat;
+			}
+
+			// Every block must be able to end.
+			if(lengths[END_OF_BLOCK] == 0)
+			{
+				return false;
+			}
+			return BuildTable(literals, lengths, literal_count) && BuildTable(distances, lengths + literal_count, distance_count);
+		}
+
+		/** Builds the canonical Huffman code with the given code lengths.
+		@param lengths The code length of each symbol, or zero if the symbol isn't used.
+		@param symbol_count The number of symbols.
+		@return False if there are more codes of some length than can exist.
+		*/
+		const bool BuildTable(HuffmanTable& table, const unsigned char* const lengths, const unsigned int symbol_count)
+		{
+			unsigned int length_counts[MAXIMUM_CODE_LENGTH + 1];
+			memset(length_counts, 0, sizeof(length_counts));
+			for(unsigned int i = 0; i < symbol_count; ++i)
+			{
+				++length_counts[lengths[i]];
+			}
+			length_counts[0] = 0;
+
+			// Assign each length its range of codes, in order of length.
+			unsigned int next_code[MAXIMUM_CODE_LENGTH + 1];
+			unsigned int code = 0;
+			unsigned int symbol_index = 0;
+			for(unsigned int length = 1; length <= MAXIMUM_CODE_LENGTH; ++length)
+			{
+				next_code[length] = code;
+				table.first_code[length] = static_cast<unsigned short>(code);
+				table.first_symbol[length] = static_cast<unsigned short>(symbol_index);
+				code += length_counts[length];
+				if(length_counts[length] != 0 && code > (1u << length))
+				{
+					return false;
+				}
+				table.end_code[length] = code << (16 - length);
+				code <<= 1;
+				symbol_index += length_counts[length];
+			}
+			table.end_code[MAXIMUM_CODE_LENGTH + 1] = 0x10000;
+
+			// Codes are stored most significant bit first, so the fast table is indexed by the
+			// reversed code, and every entry whose low bits match the code holds the symbol.
+			memset(table.fast, 0, sizeof(table.fast));
+			for(unsigned int symbol = 0; symbol < symbol_count; ++symbol)
+			{
+				const unsigned int length = lengths[symbol];
+				if(length == 0)
+				{
+					continue;
+				}
+				table.symbols[next_code[length] - table.first_code[length] + table.first_symbol[length]] = static_cast<unsigned short>(symbol);
+				if(length <= FAST_BITS)
+				{
+					const unsigned short entry = static_cast<unsigned short>((length << 9) | symbol);
+					for(unsigned int i = ReverseBits(next_code[length], length); i < (1u << FAST_BITS); i += 1u << length)
+					{
+						table.fast[i] = entry;
+					}
+				}
+				++next_code[length];
+			}
+			return true;
+		}
+
+		/** Builds the tables used by blocks with fixed Huffman codes.*/
+		void BuildFixedTables(HuffmanTable& literals, HuffmanTable& distances)
+		{
+			unsigned char lengths[LITERAL_LENGTH_SYMBOLS];
+			memset(lengths, 8, 144);
+			memset(lengths + 144, 9, 256 - 144);
+			memset(lengths + 256, 7, 280 - 256);
+			memset(lengths + 280, 8, LITERAL_LENGTH_SYMBOLS - 280);
+			BuildTable(literals, lengths, LITERAL_LENGTH_SYMBOLS);
+			memset(lengths, 5, DISTANCE_SYMBOLS);
+			BuildTable(distances, lengths, DISTANCE_SYMBOLS);
+		}
+
+		/** Tops up the bit buffer to at least 57 bits.*/
+		void Refill(BitReader& reader)
+		{
+			while(reader.count <= 56)
+			{
+				if(reader.next != reader.end)
+				{
+					reader.bits |= static_cast<unsigned long long>(*reader.next++) << reader.count;
+				}
+				else
+				{
+					reader.padding += 8;
+				}
+				reader.count += 8;
+			}
+		}
+
+		/** Reads \a count bits, which may be up to 32.*/
+		const unsigned int ReadBits(BitReader& reader, const unsigned int count)
+		{
+			if(reader.count < count)
+			{
+				Refill(reader);
+			}
+			const unsigned int value = static_cast<unsigned int>(reader.bits & ((1ull << count) - 1));
+			reader.bits >>= count;
+			reader.count -= count;
+			return value;
+		}
+
+		/** Decodes the next symbol with \a table.
+		@return The symbol, or -1 if the input isn't a valid code.
+		*/
+		const int DecodeSymbol(BitReader& reader, const HuffmanTable& table)
+		{
+			if(reader.count < 16)
+			{
+				Refill(reader);
+			}
+			const unsigned int entry = table.fast[reader.bits & ((1u << FAST_BITS) - 1)];
+			if(entry != 0)
+			{
+				const unsigned int length = entry >> 9;
+				reader.bits >>= length;
+				reader.count -= length;
+				return entry & 511;
+			}
+
+			// The code is longer than the fast table covers; find which length's range it falls in.
+			const unsigned int code = ReverseBits(static_cast<unsigned int>(reader.bits & 0xFFFF), 16);
+			unsigned int length = FAST_BITS + 1;
+			while(code >= table.end_code[length])
+			{
+				++length;
+			}
+			if(length > MAXIMUM_CODE_LENGTH)
+			{
+				return -1;
+			}
+			const unsigned int index = (code >> (16 - length)) - table.first_code[length] + table.first_symbol[length];
+			if(index >= LITERAL_LENGTH_SYMBOLS)
+			{
+				return -1;
+			}
+			reader.bits >>= length;
+			reader.count -= length;
+			return table.symbols[index];
+		}
+
+		/** Checks whether more bits have been read than the data holds.*/
+		const bool HasOverrun(const BitReader& reader)
+		{
+			return reader.padding > reader.count;
+		}
+
+		/** Reverses the order of the low \a count bits of \a bits.*/
+		const unsigned int ReverseBits(unsigned int bits, const unsigned int count)
+		{
+			bits = ((bits & 0xAAAA) >> 1) | ((bits & 0x5555) << 1);
+			bits = ((bits & 0xCCCC) >> 2) | ((bits & 0x3333) << 2);
+			bits = ((bits & 0xF0F0) >> 4) | ((bits & 0x0F0F) << 4);
+			bits = ((bits & 0xFF00) >> 8) | ((bits & 0x00FF) << 8);
+			return bits >> (16 - count);
+		}
+
+		/** Computes the Adler-32 checksum of \a size bytes of \a data.*/
+		const unsigned int Adler32(const unsigned char* data, std::size_t size)
+		{
+			// 5552 is the most bytes which can be summed before the sums must be reduced to
+			// avoid overflowing 32 bits.
+			unsigned int a = 1;
+			unsigned int b = 0;
+			while(size > 0)
+			{
+				const std::size_t block = (size < 5552) ? size : 5552;
+				for(std::size_t i = 0; i < block; ++i)
+				{
+					a += data[i];
+					b += a;
+				}
+				a %= 65521;
+				b %= 65521;
+				data += block;
+				size -= block;
+			}
+			return (b << 16) | a;
+		}
+	}
+
+
+
+} // utility
+} // avl
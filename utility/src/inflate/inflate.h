@@ -0,0 +1,65 @@
+#pragma once
+#ifndef AVL_UTILITY_INFLATE__
+#define AVL_UTILITY_INFLATE__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Provides a decompressor for DEFLATE data (RFC 1951), both raw and wrapped in a zlib stream
+(RFC 1950), as used by PNG images.
+@par Decoding:
+Huffman codes are decoded with a lookup table indexed by the next 10 bits of input, which
+resolves almost every code in a single step; the rare longer codes fall back to a search of
+the canonical code ranges.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include<cstddef>
+
+
+namespace avl
+{
+namespace utility
+{
+	/** Decompresses raw DEFLATE data. Corrupt input is detected rather than allowed to read
+	or write out of bounds.
+	@param compressed The compressed data.
+	@param compressed_size The size of \a compressed in bytes.
+	@param data [OUT] Receives the decompressed data.
+	@param size The size of the decompressed data in bytes. Must be exact.
+	@return True if \a compressed decompressed to exactly \a size bytes, and false if
+	it's corrupt.
+	*/
+	const bool Inflate(const char* const compressed, const std::size_t compressed_size, char* const data, const std::size_t size);
+
+	/** Decompresses a zlib stream: DEFLATE data with a two-byte header and an Adler-32
+	checksum of the decompressed data. Streams which need a preset dictionary aren't supported.
+	@param compressed The zlib stream.
+	@param compressed_size The size of \a compressed in bytes.
+	@param data [OUT] Receives the decompressed data.
+	@param size The size of the decompressed data in bytes. Must be exact.
+	@return True if \a compressed decompressed to exactly \a size bytes with a matching
+	checksum, and false if it's corrupt or unsupported.
+	*/
+	const bool InflateZlib(const char* const compressed, const std::size_t compressed_size, char* const data, const std::size_t size);
+
+
+
+} // utility
+} // avl
+#endif // AVL_UTILITY_INFLATE__
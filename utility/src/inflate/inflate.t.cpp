@@ -0,0 +1,98 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the inflate component. See "inflate.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"inflate.h"
+#include<iostream>
+#include<vector>
+#include<string>
+#include<cstdlib>
+
+
+
+namespace
+{
+	/// The license notice, compressed with dynamic Huffman codes (642 bytes).
+	const unsigned char DYNAMIC_STREAM[] = {
+		0x78, 0xDA, 0x8D, 0x91, 0x4F, 0x4B, 0xC3, 0x40, 0x10, 0xC5, 0xEF, 0xFB, 0x29, 0xDE, 0x51, 0xA1,
+		0x24, 0x07, 0x6F, 0x55, 0x84, 0x28, 0xAD, 0x06, 0x6A, 0x5B, 0x92, 0x14, 0xE9, 0x71, 0x93, 0x4C,
+		0x9A, 0x85, 0xED, 0x6E, 0xD8, 0xDD, 0x24, 0xE4, 0xDB, 0x3B, 0x4D, 0x15, 0x05, 0x41, 0x3C, 0xCE,
+		0xBF, 0x37, 0xBF, 0x37, 0x53, 0xB4, 0x04, 0x39, 0x68, 0x6C, 0x54, 0xE9, 0xA4, 0x9B, 0xA0, 0x3C,
+		0x1A, 0x47, 0x04, 0x6F, 0x9B, 0x30, 0x4A, 0x47, 0x4B, 0x4C, 0xB6, 0x47, 0x25, 0x0D, 0x1C, 0xD5,
+		0xCA, 0x07, 0xA7, 0xCA, 0x3E, 0x10, 0x54, 0x80, 0x34, 0x75, 0x6C, 0x1D, 0xCE, 0xB6, 0x56, 0xCD,
+		0x24, 0x38, 0xD1, 0x9B, 0x9A, 0x1C, 0x02, 0x0B, 0x06, 0x72, 0x67, 0x0F, 0xDB, 0xCC, 0xC1, 0xCB,
+		0xF6, 0x80, 0x0D, 0x79, 0xCF, 0xB5, 0x17, 0x32, 0xE4, 0xA4, 0xC6, 0xBE, 0x2F, 0xB5, 0xAA, 0x78,
+		0x67, 0x45, 0xC6, 0xF3, 0x7E, 0x8F, 0xEE, 0x92, 0xF1, 0x2D, 0xD5, 0xA2, 0x9C, 0xE6, 0xA9, 0xF5,
+		0x05, 0x22, 0xFF, 0x84, 0xC0, 0xDA, 0xB2, 0xB8, 0x0C, 0xCA, 0x9A, 0x05, 0x48, 0x71, 0xDD, 0x61,
+		0x20, 0xE7, 0x39, 0xC6, 0xDD, 0xD7, 0x9E, 0x4F, 0xB5, 0x05, 0xAC, 0x13, 0x37, 0x32, 0x5C, 0xB8,
+		0x1D, 0x6C, 0x77, 0x19, 0xBA, 0x65, 0xD8, 0x09, 0x5A, 0x86, 0xEF, 0xB9, 0x48, 0x88, 0xE2, 0xB7,
+		0xF5, 0x6F, 0x87, 0x35, 0x94, 0x99, 0x65, 0x5B, 0xDB, 0xB1, 0xA1, 0x96, 0x05, 0xD9, 0xE2, 0xA8,
+		0xB4, 0x46, 0x49, 0xE8, 0x3D, 0x35, 0xBD, 0x5E, 0x80, 0x3B, 0xC5, 0x7B, 0x5A, 0xBC, 0xEE, 0x0E,
+		0x05, 0x92, 0xED, 0x11, 0xEF, 0x49, 0x96, 0x25, 0xDB, 0xE2, 0x78, 0xCF, 0x9D, 0xA1, 0xB5, 0x7D,
+		0x00, 0x0D, 0x74, 0xD5, 0x51, 0xE7, 0x4E, 0x2B, 0x96, 0x65, 0x3F, 0x4E, 0x9A, 0x30, 0x31, 0xB6,
+		0x78, 0x5B, 0x65, 0xCF, 0xAF, 0xDC, 0x9F, 0x3C, 0xA5, 0x9B, 0xB4, 0x38, 0x32, 0x39, 0xD6, 0x69,
+		0xB1, 0x5D, 0xE5, 0x39, 0xD6, 0xBB, 0x0C, 0x09, 0xF6, 0x49, 0x56, 0xA4, 0xCF, 0x87, 0x4D, 0x92,
+		0x61, 0x7F, 0xC8, 0xF6, 0xBB, 0x7C, 0x15, 0x01, 0x39, 0xD1, 0xD7, 0x61, 0xC5, 0xDF, 0x87, 0x6D,
+		0xE6, 0xFF, 0xF0, 0xFD, 0x6A, 0x0A, 0x52, 0x69, 0xCF, 0xA6, 0x8F, 0xFC, 0x4D, 0xCF, 0x64, 0xBA,
+		0x46, 0x2B, 0x07, 0xE2, 0xAF, 0x56, 0xA4, 0x06, 0xE6, 0x92, 0xA8, 0x6C, 0x37, 0xFD, 0xFB, 0x69,
+		0x42, 0x6A, 0x6B, 0x4E, 0xB3, 0xCD, 0x79, 0xE0, 0xC7, 0x21, 0x19, 0x31, 0x6D, 0x60, 0x6C, 0x58,
+		0xC0, 0x33, 0xEA, 0x43, 0x1B, 0x42, 0xB7, 0x8C, 0xE3, 0x71, 0x1C, 0xA3, 0x93, 0xE9, 0x23, 0xEB,
+		0x4E, 0xB1, 0xBE, 0x8A, 0xF8, 0xF8, 0x31, 0x12, 0x1F, 0xC1, 0x15, 0xDC, 0x71};
+	/// "Inflate() decodes DEFLATE streams. " repeated 8 times, compressed with fixed Huffman codes (280 bytes).
+	const unsigned char FIXED_STREAM[] = {
+		0x78, 0x01, 0xF3, 0xCC, 0x4B, 0xCB, 0x49, 0x2C, 0x49, 0xD5, 0xD0, 0x54, 0x48, 0x49, 0x4D, 0xCE,
+		0x4F, 0x49, 0x2D, 0x56, 0x70, 0x71, 0x75, 0xF3, 0x71, 0x0C, 0x71, 0x55, 0x28, 0x2E, 0x29, 0x4A,
+		0x4D, 0xCC, 0x2D, 0xD6, 0x53, 0xF0, 0x1C, 0x89, 0x4A, 0x00, 0xD8, 0xE2, 0x5C, 0x69};
+	/// "Stored blocks are copied as they are." in a stored block (37 bytes).
+	const unsigned char STORED_STREAM[] = {
+		0x78, 0x01, 0x01, 0x25, 0x00, 0xDA, 0xFF, 0x53, 0x74, 0x6F, 0x72, 0x65, 0x64, 0x20, 0x62, 0x6C,
+		0x6F, 0x63, 0x6B, 0x73, 0x20, 0x61, 0x72, 0x65, 0x20, 0x63, 0x6F, 0x70, 0x69, 0x65, 0x64, 0x20,
+		0x61, 0x73, 0x20, 0x74, 0x68, 0x65, 0x79, 0x20, 0x61, 0x72, 0x65, 0x2E, 0x03, 0x31, 0x0D, 0x50};
+
+	/** Decompresses a zlib stream and reports whether it matched its checksum.*/
+	void Decompress(const std::string& name, const unsigned char* const stream, const std::size_t stream_size, const std::size_t size)
+	{
+		std::vector<char> data(size);
+		const bool ok = avl::utility::InflateZlib(reinterpret_cast<const char*>(stream), stream_size, &data[0], size);
+		std::cout << name << ": " << stream_size << " -> " << size << " bytes, " << (ok ? "passed" : "FAILED") << '\n';
+	}
+}
+
+
+
+void TestInflateComponent()
+{
+	Decompress("Dynamic Huffman codes", DYNAMIC_STREAM, sizeof(DYNAMIC_STREAM), 642);
+	Decompress("Fixed Huffman codes", FIXED_STREAM, sizeof(FIXED_STREAM), 280);
+	Decompress("Stored block", STORED_STREAM, sizeof(STORED_STREAM), 37);
+
+	// Corrupt data must be rejected rather than overrun the output.
+	std::vector<char> data(642);
+	const char* const stream = reinterpret_cast<const char*>(DYNAMIC_STREAM);
+	std::cout << "Truncated data rejected: " << (avl::utility::InflateZlib(stream, sizeof(DYNAMIC_STREAM) / 2, &data[0], data.size()) == false) << '\n';
+	std::vector<char> corrupt(stream, stream + sizeof(DYNAMIC_STREAM));
+	corrupt[100] ^= 0x10;
+	std::cout << "Corrupt data rejected: " << (avl::utility::InflateZlib(&corrupt[0], corrupt.size(), &data[0], data.size()) == false) << '\n';
+	std::cout << "Wrong size rejected: " << (avl::utility::InflateZlib(stream, sizeof(DYNAMIC_STREAM), &data[0], data.size() - 1) == false) << '\n';
+
+	system("pause");
+}
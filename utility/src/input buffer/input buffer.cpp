@@ -0,0 +1,240 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the input buffer component. See "input buffer.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"input buffer.h"
+#include"..\exceptions\exceptions.h"
+#include"..\assert\assert.h"
+#include<new>
+
+
+namespace avl
+{
+namespace utility
+{
+namespace input_events
+{
+
+	// See function declaration for details.
+	const PackedInputEvent PackKeyboardEvent(const key_codes::KeyboardKey::KeyboardKeyCodes key, const bool is_pressed, const unsigned int timestamp)
+	{
+		PackedInputEvent event;
+		event.type = KeyboardEvent::KEYBOARD_TYPE;
+		event.key.code = static_cast<unsigned short>(key);
+		event.key.is_pressed = is_pressed;
+		event.timestamp = timestamp;
+		return event;
+	}
+
+	// See function declaration for details.
+	const PackedInputEvent PackMouseButtonEvent(const key_codes::MouseButton::MouseButtonCodes button, const bool is_pressed, const unsigned int timestamp)
+	{
+		PackedInputEvent event;
+		event.type = MouseButtonEvent::MOUSE_BUTTON_TYPE;
+		event.key.code = static_cast<unsigned short>(button);
+		event.key.is_pressed = is_pressed;
+		event.timestamp = timestamp;
+		return event;
+	}
+
+	// See function declaration for details.
+	const PackedInputEvent PackMouseMoveEvent(const short delta_x, const short delta_y, const unsigned int timestamp)
+	{
+		PackedInputEvent event;
+		event.type = MouseMoveEvent::MOUSE_MOVE_TYPE;
+		event.move.delta_x = delta_x;
+		event.move.delta_y = delta_y;
+		event.timestamp = timestamp;
+		return event;
+	}
+
+	// See function declaration for details.
+	const PackedInputEvent PackMouseScrollEvent(const short delta, const unsigned int timestamp)
+	{
+		PackedInputEvent event;
+		event.type = MouseScrollEvent::MOUSE_SCROLL_TYPE;
+		event.scroll.delta = delta;
+		event.timestamp = timestamp;
+		return event;
+	}
+
+	// See function declaration for details.
+	InputEvent* const UnpackInputEvent(const PackedInputEvent& event)
+	{
+		InputEvent* unpacked = nullptr;
+		if(event.type == KeyboardEvent::KEYBOARD_TYPE)
+		{
+			unpacked = new(std::nothrow) KeyboardEvent(static_cast<key_codes::KeyboardKey::KeyboardKeyCodes>(event.key.code), event.key.is_pressed);
+		}
+		else if(event.type == MouseButtonEvent::MOUSE_BUTTON_TYPE)
+		{
+			unpacked = new(std::nothrow) MouseButtonEvent(static_cast<key_codes::MouseButton::MouseButtonCodes>(event.key.code), event.key.is_pressed);
+		}
+		else if(event.type == MouseMoveEvent::MOUSE_MOVE_TYPE)
+		{
+			unpacked = new(std::nothrow) MouseMoveEvent(event.move.delta_x, event.move.delta_y);
+		}
+		else if(event.type == MouseScrollEvent::MOUSE_SCROLL_TYPE)
+		{
+			unpacked = new(std::nothrow) MouseScrollEvent(event.scroll.delta);
+		}
+		else
+		{
+			throw InvalidArgumentException("avl::utility::input_events::UnpackInputEvent()", "event", "Must have a known type.");
+		}
+		if(unpacked == nullptr)
+		{
+			throw OutOfMemoryError();
+		}
+		return unpacked;
+	}
+
+
+
+	// See method declaration for details.
+	InputBuffer::InputBuffer(const std::size_t capacity)
+		: first(0), size(0), dropped_count(0)
+	{
+		if(capacity == 0)
+		{
+			throw InvalidArgumentException("avl::utility::input_events::InputBuffer::InputBuffer()", "capacity", "Must be greater than zero.");
+		}
+		try
+		{
+			events.resize(capacity);
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw OutOfMemoryError();
+		}
+	}
+
+	// See method declaration for details.
+	InputBuffer::~InputBuffer()
+	{
+	}
+
+	// See method declaration for details.
+	const bool InputBuffer::Push(const PackedInputEvent& event)
+	{
+		if(size == events.size())
+		{
+			++dropped_count;
+			return false;
+		}
+		std::size_t last = first + size;
+		if(last >= events.size())
+		{
+			last -= events.size();
+		}
+		events[last] = event;
+		++size;
+		return true;
+	}
+
+	// See method declaration for details.
+	const PackedInputEvent& InputBuffer::Front() const
+	{
+		if(size == 0)
+		{
+			throw InvalidCallException("avl::utility::input_events::InputBuffer::Front()", "The buffer is empty.");
+		}
+		return events[first];
+	}
+
+	// See method declaration for details.
+	void InputBuffer::Pop()
+	{
+		if(size == 0)
+		{
+			throw InvalidCallException("avl::utility::input_events::InputBuffer::Pop()", "The buffer is empty.");
+		}
+		if(++first == events.size())
+		{
+			first = 0;
+		}
+		--size;
+	}
+
+	// See method declaration for details.
+	const PackedInputEvent& InputBuffer::operator[](const std::size_t index) const
+	{
+		ASSERT(index < size);
+		std::size_t position = first + index;
+		if(position >= events.size())
+		{
+			position -= events.size();
+		}
+		return events[position];
+	}
+
+	// See method declaration for details.
+	void InputBuffer::Clear()
+	{
+		first = 0;
+		size = 0;
+	}
+
+	// See method declaration for details.
+	const bool InputBuffer::IsEmpty() const
+	{
+		return size == 0;
+	}
+
+	// See method declaration for details.
+	const std::size_t InputBuffer::GetSize() const
+	{
+		return size;
+	}
+
+	// See method declaration for details.
+	const std::size_t InputBuffer::GetCapacity() const
+	{
+		return events.size();
+	}
+
+	// See method declaration for details.
+	const unsigned int InputBuffer::GetDroppedCount() const
+	{
+		return dropped_count;
+	}
+
+
+
+	// See function declaration for details.
+	InputQueue ToInputQueue(InputBuffer& buffer)
+	{
+		InputQueue queue;
+		while(buffer.IsEmpty() == false)
+		{
+			// The queue takes ownership, and deletes the event if it can't hold it.
+			queue.push(UnpackInputEvent(buffer.Front()));
+			buffer.Pop();
+		}
+		return queue;
+	}
+
+
+
+} // input_events
+} // utility
+} // avl
@@ -0,0 +1,228 @@
+#pragma once
+#ifndef AVL_UTILITY_INPUT_BUFFER__
+#define AVL_UTILITY_INPUT_BUFFER__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Defines the \ref avl::utility::input_events::PackedInputEvent struct, which holds any
+input event by value, and the \ref avl::utility::input_events::InputBuffer ring which
+input devices fill with them and scenes consume them from.
+@par Allocation:
+The buffer allocates its storage once, when it's constructed; filling and consuming it
+never allocates. The \ref avl::utility::input_events::InputEvent classes are still
+available through \ref avl::utility::input_events::UnpackInputEvent() and
+\ref avl::utility::input_events::ToInputQueue(), which allocate an object per event as
+before.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"..\input events\input events.h"
+#include"..\key codes\key codes.h"
+#include<vector>
+#include<cstddef>
+
+
+namespace avl
+{
+namespace utility
+{
+namespace input_events
+{
+
+	/**
+	A single input event, tagged with its type. Which member of the union holds the event
+	depends upon \ref type, which is one of the type constants of the \ref InputEvent
+	classes.
+	*/
+	struct PackedInputEvent
+	{
+		/// Which kind of event this is; e.g. \ref KeyboardEvent::KEYBOARD_TYPE.
+		unsigned char type;
+		union
+		{
+			/// For \ref KeyboardEvent::KEYBOARD_TYPE and \ref MouseButtonEvent::MOUSE_BUTTON_TYPE.
+			struct
+			{
+				/// The key or mouse button code.
+				unsigned short code;
+				/// Whether the key or button was pressed, rather than released.
+				bool is_pressed;
+			} key;
+			/// For \ref MouseMoveEvent::MOUSE_MOVE_TYPE.
+			struct
+			{
+				/// The movement along the horizontal axis.
+				short delta_x;
+				/// The movement along the vertical axis.
+				short delta_y;
+			} move;
+			/// For \ref MouseScrollEvent::MOUSE_SCROLL_TYPE.
+			struct
+			{
+				/// The direction and amount in which the mouse wheel was scrolled.
+				short delta;
+			} scroll;
+		};
+		/// When the event happened, in milliseconds, as reported by the device.
+		unsigned int timestamp;
+	};
+
+
+	/** Packs a keyboard event.
+	@param key The key which was pressed or released.
+	@param is_pressed True if \a key was pressed, and false if it was released.
+	@param timestamp When the event happened, in milliseconds.
+	@return The event.
+	*/
+	const PackedInputEvent PackKeyboardEvent(const key_codes::KeyboardKey::KeyboardKeyCodes key, const bool is_pressed, const unsigned int timestamp);
+
+	/** Packs a mouse button event.
+	@param button The button which was pressed or released.
+	@param is_pressed True if \a button was pressed, and false if it was released.
+	@param timestamp When the event happened, in milliseconds.
+	@return The event.
+	*/
+	const PackedInputEvent PackMouseButtonEvent(const key_codes::MouseButton::MouseButtonCodes button, const bool is_pressed, const unsigned int timestamp);
+
+	/** Packs a mouse movement event.
+	@param delta_x The movement along the horizontal axis.
+	@param delta_y The movement along the vertical axis.
+	@param timestamp When the event happened, in milliseconds.
+	@return The event.
+	*/
+	const PackedInputEvent PackMouseMoveEvent(const short delta_x, const short delta_y, const unsigned int timestamp);
+
+	/** Packs a mouse wheel event.
+	@param delta The direction and amount in which the mouse wheel was scrolled.
+	@param timestamp When the event happened, in milliseconds.
+	@return The event.
+	*/
+	const PackedInputEvent PackMouseScrollEvent(const short delta, const unsigned int timestamp);
+
+	/** Creates the \ref InputEvent object equivalent to a packed event, for code written
+	against the \ref InputEvent classes.
+	@param event The event.
+	@return The new object. The caller takes ownership of it.
+	@throws InvalidArgumentException If \a event has an unknown type.
+	@throws OutOfMemoryError If unable to allocate the object.
+	*/
+	InputEvent* const UnpackInputEvent(const PackedInputEvent& event);
+
+
+
+	/**
+	A fixed-capacity ring of \ref PackedInputEvent objects. Input devices push events onto
+	the back, and scenes read them in place, from the front, popping those which they've
+	handled. Once the buffer is full, further events are dropped and counted, rather than
+	the buffer growing.
+	*/
+	class InputBuffer
+	{
+	public:
+		/// The default capacity: many times the events a device sees in a frame.
+		static const std::size_t DEFAULT_CAPACITY = 256;
+
+		/** Creates an empty buffer.
+		@param capacity The number of events which the buffer can hold.
+		@throws InvalidArgumentException If \a capacity is 0.
+		@throws OutOfMemoryError If unable to allocate the buffer's storage.
+		*/
+		InputBuffer(const std::size_t capacity = DEFAULT_CAPACITY);
+		/** Basic destructor.*/
+		~InputBuffer();
+
+		/** Copies \a event onto the back of the buffer, if there's room for it.
+		@param event The event.
+		@return True if \a event was pushed, and false if the buffer is full and it was
+		dropped.
+		*/
+		const bool Push(const PackedInputEvent& event);
+
+		/** Accesses the event at the front of the buffer.
+		@return The oldest event.
+		@throws InvalidCallException If the buffer is empty.
+		*/
+		const PackedInputEvent& Front() const;
+
+		/** Removes the event at the front of the buffer.
+		@throws InvalidCallException If the buffer is empty.
+		*/
+		void Pop();
+
+		/** Accesses an event in place, counting from the front of the buffer.
+		@param index The index of the event. Must be less than \ref GetSize().
+		@return The event.
+		*/
+		const PackedInputEvent& operator[](const std::size_t index) const;
+
+		/** Removes every event.
+		*/
+		void Clear();
+
+		/** Tells whether the buffer holds any events.
+		@return True if the buffer is empty.
+		*/
+		const bool IsEmpty() const;
+
+		/** Counts the events in the buffer.
+		@return The number of events.
+		*/
+		const std::size_t GetSize() const;
+
+		/** Accesses the number of events which the buffer can hold.
+		@return The capacity.
+		*/
+		const std::size_t GetCapacity() const;
+
+		/** Counts the events which were dropped because the buffer was full.
+		@return The number of events dropped since the buffer was created.
+		*/
+		const unsigned int GetDroppedCount() const;
+
+	private:
+		/// The ring of events.
+		std::vector<PackedInputEvent> events;
+		/// The index in \ref events of the front of the buffer.
+		std::size_t first;
+		/// The number of events in the buffer.
+		std::size_t size;
+		/// The number of events dropped because the buffer was full.
+		unsigned int dropped_count;
+
+		/// NOT IMPLEMENTED.
+		InputBuffer(const InputBuffer&);
+		/// NOT IMPLEMENTED.
+		InputBuffer& operator=(const InputBuffer&);
+	};
+
+
+	/** Moves every event in \a buffer into a new \ref InputQueue, as \ref InputEvent
+	objects, for code written against those classes.
+	@param buffer [IN/OUT] The buffer, which is left empty.
+	@return The queue.
+	@throws OutOfMemoryError If unable to allocate the objects.
+	*/
+	InputQueue ToInputQueue(InputBuffer& buffer);
+
+
+
+} // input_events
+} // utility
+} // avl
+#endif // AVL_UTILITY_INPUT_BUFFER__
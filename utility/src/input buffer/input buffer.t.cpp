@@ -0,0 +1,156 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the input buffer component. See "input buffer.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"input buffer.h"
+#include"..\input events\input events.h"
+#include"..\key codes\key codes.h"
+#include"..\exceptions\exceptions.h"
+#include"..\assert\assert.h"
+#include"..\timer\timer.h"
+#include<iostream>
+#include<cstdlib>
+
+
+
+void TestInputBufferComponent()
+{
+	using namespace avl::utility::input_events;
+	using avl::utility::key_codes::KeyboardKey;
+	using avl::utility::key_codes::MouseButton;
+	using avl::utility::Timer;
+
+	// Events come out in the order they went in, across the end of the ring, and those
+	// which don't fit are dropped and counted.
+	{
+		InputBuffer buffer(5);
+		ASSERT(buffer.IsEmpty() == true && buffer.GetCapacity() == 5);
+		short next_in = 0;
+		short next_out = 0;
+		for(unsigned int round = 0; round < 7; ++round)
+		{
+			for(unsigned int i = 0; i < 3; ++i)
+			{
+				ASSERT(buffer.Push(PackMouseScrollEvent(next_in, next_in * 10)) == true);
+				++next_in;
+			}
+			ASSERT(buffer.GetSize() == 3);
+			for(std::size_t i = 0; i < buffer.GetSize(); ++i)
+			{
+				ASSERT(buffer[i].scroll.delta == next_out + static_cast<short>(i));
+			}
+			while(buffer.IsEmpty() == false)
+			{
+				ASSERT(buffer.Front().type == MouseScrollEvent::MOUSE_SCROLL_TYPE);
+				ASSERT(buffer.Front().scroll.delta == next_out && buffer.Front().timestamp == static_cast<unsigned int>(next_out * 10));
+				buffer.Pop();
+				++next_out;
+			}
+		}
+		for(unsigned int i = 0; i < 5; ++i)
+		{
+			ASSERT(buffer.Push(PackMouseMoveEvent(1, 2, 0)) == true);
+		}
+		ASSERT(buffer.Push(PackMouseMoveEvent(1, 2, 0)) == false);
+		ASSERT(buffer.GetSize() == 5 && buffer.GetDroppedCount() == 1);
+		buffer.Clear();
+		ASSERT(buffer.IsEmpty() == true);
+		unsigned int refused_count = 0;
+		try { buffer.Front(); } catch(const avl::utility::InvalidCallException&) { ++refused_count; }
+		try { buffer.Pop(); } catch(const avl::utility::InvalidCallException&) { ++refused_count; }
+		try { InputBuffer empty(0); } catch(const avl::utility::InvalidArgumentException&) { ++refused_count; }
+		ASSERT(refused_count == 3);
+		std::cout << "Events are buffered in order.\n";
+	}
+
+	// Packed events unpack to the equivalent event objects.
+	{
+		InputBuffer buffer;
+		buffer.Push(PackKeyboardEvent(KeyboardKey::kk_a, true, 1));
+		buffer.Push(PackMouseButtonEvent(MouseButton::mb_right, false, 2));
+		buffer.Push(PackMouseMoveEvent(-3, 7, 3));
+		buffer.Push(PackMouseScrollEvent(-120, 4));
+		InputQueue queue = ToInputQueue(buffer);
+		ASSERT(buffer.IsEmpty() == true);
+		const KeyboardEvent& key = static_cast<const KeyboardEvent&>(queue.front());
+		ASSERT(key.GetType() == KeyboardEvent::KEYBOARD_TYPE && key.GetKey() == KeyboardKey::kk_a && key.IsPressed() == true);
+		queue.pop();
+		const MouseButtonEvent& button = static_cast<const MouseButtonEvent&>(queue.front());
+		ASSERT(button.GetType() == MouseButtonEvent::MOUSE_BUTTON_TYPE && button.GetButton() == MouseButton::mb_right && button.IsPressed() == false);
+		queue.pop();
+		const MouseMoveEvent& move = static_cast<const MouseMoveEvent&>(queue.front());
+		ASSERT(move.GetType() == MouseMoveEvent::MOUSE_MOVE_TYPE && move.GetDeltaX() == -3 && move.GetDeltaY() == 7);
+		queue.pop();
+		const MouseScrollEvent& scroll = static_cast<const MouseScrollEvent&>(queue.front());
+		ASSERT(scroll.GetType() == MouseScrollEvent::MOUSE_SCROLL_TYPE && scroll.GetDelta() == -120);
+		queue.pop();
+		ASSERT(queue.empty() == true);
+
+		PackedInputEvent unknown = PackMouseScrollEvent(0, 0);
+		unknown.type = 0;
+		unsigned int refused_count = 0;
+		try { UnpackInputEvent(unknown); } catch(const avl::utility::InvalidArgumentException&) { ++refused_count; }
+		ASSERT(refused_count == 1);
+		std::cout << "Packed events unpack to event objects.\n";
+	}
+
+	// The cost of a busy frame of mouse movement, buffered versus queued as objects.
+	{
+		const unsigned int event_count = 200;
+		const unsigned int frame_count = 1000;
+		InputBuffer buffer;
+		long total_buffered = 0;
+		long total_queued = 0;
+		Timer timer;
+		for(unsigned int frame = 0; frame < frame_count; ++frame)
+		{
+			for(unsigned int i = 0; i < event_count; ++i)
+			{
+				buffer.Push(PackMouseMoveEvent(static_cast<short>(i), 1, i));
+			}
+			for(; buffer.IsEmpty() == false; buffer.Pop())
+			{
+				total_buffered += buffer.Front().move.delta_x;
+			}
+		}
+		const double buffered_time = timer.Reset();
+		for(unsigned int frame = 0; frame < frame_count; ++frame)
+		{
+			InputQueue queue;
+			for(unsigned int i = 0; i < event_count; ++i)
+			{
+				queue.push(new MouseMoveEvent(static_cast<short>(i), 1));
+			}
+			for(; queue.empty() == false; queue.pop())
+			{
+				total_queued += static_cast<const MouseMoveEvent&>(queue.front()).GetDeltaX();
+			}
+		}
+		const double queued_time = timer.Elapsed();
+		ASSERT(total_buffered == total_queued);
+		std::cout << "Microseconds per frame of " << event_count << " mouse events:\n"
+			<< "  buffered " << buffered_time * 1000000.0 / frame_count << "\n"
+			<< "  queued   " << queued_time * 1000000.0 / frame_count << "\n";
+	}
+
+	system("pause");
+}
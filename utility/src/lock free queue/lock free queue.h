@@ -0,0 +1,250 @@
+#pragma once
+#ifndef AVL_UTILITY_LOCK_FREE_QUEUE__
+#define AVL_UTILITY_LOCK_FREE_QUEUE__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Defines the LockFreeQueue generic container class.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"..\exceptions\exceptions.h"
+#include<cstddef>
+#include<new>
+#include<Windows.h>
+
+
+namespace avl
+{
+namespace utility
+{
+
+	/**
+	A bounded, fixed-capacity queue which may be pushed to and popped from
+	by any number of threads at once without taking a lock. Each slot carries
+	a sequence number which tells producers and consumers whether it is free
+	to be written or ready to be read, so the only contended operation is a
+	single compare-and-swap on the queue position.
+	@attention \a Type must be default-constructible and copy-assignable. Objects
+	are copied into and out of the queue, so keep them small and flat.
+	@note Relies upon the Microsoft semantics for volatile accesses (reads have
+	acquire semantics and writes have release semantics).
+	*/
+	template<class Type>
+	class LockFreeQueue
+	{
+	public:
+		/** Creates an empty queue.
+		@param minimum_capacity The minimum number of objects which the queue
+		must be able to hold. The actual capacity is rounded up to the next
+		power of two.
+		@throws OutOfMemoryError If unable to allocate the queue's storage.
+		@throws InvalidArgumentException If \a minimum_capacity is zero.
+		*/
+		LockFreeQueue(const std::size_t minimum_capacity);
+		/** Basic destructor.*/
+		~LockFreeQueue();
+
+		/** Attempts to push a copy of \a object onto the back of the queue.
+		@param object The object to be copied into the queue.
+		@return True if \a object was pushed, and false if the queue is full.
+		*/
+		const bool TryPush(const Type& object);
+
+		/** Attempts to pop the object at the front of the queue.
+		@param object [OUT] Receives the popped object.
+		@return True if an object was popped into \a object, and false if the
+		queue is empty.
+		*/
+		const bool TryPop(Type& object);
+
+		/** Returns the number of objects which the queue can hold.
+		@return The capacity of the queue.
+		*/
+		const std::size_t GetCapacity() const;
+
+	private:
+		/** A single slot in the queue.*/
+		struct Cell
+		{
+			/// Equal to the slot's position when it's free for a producer, and
+			/// one greater than the slot's position when it's ready for a consumer.
+			volatile LONG sequence;
+			/// The stored object.
+			Type object;
+		};
+
+		/** Computes the signed distance from \a position to \a sequence, accounting for
+		wraparound of the position counters.
+		*/
+		static const LONG Distance(const LONG sequence, const LONG position);
+
+		/** Rounds \a minimum up to the next power of two.*/
+		static const std::size_t RoundUpToPowerOfTwo(const std::size_t minimum);
+
+		/// The queue's storage.
+		Cell* const cells;
+		/// One less than the capacity of the queue; used to wrap positions to slots.
+		const LONG mask;
+		/// Keeps the producer and consumer positions on separate cache lines.
+		char padding_front[64];
+		/// The position of the next slot to be pushed to.
+		volatile LONG enqueue_position;
+		/// Keeps the producer and consumer positions on separate cache lines.
+		char padding_middle[64];
+		/// The position of the next slot to be popped from.
+		volatile LONG dequeue_position;
+
+		/// NOT IMPLEMENTED.
+		LockFreeQueue(const LockFreeQueue&);
+		/// NOT IMPLEMENTED.
+		LockFreeQueue& operator=(const LockFreeQueue&);
+	};
+
+
+	// See method declaration for details.
+	template<class Type>
+	LockFreeQueue<Type>::LockFreeQueue(const std::size_t minimum_capacity)
+		: cells(new(std::nothrow) Cell[RoundUpToPowerOfTwo(minimum_capacity)]), mask(static_cast<LONG>(RoundUpToPowerOfTwo(minimum_capacity) - 1)), enqueue_position(0), dequeue_position(0)
+	{
+		if(minimum_capacity == 0)
+		{
+			delete[] cells;
+			throw InvalidArgumentException("avl::utility::LockFreeQueue::LockFreeQueue()", "minimum_capacity", "Must be greater than zero.");
+		}
+		if(cells == nullptr)
+		{
+			throw OutOfMemoryError();
+		}
+		// Each slot starts out free for the producer whose position matches it.
+		for(LONG i = 0; i <= mask; ++i)
+		{
+			cells[i].sequence = i;
+		}
+	}
+
+	// See method declaration for details.
+	template<class Type>
+	LockFreeQueue<Type>::~LockFreeQueue()
+	{
+		delete[] cells;
+	}
+
+	// See method declaration for details.
+	template<class Type>
+	const bool LockFreeQueue<Type>::TryPush(const Type& object)
+	{
+		Cell* cell = nullptr;
+		LONG position = enqueue_position;
+		while(true)
+		{
+			cell = &cells[position & mask];
+			const LONG distance = Distance(cell->sequence, position);
+			// The slot is free; try to claim it.
+			if(distance == 0)
+			{
+				if(InterlockedCompareExchange(&enqueue_position, position + 1, position) == position)
+				{
+					break;
+				}
+				position = enqueue_position;
+			}
+			// The slot still holds an unconsumed object, so the queue is full.
+			else if(distance < 0)
+			{
+				return false;
+			}
+			// Another producer got here first.
+			else
+			{
+				position = enqueue_position;
+			}
+		}
+		cell->object = object;
+		// Publish the object to consumers.
+		cell->sequence = position + 1;
+		return true;
+	}
+
+	// See method declaration for details.
+	template<class Type>
+	const bool LockFreeQueue<Type>::TryPop(Type& object)
+	{
+		Cell* cell = nullptr;
+		LONG position = dequeue_position;
+		while(true)
+		{
+			cell = &cells[position & mask];
+			const LONG distance = Distance(cell->sequence, position + 1);
+			// The slot holds a published object; try to claim it.
+			if(distance == 0)
+			{
+				if(InterlockedCompareExchange(&dequeue_position, position + 1, position) == position)
+				{
+					break;
+				}
+				position = dequeue_position;
+			}
+			// Nothing has been published to this slot yet, so the queue is empty.
+			else if(distance < 0)
+			{
+				return false;
+			}
+			// Another consumer got here first.
+			else
+			{
+				position = dequeue_position;
+			}
+		}
+		object = cell->object;
+		// Hand the slot back to the producer one lap ahead.
+		cell->sequence = position + mask + 1;
+		return true;
+	}
+
+	// See method declaration for details.
+	template<class Type>
+	const std::size_t LockFreeQueue<Type>::GetCapacity() const
+	{
+		return static_cast<std::size_t>(mask) + 1;
+	}
+
+	// See method declaration for details.
+	template<class Type>
+	const LONG LockFreeQueue<Type>::Distance(const LONG sequence, const LONG position)
+	{
+		return static_cast<LONG>(static_cast<unsigned long>(sequence) - static_cast<unsigned long>(position));
+	}
+
+	// See method declaration for details.
+	template<class Type>
+	const std::size_t LockFreeQueue<Type>::RoundUpToPowerOfTwo(const std::size_t minimum)
+	{
+		std::size_t power = 1;
+		while(power < minimum)
+		{
+			power <<= 1;
+		}
+		return power;
+	}
+
+
+} // utility
+} // avl
+#endif // AVL_UTILITY_LOCK_FREE_QUEUE__
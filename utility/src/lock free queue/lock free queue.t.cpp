@@ -0,0 +1,66 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the lock free queue component. See "lock free queue.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"lock free queue.h"
+#include<iostream>
+
+
+
+void TestLockFreeQueueComponent()
+{
+	// The capacity should be rounded up to a power of two.
+	avl::utility::LockFreeQueue<int> queue(5);
+	std::cout << "Capacity (expecting 8): " << queue.GetCapacity() << '\n';
+
+	// Fill the queue, then make sure that one more push fails.
+	for(int i = 0; i < 8; ++i)
+	{
+		if(queue.TryPush(i) != true)
+		{
+			std::cout << "Push " << i << " failed unexpectedly.\n";
+		}
+	}
+	std::cout << "Push into a full queue (expecting 0): " << queue.TryPush(8) << '\n';
+
+	// Objects should come out in the order they went in, then the queue should be empty.
+	int object = -1;
+	for(int i = 0; i < 8; ++i)
+	{
+		if(queue.TryPop(object) != true || object != i)
+		{
+			std::cout << "Pop " << i << " returned the wrong object.\n";
+		}
+	}
+	std::cout << "Pop from an empty queue (expecting 0): " << queue.TryPop(object) << '\n';
+
+	// Wrap around the storage a few times.
+	for(int i = 0; i < 100; ++i)
+	{
+		queue.TryPush(i);
+		queue.TryPop(object);
+		if(object != i)
+		{
+			std::cout << "Wraparound failed at " << i << ".\n";
+		}
+	}
+}
@@ -114,52 +114,44 @@ namespace utility
 
 		// Contains the message header as it is composed.
 		std::string header;
+		FormatUrgency(urgency, header);
+		FormatTimeStamp(time(nullptr), header);
+
+		// Write the header to the file.
+		file << header;
+	}
 
-		// First compose the urgency indicator, which consists of 1-4 asterisks
-		// inside of brackets. If urgency is less than 1, write 1 asterisk. If urgency
-		// is greater than 4, write 4 asterisks.
 
-		// First up, start with the opening bracket and at least one asterisk, then print
-		// from 0 to 3 more asterisks, depending on the value of urgency.
-		header = "[*";
-		for (short x = 2; x <= urgency; ++x)
-		{
-			header += '*';
-		}
 
-		// Now add in a space for each star that is missing to keep the formatting
-		// consistent.
-		for (short x = 4 - urgency; x >= 1; --x)
-		{
-			header += ' ';
-		}
 
-		// Now close the brackets.
+	// See method declaration for details.
+	void LogFile::FormatUrgency(const short urgency, std::string& header)
+	{
+		// Cap the urgency to the range of 1-4.
+		const short stars = (urgency < 1) ? 1 : ((urgency > 4) ? 4 : urgency);
+		// Print an asterisk for each level of urgency and a space for each star that is
+		// missing to keep the formatting consistent, then close the brackets.
+		header += '[';
+		header.append(stars, '*');
+		header.append(4 - stars, ' ');
 		header += ']';
+	}
 
 
 
-		// Now compose the date and time and add that to the header.
 
+	// See method declaration for details.
+	void LogFile::FormatTimeStamp(const time_t& time, std::string& header)
+	{
 		// Temporarily stores the date and time.
 		char date_and_time[30];
-		// Stores the raw time.
-		time_t raw_time;
 		// Stores the formatted time structure.
 		struct tm time_info;
-
-		// Get the raw time.
-		time(&raw_time);
 		// Get the formatted time structure in local time.
-		VERIFY(localtime_s(&time_info, &raw_time) == 0);
-		// Format the time and date into a string.
+		VERIFY(localtime_s(&time_info, &time) == 0);
+		// Format the time and date into a string and add it to the header.
 		strftime(date_and_time, 30, "%m/%d/%y @ %I:%M:%S%p---", &time_info);
-
-		// Add the date and time to the header.
 		header += date_and_time;
-
-		// Write the header to the file.
-		file << header;
 	}
 
 
@@ -26,6 +26,7 @@ Used for logging messages to a file in human-readable format.
 
 #include<string>
 #include<fstream>
+#include<ctime>
 
 
 namespace avl
@@ -58,6 +59,27 @@ namespace utility
 		*/
 		virtual const LogFile& operator()(const short& urgency, const std::string& message);
 
+	protected:
+		/** Appends the urgency indicator of a message header to \a header. The indicator
+		consists of 1-4 asterisks padded with spaces and enclosed in brackets.
+		@param urgency The urgency of the message. Values outside of 1-4 are capped to
+		the nearest valid value.
+		@param header [OUT] The string to which the urgency indicator is appended.
+		*/
+		static void FormatUrgency(const short urgency, std::string& header);
+
+		/** Appends the date and time portion of a message header to \a header.
+		@param time The time at which the message was logged.
+		@param header [OUT] The string to which the date and time are appended.
+		*/
+		static void FormatTimeStamp(const time_t& time, std::string& header);
+
+		/// The name of the log file.
+		const std::string file_name;
+		
+		/// The file which information will be logged to.
+		std::ofstream file;
+
 	private:
 		/** Attempts to write a message header to LogFile::file.
 		@param urgency The urgency of the message to follow this header.
@@ -70,12 +92,6 @@ namespace utility
 		*/
 		virtual void WriteMessage(const std::string& message);
 
-		/// The name of the log file.
-		const std::string file_name;
-		
-		/// The file which information will be logged to.
-		std::ofstream file;
-
 		/// NOT IMPLEMENTED.
 		LogFile(const LogFile&);
 		/// NOT IMPLEMENTED.
@@ -0,0 +1,272 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the lz codec component. See "lz codec.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"lz codec.h"
+#include"..\exceptions\exceptions.h"
+#include<vector>
+#include<cstddef>
+#include<cstring>
+#include<new>
+
+
+namespace avl
+{
+namespace utility
+{
+	// See method definitions for details.
+	namespace
+	{
+		/// Matches shorter than this aren't worth encoding.
+		const std::size_t MINIMUM_MATCH = 4;
+		/// Matches can't reach back further than this.
+		const std::size_t MAXIMUM_OFFSET = 65535;
+		/// The number of bits in a hash table index.
+		const unsigned int HASH_BITS = 14;
+		/// Searching for matches stops this close to the end of the data.
+		const std::size_t END_MARGIN = 12;
+
+		void WriteLength(std::vector<char>& compressed, std::size_t length);
+		const bool ReadLength(const unsigned char*& in, const unsigned char* const in_end, std::size_t& length);
+		void WriteSequence(std::vector<char>& compressed, const char* const literals, const std::size_t literal_count, const std::size_t offset, const std::size_t match_length);
+		const unsigned int Read32(const char* const data);
+		const unsigned int Hash(const unsigned int sequence);
+	}
+
+
+
+	// See function declaration for details.
+	void CompressLZ(const char* const data, const std::size_t size, std::vector<char>& compressed)
+	{
+		compressed.clear();
+		try
+		{
+			// Incompressible data grows by about one byte in 255.
+			compressed.reserve(size + size / 255 + 16);
+			if(size == 0)
+			{
+				return;
+			}
+
+			// Maps the hash of each 4-byte sequence to one past the position it was last seen at.
+			std::vector<std::size_t> table(static_cast<std::size_t>(1) << HASH_BITS, 0);
+			std::size_t anchor = 0;
+			std::size_t position = 0;
+			const std::size_t limit = (size > END_MARGIN) ? size - END_MARGIN : 0;
+			while(position < limit)
+			{
+				const unsigned int sequence = Read32(&data[position]);
+				const unsigned int hash = Hash(sequence);
+				const std::size_t candidate = table[hash];
+				table[hash] = position + 1;
+				if(candidate != 0 && position - (candidate - 1) <= MAXIMUM_OFFSET && Read32(&data[candidate - 1]) == sequence)
+				{
+					// Extend the match as far as it goes.
+					const std::size_t match = candidate - 1;
+					std::size_t match_length = MINIMUM_MATCH;
+					while(position + match_length < size && data[match + match_length] == data[position + match_length])
+					{
+						++match_length;
+					}
+					WriteSequence(compressed, &data[anchor], position - anchor, position - match, match_length);
+					position += match_length;
+					anchor = position;
+				}
+				else
+				{
+					++position;
+				}
+			}
+			// Whatever's left is stored as literals.
+			WriteSequence(compressed, &data[anchor], size - anchor, 0, 0);
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw OutOfMemoryError();
+		}
+	}
+
+	// See function declaration for details.
+	const bool DecompressLZ(const char* const compressed, const std::size_t compressed_size, char* const data, const std::size_t size)
+	{
+		if(size == 0)
+		{
+			return compressed_size == 0;
+		}
+		const unsigned char* in = reinterpret_cast<const unsigned char*>(compressed);
+		const unsigned char* const in_end = in + compressed_size;
+		char* out = data;
+		char* const out_end = data + size;
+		while(true)
+		{
+			if(in >= in_end)
+			{
+				return false;
+			}
+			const unsigned char token = *in++;
+
+			// Copy the literals.
+			std::size_t literal_count = token >> 4;
+			if(ReadLength(in, in_end, literal_count) == false)
+			{
+				return false;
+			}
+			if(literal_count > static_cast<std::size_t>(in_end - in) || literal_count > static_cast<std::size_t>(out_end - out))
+			{
+				return false;
+			}
+			memcpy(out, in, literal_count);
+			in += literal_count;
+			out += literal_count;
+
+			// The last sequence has no match.
+			if(out == out_end)
+			{
+				return in == in_end;
+			}
+
+			// Copy the match.
+			if(in_end - in < 2)
+			{
+				return false;
+			}
+			const std::size_t offset = in[0] | (in[1] << 8);
+			in += 2;
+			std::size_t match_length = token & 0x0F;
+			if(ReadLength(in, in_end, match_length) == false)
+			{
+				return false;
+			}
+			match_length += MINIMUM_MATCH;
+			if(offset == 0 || offset > static_cast<std::size_t>(out - data) || match_length > static_cast<std::size_t>(out_end - out))
+			{
+				return false;
+			}
+			const char* match = out - offset;
+			if(offset >= match_length)
+			{
+				memcpy(out, match, match_length);
+				out += match_length;
+			}
+			else
+			{
+				// The match overlaps the bytes being written, e.g. a run of one byte.
+				for(const char* const match_end = match + match_length; match != match_end; ++match, ++out)
+				{
+					*out = *match;
+				}
+			}
+		}
+	}
+
+
+
+	// Anonymous namespace.
+	namespace
+	{
+		/** Writes the part of a length which didn't fit in its token nibble.
+		@param compressed [OUT] The compressed data.
+		@param length The length, minus the 15 which was stored in the token.
+		*/
+		void WriteLength(std::vector<char>& compressed, std::size_t length)
+		{
+			while(length >= 255)
+			{
+				compressed.push_back(static_cast<char>(255));
+				length -= 255;
+			}
+			compressed.push_back(static_cast<char>(length));
+		}
+
+		/** Reads the continuation of a length whose token nibble is 15.
+		@param in [IN/OUT] The position in the compressed data.
+		@param in_end The end of the compressed data.
+		@param length [IN/OUT] The nibble from the token, to which the continuation is added.
+		@return False if the compressed data ends in the middle of the length.
+		*/
+		const bool ReadLength(const unsigned char*& in, const unsigned char* const in_end, std::size_t& length)
+		{
+			if(length != 15)
+			{
+				return true;
+			}
+			unsigned char byte = 255;
+			while(byte == 255)
+			{
+				if(in >= in_end)
+				{
+					return false;
+				}
+				byte = *in++;
+				length += byte;
+			}
+			return true;
+		}
+
+		/** Writes one sequence.
+		@param compressed [OUT] The compressed data.
+		@param literals The literal bytes.
+		@param literal_count The number of literal bytes.
+		@param offset The distance back to the match. Ignored if \a match_length is zero.
+		@param match_length The length of the match, or zero if this is the last sequence.
+		*/
+		void WriteSequence(std::vector<char>& compressed, const char* const literals, const std::size_t literal_count, const std::size_t offset, const std::size_t match_length)
+		{
+			const std::size_t match_code = (match_length > 0) ? match_length - MINIMUM_MATCH : 0;
+			const unsigned char token = static_cast<unsigned char>(((literal_count < 15 ? literal_count : 15) << 4) | (match_code < 15 ? match_code : 15));
+			compressed.push_back(static_cast<char>(token));
+			if(literal_count >= 15)
+			{
+				WriteLength(compressed, literal_count - 15);
+			}
+			compressed.insert(compressed.end(), literals, literals + literal_count);
+			if(match_length == 0)
+			{
+				return;
+			}
+			compressed.push_back(static_cast<char>(offset & 0xFF));
+			compressed.push_back(static_cast<char>(offset >> 8));
+			if(match_code >= 15)
+			{
+				WriteLength(compressed, match_code - 15);
+			}
+		}
+
+		/** Reads 4 unaligned bytes.*/
+		const unsigned int Read32(const char* const data)
+		{
+			unsigned int value;
+			memcpy(&value, data, 4);
+			return value;
+		}
+
+		/** Hashes a 4-byte sequence into a table index.*/
+		const unsigned int Hash(const unsigned int sequence)
+		{
+			return (sequence * 2654435761u) >> (32 - HASH_BITS);
+		}
+	}
+
+
+
+} // utility
+} // avl
@@ -0,0 +1,68 @@
+#pragma once
+#ifndef AVL_UTILITY_LZ_CODEC__
+#define AVL_UTILITY_LZ_CODEC__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Provides a small, fast LZ77-family compressor and decompressor.
+@par Format:
+The compressed data is a series of sequences. Each sequence starts with a token
+byte whose high nibble is the number of literal bytes which follow and whose low
+nibble is the length of the match minus 4. A nibble of 15 means that the length
+continues in the following bytes, each of which is added to the length until one
+is less than 255. The literals come next, then (unless the literals end the data)
+the match's 2-byte little-endian offset back into the decompressed data, then any
+continued match length.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include<vector>
+#include<cstddef>
+
+
+namespace avl
+{
+namespace utility
+{
+	/** Compresses \a size bytes of \a data.
+	@post \a compressed holds the compressed data and nothing else. It may be larger
+	than \a data if \a data is incompressible.
+	@param data The data to compress.
+	@param size The size of \a data in bytes.
+	@param compressed [OUT] Receives the compressed data.
+	@throws OutOfMemoryError If we run out of memory.
+	*/
+	void CompressLZ(const char* const data, const std::size_t size, std::vector<char>& compressed);
+
+	/** Decompresses data produced by \ref CompressLZ(). Corrupt input is detected
+	rather than allowed to read or write out of bounds.
+	@param compressed The compressed data.
+	@param compressed_size The size of \a compressed in bytes.
+	@param data [OUT] Receives the decompressed data.
+	@param size The size of the decompressed data in bytes. Must be exact.
+	@return True if \a compressed decompressed to exactly \a size bytes, and false if
+	it's corrupt.
+	*/
+	const bool DecompressLZ(const char* const compressed, const std::size_t compressed_size, char* const data, const std::size_t size);
+
+
+
+} // utility
+} // avl
+#endif // AVL_UTILITY_LZ_CODEC__
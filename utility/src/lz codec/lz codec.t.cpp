@@ -0,0 +1,79 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the lz codec component. See "lz codec.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"lz codec.h"
+#include"..\file operations\file operations.h"
+#include"..\exceptions\exceptions.h"
+#include<iostream>
+#include<vector>
+#include<string>
+#include<cstring>
+#include<cstdlib>
+
+
+
+namespace
+{
+	/** Compresses and decompresses \a size bytes of \a data and reports whether the round trip worked.*/
+	void RoundTrip(const std::string& name, const char* const data, const std::size_t size)
+	{
+		std::vector<char> compressed;
+		avl::utility::CompressLZ(data, size, compressed);
+		std::vector<char> decompressed(size + 1);
+		const bool ok = avl::utility::DecompressLZ(compressed.empty() ? nullptr : &compressed[0], compressed.size(), &decompressed[0], size)
+			&& memcmp(data, &decompressed[0], size) == 0;
+		std::cout << name << ": " << size << " -> " << compressed.size() << " bytes, round trip " << (ok ? "passed" : "FAILED") << '\n';
+	}
+}
+
+
+
+void TestLZCodecComponent()
+{
+	// Highly repetitive data.
+	const std::string runs(10000, 'a');
+	RoundTrip("Run", runs.data(), runs.size());
+
+	// Incompressible data.
+	std::vector<char> noise(10000);
+	for(std::vector<char>::iterator i = noise.begin(); i != noise.end(); ++i)
+	{
+		*i = static_cast<char>(rand());
+	}
+	RoundTrip("Noise", &noise[0], noise.size());
+
+	// Real assets.
+	const avl::utility::MappedFile image("assets/explosion.tga");
+	RoundTrip("explosion.tga", image.GetData(), image.GetSize());
+	const avl::utility::MappedFile text("assets/component settings.txt");
+	RoundTrip("component settings.txt", text.GetData(), text.GetSize());
+
+	// Corrupt data must be rejected rather than overrun the output.
+	std::vector<char> compressed;
+	avl::utility::CompressLZ(runs.data(), runs.size(), compressed);
+	compressed.resize(compressed.size() / 2);
+	std::vector<char> output(runs.size());
+	std::cout << "Truncated data rejected: " << (avl::utility::DecompressLZ(&compressed[0], compressed.size(), &output[0], output.size()) == false) << '\n';
+
+	system("pause");
+}
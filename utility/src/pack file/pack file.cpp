@@ -0,0 +1,457 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the pack file component. See "pack file.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"pack file.h"
+#include"..\file operations\file operations.h"
+#include"..\lz codec\lz codec.h"
+#include"..\exceptions\exceptions.h"
+#include<string>
+#include<vector>
+#include<memory>
+#include<fstream>
+#include<cstring>
+#include<cctype>
+#include<new>
+
+
+namespace avl
+{
+namespace utility
+{
+	// See method definitions for details.
+	namespace
+	{
+		/// Identifies an archive.
+		const char MAGIC[8] = {'A', 'V', 'L', 'P', 'A', 'C', 'K', '1'};
+		/// The size of the header.
+		const std::size_t HEADER_SIZE = 32;
+		/// The size of a slot in the table of contents.
+		const std::size_t SLOT_SIZE = 32;
+
+		/// The mounted archives, in the order they were mounted.
+		std::vector<std::shared_ptr<const PackFile>> mounted_pack_files;
+
+		const unsigned int Read32(const char* const data);
+		void Write32(std::vector<char>& data, const unsigned int value);
+	}
+
+
+
+	// See method declaration for details.
+	PackFile::PackFile(const std::string& file_name)
+		: file(file_name, MappedFile::RANDOM), slots(nullptr), slot_count(0), entry_count(0), names(nullptr), names_size(0)
+	{
+		const char* const data = file.GetData();
+		const std::size_t size = file.GetSize();
+		if(size < HEADER_SIZE || memcmp(data, MAGIC, sizeof(MAGIC)) != 0)
+		{
+			throw FileFormatException(file_name);
+		}
+		entry_count = Read32(&data[8]);
+		slot_count = Read32(&data[12]);
+		const unsigned int slots_offset = Read32(&data[16]);
+		const unsigned int names_offset = Read32(&data[20]);
+		names_size = Read32(&data[24]);
+
+		// The slot count must be a power of two with room to spare, and the table and
+		// names must lie within the file.
+		if(slot_count == 0 || (slot_count & (slot_count - 1)) != 0 || entry_count >= slot_count
+			|| slots_offset > size || slot_count > (size - slots_offset) / SLOT_SIZE
+			|| names_offset > size || names_size > size - names_offset
+			|| slots_offset % sizeof(unsigned long long) != 0)
+		{
+			throw FileFormatException(file_name);
+		}
+		slots = data + slots_offset;
+		names = data + names_offset;
+
+		// Check every entry once here, so that lookups can trust the table.
+		unsigned int used_slots = 0;
+		for(unsigned int i = 0; i < slot_count; ++i)
+		{
+			const Slot& slot = *reinterpret_cast<const Slot*>(slots + i * SLOT_SIZE);
+			if(slot.name_length == 0)
+			{
+				continue;
+			}
+			++used_slots;
+			if(slot.name_offset > names_size || slot.name_length > names_size - slot.name_offset
+				|| slot.data_offset > size || slot.stored_size > size - slot.data_offset
+				|| ((slot.flags & COMPRESSED) == 0 && slot.stored_size != slot.size))
+			{
+				throw FileFormatException(file_name);
+			}
+		}
+		// Lookups rely upon there being at least one empty slot.
+		if(used_slots != entry_count)
+		{
+			throw FileFormatException(file_name);
+		}
+	}
+
+	// See method declaration for details.
+	PackFile::~PackFile()
+	{
+	}
+
+	// See method declaration for details.
+	const bool PackFile::Contains(const std::string& entry_name) const
+	{
+		return FindSlot(entry_name) != nullptr;
+	}
+
+	// See method declaration for details.
+	MappedFile PackFile::Open(const std::string& entry_name) const
+	{
+		const Slot* const slot = FindSlot(entry_name);
+		if(slot == nullptr)
+		{
+			throw FileNotFoundException(entry_name);
+		}
+		const std::string name(names + slot->name_offset, slot->name_length);
+
+		// Uncompressed entries are used in place.
+		if((slot->flags & COMPRESSED) == 0)
+		{
+			return MappedFile(file, slot->data_offset, slot->size, name);
+		}
+
+		std::vector<char> data;
+		try
+		{
+			data.resize(slot->size);
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw OutOfMemoryError();
+		}
+		if(DecompressLZ(file.GetData() + slot->data_offset, slot->stored_size, data.empty() ? nullptr : &data[0], data.size()) == false)
+		{
+			throw FileFormatException(file.GetFileName() + ": " + name);
+		}
+		return MappedFile(data, name);
+	}
+
+	// See method declaration for details.
+	const std::size_t PackFile::GetEntryCount() const
+	{
+		return entry_count;
+	}
+
+	// See method declaration for details.
+	const std::string& PackFile::GetFileName() const
+	{
+		return file.GetFileName();
+	}
+
+	// See method declaration for details.
+	const std::string PackFile::NormalizeEntryName(const std::string& entry_name)
+	{
+		std::string name;
+		name.reserve(entry_name.size());
+		for(std::string::const_iterator i = entry_name.begin(); i != entry_name.end(); ++i)
+		{
+			name += (*i == '\\') ? '/' : static_cast<char>(tolower(static_cast<unsigned char>(*i)));
+		}
+		while(name.size() >= 2 && name[0] == '.' && name[1] == '/')
+		{
+			name.erase(0, 2);
+		}
+		return name;
+	}
+
+	// See method declaration for details.
+	const unsigned long long PackFile::HashEntryName(const char* const name, const std::size_t length)
+	{
+		unsigned long long hash = 14695981039346656037ULL;
+		for(std::size_t i = 0; i < length; ++i)
+		{
+			hash ^= static_cast<unsigned char>(name[i]);
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+
+	// See method declaration for details.
+	const PackFile::Slot* const PackFile::FindSlot(const std::string& entry_name) const
+	{
+		const std::string name = NormalizeEntryName(entry_name);
+		const unsigned long long hash = HashEntryName(name.data(), name.size());
+		// The table is never full, so probing always reaches an empty slot.
+		for(unsigned int i = static_cast<unsigned int>(hash) & (slot_count - 1); ; i = (i + 1) & (slot_count - 1))
+		{
+			const Slot* const slot = reinterpret_cast<const Slot*>(slots + i * SLOT_SIZE);
+			if(slot->name_length == 0)
+			{
+				return nullptr;
+			}
+			if(slot->hash == hash && slot->name_length == name.size() && memcmp(names + slot->name_offset, name.data(), name.size()) == 0)
+			{
+				return slot;
+			}
+		}
+	}
+
+
+
+	// See method declaration for details.
+	PackFileBuilder::PackFileBuilder()
+	{
+	}
+
+	// See method declaration for details.
+	PackFileBuilder::~PackFileBuilder()
+	{
+	}
+
+	// See method declaration for details.
+	void PackFileBuilder::AddEntry(const std::string& entry_name, const char* const data, const std::size_t size, const bool compress)
+	{
+		const std::string name = PackFile::NormalizeEntryName(entry_name);
+		if(name.empty() == true)
+		{
+			throw InvalidArgumentException("avl::utility::PackFileBuilder::AddEntry()", "entry_name", "Must not be empty.");
+		}
+		for(std::vector<Entry>::const_iterator i = entries.begin(); i != entries.end(); ++i)
+		{
+			if(i->name == name)
+			{
+				throw InvalidArgumentException("avl::utility::PackFileBuilder::AddEntry()", "entry_name", "The archive already holds an entry with this name.");
+			}
+		}
+
+		try
+		{
+			entries.push_back(Entry());
+			Entry& entry = entries.back();
+			entry.name = name;
+			entry.size = size;
+			entry.is_compressed = false;
+			if(compress == true)
+			{
+				CompressLZ(data, size, entry.data);
+				// Only keep the compressed data if it saves at least an eighth of the space;
+				// otherwise it isn't worth decompressing.
+				entry.is_compressed = (entry.data.size() < size - size / 8);
+			}
+			if(entry.is_compressed == false)
+			{
+				entry.data.assign(data, data + size);
+			}
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw OutOfMemoryError();
+		}
+	}
+
+	// See method declaration for details.
+	void PackFileBuilder::AddFile(const std::string& file_name, const bool compress)
+	{
+		const MappedFile file(file_name);
+		AddEntry(file_name, file.GetData(), file.GetSize(), compress);
+	}
+
+	// See method declaration for details.
+	void PackFileBuilder::Write(const std::string& file_name) const
+	{
+		try
+		{
+			// Keep the table at most half full so that probes stay short.
+			unsigned int slot_count = 1;
+			while(slot_count < entries.size() * 2)
+			{
+				slot_count <<= 1;
+			}
+			std::vector<const Entry*> table(slot_count, nullptr);
+			std::vector<unsigned long long> hashes(slot_count, 0);
+			std::string names;
+			std::vector<unsigned int> name_offsets(slot_count, 0);
+			for(std::vector<Entry>::const_iterator i = entries.begin(); i != entries.end(); ++i)
+			{
+				const unsigned long long hash = PackFile::HashEntryName(i->name.data(), i->name.size());
+				unsigned int slot = static_cast<unsigned int>(hash) & (slot_count - 1);
+				while(table[slot] != nullptr)
+				{
+					slot = (slot + 1) & (slot_count - 1);
+				}
+				table[slot] = &*i;
+				hashes[slot] = hash;
+				name_offsets[slot] = static_cast<unsigned int>(names.size());
+				names += i->name;
+			}
+
+			// Lay out the header, the table, the names, then the aligned data.
+			const std::size_t slots_offset = HEADER_SIZE;
+			const std::size_t names_offset = slots_offset + slot_count * SLOT_SIZE;
+			std::size_t data_offset = names_offset + names.size();
+			std::vector<char> header;
+			header.insert(header.end(), MAGIC, MAGIC + sizeof(MAGIC));
+			Write32(header, static_cast<unsigned int>(entries.size()));
+			Write32(header, slot_count);
+			Write32(header, static_cast<unsigned int>(slots_offset));
+			Write32(header, static_cast<unsigned int>(names_offset));
+			Write32(header, static_cast<unsigned int>(names.size()));
+			Write32(header, 0);
+
+			std::vector<std::size_t> data_offsets(slot_count, 0);
+			for(unsigned int i = 0; i < slot_count; ++i)
+			{
+				PackFile::Slot slot;
+				memset(&slot, 0, sizeof(slot));
+				if(table[i] != nullptr)
+				{
+					data_offset = (data_offset + PackFile::ALIGNMENT - 1) / PackFile::ALIGNMENT * PackFile::ALIGNMENT;
+					data_offsets[i] = data_offset;
+					slot.hash = hashes[i];
+					slot.name_offset = name_offsets[i];
+					slot.name_length = static_cast<unsigned int>(table[i]->name.size());
+					slot.data_offset = static_cast<unsigned int>(data_offset);
+					slot.stored_size = static_cast<unsigned int>(table[i]->data.size());
+					slot.size = static_cast<unsigned int>(table[i]->size);
+					slot.flags = (table[i]->is_compressed == true) ? PackFile::COMPRESSED : 0;
+					data_offset += table[i]->data.size();
+				}
+				const char* const bytes = reinterpret_cast<const char*>(&slot);
+				header.insert(header.end(), bytes, bytes + sizeof(slot));
+			}
+			header.insert(header.end(), names.begin(), names.end());
+
+			std::ofstream file;
+			file.exceptions(std::ios::goodbit);
+			file.open(file_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+			if(file.fail() == true)
+			{
+				throw FileWriteException(file_name);
+			}
+			file.write(&header[0], header.size());
+			std::size_t written = header.size();
+			const char padding[PackFile::ALIGNMENT] = {0};
+			for(unsigned int i = 0; i < slot_count; ++i)
+			{
+				if(table[i] == nullptr)
+				{
+					continue;
+				}
+				file.write(padding, data_offsets[i] - written);
+				if(table[i]->data.empty() == false)
+				{
+					file.write(&table[i]->data[0], table[i]->data.size());
+				}
+				written = data_offsets[i] + table[i]->data.size();
+			}
+			file.close();
+			if(file.fail() == true)
+			{
+				throw FileWriteException(file_name);
+			}
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw OutOfMemoryError();
+		}
+	}
+
+	// See method declaration for details.
+	const std::size_t PackFileBuilder::GetCompressedCount() const
+	{
+		std::size_t count = 0;
+		for(std::vector<Entry>::const_iterator i = entries.begin(); i != entries.end(); ++i)
+		{
+			count += (i->is_compressed == true) ? 1 : 0;
+		}
+		return count;
+	}
+
+
+
+	// See function declaration for details.
+	void MountPackFile(const std::string& file_name)
+	{
+		try
+		{
+			mounted_pack_files.push_back(std::shared_ptr<const PackFile>(new PackFile(file_name)));
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw OutOfMemoryError();
+		}
+	}
+
+	// See function declaration for details.
+	void UnmountPackFiles()
+	{
+		mounted_pack_files.clear();
+	}
+
+	// See function declaration for details.
+	const bool IsAssetFilePacked(const std::string& file_name)
+	{
+		for(std::vector<std::shared_ptr<const PackFile>>::const_iterator i = mounted_pack_files.begin(); i != mounted_pack_files.end(); ++i)
+		{
+			if((*i)->Contains(file_name) == true)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// See function declaration for details.
+	MappedFile OpenAssetFile(const std::string& file_name, const MappedFile::AccessPattern pattern)
+	{
+		for(std::vector<std::shared_ptr<const PackFile>>::const_reverse_iterator i = mounted_pack_files.rbegin(); i != mounted_pack_files.rend(); ++i)
+		{
+			if((*i)->Contains(file_name) == true)
+			{
+				return (*i)->Open(file_name);
+			}
+		}
+		return MappedFile(file_name, pattern);
+	}
+
+
+
+	// Anonymous namespace.
+	namespace
+	{
+		/** Reads a 32-bit little-endian value.*/
+		const unsigned int Read32(const char* const data)
+		{
+			unsigned int value;
+			memcpy(&value, data, 4);
+			return value;
+		}
+
+		/** Appends a 32-bit little-endian value to \a data.*/
+		void Write32(std::vector<char>& data, const unsigned int value)
+		{
+			const char* const bytes = reinterpret_cast<const char*>(&value);
+			data.insert(data.end(), bytes, bytes + 4);
+		}
+	}
+
+
+
+} // utility
+} // avl
@@ -0,0 +1,275 @@
+#pragma once
+#ifndef AVL_UTILITY_PACK_FILE__
+#define AVL_UTILITY_PACK_FILE__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Defines the \ref avl::utility::PackFile and \ref avl::utility::PackFileBuilder classes,
+which read and write archives of asset files, and \ref avl::utility::OpenAssetFile(),
+which opens an asset from a mounted archive or from the disk.
+@par Format:
+All values are little-endian.
+@li A 32-byte header: the 8 characters "AVLPACK1", then 32-bit values for the entry
+count, the slot count, the offset of the slot table, the offset of the names, the
+size of the names, and one reserved value.
+@li The slot table: an open-addressed hash table of 32-byte slots, indexed by the
+64-bit FNV-1a hash of each normalized entry name and probed linearly. Each slot
+holds the hash, then 32-bit values for the offset and length of the entry's name,
+the offset of its data, the stored size of its data, its original size, and its
+flags. Empty slots have a name length of zero.
+@li The names, which aren't null-terminated.
+@li The entries' data, each aligned to \ref PackFile::ALIGNMENT bytes so that
+it may be used straight out of the mapped archive.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"..\file operations\file operations.h"
+#include<string>
+#include<vector>
+#include<cstddef>
+
+
+namespace avl
+{
+namespace utility
+{
+	/**
+	A read-only archive of asset files. The archive is mapped into memory and its
+	table of contents is used in place, so opening the archive costs one file open
+	no matter how many entries it holds, and opening an entry costs one hash lookup.
+	Uncompressed entries are returned as views straight into the mapping.
+	@note Entry names are case-insensitive, and '\\' and '/' are interchangeable.
+	*/
+	class PackFile
+	{
+	public:
+		/// Entry data is aligned to this many bytes within the archive.
+		static const std::size_t ALIGNMENT = 16;
+
+		/** Maps the archive named \a file_name and validates its table of contents.
+		@param file_name The name of the archive.
+		@throws FileNotFoundException If the file doesn't exist.
+		@throws FileReadException If an error occurs while reading from the file.
+		@throws FileFormatException If the file isn't a valid archive.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		PackFile(const std::string& file_name);
+		/** Basic destructor. Views of entries stay valid after the archive is destroyed.*/
+		~PackFile();
+
+		/** Checks whether the archive holds an entry named \a entry_name.
+		@param entry_name The name of the entry.
+		@return True if the entry exists.
+		*/
+		const bool Contains(const std::string& entry_name) const;
+
+		/** Opens the entry named \a entry_name, decompressing it if necessary.
+		@param entry_name The name of the entry.
+		@return A view of the entry's contents.
+		@throws FileNotFoundException If the entry doesn't exist.
+		@throws FileFormatException If the entry's compressed data is corrupt.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		MappedFile Open(const std::string& entry_name) const;
+
+		/** Accesses the number of entries in the archive.
+		@return The number of entries.
+		*/
+		const std::size_t GetEntryCount() const;
+
+		/** Accesses the name of the archive.
+		@return The name of the archive.
+		*/
+		const std::string& GetFileName() const;
+
+		/** Converts \a entry_name into the form in which names are stored and hashed:
+		lowercase, with forward slashes and without any leading "./".
+		@param entry_name The name to normalize.
+		@return The normalized name.
+		*/
+		static const std::string NormalizeEntryName(const std::string& entry_name);
+
+		/** Hashes a normalized entry name.
+		@param name The start of the normalized name.
+		@param length The length of the name.
+		@return The 64-bit FNV-1a hash of the name.
+		*/
+		static const unsigned long long HashEntryName(const char* const name, const std::size_t length);
+
+	private:
+		/** A slot in the table of contents, as it's laid out in the archive.*/
+		struct Slot
+		{
+			/// The hash of the entry's normalized name.
+			unsigned long long hash;
+			/// The offset of the entry's name from the start of the names.
+			unsigned int name_offset;
+			/// The length of the entry's name, or zero if the slot is empty.
+			unsigned int name_length;
+			/// The offset of the entry's data from the start of the archive.
+			unsigned int data_offset;
+			/// The number of bytes which the entry's data takes up in the archive.
+			unsigned int stored_size;
+			/// The size of the entry's original data.
+			unsigned int size;
+			/// See \ref PackFile::COMPRESSED.
+			unsigned int flags;
+		};
+
+		/// Set in Slot::flags if the entry is compressed with CompressLZ().
+		static const unsigned int COMPRESSED = 1;
+
+		friend class PackFileBuilder;
+
+		/** Finds the slot of the entry named \a entry_name.
+		@param entry_name The name of the entry.
+		@return The entry's slot, or nullptr if the entry doesn't exist.
+		*/
+		const Slot* const FindSlot(const std::string& entry_name) const;
+
+		/// The mapped archive.
+		const MappedFile file;
+		/// The table of contents, within \ref file.
+		const char* slots;
+		/// The number of slots in the table of contents. Always a power of two.
+		unsigned int slot_count;
+		/// The number of entries.
+		unsigned int entry_count;
+		/// The entries' names, within \ref file.
+		const char* names;
+		/// The size of the names.
+		unsigned int names_size;
+
+		/// NOT IMPLEMENTED.
+		PackFile(const PackFile&);
+		/// NOT IMPLEMENTED.
+		const PackFile& operator=(const PackFile&);
+	};
+
+
+
+	/**
+	Builds a \ref PackFile archive from files or data in memory.
+	*/
+	class PackFileBuilder
+	{
+	public:
+		/** Basic constructor.*/
+		PackFileBuilder();
+		/** Basic destructor.*/
+		~PackFileBuilder();
+
+		/** Adds an entry to the archive.
+		@param entry_name The name of the entry. See PackFile::NormalizeEntryName().
+		@param data The entry's data.
+		@param size The size of \a data in bytes.
+		@param compress If true, the entry is compressed if that saves space.
+		@throws InvalidArgumentException If \a entry_name is empty or already in the archive.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		void AddEntry(const std::string& entry_name, const char* const data, const std::size_t size, const bool compress);
+
+		/** Adds the file named \a file_name to the archive, under its own name.
+		@param file_name The name of the file.
+		@param compress If true, the entry is compressed if that saves space.
+		@throws FileNotFoundException If the file doesn't exist.
+		@throws FileReadException If an error occurs while reading from the file.
+		@throws InvalidArgumentException If the file is already in the archive.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		void AddFile(const std::string& file_name, const bool compress);
+
+		/** Writes the archive.
+		@warning This will write over any existing file named \a file_name.
+		@param file_name The name of the archive.
+		@throws FileWriteException If an error occurs while writing to the file.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		void Write(const std::string& file_name) const;
+
+		/** Accesses the number of entries which were stored compressed.
+		@return The number of compressed entries.
+		*/
+		const std::size_t GetCompressedCount() const;
+
+	private:
+		/** An entry waiting to be written.*/
+		struct Entry
+		{
+			/// The normalized name of the entry.
+			std::string name;
+			/// The data to store, compressed or not.
+			std::vector<char> data;
+			/// The size of the original data.
+			std::size_t size;
+			/// True if \ref data is compressed.
+			bool is_compressed;
+		};
+
+		/// The entries, in the order they were added.
+		std::vector<Entry> entries;
+
+		/// NOT IMPLEMENTED.
+		PackFileBuilder(const PackFileBuilder&);
+		/// NOT IMPLEMENTED.
+		const PackFileBuilder& operator=(const PackFileBuilder&);
+	};
+
+
+
+	/** Makes the entries of the archive named \a file_name available through
+	\ref OpenAssetFile(). Archives mounted later take precedence.
+	@attention Not safe to call while assets are being opened on other threads; mount
+	archives before starting an AssetLoader.
+	@param file_name The name of the archive.
+	@throws FileNotFoundException If the file doesn't exist.
+	@throws FileFormatException If the file isn't a valid archive.
+	@throws OutOfMemoryError If we run out of memory.
+	*/
+	void MountPackFile(const std::string& file_name);
+
+	/** Unmounts every mounted archive. Views which have already been opened stay valid.
+	@attention Not safe to call while assets are being opened on other threads.
+	*/
+	void UnmountPackFiles();
+
+	/** Checks whether a mounted archive holds an entry named \a file_name, in which case
+	\ref OpenAssetFile() will open that entry rather than a loose file.
+	@param file_name The name of the asset.
+	@return True if the asset will be opened from an archive.
+	*/
+	const bool IsAssetFilePacked(const std::string& file_name);
+
+	/** Opens an asset file. If a mounted archive holds an entry named \a file_name, that
+	entry is opened; otherwise the file is mapped from the disk.
+	@param file_name The name of the asset.
+	@param pattern How the contents of a loose file will be read.
+	@return A view of the asset's contents.
+	@throws FileNotFoundException If the asset doesn't exist.
+	@throws FileReadException If an error occurs while reading from the file.
+	@throws FileFormatException If an archive entry is corrupt.
+	@throws OutOfMemoryError If we run out of memory.
+	*/
+	MappedFile OpenAssetFile(const std::string& file_name, const MappedFile::AccessPattern pattern = MappedFile::SEQUENTIAL);
+
+
+
+} // utility
+} // avl
+#endif // AVL_UTILITY_PACK_FILE__
@@ -0,0 +1,110 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the pack file component. See "pack file.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"pack file.h"
+#include"..\file operations\file operations.h"
+#include"..\exceptions\exceptions.h"
+#include"..\timer\timer.h"
+#include<iostream>
+#include<string>
+#include<vector>
+#include<cstring>
+#include<cstdlib>
+
+
+
+namespace
+{
+	/// The assets which are packed and loaded.
+	const char* const ASSETS[] = {"assets/background.tga", "assets/blue.tga", "assets/explosion.tga", "assets/Font.tga",
+		"assets/green.tga", "assets/red squares.tga", "assets/red.tga", "assets/spiral.tga", "assets/translucent.tga",
+		"assets/component settings.txt", "assets/Example.txt"};
+	const std::size_t ASSET_COUNT = sizeof(ASSETS) / sizeof(ASSETS[0]);
+
+	/** Opens every asset through OpenAssetFile() and touches every byte, as a loader would.
+	@return The time taken in seconds.
+	*/
+	const double LoadAssets(unsigned int& checksum)
+	{
+		avl::utility::Timer timer;
+		for(std::size_t i = 0; i < ASSET_COUNT; ++i)
+		{
+			const avl::utility::MappedFile file = avl::utility::OpenAssetFile(ASSETS[i]);
+			for(std::size_t j = 0; j < file.GetSize(); ++j)
+			{
+				checksum = checksum * 31 + static_cast<unsigned char>(file.GetData()[j]);
+			}
+		}
+		return timer.Elapsed();
+	}
+}
+
+
+
+void TestPackFileComponent()
+{
+	try
+	{
+		// Build an uncompressed and a compressed archive of the test assets.
+		avl::utility::PackFileBuilder builder;
+		avl::utility::PackFileBuilder compressed_builder;
+		for(std::size_t i = 0; i < ASSET_COUNT; ++i)
+		{
+			builder.AddFile(ASSETS[i], false);
+			compressed_builder.AddFile(ASSETS[i], true);
+		}
+		builder.Write("test assets.pak");
+		compressed_builder.Write("test compressed assets.pak");
+		std::cout << compressed_builder.GetCompressedCount() << " of " << ASSET_COUNT << " assets were worth compressing.\n";
+
+		// Names are case- and slash-insensitive, and unknown names fall through to the disk.
+		const avl::utility::PackFile pack("test assets.pak");
+		std::cout << "Entries: " << pack.GetEntryCount() << ", finds \"ASSETS\\FONT.TGA\": " << pack.Contains("ASSETS\\FONT.TGA") << ", finds \"assets/missing.tga\": " << pack.Contains("assets/missing.tga") << '\n';
+		std::cout << "Entry data is aligned: " << (reinterpret_cast<std::size_t>(pack.Open("assets/red.tga").GetData()) % avl::utility::PackFile::ALIGNMENT == 0) << '\n';
+
+		// The first pass over the loose files is the closest thing to a cold start that can
+		// be measured here; run this right after a reboot for true cold-cache numbers.
+		unsigned int loose_checksum = 0;
+		const double loose_time = LoadAssets(loose_checksum);
+
+		unsigned int pack_checksum = 0;
+		avl::utility::MountPackFile("test assets.pak");
+		const double pack_time = LoadAssets(pack_checksum);
+		avl::utility::UnmountPackFiles();
+
+		unsigned int compressed_checksum = 0;
+		avl::utility::MountPackFile("test compressed assets.pak");
+		const double compressed_time = LoadAssets(compressed_checksum);
+		avl::utility::UnmountPackFiles();
+
+		std::cout << "Loose files:      " << loose_time * 1000.0 << "ms\n";
+		std::cout << "Pack file:        " << pack_time * 1000.0 << "ms (matches: " << (pack_checksum == loose_checksum) << ")\n";
+		std::cout << "Compressed pack:  " << compressed_time * 1000.0 << "ms (matches: " << (compressed_checksum == loose_checksum) << ")\n";
+	}
+	catch(const avl::utility::Exception& e)
+	{
+		std::cout << e.GetDescription() << std::endl;
+	}
+
+	system("pause");
+}
@@ -24,12 +24,15 @@ Implementation for the settings file component. See "settings file.h" for detail
 #include"settings file.h"
 #include"..\assert\assert.h"
 #include"..\exceptions\exceptions.h"
+#include"..\file operations\file operations.h"
+#include"..\pack file\pack file.h"
 #include<cctype>
-#include<cstdlib>
-#include<iostream>
+#include<climits>
+#include<cstring>
 #include<sstream>
-#include<fstream>
+#include<string>
 #include<vector>
+#include<new>
 
 
 
@@ -39,31 +42,56 @@ namespace avl
 namespace utility
 {
 
+	// Anonymous namespace.
+	namespace
+	{
+		/// The number of slots a table starts with. Must be a power of two.
+		const unsigned int INITIAL_TABLE_SIZE = 64;
+		/// Identifies a settings cache file, and its version.
+		const char CACHE_MAGIC[8] = {'A', 'V', 'L', 'S', 'E', 'T', '1', '\0'};
+		/// Marks an integer variable in a cache file.
+		const char CACHE_INTEGER = 'I';
+		/// Marks a string variable in a cache file.
+		const char CACHE_STRING = 'S';
+
+		const char* SkipWhitespace(const char* begin, const char* const end);
+		const char* TrimWhitespace(const char* const begin, const char* end);
+		const bool ParseInteger(const char* begin, const char* const end, long& integer_value);
+		void AppendBytes(std::vector<char>& data, const void* const bytes, const std::size_t count);
+		const bool ReadBytes(const char*& cursor, const char* const end, void* const destination, const std::size_t count);
+	}
+
+
+
 	// Attempts to open the specified file and read in formatted data. If an error occurs
 	// while attempting to read from the file, will throw a FileReadException. If there is a syntax
 	// error, will throw a SettingsFileSyntaxError with one of these types:
 	// SettingsFile::SyntaxError::BAD_VARIABLE_NAME if there is a problem with the variable name; or
 	// SettingsFile::SyntaxError::BAD_VALUE if there is a problem with a variable's value.
-	SettingsFile::SettingsFile(const std::string& file_name)
+	SettingsFile::SettingsFile(const std::string& file_name, const bool use_cache)
+		: variable_count(0), loaded_from_cache(false)
 	{
-		std::ifstream file;
-		// First, tell the file not to throw any exceptions.
-		file.exceptions(std::ios_base::goodbit);
-		// Now attempt to open the specified file name for reading.
-		file.open(file_name.c_str(), std::ios_base::in);
-		// Check to see if the file was successfully opened. If not, then throw a FileReadException.
-		if(file.fail() == true)
-		{
-			file.close();
-			throw FileNotFoundException(file_name);
-		}
-		// At this point, the file should be ready for reading. Read the file into memory.
-		StringVector lines;
-		LoadFileToString(file, lines, file_name);
-		// Close the file.
-		file.close();
-		// Load the settings from the file.
-		LoadSettings(lines, file_name);
+		Clear();
+		// A cache can only be checked against a loose file, since that's what has a write time.
+		if(use_cache == true && IsAssetFilePacked(file_name) == false)
+		{
+			// If the file doesn't exist, this throws a FileNotFoundException.
+			const unsigned long long write_time = FileLastWriteTime(file_name);
+			const std::string cache_name = file_name + ".cache";
+			if(LoadCache(cache_name, write_time) == true)
+			{
+				loaded_from_cache = true;
+				return;
+			}
+			Parse(MappedFile(file_name));
+			SaveCache(cache_name, write_time);
+		}
+		else
+		{
+			// Open the file, either from a mounted pack file or from the disk. If it doesn't exist,
+			// this throws a FileNotFoundException.
+			Parse(OpenAssetFile(file_name));
+		}
 	}
 
 
@@ -76,269 +104,449 @@ namespace utility
 
 
 
-	const bool SettingsFile::IsIntegerVariable(const std::string& variable)
+	// See method declaration for details.
+	const bool SettingsFile::IsIntegerVariable(const std::string& variable) const
 	{
-		return (integer_variables.find(variable) != integer_variables.end());
+		const Entry* const entry = FindEntry(variable.data(), variable.length());
+		return (entry != nullptr && entry->is_integer == true);
 	}
 
 
 
+	// See method declaration for details.
+	const bool SettingsFile::IsIntegerVariable(const char* const variable) const
+	{
+		const Entry* const entry = FindEntry(variable, strlen(variable));
+		return (entry != nullptr && entry->is_integer == true);
+	}
+
+
 
-	const bool SettingsFile::IsStringVariable(const std::string& variable)
+	// See method declaration for details.
+	const bool SettingsFile::IsStringVariable(const std::string& variable) const
 	{
-		return (string_variables.find(variable) != string_variables.end());
+		const Entry* const entry = FindEntry(variable.data(), variable.length());
+		return (entry != nullptr && entry->is_integer == false);
 	}
 
 
 
+	// See method declaration for details.
+	const bool SettingsFile::IsStringVariable(const char* const variable) const
+	{
+		const Entry* const entry = FindEntry(variable, strlen(variable));
+		return (entry != nullptr && entry->is_integer == false);
+	}
+
+
 
+	// See method declaration for details.
 	const long& SettingsFile::GetIntegerValue(const std::string& variable) const
 	{
-		// If there's no value associated with variable, throw an InvalidArgumentException.
-		IntegerVariableMap::const_iterator i = integer_variables.find(variable);
-		if(i == integer_variables.end())
-		{
-			throw InvalidArgumentException("avl::utility::SettingsFile::GetIntegerValue()", "variable", "The supplied variable is not associated with an integer value. See avl::utility::SettingsFile::IsIntegerValue().");
-		}
-		// Otherwise the variable must exist.
-		else
-		{
-			return i->second;
-		}
+		return GetIntegerValue(variable.c_str());
 	}
 
 
 
-
-	const std::string& SettingsFile::GetStringValue(const std::string& variable) const
+	// See method declaration for details.
+	const long& SettingsFile::GetIntegerValue(const char* const variable) const
 	{
 		// If there's no value associated with variable, throw an InvalidArgumentException.
-		StringVariableMap::const_iterator i = string_variables.find(variable);
-		if(i == string_variables.end())
-		{
-			throw InvalidArgumentException("avl::utility::SettingsFile::GetStringValue()", "variable", "The supplied variable is not associated with a string value. See avl::utility::SettingsFile::IsStringValue().");
-		}
-		// Otherwise the variable must exist.
-		else
+		const Entry* const entry = FindEntry(variable, strlen(variable));
+		if(entry == nullptr || entry->is_integer == false)
 		{
-			return i->second;
+			throw InvalidArgumentException("avl::utility::SettingsFile::GetIntegerValue()", "variable", "The supplied variable is not associated with an integer value. See avl::utility::SettingsFile::IsIntegerValue().");
 		}
+		return entry->integer_value;
 	}
 
 
 
+	// See method declaration for details.
+	const std::string& SettingsFile::GetStringValue(const std::string& variable) const
+	{
+		return GetStringValue(variable.c_str());
+	}
+
 
 
-	void SettingsFile::LoadFileToString(std::ifstream& file, SettingsFile::StringVector& lines, const std::string& file_name)
+	// See method declaration for details.
+	const std::string& SettingsFile::GetStringValue(const char* const variable) const
 	{
-		// First, tell the file not to throw any exceptions.
-		file.exceptions(std::ios_base::goodbit);
-		// Now load each line from the file into a string.
-		while(file.good() == true)
-		{
-			std::string line;
-			std::getline(file, line);
-			lines.push_back(line);
-		}
-		// If an error occurred while reading (other than reaching EOF), then throw a FileReadException.
-		if(file.fail() == true && file.eof() == false)
+		// If there's no value associated with variable, throw an InvalidArgumentException.
+		const Entry* const entry = FindEntry(variable, strlen(variable));
+		if(entry == nullptr || entry->is_integer == true)
 		{
-			file.close();
-			throw FileReadException(file_name);
+			throw InvalidArgumentException("avl::utility::SettingsFile::GetStringValue()", "variable", "The supplied variable is not associated with a string value. See avl::utility::SettingsFile::IsStringValue().");
 		}
+		return string_values[entry->string_index];
 	}
 
 
 
+	// See method declaration for details.
+	const bool SettingsFile::WasLoadedFromCache() const
+	{
+		return loaded_from_cache;
+	}
+
 
 
-	void SettingsFile::LoadSettings(SettingsFile::StringVector& lines, const std::string& file_name)
+	// See method declaration for details.
+	void SettingsFile::Parse(const MappedFile& file)
 	{
-		// The line number.
+		const char* line = file.GetData();
+		const char* const end = line + file.GetSize();
 		unsigned int line_number = 1;
-		// Process each line...
-		StringVector::const_iterator end = lines.end();
-		for(StringVector::const_iterator i = lines.begin(); i != end; ++i)
+		while(line != end)
 		{
-			// Process this line.
-			ProcessLine(*i, file_name, line_number);
-			// Move to the next line.
+			// Each newline ends a line; the text after the last one is the final line.
+			const char* next_line = static_cast<const char*>(memchr(line, '\n', end - line));
+			const char* line_end = (next_line != nullptr) ? next_line : end;
+			next_line = (next_line != nullptr) ? next_line + 1 : end;
+			// Drop the carriage return of a CRLF line ending.
+			if(line_end != line && *(line_end - 1) == '\r')
+			{
+				--line_end;
+			}
+
+			// Skip blank lines and comments.
+			const std::size_t length = line_end - line;
+			if(length == 1 && isspace(static_cast<unsigned char>(line[0])) == 0)
+			{
+				throw SettingsFile::SyntaxError(SettingsFile::SyntaxError::BAD_VARIABLE_NAME, file.GetFileName(), line_number);
+			}
+			if(length >= 2 && (line[0] != '/' || line[1] != '/') && SkipWhitespace(line, line_end) != line_end)
+			{
+				ParseVariable(line, line_end, file.GetFileName(), line_number);
+			}
+
+			line = next_line;
 			++line_number;
 		}
 	}
 
 
 
-
-
-	void SettingsFile::ProcessLine(const std::string& line, const std::string& file_name, const unsigned int& line_number)
+	// See method declaration for details.
+	void SettingsFile::ParseVariable(const char* begin, const char* end, const std::string& file_name, const unsigned int line_number)
 	{
-		// Is the line empty?
-		if(line.empty() == true)
+		ASSERT(end - begin >= 2);
+		// A variable without an equals sign ('=') has no value.
+		const char* const separator = static_cast<const char*>(memchr(begin, '=', end - begin));
+		if(separator == nullptr)
 		{
-			return;
+			throw SettingsFile::SyntaxError(SettingsFile::SyntaxError::BAD_VALUE, file_name, line_number);
 		}
-		// If the line is only 1 character long, then that one character must be whitespace. Otherwise
-		// the line is malformed.
-		if(line.length() == 1)
+
+		// Names may only have visible characters, and may only be defined once.
+		const char* const name = SkipWhitespace(begin, separator);
+		const char* const name_end = TrimWhitespace(name, separator);
+		if(name == name_end)
+		{
+			throw SettingsFile::SyntaxError(SettingsFile::SyntaxError::BAD_VARIABLE_NAME, file_name, line_number);
+		}
+		for(const char* i = name; i != name_end; ++i)
 		{
-			if(isspace(line[0]) == 0)
+			if(isgraph(static_cast<unsigned char>(*i)) == 0)
 			{
 				throw SettingsFile::SyntaxError(SettingsFile::SyntaxError::BAD_VARIABLE_NAME, file_name, line_number);
 			}
 		}
-		// Otherwise there are at least 2 characters.
-		else
+		if(FindEntry(name, name_end - name) != nullptr)
 		{
-			// Is this line a comment?
-			if(line[0] == '/' && line[1] == '/')
-			{
-				return;
-			}
-			// Otherwise this line isn't a comment.
-			else
+			throw SettingsFile::SyntaxError(SettingsFile::SyntaxError::BAD_VARIABLE_NAME, file_name, line_number);
+		}
+
+		// Values may only have printable characters and whitespace characters.
+		const char* const value = SkipWhitespace(separator + 1, end);
+		const char* const value_end = TrimWhitespace(value, end);
+		if(value == value_end)
+		{
+			throw SettingsFile::SyntaxError(SettingsFile::SyntaxError::BAD_VALUE, file_name, line_number);
+		}
+		for(const char* i = value; i != value_end; ++i)
+		{
+			if(isprint(static_cast<unsigned char>(*i)) == 0 && isspace(static_cast<unsigned char>(*i)) == 0)
 			{
-				ProcessVariable(line, file_name, line_number);
+				throw SettingsFile::SyntaxError(SettingsFile::SyntaxError::BAD_VALUE, file_name, line_number);
 			}
 		}
-	}
-
 
+		long integer_value = 0;
+		const bool is_integer = ParseInteger(value, value_end, integer_value);
+		AddVariable(name, name_end - name, is_integer, integer_value, value, value_end - value);
+	}
 
 
 
-	void SettingsFile::ProcessVariable(const std::string& line, const std::string& file_name, const unsigned int& line_number)
+	// See method declaration for details.
+	const bool SettingsFile::LoadCache(const std::string& cache_name, const unsigned long long write_time)
 	{
-		ASSERT(line.length() >= 2);
-		// Looks for an equals sign ('=') on this line.
-		const unsigned int separator = line.find_first_of('=');
-		// Get the raw variable name.
-		std::string name = line.substr(0, separator);
-		// Make sure that the variable name is valid.
-		CheckVariableName(name, file_name, line_number);
-		// If this variable name already exists, then this is a bad variable name.
-		if(integer_variables.find(name) != integer_variables.end() || string_variables.find(name) != string_variables.end())
+		if(FileExists(cache_name) == false)
 		{
-			throw SettingsFile::SyntaxError(SettingsFile::SyntaxError::BAD_VARIABLE_NAME, file_name, line_number);
+			return false;
 		}
-		// This check prevents an std::out_of_range exception. If the separator is the last character
-		// on this line, then the variable's value is malformed.
-		if(separator == line.length() - 1)
+		try
 		{
-			throw SettingsFile::SyntaxError(SettingsFile::SyntaxError::BAD_VALUE, file_name, line_number);
+			return ReadCache(MappedFile(cache_name), write_time);
 		}
-		// Get the raw variable value.
-		std::string value = line.substr(separator + 1, line.npos);
-		// Make sure that the variable value is valid.
-		CheckVariableValue(value, file_name, line_number);
-		// Add the variable name/pair to the map of settings.
-		long integer_value = 0;
-		if(IsIntegerValue(value, integer_value) == true)
+		// The cache may have been removed since it was checked for.
+		catch(const FileNotFoundException&)
 		{
-			// The value is an integer.
-			integer_variables.insert(std::make_pair(name, integer_value));
+			return false;
 		}
-		else
+		catch(const FileReadException&)
 		{
-			// The value is a string.
-			string_variables.insert(std::make_pair(name, value));
+			return false;
 		}
 	}
 
 
 
-	
-	
-
-	void SettingsFile::CheckVariableName(std::string& name, const std::string& file_name, const unsigned int& line_number)
+	// See method declaration for details.
+	const bool SettingsFile::ReadCache(const MappedFile& cache, const unsigned long long write_time)
 	{
-		// Trim any whitespace from the name.
-		PruneWhitespace(name);
-		// Empty names are invalid.
-		if(name.empty() == true)
+		// The header must match, and the settings file mustn't have changed since the cache was made.
+		const char* cursor = cache.GetData();
+		const char* const end = cursor + cache.GetSize();
+		char magic[sizeof(CACHE_MAGIC)];
+		unsigned long long cached_write_time = 0;
+		unsigned int count = 0;
+		if(ReadBytes(cursor, end, magic, sizeof(magic)) == false || memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0
+			|| ReadBytes(cursor, end, &cached_write_time, sizeof(cached_write_time)) == false || cached_write_time != write_time
+			|| ReadBytes(cursor, end, &count, sizeof(count)) == false)
 		{
-			throw SettingsFile::SyntaxError(SettingsFile::SyntaxError::BAD_VARIABLE_NAME, file_name, line_number);
+			return false;
 		}
-		// Go through each character in the name.
-		for(std::string::const_iterator i = name.begin(); i != name.end(); ++i)
+
+		for(unsigned int i = 0; i < count; ++i)
 		{
-			// Names may only have alphanumeric characters.
-			if(isgraph(*i) == 0)
+			char type = 0;
+			unsigned int name_length = 0;
+			const char* name = nullptr;
+			int integer_value = 0;
+			unsigned int string_length = 0;
+			const char* string_value = nullptr;
+			bool is_valid = ReadBytes(cursor, end, &type, sizeof(type)) && ReadBytes(cursor, end, &name_length, sizeof(name_length));
+			if(is_valid == true && name_length != 0 && name_length <= static_cast<std::size_t>(end - cursor))
 			{
-				throw SettingsFile::SyntaxError(SettingsFile::SyntaxError::BAD_VARIABLE_NAME, file_name, line_number);
+				name = cursor;
+				cursor += name_length;
+				if(type == CACHE_INTEGER)
+				{
+					is_valid = ReadBytes(cursor, end, &integer_value, sizeof(integer_value));
+				}
+				else if(type == CACHE_STRING)
+				{
+					is_valid = ReadBytes(cursor, end, &string_length, sizeof(string_length)) && string_length <= static_cast<std::size_t>(end - cursor);
+					string_value = cursor;
+					cursor += (is_valid == true) ? string_length : 0;
+				}
+				else
+				{
+					is_valid = false;
+				}
+			}
+			else
+			{
+				is_valid = false;
+			}
+			if(is_valid == false || AddVariable(name, name_length, type == CACHE_INTEGER, integer_value, string_value, string_length) == false)
+			{
+				Clear();
+				return false;
 			}
 		}
+		return true;
 	}
 
 
 
+	// See method declaration for details.
+	void SettingsFile::SaveCache(const std::string& cache_name, const unsigned long long write_time) const
+	{
+		try
+		{
+			std::vector<char> data;
+			data.reserve(sizeof(CACHE_MAGIC) + sizeof(write_time) + sizeof(variable_count) + names.size() + variable_count * 16);
+			AppendBytes(data, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+			AppendBytes(data, &write_time, sizeof(write_time));
+			AppendBytes(data, &variable_count, sizeof(variable_count));
+			for(std::vector<Entry>::const_iterator i = table.begin(); i != table.end(); ++i)
+			{
+				if(i->name_length == 0)
+				{
+					continue;
+				}
+				data.push_back(i->is_integer == true ? CACHE_INTEGER : CACHE_STRING);
+				AppendBytes(data, &i->name_length, sizeof(i->name_length));
+				AppendBytes(data, names.data() + i->name_offset, i->name_length);
+				if(i->is_integer == true)
+				{
+					const int integer_value = static_cast<int>(i->integer_value);
+					AppendBytes(data, &integer_value, sizeof(integer_value));
+				}
+				else
+				{
+					const std::string& string_value = string_values[i->string_index];
+					const unsigned int string_length = static_cast<unsigned int>(string_value.length());
+					AppendBytes(data, &string_length, sizeof(string_length));
+					AppendBytes(data, string_value.data(), string_length);
+				}
+			}
+			WriteFile(cache_name, data);
+		}
+		// The settings have already been loaded; they'll just be parsed again next time.
+		catch(const Exception&)
+		{
+		}
+		catch(const std::bad_alloc&)
+		{
+		}
+	}
+
 
 
-	void SettingsFile::CheckVariableValue(std::string& value, const std::string& file_name, const unsigned int& line_number)
+	// See method declaration for details.
+	void SettingsFile::Clear()
 	{
-		// Trim any whitespace from the value.
-		PruneWhitespace(value);
-		// Empty values are invalid.
-		if(value.empty() == true)
+		try
 		{
-			throw SettingsFile::SyntaxError(SettingsFile::SyntaxError::BAD_VALUE, file_name, line_number);
+			table.assign(INITIAL_TABLE_SIZE, Entry());
+			names.clear();
+			string_values.clear();
 		}
-		// Go through each character in the name.
-		for(std::string::const_iterator i = value.begin(); i != value.end(); ++i)
+		catch(const std::bad_alloc&)
 		{
-			// Values may only have printable characters and whitespace characters.
-			if(isprint(*i) == 0 && isspace(*i) == 0)
-			{
-				throw SettingsFile::SyntaxError(SettingsFile::SyntaxError::BAD_VALUE, file_name, line_number);
-			}
+			throw OutOfMemoryError();
+		}
+		for(std::vector<Entry>::iterator i = table.begin(); i != table.end(); ++i)
+		{
+			i->name_length = 0;
 		}
+		variable_count = 0;
 	}
 
 
 
+	// See method declaration for details.
+	const bool SettingsFile::AddVariable(const char* const name, const std::size_t name_length, const bool is_integer, const long integer_value, const char* const string_value, const std::size_t string_length)
+	{
+		ASSERT(name_length != 0);
+		if(FindEntry(name, name_length) != nullptr)
+		{
+			return false;
+		}
+		// Keep the table at most half full so that probes stay short.
+		if((variable_count + 1) * 2 > table.size())
+		{
+			GrowTable();
+		}
+
+		Entry entry;
+		entry.hash = HashName(name, name_length);
+		entry.name_offset = static_cast<unsigned int>(names.length());
+		entry.name_length = static_cast<unsigned int>(name_length);
+		entry.is_integer = is_integer;
+		entry.integer_value = is_integer == true ? integer_value : 0;
+		entry.string_index = is_integer == true ? 0 : static_cast<unsigned int>(string_values.size());
+		try
+		{
+			names.append(name, name_length);
+			if(is_integer == false)
+			{
+				string_values.push_back(std::string(string_value, string_length));
+			}
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw OutOfMemoryError();
+		}
+
+		const std::size_t mask = table.size() - 1;
+		std::size_t slot = entry.hash & mask;
+		while(table[slot].name_length != 0)
+		{
+			slot = (slot + 1) & mask;
+		}
+		table[slot] = entry;
+		++variable_count;
+		return true;
+	}
 
 
-	bool SettingsFile::IsIntegerValue(std::string& value, long& integer_value)
+
+	// See method declaration for details.
+	const SettingsFile::Entry* const SettingsFile::FindEntry(const char* const name, const std::size_t name_length) const
 	{
-		// If value contains nothing but '0' characters, then it is the integer value zero.
-		if(value.find_first_not_of('0') == value.npos)
+		if(name_length == 0)
 		{
-			integer_value = 0;
-			return true;
+			return nullptr;
 		}
-		// Otherwise, value is either a non-zero integer or it is not an integer value.
-		else
+		const unsigned int hash = HashName(name, name_length);
+		const std::size_t mask = table.size() - 1;
+		for(std::size_t slot = hash & mask; table[slot].name_length != 0; slot = (slot + 1) & mask)
 		{
-			// Attempt to parse value to an integer.
-			integer_value = atol(value.c_str());
-			// At this point value can't be an integer of 0. If the parsing resulted in
-			// 0, then the parsing failed.
-			if(integer_value != 0)
+			const Entry& entry = table[slot];
+			if(entry.hash == hash && entry.name_length == name_length && memcmp(names.data() + entry.name_offset, name, name_length) == 0)
 			{
-				return true;
+				return &entry;
 			}
 		}
-		return false;
+		return nullptr;
 	}
 
 
 
-
-	void SettingsFile::PruneWhitespace(std::string& bush)
+	// See method declaration for details.
+	void SettingsFile::GrowTable()
 	{
-		// Trim off any whitespace at the beginning or end of the bush.
-		while(bush.empty() == false && isspace(*bush.begin()) != 0)
+		std::vector<Entry> grown;
+		try
 		{
-			bush.erase(bush.begin());
+			grown.resize(table.size() * 2);
 		}
-		while(bush.empty() == false && isspace(*(--bush.end())) != 0)
+		catch(const std::bad_alloc&)
 		{
-			bush.erase(--bush.end());
+			throw OutOfMemoryError();
 		}
+		for(std::vector<Entry>::iterator i = grown.begin(); i != grown.end(); ++i)
+		{
+			i->name_length = 0;
+		}
+		const std::size_t mask = grown.size() - 1;
+		for(std::vector<Entry>::const_iterator i = table.begin(); i != table.end(); ++i)
+		{
+			if(i->name_length == 0)
+			{
+				continue;
+			}
+			std::size_t slot = i->hash & mask;
+			while(grown[slot].name_length != 0)
+			{
+				slot = (slot + 1) & mask;
+			}
+			grown[slot] = *i;
+		}
+		table.swap(grown);
 	}
 
 
 
+	// See method declaration for details.
+	const unsigned int SettingsFile::HashName(const char* const name, const std::size_t name_length)
+	{
+		unsigned int hash = 2166136261u;
+		for(std::size_t i = 0; i < name_length; ++i)
+		{
+			hash ^= static_cast<unsigned char>(name[i]);
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+
 
 	// Takes a SyntaxError::ErrorType as the type of syntax error which occured and
 	// an integer specifying the line on which the error occured.
@@ -408,5 +616,102 @@ namespace utility
 
 
 
-}
-}
\ No newline at end of file
+	// Anonymous namespace.
+	namespace
+	{
+		/** Skips any whitespace at the beginning of a range.
+		@return The first non-whitespace character, or \a end.
+		*/
+		const char* SkipWhitespace(const char* begin, const char* const end)
+		{
+			while(begin != end && isspace(static_cast<unsigned char>(*begin)) != 0)
+			{
+				++begin;
+			}
+			return begin;
+		}
+
+		/** Trims any whitespace off of the end of a range.
+		@return One past the last non-whitespace character, or \a begin.
+		*/
+		const char* TrimWhitespace(const char* const begin, const char* end)
+		{
+			while(end != begin && isspace(static_cast<unsigned char>(*(end - 1))) != 0)
+			{
+				--end;
+			}
+			return end;
+		}
+
+		/** Parses a value the way atol() does: an optional sign followed by digits, stopping
+		at the first character which isn't a digit. A value of nothing but '0' characters is
+		zero; any other value which parses to zero isn't an integer.
+		@return True if the value is an integer.
+		*/
+		const bool ParseInteger(const char* begin, const char* const end, long& integer_value)
+		{
+			bool is_zero = true;
+			for(const char* i = begin; i != end; ++i)
+			{
+				if(*i != '0')
+				{
+					is_zero = false;
+					break;
+				}
+			}
+			if(is_zero == true)
+			{
+				integer_value = 0;
+				return true;
+			}
+
+			bool is_negative = false;
+			if(begin != end && (*begin == '-' || *begin == '+'))
+			{
+				is_negative = (*begin == '-');
+				++begin;
+			}
+			// Accumulate towards the sign so that LONG_MIN can be represented, and saturate.
+			long value = 0;
+			for(; begin != end && *begin >= '0' && *begin <= '9'; ++begin)
+			{
+				const long digit = *begin - '0';
+				if(is_negative == true)
+				{
+					value = (value < (LONG_MIN + digit) / 10) ? LONG_MIN : value * 10 - digit;
+				}
+				else
+				{
+					value = (value > (LONG_MAX - digit) / 10) ? LONG_MAX : value * 10 + digit;
+				}
+			}
+			integer_value = value;
+			return (value != 0);
+		}
+
+		/** Appends \a count bytes to \a data.*/
+		void AppendBytes(std::vector<char>& data, const void* const bytes, const std::size_t count)
+		{
+			const char* const first = static_cast<const char*>(bytes);
+			data.insert(data.end(), first, first + count);
+		}
+
+		/** Reads \a count bytes at \a cursor and advances it.
+		@return False if fewer than \a count bytes remain.
+		*/
+		const bool ReadBytes(const char*& cursor, const char* const end, void* const destination, const std::size_t count)
+		{
+			if(static_cast<std::size_t>(end - cursor) < count)
+			{
+				return false;
+			}
+			memcpy(destination, cursor, count);
+			cursor += count;
+			return true;
+		}
+	}
+
+
+
+} // utility
+} // avl
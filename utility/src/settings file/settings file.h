@@ -22,16 +22,15 @@ along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
 Loads formatted settings data from a text file.
 @author Sheldon Bachstein
 @date Dec 29, 2010
-@todo Rewrite this to make use of the file operations component.
 @todo Add the capability of adding new settings to a settings file.
 */
 
 
 #include"..\exceptions\exceptions.h"
+#include"..\file operations\file operations.h"
 #include<string>
-#include<map>
-#include<fstream>
 #include<vector>
+#include<cstddef>
 
 
 namespace avl
@@ -40,18 +39,27 @@ namespace utility
 {
 
 	/** Parses a text file and loads in variable names and variable values within that text file.
-	@todo Document the syntax and so on.
+	Each line of the file is either blank, a comment beginning with "//", or a variable of the
+	form "name = value". Names may not contain whitespace and may only be defined once. Values
+	which parse to an integer are stored as integers; the rest are stored as strings.
+	@par Caching:
+	A settings file may be loaded with a binary cache, which is written beside the text file
+	as "<file_name>.cache" and used in place of parsing the text whenever the text file hasn't
+	been written to since the cache was made.
 	*/
 	class SettingsFile
 	{
 	public:
 		/** Attempts to open the file \a file_name and read in any formatted data.
 		@param file_name The name of the file to read settings from.
+		@param use_cache Whether to load the settings from, and save them to, a binary cache
+		beside \a file_name. Ignored if \a file_name is opened from a pack file.
+		@throws FileNotFoundException If \a file_name doesn't exist.
 		@throws FileReadException If unable to open or read from \a file_name.
 		@throws SyntaxError If there is a problem with the syntax in \a file_name.
 		@throws OutOfMemoryError If unable to allocate space for a new string value.
 		*/
-		SettingsFile(const std::string& file_name);
+		SettingsFile(const std::string& file_name, const bool use_cache = false);
 
 		/** Basic destructor.*/
 		~SettingsFile();
@@ -61,13 +69,25 @@ namespace utility
 		@param variable The name of the variable to check.
 		@return True if \a variable is a variable name and is mapped to an integer value.
 		*/
-		const bool IsIntegerVariable(const std::string& variable);
+		const bool IsIntegerVariable(const std::string& variable) const;
+
+		/** Checks to see if a variable name exists and stores an integer value.
+		@param variable The null-terminated name of the variable to check.
+		@return True if \a variable is a variable name and is mapped to an integer value.
+		*/
+		const bool IsIntegerVariable(const char* const variable) const;
 
 		/** Checks to see if a variable name exists and stores a string value.
 		@param variable The name of the variable to check.
 		@return True if \a variable is a variable name and is mapped to a string value.
 		*/
-		const bool IsStringVariable(const std::string& variable);
+		const bool IsStringVariable(const std::string& variable) const;
+
+		/** Checks to see if a variable name exists and stores a string value.
+		@param variable The null-terminated name of the variable to check.
+		@return True if \a variable is a variable name and is mapped to a string value.
+		*/
+		const bool IsStringVariable(const char* const variable) const;
 
 		/** Attempts to access an integer setting value.
 		@attention Use \ref IsIntegerVariable() to tell whether or not a variable name is associated
@@ -79,6 +99,14 @@ namespace utility
 		integer value.
 		*/
 		const long& GetIntegerValue(const std::string& variable) const;
+
+		/** Attempts to access an integer setting value without building a string for its name.
+		@param variable The null-terminated name of the variable to access.
+		@return The value associated with the \a variable.
+		@throws InvalidArgumentException If \a variable does not exist or does not have an associated
+		integer value.
+		*/
+		const long& GetIntegerValue(const char* const variable) const;
 		
 		/** Attempts to access a string setting value.
 		@attention Use \ref IsStringVariable() to tell whether or not a variable name is associated
@@ -91,108 +119,125 @@ namespace utility
 		*/
 		const std::string& GetStringValue(const std::string& variable) const;
 
-	private:
-		/** Merely a convenience.*/
-		typedef std::vector<const std::string> StringVector;
-
-		/** Attempts to load the contents in the file \a file to a string.
-		@post Each line of \a file will be pushed onto the back of \a lines as a string.
-		@param file [IN] The file from which to read.
-		@param lines [OUT] A vector which is to contain the contents of \a file separated
-		into strings for each line.
-		@param file_name The name of the file which is to be read.
-		@return The contents of \a file separated into strings for each line.
-		@throws FileWriteException If unable to load the data from \a file.
-		*/
-		void LoadFileToString(std::ifstream& file, StringVector& lines, const std::string& file_name);
-
-		/** Attempts to parse \a lines into a series of variable name/value pairs and add them
-		to \ref integer_variables and \ref string_variables.
-		@pre \a lines obeys the rules of syntax described in \ref avl::utility::SettingsFile.
-		@param lines The lines from which the settings are to be loaded. Each string should
-		contain a full line from the settings file.
-		@param file_name The name of the settings file.
-		@throws SyntaxError If there is a syntactical error in \a lines.
+		/** Attempts to access a string setting value without building a string for its name.
+		@param variable The null-terminated name of the variable to access.
+		@return The value associated with the \a variable.
+		@throws InvalidArgumentException If \a variable does not exist or does not have an associated
+		string value.
 		*/
-		void LoadSettings(StringVector& lines, const std::string& file_name);
+		const std::string& GetStringValue(const char* const variable) const;
 
-		/** Parses a single line of text data to determine if it is a comment, blank line, or
-		a substantial line. If it's a substantial line, then we will attempt to parse it into
-		a variable name/value pair.
-		@pre \a line obeys the syntactical rules laid out in \ref avl::utility::SettingsFile.
-		@param line The line to be processed.
-		@param file_name The name of the settings file.
-		@param line_number The number of the line currently being parsed. Used to report which line
-		syntax errors occur on.
-		@throws SyntaxError If there is a syntactical error in the specified line of text
-		data.
+		/** Checks whether the settings were loaded from the binary cache rather than parsed.
+		@return True if the cache was used.
 		*/
-		void ProcessLine(const std::string& line, const std::string& file_name, const unsigned int& line_number);
+		const bool WasLoadedFromCache() const;
 
+	private:
+		/** A slot in the variable table. Names are stored in \ref names, and string values
+		in \ref string_values.*/
+		struct Entry
+		{
+			/// The hash of the name.
+			unsigned int hash;
+			/// Where the name begins in \ref names.
+			unsigned int name_offset;
+			/// The length of the name, or zero if the slot is empty.
+			unsigned int name_length;
+			/// Whether the value is an integer or a string.
+			bool is_integer;
+			/// The value, if it's an integer.
+			long integer_value;
+			/// The index of the value in \ref string_values, if it's a string.
+			unsigned int string_index;
+		};
 
-		/** Attempts to parse a non-comment, non-blank line into a variable name/value pair and add
-		it to either \ref integer_variables or \ref string_variables
-		@pre \a line obeys the syntactical rules laid out in \ref avl::utility::SettingsFile, and is
-		neither a blank line (whitespace not considered substantial) or a comment.
-		@param line The line to be processed.
-		@param file_name The name of the settings file.
-		@param line_number The number of the line currently being parsed. Used to report which line
-		syntax errors occur on.
-		@throws SyntaxError If there is a syntactical error in the specified line of text data.
+		/** Parses the contents of a settings file in a single pass.
+		@param file The contents of the settings file.
+		@throws SyntaxError If there is a syntactical error in \a file.
+		@throws OutOfMemoryError If we run out of memory.
 		*/
-		void ProcessVariable(const std::string& line, const std::string& file_name, const unsigned int& line_number);
-
+		void Parse(const MappedFile& file);
 
-		/** Checks to see if \a name is a valid variable name. Additionally, trims any
-		whitespace off the beginning and end of \a name.
-		@param name The variable name being checked.
+		/** Parses a single non-blank, non-comment line into a variable and adds it.
+		@param begin The first character of the line.
+		@param end One past the last character of the line, excluding the line terminator.
 		@param file_name The name of the settings file.
-		@param line_number The line in the settings file on which this name occurs.
-		@throws SyntaxError If \a name is not a valid variable name.
+		@param line_number The number of the line being parsed.
+		@throws SyntaxError If there is a syntactical error in the line.
+		@throws OutOfMemoryError If we run out of memory.
 		*/
-		static void CheckVariableName(std::string& name, const std::string& file_name, const unsigned int& line_number);
+		void ParseVariable(const char* begin, const char* end, const std::string& file_name, const unsigned int line_number);
 
-
-		/** Checks to see if \a value is a valid variable value. Additionally, trims any
-		whitespace off the beginning and end of \a value.
-		@param value The variable value being checked.
-		@param file_name The name of the settings file.
-		@param line_number The line in the settings file on which this value occurs.
-		@throws SyntaxError If \a value is not a valid variable value.
+		/** Attempts to load the settings from the cache file \a cache_name.
+		@param cache_name The name of the cache file.
+		@param write_time When the settings file was last written to.
+		@return True if the cache was valid and loaded; false if the settings must be parsed.
+		@throws OutOfMemoryError If we run out of memory.
 		*/
-		static void CheckVariableValue(std::string& value, const std::string& file_name, const unsigned int& line_number);
+		const bool LoadCache(const std::string& cache_name, const unsigned long long write_time);
 
-
-		/** Checks to see if \a value can be parsed to an integer value, and if so
-		stores the parsed integer in \a integer_value.
-		@param value [IN] The string which is being checked.
-		@param integer_value [OUT] The parsed integer value of \a value, if \a value
-		can be parsed to an integer.
-		@return True if \a value may be parsed to an integer value, and false if not.
+		/** Loads the settings from the contents of a cache file.
+		@param cache The contents of the cache file.
+		@param write_time When the settings file was last written to.
+		@return True if the cache was valid and loaded; false if the settings must be parsed.
+		@throws OutOfMemoryError If we run out of memory.
 		*/
-		static bool IsIntegerValue(std::string& value, long& integer_value);
-
+		const bool ReadCache(const MappedFile& cache, const unsigned long long write_time);
 
-		/** Prunes any whitespace off of the beginning and end of \a bush.
-		@param bush The string to be pruned.
+		/** Attempts to save the settings to the cache file \a cache_name. Failure to write the
+		cache is ignored, since the settings can always be parsed again.
+		@param cache_name The name of the cache file.
+		@param write_time When the settings file was last written to.
 		*/
-		static void PruneWhitespace(std::string& bush);
-
+		void SaveCache(const std::string& cache_name, const unsigned long long write_time) const;
 
-		// Forward declaration.
-		class SettingValue;
-
-		/// The structure in which string variables are stored.
-		typedef std::map<const std::string, const std::string> StringVariableMap;
+		/** Empties the table, e.g. after a corrupt cache has been partially loaded.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		void Clear();
+
+		/** Adds a variable to the table.
+		@param name The first character of the name.
+		@param name_length The length of the name.
+		@param is_integer Whether the value is an integer.
+		@param integer_value The value, if it's an integer.
+		@param string_value The first character of the value, if it's a string.
+		@param string_length The length of the value, if it's a string.
+		@return False if a variable named \a name already exists.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		const bool AddVariable(const char* const name, const std::size_t name_length, const bool is_integer, const long integer_value, const char* const string_value, const std::size_t string_length);
 
-		/// Contains all string variables.
-		StringVariableMap string_variables;
+		/** Finds the slot of the variable named \a name.
+		@param name The first character of the name.
+		@param name_length The length of the name.
+		@return The variable's slot, or null if there's no such variable.
+		*/
+		const Entry* const FindEntry(const char* const name, const std::size_t name_length) const;
 
-		/// The structure in which integer variables are stored.
-		typedef std::map<const std::string, const long> IntegerVariableMap;
+		/** Doubles the size of the table and reinserts every variable.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		void GrowTable();
 
-		/// Contains all integer variables.
-		IntegerVariableMap integer_variables;
+		/** Hashes a variable name.
+		@param name The first character of the name.
+		@param name_length The length of the name.
+		@return The FNV-1a hash of the name.
+		*/
+		static const unsigned int HashName(const char* const name, const std::size_t name_length);
+
+		/// The variable table, using open addressing with linear probing. Its size is always
+		/// a power of two, and it's kept no more than half full.
+		std::vector<Entry> table;
+		/// The number of variables in the table.
+		unsigned int variable_count;
+		/// Every variable name, stored back to back.
+		std::string names;
+		/// The string values.
+		std::vector<std::string> string_values;
+		/// Whether the settings were loaded from the cache.
+		bool loaded_from_cache;
 
 
 		/// NOT IMPLEMENTED.
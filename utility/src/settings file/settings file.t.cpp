@@ -24,22 +24,64 @@ Unit test for the settings file component. See "settings file.h" for details.
 
 #include"settings file.h"
 #include"..\exceptions\exceptions.h"
+#include"..\file operations\file operations.h"
 #include"..\assert\assert.h"
+#include"..\timer\timer.h"
 #include<iostream>
+#include<sstream>
 #include<string>
 
 void TestSettingsFileComponent()
 {
 	using avl::utility::SettingsFile;
+	using avl::utility::Timer;
 	try
 	{
-		SettingsFile file("Example.txt");
+		SettingsFile file("assets/Example.txt");
 
 		std::cout << file.GetIntegerValue("integer_value_one") << "\n";
 
 		std::cout << file.GetIntegerValue("negative_integer") << "\n";
 
 		std::cout << file.GetStringValue("string_variable") << "\n";
+
+		const std::string name = "integer_value_one";
+		ASSERT(file.IsIntegerVariable(name) == true && file.IsStringVariable(name) == false);
+		ASSERT(file.IsStringVariable("string_variable") == true && file.IsIntegerVariable("missing") == false);
+
+		// Generate a large settings file, then compare parsing it with loading its cache.
+		const std::string file_name = "settings benchmark.txt";
+		std::stringstream text;
+		for(unsigned int i = 0; i < 5000; ++i)
+		{
+			text << "integer_" << i << " = " << i + 1 << "\r\n";
+			text << "string_" << i << " = value number " << i << "\r\n";
+		}
+		avl::utility::WriteFile(file_name, text.str());
+
+		const unsigned int loads = 20;
+		Timer parse_timer;
+		for(unsigned int i = 0; i < loads; ++i)
+		{
+			SettingsFile parsed(file_name);
+		}
+		const double parse_time = parse_timer.Elapsed();
+
+		// The first load writes the cache.
+		SettingsFile cached(file_name, true);
+		Timer cache_timer;
+		for(unsigned int i = 0; i < loads; ++i)
+		{
+			SettingsFile reloaded(file_name, true);
+			ASSERT(reloaded.WasLoadedFromCache() == true);
+		}
+		const double cache_time = cache_timer.Elapsed();
+		SettingsFile reloaded(file_name, true);
+		ASSERT(reloaded.GetIntegerValue("integer_4999") == 5000);
+		ASSERT(reloaded.GetStringValue("string_17") == "value number 17");
+
+		std::cout << "Parsed " << loads << " times in " << parse_time * 1000.0 << " ms.\n";
+		std::cout << "Loaded from the cache " << loads << " times in " << cache_time * 1000.0 << " ms.\n";
 	}
 	catch (const avl::utility::Exception& error)
 	{
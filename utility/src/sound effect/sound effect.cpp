@@ -28,15 +28,20 @@ namespace avl
 {
 namespace utility
 {
+	// See method declaration for details.
+	SoundEffectListener::~SoundEffectListener()
+	{
+	}
+
 	// See method declaration for details.
 	SoundEffect::SoundEffect()
-		: sound_handle(0), volume(1.0f), is_playing(false), is_looping(false), reset(false)
+		: sound_handle(0), volume(1.0f), priority(0), is_positional(false), bus(MASTER_BUS), is_playing(false), is_looping(false), reset(false), engine_slot(NO_ENGINE_SLOT), listener(nullptr)
 	{
 	}
 
 	// See method declaration for details.
 	SoundEffect::SoundEffect(const SoundEffect::SoundHandle handle)
-		: sound_handle(handle), volume(1.0f), is_playing(false), is_looping(false), reset(false)
+		: sound_handle(handle), volume(1.0f), priority(0), is_positional(false), bus(MASTER_BUS), is_playing(false), is_looping(false), reset(false), engine_slot(NO_ENGINE_SLOT), listener(nullptr)
 	{
 	}
 
@@ -49,6 +54,7 @@ namespace utility
 	void SoundEffect::SetSoundHandle(const SoundEffect::SoundHandle new_handle)
 	{
 		sound_handle = new_handle;
+		NotifyListener();
 	}
 		
 	// See method declaration for details.	
@@ -64,6 +70,37 @@ namespace utility
 		{
 			volume = 1.0f;
 		}
+		NotifyListener();
+	}
+		
+	// See method declaration for details.
+	void SoundEffect::SetPriority(const unsigned int new_priority)
+	{
+		priority = new_priority;
+		NotifyListener();
+	}
+
+	// See method declaration for details.
+	void SoundEffect::SetPosition(const Vector& new_position)
+	{
+		position = new_position;
+		is_positional = true;
+		NotifyListener();
+	}
+
+	// See method declaration for details.
+	void SoundEffect::ClearPosition()
+	{
+		position = Vector::ZeroVector;
+		is_positional = false;
+		NotifyListener();
+	}
+
+	// See method declaration for details.
+	void SoundEffect::SetBus(const unsigned int new_bus)
+	{
+		bus = new_bus;
+		NotifyListener();
 	}
 		
 	// See method declaration for details.	
@@ -77,12 +114,14 @@ namespace utility
 		{
 			is_playing = true;
 		}
+		NotifyListener();
 	}
 		
 	// See method declaration for details.	
 	void SoundEffect::Pause()
 	{
 		is_playing = false;
+		NotifyListener();
 	}
 		
 	// See method declaration for details.	
@@ -90,12 +129,14 @@ namespace utility
 	{
 		is_playing = false;
 		reset = true;
+		NotifyListener();
 	}
 
 	// See method declaration for details.
 	void SoundEffect::Loop(const bool loop)
 	{
 		is_looping = loop;
+		NotifyListener();
 	}
 
 	// See method declaration for details.	
@@ -116,6 +157,30 @@ namespace utility
 		return volume;
 	}
 
+	// See method declaration for details.
+	const unsigned int SoundEffect::GetPriority() const
+	{
+		return priority;
+	}
+
+	// See method declaration for details.
+	const Vector& SoundEffect::GetPosition() const
+	{
+		return position;
+	}
+
+	// See method declaration for details.
+	const bool SoundEffect::IsPositional() const
+	{
+		return is_positional;
+	}
+
+	// See method declaration for details.
+	const unsigned int SoundEffect::GetBus() const
+	{
+		return bus;
+	}
+
 	// See method declaration for details.
 	const bool SoundEffect::IsPlaying() const
 	{
@@ -134,6 +199,39 @@ namespace utility
 		return reset;
 	}
 
+	// See method declaration for details.
+	void SoundEffect::SetEngineSlot(const unsigned int slot)
+	{
+		engine_slot = slot;
+	}
+
+	// See method declaration for details.
+	const unsigned int SoundEffect::GetEngineSlot() const
+	{
+		return engine_slot;
+	}
+
+	// See method declaration for details.
+	void SoundEffect::SetListener(SoundEffectListener* const new_listener)
+	{
+		listener = new_listener;
+	}
+
+	// See method declaration for details.
+	SoundEffectListener* const SoundEffect::GetListener() const
+	{
+		return listener;
+	}
+
+	// See method declaration for details.
+	void SoundEffect::NotifyListener()
+	{
+		if(listener != nullptr)
+		{
+			listener->OnSoundEffectChanged(*this);
+		}
+	}
+
 
 
 
@@ -25,6 +25,7 @@ Defines the \ref avl::utility::SoundEffect class and its associated
 @date Jun 17, 2012
 */
 
+#include"..\vector\vector.h"
 #include<list>
 
 namespace avl
@@ -34,6 +35,24 @@ namespace utility
 	// Forward declaration.
 	class SoundEffect;
 
+	/**
+	Is told about each change made to the sound effects which it listens to, as the change
+	is made, rather than when the sound effects are next updated.
+	*/
+	class SoundEffectListener
+	{
+	public:
+		/** Basic destructor.
+		*/
+		virtual ~SoundEffectListener();
+
+		/** Called after \a effect has been changed by any of SetSoundHandle(), SetVolume(),
+		SetPriority(), SetPosition(), ClearPosition(), SetBus(), Play(), Pause(), Stop(), or Loop().
+		@param effect The sound effect which changed.
+		*/
+		virtual void OnSoundEffectChanged(SoundEffect& effect) = 0;
+	};
+
 	/** Used for storing multiple SoundEffect objects in a light, mergeable, and
 	sortable container. Intended to be used to send a collection of SoundEffect
 	objects to a sound core.
@@ -51,15 +70,21 @@ namespace utility
 		*/
 		typedef unsigned int SoundHandle;
 
+		/// The engine slot of a sound effect which no sound engine has a slot for.
+		static const unsigned int NO_ENGINE_SLOT = 0xFFFFFFFF;
+		/// The bus which sound effects are mixed into unless told otherwise.
+		static const unsigned int MASTER_BUS = 0;
+
 		/** Basic constructor.
 		@post \ref sound_handle is initialized to 0, the new effect will be paused,
-		unlooping, and have a volume of 1.0f.
+		unlooping, non-positional, and have a volume of 1.0f and a priority of 0, and be
+		mixed into \ref MASTER_BUS.
 		*/
 		SoundEffect();
 
 		/** Basic constructor.
-		@post The newly constructor effect will be paused, unlooping, and have
-		a volume of 1.0f.
+		@post The newly constructor effect will be paused, unlooping, non-positional, and
+		have a volume of 1.0f and a priority of 0, and be mixed into \ref MASTER_BUS.
 		@param handle The sound which this object represents.
 		*/
 		SoundEffect(const SoundHandle handle);
@@ -80,6 +105,31 @@ namespace utility
 		*/
 		void SetVolume(const float& new_volume);
 		
+		/** Sets the priority for this sound effect. When a sound engine runs out
+		of voices, the sounds with the lowest priorities are the first to be cut off.
+		@param new_priority The new priority. Higher values are more important.
+		*/
+		void SetPriority(const unsigned int new_priority);
+
+		/** Places this sound effect in the world, making it positional: the sound engine
+		attenuates it by its distance from the engine's listener, and pans it to the side
+		which it's on (see avl::sound::SoundEngine::SetListenerPosition()).
+		@param new_position The position, in the same units as the listener's.
+		*/
+		void SetPosition(const Vector& new_position);
+
+		/** Makes this sound effect non-positional again, so that it's heard at its volume
+		alone, wherever the listener is.
+		*/
+		void ClearPosition();
+
+		/** Chooses the bus which this sound effect is mixed into, so that it's processed by
+		that bus's effects (see avl::sound::SoftwareSoundEngine::AddBusEffect()). Engines
+		which don't process buses mix every sound effect alike.
+		@param new_bus The index of the bus.
+		*/
+		void SetBus(const unsigned int new_bus);
+
 		/** Plays this sound effect, or resets it if it's already playing.
 		@note If left alone by the user, this property will remain set until
 		the sound has finished playing and the sound engine updates the
@@ -122,6 +172,27 @@ namespace utility
 		*/
 		const float GetVolume()const ;
 
+		/** Returns the priority for this sound effect.
+		@return The priority of this sound. Higher values are more important.
+		*/
+		const unsigned int GetPriority() const;
+
+		/** Returns the position of this sound effect.
+		@return The position last set by SetPosition(), or the zero vector if there isn't one.
+		*/
+		const Vector& GetPosition() const;
+
+		/** Is this sound effect positional?
+		@return True if SetPosition() has been called since the effect was constructed or
+		ClearPosition() was last called.
+		*/
+		const bool IsPositional() const;
+
+		/** Returns the bus which this sound effect is mixed into.
+		@return The index of the bus.
+		*/
+		const unsigned int GetBus() const;
+
 		/** Is this sound currently playing?
 		@return True if this sound is unpaused, and false if it's paused.
 		*/
@@ -138,18 +209,58 @@ namespace utility
 		*/
 		const bool IsReset() const;
 
+		/** Remembers where the sound engine which updates this sound effect keeps its state
+		for it, so that the engine needn't look it up. Only sound engines should call this, and
+		a sound effect should only be updated by one engine.
+		@param slot The index of the engine's slot for this sound effect.
+		*/
+		void SetEngineSlot(const unsigned int slot);
+
+		/** Returns the index of the sound engine's slot for this sound effect. Copies of a
+		sound effect share the index, so engines must check that the slot is this effect's.
+		@return The index set by SetEngineSlot(), or \ref NO_ENGINE_SLOT if none has been.
+		*/
+		const unsigned int GetEngineSlot() const;
+
+		/** Sets the listener which is told about each change to this sound effect. Copies
+		of this sound effect share the listener.
+		@param new_listener The listener, or nullptr for none. It must outlive this
+		sound effect, or be replaced first.
+		*/
+		void SetListener(SoundEffectListener* const new_listener);
+
+		/** Returns the listener which is told about each change to this sound effect.
+		@return The listener, or nullptr if there isn't one.
+		*/
+		SoundEffectListener* const GetListener() const;
+
 	private:
+		/** Tells the listener, if there is one, that this sound effect has changed.
+		*/
+		void NotifyListener();
 
 		/// The handle to the sound which is represented by this object.
 		SoundHandle sound_handle;
 		/// The volume of this sound effect, ranging from 0.0 to 1.0.
 		float volume;
+		/// The priority of this sound effect when voices run out.
+		unsigned int priority;
+		/// Where this sound effect is, if it's positional.
+		Vector position;
+		/// Is this sound effect attenuated and panned by its position?
+		bool is_positional;
+		/// The bus which this sound effect is mixed into.
+		unsigned int bus;
 		/// Is this sound effect currently playing?
 		bool is_playing;
 		/// Is this sound effect currently looping?
 		bool is_looping;
 		/// Does this sound effect need to be reset to the beginning?
 		bool reset;
+		/// Where the sound engine keeps its state for this sound effect.
+		unsigned int engine_slot;
+		/// Is told about each change to this sound effect.
+		SoundEffectListener* listener;
 
 	};
 
@@ -25,11 +25,19 @@ Includes the core components of the utility subsystem.
 */
 
 #include"assert\assert.h"
+#include"asset loader\asset loader.h"
+#include"async log file\async log file.h"
+#include"content hash\content hash.h"
 #include"exceptions\exceptions.h"
 #include"file operations\file operations.h"
+#include"inflate\inflate.h"
+#include"input buffer\input buffer.h"
 #include"input events\input events.h"
 #include"key codes\key codes.h"
+#include"lock free queue\lock free queue.h"
 #include"log file\log file.h"
+#include"lz codec\lz codec.h"
+#include"pack file\pack file.h"
 #include"quad\quad.h"
 #include"settings file\settings file.h"
 #include"sound effect\sound effect.h"
@@ -24,11 +24,16 @@ Implementation for the basic d3d renderer component. See "basic d3d renderer.h"
 #include"basic d3d renderer.h"
 #include"..\d3d wrapper\d3d wrapper.h"
 #include"..\image\image.h"
+#include"..\block compression\block compression.h"
 #include"..\..\..\utility\src\exceptions\exceptions.h"
 #include"..\..\..\utility\src\assert\assert.h"
 #include"..\..\..\utility\src\graphic\graphic.h"
 #include"..\..\..\utility\src\vector\vector.h"
+#include"..\..\..\utility\src\content hash\content hash.h"
+#include"..\..\..\utility\src\timer\timer.h"
+#include"..\..\..\utility\src\file operations\file operations.h"
 #include<new>
+#include<memory>
 // Makes d3d9 activate additional debug information and checking.
 #ifdef _DEBUG
 #define D3D_DEBUG_INFO
@@ -41,10 +46,18 @@ namespace avl
 {
 namespace view
 {
+	// Anonymous namespace.
+	namespace
+	{
+		const unsigned long long HashImage(const Image& image);
+	}
+
+
 
 	// See method declaration for details.
 	BasicD3DRenderer::BasicD3DRenderer(HWND window_handle, const d3d::D3DDisplayProfile& profile, const avl::utility::Vector& screen_space)
-		: Renderer(screen_space), display_profile(profile), vertex_format(D3DFVF_XYZ | D3DFVF_TEX1), bytes_per_pixel(4), next_texture_handle(1),
+		: Renderer(screen_space), display_profile(profile), vertex_format(D3DFVF_XYZ | D3DFVF_TEX1), bytes_per_pixel(4), next_texture_handle(1), is_dxt1_supported(false), is_dxt5_supported(false),
+		placeholder_texture(nullptr), upload_budget(4 * 1024 * 1024), shared_texture_count(0), shared_texture_size(0), hashed_size(0.0), hash_time(0.0),
 		buffer_length(1000), d3d(nullptr), device(nullptr), textured_vertex_buffer(nullptr), colored_vertex_buffer(nullptr), index_buffer(nullptr), is_device_ready(false)
 	{
 		try
@@ -57,6 +70,22 @@ namespace view
 			ASSERT(device != nullptr);
 			// Create the viewport for the device.
 			d3d::CreateViewport(*device, display_profile.GetWidth(), display_profile.GetHeight());
+			// Find out which block-compressed texture formats the device can sample.
+			D3DFORMAT adapter_format = display_profile.GetDisplayFormat();
+			D3DFORMAT dxt1_format = D3DFMT_DXT1;
+			D3DFORMAT dxt5_format = D3DFMT_DXT5;
+			is_dxt1_supported = d3d::IsTextureFormatOk(*d3d, adapter_format, dxt1_format);
+			is_dxt5_supported = d3d::IsTextureFormatOk(*d3d, adapter_format, dxt5_format);
+			// Textures added asynchronously show a transparent pixel until they're loaded.
+			const unsigned char transparent_pixel[4] = {0, 0, 0, 0};
+			placeholder_texture = d3d::CreateTexture(*device, 1, 1, D3DFMT_A8R8G8B8);
+			d3d::CopyPixelDataToTexture(*placeholder_texture, transparent_pixel, 1, 1, 4);
+			// Evicted textures are bound to the same placeholder until they're drawn again.
+			residency.reset(new(std::nothrow) d3d::TextureResidency(textures, *placeholder_texture, *this));
+			if(residency == nullptr)
+			{
+				throw utility::OutOfMemoryError();
+			}
 			// Set the scaling for the device to normalize the vertice x and y coordinates.
 			d3d::SetScreenScaling(*device, 1.0f / screen_space_resolution.GetX(), 1.0f / screen_space_resolution.GetY());
 			// Now attempt to ready the device for rendering.
@@ -79,7 +108,7 @@ namespace view
 
 
 	// See method declaration for details.
-	const utility::TexturedQuad::TextureHandle BasicD3DRenderer::AddTexture(const view::Image& image)
+	const utility::TexturedQuad::TextureHandle BasicD3DRenderer::AddTexture(const view::Image& image, const std::string& source)
 	{
 		ASSERT(image.GetPixelData() != nullptr);
 		ASSERT(image.GetWidth() > 0);
@@ -89,31 +118,53 @@ namespace view
 		// This function currently only supports 32-bit textures. Make sure that this image has a 4-byte
 		// pixel depth.
 		ASSERT(image.GetPixelDepth() == 4);
-		// Load the user's pixel data into a new texture.
-		IDirect3DTexture9* texture = d3d::CreateTexture(*device, image.GetWidth(), image.GetHeight(), D3DFMT_A8R8G8B8);
-		d3d::CopyPixelDataToTexture(*texture, image.GetPixelData(), image.GetWidth(), image.GetHeight(), image.GetPixelDepth());
-
-		// Is there a texture handle that we can reuse?
-		utility::TexturedQuad::TextureHandle texture_handle;
-		if(reusable_texture_handles.empty() == false)
+		// Share the texture of an identical image if there is one.
+		const utility::Timer timer;
+		const unsigned long long content_hash = HashImage(image);
+		hash_time += timer.Elapsed();
+		hashed_size += static_cast<double>(image.GetDataSize());
+		// The hash is confirmed against each texture which has it, so that a collision can't share
+		// another image's texture. An evicted texture is bound to the placeholder, so it can't be.
+		const auto candidates = content_hashes.equal_range(content_hash);
+		for(auto shared = candidates.first; shared != candidates.second; ++shared)
 		{
-			texture_handle = reusable_texture_handles.front();
-			reusable_texture_handles.pop();
-		}
-		else
-		{
-			texture_handle = next_texture_handle;
-			++next_texture_handle;
+			auto context = textures.find(shared->second);
+			ASSERT(context != textures.end());
+			if(context->second.is_resident == false || context->second.is_translucent != image.IsTranslucent()
+				|| IsTextureOfImage(*context->second.texture, image) == false)
+			{
+				continue;
+			}
+			++context->second.reference_count;
+			++shared_texture_count;
+			shared_texture_size += context->second.size;
+			// A source lets the texture be evicted, whichever reference it came with.
+			if(context->second.source.empty() == true)
+			{
+				context->second.source = source;
+			}
+			return shared->second;
 		}
+
+		std::size_t size = 0;
+		IDirect3DTexture9* const texture = CreateTextureFromImage(image, size);
+		const utility::TexturedQuad::TextureHandle texture_handle = IssueTextureHandle();
 		// Map the new texture handle to this texture.
 		try
 		{
 			d3d::TextureContext new_texture(*texture, image.IsTranslucent());
+			new_texture.size = size;
+			new_texture.source = source;
+			new_texture.generate_mipmaps = (image.GetLevelCount() > 1);
+			new_texture.content_hash = content_hash;
 			auto result2 = textures.insert(d3d::TexHandleToTexContext::value_type(texture_handle, new_texture));
 			ASSERT(result2.second == true);
+			content_hashes.insert(std::make_pair(content_hash, texture_handle));
 		}
 		catch(const std::bad_alloc&)
 		{
+			textures.erase(texture_handle);
+			texture->Release();
 			throw utility::OutOfMemoryError();
 		}
 		// Return the handle used for this texture.
@@ -121,6 +172,126 @@ namespace view
 	}
 
 
+	// See method declaration for details.
+	const utility::TexturedQuad::TextureHandle BasicD3DRenderer::AddTextureAsync(const std::string& file_name, utility::AssetLoader& loader,
+		const utility::AssetJob::Priority priority, const bool generate_mipmaps)
+	{
+		ASSERT(placeholder_texture != nullptr);
+		const utility::TexturedQuad::TextureHandle texture_handle = IssueTextureHandle();
+		try
+		{
+			const std::shared_ptr<StreamedTextureJob> job(new StreamedTextureJob(file_name, *this, texture_handle, priority, generate_mipmaps));
+			// Bind the placeholder until the image is uploaded.
+			textures.insert(d3d::TexHandleToTexContext::value_type(texture_handle, d3d::TextureContext(*placeholder_texture, false)));
+			placeholder_texture->AddRef();
+			streaming_textures[texture_handle] = job;
+			loader.Submit(job);
+		}
+		catch(const std::bad_alloc&)
+		{
+			// Unbind the placeholder if it was bound.
+			if(textures.find(texture_handle) != textures.end())
+			{
+				DeleteTexture(texture_handle);
+			}
+			throw utility::OutOfMemoryError();
+		}
+		catch(...)
+		{
+			if(textures.find(texture_handle) != textures.end())
+			{
+				DeleteTexture(texture_handle);
+			}
+			throw;
+		}
+		return texture_handle;
+	}
+
+
+	// See method declaration for details.
+	const Renderer::TextureState BasicD3DRenderer::GetTextureState(const utility::TexturedQuad::TextureHandle& handle) const
+	{
+		if(textures.find(handle) == textures.end())
+		{
+			return TEXTURE_INVALID;
+		}
+		auto job = streaming_textures.find(handle);
+		if(job == streaming_textures.end())
+		{
+			return TEXTURE_READY;
+		}
+		// Failed jobs are kept until their handles are deleted, so that the failure can be seen.
+		if(job->second->IsDone() == true && (job->second->HasFailed() == true || job->second->HasUploadFailed() == true))
+		{
+			return TEXTURE_FAILED;
+		}
+		return TEXTURE_LOADING;
+	}
+
+
+	// See method declaration for details.
+	const unsigned int BasicD3DRenderer::GetLoadingTextureCount() const
+	{
+		unsigned int count = 0;
+		for(auto i = streaming_textures.begin(); i != streaming_textures.end(); ++i)
+		{
+			if(i->second->IsDone() == false || (i->second->HasFailed() == false && i->second->HasUploadFailed() == false))
+			{
+				++count;
+			}
+		}
+		return count;
+	}
+
+
+	// See method declaration for details.
+	void BasicD3DRenderer::SetTextureUploadBudget(const std::size_t bytes_per_frame)
+	{
+		upload_budget = bytes_per_frame;
+	}
+
+
+	// See method declaration for details.
+	void BasicD3DRenderer::SetTextureMemoryBudget(const std::size_t bytes)
+	{
+		ASSERT(residency != nullptr);
+		residency->SetBudget(bytes);
+	}
+
+
+	// See method declaration for details.
+	const d3d::TextureResidency& BasicD3DRenderer::GetTextureResidency() const
+	{
+		ASSERT(residency != nullptr);
+		return *residency;
+	}
+
+
+	// See method declaration for details.
+	const unsigned int BasicD3DRenderer::GetSharedTextureCount() const
+	{
+		return shared_texture_count;
+	}
+
+
+	// See method declaration for details.
+	const std::size_t BasicD3DRenderer::GetSharedTextureSize() const
+	{
+		return shared_texture_size;
+	}
+
+
+	// See method declaration for details.
+	const double BasicD3DRenderer::GetHashThroughput() const
+	{
+		if(hash_time <= 0.0)
+		{
+			return 0.0;
+		}
+		return hashed_size / hash_time;
+	}
+
+
 	// See method declaration for details.
 	void BasicD3DRenderer::DeleteTexture(const utility::TexturedQuad::TextureHandle& texture_handle)
 	{
@@ -132,10 +303,29 @@ namespace view
 		{
 			return;
 		}
+		// A shared texture stays until its last reference is deleted.
+		if(i->second.reference_count > 1)
+		{
+			--i->second.reference_count;
+			--shared_texture_count;
+			shared_texture_size -= i->second.size;
+			return;
+		}
+		// Forget its hash, unless it was loaded asynchronously and never hashed.
+		const auto candidates = content_hashes.equal_range(i->second.content_hash);
+		for(auto shared = candidates.first; shared != candidates.second; ++shared)
+		{
+			if(shared->second == texture_handle)
+			{
+				content_hashes.erase(shared);
+				break;
+			}
+		}
 		// Release the texture.
-		i->second.texture.Release();
-		// Delete the texture from the map.
+		i->second.texture->Release();
+		// Delete the texture from the map, and forget any image still loading for it.
 		textures.erase(i);
+		streaming_textures.erase(texture_handle);
 		// Save the handle to be reused.
 		try
 		{
@@ -155,10 +345,15 @@ namespace view
 		d3d::TexHandleToTexContext::iterator end = textures.end();
 		for(d3d::TexHandleToTexContext::iterator i = textures.begin(); i != end; ++i)
 		{
-			i->second.texture.Release();
+			i->second.texture->Release();
 		}
-		// Delete all of the textures from the map.
+		// Delete all of the textures from the map, and forget any images still loading.
 		textures.clear();
+		streaming_textures.clear();
+		loaded_textures.clear();
+		content_hashes.clear();
+		shared_texture_count = 0;
+		shared_texture_size = 0;
 		// Reset the texture handles.
 		while(reusable_texture_handles.empty() == false)
 		{
@@ -179,16 +374,317 @@ namespace view
 			ASSERT(textured_vertex_buffer != nullptr);
 			ASSERT(colored_vertex_buffer != nullptr);
 			ASSERT(index_buffer != nullptr);
+			// Swap in any textures which have finished loading.
+			UploadLoadedTextures();
 			// Clear the screen to black.
 			d3d::ClearViewport(*device);
 			// Render sprites.
 			d3d::RenderContext render_context(*device, *index_buffer, *textured_vertex_buffer, *colored_vertex_buffer);
 			device->BeginScene();
-			d3d::GraphicBatch batch(graphics, textures);
+			d3d::GraphicBatch batch(graphics, *residency);
 			batch.Render(render_context);
 			device->EndScene();
 			// Present the scene.
 			device->Present(nullptr, nullptr, nullptr, nullptr);
+			// Evict whichever textures no longer fit in texture memory.
+			residency->EndFrame();
+		}
+	}
+
+
+	// See method declaration for details.
+	BasicD3DRenderer::StreamedTextureJob::StreamedTextureJob(const std::string& file_name, BasicD3DRenderer& renderer, const utility::TexturedQuad::TextureHandle handle,
+		const Priority priority, const bool generate_mipmaps)
+		: AssetJob(priority), file_name(file_name), renderer(renderer), handle(handle), generate_mipmaps(generate_mipmaps), is_loaded(false),
+		has_upload_failed(false)
+	{
+	}
+
+
+	// See method declaration for details.
+	BasicD3DRenderer::StreamedTextureJob::~StreamedTextureJob()
+	{
+	}
+
+
+	// See method declaration for details.
+	const bool BasicD3DRenderer::StreamedTextureJob::IsLoaded() const
+	{
+		return is_loaded;
+	}
+
+
+	// See method declaration for details.
+	const std::string& BasicD3DRenderer::StreamedTextureJob::GetFileName() const
+	{
+		return file_name;
+	}
+
+
+	// See method declaration for details.
+	std::unique_ptr<Image> BasicD3DRenderer::StreamedTextureJob::TakeImage()
+	{
+		ASSERT(is_loaded == true && image != nullptr);
+		is_loaded = false;
+		return std::move(image);
+	}
+
+
+	// See method declaration for details.
+	void BasicD3DRenderer::StreamedTextureJob::FailUpload()
+	{
+		has_upload_failed = true;
+	}
+
+
+	// See method declaration for details.
+	const bool BasicD3DRenderer::StreamedTextureJob::HasUploadFailed() const
+	{
+		return has_upload_failed;
+	}
+
+
+	// See method declaration for details.
+	void BasicD3DRenderer::StreamedTextureJob::Load()
+	{
+		image.reset(new(std::nothrow) Image(file_name));
+		if(image == nullptr)
+		{
+			throw utility::OutOfMemoryError();
+		}
+		// Image reports failure by leaving its pixel data empty.
+		if(image->GetPixelData() == nullptr)
+		{
+			image.reset();
+			throw utility::FileFormatException(file_name);
+		}
+		if(generate_mipmaps == true)
+		{
+			image->GenerateMipmaps();
+		}
+	}
+
+
+	// See method declaration for details.
+	void BasicD3DRenderer::StreamedTextureJob::Finish()
+	{
+		try
+		{
+			renderer.loaded_textures.push_back(handle);
+		}
+		catch(const std::bad_alloc&)
+		{
+			throw utility::OutOfMemoryError();
+		}
+		is_loaded = true;
+	}
+
+
+	// See method declaration for details.
+	const utility::TexturedQuad::TextureHandle BasicD3DRenderer::IssueTextureHandle()
+	{
+		// Is there a texture handle that we can reuse?
+		if(reusable_texture_handles.empty() == false)
+		{
+			const utility::TexturedQuad::TextureHandle texture_handle = reusable_texture_handles.front();
+			reusable_texture_handles.pop();
+			return texture_handle;
+		}
+		return next_texture_handle++;
+	}
+
+
+	// See method declaration for details.
+	IDirect3DTexture9* BasicD3DRenderer::CreateTextureFromImage(const Image& image, std::size_t& size)
+	{
+		// The texture gets every level of the image, one level if it has no mipmaps.
+		const unsigned int level_count = image.GetLevelCount();
+		IDirect3DTexture9* texture = nullptr;
+		size = image.GetDataSize();
+		if(image.IsCompressed() == false)
+		{
+			// Load the user's pixel data into a new texture.
+			texture = d3d::CreateTexture(*device, image.GetWidth(), image.GetHeight(), D3DFMT_A8R8G8B8, level_count);
+			for(unsigned int level = 0; level < level_count; ++level)
+			{
+				d3d::CopyPixelDataToTexture(*texture, image.GetLevelData(level), image.GetLevelWidth(level), image.GetLevelHeight(level), image.GetPixelDepth(), level);
+			}
+		}
+		else if((image.GetBlockFormat() == DXT1 && is_dxt1_supported == true) || (image.GetBlockFormat() == DXT5 && is_dxt5_supported == true))
+		{
+			// Keep the texture compressed; the blocks are laid out just as the device expects them.
+			const bool is_dxt1 = (image.GetBlockFormat() == DXT1);
+			texture = d3d::CreateTexture(*device, image.GetWidth(), image.GetHeight(), (is_dxt1 == true) ? D3DFMT_DXT1 : D3DFMT_DXT5, level_count);
+			for(unsigned int level = 0; level < level_count; ++level)
+			{
+				d3d::CopyBlockDataToTexture(*texture, image.GetLevelData(level), image.GetLevelWidth(level), image.GetLevelHeight(level), (is_dxt1 == true) ? 8 : 16, level);
+			}
+		}
+		else
+		{
+			// The device can't sample this format, so decompress it into a 32-bit texture. The top
+			// level is the largest, so its buffer will hold any of the others.
+			std::unique_ptr<unsigned char[]> pixel_data(new(std::nothrow) unsigned char[static_cast<std::size_t>(image.GetWidth()) * image.GetHeight() * 4]);
+			if(pixel_data == nullptr)
+			{
+				throw utility::OutOfMemoryError();
+			}
+			texture = d3d::CreateTexture(*device, image.GetWidth(), image.GetHeight(), D3DFMT_A8R8G8B8, level_count);
+			size = 0;
+			for(unsigned int level = 0; level < level_count; ++level)
+			{
+				size += static_cast<std::size_t>(image.GetLevelWidth(level)) * image.GetLevelHeight(level) * 4;
+				DecompressBlocks(image.GetLevelData(level), image.GetLevelWidth(level), image.GetLevelHeight(level), image.GetBlockFormat(), pixel_data.get());
+				d3d::CopyPixelDataToTexture(*texture, pixel_data.get(), image.GetLevelWidth(level), image.GetLevelHeight(level), 4, level);
+			}
+		}
+
+		return texture;
+	}
+
+
+	// See method declaration for details.
+	const bool BasicD3DRenderer::IsTextureOfImage(IDirect3DTexture9& texture, const Image& image)
+	{
+		const unsigned int level_count = image.GetLevelCount();
+		D3DSURFACE_DESC description;
+		const HRESULT result = texture.GetLevelDesc(0, &description);
+		if(FAILED(result))
+		{
+			throw d3d::D3DError("IDirect3DTexture9::GetLevelDesc()", "avl::view::BasicD3DRenderer::IsTextureOfImage() -- Unable to describe the texture.", result);
+		}
+		if(texture.GetLevelCount() != level_count || description.Width != image.GetWidth() || description.Height != image.GetHeight())
+		{
+			return false;
+		}
+		// Each level is compared just as CreateTextureFromImage() would have filled it in.
+		if(image.IsCompressed() == false)
+		{
+			if(description.Format != D3DFMT_A8R8G8B8)
+			{
+				return false;
+			}
+			for(unsigned int level = 0; level < level_count; ++level)
+			{
+				if(d3d::IsTextureLevelData(texture, image.GetLevelData(level), image.GetLevelWidth(level) * image.GetPixelDepth(), image.GetLevelHeight(level), level) == false)
+				{
+					return false;
+				}
+			}
+		}
+		else if((image.GetBlockFormat() == DXT1 && is_dxt1_supported == true) || (image.GetBlockFormat() == DXT5 && is_dxt5_supported == true))
+		{
+			const bool is_dxt1 = (image.GetBlockFormat() == DXT1);
+			if(description.Format != ((is_dxt1 == true) ? D3DFMT_DXT1 : D3DFMT_DXT5))
+			{
+				return false;
+			}
+			for(unsigned int level = 0; level < level_count; ++level)
+			{
+				const unsigned int row_size = ((image.GetLevelWidth(level) + 3) / 4) * ((is_dxt1 == true) ? 8 : 16);
+				if(d3d::IsTextureLevelData(texture, image.GetLevelData(level), row_size, (image.GetLevelHeight(level) + 3) / 4, level) == false)
+				{
+					return false;
+				}
+			}
+		}
+		else
+		{
+			if(description.Format != D3DFMT_A8R8G8B8)
+			{
+				return false;
+			}
+			std::unique_ptr<unsigned char[]> pixel_data(new(std::nothrow) unsigned char[static_cast<std::size_t>(image.GetWidth()) * image.GetHeight() * 4]);
+			if(pixel_data == nullptr)
+			{
+				throw utility::OutOfMemoryError();
+			}
+			for(unsigned int level = 0; level < level_count; ++level)
+			{
+				DecompressBlocks(image.GetLevelData(level), image.GetLevelWidth(level), image.GetLevelHeight(level), image.GetBlockFormat(), pixel_data.get());
+				if(d3d::IsTextureLevelData(texture, pixel_data.get(), image.GetLevelWidth(level) * 4, image.GetLevelHeight(level), level) == false)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+
+	// See method declaration for details.
+	IDirect3DTexture9& BasicD3DRenderer::ReloadTexture(const d3d::TextureContext& context, std::size_t& size)
+	{
+		ASSERT(context.source.empty() == false);
+		Image image(context.source);
+		// Image reports failure by leaving its pixel data empty.
+		if(image.GetPixelData() == nullptr)
+		{
+			if(utility::FileExists(context.source) == false)
+			{
+				throw utility::FileNotFoundException(context.source);
+			}
+			throw utility::FileFormatException(context.source);
+		}
+		if(context.generate_mipmaps == true)
+		{
+			image.GenerateMipmaps();
+		}
+		return *CreateTextureFromImage(image, size);
+	}
+
+
+	// See method declaration for details.
+	void BasicD3DRenderer::UploadLoadedTextures()
+	{
+		std::size_t uploaded_size = 0;
+		while(loaded_textures.empty() == false && (upload_budget == 0 || uploaded_size < upload_budget))
+		{
+			const utility::TexturedQuad::TextureHandle texture_handle = loaded_textures.front();
+			loaded_textures.pop_front();
+			// The handle may have been deleted, or even issued again, since its image was loaded.
+			auto job = streaming_textures.find(texture_handle);
+			if(job == streaming_textures.end() || job->second->IsLoaded() == false)
+			{
+				continue;
+			}
+			const std::unique_ptr<Image> image(job->second->TakeImage());
+			uploaded_size += image->GetDataSize();
+			// A texture which can't be created leaves the placeholder bound, and its job is kept so
+			// that the failure can be seen.
+			IDirect3DTexture9* texture = nullptr;
+			std::size_t size = 0;
+			try
+			{
+				texture = CreateTextureFromImage(*image, size);
+			}
+			catch(const utility::Exception&)
+			{
+				job->second->FailUpload();
+				continue;
+			}
+
+			// Swap the texture in for the placeholder. The source is copied first, so that nothing
+			// can fail once the placeholder has been released.
+			auto entry = textures.find(texture_handle);
+			ASSERT(entry != textures.end());
+			d3d::TextureContext& context = entry->second;
+			try
+			{
+				context.source = job->second->GetFileName();
+			}
+			catch(const std::bad_alloc&)
+			{
+				texture->Release();
+				job->second->FailUpload();
+				throw utility::OutOfMemoryError();
+			}
+			context.texture->Release();
+			context.texture = texture;
+			context.is_translucent = image->IsTranslucent();
+			context.size = size;
+			context.generate_mipmaps = (image->GetLevelCount() > 1);
+			streaming_textures.erase(job);
 		}
 	}
 
@@ -262,6 +758,10 @@ namespace view
 		device->SetRenderState(D3DRS_DESTBLEND, D3DBLEND_INVSRCALPHA);
 		// Set the alpha blending operation to addition.
 		device->SetRenderState(D3DRS_BLENDOP, D3DBLENDOP_ADD);
+		// Blend between mip levels when a texture is drawn smaller than its size. Magnified textures
+		// keep point sampling so that pixel art stays sharp.
+		device->SetSamplerState(0, D3DSAMP_MINFILTER, D3DTEXF_LINEAR);
+		device->SetSamplerState(0, D3DSAMP_MIPFILTER, D3DTEXF_LINEAR);
 	}
 
 
@@ -270,6 +770,12 @@ namespace view
 	{
 		// Release all textures.
 		ClearTextures();
+		residency.reset();
+		if(placeholder_texture != nullptr)
+		{
+			placeholder_texture->Release();
+			placeholder_texture = nullptr;
+		}
 		// Release all unmanaged assets.
 		ReleaseUnmanagedAssets();
 		// Release all Direct3D interfaces.
@@ -344,5 +850,30 @@ namespace view
 
 
 
+	// Anonymous namespace.
+	namespace
+	{
+		/** Hashes an image's dimensions, format, and the data of each of its levels.
+		@param image The image to hash.
+		@return The hash.
+		*/
+		const unsigned long long HashImage(const Image& image)
+		{
+			const unsigned int description[] =
+			{
+				image.GetWidth(), image.GetHeight(), image.GetPixelDepth(), image.GetLevelCount(),
+				(image.IsCompressed() == true) ? static_cast<unsigned int>(image.GetBlockFormat()) + 1 : 0
+			};
+			unsigned long long hash = utility::HashContent(description, sizeof(description));
+			for(unsigned int level = 0; level < image.GetLevelCount(); ++level)
+			{
+				hash = utility::HashContent(image.GetLevelData(level), image.GetLevelDataSize(level), hash);
+			}
+			return hash;
+		}
+	}
+
+
+
 }
 }
\ No newline at end of file
@@ -28,9 +28,16 @@ profile which will render to the entire window and set the viewport appropriatel
 
 #include"..\renderer\renderer.h"
 #include"..\d3d wrapper\d3d wrapper.h"
+#include"..\d3d\texture residency\texture residency.h"
 #include"..\..\..\utility\src\graphic\graphic.h"
 #include"..\..\..\utility\src\vector\vector.h"
+#include"..\..\..\utility\src\asset loader\asset loader.h"
 #include<queue>
+#include<deque>
+#include<map>
+#include<memory>
+#include<string>
+#include<cstddef>
 // Makes d3d9 activate additional debug information and checking.
 #ifdef _DEBUG
 #define D3D_DEBUG_INFO
@@ -52,7 +59,7 @@ namespace view
 	@todo Make the vertex/index buffers resize themselves on demand if necessary.
 	@todo Add the capability to render lines, filled quads, and filled circles.
 	*/
-	class BasicD3DRenderer: public Renderer
+	class BasicD3DRenderer: public Renderer, private d3d::TextureResidency::Reloader
 	{
 	public:
 		/** Attempts to create a renderer to render to the window represented by
@@ -74,12 +81,85 @@ namespace view
 
 		
 		/** Attempts to create a texture for \a image.
+		Block-compressed images are kept compressed if the device supports their format, and
+		are decompressed into 32-bit textures if not. Every mip level of the image is uploaded; see
+		\ref Image::GenerateMipmaps(). The image's dimensions, format, and data are hashed with
+		\ref utility::HashContent(), and an image with the same hash as an existing texture shares
+		that texture's handle instead of creating another one. A shared hash is confirmed byte for
+		byte against the resident texture, which is locked read-only; an image which merely
+		collides, or whose match has been evicted, gets a texture of its own.
 		@param image The image data used to create the texture.
+		@param source The name of the file which \a image was loaded from, if any, so that the
+		texture may be evicted and loaded again; see \ref SetTextureMemoryBudget().
 		@return A handle to the created texture.
 		@throws D3DError If unable to create the texture.
+		@throws OutOfMemoryError If unable to decompress a compressed image.
 		@todo This function currently only supports 32-bit textures.
 		*/
-		const utility::TexturedQuad::TextureHandle AddTexture(const Image& image);
+		const utility::TexturedQuad::TextureHandle AddTexture(const Image& image, const std::string& source = "");
+
+		/** Issues a texture handle for an image file at once, bound to a single transparent pixel
+		until the image has been decoded on \a loader's workers. Decoded images are uploaded at the
+		start of \ref RenderGraphics(), within the budget set by \ref SetTextureUploadBudget(), and
+		their textures take the placeholder's place under the same handle.
+		@param file_name The name of the image file to load.
+		@param loader The loader to decode the image on. Its loaded jobs must be finished with
+		AssetLoader::FinishLoadedJobs() before the texture can be uploaded, and the renderer must
+		outlive its jobs.
+		@param priority How urgently the texture is needed.
+		@param generate_mipmaps Whether to build the image's mipmap chain while decoding it.
+		@return A texture handle which may be used to render right away.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		const utility::TexturedQuad::TextureHandle AddTextureAsync(const std::string& file_name, utility::AssetLoader& loader,
+			const utility::AssetJob::Priority priority = utility::AssetJob::NORMAL, const bool generate_mipmaps = false);
+
+		/** Checks whether the texture associated with \a handle has been loaded.
+		@param handle The texture handle to check.
+		@return The state of the texture.
+		*/
+		const TextureState GetTextureState(const utility::TexturedQuad::TextureHandle& handle) const;
+
+		/** Counts the textures added with \ref AddTextureAsync() which are still loading.
+		@return The number of textures in the \ref TEXTURE_LOADING state.
+		*/
+		const unsigned int GetLoadingTextureCount() const;
+
+		/** Limits how much loaded texture data is uploaded each frame. At least one texture is
+		uploaded each frame regardless. The default is 4 MB.
+		@param bytes_per_frame The number of bytes to upload per frame, or 0 for no limit.
+		*/
+		void SetTextureUploadBudget(const std::size_t bytes_per_frame);
+
+		/** Limits how much texture memory is used; see \ref d3d::TextureResidency. An evicted
+		texture is loaded again from its file when it's next drawn, which stalls that frame while
+		the file is decoded. Until it's loaded again, it's drawn as a transparent pixel; a file
+		which is missing or can't be decoded isn't tried again. The default is no limit.
+		@param bytes The number of bytes of texture memory to use, or 0 for no limit.
+		*/
+		void SetTextureMemoryBudget(const std::size_t bytes);
+
+		/** Accesses the residency manager, for its texture memory use and its hit, miss,
+		eviction, and reload failure counts.
+		@return The residency manager.
+		*/
+		const d3d::TextureResidency& GetTextureResidency() const;
+
+		/** Counts the calls to \ref AddTexture() which were given an existing texture, for
+		textures which haven't been deleted since.
+		@return The number of shared references to textures.
+		*/
+		const unsigned int GetSharedTextureCount() const;
+
+		/** Adds up the texture memory saved by sharing textures between identical images.
+		@return The number of bytes which the shared references would otherwise take up.
+		*/
+		const std::size_t GetSharedTextureSize() const;
+
+		/** Measures how quickly images have been hashed by \ref AddTexture().
+		@return The number of bytes hashed per second, or 0 if nothing has been hashed yet.
+		*/
+		const double GetHashThroughput() const;
 
 		/** Releases the texture associated with the texture handle \a texture_handle.
 		If \a texture_handle is not associated with a texture, then nothing happens.
@@ -104,6 +184,130 @@ namespace view
 
 	private:
 
+		/**
+		Decodes an image for \ref AddTextureAsync() on an AssetLoader worker, then queues it to be
+		uploaded by the renderer.
+		*/
+		class StreamedTextureJob: public utility::AssetJob
+		{
+		public:
+			/** Basic constructor.
+			@param file_name The name of the image file to load.
+			@param renderer The renderer which will upload the texture. Must outlive the job.
+			@param handle The texture handle which the texture will be bound to.
+			@param priority How urgently the texture is needed.
+			@param generate_mipmaps Whether to build the image's mipmap chain.
+			*/
+			StreamedTextureJob(const std::string& file_name, BasicD3DRenderer& renderer, const utility::TexturedQuad::TextureHandle handle,
+				const Priority priority, const bool generate_mipmaps);
+			/** Basic destructor.*/
+			~StreamedTextureJob();
+
+			/** Checks whether the image has been decoded and is waiting to be uploaded.
+			@return True if \ref TakeImage() may be called.
+			*/
+			const bool IsLoaded() const;
+
+			/** Accesses the name of the image file being loaded.
+			@return The file name.
+			*/
+			const std::string& GetFileName() const;
+
+			/** Takes the decoded image from the job.
+			@pre \ref IsLoaded() returns true.
+			@return The image.
+			*/
+			std::unique_ptr<Image> TakeImage();
+
+			/** Records that the texture couldn't be created from the decoded image, so that its
+			handle is reported as \ref TEXTURE_FAILED.
+			*/
+			void FailUpload();
+
+			/** Checks whether the texture couldn't be created from the decoded image.
+			@return True if \ref FailUpload() has been called.
+			*/
+			const bool HasUploadFailed() const;
+
+		protected:
+			/** Loads and decodes the image file, and builds its mipmaps if asked to.
+			@throws FileFormatException If the image can't be loaded.
+			@throws OutOfMemoryError If we run out of memory.
+			*/
+			void Load();
+
+			/** Queues the job's handle to be uploaded.
+			@throws OutOfMemoryError If we run out of memory.
+			*/
+			void Finish();
+
+		private:
+			/// The name of the image file.
+			const std::string file_name;
+			/// The renderer which will upload the texture.
+			BasicD3DRenderer& renderer;
+			/// The texture handle which the texture will be bound to.
+			const utility::TexturedQuad::TextureHandle handle;
+			/// Whether to generate mipmaps for the image.
+			const bool generate_mipmaps;
+			/// The decoded image, between Load() and TakeImage().
+			std::unique_ptr<Image> image;
+			/// Set by Finish(), once the image can be taken.
+			bool is_loaded;
+			/// Set by FailUpload().
+			bool has_upload_failed;
+
+			/// NOT IMPLEMENTED.
+			StreamedTextureJob(const StreamedTextureJob&);
+			/// NOT IMPLEMENTED.
+			const StreamedTextureJob& operator=(const StreamedTextureJob&);
+		};
+		friend class StreamedTextureJob;
+
+		/** Issues a texture handle, reusing a freed one if possible.
+		@return The handle.
+		*/
+		const utility::TexturedQuad::TextureHandle IssueTextureHandle();
+
+		/** Creates a texture holding every level of \a image.
+		@param image The image data used to create the texture.
+		@param size [OUT] Receives the number of bytes of texture memory the texture takes up.
+		@return The texture.
+		@throws D3DError If unable to create the texture.
+		@throws OutOfMemoryError If unable to decompress a compressed image.
+		*/
+		IDirect3DTexture9* CreateTextureFromImage(const Image& image, std::size_t& size);
+
+		/** Checks whether a texture holds exactly what \ref CreateTextureFromImage() would create
+		from \a image, by locking each of its levels read-only.
+		@param texture The texture to check.
+		@param image The image to check \a texture against.
+		@return True if \a texture has the same dimensions, format, and data as \a image.
+		@throws D3DError If unable to read the texture.
+		@throws OutOfMemoryError If unable to decompress a compressed image.
+		*/
+		const bool IsTextureOfImage(IDirect3DTexture9& texture, const Image& image);
+
+		/** Loads an evicted texture again from its source. See
+		\ref d3d::TextureResidency::Reloader::ReloadTexture().
+		@param context The evicted texture's context.
+		@param size [OUT] Receives the number of bytes of texture memory used by the texture.
+		@return The texture.
+		@throws FileNotFoundException If the source doesn't exist.
+		@throws FileFormatException If the source can't be loaded.
+		@throws D3DError If unable to create the texture.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		IDirect3DTexture9& ReloadTexture(const d3d::TextureContext& context, std::size_t& size);
+
+		/** Uploads the textures loaded for \ref AddTextureAsync(), oldest first, until the
+		upload budget is spent, and swaps each one in for its placeholder. A texture which can't
+		be created leaves its handle bound to the placeholder and in the \ref TEXTURE_FAILED
+		state, and the rest are still uploaded.
+		@throws OutOfMemoryError If we run out of memory while swapping a texture in.
+		*/
+		void UploadLoadedTextures();
+
 		/** Releases our index and two vertex buffers. This is called when the device is
 		lost.
 		*/
@@ -141,6 +345,33 @@ namespace view
 		unsigned int next_texture_handle;
 		/// Keeps track of texture handles which have been freed so that they may be reused.
 		std::queue<utility::TexturedQuad::TextureHandle> reusable_texture_handles;
+		/// True if the device can sample DXT1 textures; if not, they're decompressed when added.
+		bool is_dxt1_supported;
+		/// True if the device can sample DXT5 textures; if not, they're decompressed when added.
+		bool is_dxt5_supported;
+		/// Drawn in place of textures which are still loading: a single transparent pixel. Each
+		/// handle bound to it holds a reference.
+		IDirect3DTexture9* placeholder_texture;
+		/// The jobs loading textures for AddTextureAsync(), by the handles they'll be bound to.
+		std::map<utility::TexturedQuad::TextureHandle, std::shared_ptr<StreamedTextureJob>> streaming_textures;
+		/// The handles whose images have been loaded, oldest first. Handles which have since been
+		/// deleted are skipped.
+		std::deque<utility::TexturedQuad::TextureHandle> loaded_textures;
+		/// The number of bytes of texture data to upload per frame, or 0 for no limit.
+		std::size_t upload_budget;
+		/// Keeps the textures within the texture memory budget, evicting and reloading them.
+		std::unique_ptr<d3d::TextureResidency> residency;
+		/// The handles of the textures added with \ref AddTexture(), by their images' hashes. Images
+		/// whose hashes collide each have an entry.
+		std::multimap<unsigned long long, utility::TexturedQuad::TextureHandle> content_hashes;
+		/// The number of shared references to textures.
+		unsigned int shared_texture_count;
+		/// The texture memory saved by the shared references, in bytes.
+		std::size_t shared_texture_size;
+		/// The number of bytes of image data hashed.
+		double hashed_size;
+		/// The time spent hashing image data, in seconds.
+		double hash_time;
 
 		/// Buffer for textured vertices.
 		IDirect3DVertexBuffer9* textured_vertex_buffer;
@@ -0,0 +1,750 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the block compression component. See "block compression.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"block compression.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include<cstddef>
+#include<cstring>
+
+
+
+namespace avl
+{
+namespace view
+{
+
+	// Anonymous namespace.
+	namespace
+	{
+		/// The number of bytes in a DXT1 block, and in the color half of a DXT5 block.
+		const unsigned int COLOR_BLOCK_SIZE = 8;
+		/// The number of bytes in a DXT5 block.
+		const unsigned int DXT5_BLOCK_SIZE = 16;
+
+		void GatherBlock(const unsigned char* const pixel_data, const unsigned int width, const unsigned int height, const unsigned int pixel_depth, const unsigned int block_x, const unsigned int block_y, unsigned char* const pixels);
+		void EncodeColorBlock(const unsigned char* const pixels, unsigned char* const block);
+		void EncodeAlphaBlock(const unsigned char* const pixels, unsigned char* const block);
+		void DecodeColorBlock(const unsigned char* const block, const bool allow_three_colors, unsigned char* const pixels);
+		void DecodeAlphaBlock(const unsigned char* const block, unsigned char* const pixels);
+		const unsigned int MatchColors(const unsigned char* const pixels, unsigned short& color0, unsigned short& color1, unsigned int& indices);
+		const bool FitColors(const unsigned char* const pixels, const unsigned int indices, unsigned short& color0, unsigned short& color1);
+		const unsigned int MatchAlphas(const unsigned char* const pixels, const unsigned char alpha0, const unsigned char alpha1, unsigned long long& indices);
+		void BuildColorPalette(const unsigned short color0, const unsigned short color1, const bool allow_three_colors, unsigned char* const palette);
+		void BuildAlphaPalette(const unsigned char alpha0, const unsigned char alpha1, unsigned char* const palette);
+		const unsigned short PackColor(const int blue, const int green, const int red);
+		void FlipColorBlock(const unsigned char* const source, unsigned char* const destination);
+		void FlipAlphaBlock(const unsigned char* const source, unsigned char* const destination);
+	}
+
+
+
+	// See function declaration for details.
+	const std::size_t GetBlockDataSize(const unsigned int width, const unsigned int height, const BlockFormat format)
+	{
+		const std::size_t block_size = (format == DXT1) ? COLOR_BLOCK_SIZE : DXT5_BLOCK_SIZE;
+		return static_cast<std::size_t>((width + 3) / 4) * ((height + 3) / 4) * block_size;
+	}
+
+
+
+	// See function declaration for details.
+	void CompressBlocks(const unsigned char* const pixel_data, const unsigned int width, const unsigned int height, const unsigned short pixel_depth, const BlockFormat format, unsigned char* const blocks)
+	{
+		ASSERT(pixel_data != nullptr && blocks != nullptr);
+		if(pixel_depth != 3 && pixel_depth != 4)
+		{
+			throw utility::InvalidArgumentException("avl::view::CompressBlocks()", "pixel_depth", "Must be 3 or 4.");
+		}
+		const unsigned int blocks_wide = (width + 3) / 4;
+		const unsigned int blocks_high = (height + 3) / 4;
+		unsigned char* block = blocks;
+		unsigned char pixels[64];
+		for(unsigned int block_y = 0; block_y < blocks_high; ++block_y)
+		{
+			for(unsigned int block_x = 0; block_x < blocks_wide; ++block_x)
+			{
+				GatherBlock(pixel_data, width, height, pixel_depth, block_x, block_y, pixels);
+				if(format == DXT5)
+				{
+					EncodeAlphaBlock(pixels, block);
+					block += COLOR_BLOCK_SIZE;
+				}
+				EncodeColorBlock(pixels, block);
+				block += COLOR_BLOCK_SIZE;
+			}
+		}
+	}
+
+
+
+	// See function declaration for details.
+	void DecompressBlocks(const unsigned char* const blocks, const unsigned int width, const unsigned int height, const BlockFormat format, unsigned char* const pixel_data)
+	{
+		ASSERT(blocks != nullptr && pixel_data != nullptr);
+		const unsigned int blocks_wide = (width + 3) / 4;
+		const unsigned int blocks_high = (height + 3) / 4;
+		const unsigned char* block = blocks;
+		unsigned char pixels[64];
+		for(unsigned int block_y = 0; block_y < blocks_high; ++block_y)
+		{
+			for(unsigned int block_x = 0; block_x < blocks_wide; ++block_x)
+			{
+				// The color half of a DXT5 block always uses four colors, so that it can't
+				// override the alpha half.
+				if(format == DXT5)
+				{
+					DecodeColorBlock(block + COLOR_BLOCK_SIZE, false, pixels);
+					DecodeAlphaBlock(block, pixels);
+					block += DXT5_BLOCK_SIZE;
+				}
+				else
+				{
+					DecodeColorBlock(block, true, pixels);
+					block += COLOR_BLOCK_SIZE;
+				}
+
+				// Only copy the part of the block which lies within the image.
+				const unsigned int columns = (width - block_x * 4 < 4) ? width - block_x * 4 : 4;
+				const unsigned int rows = (height - block_y * 4 < 4) ? height - block_y * 4 : 4;
+				for(unsigned int row = 0; row < rows; ++row)
+				{
+					const std::size_t offset = (static_cast<std::size_t>(block_y * 4 + row) * width + block_x * 4) * 4;
+					memcpy(pixel_data + offset, pixels + row * 16, columns * 4);
+				}
+			}
+		}
+	}
+
+
+
+	// See function declaration for details.
+	void FlipBlocksVertically(const unsigned char* const source, unsigned char* const destination, const unsigned int width, const unsigned int height, const BlockFormat format)
+	{
+		ASSERT(source != nullptr && destination != nullptr && source != destination);
+		if(height % 4 != 0)
+		{
+			throw utility::InvalidArgumentException("avl::view::FlipBlocksVertically()", "height", "Must be a multiple of 4.");
+		}
+		const unsigned int block_size = (format == DXT1) ? COLOR_BLOCK_SIZE : DXT5_BLOCK_SIZE;
+		const std::size_t row_size = static_cast<std::size_t>((width + 3) / 4) * block_size;
+		const unsigned int blocks_high = height / 4;
+
+		// Each row of blocks goes to the opposite row, with the rows within each block reversed
+		// on the way.
+		for(unsigned int row = 0; row < blocks_high; ++row)
+		{
+			const unsigned char* block = source + row * row_size;
+			const unsigned char* const end = block + row_size;
+			unsigned char* flipped = destination + (blocks_high - 1 - row) * row_size;
+			if(format == DXT5)
+			{
+				for(; block != end; block += DXT5_BLOCK_SIZE, flipped += DXT5_BLOCK_SIZE)
+				{
+					FlipAlphaBlock(block, flipped);
+					FlipColorBlock(block + COLOR_BLOCK_SIZE, flipped + COLOR_BLOCK_SIZE);
+				}
+			}
+			else
+			{
+				for(; block != end; block += COLOR_BLOCK_SIZE, flipped += COLOR_BLOCK_SIZE)
+				{
+					FlipColorBlock(block, flipped);
+				}
+			}
+		}
+	}
+
+
+
+	// See function declaration for details.
+	const bool IsAnyBlockTranslucent(const unsigned char* const blocks, const unsigned int width, const unsigned int height, const BlockFormat format)
+	{
+		ASSERT(blocks != nullptr);
+		if(format == DXT1)
+		{
+			return false;
+		}
+		const std::size_t block_count = static_cast<std::size_t>((width + 3) / 4) * ((height + 3) / 4);
+		unsigned char pixels[64];
+		for(std::size_t i = 0; i < block_count; ++i)
+		{
+			const unsigned char* const block = blocks + i * DXT5_BLOCK_SIZE;
+			// A block whose endpoints are both 0xFF (or both 0) is uniformly opaque (or transparent).
+			if(block[0] == block[1] && (block[0] == 0xFF || block[0] == 0))
+			{
+				continue;
+			}
+			DecodeAlphaBlock(block, pixels);
+			for(unsigned int j = 0; j < 16; ++j)
+			{
+				if(pixels[j * 4 + 3] != 0 && pixels[j * 4 + 3] != 0xFF)
+				{
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+
+
+	// Anonymous namespace.
+	namespace
+	{
+		/** Copies one block's pixels into 32-bit BGRA, repeating the edge pixels of the image for
+		any part of the block which lies past it.
+		@param pixel_data The image's pixels.
+		@param width The width of the image in pixels.
+		@param height The height of the image in pixels.
+		@param pixel_depth The number of bytes per pixel, 3 or 4.
+		@param block_x The column of the block.
+		@param block_y The row of the block.
+		@param pixels [OUT] Receives the 16 pixels of the block, row by row.
+		*/
+		void GatherBlock(const unsigned char* const pixel_data, const unsigned int width, const unsigned int height, const unsigned int pixel_depth, const unsigned int block_x, const unsigned int block_y, unsigned char* const pixels)
+		{
+			for(unsigned int row = 0; row < 4; ++row)
+			{
+				const unsigned int y = (block_y * 4 + row < height) ? block_y * 4 + row : height - 1;
+				const unsigned char* const source_row = pixel_data + static_cast<std::size_t>(y) * width * pixel_depth;
+				for(unsigned int column = 0; column < 4; ++column)
+				{
+					const unsigned int x = (block_x * 4 + column < width) ? block_x * 4 + column : width - 1;
+					const unsigned char* const source = source_row + x * pixel_depth;
+					unsigned char* const destination = pixels + (row * 4 + column) * 4;
+					destination[0] = source[0];
+					destination[1] = source[1];
+					destination[2] = source[2];
+					destination[3] = (pixel_depth == 4) ? source[3] : 0xFF;
+				}
+			}
+		}
+
+
+
+		/** Compresses the colors of a block. The endpoints start at the extremes of the block's
+		principal axis, and are then refit to the colors by least squares for as long as that
+		reduces the error.
+		@param pixels The 16 BGRA pixels of the block.
+		@param block [OUT] Receives the 8-byte color block.
+		*/
+		void EncodeColorBlock(const unsigned char* const pixels, unsigned char* const block)
+		{
+			// Find the mean and the bounding box of the colors.
+			int minimum[3] = {255, 255, 255};
+			int maximum[3] = {0, 0, 0};
+			float mean[3] = {0.0f, 0.0f, 0.0f};
+			for(unsigned int i = 0; i < 16; ++i)
+			{
+				for(unsigned int channel = 0; channel < 3; ++channel)
+				{
+					const int value = pixels[i * 4 + channel];
+					minimum[channel] = (value < minimum[channel]) ? value : minimum[channel];
+					maximum[channel] = (value > maximum[channel]) ? value : maximum[channel];
+					mean[channel] += value;
+				}
+			}
+
+			unsigned short color0;
+			unsigned short color1;
+			unsigned int indices = 0;
+			if(minimum[0] == maximum[0] && minimum[1] == maximum[1] && minimum[2] == maximum[2])
+			{
+				// A solid block only needs one color.
+				color0 = PackColor(minimum[0], minimum[1], minimum[2]);
+				color1 = color0;
+			}
+			else
+			{
+				// Find the principal axis of the colors by power iteration on their covariance,
+				// starting from the diagonal of the bounding box.
+				float covariance[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+				for(unsigned int channel = 0; channel < 3; ++channel)
+				{
+					mean[channel] /= 16.0f;
+				}
+				for(unsigned int i = 0; i < 16; ++i)
+				{
+					const float b = pixels[i * 4] - mean[0];
+					const float g = pixels[i * 4 + 1] - mean[1];
+					const float r = pixels[i * 4 + 2] - mean[2];
+					covariance[0] += b * b;
+					covariance[1] += b * g;
+					covariance[2] += b * r;
+					covariance[3] += g * g;
+					covariance[4] += g * r;
+					covariance[5] += r * r;
+				}
+				float axis[3] = {static_cast<float>(maximum[0] - minimum[0]), static_cast<float>(maximum[1] - minimum[1]), static_cast<float>(maximum[2] - minimum[2])};
+				for(unsigned int iteration = 0; iteration < 4; ++iteration)
+				{
+					const float b = covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2];
+					const float g = covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2];
+					const float r = covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2];
+					float largest = (b < 0.0f) ? -b : b;
+					largest = (g > largest) ? g : ((-g > largest) ? -g : largest);
+					largest = (r > largest) ? r : ((-r > largest) ? -r : largest);
+					if(largest < 1e-6f)
+					{
+						break;
+					}
+					axis[0] = b / largest;
+					axis[1] = g / largest;
+					axis[2] = r / largest;
+				}
+
+				// The endpoints start at the colors furthest along the axis in either direction.
+				unsigned int lowest = 0;
+				unsigned int highest = 0;
+				float lowest_distance = 0.0f;
+				float highest_distance = 0.0f;
+				for(unsigned int i = 0; i < 16; ++i)
+				{
+					const float distance = pixels[i * 4] * axis[0] + pixels[i * 4 + 1] * axis[1] + pixels[i * 4 + 2] * axis[2];
+					if(i == 0 || distance < lowest_distance)
+					{
+						lowest = i;
+						lowest_distance = distance;
+					}
+					if(i == 0 || distance > highest_distance)
+					{
+						highest = i;
+						highest_distance = distance;
+					}
+				}
+				color0 = PackColor(pixels[highest * 4], pixels[highest * 4 + 1], pixels[highest * 4 + 2]);
+				color1 = PackColor(pixels[lowest * 4], pixels[lowest * 4 + 1], pixels[lowest * 4 + 2]);
+				unsigned int error = MatchColors(pixels, color0, color1, indices);
+
+				// Refit the endpoints to the colors which chose them.
+				for(unsigned int iteration = 0; iteration < 2 && error > 0; ++iteration)
+				{
+					unsigned short fitted0;
+					unsigned short fitted1;
+					unsigned int fitted_indices;
+					if(FitColors(pixels, indices, fitted0, fitted1) == false)
+					{
+						break;
+					}
+					const unsigned int fitted_error = MatchColors(pixels, fitted0, fitted1, fitted_indices);
+					if(fitted_error >= error)
+					{
+						break;
+					}
+					color0 = fitted0;
+					color1 = fitted1;
+					indices = fitted_indices;
+					error = fitted_error;
+				}
+			}
+
+			block[0] = static_cast<unsigned char>(color0);
+			block[1] = static_cast<unsigned char>(color0 >> 8);
+			block[2] = static_cast<unsigned char>(color1);
+			block[3] = static_cast<unsigned char>(color1 >> 8);
+			block[4] = static_cast<unsigned char>(indices);
+			block[5] = static_cast<unsigned char>(indices >> 8);
+			block[6] = static_cast<unsigned char>(indices >> 16);
+			block[7] = static_cast<unsigned char>(indices >> 24);
+		}
+
+
+
+		/** Compresses the alpha values of a block. Blocks which contain fully transparent or fully
+		opaque pixels as well as translucent ones may also be encoded with six interpolated
+		values plus exact 0 and 0xFF, whichever is closer.
+		@param pixels The 16 BGRA pixels of the block.
+		@param block [OUT] Receives the 8-byte alpha block.
+		*/
+		void EncodeAlphaBlock(const unsigned char* const pixels, unsigned char* const block)
+		{
+			unsigned char minimum = 0xFF;
+			unsigned char maximum = 0;
+			unsigned char inner_minimum = 0xFF;
+			unsigned char inner_maximum = 0;
+			for(unsigned int i = 0; i < 16; ++i)
+			{
+				const unsigned char alpha = pixels[i * 4 + 3];
+				minimum = (alpha < minimum) ? alpha : minimum;
+				maximum = (alpha > maximum) ? alpha : maximum;
+				if(alpha != 0 && alpha != 0xFF)
+				{
+					inner_minimum = (alpha < inner_minimum) ? alpha : inner_minimum;
+					inner_maximum = (alpha > inner_maximum) ? alpha : inner_maximum;
+				}
+			}
+
+			unsigned char alpha0 = maximum;
+			unsigned char alpha1 = minimum;
+			unsigned long long indices = 0;
+			if(minimum != maximum)
+			{
+				// Eight values interpolated from the largest alpha to the smallest.
+				unsigned int error = MatchAlphas(pixels, alpha0, alpha1, indices);
+				if(error > 0 && (minimum == 0 || maximum == 0xFF))
+				{
+					// Six values interpolated across the translucent alphas, plus 0 and 0xFF. If
+					// there are no translucent alphas, any endpoints will do.
+					const unsigned char six_alpha0 = (inner_minimum <= inner_maximum) ? inner_minimum : 0;
+					const unsigned char six_alpha1 = (inner_minimum <= inner_maximum) ? inner_maximum : 0;
+					unsigned long long six_indices;
+					if(MatchAlphas(pixels, six_alpha0, six_alpha1, six_indices) < error)
+					{
+						alpha0 = six_alpha0;
+						alpha1 = six_alpha1;
+						indices = six_indices;
+					}
+				}
+			}
+
+			block[0] = alpha0;
+			block[1] = alpha1;
+			for(unsigned int i = 0; i < 6; ++i)
+			{
+				block[2 + i] = static_cast<unsigned char>(indices >> (i * 8));
+			}
+		}
+
+
+
+		/** Decompresses the colors of a block.
+		@param block The 8-byte color block.
+		@param allow_three_colors Whether the block may use three colors and transparent black,
+		as signalled by its first endpoint not being greater than its second. Only DXT1 allows this.
+		@param pixels [OUT] Receives the 16 BGRA pixels of the block, row by row.
+		*/
+		void DecodeColorBlock(const unsigned char* const block, const bool allow_three_colors, unsigned char* const pixels)
+		{
+			const unsigned short color0 = static_cast<unsigned short>(block[0] | (block[1] << 8));
+			const unsigned short color1 = static_cast<unsigned short>(block[2] | (block[3] << 8));
+			unsigned char palette[16];
+			BuildColorPalette(color0, color1, allow_three_colors, palette);
+			for(unsigned int row = 0; row < 4; ++row)
+			{
+				const unsigned char row_indices = block[4 + row];
+				for(unsigned int column = 0; column < 4; ++column)
+				{
+					const unsigned char* const color = palette + ((row_indices >> (column * 2)) & 3) * 4;
+					unsigned char* const pixel = pixels + (row * 4 + column) * 4;
+					pixel[0] = color[0];
+					pixel[1] = color[1];
+					pixel[2] = color[2];
+					pixel[3] = color[3];
+				}
+			}
+		}
+
+
+
+		/** Decompresses the alpha values of a block.
+		@param block The 8-byte alpha block.
+		@param pixels [OUT] Receives the alpha of the 16 BGRA pixels of the block; their colors are
+		left alone.
+		*/
+		void DecodeAlphaBlock(const unsigned char* const block, unsigned char* const pixels)
+		{
+			unsigned char palette[8];
+			BuildAlphaPalette(block[0], block[1], palette);
+			unsigned long long indices = 0;
+			for(unsigned int i = 0; i < 6; ++i)
+			{
+				indices |= static_cast<unsigned long long>(block[2 + i]) << (i * 8);
+			}
+			for(unsigned int i = 0; i < 16; ++i)
+			{
+				pixels[i * 4 + 3] = palette[(indices >> (i * 3)) & 7];
+			}
+		}
+
+
+
+		/** Picks the closest of the colors interpolated between two endpoints for each pixel.
+		@param pixels The 16 BGRA pixels of the block.
+		@param color0 [IN/OUT] The first endpoint. Swapped with \a color1 if needed, so that the
+		block decodes with four colors.
+		@param color1 [IN/OUT] The second endpoint.
+		@param indices [OUT] Receives the 2-bit index of each pixel.
+		@return The sum of the squared differences between the pixels and the colors they chose.
+		*/
+		const unsigned int MatchColors(const unsigned char* const pixels, unsigned short& color0, unsigned short& color1, unsigned int& indices)
+		{
+			// The first endpoint must be the greater for the block to have four colors; if they're
+			// equal, only the first color is used.
+			if(color0 < color1)
+			{
+				const unsigned short swap = color0;
+				color0 = color1;
+				color1 = swap;
+			}
+			unsigned char palette[16];
+			BuildColorPalette(color0, color1, false, palette);
+			const unsigned int color_count = (color0 == color1) ? 1 : 4;
+
+			unsigned int error = 0;
+			indices = 0;
+			for(unsigned int i = 0; i < 16; ++i)
+			{
+				const unsigned char* const pixel = pixels + i * 4;
+				unsigned int best_index = 0;
+				unsigned int best_error = 0xFFFFFFFF;
+				for(unsigned int j = 0; j < color_count; ++j)
+				{
+					const int b = pixel[0] - palette[j * 4];
+					const int g = pixel[1] - palette[j * 4 + 1];
+					const int r = pixel[2] - palette[j * 4 + 2];
+					const unsigned int distance = static_cast<unsigned int>(b * b + g * g + r * r);
+					if(distance < best_error)
+					{
+						best_index = j;
+						best_error = distance;
+					}
+				}
+				indices |= best_index << (i * 2);
+				error += best_error;
+			}
+			return error;
+		}
+
+
+
+		/** Finds the endpoints which best fit the pixels, in the least squares sense, given the
+		colors each pixel chose.
+		@param pixels The 16 BGRA pixels of the block.
+		@param indices The 2-bit index of each pixel, as of a four-color block.
+		@param color0 [OUT] Receives the first endpoint.
+		@param color1 [OUT] Receives the second endpoint.
+		@return False if every pixel chose the same weighting, so no fit is possible.
+		*/
+		const bool FitColors(const unsigned char* const pixels, const unsigned int indices, unsigned short& color0, unsigned short& color1)
+		{
+			// Each index is a weighting of the second endpoint against the first.
+			const float weights[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+			float aa = 0.0f;
+			float ab = 0.0f;
+			float bb = 0.0f;
+			float ax[3] = {0.0f, 0.0f, 0.0f};
+			float bx[3] = {0.0f, 0.0f, 0.0f};
+			for(unsigned int i = 0; i < 16; ++i)
+			{
+				const float b = weights[(indices >> (i * 2)) & 3];
+				const float a = 1.0f - b;
+				aa += a * a;
+				ab += a * b;
+				bb += b * b;
+				for(unsigned int channel = 0; channel < 3; ++channel)
+				{
+					ax[channel] += a * pixels[i * 4 + channel];
+					bx[channel] += b * pixels[i * 4 + channel];
+				}
+			}
+			const float determinant = aa * bb - ab * ab;
+			if(determinant < 1e-3f)
+			{
+				return false;
+			}
+			int endpoint0[3];
+			int endpoint1[3];
+			for(unsigned int channel = 0; channel < 3; ++channel)
+			{
+				endpoint0[channel] = static_cast<int>((ax[channel] * bb - bx[channel] * ab) / determinant + 0.5f);
+				endpoint1[channel] = static_cast<int>((bx[channel] * aa - ax[channel] * ab) / determinant + 0.5f);
+			}
+			color0 = PackColor(endpoint0[0], endpoint0[1], endpoint0[2]);
+			color1 = PackColor(endpoint1[0], endpoint1[1], endpoint1[2]);
+			return true;
+		}
+
+
+
+		/** Picks the closest of the alpha values interpolated between two endpoints for each pixel.
+		@param pixels The 16 BGRA pixels of the block.
+		@param alpha0 The first endpoint.
+		@param alpha1 The second endpoint.
+		@param indices [OUT] Receives the 3-bit index of each pixel.
+		@return The sum of the squared differences between the pixels and the alphas they chose.
+		*/
+		const unsigned int MatchAlphas(const unsigned char* const pixels, const unsigned char alpha0, const unsigned char alpha1, unsigned long long& indices)
+		{
+			unsigned char palette[8];
+			BuildAlphaPalette(alpha0, alpha1, palette);
+			unsigned int error = 0;
+			indices = 0;
+			for(unsigned int i = 0; i < 16; ++i)
+			{
+				const int alpha = pixels[i * 4 + 3];
+				unsigned int best_index = 0;
+				unsigned int best_error = 0xFFFFFFFF;
+				for(unsigned int j = 0; j < 8; ++j)
+				{
+					const unsigned int distance = static_cast<unsigned int>((alpha - palette[j]) * (alpha - palette[j]));
+					if(distance < best_error)
+					{
+						best_index = j;
+						best_error = distance;
+					}
+				}
+				indices |= static_cast<unsigned long long>(best_index) << (i * 3);
+				error += best_error;
+			}
+			return error;
+		}
+
+
+
+		/** Expands two 5:6:5 endpoints into the colors a block may use.
+		@param color0 The first endpoint.
+		@param color1 The second endpoint.
+		@param allow_three_colors If true and \a color0 isn't greater than \a color1, the block
+		has three colors and transparent black rather than four colors.
+		@param palette [OUT] Receives four BGRA colors.
+		*/
+		void BuildColorPalette(const unsigned short color0, const unsigned short color1, const bool allow_three_colors, unsigned char* const palette)
+		{
+			const unsigned short colors[2] = {color0, color1};
+			for(unsigned int i = 0; i < 2; ++i)
+			{
+				// Replicate the high bits into the low bits so that the full range is reached.
+				const unsigned int blue = colors[i] & 0x1F;
+				const unsigned int green = (colors[i] >> 5) & 0x3F;
+				const unsigned int red = colors[i] >> 11;
+				palette[i * 4] = static_cast<unsigned char>((blue << 3) | (blue >> 2));
+				palette[i * 4 + 1] = static_cast<unsigned char>((green << 2) | (green >> 4));
+				palette[i * 4 + 2] = static_cast<unsigned char>((red << 3) | (red >> 2));
+				palette[i * 4 + 3] = 0xFF;
+			}
+			if(allow_three_colors == true && color0 <= color1)
+			{
+				for(unsigned int channel = 0; channel < 3; ++channel)
+				{
+					palette[8 + channel] = static_cast<unsigned char>((palette[channel] + palette[4 + channel]) / 2);
+					palette[12 + channel] = 0;
+				}
+				palette[11] = 0xFF;
+				palette[15] = 0;
+			}
+			else
+			{
+				for(unsigned int channel = 0; channel < 3; ++channel)
+				{
+					palette[8 + channel] = static_cast<unsigned char>((2 * palette[channel] + palette[4 + channel]) / 3);
+					palette[12 + channel] = static_cast<unsigned char>((palette[channel] + 2 * palette[4 + channel]) / 3);
+				}
+				palette[11] = 0xFF;
+				palette[15] = 0xFF;
+			}
+		}
+
+
+
+		/** Expands two alpha endpoints into the alpha values a block may use.
+		@param alpha0 The first endpoint.
+		@param alpha1 The second endpoint.
+		@param palette [OUT] Receives eight alpha values: six interpolated values followed by 0 and
+		0xFF if \a alpha0 isn't greater than \a alpha1, and eight interpolated values otherwise.
+		*/
+		void BuildAlphaPalette(const unsigned char alpha0, const unsigned char alpha1, unsigned char* const palette)
+		{
+			palette[0] = alpha0;
+			palette[1] = alpha1;
+			if(alpha0 > alpha1)
+			{
+				for(unsigned int i = 2; i < 8; ++i)
+				{
+					palette[i] = static_cast<unsigned char>(((8 - i) * alpha0 + (i - 1) * alpha1) / 7);
+				}
+			}
+			else
+			{
+				for(unsigned int i = 2; i < 6; ++i)
+				{
+					palette[i] = static_cast<unsigned char>(((6 - i) * alpha0 + (i - 1) * alpha1) / 5);
+				}
+				palette[6] = 0;
+				palette[7] = 0xFF;
+			}
+		}
+
+
+
+		/** Rounds an 8-bit color to 5:6:5.
+		@param blue The blue channel; clamped to [0, 255].
+		@param green The green channel; clamped to [0, 255].
+		@param red The red channel; clamped to [0, 255].
+		@return The packed color.
+		*/
+		const unsigned short PackColor(const int blue, const int green, const int red)
+		{
+			const int b = (blue < 0) ? 0 : ((blue > 255) ? 255 : blue);
+			const int g = (green < 0) ? 0 : ((green > 255) ? 255 : green);
+			const int r = (red < 0) ? 0 : ((red > 255) ? 255 : red);
+			return static_cast<unsigned short>((((r * 31 + 127) / 255) << 11) | (((g * 63 + 127) / 255) << 5) | ((b * 31 + 127) / 255));
+		}
+
+
+
+		/** Copies a color block with its rows reversed.
+		@param source The 8-byte color block.
+		@param destination [OUT] Receives the flipped block.
+		*/
+		void FlipColorBlock(const unsigned char* const source, unsigned char* const destination)
+		{
+			// The endpoints stay put; there's one byte of indices per row.
+			destination[0] = source[0];
+			destination[1] = source[1];
+			destination[2] = source[2];
+			destination[3] = source[3];
+			destination[4] = source[7];
+			destination[5] = source[6];
+			destination[6] = source[5];
+			destination[7] = source[4];
+		}
+
+
+
+		/** Copies an alpha block with its rows reversed.
+		@param source The 8-byte alpha block.
+		@param destination [OUT] Receives the flipped block.
+		*/
+		void FlipAlphaBlock(const unsigned char* const source, unsigned char* const destination)
+		{
+			// The endpoints stay put; there are twelve bits of indices per row.
+			const unsigned int first_rows = source[2] | (source[3] << 8) | (source[4] << 16);
+			const unsigned int last_rows = source[5] | (source[6] << 8) | (source[7] << 16);
+			const unsigned int flipped_first_rows = ((last_rows & 0xFFF) << 12) | (last_rows >> 12);
+			const unsigned int flipped_last_rows = ((first_rows & 0xFFF) << 12) | (first_rows >> 12);
+			destination[0] = source[0];
+			destination[1] = source[1];
+			destination[2] = static_cast<unsigned char>(flipped_first_rows);
+			destination[3] = static_cast<unsigned char>(flipped_first_rows >> 8);
+			destination[4] = static_cast<unsigned char>(flipped_first_rows >> 16);
+			destination[5] = static_cast<unsigned char>(flipped_last_rows);
+			destination[6] = static_cast<unsigned char>(flipped_last_rows >> 8);
+			destination[7] = static_cast<unsigned char>(flipped_last_rows >> 16);
+		}
+	}
+
+
+
+} // view
+} // avl
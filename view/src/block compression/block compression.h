@@ -0,0 +1,112 @@
+#pragma once
+#ifndef AVL_VIEW_BLOCK_COMPRESSION__
+#define AVL_VIEW_BLOCK_COMPRESSION__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Encodes and decodes DXT1 and DXT5 block-compressed pixel data.
+@par Layout:
+Pixels are grouped into blocks of 4x4, which are stored left to right, then row by row.
+Blocks are ordered the same way as the pixel data they came from: the first row of
+blocks holds the first four rows of pixels, and so on. Pixel data is 32-bit BGRA (or
+24-bit BGR when compressing), the same layout as an \ref avl::view::Image's.
+@li DXT1 blocks are 8 bytes: two 5:6:5 colors, then a 2-bit index per pixel which picks one
+of the two colors or one of two colors interpolated between them. Alpha isn't stored.
+@li DXT5 blocks are 16 bytes: two alpha values and a 3-bit index per pixel which picks one of
+eight alpha values interpolated between them, followed by a DXT1 color block.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include<cstddef>
+
+
+namespace avl
+{
+namespace view
+{
+	/** The supported block-compressed formats.*/
+	enum BlockFormat
+	{
+		/// Opaque color, 4 bits per pixel.
+		DXT1,
+		/// Color with interpolated alpha, 8 bits per pixel.
+		DXT5
+	};
+
+	/** Computes the size of an image's block-compressed data. Partial blocks at the right
+	and top edges of the image take up a whole block.
+	@param width The width of the image in pixels.
+	@param height The height of the image in pixels.
+	@param format The block format.
+	@return The size of the compressed data in bytes.
+	*/
+	const std::size_t GetBlockDataSize(const unsigned int width, const unsigned int height, const BlockFormat format);
+
+	/** Compresses pixel data into blocks. Pixels past the edge of the image are treated as
+	copies of the nearest edge pixel.
+	@param pixel_data The pixels to compress.
+	@param width The width of the image in pixels.
+	@param height The height of the image in pixels.
+	@param pixel_depth The number of bytes per pixel: 3 for BGR, or 4 for BGRA. 24-bit
+	pixels are treated as opaque.
+	@param format The block format to compress to. DXT1 drops the alpha channel.
+	@param blocks [OUT] Receives the compressed data. Must have room for
+	\ref GetBlockDataSize() bytes.
+	@throws InvalidArgumentException If \a pixel_depth isn't 3 or 4.
+	*/
+	void CompressBlocks(const unsigned char* const pixel_data, const unsigned int width, const unsigned int height, const unsigned short pixel_depth, const BlockFormat format, unsigned char* const blocks);
+
+	/** Decompresses blocks into 32-bit BGRA pixel data. This is the reference decoder: it's
+	used wherever the device can't sample compressed textures, and to check the encoder.
+	@param blocks The compressed data.
+	@param width The width of the image in pixels.
+	@param height The height of the image in pixels.
+	@param format The block format of \a blocks.
+	@param pixel_data [OUT] Receives the pixels. Must have room for \a width * \a height * 4
+	bytes.
+	*/
+	void DecompressBlocks(const unsigned char* const blocks, const unsigned int width, const unsigned int height, const BlockFormat format, unsigned char* const pixel_data);
+
+	/** Copies compressed data upside down, by reversing the order of the rows of blocks and of the
+	rows of pixels within each block. DDS files store images top row first, whereas images are
+	stored bottom row first.
+	@param source The compressed data.
+	@param destination [OUT] Receives the flipped data. Must not overlap \a source.
+	@param width The width of the image in pixels.
+	@param height The height of the image in pixels.
+	@param format The block format of \a source.
+	@throws InvalidArgumentException If \a height isn't a multiple of 4, since the partial
+	blocks would end up at the wrong edge.
+	*/
+	void FlipBlocksVertically(const unsigned char* const source, unsigned char* const destination, const unsigned int width, const unsigned int height, const BlockFormat format);
+
+	/** Checks whether any decompressed pixel would have an alpha value other than 0 or 0xFF.
+	@param blocks The compressed data.
+	@param width The width of the image in pixels.
+	@param height The height of the image in pixels.
+	@param format The block format of \a blocks.
+	@return True if any pixel is translucent. Always false for DXT1.
+	*/
+	const bool IsAnyBlockTranslucent(const unsigned char* const blocks, const unsigned int width, const unsigned int height, const BlockFormat format);
+
+
+
+} // view
+} // avl
+#endif // AVL_VIEW_BLOCK_COMPRESSION__
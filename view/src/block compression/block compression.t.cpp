@@ -0,0 +1,240 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the block compression component. See "block compression.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"block compression.h"
+#include"..\image\image.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include"..\..\..\utility\src\file operations\file operations.h"
+#include"..\..\..\utility\src\timer\timer.h"
+#include<iostream>
+#include<string>
+#include<vector>
+#include<cmath>
+#include<cstring>
+#include<cstdlib>
+#include<cstdio>
+
+
+
+// Anonymous namespace.
+namespace
+{
+	void MeasureError(const avl::view::Image& image, const avl::view::BlockFormat format, double& color_error, double& alpha_error);
+	void WriteTestTGA(const std::string& file_name, const unsigned int width, const unsigned int height);
+	const double TimeLoad(const std::string& file_name, const unsigned int iterations);
+}
+
+
+
+void TestBlockCompressionComponent()
+{
+	using namespace avl::view;
+	using avl::utility::Timer;
+
+	// Decode known blocks: red and blue endpoints with a 2-bit index per pixel, first in the
+	// four-color mode and then, with the endpoints swapped, in the three-color mode.
+	const unsigned char four_colors[8] = {0x00, 0xF8, 0x1F, 0x00, 0xE4, 0xE4, 0xE4, 0xE4};
+	const unsigned char three_colors[8] = {0x1F, 0x00, 0x00, 0xF8, 0xE4, 0xE4, 0xE4, 0xE4};
+	unsigned char pixels[4 * 4 * 4];
+	DecompressBlocks(four_colors, 4, 4, DXT1, pixels);
+	const unsigned char expected_four[16] = {0, 0, 255, 255, 255, 0, 0, 255, 85, 0, 170, 255, 170, 0, 85, 255};
+	ASSERT(memcmp(pixels, expected_four, 16) == 0 && memcmp(pixels + 48, expected_four, 16) == 0);
+	DecompressBlocks(three_colors, 4, 4, DXT1, pixels);
+	const unsigned char expected_three[16] = {255, 0, 0, 255, 0, 0, 255, 255, 127, 0, 127, 255, 0, 0, 0, 0};
+	ASSERT(memcmp(pixels, expected_three, 16) == 0);
+	// DXT5 ignores the three-color mode, and interpolates eight alphas from 0xFF to 0.
+	const unsigned char alpha_block[16] = {0xFF, 0x00, 0x88, 0xC6, 0xFA, 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00};
+	DecompressBlocks(alpha_block, 4, 4, DXT5, pixels);
+	const unsigned char expected_alphas[8] = {255, 0, 218, 182, 145, 109, 72, 36};
+	for(unsigned int i = 0; i < 8; ++i)
+	{
+		ASSERT(pixels[i * 4 + 3] == expected_alphas[i]);
+		ASSERT(pixels[i * 4] == 255 && pixels[i * 4 + 2] == 0);
+	}
+	ASSERT(IsAnyBlockTranslucent(alpha_block, 4, 4, DXT5) == true);
+	std::cout << "Known blocks decode correctly.\n";
+
+	// Flipping twice must restore the data, and flipping once must match the flipped pixels.
+	const Image sheet_source("assets/explosion.tga");
+	ASSERT(sheet_source.GetPixelData() != nullptr && sheet_source.GetHeight() % 4 == 0);
+	const unsigned int width = sheet_source.GetWidth();
+	const unsigned int height = sheet_source.GetHeight();
+	std::vector<unsigned char> blocks(GetBlockDataSize(width, height, DXT5));
+	CompressBlocks(sheet_source.GetPixelData(), width, height, sheet_source.GetPixelDepth(), DXT5, &blocks[0]);
+	std::vector<unsigned char> flipped(blocks.size());
+	FlipBlocksVertically(&blocks[0], &flipped[0], width, height, DXT5);
+	std::vector<unsigned char> decoded(width * height * 4);
+	std::vector<unsigned char> decoded_flipped(width * height * 4);
+	DecompressBlocks(&blocks[0], width, height, DXT5, &decoded[0]);
+	DecompressBlocks(&flipped[0], width, height, DXT5, &decoded_flipped[0]);
+	for(unsigned int row = 0; row < height; ++row)
+	{
+		ASSERT(memcmp(&decoded[row * width * 4], &decoded_flipped[(height - 1 - row) * width * 4], width * 4) == 0);
+	}
+	std::vector<unsigned char> restored(blocks.size());
+	FlipBlocksVertically(&flipped[0], &restored[0], width, height, DXT5);
+	ASSERT(restored == blocks);
+	std::cout << "Flipping is correct.\n";
+
+	// Compress every asset and report how close the reference decoder gets to the original,
+	// and how much memory each texture takes up.
+	const char* const assets[] = {"assets/Font.tga", "assets/background.tga", "assets/blue.tga", "assets/explosion.tga",
+		"assets/red squares.tga", "assets/spiral.tga", "assets/translucent.tga"};
+	std::cout << "Asset: 32-bit bytes, DXT1 bytes (RMS error), DXT5 bytes (RMS error, alpha RMS error)\n";
+	for(unsigned int i = 0; i < sizeof(assets) / sizeof(assets[0]); ++i)
+	{
+		const Image image(assets[i]);
+		ASSERT(image.GetPixelData() != nullptr);
+		double dxt1_error, dxt5_error, alpha_error, unused;
+		MeasureError(image, DXT1, dxt1_error, unused);
+		MeasureError(image, DXT5, dxt5_error, alpha_error);
+		ASSERT(dxt1_error < 16.0 && dxt5_error < 16.0 && alpha_error < 4.0);
+		std::cout << assets[i] << ": " << image.GetWidth() * image.GetHeight() * 4 << ", "
+			<< GetBlockDataSize(image.GetWidth(), image.GetHeight(), DXT1) << " (" << dxt1_error << "), "
+			<< GetBlockDataSize(image.GetWidth(), image.GetHeight(), DXT5) << " (" << dxt5_error << ", " << alpha_error << ")\n";
+	}
+
+	// Round trip through a DDS file, and compare load times against an uncompressed TGA.
+	const unsigned int sheet_size = 2048;
+	WriteTestTGA("block compression test.tga", sheet_size, sheet_size);
+	const Image sheet("block compression test.tga");
+	ASSERT(sheet.GetPixelData() != nullptr);
+	const std::size_t pixel_count = static_cast<std::size_t>(sheet_size) * sheet_size;
+	for(unsigned int i = 0; i < 2; ++i)
+	{
+		const BlockFormat format = (i == 0) ? DXT1 : DXT5;
+		unsigned char* const sheet_blocks = new unsigned char[GetBlockDataSize(sheet_size, sheet_size, format)];
+		const Timer timer;
+		CompressBlocks(sheet.GetPixelData(), sheet_size, sheet_size, 4, format, sheet_blocks);
+		const double encode_time = timer.Elapsed();
+		const Image compressed(sheet_size, sheet_size, format, IsAnyBlockTranslucent(sheet_blocks, sheet_size, sheet_size, format), sheet_blocks);
+		const std::string dds_name = (i == 0) ? "block compression test 1.dds" : "block compression test 5.dds";
+		ASSERT(SaveImageDDS(dds_name, compressed) == true);
+
+		const Image loaded(dds_name);
+		ASSERT(loaded.IsCompressed() == true && loaded.GetBlockFormat() == format);
+		ASSERT(loaded.GetWidth() == sheet_size && loaded.GetHeight() == sheet_size);
+		ASSERT(loaded.IsTranslucent() == compressed.IsTranslucent());
+		ASSERT(memcmp(loaded.GetPixelData(), compressed.GetPixelData(), compressed.GetDataSize()) == 0);
+
+		std::cout << ((i == 0) ? "DXT1" : "DXT5") << " " << sheet_size << "x" << sheet_size << ": encoded at "
+			<< pixel_count / encode_time / 1000000.0 << " MP/s; " << compressed.GetDataSize() / 1024 << " KB vs. "
+			<< sheet.GetDataSize() / 1024 << " KB; loaded in " << TimeLoad(dds_name, 10) * 1000.0 << " ms vs. "
+			<< TimeLoad("block compression test.tga", 10) * 1000.0 << " ms for the TGA.\n";
+		remove(dds_name.c_str());
+	}
+	remove("block compression test.tga");
+
+	std::cout << "\n\n";
+	system("pause");
+}
+
+
+
+// Anonymous namespace.
+namespace
+{
+	/** Compresses an image and decompresses it again with the reference decoder.
+	@param image The image to compress.
+	@param format The block format to compress to.
+	@param color_error [OUT] The root mean square error of the color channels.
+	@param alpha_error [OUT] The root mean square error of the alpha channel.
+	*/
+	void MeasureError(const avl::view::Image& image, const avl::view::BlockFormat format, double& color_error, double& alpha_error)
+	{
+		const unsigned int width = image.GetWidth();
+		const unsigned int height = image.GetHeight();
+		const unsigned int pixel_depth = image.GetPixelDepth();
+		std::vector<unsigned char> blocks(avl::view::GetBlockDataSize(width, height, format));
+		std::vector<unsigned char> decoded(width * height * 4);
+		avl::view::CompressBlocks(image.GetPixelData(), width, height, image.GetPixelDepth(), format, &blocks[0]);
+		avl::view::DecompressBlocks(&blocks[0], width, height, format, &decoded[0]);
+
+		double color_sum = 0.0;
+		double alpha_sum = 0.0;
+		for(std::size_t i = 0; i < static_cast<std::size_t>(width) * height; ++i)
+		{
+			for(unsigned int channel = 0; channel < 3; ++channel)
+			{
+				const double difference = static_cast<double>(image.GetPixelData()[i * pixel_depth + channel]) - decoded[i * 4 + channel];
+				color_sum += difference * difference;
+			}
+			const double alpha = (pixel_depth == 4) ? image.GetPixelData()[i * 4 + 3] : 255.0;
+			alpha_sum += (alpha - decoded[i * 4 + 3]) * (alpha - decoded[i * 4 + 3]);
+		}
+		color_error = std::sqrt(color_sum / (static_cast<double>(width) * height * 3));
+		alpha_error = std::sqrt(alpha_sum / (static_cast<double>(width) * height));
+	}
+
+
+
+	/** Writes an uncompressed 32-bit TGA file of smooth gradients and translucent circles.
+	@param file_name The name of the file to write.
+	@param width The width of the image.
+	@param height The height of the image.
+	*/
+	void WriteTestTGA(const std::string& file_name, const unsigned int width, const unsigned int height)
+	{
+		std::vector<char> file_data(18 + width * height * 4, 0);
+		file_data[2] = 2;
+		file_data[12] = static_cast<char>(width);
+		file_data[13] = static_cast<char>(width >> 8);
+		file_data[14] = static_cast<char>(height);
+		file_data[15] = static_cast<char>(height >> 8);
+		file_data[16] = 32;
+		file_data[17] = 8;
+		char* pixel = &file_data[18];
+		for(unsigned int y = 0; y < height; ++y)
+		{
+			for(unsigned int x = 0; x < width; ++x, pixel += 4)
+			{
+				const int dx = static_cast<int>(x % 64) - 32;
+				const int dy = static_cast<int>(y % 64) - 32;
+				const int distance = dx * dx + dy * dy;
+				pixel[0] = static_cast<char>(x * 255 / width);
+				pixel[1] = static_cast<char>(y * 255 / height);
+				pixel[2] = static_cast<char>((x ^ y) & 0xC0);
+				pixel[3] = static_cast<char>((distance >= 1024) ? 0 : 255 - distance / 4);
+			}
+		}
+		avl::utility::WriteFile(file_name, file_data);
+	}
+
+
+
+	/** Times how long an image takes to load.
+	@param file_name The image to load.
+	@param iterations The number of times to load it.
+	@return The average time to load the image, in seconds.
+	*/
+	const double TimeLoad(const std::string& file_name, const unsigned int iterations)
+	{
+		const avl::utility::Timer timer;
+		for(unsigned int i = 0; i < iterations; ++i)
+		{
+			const avl::view::Image image(file_name);
+			ASSERT(image.GetPixelData() != nullptr);
+		}
+		return timer.Elapsed() / iterations;
+	}
+}
@@ -25,6 +25,7 @@ Implementation for the draw primitives task list component. See "draw primitives
 #include"..\render task\render task.h"
 #include"..\draw primitives task\draw primitives task.h"
 #include"..\texture context\texture context.h"
+#include"..\texture residency\texture residency.h"
 #include"..\wrapper functions\wrapper functions.h"
 #include"..\d3d error\d3d error.h"
 #include"..\..\renderer\renderer.h"
@@ -42,7 +43,7 @@ namespace d3d
 {
 
 	// See method declaration for details.
-	DrawPrimitivesTaskList::DrawPrimitivesTaskList(const utility::GraphicList& graphics, TexHandleToTexContext& textures)
+	DrawPrimitivesTaskList::DrawPrimitivesTaskList(const utility::GraphicList& graphics, TextureResidency& textures)
 	{
 		utility::RenderPrimitiveList render_primitives;
 		ExtractRenderPrimitives(graphics, render_primitives);
@@ -122,7 +123,7 @@ namespace d3d
 	}
 
 	// See method declaration for details.
-	void DrawPrimitivesTaskList::GenerateDrawPrimitivesTasks(const utility::RenderPrimitiveList& render_primitives, TexHandleToTexContext& textures)
+	void DrawPrimitivesTaskList::GenerateDrawPrimitivesTasks(const utility::RenderPrimitiveList& render_primitives, TextureResidency& textures)
 	{
 		for(auto i = render_primitives.cbegin(); i != render_primitives.cend(); ++i)
 		{
@@ -138,10 +139,10 @@ namespace d3d
 	}
 
 	// See method declaration for details.
-	void DrawPrimitivesTaskList::GenerateDrawPrimitivesTask(const utility::TexturedQuad& quad, TexHandleToTexContext& textures)
+	void DrawPrimitivesTaskList::GenerateDrawPrimitivesTask(const utility::TexturedQuad& quad, TextureResidency& textures)
 	{
-		TextureContext& texture_context = GetTextureContextFromHandle(textures, quad.GetTextureHandle());
-		DrawPrimitivesTask task(quad, &texture_context.texture, texture_context.is_translucent);
+		TextureContext& texture_context = textures.UseTexture(quad.GetTextureHandle());
+		DrawPrimitivesTask task(quad, texture_context.texture, texture_context.is_translucent);
 		try
 		{
 			draw_primitives_tasks.push_back(task);
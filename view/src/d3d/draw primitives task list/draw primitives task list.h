@@ -26,6 +26,7 @@ Defines the DrawPrimitivesTaskList class.
 
 #include"..\draw primitives task\draw primitives task.h"
 #include"..\texture context\texture context.h"
+#include"..\texture residency\texture residency.h"
 #include"..\wrapper functions\wrapper functions.h"
 #include"..\..\..\..\utility\src\graphic\graphic.h"
 #include<list>
@@ -48,13 +49,13 @@ namespace d3d
 	public:
 		/** Derives DrawPrimitiveTask objects directly from \a graphics.
 		@param graphics A list of unsorted graphics to be rendered.
-		@param textures The texture map defining the textures used by any
-		textured RenderPrimitive objects.
+		@param textures The textures used by any textured RenderPrimitive
+		objects. Each one is marked as drawn in the current frame.
 		@throws avl::utility::OutOfMemoryError If we run out of memory.
 		@throws RendererException If we find an unsupported
 		RenderPrimitive type.
 		*/
-		DrawPrimitivesTaskList(const utility::GraphicList& graphics, TexHandleToTexContext& textures);
+		DrawPrimitivesTaskList(const utility::GraphicList& graphics, TextureResidency& textures);
 		~DrawPrimitivesTaskList();
 		
 		/** Standardizes this list of DrawPrimitivesTask objects by first
@@ -106,22 +107,22 @@ namespace d3d
 		\ref draw_primitives_tasks.
 		@param render_primitives The DrawPrimitivesTask
 		objects will be generated from these.
-		@param textures The texture map defining the textures used by any
-		textured RenderPrimitive objects.
+		@param textures The textures used by any textured RenderPrimitive
+		objects. Each one is marked as drawn in the current frame.
 		@throws avl::utility::OutOfMemoryError If we run out of memory.
 		@throws RendererException If we find an unsupported
 		RenderPrimitive type.
 		*/
-		void GenerateDrawPrimitivesTasks(const utility::RenderPrimitiveList& render_primitives, TexHandleToTexContext& textures);
+		void GenerateDrawPrimitivesTasks(const utility::RenderPrimitiveList& render_primitives, TextureResidency& textures);
 		/** Given a TexturedQuad object, generates a corresponding
 		DrawPrimitivesTask object. The generated DrawPrimitivesTask
 		object is inserted into \ref draw_primitives_tasks.
 		@param quad The DrawPrimitivesTask object is based on this.
-		@param textures The texture map defining the texture used by
-		\a quad.
+		@param textures The textures, including the one used by \a quad,
+		which is marked as drawn in the current frame.
 		@throws avl::utility::OutOfMemoryError If we run out of memory.
 		*/
-		void GenerateDrawPrimitivesTask(const utility::TexturedQuad& quad, TexHandleToTexContext& textures);
+		void GenerateDrawPrimitivesTask(const utility::TexturedQuad& quad, TextureResidency& textures);
 		
 		/** Sorts \ref draw_primitives_tasks using the less-than
 		operator defined in the DrawPrimitivesTask class.
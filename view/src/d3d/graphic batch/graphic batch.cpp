@@ -27,6 +27,7 @@ Implementation for the graphic batch component. See "graphic batch.h" for detail
 #include"..\wrapper functions\wrapper functions.h"
 #include"..\render context\render context.h"
 #include"..\texture context\texture context.h"
+#include"..\texture residency\texture residency.h"
 #include"..\d3d error\d3d error.h"
 #include"..\render task\render task.h"
 #include"..\..\..\..\utility\src\graphic\graphic.h"
@@ -45,7 +46,7 @@ namespace d3d
 {
 
 	// See method declaration for details.
-	GraphicBatch::GraphicBatch(const utility::GraphicList& graphics, TexHandleToTexContext& textures)
+	GraphicBatch::GraphicBatch(const utility::GraphicList& graphics, TextureResidency& textures)
 	{
 		
 		DrawPrimitivesTaskList draw_primitive_tasks(graphics, textures);
@@ -25,6 +25,7 @@ Defines the GraphicBatch class.
 */
 
 #include"..\texture context\texture context.h"
+#include"..\texture residency\texture residency.h"
 #include"..\render task\render task.h"
 #include"..\wrapper functions\wrapper functions.h"
 #include"..\draw primitives task\draw primitives task.h"
@@ -55,7 +56,7 @@ namespace d3d
 	class GraphicBatch
 	{
 	public:
-		GraphicBatch(const utility::GraphicList& graphics, TexHandleToTexContext& textures);
+		GraphicBatch(const utility::GraphicList& graphics, TextureResidency& textures);
 		~GraphicBatch();
 
 		void Render(RenderContext& render_context);
@@ -49,13 +49,15 @@ namespace d3d
 
 	// See method declaration for details.
 	TextureContext::TextureContext(IDirect3DTexture9& initial_texture, const bool translucent)
-		: texture(initial_texture), is_translucent(translucent)
+		: texture(&initial_texture), is_translucent(translucent), size(0), last_used_frame(0), generate_mipmaps(false), is_resident(true), reload_failed_frame(0), content_hash(0), reference_count(1)
 	{
 	}
 
 	// See method declaration for details.
 	TextureContext::TextureContext(const TextureContext& original)
-		: texture(original.texture), is_translucent(original.is_translucent)
+		: texture(original.texture), is_translucent(original.is_translucent), size(original.size), last_used_frame(original.last_used_frame),
+		source(original.source), generate_mipmaps(original.generate_mipmaps), is_resident(original.is_resident), reload_failed_frame(original.reload_failed_frame),
+		content_hash(original.content_hash), reference_count(original.reference_count)
 	{
 	}
 
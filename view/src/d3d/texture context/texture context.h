@@ -27,6 +27,8 @@ structure.
 
 #include"..\..\..\..\utility\src\textured quad\textured quad.h"
 #include<map>
+#include<string>
+#include<cstddef>
 #ifdef _DEBUG
 #define D3D_DEBUG_INFO
 #endif
@@ -56,7 +58,8 @@ namespace d3d
 
 	/**
 	Groups together a texture and a flag specifying whether
-	or not the texture is translucent.
+	or not the texture is translucent, along with what's needed
+	to evict it from texture memory and load it again.
 	*/
 	struct TextureContext
 	{
@@ -65,8 +68,27 @@ namespace d3d
 		TextureContext(const TextureContext& original);
 		~TextureContext();
 
-		const bool is_translucent;
-		IDirect3DTexture9& texture;
+		bool is_translucent;
+		/// The texture drawn. It's replaced in place when the texture is uploaded, evicted, or
+		/// loaded again, so that swapping it can't fail.
+		IDirect3DTexture9* texture;
+		/// The number of bytes of texture memory used by \ref texture.
+		std::size_t size;
+		/// The frame in which the texture was last drawn.
+		unsigned int last_used_frame;
+		/// The image file which the texture can be loaded from again, or empty if it can't be evicted.
+		std::string source;
+		/// Whether the mipmaps of \ref source are generated when it's loaded again.
+		bool generate_mipmaps;
+		/// False while the texture is evicted, in which case \ref texture is a placeholder.
+		bool is_resident;
+		/// The frame in which loading \ref source again last failed, or 0 if it hasn't.
+		unsigned int reload_failed_frame;
+		/// The hash of the image which the texture was created from, so that identical images can
+		/// share it.
+		unsigned long long content_hash;
+		/// The number of times the texture has been added and not yet deleted.
+		unsigned int reference_count;
 
 	private:
 		/// NOT IMPLEMENTED.
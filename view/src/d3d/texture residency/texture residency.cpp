@@ -0,0 +1,240 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the texture residency component. See "texture residency.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"texture residency.h"
+#include"..\texture context\texture context.h"
+#include"..\..\renderer\renderer.h"
+#include"..\..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\..\utility\src\assert\assert.h"
+#include<vector>
+#include<algorithm>
+#include<new>
+#ifdef _DEBUG
+#define D3D_DEBUG_INFO
+#endif
+#include<d3d9.h>
+
+
+namespace avl
+{
+namespace view
+{
+namespace d3d
+{
+
+	// Anonymous namespace.
+	namespace
+	{
+		const bool WasUsedEarlier(const TexHandleToTexContext::iterator& first, const TexHandleToTexContext::iterator& second);
+	}
+
+
+
+	// See method declaration for details.
+	TextureResidency::Reloader::~Reloader()
+	{
+	}
+
+	// See method declaration for details.
+	TextureResidency::TextureResidency(TexHandleToTexContext& textures, IDirect3DTexture9& placeholder, Reloader& reloader)
+		: textures(textures), placeholder(placeholder), reloader(reloader), budget(0), frame(1), hit_count(0), miss_count(0), eviction_count(0), reload_failure_count(0)
+	{
+	}
+
+	// See method declaration for details.
+	TextureResidency::~TextureResidency()
+	{
+	}
+
+	// See method declaration for details.
+	TextureContext& TextureResidency::UseTexture(const utility::TexturedQuad::TextureHandle handle)
+	{
+		TexHandleToTexContext::iterator context = textures.find(handle);
+		if(context == textures.end())
+		{
+			throw RendererException("avl::view::d3d::TextureResidency::UseTexture() -- Invalid texture handle used.");
+		}
+		if(context->second.is_resident == true)
+		{
+			++hit_count;
+		}
+		else if(context->second.source.empty() == false
+			&& (context->second.reload_failed_frame == 0 || frame - context->second.reload_failed_frame >= RELOAD_RETRY_FRAMES))
+		{
+			++miss_count;
+			IDirect3DTexture9* texture = nullptr;
+			std::size_t size = 0;
+			try
+			{
+				texture = &reloader.ReloadTexture(context->second, size);
+			}
+			catch(const utility::FileNotFoundException&)
+			{
+				// The source is gone, so keep drawing the placeholder for good.
+				++reload_failure_count;
+				context->second.source.clear();
+			}
+			catch(const utility::FileFormatException&)
+			{
+				// The source can't be decoded, so keep drawing the placeholder for good.
+				++reload_failure_count;
+				context->second.source.clear();
+			}
+			catch(const utility::Exception&)
+			{
+				// The failure may pass, so keep drawing the placeholder for a while and then try again.
+				++reload_failure_count;
+				context->second.reload_failed_frame = frame;
+			}
+			if(texture != nullptr)
+			{
+				context->second.texture = texture;
+				context->second.size = size;
+				context->second.reload_failed_frame = 0;
+				placeholder.Release();
+				context->second.is_resident = true;
+			}
+		}
+		context->second.last_used_frame = frame;
+		return context->second;
+	}
+
+	// See method declaration for details.
+	void TextureResidency::EndFrame()
+	{
+		const std::size_t resident_size = GetResidentSize();
+		if(budget != 0 && resident_size > budget)
+		{
+			// Gather the textures which may be evicted, least recently drawn first.
+			std::vector<TexHandleToTexContext::iterator> candidates;
+			try
+			{
+				for(TexHandleToTexContext::iterator i = textures.begin(); i != textures.end(); ++i)
+				{
+					if(i->second.is_resident == true && i->second.source.empty() == false && i->second.last_used_frame < frame)
+					{
+						candidates.push_back(i);
+					}
+				}
+			}
+			catch(const std::bad_alloc&)
+			{
+				throw utility::OutOfMemoryError();
+			}
+			std::sort(candidates.begin(), candidates.end(), &WasUsedEarlier);
+
+			std::size_t remaining_size = resident_size;
+			for(std::vector<TexHandleToTexContext::iterator>::iterator i = candidates.begin(); i != candidates.end() && remaining_size > budget; ++i)
+			{
+				TextureContext& context = (*i)->second;
+				placeholder.AddRef();
+				context.texture->Release();
+				context.texture = &placeholder;
+				remaining_size -= context.size;
+				context.is_resident = false;
+				++eviction_count;
+			}
+		}
+		++frame;
+	}
+
+	// See method declaration for details.
+	void TextureResidency::SetBudget(const std::size_t bytes)
+	{
+		budget = bytes;
+	}
+
+	// See method declaration for details.
+	const std::size_t TextureResidency::GetBudget() const
+	{
+		return budget;
+	}
+
+	// See method declaration for details.
+	const std::size_t TextureResidency::GetResidentSize() const
+	{
+		std::size_t size = 0;
+		for(TexHandleToTexContext::const_iterator i = textures.begin(); i != textures.end(); ++i)
+		{
+			if(i->second.is_resident == true)
+			{
+				size += i->second.size;
+			}
+		}
+		return size;
+	}
+
+	// See method declaration for details.
+	const unsigned int TextureResidency::GetHitCount() const
+	{
+		return hit_count;
+	}
+
+	// See method declaration for details.
+	const unsigned int TextureResidency::GetMissCount() const
+	{
+		return miss_count;
+	}
+
+	// See method declaration for details.
+	const unsigned int TextureResidency::GetEvictionCount() const
+	{
+		return eviction_count;
+	}
+
+	// See method declaration for details.
+	const unsigned int TextureResidency::GetReloadFailureCount() const
+	{
+		return reload_failure_count;
+	}
+
+	// See method declaration for details.
+	void TextureResidency::ResetCounts()
+	{
+		hit_count = 0;
+		miss_count = 0;
+		eviction_count = 0;
+		reload_failure_count = 0;
+	}
+
+
+
+	// Anonymous namespace.
+	namespace
+	{
+		/** Orders texture contexts by when they were last drawn.
+		@param first The first texture context.
+		@param second The second texture context.
+		@return True if \a first was drawn before \a second.
+		*/
+		const bool WasUsedEarlier(const TexHandleToTexContext::iterator& first, const TexHandleToTexContext::iterator& second)
+		{
+			return first->second.last_used_frame < second->second.last_used_frame;
+		}
+	}
+
+
+
+} // d3d
+} // view
+} // avl
@@ -0,0 +1,178 @@
+#pragma once
+#ifndef AVL_VIEW_TEXTURE_RESIDENCY__
+#define AVL_VIEW_TEXTURE_RESIDENCY__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Defines the \ref avl::view::d3d::TextureResidency class.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"..\texture context\texture context.h"
+#include"..\..\..\..\utility\src\textured quad\textured quad.h"
+#include<cstddef>
+#ifdef _DEBUG
+#define D3D_DEBUG_INFO
+#endif
+#include<d3d9.h>
+
+
+namespace avl
+{
+namespace view
+{
+namespace d3d
+{
+	/**
+	Keeps the textures in a texture map within a budget of texture memory. Textures are
+	marked as they're drawn; once a frame is over, the least recently drawn textures are
+	evicted until the rest fit, and their handles are bound to a placeholder. An evicted
+	texture is loaded again from its source the next time it's drawn. Textures drawn in
+	the current frame, and those without a source, are never evicted.
+	@par Reloading:
+	An evicted texture is loaded again synchronously, from within \ref UseTexture(), so the
+	frame which next draws it stalls while its source is read and decoded. A texture whose
+	source is missing or can't be decoded keeps the placeholder for good. Any other failure,
+	such as running out of memory, may pass, so the texture keeps the placeholder for a
+	while and is then tried again.
+	*/
+	class TextureResidency
+	{
+	public:
+		/**
+		Loads evicted textures again. Implemented by whatever creates the textures.
+		*/
+		class Reloader
+		{
+		public:
+			/** Basic destructor.*/
+			virtual ~Reloader();
+
+			/** Creates the texture for \a context again from its source.
+			@param context The evicted texture's context.
+			@param size [OUT] Receives the number of bytes of texture memory used by the texture.
+			@return The texture, which the caller takes a reference to.
+			@throws FileNotFoundException If the source doesn't exist.
+			@throws FileFormatException If the source can't be loaded.
+			@throws D3DError If unable to create the texture.
+			*/
+			virtual IDirect3DTexture9& ReloadTexture(const TextureContext& context, std::size_t& size) = 0;
+		};
+
+		/// The number of frames to wait before loading a texture again after a failure which may pass.
+		static const unsigned int RELOAD_RETRY_FRAMES = 60;
+
+		/** Basic constructor.
+		@param textures The texture map to manage. Must outlive this object.
+		@param placeholder The texture which evicted handles are bound to. Each eviction takes a
+		reference to it. Must outlive this object.
+		@param reloader Loads evicted textures again. Must outlive this object.
+		*/
+		TextureResidency(TexHandleToTexContext& textures, IDirect3DTexture9& placeholder, Reloader& reloader);
+		/** Basic destructor.*/
+		~TextureResidency();
+
+		/** Obtains the texture context associated with \a handle, to draw it in the current
+		frame. If the texture was evicted, it's loaded again first. If that fails, the failure
+		is counted and the placeholder stays bound. A source which is missing or can't be
+		decoded is cleared so that it isn't tried again; after any other failure, the texture
+		isn't tried again until \ref RELOAD_RETRY_FRAMES frames have passed.
+		@param handle The handle to get the texture context for.
+		@return The texture context, which is valid until the next call.
+		@throws RendererException If \a handle is not mapped to any texture.
+		*/
+		TextureContext& UseTexture(const utility::TexturedQuad::TextureHandle handle);
+
+		/** Ends the current frame: evicts the least recently drawn textures until the resident
+		ones fit within the budget, then starts a new frame.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		void EndFrame();
+
+		/** Sets the budget of texture memory.
+		@param bytes The number of bytes which resident textures may take up, or 0 for no limit.
+		*/
+		void SetBudget(const std::size_t bytes);
+
+		/** Accesses the budget of texture memory.
+		@return The number of bytes which resident textures may take up, or 0 for no limit.
+		*/
+		const std::size_t GetBudget() const;
+
+		/** Adds up the texture memory used by resident textures.
+		@return The number of bytes used.
+		*/
+		const std::size_t GetResidentSize() const;
+
+		/** Counts the times a resident texture was drawn.
+		@return The number of hits.
+		*/
+		const unsigned int GetHitCount() const;
+
+		/** Counts the times an evicted texture had to be loaded again to be drawn.
+		@return The number of misses.
+		*/
+		const unsigned int GetMissCount() const;
+
+		/** Counts the textures which have been evicted.
+		@return The number of evictions.
+		*/
+		const unsigned int GetEvictionCount() const;
+
+		/** Counts the evicted textures which couldn't be loaded again, and are drawn as the
+		placeholder instead.
+		@return The number of failed reloads.
+		*/
+		const unsigned int GetReloadFailureCount() const;
+
+		/** Resets the hit, miss, eviction, and reload failure counts to zero.*/
+		void ResetCounts();
+
+	private:
+		/// The texture map being managed.
+		TexHandleToTexContext& textures;
+		/// The texture which evicted handles are bound to.
+		IDirect3DTexture9& placeholder;
+		/// Loads evicted textures again.
+		Reloader& reloader;
+		/// The number of bytes which resident textures may take up, or 0 for no limit.
+		std::size_t budget;
+		/// The current frame.
+		unsigned int frame;
+		/// The number of times a resident texture was drawn.
+		unsigned int hit_count;
+		/// The number of times an evicted texture was loaded again.
+		unsigned int miss_count;
+		/// The number of textures evicted.
+		unsigned int eviction_count;
+		/// The number of evicted textures which couldn't be loaded again.
+		unsigned int reload_failure_count;
+
+		/// NOT IMPLEMENTED.
+		TextureResidency(const TextureResidency&);
+		/// NOT IMPLEMENTED.
+		const TextureResidency& operator=(const TextureResidency&);
+	};
+
+
+
+} // d3d
+} // view
+} // avl
+#endif // AVL_VIEW_TEXTURE_RESIDENCY__
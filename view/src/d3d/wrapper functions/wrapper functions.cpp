@@ -293,7 +293,7 @@ namespace d3d
 
 	// See function declaration for details.
 	void CopyPixelDataToTexture(IDirect3DTexture9& destination, const unsigned char* const pixel_data,
-									const unsigned int& width, const unsigned int& height, const unsigned int& bytes_per_pixel)
+									const unsigned int& width, const unsigned int& height, const unsigned int& bytes_per_pixel, const unsigned int& level)
 	{
 		ASSERT(pixel_data != nullptr);
 		// If pixel_data is nullptr, throw an error describing the problem.
@@ -301,9 +301,9 @@ namespace d3d
 		{
 			throw utility::InvalidArgumentException("avl::view::d3d::CopyPixelDataToTexture()", "pixel_data", "Can not be null.");
 		}
-		// First access the texture's surface data.
+		// First access the surface data of the texture's level.
 		IDirect3DSurface9* surface = nullptr;
-		HRESULT result = destination.GetSurfaceLevel(0, &surface);
+		HRESULT result = destination.GetSurfaceLevel(level, &surface);
 		// If accessing the texture's surface data failed, throw a D3DError with the error code and a description.
 		if (FAILED(result))
 		{
@@ -354,6 +354,72 @@ namespace d3d
 	}
 
 
+	// See function declaration for details.
+	void CopyBlockDataToTexture(IDirect3DTexture9& destination, const unsigned char* const block_data,
+									const unsigned int& width, const unsigned int& height, const unsigned int& bytes_per_block, const unsigned int& level)
+	{
+		ASSERT(block_data != nullptr);
+		// If block_data is nullptr, throw an error describing the problem.
+		if(block_data == nullptr)
+		{
+			throw utility::InvalidArgumentException("avl::view::d3d::CopyBlockDataToTexture()", "block_data", "Can not be null.");
+		}
+		// Lock the entire level of the texture.
+		D3DLOCKED_RECT rectangle;
+		HRESULT result = destination.LockRect(level, &rectangle, nullptr, 0);
+		if(FAILED(result))
+		{
+			throw D3DError("IDirect3DTexture9::LockRect()", "avl::view::d3d::CopyBlockDataToTexture() -- Unable to lock texture.", result);
+		}
+		// For a compressed texture, the pitch is the distance between rows of blocks rather than rows of pixels.
+		const unsigned int row_size = ((width + 3) / 4) * bytes_per_block;
+		const unsigned int block_rows = (height + 3) / 4;
+		for(unsigned int row = 0; row < block_rows; ++row)
+		{
+			memcpy((unsigned char*)rectangle.pBits + rectangle.Pitch*row, block_data + row_size * row, row_size);
+		}
+		// Unlock the texture.
+		result = destination.UnlockRect(level);
+		if(FAILED(result))
+		{
+			throw D3DError("IDirect3DTexture9::UnlockRect()", "avl::view::d3d::CopyBlockDataToTexture() - Unable to unlock the texture.", result);
+		}
+	}
+
+
+	// See function declaration for details.
+	bool IsTextureLevelData(IDirect3DTexture9& texture, const unsigned char* const data,
+								const unsigned int& row_size, const unsigned int& row_count, const unsigned int& level)
+	{
+		ASSERT(data != nullptr);
+		// If data is nullptr, throw an error describing the problem.
+		if(data == nullptr)
+		{
+			throw utility::InvalidArgumentException("avl::view::d3d::IsTextureLevelData()", "data", "Can not be null.");
+		}
+		// Lock the entire level of the texture, only to read it.
+		D3DLOCKED_RECT rectangle;
+		HRESULT result = texture.LockRect(level, &rectangle, nullptr, D3DLOCK_READONLY);
+		if(FAILED(result))
+		{
+			throw D3DError("IDirect3DTexture9::LockRect()", "avl::view::d3d::IsTextureLevelData() -- Unable to lock texture.", result);
+		}
+		// Compare row by row, skipping the padding at the end of each row of the surface.
+		bool is_equal = true;
+		for(unsigned int row = 0; row < row_count && is_equal == true; ++row)
+		{
+			is_equal = (memcmp((const unsigned char*)rectangle.pBits + rectangle.Pitch*row, data + row_size * row, row_size) == 0);
+		}
+		// Unlock the texture.
+		result = texture.UnlockRect(level);
+		if(FAILED(result))
+		{
+			throw D3DError("IDirect3DTexture9::UnlockRect()", "avl::view::d3d::IsTextureLevelData() - Unable to unlock the texture.", result);
+		}
+		return is_equal;
+	}
+
+
 	// See function declaration for details.
 	bool IsTextureFormatOk(IDirect3D9& d3d, D3DFORMAT& adapter_format, D3DFORMAT& format)
 	{
@@ -365,13 +431,13 @@ namespace d3d
 
 
 	// See function declaration for details.
-	IDirect3DTexture9* CreateTexture(IDirect3DDevice9& device, const unsigned int& width, const unsigned int& height, D3DFORMAT format)
+	IDirect3DTexture9* CreateTexture(IDirect3DDevice9& device, const unsigned int& width, const unsigned int& height, D3DFORMAT format, const unsigned int& levels)
 	{
 		// Temporarily stores the texture's address.
 		IDirect3DTexture9* texture = nullptr;
 		// Attempt to create the texture; if this fails, throw a D3DError with the error code and a
 		// description of the problem.
-		HRESULT result = device.CreateTexture(width, height, 1, 0, format, D3DPOOL_MANAGED, &texture, nullptr);
+		HRESULT result = device.CreateTexture(width, height, levels, 0, format, D3DPOOL_MANAGED, &texture, nullptr);
 		if(FAILED(result))
 		{
 			throw D3DError("IDirect3DDevice9::CreateTexture()", "avl::view::d3d::CreateTexture() - Unable to create a new texture.", result);
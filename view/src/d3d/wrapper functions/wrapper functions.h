@@ -144,11 +144,12 @@ namespace d3d
 	@param width The width in pixels of \a pixel_data.
 	@param height The height in pixels of \a pixel_data.
 	@param bytes_per_pixel The number of bytes of data per pixel.
+	@param level The mip level of \a destination to copy to, whose dimensions must be \a width by \a height.
 	@throws InvalidArgumentException If \a pixel_data is \c nullptr.
 	@throws D3DError If unable to lock or unlock the surface of \a destination.
 	*/
 	void CopyPixelDataToTexture(IDirect3DTexture9& destination, const unsigned char* const pixel_data,
-								const unsigned int& width, const unsigned int& height, const unsigned int& bytes_per_pixel);
+								const unsigned int& width, const unsigned int& height, const unsigned int& bytes_per_pixel, const unsigned int& level = 0);
 
 	/** Attempts to copy pixel_data into the destination surface, taking into account the pitch of \a destination.
 	@pre \a destination must be a lockable Direct3D surface, and \a pixel_data must point to a block of pixel data
@@ -163,6 +164,37 @@ namespace d3d
 	*/
 	void CopyPixelDataToSurface(IDirect3DSurface9& destination, const unsigned char* const pixel_data,
 									const unsigned int& width, const unsigned int& height, const unsigned int& bytes_per_pixel);
+
+	/** Attempts to copy block-compressed data into a level of the destination texture, one row of
+	blocks at a time, taking into account the pitch of the destination surface.
+	@pre \a destination must be a lockable texture in a block-compressed format, and \a block_data must
+	point to \c ceil(width/4)*ceil(height/4)*bytes_per_block bytes of blocks.
+	@param destination The texture to which \a block_data is to be copied.
+	@param block_data The compressed data to be copied to \a destination.
+	@param width The width of the image in pixels.
+	@param height The height of the image in pixels.
+	@param bytes_per_block The number of bytes in each 4x4 block; 8 for DXT1, and 16 for DXT5.
+	@param level The mip level of \a destination to copy to, whose dimensions must be \a width by \a height.
+	@throws InvalidArgumentException If \a block_data is \c nullptr.
+	@throws D3DError If unable to lock or unlock \a destination.
+	*/
+	void CopyBlockDataToTexture(IDirect3DTexture9& destination, const unsigned char* const block_data,
+									const unsigned int& width, const unsigned int& height, const unsigned int& bytes_per_block, const unsigned int& level = 0);
+
+	/** Compares data with a level of a texture, one row at a time, taking into account the pitch of
+	the level's surface. The level is locked read-only.
+	@pre \a texture must be a lockable texture, and \a data must point to \c row_size*row_count bytes.
+	@param texture The texture to compare \a data with.
+	@param data The data to compare; rows of pixels, or rows of blocks for a block-compressed texture.
+	@param row_size The number of bytes in each row of \a data.
+	@param row_count The number of rows in \a data.
+	@param level The mip level of \a texture to compare \a data with.
+	@return True if the level holds the same data as \a data, and false if not.
+	@throws InvalidArgumentException If \a data is \c nullptr.
+	@throws D3DError If unable to lock or unlock \a texture.
+	*/
+	bool IsTextureLevelData(IDirect3DTexture9& texture, const unsigned char* const data,
+								const unsigned int& row_size, const unsigned int& row_count, const unsigned int& level = 0);
 		
 	/** Checks to see if the device supports textures in the specified format.
 	@param d3d A Direct3D9 object on which to test the texture format.
@@ -172,18 +204,19 @@ namespace d3d
 	*/
 	bool IsTextureFormatOk(IDirect3D9& d3d, D3DFORMAT& adapter_format, D3DFORMAT& format);
 		
-	/** Attempts to create a texture with the specified width, height, and format.
-	Textures are created in the \c MANAGED Direct3D pool and with 1 level.
+	/** Attempts to create a texture with the specified width, height, format, and number of mip levels.
+	Textures are created in the \c MANAGED Direct3D pool.
 	@param device The device on which to create the texture.
 	@param width The desired width of the texture.
 	@param height The desired height of the texture.
 	@param format The desired format of the texture.
+	@param levels The number of mip levels, including the top level.
 	@note You can check to see if the device supports the creation of textures of a format by using
 	\ref avl::view::D3DRendererBase::IsTextureFormatOk().
 	@sa avl::view::D3DRendererBase::IsTextureFormatOk()
 	@throws D3DError If the creation of the texture fails.
 	*/
-	IDirect3DTexture9* CreateTexture(IDirect3DDevice9& device, const unsigned int& width, const unsigned int& height, D3DFORMAT format);
+	IDirect3DTexture9* CreateTexture(IDirect3DDevice9& device, const unsigned int& width, const unsigned int& height, D3DFORMAT format, const unsigned int& levels = 1);
 		
 	/** Attempts to create a vertex buffer capable of storing \a buffer_length vertices. The expected vertex format
 	consists of spatial coordinates (XYZ) and one set of texture coordinates. The created buffer is dynamic and
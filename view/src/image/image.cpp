@@ -22,11 +22,19 @@ Implementation for the image component. See "image.h" for details.
 */
 
 #include"image.h"
+#include"..\block compression\block compression.h"
+#include"..\mipmap\mipmap.h"
 #include"..\..\..\utility\src\exceptions\exceptions.h"
 #include"..\..\..\utility\src\assert\assert.h"
+#include"..\..\..\utility\src\file operations\file operations.h"
+#include"..\..\..\utility\src\pack file\pack file.h"
+#include"..\..\..\utility\src\inflate\inflate.h"
 #include<memory>
-#include<fstream>
+#include<vector>
+#include<cstring>
+#include<cstdlib>
 #include<new>
+#include<emmintrin.h>
 
 
 
@@ -35,6 +43,46 @@ namespace avl
 namespace view
 {
 
+	// Anonymous namespace.
+	namespace
+	{
+		/** Writes decoded pixels straight to where they belong in the final image, so that
+		the image's orientation is applied while it's decoded rather than in separate passes.
+		Pixels are written in the order they're stored in the file.*/
+		struct PixelWriter
+		{
+			/// The destination pixel data.
+			unsigned char* pixel_data;
+			/// The width of the image in pixels.
+			unsigned int width;
+			/// The height of the image in pixels.
+			unsigned int height;
+			/// The number of bytes per pixel.
+			unsigned int pixel_depth;
+			/// If true, the file's first row is the image's last row.
+			bool swap_rows;
+			/// If true, each row is stored in the file right to left.
+			bool mirror_rows;
+			/// The row of the file being decoded.
+			unsigned int row;
+			/// The next pixel of the row being decoded, in file order.
+			unsigned int column;
+			/// Set once a pixel with an alpha value other than 0 or 0xFF is written.
+			bool is_translucent;
+		};
+
+		void WritePixels(PixelWriter& writer, const unsigned char* source, unsigned int count, const bool is_run);
+		void FillPixels(unsigned char* const destination, const unsigned char* const pixel, const unsigned int count, const unsigned int pixel_depth);
+		void CopyPixelsReversed(unsigned char* const destination, const unsigned char* const source, const unsigned int count, const unsigned int pixel_depth);
+		const bool IsAnyPixelTranslucent(const unsigned char* const pixels, const unsigned int count);
+		const bool UnfilterPNGRow(unsigned char* const row, const unsigned char* const previous_row, const std::size_t row_size, const unsigned int pixel_size, const unsigned char filter);
+		const unsigned int ReadBigEndian32(const unsigned char* const data);
+		const unsigned int ReadLittleEndian32(const unsigned char* const data);
+		const unsigned short ReadLittleEndian16(const unsigned char* const data);
+		void WriteLittleEndian32(unsigned char* const data, const unsigned int value);
+	}
+
+
 
 	// See method declaration for details.
 	bool LoadImageTGA(const std::string& file_name, unsigned int& width, unsigned int& height, unsigned short& pixel_depth, bool& contains_alpha_channel, bool& is_translucent, unsigned char*& pixel_data)
@@ -43,32 +91,18 @@ namespace view
 		
 		try
 		{
-			// Attempt to open the file specified. If this fails, return false.
-			ifstream file(file_name.c_str(), ios_base::in | ios_base::binary);
-			if(file.good() == false)
-			{
-				return false;
-			}
+			// Decode straight out of the mapped file or pack file entry. If it can't be opened, this
+			// throws and we return false below.
+			const utility::MappedFile file = utility::OpenAssetFile(file_name);
+			const unsigned char* const file_data = reinterpret_cast<const unsigned char*>(file.GetData());
+			const std::size_t file_size = file.GetSize();
 
-			// Get the file size.
-			file.seekg(0, ios_base::end);
-			unsigned long file_size = (unsigned long)file.tellg();
-			file.seekg(0, ios_base::beg);
-
-			// If unable to allocate memory for file_data, return false.
-			unsigned char* file_data = new(std::nothrow) unsigned char[file_size];
-			if(file_data == nullptr)
+			// If the file is too small to hold a header, return false.
+			if(file_size < 18)
 			{
-				file.close();
 				return false;
 			}
 
-			// Copy the file contents to memory for safer reading.
-			file.read((char*)file_data, file_size);
-
-			// Done with the file -- close it.
-			file.close();
-
 
 
 			//
@@ -98,33 +132,29 @@ namespace view
 			memcpy(&y1,&file_data[10],2);
 			memcpy(&x2,&file_data[12],2);
 			memcpy(&y2,&file_data[14],2);
- 
-			width = (x2 - x1);
-			height = (y2 - y1);
-		
+
 			// If the width or height are less than 1, return false.
-			if(width < 1 || height < 1)
+			if(x2 <= x1 || y2 <= y1)
 			{
 				return false;
 			}
+			width = (x2 - x1);
+			height = (y2 - y1);
 
 			// Retrieve the pixel depth.
 			ASSERT(file_data[16] % 8 == 0);
 			pixel_depth = file_data[16] / 8;
-
-			// Calculate the size of the image data.
-			unsigned long image_size = width * height * pixel_depth;
-
-			// Check to see if the image is flipped either horizontall, vertically, or both.
-			bool flipped_horizontally = false;
-			bool flipped_vertically = false;
-			if(file_data[17] & 16)
+			if(pixel_depth == 0)
 			{
-				flipped_horizontally = true;
+				return false;
 			}
-			if(file_data[17] & 32)
+
+			// Calculate the size of the image data. The dimensions are 16-bit, so this can only
+			// overflow where size_t is 32-bit.
+			const unsigned long long image_size = static_cast<unsigned long long>(width) * height * pixel_depth;
+			if(image_size != static_cast<std::size_t>(image_size))
 			{
-				flipped_vertically = true;
+				return false;
 			}
 
 			// If the image is interleaved, return false.
@@ -134,14 +164,7 @@ namespace view
 			}
 
 			// If the pixel depth is 4 (32 bits), the image has an alpha channel.
-			if(pixel_depth == 4)
-			{
-				contains_alpha_channel = true;
-			}
-			else
-			{
-				contains_alpha_channel = false;
-			}
+			contains_alpha_channel = (pixel_depth == 4);
 
 			// If there are any color map entries, return false.
 			unsigned short color_map_entries;
@@ -152,187 +175,485 @@ namespace view
 			}
 
 
+			// If the pixel data starts past the end of the file, return false.
+			const std::size_t offset = file_data[0] + 18;
+			if(offset > file_size)
+			{
+				return false;
+			}
+			const unsigned char* const end = file_data + file_size;
+
 			// Done with the header. Allocate memory for the pixel data.
-			pixel_data = new(std::nothrow) unsigned char[image_size];
+			pixel_data = new(std::nothrow) unsigned char[static_cast<std::size_t>(image_size)];
 			if(pixel_data == nullptr)
 			{
 				return false;
 			}
 
-			// Now copy the pixel data based on the encoding.
-			unsigned short offset = file_data[0] + 18;
-			switch(encoding)
+			// Bit 16 of the descriptor swaps the order of the rows, and bit 32 reverses each row.
+			// Only 32-bit images are checked for translucency.
+			PixelWriter writer;
+			writer.pixel_data = pixel_data;
+			writer.width = width;
+			writer.height = height;
+			writer.pixel_depth = pixel_depth;
+			writer.swap_rows = (file_data[17] & 16) != 0;
+			writer.mirror_rows = (file_data[17] & 32) != 0;
+			writer.row = 0;
+			writer.column = 0;
+			writer.is_translucent = (contains_alpha_channel == false);
+
+			// Now decode the pixel data based on the encoding, in a single pass.
+			const unsigned char* current = &file_data[offset];
+			const std::size_t pixel_count = static_cast<std::size_t>(width) * height;
+			if(encoding == 2)
 			{
-			case 2:
 				// Raw RGB(A).
-				memcpy(pixel_data, &file_data[offset], image_size);
-				break;
-			case 10:
-				// RLE RGB(A).
-
-				// Points to the current run-length chunk/pixel data. Start from the beginning of the image data.
-				unsigned char* current;
-				current = &file_data[offset];
-				// Index in bytes to the beginning of the current run-length chunk/pixel data.
-				unsigned long index;
-				index = 0;
-				// The run length of each encoding chunk
-				unsigned char run_length;
-				// Loop counter.
-				unsigned char i;
-
-				// Unpack the encoded pixel data.
-				while(index < image_size)
-				{
-					// Is this section encoded?
-					if(*current & 0x80)
+				if(image_size > static_cast<std::size_t>(end - current))
+				{
+					delete[] pixel_data;
+					return false;
+				}
+				for(unsigned int row = 0; row < height; ++row, current += width * pixel_depth)
+				{
+					WritePixels(writer, current, width, false);
+				}
+			}
+			else
+			{
+				// RLE RGB(A). Each packet begins with a byte whose high bit says whether it's a run
+				// of one repeated pixel or a literal series of pixels, and whose low 7 bits hold one
+				// less than the number of pixels.
+				std::size_t decoded = 0;
+				while(decoded < pixel_count)
+				{
+					// The file may not be truncated mid-packet; it's mapped, so reading past the end
+					// would fault rather than just read garbage.
+					if(current >= end)
 					{
-						// Get the run length.
-						run_length = *current - 127;
-						// Scoot up past the run-length chunk to the pixel data.
-						++current;
-						// For the length of this run-length, put that many copies of the current
-						// pixel into pixel_data
-						for(i = 0; i < run_length; ++i, index += pixel_depth)
-						{
-							memcpy(&pixel_data[index], current, pixel_depth);
-						}
-						// Scoot up to the next run-length chunk.
-						current += pixel_depth;
+						delete[] pixel_data;
+						return false;
 					}
-					// This section isn't encoded.
-					else
+					const bool is_run = (*current & 0x80) != 0;
+					const unsigned int run_length = (*current & 0x7F) + 1;
+					const std::size_t packet_size = 1 + (is_run == true ? 1 : run_length) * pixel_depth;
+					// Packets may not spill past the end of the file or the image.
+					if(packet_size > static_cast<std::size_t>(end - current) || run_length > pixel_count - decoded)
 					{
-						// Figure out how many pixels are in this unencoded run.
-						run_length = *current + 1;
-						// Scoot up the pixel data.
-						++current;
-						// For each pixel in the unencoded run, copy it to the pixel data.
-						for(i = 0; i < run_length; ++i, current += pixel_depth, index += pixel_depth)
-						{
-							memcpy(&pixel_data[index], current, pixel_depth);
-						}
+						delete[] pixel_data;
+						return false;
 					}
+					WritePixels(writer, current + 1, run_length, is_run);
+					decoded += run_length;
+					current += packet_size;
 				}
-				break;
-			default: // Return false if the encoding is unsupported.
+			}
+
+			// Check to see if the image contains any translucent pixels.
+			is_translucent = (contains_alpha_channel == true && writer.is_translucent == true);
+
+			// Return success.
+			return true;
+
+
+			}
+		// If an exception occurred while reading from the file, simply return false.
+		catch(...)
+		{
+			return false;
+		}
+	}
+
+
+
+
+
+
+	// See method declaration for details.
+	bool LoadImagePNG(const std::string& file_name, unsigned int& width, unsigned int& height, unsigned short& pixel_depth, bool& contains_alpha_channel, bool& is_translucent, unsigned char*& pixel_data)
+	{
+		try
+		{
+			const utility::MappedFile file = utility::OpenAssetFile(file_name);
+			const unsigned char* const file_data = reinterpret_cast<const unsigned char*>(file.GetData());
+			const std::size_t file_size = file.GetSize();
+
+			// The file must start with the PNG signature, followed by the header chunk.
+			static const unsigned char SIGNATURE[8] = {137, 'P', 'N', 'G', 13, 10, 26, 10};
+			if(file_size < 8 + 25 || memcmp(file_data, SIGNATURE, 8) != 0 || ReadBigEndian32(&file_data[8]) != 13 || memcmp(&file_data[12], "IHDR", 4) != 0)
+			{
 				return false;
-				break;
 			}
-		
+			const unsigned char* const header = &file_data[16];
+			width = ReadBigEndian32(&header[0]);
+			height = ReadBigEndian32(&header[4]);
+			const unsigned char bit_depth = header[8];
+			const unsigned char color_type = header[9];
+			// Only 8-bit channels, the standard compression and filter methods, and
+			// non-interlaced images are supported.
+			if(width == 0 || height == 0 || width > 0x7FFFFFFF || height > 0x7FFFFFFF || bit_depth != 8 || header[10] != 0 || header[11] != 0 || header[12] != 0)
+			{
+				return false;
+			}
+			// The number of channels of each color type: grayscale, RGB, palette, grayscale and
+			// alpha, and RGBA.
+			unsigned int channels;
+			switch(color_type)
+			{
+			case 0: channels = 1; break;
+			case 2: channels = 3; break;
+			case 3: channels = 1; break;
+			case 4: channels = 2; break;
+			case 6: channels = 4; break;
+			default: return false;
+			}
 
-		
-			// Does the image need to be flipped horizontally?
-			if(flipped_horizontally == true)
+			// Gather the palette, stored as BGRA, and the compressed image data, which may be split among several chunks.
+			unsigned char palette[256][4];
+			memset(palette, 0, sizeof(palette));
+			unsigned int palette_size = 0;
+			bool has_transparent_palette = false;
+			std::vector<std::pair<const unsigned char*, std::size_t>> data_chunks;
+			std::size_t compressed_size = 0;
+			for(std::size_t position = 8 + 25; position + 12 <= file_size; )
 			{
-				// Temporary storage.
-				unsigned short upper_line = 1;
-				unsigned short lower_line = height;
-				unsigned char* temp = new(std::nothrow) unsigned char[width * pixel_depth];
-				// If unable to get the memory, return false.
-				if(temp == nullptr)
+				const std::size_t length = ReadBigEndian32(&file_data[position]);
+				const unsigned char* const type = &file_data[position + 4];
+				const unsigned char* const data = &file_data[position + 8];
+				if(length > file_size - position - 12)
 				{
-					delete[] pixel_data;
-					delete[] file_data;
 					return false;
 				}
-			
-				// Flip the upper lines with their corresponding lower lines like this:
-				//		-->================
-				//		|  ================
-				// Swap	|  ================
-				//		|  ================
-				//		-->================
-				while(upper_line < lower_line)
-				{
-					// Copy the upper line to temp.
-					memcpy(temp, &pixel_data[(upper_line - 1) * width * pixel_depth], width * pixel_depth);
-					// Copy the lower line to the upper line.
-					memcpy(&pixel_data[(upper_line - 1) * width * pixel_depth], &pixel_data[(lower_line - 1) * width * pixel_depth], width * pixel_depth);
-					// Copy the old upper line to the lower line.
-					memcpy(&pixel_data[(lower_line - 1) * width * pixel_depth], temp, width * pixel_depth);
-
-					// Move the upper line down, and the lower line up.
-					++upper_line;
-					--lower_line;
-				}
-				// Clean up.
-				delete[] temp;
-			}
-			// Does the image need to be flipped vertically?
-			if(flipped_vertically == true)
-			{
-				// Temporary storage.
-				unsigned short left_pixel;
-				unsigned short right_pixel;
-				unsigned char* temp = new(std::nothrow) unsigned char[pixel_depth];
-				// If unable to get the memory, return false.
-				if(temp == nullptr)
+				if(memcmp(type, "PLTE", 4) == 0)
+				{
+					if(length % 3 != 0 || length / 3 > 256)
+					{
+						return false;
+					}
+					palette_size = static_cast<unsigned int>(length / 3);
+					for(unsigned int i = 0; i < palette_size; ++i)
+					{
+						palette[i][0] = data[i * 3 + 2];
+						palette[i][1] = data[i * 3 + 1];
+						palette[i][2] = data[i * 3];
+						palette[i][3] = 0xFF;
+					}
+				}
+				else if(memcmp(type, "tRNS", 4) == 0 && color_type == 3)
+				{
+					// The alpha of the first few palette entries.
+					if(length > palette_size)
+					{
+						return false;
+					}
+					for(std::size_t i = 0; i < length; ++i)
+					{
+						palette[i][3] = data[i];
+					}
+					has_transparent_palette = true;
+				}
+				else if(memcmp(type, "IDAT", 4) == 0)
+				{
+					data_chunks.push_back(std::make_pair(data, length));
+					compressed_size += length;
+				}
+				else if(memcmp(type, "IEND", 4) == 0)
+				{
+					break;
+				}
+				position += length + 12;
+			}
+			if(data_chunks.empty() == true || (color_type == 3 && palette_size == 0))
+			{
+				return false;
+			}
+
+			// Each row is preceded by a byte naming the filter applied to it.
+			const unsigned long long row_size = static_cast<unsigned long long>(width) * channels;
+			const unsigned long long filtered_size = (row_size + 1) * height;
+			// DEFLATE can't compress by more than a factor of 1032, so don't allocate space for
+			// an image the data can't possibly hold.
+			if(filtered_size != static_cast<std::size_t>(filtered_size) || filtered_size / 1032 > compressed_size)
+			{
+				return false;
+			}
+			std::vector<unsigned char> filtered(static_cast<std::size_t>(filtered_size));
+			const char* compressed = reinterpret_cast<const char*>(data_chunks.front().first);
+			std::vector<char> joined_chunks;
+			if(data_chunks.size() > 1)
+			{
+				joined_chunks.reserve(compressed_size);
+				for(std::vector<std::pair<const unsigned char*, std::size_t>>::const_iterator i = data_chunks.begin(); i != data_chunks.end(); ++i)
+				{
+					joined_chunks.insert(joined_chunks.end(), i->first, i->first + i->second);
+				}
+				compressed = &joined_chunks[0];
+			}
+			if(utility::InflateZlib(compressed, compressed_size, reinterpret_cast<char*>(&filtered[0]), filtered.size()) == false)
+			{
+				return false;
+			}
+
+			// Undo the filters in place. The row above the first row is treated as zeros.
+			const std::vector<unsigned char> zero_row(static_cast<std::size_t>(row_size), 0);
+			const unsigned char* previous_row = &zero_row[0];
+			for(unsigned int row = 0; row < height; ++row)
+			{
+				unsigned char* const row_data = &filtered[static_cast<std::size_t>(row * (row_size + 1))];
+				if(UnfilterPNGRow(row_data + 1, previous_row, static_cast<std::size_t>(row_size), channels, row_data[0]) == false)
 				{
-					delete[] pixel_data;
-					delete[] file_data;
 					return false;
 				}
+				previous_row = row_data + 1;
+			}
 
-				// Swap right-most pixels with left-most pixels on each line, like this:
-				//
-				//		=================
-				//		=================
-				//		=================
-				//		  ^           ^
-				//		  |___________|
-				//			  Swap
-				for(unsigned short line = 0; line < height; ++line)
-				{
-					// Start from the outside, then move inwards.
-					left_pixel = 0;
-					right_pixel = width - 1;
-					while(left_pixel < right_pixel)
+			// Done decoding. Convert to the BGR(A) layout of a TGA image, whose rows run from
+			// the bottom of the image to the top.
+			contains_alpha_channel = (color_type == 4 || color_type == 6 || has_transparent_palette == true);
+			pixel_depth = (contains_alpha_channel == true) ? 4 : 3;
+			pixel_data = new(std::nothrow) unsigned char[static_cast<std::size_t>(width) * height * pixel_depth];
+			if(pixel_data == nullptr)
+			{
+				return false;
+			}
+			for(unsigned int row = 0; row < height; ++row)
+			{
+				const unsigned char* source = &filtered[static_cast<std::size_t>(row * (row_size + 1)) + 1];
+				unsigned char* destination = pixel_data + static_cast<std::size_t>(height - 1 - row) * width * pixel_depth;
+				switch(color_type)
+				{
+				case 0:
+					for(unsigned int x = 0; x < width; ++x, source += 1, destination += 3)
+					{
+						destination[0] = destination[1] = destination[2] = source[0];
+					}
+					break;
+				case 2:
+					for(unsigned int x = 0; x < width; ++x, source += 3, destination += 3)
+					{
+						destination[0] = source[2];
+						destination[1] = source[1];
+						destination[2] = source[0];
+					}
+					break;
+				case 3:
+					for(unsigned int x = 0; x < width; ++x, source += 1, destination += pixel_depth)
+					{
+						memcpy(destination, palette[source[0]], pixel_depth);
+					}
+					break;
+				case 4:
+					for(unsigned int x = 0; x < width; ++x, source += 2, destination += 4)
 					{
-						// Copy the left pixel to temp.
-						memcpy(temp, &pixel_data[(line * width + left_pixel) * pixel_depth], pixel_depth);
-						// Copy the right pixel to left pixel.
-						memcpy(&pixel_data[(line * width + left_pixel) * pixel_depth], &pixel_data[(line * width + right_pixel) * pixel_depth], pixel_depth);
-						// Copy the old left pixel to right pixel.
-						memcpy(&pixel_data[(line * width + right_pixel) * pixel_depth], temp, pixel_depth);
-					
-						// Move each pixel index inwards.
-						++left_pixel;
-						--right_pixel;
+						destination[0] = destination[1] = destination[2] = source[0];
+						destination[3] = source[1];
 					}
+					break;
+				case 6:
+					for(unsigned int x = 0; x < width; ++x, source += 4, destination += 4)
+					{
+						destination[0] = source[2];
+						destination[1] = source[1];
+						destination[2] = source[0];
+						destination[3] = source[3];
+					}
+					break;
 				}
-				// Clean up.
-				delete[] temp;
 			}
+			is_translucent = (contains_alpha_channel == true && IsAnyPixelTranslucent(pixel_data, width * height) == true);
+			return true;
+		}
+		// If an exception occurred while reading from the file, simply return false.
+		catch(...)
+		{
+			return false;
+		}
+	}
 
-			// Check to see if the image contains any translucent pixels.
+
+
+
+
+
+	// See method declaration for details.
+	bool LoadImageBMP(const std::string& file_name, unsigned int& width, unsigned int& height, unsigned short& pixel_depth, bool& contains_alpha_channel, bool& is_translucent, unsigned char*& pixel_data)
+	{
+		try
+		{
+			const utility::MappedFile file = utility::OpenAssetFile(file_name);
+			const unsigned char* const file_data = reinterpret_cast<const unsigned char*>(file.GetData());
+			const std::size_t file_size = file.GetSize();
+
+			// A 14-byte file header, then an info header of at least 40 bytes.
+			if(file_size < 54 || file_data[0] != 'B' || file_data[1] != 'M')
+			{
+				return false;
+			}
+			const std::size_t offset = ReadLittleEndian32(&file_data[10]);
+			const unsigned int header_size = ReadLittleEndian32(&file_data[14]);
+			const int signed_width = static_cast<int>(ReadLittleEndian32(&file_data[18]));
+			const int signed_height = static_cast<int>(ReadLittleEndian32(&file_data[22]));
+			const unsigned short bit_count = ReadLittleEndian16(&file_data[28]);
+			const unsigned int compression = ReadLittleEndian32(&file_data[30]);
+			if(header_size < 40 || 14 + static_cast<std::size_t>(header_size) > file_size || signed_width <= 0 || signed_height == 0 || static_cast<unsigned int>(signed_height) == 0x80000000)
+			{
+				return false;
+			}
+			// A negative height means the rows are stored from the top of the image down.
+			const bool is_top_down = (signed_height < 0);
+			width = signed_width;
+			height = (is_top_down == true) ? -signed_height : signed_height;
+
+			// Only uncompressed 24- and 32-bit pixels are supported. Bit fields are accepted as long
+			// as they describe the same layout.
+			if(bit_count != 24 && bit_count != 32)
+			{
+				return false;
+			}
+			bool has_alpha_mask = false;
+			if(compression == 3 && bit_count == 32)
+			{
+				// The masks follow a 40-byte header, but are part of any longer one.
+				const std::size_t masks = 14 + 40;
+				if(masks + 12 > file_size || ReadLittleEndian32(&file_data[masks]) != 0x00FF0000 || ReadLittleEndian32(&file_data[masks + 4]) != 0x0000FF00
+					|| ReadLittleEndian32(&file_data[masks + 8]) != 0x000000FF)
+				{
+					return false;
+				}
+				if(header_size >= 56)
+				{
+					const unsigned int alpha_mask = ReadLittleEndian32(&file_data[masks + 12]);
+					if(alpha_mask != 0 && alpha_mask != 0xFF000000)
+					{
+						return false;
+					}
+					has_alpha_mask = (alpha_mask != 0);
+				}
+			}
+			else if(compression != 0)
+			{
+				return false;
+			}
+
+			// Each row is padded to a multiple of 4 bytes.
+			pixel_depth = bit_count / 8;
+			const unsigned long long row_size = static_cast<unsigned long long>(width) * pixel_depth;
+			const unsigned long long stride = (row_size + 3) & ~3ull;
+			if(offset > file_size || stride * height > file_size - offset || row_size * height != static_cast<std::size_t>(row_size * height))
+			{
+				return false;
+			}
+
+			// Done with the header. BMP pixels are already in the bottom-up BGR(A) layout of a TGA
+			// image, so each row is a straight copy.
+			pixel_data = new(std::nothrow) unsigned char[static_cast<std::size_t>(row_size * height)];
+			if(pixel_data == nullptr)
+			{
+				return false;
+			}
+			for(unsigned int row = 0; row < height; ++row)
+			{
+				const unsigned int destination_row = (is_top_down == true) ? height - 1 - row : row;
+				memcpy(pixel_data + static_cast<std::size_t>(destination_row * row_size), file_data + offset + static_cast<std::size_t>(row * stride), static_cast<std::size_t>(row_size));
+			}
+
+			// An uncompressed 32-bit BMP officially has no alpha channel, but some programs store one
+			// anyway; if every alpha value is zero, it was left unused and the image is opaque.
+			contains_alpha_channel = (pixel_depth == 4);
 			is_translucent = false;
 			if(contains_alpha_channel == true)
 			{
-				// Each pixel must be separated into four equal channels.
-				ASSERT(pixel_depth % 4 == 0);
-				const unsigned int alpha_channel_size = pixel_depth / 4;
-				for(unsigned int current_pixel_alpha = pixel_depth - alpha_channel_size; current_pixel_alpha < image_size; current_pixel_alpha += pixel_depth)
+				const std::size_t pixel_count = static_cast<std::size_t>(width) * height;
+				bool is_alpha_used = has_alpha_mask;
+				for(std::size_t i = 0; i < pixel_count && is_alpha_used == false && compression == 0; ++i)
 				{
-					for(unsigned int alpha_offset = 0; alpha_offset < alpha_channel_size; ++alpha_offset)
+					is_alpha_used = (pixel_data[i * 4 + 3] != 0);
+				}
+				if(is_alpha_used == false)
+				{
+					for(std::size_t i = 0; i < pixel_count; ++i)
 					{
-						if(pixel_data[current_pixel_alpha + alpha_offset] != 0 && pixel_data[current_pixel_alpha + alpha_offset] != 0xFF)
-						{
-							is_translucent = true;
-							current_pixel_alpha = image_size - pixel_depth;
-						}
+						pixel_data[i * 4 + 3] = 0xFF;
 					}
 				}
+				is_translucent = IsAnyPixelTranslucent(pixel_data, width * height);
 			}
+			return true;
+		}
+		// If an exception occurred while reading from the file, simply return false.
+		catch(...)
+		{
+			return false;
+		}
+	}
+
 
-			// Done with the file data now.
-			delete[] file_data;
 
-			// Return success.
-			return true;
 
 
+
+	// See method declaration for details.
+	bool LoadImageDDS(const std::string& file_name, unsigned int& width, unsigned int& height, unsigned short& pixel_depth, bool& contains_alpha_channel, bool& is_translucent, BlockFormat& block_format, unsigned char*& pixel_data)
+	{
+		try
+		{
+			const utility::MappedFile file = utility::OpenAssetFile(file_name);
+			const unsigned char* const file_data = reinterpret_cast<const unsigned char*>(file.GetData());
+			const std::size_t file_size = file.GetSize();
+
+			// A 4-byte magic number, then a 124-byte header which contains a 32-byte pixel format.
+			if(file_size < 128 || memcmp(file_data, "DDS ", 4) != 0 || ReadLittleEndian32(&file_data[4]) != 124 || ReadLittleEndian32(&file_data[76]) != 32)
+			{
+				return false;
+			}
+			// Cube maps and volume textures aren't supported.
+			if((ReadLittleEndian32(&file_data[112]) & (0x200 | 0x200000)) != 0)
+			{
+				return false;
+			}
+			// The pixel format must be named by a four-character code.
+			if((ReadLittleEndian32(&file_data[80]) & 0x4) == 0)
+			{
+				return false;
 			}
+			if(memcmp(&file_data[84], "DXT1", 4) == 0)
+			{
+				block_format = DXT1;
+			}
+			else if(memcmp(&file_data[84], "DXT5", 4) == 0)
+			{
+				block_format = DXT5;
+			}
+			else
+			{
+				return false;
+			}
+
+			// Whole blocks only, since the rows of blocks are about to be turned upside down.
+			height = ReadLittleEndian32(&file_data[12]);
+			width = ReadLittleEndian32(&file_data[16]);
+			if(width == 0 || height == 0 || width % 4 != 0 || height % 4 != 0)
+			{
+				return false;
+			}
+			const unsigned long long data_size = static_cast<unsigned long long>(width / 4) * (height / 4) * ((block_format == DXT1) ? 8 : 16);
+			if(data_size > file_size - 128)
+			{
+				return false;
+			}
+
+			// Done with the header. The top mip level comes first; any others are ignored.
+			pixel_data = new(std::nothrow) unsigned char[static_cast<std::size_t>(data_size)];
+			if(pixel_data == nullptr)
+			{
+				return false;
+			}
+			FlipBlocksVertically(file_data + 128, pixel_data, width, height, block_format);
+			pixel_depth = 4;
+			contains_alpha_channel = (block_format == DXT5);
+			is_translucent = IsAnyBlockTranslucent(pixel_data, width, height, block_format);
+			return true;
+		}
 		// If an exception occurred while reading from the file, simply return false.
 		catch(...)
 		{
@@ -342,18 +663,66 @@ namespace view
 
 
 
+	// See method declaration for details.
+	bool SaveImageDDS(const std::string& file_name, const Image& image)
+	{
+		if(image.IsCompressed() == false || image.GetPixelData() == nullptr || image.GetHeight() % 4 != 0)
+		{
+			return false;
+		}
+		try
+		{
+			// Only the top level is written; mip levels are generated again when the file is loaded.
+			const std::size_t data_size = image.GetLevelDataSize(0);
+			std::vector<char> file_data(128 + data_size, 0);
+			unsigned char* const header = reinterpret_cast<unsigned char*>(&file_data[0]);
+			memcpy(header, "DDS ", 4);
+			WriteLittleEndian32(&header[4], 124);
+			// The caps, height, width, pixel format, and linear size fields are valid.
+			WriteLittleEndian32(&header[8], 0x1 | 0x2 | 0x4 | 0x1000 | 0x80000);
+			WriteLittleEndian32(&header[12], image.GetHeight());
+			WriteLittleEndian32(&header[16], image.GetWidth());
+			WriteLittleEndian32(&header[20], static_cast<unsigned int>(data_size));
+			// The pixel format is named by a four-character code.
+			WriteLittleEndian32(&header[76], 32);
+			WriteLittleEndian32(&header[80], 0x4);
+			memcpy(&header[84], (image.GetBlockFormat() == DXT1) ? "DXT1" : "DXT5", 4);
+			// The file holds a texture.
+			WriteLittleEndian32(&header[108], 0x1000);
+
+			FlipBlocksVertically(image.GetPixelData(), header + 128, image.GetWidth(), image.GetHeight(), image.GetBlockFormat());
+			utility::WriteFile(file_name, file_data);
+			return true;
+		}
+		// If an exception occurred while writing to the file, simply return false.
+		catch(...)
+		{
+			return false;
+		}
+	}
+
+
+
 
 
 
 	// See method declaration for details.
 	Image::Image(const unsigned int width, const unsigned int height, const unsigned short pixel_depth, const bool alpha, const bool translucent, unsigned char* const pixel_data)
-		: width(width), height(height), pixel_depth(pixel_depth), contains_alpha_channel(alpha), is_translucent(translucent), pixel_data(pixel_data)
+		: width(width), height(height), pixel_depth(pixel_depth), contains_alpha_channel(alpha), is_translucent(translucent), is_compressed(false), block_format(DXT1), pixel_data(pixel_data), mip_data(nullptr), level_count(1)
 	{
 		ASSERT(width != 0 && height != 0 && pixel_depth != 0 && pixel_data != nullptr);
 	}
 
+	// See method declaration for details.
+	Image::Image(const unsigned int width, const unsigned int height, const BlockFormat block_format, const bool translucent, unsigned char* const block_data)
+		: width(width), height(height), pixel_depth(4), contains_alpha_channel(block_format == DXT5), is_translucent(translucent), is_compressed(true), block_format(block_format), pixel_data(block_data), mip_data(nullptr), level_count(1)
+	{
+		ASSERT(width != 0 && height != 0 && block_data != nullptr);
+	}
+
 	// See method declaration for details.
 	Image::Image(const std::string& file_name)
+		: mip_data(nullptr), level_count(1)
 	{
 		// Figure out the file extension by moving backwards from the end of the string to the first period.
 		// Then store the remainder of the string from there in lowercase.
@@ -375,12 +744,27 @@ namespace view
 
 		// Stores the success status of loading the image.
 		bool status;
+		is_compressed = false;
+		block_format = DXT1;
 
 		// If the extension is a valid format, use the appropriate loading function.
 		if(extension == "tga")
 		{
 			status = LoadImageTGA(file_name, width, height, pixel_depth, contains_alpha_channel, is_translucent, pixel_data);
 		}
+		else if(extension == "png")
+		{
+			status = LoadImagePNG(file_name, width, height, pixel_depth, contains_alpha_channel, is_translucent, pixel_data);
+		}
+		else if(extension == "bmp")
+		{
+			status = LoadImageBMP(file_name, width, height, pixel_depth, contains_alpha_channel, is_translucent, pixel_data);
+		}
+		else if(extension == "dds")
+		{
+			status = LoadImageDDS(file_name, width, height, pixel_depth, contains_alpha_channel, is_translucent, block_format, pixel_data);
+			is_compressed = status;
+		}
 		else
 		{
 			status = false;
@@ -405,6 +789,11 @@ namespace view
 			delete[] pixel_data;
 			pixel_data = nullptr;
 		}
+		if(mip_data != nullptr)
+		{
+			delete[] mip_data;
+			mip_data = nullptr;
+		}
 	}
 
 	// See method declaration for details.
@@ -437,12 +826,393 @@ namespace view
 		return is_translucent;
 	}
 
+	// See method declaration for details.
+	const bool Image::IsCompressed() const
+	{
+		return is_compressed;
+	}
+
+	// See method declaration for details.
+	const BlockFormat Image::GetBlockFormat() const
+	{
+		ASSERT(is_compressed == true);
+		return block_format;
+	}
+
 	// See method declaration for details.
 	unsigned char* const Image::GetPixelData() const
 	{
 		return pixel_data;
 	}
 
+	// See method declaration for details.
+	const std::size_t Image::GetDataSize() const
+	{
+		std::size_t data_size = 0;
+		for(unsigned int level = 0; level < level_count; ++level)
+		{
+			data_size += GetLevelDataSize(level);
+		}
+		return data_size;
+	}
+
+	// See method declaration for details.
+	void Image::GenerateMipmaps(const MipFilter filter)
+	{
+		ASSERT(pixel_data != nullptr);
+		if(mip_data != nullptr)
+		{
+			delete[] mip_data;
+			mip_data = nullptr;
+		}
+		level_count = 1;
+
+		const unsigned int new_level_count = GetMipLevelCount(width, height);
+		if(new_level_count == 1)
+		{
+			return;
+		}
+		// The levels below the top one are stored one after the other.
+		std::size_t mip_data_size = 0;
+		for(unsigned int level = 1; level < new_level_count; ++level)
+		{
+			mip_data_size += GetLevelDataSize(level);
+		}
+		std::unique_ptr<unsigned char[]> new_mip_data(new(std::nothrow) unsigned char[mip_data_size]);
+		if(new_mip_data == nullptr)
+		{
+			throw utility::OutOfMemoryError();
+		}
+
+		// Compressed levels are downsampled from the decompressed level above, which needs two
+		// scratch buffers: one the size of the top level, and one the size of the next.
+		std::unique_ptr<unsigned char[]> current;
+		std::unique_ptr<unsigned char[]> next;
+		if(is_compressed == true)
+		{
+			current.reset(new(std::nothrow) unsigned char[static_cast<std::size_t>(width) * height * 4]);
+			next.reset(new(std::nothrow) unsigned char[static_cast<std::size_t>(GetLevelWidth(1)) * GetLevelHeight(1) * 4]);
+			if(current == nullptr || next == nullptr)
+			{
+				throw utility::OutOfMemoryError();
+			}
+			DecompressBlocks(pixel_data, width, height, block_format, current.get());
+		}
+
+		const unsigned char* source = pixel_data;
+		unsigned char* level_data = new_mip_data.get();
+		for(unsigned int level = 1; level < new_level_count; ++level)
+		{
+			const unsigned int level_width = GetLevelWidth(level);
+			const unsigned int level_height = GetLevelHeight(level);
+			unsigned char* const pixels = (is_compressed == true) ? next.get() : level_data;
+			DownsampleImage((is_compressed == true) ? current.get() : source, GetLevelWidth(level - 1), GetLevelHeight(level - 1), pixel_depth, filter, pixels);
+			// Filtering blends the edges of opaque areas; round them off again so that the level
+			// can still be drawn with an alpha test.
+			if(pixel_depth == 4 && is_translucent == false)
+			{
+				const std::size_t pixel_count = static_cast<std::size_t>(level_width) * level_height;
+				for(std::size_t i = 0; i < pixel_count; ++i)
+				{
+					pixels[i * 4 + 3] = (pixels[i * 4 + 3] >= 0x80) ? 0xFF : 0x00;
+				}
+			}
+			if(is_compressed == true)
+			{
+				CompressBlocks(pixels, level_width, level_height, 4, block_format, level_data);
+				current.swap(next);
+			}
+			source = level_data;
+			level_data += GetLevelDataSize(level);
+		}
+		mip_data = new_mip_data.release();
+		level_count = new_level_count;
+	}
+
+	// See method declaration for details.
+	const unsigned int Image::GetLevelCount() const
+	{
+		return level_count;
+	}
+
+	// See method declaration for details.
+	const unsigned int Image::GetLevelWidth(const unsigned int level) const
+	{
+		return ((width >> level) > 0) ? (width >> level) : 1;
+	}
+
+	// See method declaration for details.
+	const unsigned int Image::GetLevelHeight(const unsigned int level) const
+	{
+		return ((height >> level) > 0) ? (height >> level) : 1;
+	}
+
+	// See method declaration for details.
+	unsigned char* const Image::GetLevelData(const unsigned int level) const
+	{
+		ASSERT(level < level_count);
+		if(level == 0)
+		{
+			return pixel_data;
+		}
+		std::size_t offset = 0;
+		for(unsigned int i = 1; i < level; ++i)
+		{
+			offset += GetLevelDataSize(i);
+		}
+		return mip_data + offset;
+	}
+
+	// See method declaration for details.
+	const std::size_t Image::GetLevelDataSize(const unsigned int level) const
+	{
+		if(is_compressed == true)
+		{
+			return GetBlockDataSize(GetLevelWidth(level), GetLevelHeight(level), block_format);
+		}
+		return static_cast<std::size_t>(GetLevelWidth(level)) * GetLevelHeight(level) * pixel_depth;
+	}
+
+
+
+	// Anonymous namespace.
+	namespace
+	{
+		/** Writes \a count pixels in file order, wrapping onto following rows as needed.
+		@param writer Where the pixels go.
+		@param source The pixels to write if \a is_run is false, or the single pixel to repeat
+		\a count times if it's true.
+		@param count The number of pixels to write.
+		@param is_run Whether \a source is one repeated pixel.
+		*/
+		void WritePixels(PixelWriter& writer, const unsigned char* source, unsigned int count, const bool is_run)
+		{
+			const unsigned int pixel_depth = writer.pixel_depth;
+			// Runs only need their one pixel checked.
+			if(writer.is_translucent == false)
+			{
+				writer.is_translucent = IsAnyPixelTranslucent(source, (is_run == true) ? 1 : count);
+			}
+
+			while(count > 0)
+			{
+				const unsigned int row_count = (count < writer.width - writer.column) ? count : writer.width - writer.column;
+				const unsigned int row = (writer.swap_rows == true) ? writer.height - 1 - writer.row : writer.row;
+				unsigned char* const row_data = writer.pixel_data + static_cast<std::size_t>(row) * writer.width * pixel_depth;
+				// A mirrored row is filled from its right end, so the span lands at the mirror
+				// image of its columns, in reverse order.
+				const unsigned int first_column = (writer.mirror_rows == true) ? writer.width - writer.column - row_count : writer.column;
+				unsigned char* const destination = row_data + first_column * pixel_depth;
+
+				if(is_run == true)
+				{
+					FillPixels(destination, source, row_count, pixel_depth);
+				}
+				else
+				{
+					if(writer.mirror_rows == true)
+					{
+						CopyPixelsReversed(destination, source, row_count, pixel_depth);
+					}
+					else
+					{
+						memcpy(destination, source, row_count * pixel_depth);
+					}
+					source += row_count * pixel_depth;
+				}
+
+				count -= row_count;
+				writer.column += row_count;
+				if(writer.column == writer.width)
+				{
+					writer.column = 0;
+					++writer.row;
+				}
+			}
+		}
+
+		/** Fills \a count pixels at \a destination with copies of \a pixel.*/
+		void FillPixels(unsigned char* const destination, const unsigned char* const pixel, const unsigned int count, const unsigned int pixel_depth)
+		{
+			if(pixel_depth == 4)
+			{
+				int value;
+				memcpy(&value, pixel, 4);
+				const __m128i pixels = _mm_set1_epi32(value);
+				unsigned int i = 0;
+				for(; i + 4 <= count; i += 4)
+				{
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), pixels);
+				}
+				for(; i < count; ++i)
+				{
+					memcpy(destination + i * 4, &value, 4);
+				}
+			}
+			else
+			{
+				// Double the filled span with each copy.
+				const std::size_t size = static_cast<std::size_t>(count) * pixel_depth;
+				memcpy(destination, pixel, pixel_depth);
+				for(std::size_t filled = pixel_depth; filled < size; filled *= 2)
+				{
+					memcpy(destination + filled, destination, (filled < size - filled) ? filled : size - filled);
+				}
+			}
+		}
+
+		/** Copies \a count pixels from \a source to \a destination in reverse order.*/
+		void CopyPixelsReversed(unsigned char* const destination, const unsigned char* const source, const unsigned int count, const unsigned int pixel_depth)
+		{
+			unsigned int i = 0;
+			if(pixel_depth == 4)
+			{
+				// Reverse four pixels at a time.
+				for(; i + 4 <= count; i += 4)
+				{
+					const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + (count - i - 4) * 4));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), _mm_shuffle_epi32(pixels, _MM_SHUFFLE(0, 1, 2, 3)));
+				}
+			}
+			for(; i < count; ++i)
+			{
+				memcpy(destination + i * pixel_depth, source + (count - 1 - i) * pixel_depth, pixel_depth);
+			}
+		}
+
+		/** Checks whether any of \a count 32-bit pixels has an alpha value other than 0 or 0xFF.*/
+		const bool IsAnyPixelTranslucent(const unsigned char* const pixels, const unsigned int count)
+		{
+			unsigned int i = 0;
+			const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+			const __m128i zero = _mm_setzero_si128();
+			for(; i + 4 <= count; i += 4)
+			{
+				const __m128i alpha = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * 4)), alpha_mask);
+				const __m128i is_opaque_or_clear = _mm_or_si128(_mm_cmpeq_epi32(alpha, zero), _mm_cmpeq_epi32(alpha, alpha_mask));
+				if(_mm_movemask_epi8(is_opaque_or_clear) != 0xFFFF)
+				{
+					return true;
+				}
+			}
+			for(; i < count; ++i)
+			{
+				if(pixels[i * 4 + 3] != 0 && pixels[i * 4 + 3] != 0xFF)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/** Undoes the filter applied to a row of a PNG image.
+		@param row The filtered row, which is replaced by the original.
+		@param previous_row The original row above \a row.
+		@param row_size The size of a row in bytes.
+		@param pixel_size The number of bytes per pixel.
+		@param filter The filter which was applied to the row.
+		@return False if \a filter isn't a known filter.
+		*/
+		const bool UnfilterPNGRow(unsigned char* const row, const unsigned char* const previous_row, const std::size_t row_size, const unsigned int pixel_size, const unsigned char filter)
+		{
+			std::size_t i = 0;
+			switch(filter)
+			{
+			case 0:
+				// None.
+				break;
+			case 1:
+				// Sub: each byte is relative to the byte one pixel to the left.
+				for(i = pixel_size; i < row_size; ++i)
+				{
+					row[i] = static_cast<unsigned char>(row[i] + row[i - pixel_size]);
+				}
+				break;
+			case 2:
+				// Up: each byte is relative to the byte above, so sixteen can be done at once.
+				for(; i + 16 <= row_size; i += 16)
+				{
+					const __m128i above = _mm_loadu_si128(reinterpret_cast<const __m128i*>(previous_row + i));
+					const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(row + i), _mm_add_epi8(bytes, above));
+				}
+				for(; i < row_size; ++i)
+				{
+					row[i] = static_cast<unsigned char>(row[i] + previous_row[i]);
+				}
+				break;
+			case 3:
+				// Average: each byte is relative to the average of the bytes to the left and above.
+				for(; i < pixel_size && i < row_size; ++i)
+				{
+					row[i] = static_cast<unsigned char>(row[i] + (previous_row[i] >> 1));
+				}
+				for(; i < row_size; ++i)
+				{
+					row[i] = static_cast<unsigned char>(row[i] + ((row[i - pixel_size] + previous_row[i]) >> 1));
+				}
+				break;
+			case 4:
+				// Paeth: each byte is relative to whichever of the bytes to the left, above, and
+				// above-left is closest to left + above - above-left. With no left pixel, that's above.
+				for(; i < pixel_size && i < row_size; ++i)
+				{
+					row[i] = static_cast<unsigned char>(row[i] + previous_row[i]);
+				}
+				for(; i < row_size; ++i)
+				{
+					const int left = row[i - pixel_size];
+					const int above = previous_row[i];
+					const int above_left = previous_row[i - pixel_size];
+					const int left_distance = abs(above - above_left);
+					const int above_distance = abs(left - above_left);
+					const int above_left_distance = abs(left + above - 2 * above_left);
+					int predictor = above_left;
+					if(left_distance <= above_distance && left_distance <= above_left_distance)
+					{
+						predictor = left;
+					}
+					else if(above_distance <= above_left_distance)
+					{
+						predictor = above;
+					}
+					row[i] = static_cast<unsigned char>(row[i] + predictor);
+				}
+				break;
+			default:
+				return false;
+			}
+			return true;
+		}
+
+		/** Reads a 32-bit big-endian value.*/
+		const unsigned int ReadBigEndian32(const unsigned char* const data)
+		{
+			return (static_cast<unsigned int>(data[0]) << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+		}
+
+		/** Reads a 32-bit little-endian value.*/
+		const unsigned int ReadLittleEndian32(const unsigned char* const data)
+		{
+			return (static_cast<unsigned int>(data[3]) << 24) | (data[2] << 16) | (data[1] << 8) | data[0];
+		}
+
+		/** Reads a 16-bit little-endian value.*/
+		const unsigned short ReadLittleEndian16(const unsigned char* const data)
+		{
+			return static_cast<unsigned short>((data[1] << 8) | data[0]);
+		}
+
+		/** Writes a 32-bit little-endian value.*/
+		void WriteLittleEndian32(unsigned char* const data, const unsigned int value)
+		{
+			data[0] = static_cast<unsigned char>(value);
+			data[1] = static_cast<unsigned char>(value >> 8);
+			data[2] = static_cast<unsigned char>(value >> 16);
+			data[3] = static_cast<unsigned char>(value >> 24);
+		}
+	}
+
 
 
 }
@@ -22,6 +22,9 @@ along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
 Used for loading graphical image data, especially from a file.
 @par Currently supported file formats:
 @li *.TGA
+@li *.PNG (8 bits per channel, non-interlaced)
+@li *.BMP (24- and 32-bit, uncompressed)
+@li *.DDS (DXT1 and DXT5, kept compressed)
 @attention Currently only supports \b 24-bit (non-alpha) and \b 32-bit (alpha) images.
 @author Sheldon Bachstein
 @date Jul 24, 2011
@@ -30,7 +33,10 @@ separate component.
 */
 
 
+#include"..\block compression\block compression.h"
+#include"..\mipmap\mipmap.h"
 #include<string>
+#include<cstddef>
 
 
 namespace avl
@@ -57,6 +63,66 @@ namespace view
 	*/
 	bool LoadImageTGA(const std::string& file_name, unsigned int& width, unsigned int& height, unsigned short& pixel_depth, bool& contains_alpha_channel, bool& is_translucent, unsigned char*& pixel_data);
 
+	/** Attempts to load image data from a file in the .PNG image file format. Grayscale, RGB, and
+	palette images are loaded as 24-bit images, and those with an alpha channel or a transparent
+	palette as 32-bit images, in the same pixel layout as \ref LoadImageTGA().
+	@pre \a file_name is the name of a non-interlaced .PNG file with 8 bits per channel. Chunk CRCs
+	aren't checked, though the compressed image data's checksum is.
+	@post If true is returned, then \a width, \a height, \a pixel_depth, \a contains_alpha, and \a pixel_data will
+	contain information about the file \a file_name; you are responsible for deleting \a pixel_data when you no longer
+	need the image data.\n If false is returned, then there was a problem when reading
+	from the file \a file_name, the file doesn't exist, or the file was improperly formatted; if this is the case,
+	then the only gaurantees are that \a file_name is unchanged and \a pixel_data does not need to be deleted.
+	@param file_name [IN] Name of the PNG file to load the image data from.
+	@param width [OUT] Width of the image.
+	@param height [OUT] Height of the image.
+	@param pixel_depth [OUT] Number of bytes per pixel.
+	@param contains_alpha_channel [OUT] Does this image have an alpha channel?
+	@param is_translucent [OUT] Does this image have any translucent pixels?
+	@param pixel_data [OUT] Pointer to the image's pixel data.
+	*/
+	bool LoadImagePNG(const std::string& file_name, unsigned int& width, unsigned int& height, unsigned short& pixel_depth, bool& contains_alpha_channel, bool& is_translucent, unsigned char*& pixel_data);
+
+	/** Attempts to load image data from a file in the .BMP image file format. 32-bit images whose
+	alpha channel is entirely zero are treated as opaque, since most programs leave it unused.
+	@pre \a file_name is the name of an uncompressed 24- or 32-bit .BMP file. 32-bit files may use
+	bit fields only if they're laid out the same way as uncompressed pixels.
+	@post If true is returned, then \a width, \a height, \a pixel_depth, \a contains_alpha, and \a pixel_data will
+	contain information about the file \a file_name; you are responsible for deleting \a pixel_data when you no longer
+	need the image data.\n If false is returned, then there was a problem when reading
+	from the file \a file_name, the file doesn't exist, or the file was improperly formatted; if this is the case,
+	then the only gaurantees are that \a file_name is unchanged and \a pixel_data does not need to be deleted.
+	@param file_name [IN] Name of the BMP file to load the image data from.
+	@param width [OUT] Width of the image.
+	@param height [OUT] Height of the image.
+	@param pixel_depth [OUT] Number of bytes per pixel.
+	@param contains_alpha_channel [OUT] Does this image have an alpha channel?
+	@param is_translucent [OUT] Does this image have any translucent pixels?
+	@param pixel_data [OUT] Pointer to the image's pixel data.
+	*/
+	bool LoadImageBMP(const std::string& file_name, unsigned int& width, unsigned int& height, unsigned short& pixel_depth, bool& contains_alpha_channel, bool& is_translucent, unsigned char*& pixel_data);
+
+	/** Attempts to load block-compressed image data from a file in the .DDS file format. The data is
+	left compressed, and turned upside down to match the bottom-up row order of the other loaders.
+	@pre \a file_name is the name of a 2D .DDS file in the DXT1 or DXT5 format whose width and height
+	are multiples of 4. Only the top mip level is loaded.
+	@post If true is returned, then \a width, \a height, \a pixel_depth, \a contains_alpha, \a block_format,
+	and \a pixel_data will contain information about the file \a file_name; \a pixel_depth is that of the
+	decompressed pixels, and you are responsible for deleting \a pixel_data when you no longer
+	need the image data.\n If false is returned, then there was a problem when reading
+	from the file \a file_name, the file doesn't exist, or the file was improperly formatted; if this is the case,
+	then the only gaurantees are that \a file_name is unchanged and \a pixel_data does not need to be deleted.
+	@param file_name [IN] Name of the DDS file to load the image data from.
+	@param width [OUT] Width of the image.
+	@param height [OUT] Height of the image.
+	@param pixel_depth [OUT] Number of bytes per decompressed pixel.
+	@param contains_alpha_channel [OUT] Does this image have an alpha channel?
+	@param is_translucent [OUT] Does this image have any translucent pixels?
+	@param block_format [OUT] The block format of the image data.
+	@param pixel_data [OUT] Pointer to the image's compressed data.
+	*/
+	bool LoadImageDDS(const std::string& file_name, unsigned int& width, unsigned int& height, unsigned short& pixel_depth, bool& contains_alpha_channel, bool& is_translucent, BlockFormat& block_format, unsigned char*& pixel_data);
+
 
 
 	/**
@@ -74,6 +140,15 @@ namespace view
 		@param pixel_data Pointer to the image's pixel data.
 		*/
 		Image(const unsigned int width, const unsigned int height, const unsigned short pixel_depth, const bool alpha, const bool translucent, unsigned char* const pixel_data);
+		/** Constructs a block-compressed image.
+		@param width The width of the image in pixel.
+		@param height The height of the image in pixels.
+		@param block_format The block format of \a block_data.
+		@param translucent Are any pixels in this image translucent?
+		@param block_data Pointer to the image's compressed data, laid out as described in
+		"block compression.h".
+		*/
+		Image(const unsigned int width, const unsigned int height, const BlockFormat block_format, const bool translucent, unsigned char* const block_data);
 		/** Attempts to load an image given only a file name. \a file_name must have the extension of a currently
 		implemented image file format, and the data contained in the file must match that file format (i.e. you
 		will run into problems if you simply rename a .PNG file to .TGA and then try loading it).
@@ -84,7 +159,7 @@ namespace view
 		see what additional restrictions are imposed for each file format.
 		*/
 		Image(const std::string& file_name);
-		/** Basic destructor. Deletes \ref pixel_data.*/
+		/** Basic destructor. Deletes \ref pixel_data and \ref mip_data.*/
 		~Image();
 
 		/** Returns the image's width.
@@ -95,7 +170,8 @@ namespace view
 		@return The value of \ref height.
 		*/
 		const unsigned int GetHeight() const;
-		/** Returns the image's pixel depth in bytes.
+		/** Returns the image's pixel depth in bytes. For a compressed image, this is the depth
+		of the decompressed pixels.
 		@return The value of \ref pixel_depth.
 		*/
 		const unsigned short GetPixelDepth() const;
@@ -107,11 +183,60 @@ namespace view
 		@return True if this image contains translucent pixels, and false if not.
 		*/
 		const bool IsTranslucent() const;
+		/** Is this image's data block-compressed?
+		@return True if \ref GetPixelData() holds compressed blocks rather than pixels.
+		*/
+		const bool IsCompressed() const;
+		/** Returns the block format of a compressed image.
+		@pre \ref IsCompressed() returns true.
+		@return The value of \ref block_format.
+		*/
+		const BlockFormat GetBlockFormat() const;
 		/** Gets the image's pixel data. Allows for modification of the pixel data.
 		@return \ref pixel_data.
-		@attention Pixel data is arranged in little-endian order.
+		@attention Pixel data is arranged in little-endian order. If the image is compressed,
+		this is the compressed data instead.
 		*/
 		unsigned char* const GetPixelData() const;
+		/** Computes the size of the image's data, which is how much memory it takes up as a texture.
+		@return The size of all of the image's levels in bytes.
+		*/
+		const std::size_t GetDataSize() const;
+
+		/** Builds the full chain of mip levels below the top level, down to 1x1, replacing any
+		levels built before. Compressed images are decompressed, downsampled, and compressed again
+		level by level. If the image isn't translucent, the alpha of the smaller levels is rounded
+		to 0 or 0xFF so that they stay that way.
+		@pre The image was loaded successfully.
+		@param filter The filter to downsample with.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		void GenerateMipmaps(const MipFilter filter = BOX_FILTER);
+		/** Returns the number of mip levels the image has.
+		@return 1 unless \ref GenerateMipmaps() has been called.
+		*/
+		const unsigned int GetLevelCount() const;
+		/** Returns the width of a mip level.
+		@param level The level, where 0 is the top level.
+		@return Half the width of the level above, rounded down, but no less than 1.
+		*/
+		const unsigned int GetLevelWidth(const unsigned int level) const;
+		/** Returns the height of a mip level.
+		@param level The level, where 0 is the top level.
+		@return Half the height of the level above, rounded down, but no less than 1.
+		*/
+		const unsigned int GetLevelHeight(const unsigned int level) const;
+		/** Gets the data of a mip level, laid out the same way as \ref GetPixelData().
+		@pre \a level is less than \ref GetLevelCount().
+		@param level The level, where 0 is the top level.
+		@return The level's pixels, or its blocks if the image is compressed.
+		*/
+		unsigned char* const GetLevelData(const unsigned int level) const;
+		/** Computes the size of a mip level's data.
+		@param level The level, where 0 is the top level.
+		@return The size of the level's data in bytes.
+		*/
+		const std::size_t GetLevelDataSize(const unsigned int level) const;
 
 	private:
 		/// The image's width in pixels.
@@ -124,12 +249,32 @@ namespace view
 		bool contains_alpha_channel;
 		/// True if the image contains any translucent pixels.
 		bool is_translucent;
+		/// True if \ref pixel_data holds compressed blocks.
+		bool is_compressed;
+		/// The block format of \ref pixel_data, if it's compressed.
+		BlockFormat block_format;
 		/// The image's pixel data.
 		unsigned char* pixel_data;
+		/// The data of every mip level below the top level, one after the other.
+		unsigned char* mip_data;
+		/// The number of mip levels, including the top level.
+		unsigned int level_count;
 	};
 
 
 
+	/** Attempts to save a block-compressed image to a file in the .DDS file format, top row first
+	as the format expects. Only the top mip level is written, since that's all which is loaded;
+	see \ref Image::GenerateMipmaps().
+	@param file_name [IN] Name of the DDS file to write.
+	@param image [IN] The image to save.
+	@return True if the file was written, and false if \a image isn't compressed, its height isn't a
+	multiple of 4, or there was a problem writing to \a file_name.
+	*/
+	bool SaveImageDDS(const std::string& file_name, const Image& image);
+
+
+
 } // view
 } // avl
 #endif // AVL_VIEW_IMAGE__
\ No newline at end of file
@@ -21,6 +21,358 @@ Unit test for the image component. See "image.h" for details.
 @date July 24, 2011
 */
 
-#include"image.cpp"
+#include"image.h"
+#include"..\block compression\block compression.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include"..\..\..\utility\src\file operations\file operations.h"
+#include"..\..\..\utility\src\timer\timer.h"
+#include<iostream>
+#include<string>
+#include<vector>
+#include<cstring>
+#include<cstdlib>
 
 
+
+// Anonymous namespace.
+namespace
+{
+	bool LoadImageTGAReference(const std::string& file_name, unsigned int& width, unsigned int& height, unsigned short& pixel_depth, bool& is_translucent, std::vector<unsigned char>& pixel_data);
+	void WriteSpriteSheetTGA(const std::string& file_name, const unsigned short width, const unsigned short height, const unsigned char pixel_depth, const unsigned char descriptor, const bool use_rle);
+	const bool MatchesReference(const std::string& file_name);
+	void BenchmarkTGA(const std::string& file_name);
+	const bool MatchesImage(const std::string& file_name, const std::string& reference_name);
+	void WriteBMP(const std::string& file_name, const avl::view::Image& image, const bool is_top_down);
+	void BenchmarkLoad(const std::string& file_name);
+}
+
+
+
+void TestImageComponent()
+{
+	using avl::utility::Timer;
+
+	// The decoder must match the reference loader on every asset, and on every orientation
+	// and encoding it supports.
+	const char* const assets[] = {"assets/Font.tga", "assets/background.tga", "assets/blue.tga", "assets/explosion.tga",
+		"assets/red squares.tga", "assets/spiral.tga", "assets/translucent.tga"};
+	for(unsigned int i = 0; i < sizeof(assets) / sizeof(assets[0]); ++i)
+	{
+		ASSERT(MatchesReference(assets[i]) == true);
+	}
+	const unsigned char descriptors[] = {8, 8 | 16, 32, 0, 16};
+	for(unsigned int i = 0; i < sizeof(descriptors) / sizeof(descriptors[0]); ++i)
+	{
+		for(unsigned char pixel_depth = 3; pixel_depth <= 4; ++pixel_depth)
+		{
+			WriteSpriteSheetTGA("orientation test.tga", 67, 41, pixel_depth, descriptors[i], true);
+			ASSERT(MatchesReference("orientation test.tga") == true);
+			WriteSpriteSheetTGA("orientation test.tga", 67, 41, pixel_depth, descriptors[i], false);
+			ASSERT(MatchesReference("orientation test.tga") == true);
+		}
+	}
+	std::cout << "The decoder matches the reference loader.\n";
+
+	// Compare throughput on 4k sprite sheets.
+	WriteSpriteSheetTGA("sprite sheet rle.tga", 4096, 4096, 4, 8, true);
+	WriteSpriteSheetTGA("sprite sheet raw.tga", 4096, 4096, 4, 8, false);
+	WriteSpriteSheetTGA("sprite sheet flipped.tga", 4096, 4096, 4, 32, true);
+	BenchmarkTGA("sprite sheet rle.tga");
+	BenchmarkTGA("sprite sheet raw.tga");
+	BenchmarkTGA("sprite sheet flipped.tga");
+
+	// PNG and BMP images must decode to exactly the same pixels as the TGA images they were
+	// converted from. The PNG images use every filter, a palette, and split data chunks.
+	ASSERT(MatchesImage("assets/background.png", "assets/background.tga") == true);
+	ASSERT(MatchesImage("assets/translucent.png", "assets/translucent.tga") == true);
+	ASSERT(MatchesImage("assets/red squares.png", "assets/red squares.tga") == true);
+	const avl::view::Image background("assets/background.tga");
+	const avl::view::Image translucent("assets/translucent.tga");
+	WriteBMP("background.bmp", background, false);
+	WriteBMP("translucent.bmp", translucent, true);
+	ASSERT(MatchesImage("background.bmp", "assets/background.tga") == true);
+	ASSERT(MatchesImage("translucent.bmp", "assets/translucent.tga") == true);
+	std::cout << "PNG and BMP images match their TGA originals.\n";
+
+	// A mipmapped DDS image is saved as its top level alone, which its mip levels can be
+	// generated from again once it's loaded.
+	{
+		using namespace avl::view;
+		const unsigned int size = 64;
+		std::vector<unsigned char> pixels(size * size * 4);
+		for(std::size_t i = 0; i < pixels.size(); ++i)
+		{
+			pixels[i] = static_cast<unsigned char>((i % 4 == 3) ? 0xFF : i * 7 + i / 256);
+		}
+		unsigned char* const blocks = new unsigned char[GetBlockDataSize(size, size, DXT5)];
+		CompressBlocks(&pixels[0], size, size, 4, DXT5, blocks);
+		Image mipmapped(size, size, DXT5, false, blocks);
+		mipmapped.GenerateMipmaps();
+		ASSERT(mipmapped.GetLevelCount() == 7);
+		ASSERT(SaveImageDDS("mipmap test.dds", mipmapped) == true);
+		ASSERT(avl::utility::FileSize("mipmap test.dds") == static_cast<std::streamoff>(128 + mipmapped.GetLevelDataSize(0)));
+		Image loaded("mipmap test.dds");
+		ASSERT(loaded.IsCompressed() == true && loaded.GetWidth() == size && loaded.GetHeight() == size);
+		ASSERT(loaded.GetLevelCount() == 1 && loaded.GetDataSize() == mipmapped.GetLevelDataSize(0));
+		loaded.GenerateMipmaps();
+		ASSERT(loaded.GetLevelCount() == mipmapped.GetLevelCount());
+		for(unsigned int level = 0; level < loaded.GetLevelCount(); ++level)
+		{
+			ASSERT(memcmp(loaded.GetLevelData(level), mipmapped.GetLevelData(level), mipmapped.GetLevelDataSize(level)) == 0);
+		}
+		remove("mipmap test.dds");
+		std::cout << "Mipmapped DDS images round trip.\n";
+	}
+
+	// Compare load times of the same image in each format.
+	BenchmarkLoad("assets/background.tga");
+	BenchmarkLoad("assets/background.png");
+	BenchmarkLoad("background.bmp");
+
+	system("pause");
+}
+
+
+
+// Anonymous namespace.
+namespace
+{
+	/** The TGA loader as it was before decoding was fused into one pass: read the file into
+	a buffer, decode, flip rows, mirror rows, then scan for translucency.*/
+	bool LoadImageTGAReference(const std::string& file_name, unsigned int& width, unsigned int& height, unsigned short& pixel_depth, bool& is_translucent, std::vector<unsigned char>& pixel_data)
+	{
+		std::vector<char> file;
+		avl::utility::LoadFile(file_name, file);
+		const unsigned char* const file_data = reinterpret_cast<const unsigned char*>(&file[0]);
+		if(file.size() < 18 || file_data[1] != 0 || (file_data[2] != 2 && file_data[2] != 10) || file_data[17] > 32)
+		{
+			return false;
+		}
+		unsigned short x1, y1, x2, y2;
+		memcpy(&x1, &file_data[8], 2);
+		memcpy(&y1, &file_data[10], 2);
+		memcpy(&x2, &file_data[12], 2);
+		memcpy(&y2, &file_data[14], 2);
+		width = x2 - x1;
+		height = y2 - y1;
+		pixel_depth = file_data[16] / 8;
+		const unsigned int row_size = width * pixel_depth;
+		const unsigned int image_size = row_size * height;
+		pixel_data.resize(image_size);
+
+		const unsigned char* current = &file_data[file_data[0] + 18];
+		if(file_data[2] == 2)
+		{
+			memcpy(&pixel_data[0], current, image_size);
+		}
+		else
+		{
+			for(unsigned int index = 0; index < image_size; )
+			{
+				const bool is_run = (*current & 0x80) != 0;
+				const unsigned int run_length = (*current & 0x7F) + 1;
+				++current;
+				for(unsigned int i = 0; i < run_length; ++i, index += pixel_depth)
+				{
+					memcpy(&pixel_data[index], current, pixel_depth);
+					current += (is_run == true) ? 0 : pixel_depth;
+				}
+				current += (is_run == true) ? pixel_depth : 0;
+			}
+		}
+
+		if(file_data[17] & 16)
+		{
+			std::vector<unsigned char> temp(row_size);
+			for(unsigned int upper = 0, lower = height - 1; upper < lower; ++upper, --lower)
+			{
+				memcpy(&temp[0], &pixel_data[upper * row_size], row_size);
+				memcpy(&pixel_data[upper * row_size], &pixel_data[lower * row_size], row_size);
+				memcpy(&pixel_data[lower * row_size], &temp[0], row_size);
+			}
+		}
+		if(file_data[17] & 32)
+		{
+			unsigned char temp[4];
+			for(unsigned int line = 0; line < height; ++line)
+			{
+				for(unsigned int left = 0, right = width - 1; left < right; ++left, --right)
+				{
+					memcpy(temp, &pixel_data[(line * width + left) * pixel_depth], pixel_depth);
+					memcpy(&pixel_data[(line * width + left) * pixel_depth], &pixel_data[(line * width + right) * pixel_depth], pixel_depth);
+					memcpy(&pixel_data[(line * width + right) * pixel_depth], temp, pixel_depth);
+				}
+			}
+		}
+
+		is_translucent = false;
+		for(unsigned int alpha = 3; pixel_depth == 4 && alpha < image_size && is_translucent == false; alpha += 4)
+		{
+			is_translucent = (pixel_data[alpha] != 0 && pixel_data[alpha] != 0xFF);
+		}
+		return true;
+	}
+
+	/** Writes a sprite sheet-like image: frames of noisy pixels separated by transparent gutters.*/
+	void WriteSpriteSheetTGA(const std::string& file_name, const unsigned short width, const unsigned short height, const unsigned char pixel_depth, const unsigned char descriptor, const bool use_rle)
+	{
+		std::vector<unsigned char> pixels(static_cast<std::size_t>(width) * height * pixel_depth);
+		unsigned int seed = 747;
+		for(unsigned int y = 0; y < height; ++y)
+		{
+			for(unsigned int x = 0; x < width; ++x)
+			{
+				unsigned char* const pixel = &pixels[(static_cast<std::size_t>(y) * width + x) * pixel_depth];
+				const bool is_gutter = (x % 64) >= 48 || (y % 64) >= 48;
+				// Frames are made of short spans of one color, so that RLE has runs to encode.
+				if(x % 5 == 0)
+				{
+					seed = seed * 1103515245 + 12345;
+				}
+				for(unsigned int c = 0; c < pixel_depth; ++c)
+				{
+					pixel[c] = (is_gutter == true) ? 0 : static_cast<unsigned char>(seed >> (8 + c * 5));
+				}
+				if(pixel_depth == 4 && is_gutter == false)
+				{
+					pixel[3] = ((x / 64 + y / 64) % 4 == 0) ? 0x80 : 0xFF;
+				}
+			}
+		}
+
+		std::vector<char> file(18, 0);
+		file[2] = (use_rle == true) ? 10 : 2;
+		memcpy(&file[12], &width, 2);
+		memcpy(&file[14], &height, 2);
+		file[16] = pixel_depth * 8;
+		file[17] = descriptor;
+		if(use_rle == false)
+		{
+			file.insert(file.end(), pixels.begin(), pixels.end());
+		}
+		else
+		{
+			// Greedily encode runs of identical pixels, and literal packets in between.
+			const std::size_t pixel_count = static_cast<std::size_t>(width) * height;
+			for(std::size_t i = 0; i < pixel_count; )
+			{
+				std::size_t run = 1;
+				while(i + run < pixel_count && run < 128 && memcmp(&pixels[i * pixel_depth], &pixels[(i + run) * pixel_depth], pixel_depth) == 0)
+				{
+					++run;
+				}
+				if(run >= 2)
+				{
+					file.push_back(static_cast<char>(0x80 | (run - 1)));
+					file.insert(file.end(), &pixels[i * pixel_depth], &pixels[i * pixel_depth] + pixel_depth);
+					i += run;
+					continue;
+				}
+				std::size_t literal = 1;
+				while(i + literal < pixel_count && literal < 128 && (i + literal + 1 >= pixel_count
+					|| memcmp(&pixels[(i + literal) * pixel_depth], &pixels[(i + literal + 1) * pixel_depth], pixel_depth) != 0))
+				{
+					++literal;
+				}
+				file.push_back(static_cast<char>(literal - 1));
+				file.insert(file.end(), &pixels[i * pixel_depth], &pixels[(i + literal) * pixel_depth]);
+				i += literal;
+			}
+		}
+		avl::utility::WriteFile(file_name, file);
+	}
+
+	/** Checks that LoadImageTGA() and the reference loader agree on \a file_name.*/
+	const bool MatchesReference(const std::string& file_name)
+	{
+		unsigned int width, height, reference_width, reference_height;
+		unsigned short pixel_depth, reference_pixel_depth;
+		bool contains_alpha_channel, is_translucent, reference_is_translucent;
+		unsigned char* pixel_data = nullptr;
+		std::vector<unsigned char> reference_pixel_data;
+		if(avl::view::LoadImageTGA(file_name, width, height, pixel_depth, contains_alpha_channel, is_translucent, pixel_data) == false)
+		{
+			return false;
+		}
+		const bool matches = LoadImageTGAReference(file_name, reference_width, reference_height, reference_pixel_depth, reference_is_translucent, reference_pixel_data) == true
+			&& width == reference_width && height == reference_height && pixel_depth == reference_pixel_depth
+			&& is_translucent == reference_is_translucent && memcmp(pixel_data, &reference_pixel_data[0], reference_pixel_data.size()) == 0;
+		delete[] pixel_data;
+		return matches;
+	}
+
+	/** Reports the decoding throughput of LoadImageTGA() and the reference loader on \a file_name.*/
+	void BenchmarkTGA(const std::string& file_name)
+	{
+		const unsigned int loads = 10;
+		unsigned int width, height;
+		unsigned short pixel_depth;
+		bool contains_alpha_channel, is_translucent;
+
+		avl::utility::Timer fused_timer;
+		for(unsigned int i = 0; i < loads; ++i)
+		{
+			unsigned char* pixel_data = nullptr;
+			VERIFY(avl::view::LoadImageTGA(file_name, width, height, pixel_depth, contains_alpha_channel, is_translucent, pixel_data) == true);
+			delete[] pixel_data;
+		}
+		const double fused_time = fused_timer.Elapsed();
+
+		avl::utility::Timer reference_timer;
+		for(unsigned int i = 0; i < loads; ++i)
+		{
+			std::vector<unsigned char> pixel_data;
+			VERIFY(LoadImageTGAReference(file_name, width, height, pixel_depth, is_translucent, pixel_data) == true);
+		}
+		const double reference_time = reference_timer.Elapsed();
+
+		const double megabytes = static_cast<double>(width) * height * pixel_depth * loads / (1024.0 * 1024.0);
+		std::cout << file_name << ": " << megabytes / fused_time << " MB/s fused, " << megabytes / reference_time << " MB/s reference.\n";
+	}
+
+	/** Checks that \a file_name and \a reference_name load to the same image.*/
+	const bool MatchesImage(const std::string& file_name, const std::string& reference_name)
+	{
+		const avl::view::Image image(file_name);
+		const avl::view::Image reference(reference_name);
+		return image.GetPixelData() != nullptr && reference.GetPixelData() != nullptr
+			&& image.GetWidth() == reference.GetWidth() && image.GetHeight() == reference.GetHeight()
+			&& image.GetPixelDepth() == reference.GetPixelDepth() && image.IsTranslucent() == reference.IsTranslucent()
+			&& memcmp(image.GetPixelData(), reference.GetPixelData(), image.GetWidth() * image.GetHeight() * image.GetPixelDepth()) == 0;
+	}
+
+	/** Writes \a image to an uncompressed BMP file.*/
+	void WriteBMP(const std::string& file_name, const avl::view::Image& image, const bool is_top_down)
+	{
+		const unsigned int row_size = image.GetWidth() * image.GetPixelDepth();
+		const unsigned int stride = (row_size + 3) & ~3u;
+		std::vector<char> file(54 + stride * image.GetHeight(), 0);
+		const unsigned int values[] = {static_cast<unsigned int>(file.size()), 0, 54, 40, image.GetWidth(),
+			is_top_down == true ? 0u - image.GetHeight() : image.GetHeight()};
+		file[0] = 'B';
+		file[1] = 'M';
+		memcpy(&file[2], values, sizeof(values));
+		file[26] = 1;
+		file[28] = static_cast<char>(image.GetPixelDepth() * 8);
+		for(unsigned int row = 0; row < image.GetHeight(); ++row)
+		{
+			const unsigned int source_row = (is_top_down == true) ? image.GetHeight() - 1 - row : row;
+			memcpy(&file[54 + row * stride], image.GetPixelData() + source_row * row_size, row_size);
+		}
+		avl::utility::WriteFile(file_name, file);
+	}
+
+	/** Reports how long it takes to load \a file_name.*/
+	void BenchmarkLoad(const std::string& file_name)
+	{
+		const unsigned int loads = 50;
+		avl::utility::Timer timer;
+		for(unsigned int i = 0; i < loads; ++i)
+		{
+			const avl::view::Image image(file_name);
+			VERIFY(image.GetPixelData() != nullptr);
+		}
+		std::cout << file_name << ": " << timer.Elapsed() * 1000.0 / loads << " ms per load, "
+			<< avl::utility::FileSize(file_name) << " bytes on disk.\n";
+	}
+}
@@ -0,0 +1,486 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the mipmap component. See "mipmap.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"mipmap.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include<vector>
+#include<cmath>
+#include<cstddef>
+#include<new>
+#include<emmintrin.h>
+
+
+
+namespace avl
+{
+namespace view
+{
+
+	// Anonymous namespace.
+	namespace
+	{
+		/// The radius of the Kaiser filter, in output pixels.
+		const float KAISER_RADIUS = 3.0f;
+		/// The shape of the Kaiser window; larger values ring less but blur more.
+		const float KAISER_ALPHA = 4.0f;
+
+		/** The taps of a separable filter along one axis, for every output pixel.*/
+		struct FilterTaps
+		{
+			/// The number of taps per output pixel.
+			unsigned int tap_count;
+			/// The source pixel read by each tap, already clamped to the edge of the image.
+			std::vector<unsigned int> indices;
+			/// The weight of each tap. The weights of an output pixel sum to 1.
+			std::vector<float> weights;
+		};
+
+		void DownsampleBox(const unsigned char* const source, const unsigned int width, const unsigned int height, const unsigned int pixel_depth, unsigned char* const destination);
+		void DownsampleKaiser(const unsigned char* const source, const unsigned int width, const unsigned int height, const unsigned int pixel_depth, unsigned char* const destination);
+		void BoxFilterPairs(const unsigned char* const top_row, const unsigned char* const bottom_row, const unsigned int pair_count, unsigned char* const destination);
+		void BoxFilterPixel(const unsigned char* const source, const unsigned int width, const unsigned int pixel_depth, const unsigned int first_column, const unsigned int last_column, const unsigned int first_row, const unsigned int last_row, unsigned char* const destination);
+		void GetBoxSpan(const unsigned int index, const unsigned int source_size, const unsigned int destination_size, unsigned int& first, unsigned int& last);
+		void FilterRow(const unsigned char* const source_row, const unsigned int width, const unsigned int pixel_depth, const FilterTaps& columns, std::vector<float>& premultiplied, float* const destination);
+		void BuildKaiserTaps(const unsigned int source_size, const unsigned int destination_size, FilterTaps& taps);
+		const float BesselI0(const float x);
+	}
+
+
+
+	// See function declaration for details.
+	const unsigned int GetMipLevelCount(const unsigned int width, const unsigned int height)
+	{
+		unsigned int level_count = 1;
+		for(unsigned int w = width, h = height; w > 1 || h > 1; ++level_count)
+		{
+			w = (w > 1) ? w / 2 : 1;
+			h = (h > 1) ? h / 2 : 1;
+		}
+		return level_count;
+	}
+
+
+
+	// See function declaration for details.
+	void DownsampleImage(const unsigned char* const source, const unsigned int width, const unsigned int height, const unsigned short pixel_depth, const MipFilter filter, unsigned char* const destination)
+	{
+		ASSERT(source != nullptr && destination != nullptr && width > 0 && height > 0);
+		if(pixel_depth != 3 && pixel_depth != 4)
+		{
+			throw utility::InvalidArgumentException("avl::view::DownsampleImage()", "pixel_depth", "Must be 3 or 4.");
+		}
+		if(filter == KAISER_FILTER)
+		{
+			DownsampleKaiser(source, width, height, pixel_depth, destination);
+		}
+		else
+		{
+			DownsampleBox(source, width, height, pixel_depth, destination);
+		}
+	}
+
+
+
+	// Anonymous namespace.
+	namespace
+	{
+		/** Downsamples an image with a box filter.
+		@param source The pixels to downsample.
+		@param width The width of \a source in pixels.
+		@param height The height of \a source in pixels.
+		@param pixel_depth The number of bytes per pixel, 3 or 4.
+		@param destination [OUT] Receives the downsampled pixels.
+		*/
+		void DownsampleBox(const unsigned char* const source, const unsigned int width, const unsigned int height, const unsigned int pixel_depth, unsigned char* const destination)
+		{
+			const unsigned int destination_width = (width > 1) ? width / 2 : 1;
+			const unsigned int destination_height = (height > 1) ? height / 2 : 1;
+			for(unsigned int y = 0; y < destination_height; ++y)
+			{
+				unsigned int first_row, last_row;
+				GetBoxSpan(y, height, destination_height, first_row, last_row);
+				unsigned char* const destination_row = destination + static_cast<std::size_t>(y) * destination_width * pixel_depth;
+
+				// Squares of 32-bit pixels from even-width rows are filtered two at a time; the
+				// rest, including any 3-pixel spans at odd edges, one at a time.
+				unsigned int x = 0;
+				if(pixel_depth == 4 && width % 2 == 0 && last_row - first_row == 1)
+				{
+					const unsigned char* const top_row = source + static_cast<std::size_t>(first_row) * width * 4;
+					BoxFilterPairs(top_row, top_row + width * 4, destination_width / 2, destination_row);
+					x = destination_width / 2 * 2;
+				}
+				for(; x < destination_width; ++x)
+				{
+					unsigned int first_column, last_column;
+					GetBoxSpan(x, width, destination_width, first_column, last_column);
+					BoxFilterPixel(source, width, pixel_depth, first_column, last_column, first_row, last_row, destination_row + x * pixel_depth);
+				}
+			}
+		}
+
+
+
+		/** Downsamples an image with a separable Kaiser-windowed sinc filter. Each source row is
+		filtered horizontally once, into a ring of rows which the vertical pass reads from.
+		@param source The pixels to downsample.
+		@param width The width of \a source in pixels.
+		@param height The height of \a source in pixels.
+		@param pixel_depth The number of bytes per pixel, 3 or 4.
+		@param destination [OUT] Receives the downsampled pixels.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		void DownsampleKaiser(const unsigned char* const source, const unsigned int width, const unsigned int height, const unsigned int pixel_depth, unsigned char* const destination)
+		{
+			const unsigned int destination_width = (width > 1) ? width / 2 : 1;
+			const unsigned int destination_height = (height > 1) ? height / 2 : 1;
+			try
+			{
+				FilterTaps columns;
+				FilterTaps rows;
+				BuildKaiserTaps(width, destination_width, columns);
+				BuildKaiserTaps(height, destination_height, rows);
+
+				// Any window of rows fits in the ring without two of its rows sharing a slot.
+				const unsigned int ring_size = rows.tap_count;
+				const std::size_t row_floats = static_cast<std::size_t>(destination_width) * 4;
+				std::vector<float> ring(ring_size * row_floats);
+				std::vector<unsigned int> ring_rows(ring_size, 0xFFFFFFFF);
+				std::vector<float> premultiplied(static_cast<std::size_t>(width) * 4);
+				std::vector<float> filtered(row_floats);
+
+				const __m128 zero = _mm_setzero_ps();
+				const __m128 maximum = _mm_set1_ps(255.0f);
+				const __m128 half = _mm_set1_ps(0.5f);
+				for(unsigned int y = 0; y < destination_height; ++y)
+				{
+					// Filter vertically across the horizontally filtered rows.
+					for(std::size_t i = 0; i < row_floats; ++i)
+					{
+						filtered[i] = 0.0f;
+					}
+					for(unsigned int k = 0; k < rows.tap_count; ++k)
+					{
+						const float weight = rows.weights[y * rows.tap_count + k];
+						if(weight == 0.0f)
+						{
+							continue;
+						}
+						const unsigned int row = rows.indices[y * rows.tap_count + k];
+						float* const ring_row = &ring[(row % ring_size) * row_floats];
+						if(ring_rows[row % ring_size] != row)
+						{
+							FilterRow(source + static_cast<std::size_t>(row) * width * pixel_depth, width, pixel_depth, columns, premultiplied, ring_row);
+							ring_rows[row % ring_size] = row;
+						}
+						const __m128 weights = _mm_set1_ps(weight);
+						for(std::size_t i = 0; i < row_floats; i += 4)
+						{
+							_mm_storeu_ps(&filtered[i], _mm_add_ps(_mm_loadu_ps(&filtered[i]), _mm_mul_ps(_mm_loadu_ps(ring_row + i), weights)));
+						}
+					}
+
+					// Divide the colors by alpha again. Sinc filters overshoot, so clamp everything
+					// to its range first.
+					unsigned int first_row, last_row;
+					GetBoxSpan(y, height, destination_height, first_row, last_row);
+					unsigned char* const destination_row = destination + static_cast<std::size_t>(y) * destination_width * pixel_depth;
+					for(unsigned int x = 0; x < destination_width; ++x)
+					{
+						__m128 pixel = _mm_loadu_ps(&filtered[x * 4]);
+						const __m128 alpha = _mm_min_ps(_mm_max_ps(_mm_shuffle_ps(pixel, pixel, 0xFF), zero), maximum);
+						unsigned char* const output = destination_row + x * pixel_depth;
+						const int rounded_alpha = _mm_cvttss_si32(_mm_add_ss(alpha, half));
+						if(pixel_depth == 4 && rounded_alpha == 0)
+						{
+							// Fully transparent, so fall back on the plain average of the colors.
+							unsigned int first_column, last_column;
+							GetBoxSpan(x, width, destination_width, first_column, last_column);
+							BoxFilterPixel(source, width, pixel_depth, first_column, last_column, first_row, last_row, output);
+							output[3] = 0;
+							continue;
+						}
+						if(pixel_depth == 4)
+						{
+							pixel = _mm_mul_ps(pixel, _mm_div_ps(maximum, alpha));
+						}
+						pixel = _mm_add_ps(_mm_min_ps(_mm_max_ps(pixel, zero), maximum), half);
+						const __m128i channels = _mm_cvttps_epi32(pixel);
+						output[0] = static_cast<unsigned char>(_mm_cvtsi128_si32(channels));
+						output[1] = static_cast<unsigned char>(_mm_cvtsi128_si32(_mm_srli_si128(channels, 4)));
+						output[2] = static_cast<unsigned char>(_mm_cvtsi128_si32(_mm_srli_si128(channels, 8)));
+						if(pixel_depth == 4)
+						{
+							output[3] = static_cast<unsigned char>(rounded_alpha);
+						}
+					}
+				}
+			}
+			catch(const std::bad_alloc&)
+			{
+				throw utility::OutOfMemoryError();
+			}
+		}
+
+
+
+		/** Box filters squares of 2x2 32-bit pixels, two squares at a time, with SSE2. Produces
+		exactly the same results as \ref BoxFilterPixel().
+		@param top_row The top row of the squares.
+		@param bottom_row The bottom row of the squares.
+		@param pair_count The number of pairs of squares; 4 pixels are read from each row per pair.
+		@param destination [OUT] Receives 2 pixels per pair.
+		*/
+		void BoxFilterPairs(const unsigned char* const top_row, const unsigned char* const bottom_row, const unsigned int pair_count, unsigned char* const destination)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			// Selects the alpha channel of the two pixels held in 16-bit channels.
+			const __m128i alpha_lanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+			const __m128i alpha_weights = _mm_set_epi16(1, 0, 0, 0, 1, 0, 0, 0);
+			const __m128i two = _mm_set1_epi16(2);
+			const __m128 half = _mm_set1_ps(0.5f);
+			for(unsigned int i = 0; i < pair_count; ++i)
+			{
+				const __m128i top = _mm_loadu_si128(reinterpret_cast<const __m128i*>(top_row + i * 16));
+				const __m128i bottom = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom_row + i * 16));
+				// The first square is in the low halves, and the second in the high halves.
+				const __m128i top_first = _mm_unpacklo_epi8(top, zero);
+				const __m128i top_second = _mm_unpackhi_epi8(top, zero);
+				const __m128i bottom_first = _mm_unpacklo_epi8(bottom, zero);
+				const __m128i bottom_second = _mm_unpackhi_epi8(bottom, zero);
+
+				// The plain sums of each square fit in 16 bits.
+				const __m128i first = _mm_add_epi16(top_first, bottom_first);
+				const __m128i second = _mm_add_epi16(top_second, bottom_second);
+				const __m128i sums = _mm_add_epi16(_mm_unpacklo_epi64(first, second), _mm_unpackhi_epi64(first, second));
+
+				// Weigh each color by its alpha, and each alpha by 1, then sum in 32 bits.
+				__m128i weighted[4] = {top_first, bottom_first, top_second, bottom_second};
+				for(unsigned int j = 0; j < 4; ++j)
+				{
+					const __m128i alphas = _mm_shufflehi_epi16(_mm_shufflelo_epi16(weighted[j], 0xFF), 0xFF);
+					weighted[j] = _mm_mullo_epi16(weighted[j], _mm_or_si128(_mm_andnot_si128(alpha_lanes, alphas), alpha_weights));
+				}
+				const __m128i first_weighted = _mm_add_epi32(_mm_add_epi32(_mm_unpacklo_epi16(weighted[0], zero), _mm_unpackhi_epi16(weighted[0], zero)),
+					_mm_add_epi32(_mm_unpacklo_epi16(weighted[1], zero), _mm_unpackhi_epi16(weighted[1], zero)));
+				const __m128i second_weighted = _mm_add_epi32(_mm_add_epi32(_mm_unpacklo_epi16(weighted[2], zero), _mm_unpackhi_epi16(weighted[2], zero)),
+					_mm_add_epi32(_mm_unpacklo_epi16(weighted[3], zero), _mm_unpackhi_epi16(weighted[3], zero)));
+
+				// Divide the weighted colors by the total alpha, rounding to nearest.
+				const __m128 first_sums = _mm_cvtepi32_ps(first_weighted);
+				const __m128 second_sums = _mm_cvtepi32_ps(second_weighted);
+				const __m128i first_colors = _mm_cvttps_epi32(_mm_add_ps(_mm_div_ps(first_sums, _mm_shuffle_ps(first_sums, first_sums, 0xFF)), half));
+				const __m128i second_colors = _mm_cvttps_epi32(_mm_add_ps(_mm_div_ps(second_sums, _mm_shuffle_ps(second_sums, second_sums, 0xFF)), half));
+				const __m128i colors = _mm_packs_epi32(first_colors, second_colors);
+
+				// Alpha, and the colors of fully transparent squares, are plain averages.
+				const __m128i averages = _mm_srli_epi16(_mm_add_epi16(sums, two), 2);
+				const __m128i alpha_sums = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sums, 0xFF), 0xFF);
+				const __m128i use_averages = _mm_or_si128(_mm_cmpeq_epi16(alpha_sums, zero), alpha_lanes);
+				const __m128i result = _mm_or_si128(_mm_and_si128(use_averages, averages), _mm_andnot_si128(use_averages, colors));
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(destination + i * 8), _mm_packus_epi16(result, result));
+			}
+		}
+
+
+
+		/** Box filters a rectangle of pixels into one pixel.
+		@param source The pixels to downsample.
+		@param width The width of \a source in pixels.
+		@param pixel_depth The number of bytes per pixel, 3 or 4.
+		@param first_column The first column of the rectangle.
+		@param last_column The last column of the rectangle.
+		@param first_row The first row of the rectangle.
+		@param last_row The last row of the rectangle.
+		@param destination [OUT] Receives the pixel.
+		*/
+		void BoxFilterPixel(const unsigned char* const source, const unsigned int width, const unsigned int pixel_depth, const unsigned int first_column, const unsigned int last_column, const unsigned int first_row, const unsigned int last_row, unsigned char* const destination)
+		{
+			const unsigned int count = (last_column - first_column + 1) * (last_row - first_row + 1);
+			unsigned int sums[3] = {0, 0, 0};
+			unsigned int weighted_sums[3] = {0, 0, 0};
+			unsigned int alpha_sum = 0;
+			for(unsigned int y = first_row; y <= last_row; ++y)
+			{
+				const unsigned char* pixel = source + (static_cast<std::size_t>(y) * width + first_column) * pixel_depth;
+				for(unsigned int x = first_column; x <= last_column; ++x, pixel += pixel_depth)
+				{
+					const unsigned int alpha = (pixel_depth == 4) ? pixel[3] : 0;
+					for(unsigned int channel = 0; channel < 3; ++channel)
+					{
+						sums[channel] += pixel[channel];
+						weighted_sums[channel] += pixel[channel] * alpha;
+					}
+					alpha_sum += alpha;
+				}
+			}
+			for(unsigned int channel = 0; channel < 3; ++channel)
+			{
+				if(alpha_sum == 0)
+				{
+					destination[channel] = static_cast<unsigned char>((sums[channel] + count / 2) / count);
+				}
+				else
+				{
+					destination[channel] = static_cast<unsigned char>((2 * weighted_sums[channel] + alpha_sum) / (2 * alpha_sum));
+				}
+			}
+			if(pixel_depth == 4)
+			{
+				destination[3] = static_cast<unsigned char>((alpha_sum + count / 2) / count);
+			}
+		}
+
+
+
+		/** Finds the source pixels which a box filter averages into one output pixel along an axis:
+		normally two, but one if the source is only one pixel across, and three for the last output
+		pixel if the source is an odd number of pixels across.
+		@param index The output pixel.
+		@param source_size The size of the source along the axis.
+		@param destination_size The size of the output along the axis.
+		@param first [OUT] Receives the first source pixel.
+		@param last [OUT] Receives the last source pixel.
+		*/
+		void GetBoxSpan(const unsigned int index, const unsigned int source_size, const unsigned int destination_size, unsigned int& first, unsigned int& last)
+		{
+			if(source_size == 1)
+			{
+				first = 0;
+				last = 0;
+				return;
+			}
+			first = index * 2;
+			last = (index == destination_size - 1) ? source_size - 1 : index * 2 + 1;
+		}
+
+
+
+		/** Premultiplies a row of pixels by alpha and filters it horizontally.
+		@param source_row The row of pixels.
+		@param width The width of the row in pixels.
+		@param pixel_depth The number of bytes per pixel, 3 or 4.
+		@param columns The horizontal filter.
+		@param premultiplied Scratch space for \a width premultiplied pixels.
+		@param destination [OUT] Receives the filtered pixels as four floats each.
+		*/
+		void FilterRow(const unsigned char* const source_row, const unsigned int width, const unsigned int pixel_depth, const FilterTaps& columns, std::vector<float>& premultiplied, float* const destination)
+		{
+			const float inverse_maximum = 1.0f / 255.0f;
+			for(unsigned int x = 0; x < width; ++x)
+			{
+				const unsigned char* const pixel = source_row + x * pixel_depth;
+				const float alpha = (pixel_depth == 4) ? pixel[3] : 255.0f;
+				const __m128 colors = _mm_mul_ps(_mm_set_ps(255.0f, pixel[2], pixel[1], pixel[0]), _mm_set1_ps(alpha * inverse_maximum));
+				_mm_storeu_ps(&premultiplied[x * 4], colors);
+			}
+
+			const unsigned int destination_width = static_cast<unsigned int>(columns.indices.size() / columns.tap_count);
+			const unsigned int* index = &columns.indices[0];
+			const float* weight = &columns.weights[0];
+			for(unsigned int x = 0; x < destination_width; ++x)
+			{
+				__m128 sum = _mm_setzero_ps();
+				for(unsigned int k = 0; k < columns.tap_count; ++k, ++index, ++weight)
+				{
+					sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(&premultiplied[*index * 4]), _mm_set1_ps(*weight)));
+				}
+				_mm_storeu_ps(destination + x * 4, sum);
+			}
+		}
+
+
+
+		/** Computes the taps of a Kaiser-windowed sinc filter along one axis.
+		@param source_size The size of the source along the axis.
+		@param destination_size The size of the output along the axis.
+		@param taps [OUT] Receives the taps.
+		@throws std::bad_alloc If we run out of memory.
+		*/
+		void BuildKaiserTaps(const unsigned int source_size, const unsigned int destination_size, FilterTaps& taps)
+		{
+			const float pi = 3.14159265f;
+			// The filter is defined in output pixels, and stretched across the source.
+			const float scale = static_cast<float>(source_size) / destination_size;
+			const float radius = KAISER_RADIUS * scale;
+			taps.tap_count = static_cast<unsigned int>(std::ceil(radius * 2.0f)) + 1;
+			taps.indices.resize(static_cast<std::size_t>(destination_size) * taps.tap_count);
+			taps.weights.resize(static_cast<std::size_t>(destination_size) * taps.tap_count);
+
+			const float window_scale = 1.0f / BesselI0(KAISER_ALPHA);
+			for(unsigned int i = 0; i < destination_size; ++i)
+			{
+				const float center = (i + 0.5f) * scale;
+				const int first = static_cast<int>(std::floor(center - radius));
+				float total = 0.0f;
+				for(unsigned int k = 0; k < taps.tap_count; ++k)
+				{
+					const int source_index = first + static_cast<int>(k);
+					const float distance = (source_index + 0.5f - center) / scale;
+					float weight = 0.0f;
+					if(distance > -KAISER_RADIUS && distance < KAISER_RADIUS)
+					{
+						const float t = distance / KAISER_RADIUS;
+						const float sinc = (distance == 0.0f) ? 1.0f : std::sin(pi * distance) / (pi * distance);
+						weight = sinc * BesselI0(KAISER_ALPHA * std::sqrt(1.0f - t * t)) * window_scale;
+					}
+					// Repeat the edge pixels past the edges.
+					const int clamped_index = (source_index < 0) ? 0 : ((source_index >= static_cast<int>(source_size)) ? source_size - 1 : source_index);
+					taps.indices[i * taps.tap_count + k] = static_cast<unsigned int>(clamped_index);
+					taps.weights[i * taps.tap_count + k] = weight;
+					total += weight;
+				}
+				for(unsigned int k = 0; k < taps.tap_count; ++k)
+				{
+					taps.weights[i * taps.tap_count + k] /= total;
+				}
+			}
+		}
+
+
+
+		/** Evaluates the zeroth-order modified Bessel function of the first kind, which shapes the
+		Kaiser window.
+		@param x The argument.
+		@return I0(\a x).
+		*/
+		const float BesselI0(const float x)
+		{
+			// Sum the power series until its terms stop mattering.
+			float sum = 1.0f;
+			float term = 1.0f;
+			const float quarter_square = x * x * 0.25f;
+			for(unsigned int k = 1; k < 32 && term > sum * 1e-8f; ++k)
+			{
+				term *= quarter_square / static_cast<float>(k * k);
+				sum += term;
+			}
+			return sum;
+		}
+	}
+
+
+
+} // view
+} // avl
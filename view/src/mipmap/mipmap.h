@@ -0,0 +1,70 @@
+#pragma once
+#ifndef AVL_VIEW_MIPMAP__
+#define AVL_VIEW_MIPMAP__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Downsamples pixel data to build mipmap chains.
+@par Alpha:
+32-bit pixels are filtered as if their colors were premultiplied by their alpha, so that
+the colors of transparent pixels don't bleed into their neighbours; the results are then
+divided by alpha again, since images aren't stored premultiplied. A pixel which ends up fully
+transparent keeps the plain average of the colors it came from.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+
+
+namespace avl
+{
+namespace view
+{
+	/** The filters which may be used to downsample an image.*/
+	enum MipFilter
+	{
+		/// Averages each 2x2 square of pixels (or 2x3, 3x2, or 3x3 at odd edges). Fast.
+		BOX_FILTER,
+		/// A Kaiser-windowed sinc, three output pixels wide on either side. Sharper, but slower.
+		KAISER_FILTER
+	};
+
+	/** Computes the number of levels in a full mipmap chain, down to 1x1.
+	@param width The width of the top level in pixels.
+	@param height The height of the top level in pixels.
+	@return The number of levels, including the top level.
+	*/
+	const unsigned int GetMipLevelCount(const unsigned int width, const unsigned int height);
+
+	/** Downsamples an image to half its width and height, rounded down, but no less than 1.
+	@param source The pixels to downsample.
+	@param width The width of \a source in pixels.
+	@param height The height of \a source in pixels.
+	@param pixel_depth The number of bytes per pixel: 3 for BGR, or 4 for BGRA.
+	@param filter The filter to downsample with.
+	@param destination [OUT] Receives the downsampled pixels, in the same format as \a source.
+	@throws InvalidArgumentException If \a pixel_depth isn't 3 or 4.
+	@throws OutOfMemoryError If we run out of memory.
+	*/
+	void DownsampleImage(const unsigned char* const source, const unsigned int width, const unsigned int height, const unsigned short pixel_depth, const MipFilter filter, unsigned char* const destination);
+
+
+
+} // view
+} // avl
+#endif // AVL_VIEW_MIPMAP__
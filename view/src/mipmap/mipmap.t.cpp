@@ -0,0 +1,317 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Unit test for the mipmap component. See "mipmap.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"mipmap.h"
+#include"..\image\image.h"
+#include"..\block compression\block compression.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include"..\..\..\utility\src\timer\timer.h"
+#include<iostream>
+#include<vector>
+#include<cstring>
+#include<cstdlib>
+
+
+
+// Anonymous namespace.
+namespace
+{
+	void ReferenceBoxFilter(const unsigned char* const source, const unsigned int width, const unsigned int height, const unsigned int pixel_depth, unsigned char* const destination);
+	void FillRandomly(std::vector<unsigned char>& pixels, const unsigned int pixel_depth);
+	const bool IsConstant(const unsigned char* const pixels, const unsigned int pixel_count, const unsigned int pixel_depth, const unsigned char* const color);
+}
+
+
+
+void TestMipmapComponent()
+{
+	using namespace avl::view;
+	using avl::utility::Timer;
+
+	// Chains go all the way down to 1x1.
+	ASSERT(GetMipLevelCount(1, 1) == 1);
+	ASSERT(GetMipLevelCount(256, 256) == 9);
+	ASSERT(GetMipLevelCount(620, 335) == 10);
+	ASSERT(GetMipLevelCount(1, 5) == 3);
+	std::cout << "Level counts are correct.\n";
+
+	// The box filter must match a plain scalar one exactly, whichever path it takes: even widths
+	// use SSE2 for 32-bit pixels, and odd edges fold in a third row or column.
+	const unsigned int sizes[][2] = {{2, 2}, {8, 6}, {16, 16}, {10, 7}, {7, 10}, {1, 9}, {9, 1}, {34, 3}, {66, 66}};
+	for(unsigned int i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+	{
+		for(unsigned int pixel_depth = 3; pixel_depth <= 4; ++pixel_depth)
+		{
+			const unsigned int width = sizes[i][0];
+			const unsigned int height = sizes[i][1];
+			const unsigned int destination_size = ((width > 1) ? width / 2 : 1) * ((height > 1) ? height / 2 : 1) * pixel_depth;
+			std::vector<unsigned char> source(width * height * pixel_depth);
+			FillRandomly(source, pixel_depth);
+			std::vector<unsigned char> expected(destination_size);
+			std::vector<unsigned char> actual(destination_size);
+			ReferenceBoxFilter(&source[0], width, height, pixel_depth, &expected[0]);
+			DownsampleImage(&source[0], width, height, pixel_depth, BOX_FILTER, &actual[0]);
+			ASSERT(expected == actual);
+			// The Kaiser filter must cope with the same sizes.
+			DownsampleImage(&source[0], width, height, pixel_depth, KAISER_FILTER, &actual[0]);
+		}
+	}
+	std::cout << "The box filter matches the reference.\n";
+
+	// An opaque red pixel among transparent green ones must stay red: green is weighted by zero.
+	const unsigned char mixed[16] = {0, 0, 255, 255, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0};
+	unsigned char result[4];
+	DownsampleImage(mixed, 2, 2, 4, BOX_FILTER, result);
+	ASSERT(result[0] == 0 && result[1] == 0 && result[2] == 255 && result[3] == 64);
+	DownsampleImage(mixed, 2, 2, 4, KAISER_FILTER, result);
+	ASSERT(result[0] == 0 && result[1] == 0 && result[2] >= 254 && result[3] == 64);
+	// Fully transparent pixels keep their colors.
+	const unsigned char transparent[16] = {10, 20, 30, 0, 10, 20, 30, 0, 10, 20, 30, 0, 10, 20, 30, 0};
+	const unsigned char expected_transparent[4] = {10, 20, 30, 0};
+	DownsampleImage(transparent, 2, 2, 4, BOX_FILTER, result);
+	ASSERT(memcmp(result, expected_transparent, 4) == 0);
+	DownsampleImage(transparent, 2, 2, 4, KAISER_FILTER, result);
+	ASSERT(memcmp(result, expected_transparent, 4) == 0);
+	std::cout << "Alpha is filtered premultiplied.\n";
+
+	// A constant image stays constant all the way down, with both filters.
+	const unsigned char color[4] = {12, 99, 201, 200};
+	for(unsigned int filter = BOX_FILTER; filter <= KAISER_FILTER; ++filter)
+	{
+		const unsigned int width = 37;
+		const unsigned int height = 23;
+		unsigned char* const pixel_data = new unsigned char[width * height * 4];
+		for(unsigned int i = 0; i < width * height; ++i)
+		{
+			memcpy(pixel_data + i * 4, color, 4);
+		}
+		Image image(width, height, 4, true, true, pixel_data);
+		image.GenerateMipmaps(static_cast<MipFilter>(filter));
+		ASSERT(image.GetLevelCount() == GetMipLevelCount(width, height));
+		for(unsigned int level = 0; level < image.GetLevelCount(); ++level)
+		{
+			ASSERT(IsConstant(image.GetLevelData(level), image.GetLevelWidth(level) * image.GetLevelHeight(level), 4, color) == true);
+		}
+	}
+	std::cout << "Constant images stay constant.\n";
+
+	// Build the chain of an asset, and of a compressed copy of it.
+	{
+		Image image("assets/explosion.tga");
+		ASSERT(image.GetPixelData() != nullptr && image.GetLevelCount() == 1);
+		const std::size_t top_size = image.GetDataSize();
+		image.GenerateMipmaps();
+		ASSERT(image.GetLevelCount() == GetMipLevelCount(image.GetWidth(), image.GetHeight()));
+		std::size_t total_size = 0;
+		for(unsigned int level = 0; level < image.GetLevelCount(); ++level)
+		{
+			ASSERT(image.GetLevelDataSize(level) == static_cast<std::size_t>(image.GetLevelWidth(level)) * image.GetLevelHeight(level) * image.GetPixelDepth());
+			total_size += image.GetLevelDataSize(level);
+		}
+		ASSERT(image.GetDataSize() == total_size && total_size < top_size * 4 / 3 + 4 * image.GetLevelCount());
+		const unsigned int last = image.GetLevelCount() - 1;
+		ASSERT(image.GetLevelWidth(last) == 1 && image.GetLevelHeight(last) == 1);
+		// Opaque sprites must stay opaque or fully transparent, to be drawn with an alpha test.
+		if(image.IsTranslucent() == false && image.GetPixelDepth() == 4)
+		{
+			for(unsigned int level = 1; level < image.GetLevelCount(); ++level)
+			{
+				for(unsigned int i = 0; i < image.GetLevelWidth(level) * image.GetLevelHeight(level); ++i)
+				{
+					const unsigned char alpha = image.GetLevelData(level)[i * 4 + 3];
+					ASSERT(alpha == 0 || alpha == 255);
+				}
+			}
+		}
+		std::cout << "Built " << image.GetLevelCount() << " levels for assets/explosion.tga: " << total_size << " bytes vs. " << top_size << ".\n";
+
+		if(image.GetWidth() % 4 == 0 && image.GetHeight() % 4 == 0 && image.GetPixelDepth() == 4)
+		{
+			unsigned char* const blocks = new unsigned char[GetBlockDataSize(image.GetWidth(), image.GetHeight(), DXT5)];
+			CompressBlocks(image.GetPixelData(), image.GetWidth(), image.GetHeight(), 4, DXT5, blocks);
+			Image compressed(image.GetWidth(), image.GetHeight(), DXT5, true, blocks);
+			compressed.GenerateMipmaps();
+			ASSERT(compressed.GetLevelCount() == image.GetLevelCount());
+			std::size_t compressed_size = 0;
+			for(unsigned int level = 0; level < compressed.GetLevelCount(); ++level)
+			{
+				ASSERT(compressed.GetLevelDataSize(level) == GetBlockDataSize(compressed.GetLevelWidth(level), compressed.GetLevelHeight(level), DXT5));
+				compressed_size += compressed.GetLevelDataSize(level);
+			}
+			ASSERT(compressed.GetDataSize() == compressed_size);
+			unsigned char last_pixel[4];
+			DecompressBlocks(compressed.GetLevelData(last), 1, 1, DXT5, last_pixel);
+			std::cout << "Built " << compressed.GetLevelCount() << " DXT5 levels: " << compressed_size << " bytes.\n";
+		}
+	}
+
+	// Time whole chains of a 2048x2048 32-bit image.
+	{
+		const unsigned int width = 2048;
+		const unsigned int height = 2048;
+		const double megapixels = width * height / 1000000.0;
+		std::vector<unsigned char> source(width * height * 4);
+		FillRandomly(source, 4);
+		const unsigned int iterations = 5;
+
+		std::vector<unsigned char> scratch(width * height);
+		double reference_time;
+		{
+			const Timer timer;
+			for(unsigned int i = 0; i < iterations; ++i)
+			{
+				// Ping-pong between the source and the scratch space as the levels shrink.
+				ReferenceBoxFilter(&source[0], width, height, 4, &scratch[0]);
+				for(unsigned int level = 1; level < GetMipLevelCount(width, height) - 1; ++level)
+				{
+					const unsigned int level_width = (width >> level > 0) ? width >> level : 1;
+					const unsigned int level_height = (height >> level > 0) ? height >> level : 1;
+					unsigned char* const from = (level % 2 == 1) ? &scratch[0] : &source[0];
+					unsigned char* const to = (level % 2 == 1) ? &source[0] : &scratch[0];
+					ReferenceBoxFilter(from, level_width, level_height, 4, to);
+				}
+			}
+			reference_time = timer.Elapsed() / iterations;
+		}
+		FillRandomly(source, 4);
+
+		double times[2];
+		for(unsigned int filter = BOX_FILTER; filter <= KAISER_FILTER; ++filter)
+		{
+			unsigned char* const pixel_data = new unsigned char[width * height * 4];
+			memcpy(pixel_data, &source[0], width * height * 4);
+			Image image(width, height, 4, true, true, pixel_data);
+			const Timer timer;
+			for(unsigned int i = 0; i < iterations; ++i)
+			{
+				image.GenerateMipmaps(static_cast<MipFilter>(filter));
+			}
+			times[filter] = timer.Elapsed() / iterations;
+		}
+		std::cout << "Chain of a 2048x2048 image, per megapixel of the top level:\n"
+			<< "  scalar box " << reference_time * 1000.0 / megapixels << " ms\n"
+			<< "  SSE2 box   " << times[BOX_FILTER] * 1000.0 / megapixels << " ms\n"
+			<< "  Kaiser     " << times[KAISER_FILTER] * 1000.0 / megapixels << " ms\n";
+	}
+
+	std::cout << "\n\nAll tests passed.\n";
+	system("pause");
+}
+
+
+
+// Anonymous namespace.
+namespace
+{
+	/** A plain box filter to check the optimized one against, written as directly as possible.
+	@param source The pixels to downsample.
+	@param width The width of \a source in pixels.
+	@param height The height of \a source in pixels.
+	@param pixel_depth The number of bytes per pixel.
+	@param destination [OUT] Receives the downsampled pixels.
+	*/
+	void ReferenceBoxFilter(const unsigned char* const source, const unsigned int width, const unsigned int height, const unsigned int pixel_depth, unsigned char* const destination)
+	{
+		const unsigned int destination_width = (width > 1) ? width / 2 : 1;
+		const unsigned int destination_height = (height > 1) ? height / 2 : 1;
+		for(unsigned int y = 0; y < destination_height; ++y)
+		{
+			const unsigned int first_row = (height > 1) ? y * 2 : 0;
+			const unsigned int last_row = (height == 1) ? 0 : ((y == destination_height - 1) ? height - 1 : y * 2 + 1);
+			for(unsigned int x = 0; x < destination_width; ++x)
+			{
+				const unsigned int first_column = (width > 1) ? x * 2 : 0;
+				const unsigned int last_column = (width == 1) ? 0 : ((x == destination_width - 1) ? width - 1 : x * 2 + 1);
+				unsigned int count = 0;
+				unsigned int alpha_sum = 0;
+				unsigned int sums[3] = {0, 0, 0};
+				unsigned int weighted_sums[3] = {0, 0, 0};
+				for(unsigned int row = first_row; row <= last_row; ++row)
+				{
+					for(unsigned int column = first_column; column <= last_column; ++column)
+					{
+						const unsigned char* const pixel = source + (row * width + column) * pixel_depth;
+						const unsigned int alpha = (pixel_depth == 4) ? pixel[3] : 0;
+						for(unsigned int channel = 0; channel < 3; ++channel)
+						{
+							sums[channel] += pixel[channel];
+							weighted_sums[channel] += pixel[channel] * alpha;
+						}
+						alpha_sum += alpha;
+						++count;
+					}
+				}
+				unsigned char* const output = destination + (y * destination_width + x) * pixel_depth;
+				for(unsigned int channel = 0; channel < 3; ++channel)
+				{
+					// Round to nearest.
+					output[channel] = static_cast<unsigned char>((alpha_sum == 0) ? (sums[channel] * 2 + count) / (count * 2) : (weighted_sums[channel] * 2 + alpha_sum) / (alpha_sum * 2));
+				}
+				if(pixel_depth == 4)
+				{
+					output[3] = static_cast<unsigned char>((alpha_sum * 2 + count) / (count * 2));
+				}
+			}
+		}
+	}
+
+
+
+	/** Fills pixels with random colors. A quarter of the alphas are 0 and another quarter 0xFF,
+	since those are the special cases.
+	@param pixels The pixels to fill.
+	@param pixel_depth The number of bytes per pixel.
+	*/
+	void FillRandomly(std::vector<unsigned char>& pixels, const unsigned int pixel_depth)
+	{
+		for(std::size_t i = 0; i < pixels.size(); ++i)
+		{
+			pixels[i] = static_cast<unsigned char>(rand());
+			if(pixel_depth == 4 && i % 4 == 3 && pixels[i] < 0x80)
+			{
+				pixels[i] = (pixels[i] < 0x40) ? 0 : 0xFF;
+			}
+		}
+	}
+
+
+
+	/** Checks that every pixel has the same color.
+	@param pixels The pixels to check.
+	@param pixel_count The number of pixels.
+	@param pixel_depth The number of bytes per pixel.
+	@param color The expected color.
+	@return True if every channel is within 1 of \a color.
+	*/
+	const bool IsConstant(const unsigned char* const pixels, const unsigned int pixel_count, const unsigned int pixel_depth, const unsigned char* const color)
+	{
+		for(unsigned int i = 0; i < pixel_count * pixel_depth; ++i)
+		{
+			if(abs(static_cast<int>(pixels[i]) - color[i % pixel_depth]) > 1)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
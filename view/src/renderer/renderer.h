@@ -29,7 +29,9 @@ Defines the \ref avl::view::Renderer class and the \ref avl::view::RendererExcep
 #include"..\..\..\utility\src\graphic\graphic.h"
 #include"..\..\..\utility\src\textured quad\textured quad.h"
 #include"..\..\..\utility\src\vector\vector.h"
+#include"..\..\..\utility\src\asset loader\asset loader.h"
 #include<string>
+#include<cstddef>
 
 
 namespace avl
@@ -42,6 +44,19 @@ namespace view
 	class Renderer
 	{
 	public:
+		/** The states which a texture handle can be in.*/
+		enum TextureState
+		{
+			/// The texture is still being loaded, and a placeholder is drawn in its place.
+			TEXTURE_LOADING,
+			/// The texture is ready to be drawn.
+			TEXTURE_READY,
+			/// The texture couldn't be loaded, so the placeholder stays in its place.
+			TEXTURE_FAILED,
+			/// The handle isn't associated with a texture.
+			TEXTURE_INVALID
+		};
+
 		/** Basic constructor.
 		@param screen_space The adjusted screen resolution for the renderer. 
 		The center of the screen will be at (0, 0). The x component will specify
@@ -52,18 +67,66 @@ namespace view
 		/** Basic destructor.*/
 		virtual ~Renderer();
 
-		/** Makes it possible to render \a image using the returned texture handle.
+		/** Makes it possible to render \a image using the returned texture handle. If a texture
+		with identical contents has already been added, its handle is returned instead, and the
+		texture is shared; it's freed once each \ref AddTexture() has been matched by a
+		\ref DeleteTexture().
 		@post It will be possible to render \a image by using the returned texture handle.
 		@param image The image to be saved internally and accessed with the returned texture
 		handle.
+		@param source The name of the file which \a image was loaded from, if any. A texture with
+		a source may be freed to stay within the texture memory budget, and is loaded from its
+		source again when next rendered; see \ref SetTextureMemoryBudget().
 		@return A texture handle used to access \a image as a texture. This texture handle may be
 		used to render \a image.
 		*/
-		virtual const utility::TexturedQuad::TextureHandle AddTexture(const Image& image) = 0;
+		virtual const utility::TexturedQuad::TextureHandle AddTexture(const Image& image, const std::string& source = "") = 0;
+
+		/** Makes it possible to render an image file using the returned texture handle without
+		waiting for the file to be loaded. The image is decoded on \a loader's workers and uploaded
+		later, a few textures per frame; until then, the handle draws a placeholder.
+		@param file_name The name of the image file to load.
+		@param loader The loader to decode the image on. Its loaded jobs must be finished with
+		AssetLoader::FinishLoadedJobs() before the texture can be uploaded, and the renderer must
+		outlive its jobs.
+		@param priority How urgently the texture is needed.
+		@param generate_mipmaps Whether to build the image's mipmap chain while decoding it.
+		@return A texture handle which may be used to render right away.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		virtual const utility::TexturedQuad::TextureHandle AddTextureAsync(const std::string& file_name, utility::AssetLoader& loader,
+			const utility::AssetJob::Priority priority = utility::AssetJob::NORMAL, const bool generate_mipmaps = false) = 0;
+
+		/** Checks whether the texture associated with \a handle has been loaded.
+		@param handle The texture handle to check.
+		@return The state of the texture.
+		*/
+		virtual const TextureState GetTextureState(const utility::TexturedQuad::TextureHandle& handle) const = 0;
+
+		/** Counts the textures added with \ref AddTextureAsync() which are still loading.
+		@return The number of textures in the \ref TEXTURE_LOADING state.
+		*/
+		virtual const unsigned int GetLoadingTextureCount() const = 0;
+
+		/** Limits how much loaded texture data is uploaded each frame, so that a batch of textures
+		finishing at once doesn't cause a spike. At least one texture is uploaded each frame
+		regardless.
+		@param bytes_per_frame The number of bytes to upload per frame, or 0 for no limit.
+		*/
+		virtual void SetTextureUploadBudget(const std::size_t bytes_per_frame) = 0;
+
+		/** Limits how much texture memory is used. At the end of each frame, the textures which
+		have gone undrawn the longest are freed until the rest fit; they're loaded from their
+		sources again when next rendered. Textures drawn in the last frame, and textures added
+		without a source, are never freed.
+		@param bytes The number of bytes of texture memory to use, or 0 for no limit.
+		*/
+		virtual void SetTextureMemoryBudget(const std::size_t bytes) = 0;
 
 		/** Removes the texture associated with \a handle so that it will be freed from memory
-		and will no longer be able to be rendered.
-		@post \a handle will no longer be associated with a texture.
+		and will no longer be able to be rendered. A texture shared by several calls to
+		\ref AddTexture() is only removed when the last of them is matched.
+		@post \a handle will no longer be associated with a texture, unless it's still shared.
 		@param handle The texture handle to delete.
 		*/
 		virtual void DeleteTexture(const utility::TexturedQuad::TextureHandle& handle) = 0;
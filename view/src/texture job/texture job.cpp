@@ -0,0 +1,87 @@
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Implementation for the texture job component. See "texture job.h" for details.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"texture job.h"
+#include"..\renderer\renderer.h"
+#include"..\image\image.h"
+#include"..\..\..\utility\src\exceptions\exceptions.h"
+#include"..\..\..\utility\src\assert\assert.h"
+#include<string>
+#include<memory>
+#include<new>
+
+
+namespace avl
+{
+namespace view
+{
+
+	// See method declaration for details.
+	TextureJob::TextureJob(const std::string& file_name, Renderer& renderer, const Priority priority, const bool generate_mipmaps)
+		: AssetJob(priority), file_name(file_name), renderer(renderer), generate_mipmaps(generate_mipmaps), handle(0)
+	{
+	}
+
+	// See method declaration for details.
+	TextureJob::~TextureJob()
+	{
+	}
+
+	// See method declaration for details.
+	const utility::TexturedQuad::TextureHandle TextureJob::GetHandle() const
+	{
+		ASSERT(IsDone() == true && HasFailed() == false);
+		return handle;
+	}
+
+	// See method declaration for details.
+	void TextureJob::Load()
+	{
+		image.reset(new(std::nothrow) Image(file_name));
+		if(image == nullptr)
+		{
+			throw utility::OutOfMemoryError();
+		}
+		// Image reports failure by leaving its pixel data empty.
+		if(image->GetPixelData() == nullptr)
+		{
+			image.reset();
+			throw utility::FileFormatException(file_name);
+		}
+		if(generate_mipmaps == true)
+		{
+			image->GenerateMipmaps();
+		}
+	}
+
+	// See method declaration for details.
+	void TextureJob::Finish()
+	{
+		handle = renderer.AddTexture(*image, file_name);
+		image.reset();
+	}
+
+
+
+} // view
+} // avl
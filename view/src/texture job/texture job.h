@@ -0,0 +1,97 @@
+#pragma once
+#ifndef AVL_VIEW_TEXTURE_JOB__
+#define AVL_VIEW_TEXTURE_JOB__
+/* Copyright 2026 Sheldon Bachstein
+This file is part of the avl Library.
+
+The avl Library is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published
+by the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+The avl Library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with the avl Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+@file
+Defines the \ref avl::view::TextureJob class.
+@author Sheldon Bachstein
+@date Oct 19, 2026
+*/
+
+#include"..\renderer\renderer.h"
+#include"..\image\image.h"
+#include"..\..\..\utility\src\asset loader\asset loader.h"
+#include"..\..\..\utility\src\textured quad\textured quad.h"
+#include<string>
+#include<memory>
+
+
+namespace avl
+{
+namespace view
+{
+	/**
+	Loads an image file on an AssetLoader worker and then adds it to a Renderer
+	on the owning thread.
+	*/
+	class TextureJob: public utility::AssetJob
+	{
+	public:
+		/** Basic constructor.
+		@param file_name The name of the image file to load.
+		@param renderer The renderer which the texture will be added to. Must outlive the job.
+		@param priority How urgently the texture is needed.
+		@param generate_mipmaps Whether to build the image's mipmap chain on the worker, for textures
+		which will be drawn smaller than their size.
+		*/
+		TextureJob(const std::string& file_name, Renderer& renderer, const Priority priority = NORMAL, const bool generate_mipmaps = false);
+		/** Basic destructor.*/
+		~TextureJob();
+
+		/** Accesses the handle of the loaded texture.
+		@pre The job is done and didn't fail.
+		@return The handle which the renderer issued for the texture.
+		*/
+		const utility::TexturedQuad::TextureHandle GetHandle() const;
+
+	protected:
+		/** Loads and decodes the image file, and builds its mipmaps if asked to.
+		@throws FileFormatException If the image can't be loaded.
+		@throws OutOfMemoryError If we run out of memory.
+		*/
+		void Load();
+
+		/** Adds the decoded image to the renderer and frees it.
+		@throws RendererException If the renderer can't create the texture.
+		*/
+		void Finish();
+
+	private:
+		/// The name of the image file.
+		const std::string file_name;
+		/// The renderer which the texture will be added to.
+		Renderer& renderer;
+		/// Whether to generate mipmaps for the image.
+		const bool generate_mipmaps;
+		/// The decoded image, between Load() and Finish().
+		std::unique_ptr<Image> image;
+		/// The handle issued by the renderer.
+		utility::TexturedQuad::TextureHandle handle;
+
+		/// NOT IMPLEMENTED.
+		TextureJob(const TextureJob&);
+		/// NOT IMPLEMENTED.
+		const TextureJob& operator=(const TextureJob&);
+	};
+
+
+
+} // view
+} // avl
+#endif // AVL_VIEW_TEXTURE_JOB__
@@ -24,8 +24,11 @@ Includes the core components of the view subsystem.
 @date Jun 28, 2012
 */
 
+#include"block compression\block compression.h"
 #include"image\image.h"
+#include"mipmap\mipmap.h"
 #include"renderer\renderer.h"
+#include"texture job\texture job.h"
 #include"window\window.h"
 
 #endif // AVL_VIEW_SUBSYSTEM__